@@ -83,6 +83,33 @@ BOOST_AUTO_TEST_CASE(ParallelAssemblyCorrectnes)
     CompareHessiansAndInternalGradients(smallStructureSerial, smallStructureParallel);
 }
 
+BOOST_AUTO_TEST_CASE(ParallelAssemblyThreadLocalCorrectnes)
+{
+    NuTo::Structure smallStructureSerial(3);
+    NuTo::Structure smallStructureParallel(3);
+
+    smallStructureSerial.SetNumProcessors(1);
+    smallStructureParallel.SetNumProcessors(numProc);
+    smallStructureParallel.SetParallelAssembly(NuTo::eParallelAssembly::THREAD_LOCAL);
+
+    SetupStructure(smallStructureSerial, 2);
+    SetupStructure(smallStructureParallel, 2);
+
+    CompareHessiansAndInternalGradients(smallStructureSerial, smallStructureParallel);
+
+    // repeated evaluations have to give bitwise identical results
+    auto intGrad1 = smallStructureParallel.BuildGlobalInternalGradient();
+    auto intGrad2 = smallStructureParallel.BuildGlobalInternalGradient();
+    intGrad1 -= intGrad2;
+    BOOST_CHECK_EQUAL(intGrad1.J[NuTo::Node::eDof::DISPLACEMENTS].cwiseAbs().maxCoeff(), 0.);
+
+    // the thread local outputs are reused, also after the assembly pattern is built
+    CompareHessiansAndInternalGradients(smallStructureSerial, smallStructureParallel);
+    smallStructureParallel.SetUseAssemblyPattern(true);
+    CompareHessiansAndInternalGradients(smallStructureSerial, smallStructureParallel);
+    CompareHessiansAndInternalGradients(smallStructureSerial, smallStructureParallel);
+}
+
 BOOST_AUTO_TEST_CASE(ParallelAssemblyPerformance)
 {
     NuTo::Structure bigStructureSerial(3);
@@ -35,6 +35,11 @@ public:
         matrix.ExportToCSR();
     }
 
+    void NuToToEigenView()
+    {
+        matrix.GetEigenSparseMatrixView();
+    }
+
 private:
     NuTo::BlockSparseMatrix matrix;
     NuTo::BlockFullVector<double> rhs;
@@ -52,6 +57,16 @@ BENCHMARK(Convert, NuToToEigen, runner)
     }
 }
 
+BENCHMARK(Convert, NuToToEigenView, runner)
+{
+    NuTo::Benchmark::LinearElasticBenchmarkStructure s(numElements);
+    TestProblem t(s);
+    while (runner.KeepRunningIterations(10))
+    {
+        t.NuToToEigenView();
+    }
+}
+
 BENCHMARK(Convert, NuToToCSR, runner)
 {
     NuTo::Benchmark::LinearElasticBenchmarkStructure s(numElements);
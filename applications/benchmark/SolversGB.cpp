@@ -6,6 +6,10 @@
 #include "mechanics/dofSubMatrixSolvers/SolverMUMPS.h"
 #include "mechanics/dofSubMatrixSolvers/SolverPardiso.h"
 #include "mechanics/dofSubMatrixSolvers/SolverEigen.h"
+#include "mechanics/dofSubMatrixSolvers/SolverMINRES.h"
+#include "mechanics/dofSubMatrixSolvers/SolverMixedPrecision.h"
+#include "mechanics/dofSubMatrixSolvers/SolverPCG.h"
+#include "mechanics/dofSubMatrixSolvers/SolverSupernodalLDLT.h"
 
 
 // Setup Test Structure %%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
@@ -20,6 +24,8 @@ public:
         r.SetupBCs();
         matrix = r.GetStructure().BuildGlobalHessian0().JJ;
         rhs = r.GetStructure().BuildGlobalInternalGradient().J;
+        // the internal gradient of the undeformed structure is zero, which is trivial for the iterative solvers
+        rhs.Import(Eigen::VectorXd::Ones(rhs.GetNumActiveRows()));
     }
 
     void Solve(NuTo::SolverBase& rSolver)
@@ -27,6 +33,17 @@ public:
         rSolver.Solve(matrix, rhs);
     }
 
+    //! @brief scales the matrix, i.e. new values with the same pattern
+    void Scale(double rFactor)
+    {
+        matrix.AddScal(matrix, rFactor - 1.);
+    }
+
+    void SolveFactorized(NuTo::SolverBase& rSolver)
+    {
+        rSolver.SolveFactorized(rhs);
+    }
+
     void NuToToEigen()
     {
         matrix.ExportToEigenSparseMatrix();
@@ -52,12 +69,15 @@ class fixture : public benchmark::Fixture
 public:
     TestProblem t = {s};
 
+    //! @brief analysis, factorization and solution with a new solver in each iteration
     template <typename TSolver = void, typename... Params>
     void SolverBenchmark(benchmark::State& state, Params&&... params)
     {
-        TSolver solver = {std::forward<Params>(params)...};
         for (auto _ : state)
+        {
+            TSolver solver = {std::forward<Params>(params)...};
             t.Solve(solver);
+        }
     }
 };
 
@@ -104,5 +124,83 @@ BENCHMARK_F(fixture, Solver_EigenLDLT)(benchmark::State& state)
     SolverBenchmark<NuTo::SolverEigen<Eigen::SimplicialLDLT<Eigen::SparseMatrix<double>>>>(state);
 }
 
+BENCHMARK_F(fixture, Solver_SupernodalLDLT)(benchmark::State& state)
+{
+    SolverBenchmark<NuTo::SolverSupernodalLDLT>(state);
+}
+
+BENCHMARK_F(fixture, Solver_SupernodalLDLT_Single)(benchmark::State& state)
+{
+    SolverBenchmark<NuTo::SolverSupernodalLDLT>(state, NuTo::SupernodalLDLT::ePrecision::SINGLE);
+}
+
+BENCHMARK_F(fixture, Solver_MixedPrecision)(benchmark::State& state)
+{
+    SolverBenchmark<NuTo::SolverMixedPrecision>(state);
+}
+
+BENCHMARK_F(fixture, Solver_PCG_Jacobi)(benchmark::State& state)
+{
+    SolverBenchmark<NuTo::SolverPCG>(state, NuTo::SolverIterative::ePreconditioner::JACOBI);
+}
+
+BENCHMARK_F(fixture, Solver_PCG_BlockJacobi)(benchmark::State& state)
+{
+    SolverBenchmark<NuTo::SolverPCG>(state, NuTo::SolverIterative::ePreconditioner::BLOCK_JACOBI);
+}
+
+BENCHMARK_F(fixture, Solver_PCG_SSOR)(benchmark::State& state)
+{
+    SolverBenchmark<NuTo::SolverPCG>(state, NuTo::SolverIterative::ePreconditioner::SSOR);
+}
+
+BENCHMARK_F(fixture, Solver_PCG_IC)(benchmark::State& state)
+{
+    SolverBenchmark<NuTo::SolverPCG>(state, NuTo::SolverIterative::ePreconditioner::INCOMPLETE_CHOLESKY);
+}
+
+BENCHMARK_F(fixture, Solver_MINRES_Jacobi)(benchmark::State& state)
+{
+    SolverBenchmark<NuTo::SolverMINRES>(state, NuTo::SolverIterative::ePreconditioner::JACOBI);
+}
+
+
+// Factorization Reuse Benchmarks %%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+
+BENCHMARK_F(fixture, Solver_EigenLDLT_Refactorize)(benchmark::State& state)
+{
+    NuTo::SolverEigen<Eigen::SimplicialLDLT<Eigen::SparseMatrix<double>>> solver;
+    t.Solve(solver);
+    double factor = 2.;
+    for (auto _ : state)
+    {
+        // new values, the analysis of the pattern is reused
+        t.Scale(factor);
+        factor = 1. / factor;
+        t.Solve(solver);
+    }
+}
+
+BENCHMARK_F(fixture, Solver_SupernodalLDLT_Refactorize)(benchmark::State& state)
+{
+    NuTo::SolverSupernodalLDLT solver;
+    t.Solve(solver);
+    double factor = 2.;
+    for (auto _ : state)
+    {
+        t.Scale(factor);
+        factor = 1. / factor;
+        t.Solve(solver);
+    }
+}
+
+BENCHMARK_F(fixture, Solver_EigenLDLT_Resolve)(benchmark::State& state)
+{
+    NuTo::SolverEigen<Eigen::SimplicialLDLT<Eigen::SparseMatrix<double>>> solver;
+    t.Solve(solver);
+    for (auto _ : state)
+        t.SolveFactorized(solver);
+}
+
 
 BENCHMARK_MAIN()
@@ -0,0 +1,147 @@
+#include <benchmark/benchmark.h>
+
+#include <Eigen/SparseCore>
+
+#include "LinearElasticBenchmarkStructure.h"
+#include "math/SparseMatrixBSR.h"
+#include "math/SparseMatrixCSRGeneral.h"
+#include "math/SparseMatrixCSRSymmetric.h"
+#include "math/SparseMatrixCSRVector2General.h"
+#include "math/SparseMatrixCSRVector2Symmetric.h"
+#include "mechanics/dofSubMatrixStorage/BlockSparseMatrix.h"
+
+
+// Setup Test Matrices %%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+
+//! @brief hessian of the LinearElasticBenchmarkStructure in all sparse matrix formats
+class TestMatrices
+{
+public:
+    TestMatrices(NuTo::Benchmark::LinearElasticBenchmarkStructure& r)
+        : block(r.GetStructure().GetDofStatus())
+        , blockVector(r.GetStructure().GetDofStatus())
+    {
+        r.SetupBCs();
+        block = r.GetStructure().BuildGlobalHessian0().JJ;
+        eigen = block.GetEigenSparseMatrixView();
+
+        const int numRows = eigen.rows();
+        csrGeneral = NuTo::SparseMatrixCSRGeneral<double>(numRows, eigen.cols());
+        csrGeneral.GetRowIndexReference().assign(eigen.outerIndexPtr(), eigen.outerIndexPtr() + numRows + 1);
+        csrGeneral.GetColumnsReference().assign(eigen.innerIndexPtr(), eigen.innerIndexPtr() + eigen.nonZeros());
+        csrGeneral.GetValuesReference().assign(eigen.valuePtr(), eigen.valuePtr() + eigen.nonZeros());
+
+        csrSymmetric = NuTo::SparseMatrixCSRSymmetric<double>(numRows);
+        for (int row = 0; row < numRows; ++row)
+            for (Eigen::SparseMatrix<double, Eigen::RowMajor>::InnerIterator it(eigen, row); it; ++it)
+                if (it.col() >= row)
+                    csrSymmetric.AddValue(row, it.col(), it.value());
+
+        csrVector2General = NuTo::SparseMatrixCSRVector2General<double>(csrGeneral);
+        csrVector2Symmetric = NuTo::SparseMatrixCSRVector2Symmetric<double>(csrSymmetric);
+        bsr = NuTo::SparseMatrixBSR(csrGeneral, 3);
+
+        vector = Eigen::VectorXd::Random(numRows);
+        blockVector = r.GetStructure().BuildGlobalInternalGradient().J;
+        blockVector.Import(vector);
+    }
+
+    NuTo::BlockSparseMatrix block;
+    NuTo::BlockFullVector<double> blockVector;
+    Eigen::SparseMatrix<double, Eigen::RowMajor> eigen;
+    NuTo::SparseMatrixCSRGeneral<double> csrGeneral;
+    NuTo::SparseMatrixCSRSymmetric<double> csrSymmetric;
+    NuTo::SparseMatrixCSRVector2General<double> csrVector2General;
+    NuTo::SparseMatrixCSRVector2Symmetric<double> csrVector2Symmetric;
+    NuTo::SparseMatrixBSR bsr;
+    Eigen::MatrixXd vector;
+};
+
+// Benchmark Fixture %%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+
+class fixture : public benchmark::Fixture
+{
+    const std::vector<int> numElements = {10, 10, 10};
+    NuTo::Benchmark::LinearElasticBenchmarkStructure s = {numElements};
+
+public:
+    TestMatrices t = {s};
+
+    //! @brief reports the floating point operations and the memory traffic of the products
+    //! @param rNumStoredEntries ... number of stored entries, e.g. only the upper triangle of symmetric matrices
+    //! @param rBytesPerEntry ... bytes of value and index of an entry
+    void SetCounters(benchmark::State& state, long rNumStoredEntries, double rBytesPerEntry)
+    {
+        const long numRows = t.eigen.rows();
+        const double flops = 2. * t.eigen.nonZeros();
+        const double bytes = rNumStoredEntries * rBytesPerEntry + 2. * numRows * sizeof(double);
+        state.counters["FLOPS"] = benchmark::Counter(flops * state.iterations(), benchmark::Counter::kIsRate);
+        state.SetBytesProcessed(static_cast<int64_t>(bytes * state.iterations()));
+    }
+
+    template <typename TMatrix>
+    void ProductBenchmark(benchmark::State& state, const TMatrix& rMatrix, long rNumStoredEntries)
+    {
+        for (auto _ : state)
+            benchmark::DoNotOptimize(rMatrix.operator*(t.vector));
+        SetCounters(state, rNumStoredEntries, sizeof(double) + sizeof(int));
+    }
+};
+
+
+// Product Benchmarks %%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+
+BENCHMARK_F(fixture, Product_CSRGeneral)(benchmark::State& state)
+{
+    ProductBenchmark(state, t.csrGeneral, t.csrGeneral.GetNumEntries());
+}
+
+BENCHMARK_F(fixture, Product_CSRSymmetric)(benchmark::State& state)
+{
+    ProductBenchmark(state, t.csrSymmetric, t.csrSymmetric.GetNumEntries());
+}
+
+BENCHMARK_F(fixture, Product_CSRVector2General)(benchmark::State& state)
+{
+    ProductBenchmark(state, t.csrVector2General, t.csrVector2General.GetNumEntries());
+}
+
+BENCHMARK_F(fixture, Product_CSRVector2Symmetric)(benchmark::State& state)
+{
+    ProductBenchmark(state, t.csrVector2Symmetric, t.csrVector2Symmetric.GetNumEntries());
+}
+
+BENCHMARK_F(fixture, Product_BlockSparseMatrix)(benchmark::State& state)
+{
+    for (auto _ : state)
+        benchmark::DoNotOptimize(t.block * t.blockVector);
+    SetCounters(state, t.csrGeneral.GetNumEntries(), sizeof(double) + sizeof(int));
+}
+
+BENCHMARK_F(fixture, Product_BSR3)(benchmark::State& state)
+{
+    const Eigen::VectorXd vector = t.vector;
+    Eigen::VectorXd result;
+    for (auto _ : state)
+    {
+        t.bsr.Multiply(vector, result);
+        benchmark::DoNotOptimize(result.data());
+    }
+    // one column index per block
+    SetCounters(state, t.bsr.GetValues().size(), sizeof(double) + sizeof(int) / 9.);
+}
+
+BENCHMARK_F(fixture, Product_Eigen)(benchmark::State& state)
+{
+    const Eigen::VectorXd vector = t.vector;
+    Eigen::VectorXd result;
+    for (auto _ : state)
+    {
+        result.noalias() = t.eigen * vector;
+        benchmark::DoNotOptimize(result.data());
+    }
+    SetCounters(state, t.eigen.nonZeros(), sizeof(double) + sizeof(int));
+}
+
+
+BENCHMARK_MAIN()
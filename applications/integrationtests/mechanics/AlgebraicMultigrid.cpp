@@ -0,0 +1,91 @@
+#include "BoostUnitTest.h"
+
+#include <Eigen/SparseCholesky>
+#include "math/SmoothedAggregationAMG.h"
+#include "mechanics/MechanicsEnums.h"
+#include "mechanics/constraints/ConstraintCompanion.h"
+#include "mechanics/dofSubMatrixSolvers/SolverPCG.h"
+#include "mechanics/groups/Group.h"
+#include "mechanics/mesh/MeshGenerator.h"
+#include "mechanics/structures/StructureOutputBlockMatrix.h"
+#include "mechanics/structures/unstructured/Structure.h"
+
+using ePreconditioner = NuTo::SolverIterative::ePreconditioner;
+
+//! @brief linear elastic cube with n x n x n elements
+void SetupStructure(NuTo::Structure& rStructure, int n)
+{
+    rStructure.SetShowTime(false);
+    rStructure.SetVerboseLevel(0);
+    int interpolationType = NuTo::MeshGenerator::Grid(rStructure, {1., 2., 1.}, {n, n, n}).second;
+    rStructure.InterpolationTypeAdd(interpolationType, NuTo::Node::eDof::DISPLACEMENTS,
+                                    NuTo::Interpolation::eTypeOrder::EQUIDISTANT1);
+    rStructure.ElementTotalConvertToInterpolationType();
+
+    rStructure.ConstitutiveLawCreate(0, NuTo::Constitutive::eConstitutiveType::LINEAR_ELASTIC_ENGINEERING_STRESS);
+    rStructure.ConstitutiveLawSetParameterDouble(0, NuTo::Constitutive::eConstitutiveParameter::YOUNGS_MODULUS, 20000);
+    rStructure.ConstitutiveLawSetParameterDouble(0, NuTo::Constitutive::eConstitutiveParameter::POISSONS_RATIO, .2);
+    rStructure.ElementTotalSetConstitutiveLaw(0);
+}
+
+BOOST_AUTO_TEST_CASE(RigidBodyModes)
+{
+    NuTo::Structure s(3);
+    SetupStructure(s, 3);
+    const NuTo::NearNullSpace nearNullSpace = s.BuildNearNullSpace();
+    BOOST_CHECK_EQUAL(nearNullSpace.mModes.cols(), 6);
+    BOOST_CHECK_EQUAL(nearNullSpace.mModes.rows(), s.GetNumActiveDofs(NuTo::Node::eDof::DISPLACEMENTS));
+    BOOST_CHECK_EQUAL(nearNullSpace.mNodes.size(), nearNullSpace.mModes.rows());
+
+    // no strains and stresses for rigid body motions
+    const Eigen::SparseMatrix<double> hessian = s.BuildGlobalHessian0().JJ.ExportToEigenSparseMatrix();
+    const Eigen::MatrixXd forces = hessian * nearNullSpace.mModes;
+    BOOST_CHECK_SMALL(forces.norm() / (hessian.norm() * nearNullSpace.mModes.norm()), 1.e-12);
+
+    // 2D: two translations and one rotation
+    NuTo::Structure s2D(2);
+    s2D.SetVerboseLevel(0);
+    s2D.SetShowTime(false);
+    int interpolationType = NuTo::MeshGenerator::Grid(s2D, {1., 1.}, {3, 3}).second;
+    s2D.InterpolationTypeAdd(interpolationType, NuTo::Node::eDof::DISPLACEMENTS,
+                             NuTo::Interpolation::eTypeOrder::EQUIDISTANT2);
+    s2D.ElementTotalConvertToInterpolationType();
+    BOOST_CHECK_EQUAL(s2D.BuildNearNullSpace().mModes.cols(), 3);
+}
+
+BOOST_AUTO_TEST_CASE(MultigridPCG)
+{
+    std::vector<int> numIterations;
+    for (int n : {4, 8})
+    {
+        NuTo::Structure s(3);
+        SetupStructure(s, n);
+        auto& bottomNodes = s.GroupGetNodesAtCoordinate(NuTo::eDirection::Z, 0.);
+        s.Constraints().Add(NuTo::Node::eDof::DISPLACEMENTS,
+                            NuTo::Constraint::Component(bottomNodes, {NuTo::eDirection::X, NuTo::eDirection::Y,
+                                                                      NuTo::eDirection::Z}));
+        s.NodeBuildGlobalDofs();
+
+        const auto hessian = s.BuildGlobalHessian0();
+        NuTo::BlockFullVector<double> rhs = s.BuildGlobalInternalGradient().J;
+        rhs.Import(Eigen::VectorXd::Ones(rhs.GetNumActiveRows()));
+
+        Eigen::SimplicialLDLT<Eigen::SparseMatrix<double>> direct(hessian.JJ.ExportToEigenSparseMatrix());
+        const Eigen::VectorXd expected = direct.solve(rhs.Export());
+
+        NuTo::SolverPCG multigrid(ePreconditioner::ALGEBRAIC_MULTIGRID);
+        multigrid.SetNearNullSpace(s.BuildNearNullSpace());
+        multigrid.GetMultigrid().SetMaxCoarseSize(100);
+        const Eigen::VectorXd solution = multigrid.Solve(hessian.JJ, rhs).Export();
+        BOOST_CHECK_SMALL((solution - expected).norm() / expected.norm(), 1.e-8);
+        numIterations.push_back(multigrid.GetNumIterations());
+
+        NuTo::SolverPCG jacobi(ePreconditioner::JACOBI);
+        jacobi.Solve(hessian.JJ, rhs);
+        BOOST_TEST_MESSAGE("n = " << n << ", iterations multigrid " << multigrid.GetNumIterations() << ", jacobi "
+                                  << jacobi.GetNumIterations());
+        BOOST_CHECK_LT(2 * multigrid.GetNumIterations(), jacobi.GetNumIterations());
+    }
+    // mesh independent up to a few iterations
+    BOOST_CHECK_LE(numIterations[1], numIterations[0] + 5);
+}
@@ -0,0 +1,76 @@
+#include "BoostUnitTest.h"
+
+#include "mechanics/structures/unstructured/Structure.h"
+#include "mechanics/MechanicsEnums.h"
+#include "mechanics/constraints/ConstraintCompanion.h"
+#include "mechanics/groups/Group.h"
+#include "mechanics/mesh/MeshGenerator.h"
+#include "mechanics/nodes/NodeBase.h"
+#include "mechanics/structures/StructureOutputBlockMatrix.h"
+
+void SetupStructure(NuTo::Structure& rStructure)
+{
+    rStructure.SetShowTime(false);
+    rStructure.SetVerboseLevel(0);
+
+    int interpolationType = NuTo::MeshGenerator::Grid(rStructure, {2., 3., 4.}, {3, 2, 2}).second;
+    rStructure.InterpolationTypeAdd(interpolationType, NuTo::Node::eDof::DISPLACEMENTS,
+                                    NuTo::Interpolation::eTypeOrder::EQUIDISTANT2);
+    rStructure.ElementTotalConvertToInterpolationType();
+
+    rStructure.ConstitutiveLawCreate(0, NuTo::Constitutive::eConstitutiveType::LINEAR_ELASTIC_ENGINEERING_STRESS);
+    rStructure.ConstitutiveLawSetParameterDouble(0, NuTo::Constitutive::eConstitutiveParameter::YOUNGS_MODULUS, 20000);
+    rStructure.ConstitutiveLawSetParameterDouble(0, NuTo::Constitutive::eConstitutiveParameter::POISSONS_RATIO, .2);
+    rStructure.ConstitutiveLawSetParameterDouble(0, NuTo::Constitutive::eConstitutiveParameter::DENSITY, 1.5);
+    rStructure.ElementTotalSetConstitutiveLaw(0);
+
+    // constrained dofs to get entries in all submatrices
+    auto& nodesLeft = rStructure.GroupGetNodesAtCoordinate(NuTo::eDirection::X, 0.);
+    rStructure.Constraints().Add(NuTo::Node::eDof::DISPLACEMENTS,
+                                 NuTo::Constraint::Component(nodesLeft, {NuTo::eDirection::X, NuTo::eDirection::Y}));
+}
+
+void CheckEqual(const NuTo::StructureOutputBlockMatrix& rExpected, const NuTo::StructureOutputBlockMatrix& rActual)
+{
+    Eigen::SparseMatrix<double> difference =
+            rExpected.ExportToEigenSparseMatrix() - rActual.ExportToEigenSparseMatrix();
+    BOOST_CHECK_GT(rExpected.ExportToEigenSparseMatrix().norm(), 0.);
+    BOOST_CHECK_SMALL(difference.norm(), 1.e-8);
+}
+
+BOOST_AUTO_TEST_CASE(AssemblyPatternHessians)
+{
+    NuTo::Structure reference(3);
+    NuTo::Structure structure(3);
+    SetupStructure(reference);
+    SetupStructure(structure);
+    structure.SetUseAssemblyPattern(true);
+
+    CheckEqual(reference.BuildGlobalHessian0(), structure.BuildGlobalHessian0());
+    CheckEqual(reference.BuildGlobalHessian2(), structure.BuildGlobalHessian2());
+
+    // reuse of the pattern in the same output
+    auto hessian0 = structure.BuildGlobalHessian0();
+    CheckEqual(reference.BuildGlobalHessian0(), hessian0);
+}
+
+BOOST_AUTO_TEST_CASE(AssemblyPatternChangedConstraints)
+{
+    NuTo::Structure reference(3);
+    NuTo::Structure structure(3);
+    SetupStructure(reference);
+    SetupStructure(structure);
+    structure.SetUseAssemblyPattern(true);
+
+    CheckEqual(reference.BuildGlobalHessian0(), structure.BuildGlobalHessian0());
+
+    // changes the dof numbering, the pattern has to be rebuilt
+    for (NuTo::Structure* s : {&reference, &structure})
+    {
+        auto& nodesBottom = s->GroupGetNodesAtCoordinate(NuTo::eDirection::Z, 0.);
+        s->Constraints().Add(NuTo::Node::eDof::DISPLACEMENTS,
+                             NuTo::Constraint::Component(nodesBottom, {NuTo::eDirection::Z}));
+    }
+
+    CheckEqual(reference.BuildGlobalHessian0(), structure.BuildGlobalHessian0());
+}
@@ -7,6 +7,8 @@
 #include <Eigen/Sparse>
 
 
+#include "math/SparseMatrixBSR.h"
+#include "math/SparseMatrixCSR.h"
 #include "math/SparseMatrixCSRVector2General.h"
 
 
@@ -162,6 +164,31 @@ BOOST_AUTO_TEST_CASE(BlockSparseMatrix)
     BoostUnitTest::CheckEigenMatrix(exportCSRVector2, exportReference);
     BoostUnitTest::CheckEigenMatrix(exportCSR, exportReference);
 
+    // compressed matrix, updated in place for the same pattern
+    Eigen::MatrixXd exportView = m.GetEigenSparseMatrixView();
+    BoostUnitTest::CheckEigenMatrix(exportView, exportReference);
+    BoostUnitTest::CheckEigenMatrix(Eigen::MatrixXd(m.ExportToEigenSparseMatrix()), exportReference);
+    const double* compressedValues = m.GetCompressed().GetValues().data();
+    m.AddScal(m, 1.);
+    exportView = m.GetEigenSparseMatrixView();
+    BoostUnitTest::CheckEigenMatrix(exportView, 2. * exportReference);
+    BOOST_CHECK_EQUAL(m.GetCompressed().GetValues().data(), compressedValues);
+
+    for (int blockSize : {2, 3})
+    {
+        const NuTo::SparseMatrixBSR& bsr = m.GetCompressedBSR(blockSize);
+        BOOST_CHECK_EQUAL(bsr.GetBlockSize(), blockSize);
+        BoostUnitTest::CheckEigenMatrix(bsr.ConvertToFullMatrix(), 2. * exportReference);
+        const Eigen::VectorXd vector = v.Export();
+        BoostUnitTest::CheckVector(bsr * vector, 2. * exportReference * vector, vector.rows());
+    }
+
+    const NuTo::SparseMatrixCSR<double>& compressedOneBased = m.GetCompressed(true);
+    BOOST_CHECK(compressedOneBased.HasOneBasedIndexing());
+    BOOST_CHECK(not compressedOneBased.IsSymmetric());
+    BOOST_CHECK_EQUAL(compressedOneBased.GetRowIndex()[0], 1);
+    BoostUnitTest::CheckEigenMatrix(compressedOneBased.ConvertToFullMatrix(), 2. * exportReference);
+
     s.SetActiveDofTypes({NuTo::Node::eDof::DISPLACEMENTS});
 
     auto CSR = m.ExportToCSR();
@@ -169,6 +196,13 @@ BOOST_AUTO_TEST_CASE(BlockSparseMatrix)
 
     Eigen::MatrixXd exportCSRSymm = CSR->ConvertToFullMatrix();
     BoostUnitTest::CheckEigenMatrix(exportCSRSymm, m.ExportToFullMatrix());
+
+    const NuTo::SparseMatrixCSR<double>& compressedSymm = m.GetCompressed(true);
+    BOOST_CHECK(compressedSymm.IsSymmetric());
+    BOOST_CHECK_EQUAL(compressedSymm.GetNumEntries(), CSR->GetNumEntries());
+    BoostUnitTest::CheckEigenMatrix(compressedSymm.ConvertToFullMatrix(), m.ExportToFullMatrix());
+    exportView = m.GetEigenSparseMatrixView();
+    BoostUnitTest::CheckEigenMatrix(exportView, m.ExportToFullMatrix());
 }
 
 //! @brief StructureOutputBlockMatrixTest
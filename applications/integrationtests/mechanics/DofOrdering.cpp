@@ -0,0 +1,135 @@
+#include "BoostUnitTest.h"
+
+#include "mechanics/structures/unstructured/Structure.h"
+#include "mechanics/MechanicsEnums.h"
+#include "mechanics/constraints/ConstraintCompanion.h"
+#include "mechanics/groups/Group.h"
+#include "mechanics/mesh/MeshGenerator.h"
+#include "mechanics/nodes/NodeBase.h"
+#include "mechanics/sections/SectionPlane.h"
+#include "mechanics/structures/Assembler.h"
+#include "mechanics/structures/StructureOutputBlockMatrix.h"
+
+using NuTo::eDofOrdering;
+
+void SetupStructure(NuTo::Structure& rStructure, eDofOrdering rDofOrdering)
+{
+    rStructure.SetShowTime(false);
+    rStructure.SetVerboseLevel(0);
+    rStructure.SetDofOrdering(rDofOrdering);
+
+    // the nodes of the grid are numbered along the long side
+    int interpolationType = NuTo::MeshGenerator::Grid(rStructure, {6., 1.}, {24, 3}).second;
+    rStructure.InterpolationTypeAdd(interpolationType, NuTo::Node::eDof::DISPLACEMENTS,
+                                    NuTo::Interpolation::eTypeOrder::EQUIDISTANT2);
+    rStructure.ElementTotalConvertToInterpolationType();
+    rStructure.ElementTotalSetSection(NuTo::SectionPlane::Create(1., false));
+
+    rStructure.ConstitutiveLawCreate(0, NuTo::Constitutive::eConstitutiveType::LINEAR_ELASTIC_ENGINEERING_STRESS);
+    rStructure.ConstitutiveLawSetParameterDouble(0, NuTo::Constitutive::eConstitutiveParameter::YOUNGS_MODULUS, 20000);
+    rStructure.ConstitutiveLawSetParameterDouble(0, NuTo::Constitutive::eConstitutiveParameter::POISSONS_RATIO, .2);
+    rStructure.ElementTotalSetConstitutiveLaw(0);
+
+    // fixed nodes on the left, nodes on the right that couple their displacement components
+    auto& nodesLeft = rStructure.GroupGetNodesAtCoordinate(NuTo::eDirection::X, 0.);
+    rStructure.Constraints().Add(NuTo::Node::eDof::DISPLACEMENTS,
+                                 NuTo::Constraint::Component(nodesLeft, {NuTo::eDirection::X, NuTo::eDirection::Y}));
+    auto& nodesRight = rStructure.GroupGetNodesAtCoordinate(NuTo::eDirection::X, 6.);
+    rStructure.Constraints().Add(NuTo::Node::eDof::DISPLACEMENTS,
+                                 NuTo::Constraint::Direction(nodesRight, Eigen::Vector2d(1., 2.)));
+    rStructure.NodeBuildGlobalDofs();
+}
+
+//! @brief hessian of the active dofs with the constraints applied
+Eigen::SparseMatrix<double> ReducedHessian(NuTo::Structure& rStructure)
+{
+    auto hessian = rStructure.BuildGlobalHessian0();
+    hessian.ApplyCMatrix(rStructure.GetAssembler().GetConstraintMatrix());
+    return hessian.JJ.ExportToEigenSparseMatrix();
+}
+
+//! @brief global dof numbers of all displacement components, in the order of the node ids
+std::vector<int> DofNumbers(NuTo::Structure& rStructure)
+{
+    std::vector<int> dofNumbers;
+    int groupId = rStructure.GroupGetNodesTotal();
+    for (int nodeId : rStructure.GroupGetMemberIds(groupId))
+    {
+        const NuTo::NodeBase* node = rStructure.NodeGetNodePtr(nodeId);
+        for (int i = 0; i < node->GetNum(NuTo::Node::eDof::DISPLACEMENTS); ++i)
+            dofNumbers.push_back(node->GetDof(NuTo::Node::eDof::DISPLACEMENTS, i));
+    }
+    rStructure.GroupDelete(groupId);
+    return dofNumbers;
+}
+
+int Bandwidth(const Eigen::SparseMatrix<double>& rMatrix)
+{
+    int bandwidth = 0;
+    for (int column = 0; column < rMatrix.outerSize(); ++column)
+        for (Eigen::SparseMatrix<double>::InnerIterator it(rMatrix, column); it; ++it)
+            bandwidth = std::max(bandwidth, static_cast<int>(std::abs(it.row() - column)));
+    return bandwidth;
+}
+
+//! @brief the reduced hessians of both structures are equal up to the numbering of the dofs
+void CheckPermutedHessian(NuTo::Structure& rExpected, NuTo::Structure& rActual)
+{
+    const Eigen::MatrixXd expected = ReducedHessian(rExpected);
+    const Eigen::MatrixXd actual = ReducedHessian(rActual);
+    BOOST_REQUIRE_EQUAL(expected.rows(), actual.rows());
+
+    const int numActiveDofs = rExpected.GetNumActiveDofs(NuTo::Node::eDof::DISPLACEMENTS);
+    BOOST_CHECK_EQUAL(rActual.GetNumActiveDofs(NuTo::Node::eDof::DISPLACEMENTS), numActiveDofs);
+    const std::vector<int> expectedDofs = DofNumbers(rExpected);
+    const std::vector<int> actualDofs = DofNumbers(rActual);
+
+    Eigen::MatrixXd permuted = Eigen::MatrixXd::Zero(expected.rows(), expected.cols());
+    for (unsigned int i = 0; i < expectedDofs.size(); ++i)
+    {
+        // the same components are dependent
+        BOOST_CHECK_EQUAL(expectedDofs[i] < numActiveDofs, actualDofs[i] < numActiveDofs);
+        if (expectedDofs[i] >= numActiveDofs)
+            continue;
+        for (unsigned int j = 0; j < expectedDofs.size(); ++j)
+            if (expectedDofs[j] < numActiveDofs)
+                permuted(expectedDofs[i], expectedDofs[j]) = actual(actualDofs[i], actualDofs[j]);
+    }
+    BOOST_CHECK_SMALL((permuted - expected).norm() / expected.norm(), 1.e-12);
+}
+
+BOOST_AUTO_TEST_CASE(DofOrderingPermutation)
+{
+    NuTo::Structure reference(2);
+    SetupStructure(reference, eDofOrdering::NODE_ID);
+    const int referenceBandwidth = Bandwidth(ReducedHessian(reference));
+
+    for (eDofOrdering ordering :
+         {eDofOrdering::REVERSE_CUTHILL_MCKEE, eDofOrdering::MORTON_CURVE, eDofOrdering::NESTED_DISSECTION})
+    {
+        NuTo::Structure s(2);
+        SetupStructure(s, ordering);
+        BOOST_CHECK(s.GetDofOrdering() == ordering);
+        CheckPermutedHessian(reference, s);
+        if (ordering == eDofOrdering::REVERSE_CUTHILL_MCKEE)
+            BOOST_CHECK_LT(2 * Bandwidth(ReducedHessian(s)), referenceBandwidth);
+    }
+}
+
+BOOST_AUTO_TEST_CASE(DofOrderingChange)
+{
+    NuTo::Structure reference(2);
+    NuTo::Structure s(2);
+    SetupStructure(reference, eDofOrdering::NODE_ID);
+    SetupStructure(s, eDofOrdering::NODE_ID);
+    const int referenceBandwidth = Bandwidth(ReducedHessian(s));
+
+    // the dofs are renumbered in the next evaluation
+    s.SetDofOrdering(eDofOrdering::REVERSE_CUTHILL_MCKEE);
+    BOOST_CHECK(s.GetAssembler().RenumberingRequired());
+    BOOST_CHECK_LT(2 * Bandwidth(ReducedHessian(s)), referenceBandwidth);
+    CheckPermutedHessian(reference, s);
+
+    s.SetDofOrdering(eDofOrdering::NODE_ID);
+    BOOST_CHECK_EQUAL(Bandwidth(ReducedHessian(s)), referenceBandwidth);
+}
@@ -0,0 +1,134 @@
+#include "BoostUnitTest.h"
+
+#include "ElementKernel_Setup.h"
+
+#include "mechanics/dofSubMatrixStorage/BlockFullVector.h"
+#include "mechanics/dofSubMatrixStorage/BlockSparseMatrix.h"
+#include "mechanics/structures/StructureOutputBlockMatrix.h"
+#include "mechanics/structures/StructureOutputBlockVector.h"
+
+using NuTo::Interpolation::eShapeType;
+using NuTo::Interpolation::eTypeOrder;
+
+//! @brief adds a second linear elastic law to some elements, such that some batches are incomplete
+void AddSecondLaw(NuTo::Structure& rStructure)
+{
+    rStructure.ConstitutiveLawCreate(1, NuTo::Constitutive::eConstitutiveType::LINEAR_ELASTIC_ENGINEERING_STRESS);
+    rStructure.ConstitutiveLawSetParameterDouble(1, NuTo::Constitutive::eConstitutiveParameter::YOUNGS_MODULUS, 40000);
+    rStructure.ConstitutiveLawSetParameterDouble(1, NuTo::Constitutive::eConstitutiveParameter::POISSONS_RATIO, .2);
+
+    int groupId = rStructure.GroupGetElementsTotal();
+    for (int elementId : rStructure.GroupGetMemberIds(groupId))
+        if (elementId % 7 == 3)
+            rStructure.ElementSetConstitutiveLaw(elementId, 1);
+    rStructure.GroupDelete(groupId);
+}
+
+//! @brief assigns a local damage model to all elements but some of the ones with the law 0 or 1 of AddSecondLaw
+void AddDamageLaw(NuTo::Structure& rStructure)
+{
+    CreateDamageLaw(rStructure, 2);
+    int groupId = rStructure.GroupGetElementsTotal();
+    for (int elementId : rStructure.GroupGetMemberIds(groupId))
+        if (elementId % 7 != 3 and elementId % 5 != 1)
+            rStructure.ElementSetConstitutiveLaw(elementId, 2);
+    rStructure.GroupDelete(groupId);
+}
+
+//! @brief scales the displacements of all nodes by rFactor
+void ScaleDisplacements(NuTo::Structure& rStructure, double rFactor)
+{
+    int groupId = rStructure.GroupGetNodesTotal();
+    for (int nodeId : rStructure.GroupGetMemberIds(groupId))
+    {
+        NuTo::NodeBase* node = rStructure.NodeGetNodePtr(nodeId);
+        node->Set(NuTo::Node::eDof::DISPLACEMENTS, rFactor * node->Get(NuTo::Node::eDof::DISPLACEMENTS));
+    }
+    rStructure.GroupDelete(groupId);
+}
+
+//! @brief compares the global hessian and internal gradient with and without batches
+//! @return hessian JJ
+Eigen::MatrixXd CheckEqual(NuTo::Structure& rStructure)
+{
+    rStructure.SetUseElementBatches(true);
+    auto hessianBatches = rStructure.BuildGlobalHessian0();
+    auto gradientBatches = rStructure.BuildGlobalInternalGradient();
+
+    rStructure.SetUseElementBatches(false);
+    auto hessian = rStructure.BuildGlobalHessian0();
+    auto gradient = rStructure.BuildGlobalInternalGradient();
+
+    const Eigen::MatrixXd k = Eigen::MatrixXd(hessian.JJ.ExportToEigenSparseMatrix());
+    const Eigen::MatrixXd kBatches = Eigen::MatrixXd(hessianBatches.JJ.ExportToEigenSparseMatrix());
+    BOOST_CHECK_GT(k.norm(), 0.);
+    BOOST_CHECK_SMALL((kBatches - k).norm() / k.norm(), 1.e-12);
+
+    const Eigen::MatrixXd kk = Eigen::MatrixXd(hessian.KK.ExportToEigenSparseMatrix());
+    const Eigen::MatrixXd kkBatches = Eigen::MatrixXd(hessianBatches.KK.ExportToEigenSparseMatrix());
+    BOOST_CHECK_SMALL((kkBatches - kk).norm(), 1.e-12 * k.norm());
+
+    const Eigen::VectorXd f = gradient.J.Export();
+    BOOST_CHECK_GT(f.norm(), 0.);
+    BOOST_CHECK_SMALL((gradientBatches.J.Export() - f).norm() / f.norm(), 1.e-12);
+    return k;
+}
+
+//! @brief compares the evaluation with and without batches, with and without geometry caches
+void CheckBatches(eShapeType rShape, eTypeOrder rOrder, int rDimension)
+{
+    NuTo::Structure s(rDimension);
+    SetupStructure(s, rShape, rOrder, {3, 5, 2}, true);
+    AddSecondLaw(s);
+    MoveNodes(s, 0.05);
+    // disabled by default
+    BOOST_CHECK(not s.GetUseElementBatches());
+    CheckEqual(s);
+
+    // the batches use the cached geometry of the elements
+    s.SetUseGeometryCache(true);
+    CheckEqual(s);
+}
+
+//! @brief compares the evaluation of damaged elements with and without batches, while the damage evolves and after
+//! unloading, where the tangents are (1 - omega) C
+void CheckDamage(eShapeType rShape, eTypeOrder rOrder, int rDimension)
+{
+    NuTo::Structure s(rDimension);
+    SetupStructure(s, rShape, rOrder, {3, 5, 2}, true);
+    AddSecondLaw(s);
+    AddDamageLaw(s);
+    MoveNodes(s, 0.05);
+
+    // the tangents of the evolving damage are not symmetric
+    const Eigen::MatrixXd kLoading = CheckEqual(s);
+    BOOST_CHECK_GT((kLoading - kLoading.transpose()).norm(), 1.e-6 * kLoading.norm());
+
+    s.ElementTotalUpdateStaticData();
+    ScaleDisplacements(s, 0.5);
+    const Eigen::MatrixXd kUnloading = CheckEqual(s);
+    BOOST_CHECK_SMALL((kUnloading - kUnloading.transpose()).norm(), 1.e-12 * kUnloading.norm());
+
+    s.SetUseGeometryCache(true);
+    CheckEqual(s);
+}
+
+BOOST_AUTO_TEST_CASE(ElementBatch2D)
+{
+    CheckAllShapes(2, CheckBatches);
+}
+
+BOOST_AUTO_TEST_CASE(ElementBatch3D)
+{
+    CheckAllShapes(3, CheckBatches);
+}
+
+BOOST_AUTO_TEST_CASE(ElementBatchDamage2D)
+{
+    CheckAllShapes(2, CheckDamage);
+}
+
+BOOST_AUTO_TEST_CASE(ElementBatchDamage3D)
+{
+    CheckAllShapes(3, CheckDamage);
+}
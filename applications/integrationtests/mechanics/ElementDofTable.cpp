@@ -0,0 +1,100 @@
+#include "BoostUnitTest.h"
+
+#include "mechanics/structures/unstructured/Structure.h"
+#include "mechanics/MechanicsEnums.h"
+#include "mechanics/constraints/ConstraintCompanion.h"
+#include "mechanics/dofSubMatrixStorage/BlockFullVector.h"
+#include "mechanics/elements/ElementBase.h"
+#include "mechanics/elements/ElementOutputBlockVectorInt.h"
+#include "mechanics/groups/Group.h"
+#include "mechanics/mesh/MeshGenerator.h"
+#include "mechanics/sections/SectionPlane.h"
+#include "mechanics/structures/ElementDofTable.h"
+#include "mechanics/structures/StructureOutputBlockMatrix.h"
+
+void SetupStructure(NuTo::Structure& rStructure)
+{
+    rStructure.SetShowTime(false);
+    rStructure.SetVerboseLevel(0);
+
+    int interpolationType = NuTo::MeshGenerator::Grid(rStructure, {2., 3.}, {3, 2}).second;
+    rStructure.InterpolationTypeAdd(interpolationType, NuTo::Node::eDof::DISPLACEMENTS,
+                                    NuTo::Interpolation::eTypeOrder::EQUIDISTANT2);
+    rStructure.InterpolationTypeAdd(interpolationType, NuTo::Node::eDof::TEMPERATURE,
+                                    NuTo::Interpolation::eTypeOrder::EQUIDISTANT1);
+    rStructure.ElementTotalConvertToInterpolationType();
+    rStructure.ElementTotalSetSection(NuTo::SectionPlane::Create(1., false));
+
+    rStructure.ConstitutiveLawCreate(0, NuTo::Constitutive::eConstitutiveType::LINEAR_ELASTIC_ENGINEERING_STRESS);
+    rStructure.ConstitutiveLawSetParameterDouble(0, NuTo::Constitutive::eConstitutiveParameter::YOUNGS_MODULUS, 20000);
+    rStructure.ConstitutiveLawSetParameterDouble(0, NuTo::Constitutive::eConstitutiveParameter::POISSONS_RATIO, .2);
+    rStructure.ElementTotalSetConstitutiveLaw(0);
+}
+
+//! @brief compares the cached dof numbers of all elements with the ones calculated by the elements
+void CheckTable(NuTo::Structure& rStructure)
+{
+    const auto& table = rStructure.GetElementDofTable();
+
+    BOOST_CHECK_EQUAL(table.GetNumElements(), rStructure.GetNumElements());
+
+    int groupId = rStructure.GroupGetElementsTotal();
+    for (int elementId : rStructure.GroupGetMemberIds(groupId))
+    {
+        NuTo::ElementBase* element = rStructure.ElementGetElementPtr(elementId);
+        std::map<NuTo::Element::eOutput, std::shared_ptr<NuTo::ElementOutputBase>> elementOutputMap;
+        elementOutputMap[NuTo::Element::eOutput::GLOBAL_ROW_DOF] =
+                std::make_shared<NuTo::ElementOutputBlockVectorInt>(rStructure.GetDofStatus());
+        element->Evaluate(elementOutputMap);
+        const auto& expected = elementOutputMap.at(NuTo::Element::eOutput::GLOBAL_ROW_DOF)->GetBlockFullVectorInt();
+
+        for (auto dof : rStructure.DofTypesGetActive())
+        {
+            BOOST_CHECK(table.GetRowDofs(*element)[dof] == expected[dof]);
+            BOOST_CHECK(table.GetColumnDofs(*element)[dof] == expected[dof]);
+        }
+    }
+    rStructure.GroupDelete(groupId);
+}
+
+BOOST_AUTO_TEST_CASE(ElementDofTableRenumbering)
+{
+    NuTo::Structure s(2);
+    SetupStructure(s);
+    s.NodeBuildGlobalDofs();
+    CheckTable(s);
+
+    // constraints change the dof numbering
+    auto& nodesLeft = s.GroupGetNodesAtCoordinate(NuTo::eDirection::X, 0.);
+    s.Constraints().Add(NuTo::Node::eDof::DISPLACEMENTS,
+                        NuTo::Constraint::Component(nodesLeft, {NuTo::eDirection::X, NuTo::eDirection::Y}));
+    s.NodeBuildGlobalDofs();
+    CheckTable(s);
+}
+
+BOOST_AUTO_TEST_CASE(ElementDofTableActiveDofs)
+{
+    NuTo::Structure s(2);
+    SetupStructure(s);
+    s.NodeBuildGlobalDofs();
+    CheckTable(s);
+
+    s.DofTypeSetIsActive(NuTo::Node::eDof::TEMPERATURE, false);
+    CheckTable(s);
+
+    s.DofTypeSetIsActive(NuTo::Node::eDof::TEMPERATURE, true);
+    CheckTable(s);
+}
+
+BOOST_AUTO_TEST_CASE(ElementDofTableDeleteElement)
+{
+    NuTo::Structure s(2);
+    SetupStructure(s);
+    s.NodeBuildGlobalDofs();
+    CheckTable(s);
+
+    s.ElementDelete(0);
+    s.NodeBuildGlobalDofs();
+    CheckTable(s);
+    BOOST_CHECK_EQUAL(s.GetElementDofTable().GetNumElements(), 5);
+}
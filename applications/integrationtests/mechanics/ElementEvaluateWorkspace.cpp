@@ -0,0 +1,192 @@
+#include "BoostUnitTest.h"
+
+#include <atomic>
+#include <cstdlib>
+#include <new>
+
+#include "mechanics/structures/unstructured/Structure.h"
+#include "mechanics/MechanicsEnums.h"
+#include "mechanics/constitutive/inputoutput/ConstitutiveCalculateStaticData.h"
+#include "mechanics/dofSubMatrixStorage/BlockFullMatrix.h"
+#include "mechanics/dofSubMatrixStorage/BlockFullVector.h"
+#include "mechanics/elements/ElementBase.h"
+#include "mechanics/elements/ElementOutputBlockMatrixDouble.h"
+#include "mechanics/elements/ElementOutputBlockVectorDouble.h"
+#include "mechanics/groups/Group.h"
+#include "mechanics/mesh/MeshGenerator.h"
+#include "mechanics/nodes/NodeBase.h"
+
+//! @brief counts the calls of the global operator new
+std::atomic<long> numAllocations(0);
+
+void* operator new(std::size_t rSize)
+{
+    ++numAllocations;
+    if (void* ptr = std::malloc(rSize == 0 ? 1 : rSize))
+        return ptr;
+    throw std::bad_alloc();
+}
+
+void operator delete(void* rPtr) noexcept
+{
+    std::free(rPtr);
+}
+
+void operator delete(void* rPtr, std::size_t) noexcept
+{
+    std::free(rPtr);
+}
+
+void SetupStructure(NuTo::Structure& rStructure, NuTo::Interpolation::eTypeOrder rOrder)
+{
+    rStructure.SetShowTime(false);
+    rStructure.SetVerboseLevel(0);
+
+    int interpolationType = NuTo::MeshGenerator::Grid(rStructure, {2., 3., 4.}, {2, 2, 2}).second;
+    rStructure.InterpolationTypeAdd(interpolationType, NuTo::Node::eDof::DISPLACEMENTS, rOrder);
+    rStructure.ElementTotalConvertToInterpolationType();
+
+    rStructure.ConstitutiveLawCreate(0, NuTo::Constitutive::eConstitutiveType::LINEAR_ELASTIC_ENGINEERING_STRESS);
+    rStructure.ConstitutiveLawSetParameterDouble(0, NuTo::Constitutive::eConstitutiveParameter::YOUNGS_MODULUS, 20000);
+    rStructure.ConstitutiveLawSetParameterDouble(0, NuTo::Constitutive::eConstitutiveParameter::POISSONS_RATIO, .2);
+    rStructure.ConstitutiveLawSetParameterDouble(0, NuTo::Constitutive::eConstitutiveParameter::DENSITY, 1.5);
+    rStructure.ElementTotalSetConstitutiveLaw(0);
+    rStructure.NodeBuildGlobalDofs();
+
+    // nonzero displacements for nonzero internal gradients
+    int groupId = rStructure.GroupGetNodesTotal();
+    for (int nodeId : rStructure.GroupGetMemberIds(groupId))
+    {
+        NuTo::NodeBase* node = rStructure.NodeGetNodePtr(nodeId);
+        Eigen::VectorXd coordinates = node->Get(NuTo::Node::eDof::COORDINATES);
+        node->Set(NuTo::Node::eDof::DISPLACEMENTS, 0.01 * coordinates.cwiseProduct(coordinates));
+    }
+    rStructure.GroupDelete(groupId);
+}
+
+//! @brief element outputs of all elements of a structure
+struct Outputs
+{
+    std::vector<Eigen::VectorXd> mInternalGradients;
+    std::vector<Eigen::MatrixXd> mHessians0;
+    std::vector<Eigen::MatrixXd> mHessians2;
+};
+
+class ElementEvaluator
+{
+public:
+    ElementEvaluator(NuTo::Structure& rStructure)
+    {
+        int groupId = rStructure.GroupGetElementsTotal();
+        for (int elementId : rStructure.GroupGetMemberIds(groupId))
+            mElements.push_back(rStructure.ElementGetElementPtr(elementId));
+        rStructure.GroupDelete(groupId);
+
+        // like in the assembly of the structure, the input is created once for all elements
+        mInput[NuTo::Constitutive::eInput::CALCULATE_STATIC_DATA] =
+                std::make_unique<NuTo::ConstitutiveCalculateStaticData>(NuTo::eCalculateStaticData::EULER_BACKWARD);
+
+        mElementOutput[NuTo::Element::eOutput::INTERNAL_GRADIENT] =
+                std::make_shared<NuTo::ElementOutputBlockVectorDouble>(rStructure.GetDofStatus());
+        mElementOutput[NuTo::Element::eOutput::HESSIAN_0_TIME_DERIVATIVE] =
+                std::make_shared<NuTo::ElementOutputBlockMatrixDouble>(rStructure.GetDofStatus());
+        mElementOutput[NuTo::Element::eOutput::HESSIAN_2_TIME_DERIVATIVE] =
+                std::make_shared<NuTo::ElementOutputBlockMatrixDouble>(rStructure.GetDofStatus());
+    }
+
+    //! @brief evaluates all elements without storing the outputs
+    void Evaluate()
+    {
+        for (NuTo::ElementBase* element : mElements)
+            element->Evaluate(mInput, mElementOutput);
+    }
+
+    //! @brief evaluates all elements and exports the outputs
+    Outputs EvaluateAndExport()
+    {
+        Outputs outputs;
+        for (NuTo::ElementBase* element : mElements)
+        {
+            element->Evaluate(mInput, mElementOutput);
+            using NuTo::Element::eOutput;
+            outputs.mInternalGradients.push_back(
+                    mElementOutput.at(eOutput::INTERNAL_GRADIENT)->GetBlockFullVectorDouble().Export());
+            outputs.mHessians0.push_back(
+                    mElementOutput.at(eOutput::HESSIAN_0_TIME_DERIVATIVE)->GetBlockFullMatrixDouble().Export());
+            outputs.mHessians2.push_back(
+                    mElementOutput.at(eOutput::HESSIAN_2_TIME_DERIVATIVE)->GetBlockFullMatrixDouble().Export());
+        }
+        return outputs;
+    }
+
+private:
+    std::vector<NuTo::ElementBase*> mElements;
+    NuTo::ConstitutiveInputMap mInput;
+    std::map<NuTo::Element::eOutput, std::shared_ptr<NuTo::ElementOutputBase>> mElementOutput;
+};
+
+void CheckEqual(const Outputs& rExpected, const Outputs& rActual)
+{
+    BOOST_REQUIRE_EQUAL(rExpected.mInternalGradients.size(), rActual.mInternalGradients.size());
+    for (unsigned i = 0; i < rExpected.mInternalGradients.size(); ++i)
+    {
+        BOOST_CHECK_GT(rExpected.mInternalGradients[i].norm(), 0.);
+        BOOST_CHECK_GT(rExpected.mHessians0[i].norm(), 0.);
+        BOOST_CHECK_GT(rExpected.mHessians2[i].norm(), 0.);
+        BOOST_CHECK((rExpected.mInternalGradients[i] - rActual.mInternalGradients[i]).isZero());
+        BOOST_CHECK((rExpected.mHessians0[i] - rActual.mHessians0[i]).isZero());
+        BOOST_CHECK((rExpected.mHessians2[i] - rActual.mHessians2[i]).isZero());
+    }
+}
+
+BOOST_AUTO_TEST_CASE(ElementEvaluateWorkspaceNoAllocations)
+{
+    NuTo::Structure s(3);
+    SetupStructure(s, NuTo::Interpolation::eTypeOrder::EQUIDISTANT2);
+    ElementEvaluator evaluator(s);
+
+    // the first element prepares the workspace
+    evaluator.Evaluate();
+
+    numAllocations = 0;
+    evaluator.Evaluate();
+    BOOST_CHECK_EQUAL(numAllocations, 0);
+}
+
+BOOST_AUTO_TEST_CASE(ElementEvaluateWorkspaceChangingElements)
+{
+    NuTo::Structure a(3);
+    NuTo::Structure b(3);
+    SetupStructure(a, NuTo::Interpolation::eTypeOrder::EQUIDISTANT2);
+    SetupStructure(b, NuTo::Interpolation::eTypeOrder::EQUIDISTANT1);
+    ElementEvaluator evaluatorA(a);
+    ElementEvaluator evaluatorB(b);
+
+    Outputs outputsA = evaluatorA.EvaluateAndExport();
+    Outputs outputsB = evaluatorB.EvaluateAndExport();
+
+    // the workspace was prepared for b and has to be rebuilt for a
+    CheckEqual(outputsA, evaluatorA.EvaluateAndExport());
+
+    // a new output map with new element output objects
+    ElementEvaluator freshEvaluatorB(b);
+    CheckEqual(outputsB, freshEvaluatorB.EvaluateAndExport());
+}
+
+BOOST_AUTO_TEST_CASE(ElementEvaluateWorkspaceOtherStructures)
+{
+    NuTo::Structure s(3);
+    SetupStructure(s, NuTo::Interpolation::eTypeOrder::EQUIDISTANT2);
+    ElementEvaluator evaluator(s);
+    evaluator.Evaluate();
+
+    // destroying the constitutive laws, interpolation and integration types of another structure keeps the workspace
+    {
+        NuTo::Structure other(3);
+        SetupStructure(other, NuTo::Interpolation::eTypeOrder::EQUIDISTANT1);
+    }
+
+    numAllocations = 0;
+    evaluator.Evaluate();
+    BOOST_CHECK_EQUAL(numAllocations, 0);
+}
@@ -0,0 +1,99 @@
+#pragma once
+
+#include <functional>
+#include <vector>
+
+#include "mechanics/structures/unstructured/Structure.h"
+#include "mechanics/MechanicsEnums.h"
+#include "mechanics/constitutive/damageLaws/DamageLawExponential.h"
+#include "mechanics/groups/Group.h"
+#include "mechanics/mesh/MeshGenerator.h"
+#include "mechanics/nodes/NodeBase.h"
+#include "mechanics/sections/SectionPlane.h"
+#include "mechanics/sections/SectionTruss.h"
+
+// setup of the tests that compare optimized element evaluations with the generic evaluation, e.g. the fixed-size
+// kernels, the geometry cache and the element batches
+
+//! @brief grid of rShape elements with rOrder displacement interpolations and the linear elastic law 0
+//! @param rNumElements ... number of elements in x, y and z direction, only the first GetDimension() are used
+//! @param rPlaneStress ... plane state of the 2D section
+inline void SetupStructure(NuTo::Structure& rStructure, NuTo::Interpolation::eShapeType rShape,
+                           NuTo::Interpolation::eTypeOrder rOrder, const std::vector<int>& rNumElements,
+                           bool rPlaneStress = false)
+{
+    rStructure.SetShowTime(false);
+    rStructure.SetVerboseLevel(0);
+
+    const int dimension = rStructure.GetDimension();
+    const std::vector<double> end = {2., 3., 4.};
+    int interpolationType = NuTo::MeshGenerator::Grid(rStructure, {end.begin(), end.begin() + dimension},
+                                                      {rNumElements.begin(), rNumElements.begin() + dimension}, rShape)
+                                    .second;
+    rStructure.InterpolationTypeAdd(interpolationType, NuTo::Node::eDof::DISPLACEMENTS, rOrder);
+    rStructure.ElementTotalConvertToInterpolationType();
+    if (dimension == 1)
+        rStructure.ElementTotalSetSection(NuTo::SectionTruss::Create(0.3));
+    if (dimension == 2)
+        rStructure.ElementTotalSetSection(NuTo::SectionPlane::Create(0.7, rPlaneStress));
+
+    rStructure.ConstitutiveLawCreate(0, NuTo::Constitutive::eConstitutiveType::LINEAR_ELASTIC_ENGINEERING_STRESS);
+    rStructure.ConstitutiveLawSetParameterDouble(0, NuTo::Constitutive::eConstitutiveParameter::YOUNGS_MODULUS, 20000);
+    rStructure.ConstitutiveLawSetParameterDouble(0, NuTo::Constitutive::eConstitutiveParameter::POISSONS_RATIO, .2);
+    rStructure.ConstitutiveLawSetParameterDouble(0, NuTo::Constitutive::eConstitutiveParameter::DENSITY, 1.);
+    rStructure.ElementTotalSetConstitutiveLaw(0);
+    rStructure.NodeBuildGlobalDofs();
+}
+
+//! @brief creates a local damage model with the id rId, the displacements of MoveNodes damage most integration points
+inline void CreateDamageLaw(NuTo::Structure& rStructure, int rId)
+{
+    rStructure.ConstitutiveLawCreate(rId, NuTo::Constitutive::eConstitutiveType::LOCAL_DAMAGE_MODEL);
+    rStructure.ConstitutiveLawSetParameterDouble(rId, NuTo::Constitutive::eConstitutiveParameter::YOUNGS_MODULUS,
+                                                 20000);
+    rStructure.ConstitutiveLawSetParameterDouble(rId, NuTo::Constitutive::eConstitutiveParameter::POISSONS_RATIO, .2);
+    rStructure.ConstitutiveLawSetParameterDouble(rId, NuTo::Constitutive::eConstitutiveParameter::DENSITY, 1.);
+    rStructure.ConstitutiveLawSetParameterDouble(rId, NuTo::Constitutive::eConstitutiveParameter::TENSILE_STRENGTH,
+                                                 600.);
+    rStructure.ConstitutiveLawSetParameterDouble(rId, NuTo::Constitutive::eConstitutiveParameter::COMPRESSIVE_STRENGTH,
+                                                 6000.);
+    rStructure.ConstitutiveLawSetDamageLaw(rId, NuTo::Constitutive::DamageLawExponential::Create(600. / 20000., 20.));
+}
+
+//! @brief sets nonzero displacements and distorts the node coordinates by rDistortion
+inline void MoveNodes(NuTo::Structure& rStructure, double rDistortion)
+{
+    int groupId = rStructure.GroupGetNodesTotal();
+    for (int nodeId : rStructure.GroupGetMemberIds(groupId))
+    {
+        NuTo::NodeBase* node = rStructure.NodeGetNodePtr(nodeId);
+        Eigen::VectorXd coordinates = node->Get(NuTo::Node::eDof::COORDINATES);
+        node->Set(NuTo::Node::eDof::DISPLACEMENTS, 0.01 * coordinates.cwiseProduct(coordinates));
+        node->Set(NuTo::Node::eDof::COORDINATES,
+                  coordinates + rDistortion * coordinates.array().sin().matrix().reverse());
+    }
+    rStructure.GroupDelete(groupId);
+}
+
+//! @brief calls rCheck for all continuum shapes of rDimension with linear and quadratic interpolations
+inline void CheckAllShapes(int rDimension,
+                           const std::function<void(NuTo::Interpolation::eShapeType, NuTo::Interpolation::eTypeOrder,
+                                                    int)>& rCheck)
+{
+    using NuTo::Interpolation::eShapeType;
+    std::vector<eShapeType> shapes;
+    switch (rDimension)
+    {
+    case 1:
+        shapes = {eShapeType::TRUSS1D};
+        break;
+    case 2:
+        shapes = {eShapeType::TRIANGLE2D, eShapeType::QUAD2D};
+        break;
+    default:
+        shapes = {eShapeType::TETRAHEDRON3D, eShapeType::BRICK3D};
+    }
+    for (auto shape : shapes)
+        for (auto order : {NuTo::Interpolation::eTypeOrder::EQUIDISTANT1, NuTo::Interpolation::eTypeOrder::EQUIDISTANT2})
+            rCheck(shape, order, rDimension);
+}
@@ -0,0 +1,104 @@
+#include "BoostUnitTest.h"
+
+#include <algorithm>
+
+#include "ElementKernel_Setup.h"
+
+#include "mechanics/constitutive/inputoutput/ConstitutiveCalculateStaticData.h"
+#include "mechanics/dofSubMatrixStorage/BlockFullMatrix.h"
+#include "mechanics/dofSubMatrixStorage/BlockFullVector.h"
+#include "mechanics/elements/ElementBase.h"
+#include "mechanics/elements/ElementOutputBlockMatrixDouble.h"
+#include "mechanics/elements/ElementOutputBlockVectorDouble.h"
+
+using NuTo::Interpolation::eShapeType;
+using NuTo::Interpolation::eTypeOrder;
+using NuTo::Element::eOutput;
+
+//! @brief compares the element outputs of the fixed-size kernels with the generic evaluation
+//! @return maximum of the relative asymmetries of the element hessians
+double CompareElements(NuTo::Structure& s)
+{
+    NuTo::ConstitutiveInputMap input;
+    input[NuTo::Constitutive::eInput::CALCULATE_STATIC_DATA] =
+            std::make_unique<NuTo::ConstitutiveCalculateStaticData>(NuTo::eCalculateStaticData::EULER_BACKWARD);
+
+    const auto& dofStatus = s.GetDofStatus();
+    auto internalGradient = std::make_shared<NuTo::ElementOutputBlockVectorDouble>(dofStatus);
+    auto hessian0 = std::make_shared<NuTo::ElementOutputBlockMatrixDouble>(dofStatus);
+    std::map<eOutput, std::shared_ptr<NuTo::ElementOutputBase>> fixedSizeOutput;
+    fixedSizeOutput[eOutput::INTERNAL_GRADIENT] = internalGradient;
+    fixedSizeOutput[eOutput::HESSIAN_0_TIME_DERIVATIVE] = hessian0;
+
+    // the mass matrix requires the generic evaluation
+    auto internalGradientGeneric = std::make_shared<NuTo::ElementOutputBlockVectorDouble>(dofStatus);
+    auto hessian0Generic = std::make_shared<NuTo::ElementOutputBlockMatrixDouble>(dofStatus);
+    std::map<eOutput, std::shared_ptr<NuTo::ElementOutputBase>> genericOutput;
+    genericOutput[eOutput::INTERNAL_GRADIENT] = internalGradientGeneric;
+    genericOutput[eOutput::HESSIAN_0_TIME_DERIVATIVE] = hessian0Generic;
+    genericOutput[eOutput::HESSIAN_2_TIME_DERIVATIVE] =
+            std::make_shared<NuTo::ElementOutputBlockMatrixDouble>(dofStatus);
+
+    constexpr auto disp = NuTo::Node::eDof::DISPLACEMENTS;
+    double asymmetry = 0.;
+    int groupId = s.GroupGetElementsTotal();
+    for (int elementId : s.GroupGetMemberIds(groupId))
+    {
+        NuTo::ElementBase* element = s.ElementGetElementPtr(elementId);
+        element->Evaluate(input, fixedSizeOutput);
+        element->Evaluate(input, genericOutput);
+
+        const Eigen::MatrixXd& k = hessian0Generic->GetBlockFullMatrixDouble()(disp, disp);
+        const Eigen::MatrixXd& kFixedSize = hessian0->GetBlockFullMatrixDouble()(disp, disp);
+        BOOST_CHECK_GT(k.norm(), 0.);
+        BOOST_CHECK_SMALL((kFixedSize - k).norm() / k.norm(), 1.e-12);
+        asymmetry = std::max(asymmetry, (kFixedSize - kFixedSize.transpose()).norm() / k.norm());
+
+        const Eigen::VectorXd& f = internalGradientGeneric->GetBlockFullVectorDouble()[disp];
+        const Eigen::VectorXd& fFixedSize = internalGradient->GetBlockFullVectorDouble()[disp];
+        BOOST_CHECK_GT(f.norm(), 0.);
+        BOOST_CHECK_SMALL((fFixedSize - f).norm() / f.norm(), 1.e-12);
+    }
+    s.GroupDelete(groupId);
+    return asymmetry;
+}
+
+void CheckElements(eShapeType rShape, eTypeOrder rOrder, int rDimension)
+{
+    NuTo::Structure s(rDimension);
+    SetupStructure(s, rShape, rOrder, {3, 3, 2});
+    MoveNodes(s, 0.05);
+    BOOST_CHECK_SMALL(CompareElements(s), 1.e-14);
+}
+
+//! @brief the tangents of evolving damage are not symmetric
+void CheckDamage(eShapeType rShape, eTypeOrder rOrder, int rDimension)
+{
+    NuTo::Structure s(rDimension);
+    SetupStructure(s, rShape, rOrder, {3, 3, 2});
+    CreateDamageLaw(s, 1);
+    s.ElementTotalSetConstitutiveLaw(1);
+    MoveNodes(s, 0.05);
+    BOOST_CHECK_GT(CompareElements(s), 1.e-6);
+}
+
+BOOST_AUTO_TEST_CASE(FixedSizeKernelTruss)
+{
+    CheckAllShapes(1, CheckElements);
+}
+
+BOOST_AUTO_TEST_CASE(FixedSizeKernel2D)
+{
+    CheckAllShapes(2, CheckElements);
+}
+
+BOOST_AUTO_TEST_CASE(FixedSizeKernel3D)
+{
+    CheckAllShapes(3, CheckElements);
+}
+
+BOOST_AUTO_TEST_CASE(FixedSizeKernelDamage)
+{
+    CheckAllShapes(2, CheckDamage);
+    CheckAllShapes(3, CheckDamage);
+}
@@ -0,0 +1,108 @@
+#include "BoostUnitTest.h"
+
+#include "ElementKernel_Setup.h"
+
+#include "mechanics/constitutive/inputoutput/ConstitutiveCalculateStaticData.h"
+#include "mechanics/dofSubMatrixStorage/BlockFullMatrix.h"
+#include "mechanics/dofSubMatrixStorage/BlockFullVector.h"
+#include "mechanics/elements/ElementBase.h"
+#include "mechanics/elements/ElementOutputBlockMatrixDouble.h"
+#include "mechanics/elements/ElementOutputBlockVectorDouble.h"
+
+using NuTo::Interpolation::eShapeType;
+using NuTo::Interpolation::eTypeOrder;
+using NuTo::Element::eOutput;
+
+//! @brief element hessians and internal gradients of all elements
+//! @param rGeneric ... true, to request the mass matrix, which requires the generic evaluation
+std::pair<std::vector<Eigen::MatrixXd>, std::vector<Eigen::VectorXd>> EvaluateElements(NuTo::Structure& rStructure,
+                                                                                        bool rGeneric)
+{
+    NuTo::ConstitutiveInputMap input;
+    input[NuTo::Constitutive::eInput::CALCULATE_STATIC_DATA] =
+            std::make_unique<NuTo::ConstitutiveCalculateStaticData>(NuTo::eCalculateStaticData::EULER_BACKWARD);
+
+    const auto& dofStatus = rStructure.GetDofStatus();
+    auto internalGradient = std::make_shared<NuTo::ElementOutputBlockVectorDouble>(dofStatus);
+    auto hessian0 = std::make_shared<NuTo::ElementOutputBlockMatrixDouble>(dofStatus);
+    std::map<eOutput, std::shared_ptr<NuTo::ElementOutputBase>> output;
+    output[eOutput::INTERNAL_GRADIENT] = internalGradient;
+    output[eOutput::HESSIAN_0_TIME_DERIVATIVE] = hessian0;
+    if (rGeneric)
+        output[eOutput::HESSIAN_2_TIME_DERIVATIVE] = std::make_shared<NuTo::ElementOutputBlockMatrixDouble>(dofStatus);
+
+    constexpr auto disp = NuTo::Node::eDof::DISPLACEMENTS;
+    std::pair<std::vector<Eigen::MatrixXd>, std::vector<Eigen::VectorXd>> result;
+    int groupId = rStructure.GroupGetElementsTotal();
+    for (int elementId : rStructure.GroupGetMemberIds(groupId))
+    {
+        rStructure.ElementGetElementPtr(elementId)->Evaluate(input, output);
+        result.first.push_back(hessian0->GetBlockFullMatrixDouble()(disp, disp));
+        result.second.push_back(internalGradient->GetBlockFullVectorDouble()[disp]);
+    }
+    rStructure.GroupDelete(groupId);
+    return result;
+}
+
+void CheckEqual(const std::pair<std::vector<Eigen::MatrixXd>, std::vector<Eigen::VectorXd>>& rExpected,
+                const std::pair<std::vector<Eigen::MatrixXd>, std::vector<Eigen::VectorXd>>& rActual)
+{
+    BOOST_REQUIRE_EQUAL(rExpected.first.size(), rActual.first.size());
+    for (unsigned i = 0; i < rExpected.first.size(); ++i)
+    {
+        BOOST_CHECK_GT(rExpected.first[i].norm(), 0.);
+        BOOST_CHECK_SMALL((rActual.first[i] - rExpected.first[i]).norm() / rExpected.first[i].norm(), 1.e-12);
+        BOOST_CHECK_GT(rExpected.second[i].norm(), 0.);
+        BOOST_CHECK_SMALL((rActual.second[i] - rExpected.second[i]).norm() / rExpected.second[i].norm(), 1.e-12);
+    }
+}
+
+//! @brief compares the evaluation with and without geometry cache, also after the node coordinates have changed
+void CheckGeometryCache(eShapeType rShape, eTypeOrder rOrder, int rDimension)
+{
+    NuTo::Structure s(rDimension);
+    SetupStructure(s, rShape, rOrder, {3, 3, 2});
+    MoveNodes(s, 0.05);
+
+    // disabled by default
+    BOOST_CHECK(not s.GetUseGeometryCache());
+    s.SetUseGeometryCache(true);
+
+    for (bool generic : {true, false})
+    {
+        BOOST_CHECK(s.GetUseGeometryCache());
+        auto cached = EvaluateElements(s, generic);
+        auto cachedAgain = EvaluateElements(s, generic);
+
+        s.SetUseGeometryCache(false);
+        auto uncached = EvaluateElements(s, generic);
+        CheckEqual(uncached, cached);
+        CheckEqual(uncached, cachedAgain);
+
+        // the caches of the new node coordinates are rebuilt
+        s.SetUseGeometryCache(true);
+        EvaluateElements(s, generic);
+        MoveNodes(s, 0.02);
+        auto cachedMoved = EvaluateElements(s, generic);
+        s.SetUseGeometryCache(false);
+        auto uncachedMoved = EvaluateElements(s, generic);
+        CheckEqual(uncachedMoved, cachedMoved);
+        BOOST_CHECK_GT((uncachedMoved.first[0] - uncached.first[0]).norm(), 1.e-6 * uncached.first[0].norm());
+        s.SetUseGeometryCache(true);
+    }
+}
+
+BOOST_AUTO_TEST_CASE(GeometryCacheTruss)
+{
+    CheckAllShapes(1, CheckGeometryCache);
+}
+
+BOOST_AUTO_TEST_CASE(GeometryCache2D)
+{
+    CheckAllShapes(2, CheckGeometryCache);
+}
+
+BOOST_AUTO_TEST_CASE(GeometryCache3D)
+{
+    CheckAllShapes(3, CheckGeometryCache);
+}
@@ -0,0 +1,111 @@
+#include "BoostUnitTest.h"
+
+#include <Eigen/IterativeLinearSolvers>
+#include <Eigen/SparseLU>
+
+#include "math/Gmres.h"
+#include "mechanics/structures/unstructured/Structure.h"
+#include "mechanics/MechanicsEnums.h"
+#include "mechanics/constraints/ConstraintCompanion.h"
+#include "mechanics/dofSubMatrixStorage/BlockFullVector.h"
+#include "mechanics/groups/Group.h"
+#include "mechanics/mesh/MeshGenerator.h"
+#include "mechanics/nodes/NodeBase.h"
+#include "mechanics/sections/SectionPlane.h"
+#include "mechanics/structures/Assembler.h"
+#include "mechanics/structures/HessianOperator.h"
+#include "mechanics/structures/StructureOutputBlockMatrix.h"
+
+void SetupStructure(NuTo::Structure& rStructure)
+{
+    rStructure.SetShowTime(false);
+    rStructure.SetVerboseLevel(0);
+
+    int interpolationType = NuTo::MeshGenerator::Grid(rStructure, {2., 3.}, {4, 3}).second;
+    rStructure.InterpolationTypeAdd(interpolationType, NuTo::Node::eDof::DISPLACEMENTS,
+                                    NuTo::Interpolation::eTypeOrder::EQUIDISTANT2);
+    rStructure.ElementTotalConvertToInterpolationType();
+    rStructure.ElementTotalSetSection(NuTo::SectionPlane::Create(1., false));
+
+    rStructure.ConstitutiveLawCreate(0, NuTo::Constitutive::eConstitutiveType::LINEAR_ELASTIC_ENGINEERING_STRESS);
+    rStructure.ConstitutiveLawSetParameterDouble(0, NuTo::Constitutive::eConstitutiveParameter::YOUNGS_MODULUS, 20000);
+    rStructure.ConstitutiveLawSetParameterDouble(0, NuTo::Constitutive::eConstitutiveParameter::POISSONS_RATIO, .2);
+    rStructure.ConstitutiveLawSetParameterDouble(0, NuTo::Constitutive::eConstitutiveParameter::DENSITY, 1.5);
+    rStructure.ElementTotalSetConstitutiveLaw(0);
+
+    // fixed nodes on the left, nodes on the right that couple their displacement components
+    auto& nodesLeft = rStructure.GroupGetNodesAtCoordinate(NuTo::eDirection::X, 0.);
+    rStructure.Constraints().Add(NuTo::Node::eDof::DISPLACEMENTS,
+                                 NuTo::Constraint::Component(nodesLeft, {NuTo::eDirection::X, NuTo::eDirection::Y}));
+    auto& nodesRight = rStructure.GroupGetNodesAtCoordinate(NuTo::eDirection::X, 2.);
+    rStructure.Constraints().Add(NuTo::Node::eDof::DISPLACEMENTS,
+                                 NuTo::Constraint::Direction(nodesRight, Eigen::Vector2d(1., 2.)));
+    rStructure.NodeBuildGlobalDofs();
+}
+
+//! @brief reduced hessian HESSIAN0 + rFactor2 * HESSIAN2, assembled and exported
+Eigen::SparseMatrix<double> AssembledHessian(NuTo::Structure& rStructure, double rFactor2)
+{
+    auto hessian = rStructure.BuildGlobalHessian0();
+    hessian.AddScal(rStructure.BuildGlobalHessian2(), rFactor2);
+    hessian.ApplyCMatrix(rStructure.GetAssembler().GetConstraintMatrix());
+    return hessian.JJ.ExportToEigenSparseMatrix();
+}
+
+BOOST_AUTO_TEST_CASE(HessianOperatorProduct)
+{
+    NuTo::Structure s(2);
+    SetupStructure(s);
+
+    NuTo::HessianOperator hessianOperator(s, 1., 0., 3.);
+    Eigen::SparseMatrix<double> hessian = AssembledHessian(s, 3.);
+    BOOST_CHECK_EQUAL(hessianOperator.rows(), hessian.rows());
+    BOOST_CHECK_EQUAL(hessianOperator.cols(), hessian.cols());
+
+    Eigen::VectorXd v = Eigen::VectorXd::Random(hessian.cols());
+    Eigen::VectorXd expected = hessian * v;
+    BOOST_CHECK_SMALL((hessianOperator.Apply(v) - expected).norm() / expected.norm(), 1.e-12);
+
+    // Eigen expressions
+    Eigen::VectorXd product = 2. * v;
+    product -= hessianOperator * v;
+    BOOST_CHECK_SMALL((product - 2. * v + expected).norm() / expected.norm(), 1.e-12);
+
+    // block vectors
+    NuTo::BlockFullVector<double> vBlock(v, s.GetDofStatus());
+    BOOST_CHECK_SMALL((hessianOperator.Apply(vBlock).Export() - expected).norm() / expected.norm(), 1.e-12);
+
+    // diagonal of the active part of the hessian, the constraints do not change the diagonal of the free dofs
+    Eigen::VectorXd diagonal = hessianOperator.GetDiagonal();
+    auto hessian0 = s.BuildGlobalHessian0();
+    auto hessian2 = s.BuildGlobalHessian2();
+    Eigen::VectorXd expectedDiagonal = Eigen::MatrixXd(hessian0.JJ.ExportToEigenSparseMatrix()).diagonal() +
+                                       3. * Eigen::MatrixXd(hessian2.JJ.ExportToEigenSparseMatrix()).diagonal();
+    BOOST_CHECK_SMALL((diagonal - expectedDiagonal).norm() / expectedDiagonal.norm(), 1.e-12);
+
+    BOOST_CHECK_THROW(NuTo::HessianOperator(s, 0., 0., 0.), NuTo::Exception);
+}
+
+BOOST_AUTO_TEST_CASE(HessianOperatorSolve)
+{
+    NuTo::Structure s(2);
+    SetupStructure(s);
+
+    NuTo::HessianOperator hessianOperator(s);
+    Eigen::SparseMatrix<double> hessian = AssembledHessian(s, 0.);
+
+    Eigen::VectorXd rhs = Eigen::VectorXd::Random(hessian.rows());
+    Eigen::SparseLU<Eigen::SparseMatrix<double>> directSolver(hessian);
+    Eigen::VectorXd expected = directSolver.solve(rhs);
+
+    Eigen::VectorXd xGmres = Eigen::VectorXd::Zero(hessian.rows());
+    NuTo::Gmres<NuTo::HessianOperator, NuTo::HessianOperatorJacobi>(hessianOperator, rhs, xGmres, 100, 1.e-12, 50);
+    BOOST_CHECK_SMALL((xGmres - expected).norm() / expected.norm(), 1.e-6);
+
+    Eigen::ConjugateGradient<NuTo::HessianOperator, Eigen::Lower | Eigen::Upper, NuTo::HessianOperatorJacobi> cg;
+    cg.setTolerance(1.e-12);
+    cg.compute(hessianOperator);
+    Eigen::VectorXd xCG = cg.solve(rhs);
+    BOOST_CHECK_EQUAL(cg.info(), Eigen::Success);
+    BOOST_CHECK_SMALL((xCG - expected).norm() / expected.norm(), 1.e-8);
+}
@@ -0,0 +1,180 @@
+#include "BoostUnitTest.h"
+
+#include <cmath>
+
+#include "mechanics/structures/unstructured/Structure.h"
+#include "mechanics/MechanicsEnums.h"
+#include "mechanics/constitutive/damageLaws/DamageLawExponential.h"
+#include "mechanics/constraints/ConstraintCompanion.h"
+#include "mechanics/groups/Group.h"
+#include "mechanics/mesh/MeshGenerator.h"
+#include "mechanics/nodes/NodeBase.h"
+#include "mechanics/sections/SectionPlane.h"
+#include "mechanics/sections/SectionTruss.h"
+#include "mechanics/constitutive/inputoutput/ConstitutiveCalculateStaticData.h"
+#include "mechanics/constitutive/inputoutput/ConstitutiveIOMap.h"
+#include "mechanics/structures/StructureOutputBlockMatrix.h"
+#include "mechanics/structures/StructureOutputBlockVector.h"
+
+using NuTo::Constitutive::eConstitutiveParameter;
+
+void SetupStructure(NuTo::Structure& rStructure, NuTo::Constitutive::eConstitutiveType rLaw, bool rIncremental)
+{
+    rStructure.SetShowTime(false);
+    rStructure.SetVerboseLevel(0);
+    rStructure.SetUseAssemblyPattern(true);
+    rStructure.SetUseIncrementalHessian0(rIncremental);
+
+    const bool is1D = rStructure.GetDimension() == 1;
+    int interpolationType = is1D ? NuTo::MeshGenerator::Grid(rStructure, {4.}, {32}).second
+                                 : NuTo::MeshGenerator::Grid(rStructure, {4., 1.}, {16, 4}).second;
+    rStructure.InterpolationTypeAdd(interpolationType, NuTo::Node::eDof::DISPLACEMENTS,
+                                    NuTo::Interpolation::eTypeOrder::EQUIDISTANT1);
+    rStructure.ElementTotalConvertToInterpolationType();
+    if (is1D)
+        rStructure.ElementTotalSetSection(NuTo::SectionTruss::Create(0.5));
+    else
+        rStructure.ElementTotalSetSection(NuTo::SectionPlane::Create(0.5, true));
+
+    rStructure.ConstitutiveLawCreate(0, rLaw);
+    rStructure.ConstitutiveLawSetParameterDouble(0, eConstitutiveParameter::YOUNGS_MODULUS, 20000.);
+    rStructure.ConstitutiveLawSetParameterDouble(0, eConstitutiveParameter::POISSONS_RATIO, 0.2);
+    if (rLaw == NuTo::Constitutive::eConstitutiveType::LOCAL_DAMAGE_MODEL)
+    {
+        rStructure.ConstitutiveLawSetParameterDouble(0, eConstitutiveParameter::TENSILE_STRENGTH, 4.);
+        rStructure.ConstitutiveLawSetParameterDouble(0, eConstitutiveParameter::COMPRESSIVE_STRENGTH, 40.);
+        rStructure.ConstitutiveLawSetDamageLaw(0, NuTo::Constitutive::DamageLawExponential::Create(4. / 20000., 200.));
+    }
+    rStructure.ElementTotalSetConstitutiveLaw(0);
+
+    // constrained dofs to get entries in all submatrices
+    auto& nodesLeft = rStructure.GroupGetNodesAtCoordinate(NuTo::eDirection::X, 0.);
+    std::vector<NuTo::eDirection> directions = {NuTo::eDirection::X};
+    if (not is1D)
+        directions.push_back(NuTo::eDirection::Y);
+    rStructure.Constraints().Add(NuTo::Node::eDof::DISPLACEMENTS, NuTo::Constraint::Component(nodesLeft, directions));
+    rStructure.NodeBuildGlobalDofs();
+}
+
+//! @brief displacements that localize in a band around x = 2
+void SetDisplacements(NuTo::Structure& rStructure, double rAmplitude)
+{
+    int groupId = rStructure.GroupGetNodesTotal();
+    for (int nodeId : rStructure.GroupGetMemberIds(groupId))
+    {
+        NuTo::NodeBase* node = rStructure.NodeGetNodePtr(nodeId);
+        Eigen::VectorXd coordinates = node->Get(NuTo::Node::eDof::COORDINATES);
+        Eigen::VectorXd displacements(coordinates.rows());
+        displacements[0] = rAmplitude * (std::tanh(4. * (coordinates[0] - 2.)) + 0.1 * coordinates[0]);
+        if (coordinates.rows() > 1)
+            displacements[1] = 0.2 * rAmplitude * coordinates[1];
+        node->Set(NuTo::Node::eDof::DISPLACEMENTS, displacements);
+    }
+    rStructure.GroupDelete(groupId);
+}
+
+void CheckEqual(const NuTo::StructureOutputBlockMatrix& rExpected, const NuTo::StructureOutputBlockMatrix& rActual)
+{
+    Eigen::SparseMatrix<double> expected = rExpected.ExportToEigenSparseMatrix();
+    Eigen::SparseMatrix<double> difference = expected - rActual.ExportToEigenSparseMatrix();
+    BOOST_CHECK_GT(expected.norm(), 0.);
+    BOOST_CHECK_SMALL(difference.norm() / expected.norm(), 1.e-12);
+}
+
+//! @brief compares HESSIAN0 and INTERNAL_GRADIENT, evaluated together in one pass over the elements, with the separate
+//! assemblies of rReference
+void CheckEqualWithGradient(NuTo::Structure& rReference, NuTo::Structure& rStructure)
+{
+    NuTo::StructureOutputBlockMatrix hessian0(rStructure.GetDofStatus(), true);
+    NuTo::StructureOutputBlockVector internalGradient(rStructure.GetDofStatus(), true);
+    std::map<NuTo::eStructureOutput, NuTo::StructureOutputBase*> evaluateMap;
+    evaluateMap[NuTo::eStructureOutput::HESSIAN0] = &hessian0;
+    evaluateMap[NuTo::eStructureOutput::INTERNAL_GRADIENT] = &internalGradient;
+
+    NuTo::ConstitutiveInputMap input;
+    input[NuTo::Constitutive::eInput::CALCULATE_STATIC_DATA] =
+            std::make_unique<NuTo::ConstitutiveCalculateStaticData>(NuTo::eCalculateStaticData::EULER_BACKWARD);
+    rStructure.Evaluate(input, evaluateMap);
+
+    CheckEqual(rReference.BuildGlobalHessian0(), hessian0);
+    const Eigen::VectorXd expected = rReference.BuildGlobalInternalGradient().J.Export();
+    BOOST_CHECK_SMALL((expected - internalGradient.J.Export()).norm() / expected.norm(), 1.e-12);
+}
+
+//! @brief compares the incremental hessian with the full assembly while the damage grows between the assemblies
+void CheckDamage(int rDimension)
+{
+    NuTo::Structure reference(rDimension);
+    NuTo::Structure structure(rDimension);
+    SetupStructure(reference, NuTo::Constitutive::eConstitutiveType::LOCAL_DAMAGE_MODEL, false);
+    SetupStructure(structure, NuTo::Constitutive::eConstitutiveType::LOCAL_DAMAGE_MODEL, true);
+    BOOST_CHECK(structure.GetUseIncrementalHessian0());
+
+    const Eigen::SparseMatrix<double> elasticHessian = reference.BuildGlobalHessian0().ExportToEigenSparseMatrix();
+    for (double amplitude : {1.e-5, 2.e-4, 3.e-4, 3.e-4, 2.e-4, 5.e-4})
+    {
+        // several iterations per load step, the damage only evolves in the band
+        for (double iteration : {0.9, 0.95, 1.})
+        {
+            SetDisplacements(reference, iteration * amplitude);
+            SetDisplacements(structure, iteration * amplitude);
+            CheckEqual(reference.BuildGlobalHessian0(), structure.BuildGlobalHessian0());
+            CheckEqualWithGradient(reference, structure);
+        }
+        reference.ElementTotalUpdateStaticData();
+        structure.ElementTotalUpdateStaticData();
+    }
+
+    // the damage changed the tangents
+    Eigen::SparseMatrix<double> damagedHessian = reference.BuildGlobalHessian0().ExportToEigenSparseMatrix();
+    BOOST_CHECK_GT((damagedHessian - elasticHessian).norm(), 1.e-3 * elasticHessian.norm());
+}
+
+BOOST_AUTO_TEST_CASE(IncrementalHessianDamage1D)
+{
+    CheckDamage(1);
+}
+
+BOOST_AUTO_TEST_CASE(IncrementalHessianDamage)
+{
+    CheckDamage(2);
+}
+
+BOOST_AUTO_TEST_CASE(IncrementalHessianChanges)
+{
+    NuTo::Structure reference(2);
+    NuTo::Structure structure(2);
+    SetupStructure(reference, NuTo::Constitutive::eConstitutiveType::LINEAR_ELASTIC_ENGINEERING_STRESS, false);
+    SetupStructure(structure, NuTo::Constitutive::eConstitutiveType::LINEAR_ELASTIC_ENGINEERING_STRESS, true);
+
+    CheckEqual(reference.BuildGlobalHessian0(), structure.BuildGlobalHessian0());
+    CheckEqual(reference.BuildGlobalHessian0(), structure.BuildGlobalHessian0());
+
+    // parameters of the constitutive law
+    for (NuTo::Structure* s : {&reference, &structure})
+        s->ConstitutiveLawSetParameterDouble(0, eConstitutiveParameter::YOUNGS_MODULUS, 30000.);
+    CheckEqual(reference.BuildGlobalHessian0(), structure.BuildGlobalHessian0());
+
+    // node coordinates
+    for (NuTo::Structure* s : {&reference, &structure})
+    {
+        NuTo::NodeBase* node = s->NodeGetNodePtr(30);
+        node->Set(NuTo::Node::eDof::COORDINATES, node->Get(NuTo::Node::eDof::COORDINATES) * 1.02);
+    }
+    CheckEqual(reference.BuildGlobalHessian0(), structure.BuildGlobalHessian0());
+
+    // sections
+    for (NuTo::Structure* s : {&reference, &structure})
+        s->ElementSetSection(s->ElementGetElementPtr(3), NuTo::SectionPlane::Create(0.7, true));
+    CheckEqual(reference.BuildGlobalHessian0(), structure.BuildGlobalHessian0());
+
+    // constraints, the assembly pattern is rebuilt
+    for (NuTo::Structure* s : {&reference, &structure})
+    {
+        auto& nodesRight = s->GroupGetNodesAtCoordinate(NuTo::eDirection::X, 4.);
+        s->Constraints().Add(NuTo::Node::eDof::DISPLACEMENTS,
+                             NuTo::Constraint::Component(nodesRight, {NuTo::eDirection::X}));
+        s->NodeBuildGlobalDofs();
+    }
+    CheckEqual(reference.BuildGlobalHessian0(), structure.BuildGlobalHessian0());
+}
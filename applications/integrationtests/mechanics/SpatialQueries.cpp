@@ -0,0 +1,121 @@
+#include "BoostUnitTest.h"
+
+#include <cmath>
+#include <set>
+
+#include "mechanics/structures/unstructured/Structure.h"
+#include "mechanics/MechanicsEnums.h"
+#include "mechanics/elements/ElementBase.h"
+#include "mechanics/groups/Group.h"
+#include "mechanics/mesh/MeshGenerator.h"
+#include "mechanics/nodes/NodeBase.h"
+
+//! @brief ids of all nodes that satisfy rFunction, by checking all nodes
+std::set<int> NodesBruteForce(NuTo::Structure& rStructure, std::function<bool(const Eigen::VectorXd&)> rFunction)
+{
+    std::set<int> ids;
+    for (auto it = rStructure.NodeGetNodeMap().begin(); it != rStructure.NodeGetNodeMap().end(); ++it)
+        if (rFunction(it->second->Get(NuTo::Node::eDof::COORDINATES)))
+            ids.insert(it->first);
+    return ids;
+}
+
+//! @brief deletes the group and returns its members
+std::set<int> ExtractGroup(NuTo::Structure& rStructure, int rGroupId)
+{
+    std::vector<int> members = rStructure.GroupGetMemberIds(rGroupId);
+    rStructure.GroupDelete(rGroupId);
+    return std::set<int>(members.begin(), members.end());
+}
+
+void CheckNodeQueries(NuTo::Structure& rStructure)
+{
+    for (double x : {0., 0.25, 1.3, 2.})
+    {
+        int group = rStructure.GroupCreate(NuTo::eGroupId::Nodes);
+        rStructure.GroupAddNodeCoordinateRange(group, NuTo::eDirection::X, x - 0.1, x + 0.1);
+        std::set<int> expected = NodesBruteForce(
+                rStructure, [=](const Eigen::VectorXd& c) { return c[0] >= x - 0.1 and c[0] <= x + 0.1; });
+        BOOST_CHECK(ExtractGroup(rStructure, group) == expected);
+    }
+
+    const Eigen::Vector3d center(1., 0.5, 0.25);
+    int group = rStructure.GroupCreate(NuTo::eGroupId::Nodes);
+    rStructure.GroupAddNodeRadiusRange(group, center, 0.2, 0.4);
+    std::set<int> expected = NodesBruteForce(rStructure, [&](const Eigen::VectorXd& c) {
+        const double r = (c - center).norm();
+        return r >= 0.2 and r <= 0.4;
+    });
+    BOOST_CHECK(not expected.empty());
+    BOOST_CHECK(ExtractGroup(rStructure, group) == expected);
+
+    // cylinder along z and along a skew axis, the latter is unbounded in all directions
+    for (Eigen::Vector3d direction : {Eigen::Vector3d(0., 0., 2.), Eigen::Vector3d(1., 1., 1.)})
+    {
+        group = rStructure.GroupCreate(NuTo::eGroupId::Nodes);
+        rStructure.GroupAddNodeCylinderRadiusRange(group, center, direction, 0., 0.3);
+        expected = NodesBruteForce(rStructure, [&](const Eigen::VectorXd& c) {
+            const Eigen::Vector3d delta = c - center;
+            const Eigen::Vector3d axis = direction.normalized();
+            return (delta - axis * axis.dot(delta)).norm() <= 0.3;
+        });
+        BOOST_CHECK(not expected.empty());
+        BOOST_CHECK(ExtractGroup(rStructure, group) == expected);
+    }
+
+    const Eigen::Vector3d point(0.51, 0.27, 0.49);
+    std::set<int> nearest = NodesBruteForce(rStructure, [&](const Eigen::VectorXd& c) {
+        return (c - point).norm() < 0.5 * 0.25 * std::sqrt(3.);
+    });
+    BOOST_REQUIRE_EQUAL(nearest.size(), 1);
+    BOOST_CHECK_EQUAL(rStructure.NodeGetIdNearestToCoordinate(point), *nearest.begin());
+}
+
+BOOST_AUTO_TEST_CASE(SpatialQueriesNodes)
+{
+    NuTo::Structure s(3);
+    s.SetShowTime(false);
+    NuTo::MeshGenerator::Grid(s, {2., 1., 0.5}, {8, 4, 2});
+    CheckNodeQueries(s);
+
+    // moved nodes
+    int nodeId = s.NodeGetIdAtCoordinate(Eigen::Vector3d(0.5, 0.25, 0.25));
+    BOOST_REQUIRE_NE(nodeId, -1);
+    s.NodeGetNodePtr(nodeId)->Set(NuTo::Node::eDof::COORDINATES, Eigen::Vector3d(1.9, 0.1, 0.2));
+    BOOST_CHECK_EQUAL(s.NodeGetIdAtCoordinate(Eigen::Vector3d(1.9, 0.1, 0.2)), nodeId);
+    BOOST_CHECK_EQUAL(s.NodeGetIdAtCoordinate(Eigen::Vector3d(0.5, 0.25, 0.25)), -1);
+    CheckNodeQueries(s);
+
+    // added and deleted nodes
+    int newNodeId = s.NodeCreate(Eigen::Vector3d(1.05, 0.5, 0.25));
+    BOOST_CHECK_EQUAL(s.NodeGetIdNearestToCoordinate(Eigen::Vector3d(1.06, 0.5, 0.25)), newNodeId);
+    CheckNodeQueries(s);
+    s.NodeDelete(newNodeId);
+    BOOST_CHECK_NE(s.NodeGetIdNearestToCoordinate(Eigen::Vector3d(1.06, 0.5, 0.25)), newNodeId);
+    CheckNodeQueries(s);
+}
+
+BOOST_AUTO_TEST_CASE(SpatialQueriesElements)
+{
+    NuTo::Structure s(2);
+    s.SetShowTime(false);
+    NuTo::MeshGenerator::Grid(s, {4., 2.}, {8, 4});
+
+    int group = s.GroupCreate(NuTo::eGroupId::Elements);
+    s.GroupAddElementsInBox(group, Eigen::Vector2d(0.9, -1.), Eigen::Vector2d(2.1, 1.));
+    std::set<int> elements = ExtractGroup(s, group);
+
+    // elements of the columns 2 and 3 in the lower half
+    std::set<int> expected;
+    for (int elementId : ExtractGroup(s, s.GroupGetElementsTotal()))
+    {
+        const NuTo::ElementBase& element = *s.ElementGetElementPtr(elementId);
+        Eigen::Vector2d center = Eigen::Vector2d::Zero();
+        for (int iNode = 0; iNode < element.GetNumNodes(); ++iNode)
+            center += element.GetNode(iNode)->Get(NuTo::Node::eDof::COORDINATES) / element.GetNumNodes();
+        if (center[0] > 1. and center[0] < 2. and center[1] < 1.)
+            expected.insert(elementId);
+    }
+    BOOST_CHECK_EQUAL(expected.size(), 4);
+    BOOST_CHECK(elements == expected);
+}
@@ -0,0 +1,153 @@
+#include "BoostUnitTest.h"
+
+#include "mechanics/structures/unstructured/Structure.h"
+#include "mechanics/MechanicsEnums.h"
+#include "mechanics/constitutive/inputoutput/ConstitutiveCalculateStaticData.h"
+#include "mechanics/dofSubMatrixStorage/BlockFullMatrix.h"
+#include "mechanics/dofSubMatrixStorage/BlockFullVector.h"
+#include "mechanics/elements/ElementBase.h"
+#include "mechanics/elements/ElementOutputBlockMatrixDouble.h"
+#include "mechanics/elements/ElementOutputBlockVectorDouble.h"
+#include "mechanics/groups/Group.h"
+#include "mechanics/mesh/MeshGenerator.h"
+#include "mechanics/nodes/NodeBase.h"
+#include "mechanics/sections/SectionPlane.h"
+#include "mechanics/structures/HessianOperator.h"
+#include "mechanics/structures/StructureOutputBlockMatrix.h"
+
+using NuTo::Interpolation::eTypeOrder;
+using NuTo::Element::eOutput;
+
+//! @brief distorted grid with nonzero displacements
+void SetupStructure(NuTo::Structure& rStructure, eTypeOrder rOrder)
+{
+    rStructure.SetShowTime(false);
+    rStructure.SetVerboseLevel(0);
+
+    const int dimension = rStructure.GetDimension();
+    int interpolationType = dimension == 2 ? NuTo::MeshGenerator::Grid(rStructure, {2., 3.}, {2, 3}).second
+                                           : NuTo::MeshGenerator::Grid(rStructure, {2., 3., 4.}, {2, 2, 1}).second;
+    rStructure.InterpolationTypeAdd(interpolationType, NuTo::Node::eDof::DISPLACEMENTS, rOrder);
+    rStructure.ElementTotalConvertToInterpolationType();
+    if (dimension == 2)
+        rStructure.ElementTotalSetSection(NuTo::SectionPlane::Create(0.7, false));
+
+    rStructure.ConstitutiveLawCreate(0, NuTo::Constitutive::eConstitutiveType::LINEAR_ELASTIC_ENGINEERING_STRESS);
+    rStructure.ConstitutiveLawSetParameterDouble(0, NuTo::Constitutive::eConstitutiveParameter::YOUNGS_MODULUS, 20000);
+    rStructure.ConstitutiveLawSetParameterDouble(0, NuTo::Constitutive::eConstitutiveParameter::POISSONS_RATIO, .2);
+    rStructure.ElementTotalSetConstitutiveLaw(0);
+    rStructure.NodeBuildGlobalDofs();
+
+    int groupId = rStructure.GroupGetNodesTotal();
+    for (int nodeId : rStructure.GroupGetMemberIds(groupId))
+    {
+        NuTo::NodeBase* node = rStructure.NodeGetNodePtr(nodeId);
+        Eigen::VectorXd coordinates = node->Get(NuTo::Node::eDof::COORDINATES);
+        node->Set(NuTo::Node::eDof::DISPLACEMENTS, 0.01 * coordinates.cwiseProduct(coordinates));
+        node->Set(NuTo::Node::eDof::COORDINATES, coordinates + 0.05 * coordinates.array().sin().matrix().reverse());
+    }
+    rStructure.GroupDelete(groupId);
+}
+
+std::vector<NuTo::ElementBase*> GetElements(NuTo::Structure& rStructure)
+{
+    std::vector<NuTo::ElementBase*> elements;
+    int groupId = rStructure.GroupGetElementsTotal();
+    for (int elementId : rStructure.GroupGetMemberIds(groupId))
+        elements.push_back(rStructure.ElementGetElementPtr(elementId));
+    rStructure.GroupDelete(groupId);
+    return elements;
+}
+
+//! @brief compares the internal gradients and hessian products by sum factorization with the element hessians
+void CheckElements(NuTo::Structure& rStructure, bool rExpectSumFactorization)
+{
+    NuTo::ConstitutiveInputMap input;
+    input[NuTo::Constitutive::eInput::CALCULATE_STATIC_DATA] =
+            std::make_unique<NuTo::ConstitutiveCalculateStaticData>(NuTo::eCalculateStaticData::EULER_BACKWARD);
+
+    const auto& dofStatus = rStructure.GetDofStatus();
+    auto internalGradient = std::make_shared<NuTo::ElementOutputBlockVectorDouble>(dofStatus);
+    auto hessian0 = std::make_shared<NuTo::ElementOutputBlockMatrixDouble>(dofStatus);
+
+    // only the internal gradient: evaluated by sum factorization, if supported
+    std::map<eOutput, std::shared_ptr<NuTo::ElementOutputBase>> gradientOutput;
+    gradientOutput[eOutput::INTERNAL_GRADIENT] = internalGradient;
+
+    // the hessian requires the standard evaluation
+    std::map<eOutput, std::shared_ptr<NuTo::ElementOutputBase>> hessianOutput;
+    hessianOutput[eOutput::HESSIAN_0_TIME_DERIVATIVE] = hessian0;
+
+    for (NuTo::ElementBase* element : GetElements(rStructure))
+    {
+        const Eigen::VectorXd u = element->ExtractNodeValues(NuTo::Node::eDof::DISPLACEMENTS);
+
+        element->Evaluate(input, gradientOutput);
+        element->Evaluate(input, hessianOutput);
+        const Eigen::MatrixXd& k = hessian0->GetBlockFullMatrixDouble()(NuTo::Node::eDof::DISPLACEMENTS,
+                                                                        NuTo::Node::eDof::DISPLACEMENTS);
+
+        // linear elasticity, internal gradient = K u. The kernels use exact 1D polynomials, the element hessian the
+        // shape functions of the interpolation with coefficients rounded to 12 digits.
+        const Eigen::VectorXd& gradient = internalGradient->GetBlockFullVectorDouble()[NuTo::Node::eDof::DISPLACEMENTS];
+        BOOST_CHECK_GT(gradient.norm(), 0.);
+        BOOST_CHECK_SMALL((gradient - k * u).norm() / gradient.norm(), 1.e-8);
+
+        NuTo::BlockFullVector<double> values(dofStatus);
+        values[NuTo::Node::eDof::DISPLACEMENTS] = Eigen::VectorXd::Random(u.rows());
+        NuTo::BlockFullVector<double> product(dofStatus);
+        product[NuTo::Node::eDof::DISPLACEMENTS].setZero(u.rows());
+        BOOST_CHECK_EQUAL(element->AddHessian0Product(input, values, 2., product), rExpectSumFactorization);
+        if (rExpectSumFactorization)
+        {
+            const Eigen::VectorXd expected = 2. * k * values[NuTo::Node::eDof::DISPLACEMENTS];
+            BOOST_CHECK_SMALL((product[NuTo::Node::eDof::DISPLACEMENTS] - expected).norm() / expected.norm(), 1.e-8);
+        }
+    }
+}
+
+//! @brief compares the matrix-free operator with the assembled hessian
+void CheckHessianOperator(NuTo::Structure& rStructure)
+{
+    NuTo::HessianOperator hessianOperator(rStructure);
+    auto hessian = rStructure.BuildGlobalHessian0();
+    Eigen::SparseMatrix<double> hessianJJ = hessian.JJ.ExportToEigenSparseMatrix();
+
+    Eigen::VectorXd v = Eigen::VectorXd::Random(hessianJJ.cols());
+    Eigen::VectorXd expected = hessianJJ * v;
+    BOOST_CHECK_SMALL((hessianOperator.Apply(v) - expected).norm() / expected.norm(), 1.e-8);
+}
+
+BOOST_AUTO_TEST_CASE(SumFactorizationQuad)
+{
+    for (auto order : {eTypeOrder::LOBATTO2, eTypeOrder::LOBATTO3, eTypeOrder::LOBATTO4})
+    {
+        NuTo::Structure s(2);
+        SetupStructure(s, order);
+        CheckElements(s, true);
+        CheckHessianOperator(s);
+    }
+}
+
+BOOST_AUTO_TEST_CASE(SumFactorizationBrick)
+{
+    for (auto order : {eTypeOrder::LOBATTO2, eTypeOrder::LOBATTO3, eTypeOrder::LOBATTO4})
+    {
+        NuTo::Structure s(3);
+        SetupStructure(s, order);
+        CheckElements(s, true);
+        CheckHessianOperator(s);
+    }
+}
+
+BOOST_AUTO_TEST_CASE(SumFactorizationNotSupported)
+{
+    // linear elements and serendipity elements use the standard evaluation
+    for (auto order : {eTypeOrder::EQUIDISTANT1, eTypeOrder::EQUIDISTANT2})
+    {
+        NuTo::Structure s(3);
+        SetupStructure(s, order);
+        CheckElements(s, false);
+        CheckHessianOperator(s);
+    }
+}
@@ -0,0 +1,99 @@
+#pragma once
+
+#include <cstddef>
+#include <memory>
+#include <mutex>
+#include <new>
+#include <vector>
+
+namespace NuTo
+{
+
+//! @brief allocates objects of the size TSize in chunks of contiguous memory instead of one heap allocation per object
+//! @remark Objects that are allocated one after another are stored next to each other, e.g. the elements of a
+//! structure. Freed slots are reused, the chunks are released when the last object is deallocated.
+//! @remark thread safe
+template <std::size_t TSize>
+class ObjectPool
+{
+public:
+    //! @brief returns the pool of all objects of the size TSize
+    //! @remark never destroyed, objects with static storage duration may be deallocated after the end of main
+    static ObjectPool& Instance()
+    {
+        static ObjectPool* pool = new ObjectPool;
+        return *pool;
+    }
+
+    //! @brief returns uninitialized memory for one object
+    void* Allocate()
+    {
+        std::lock_guard<std::mutex> lock(mMutex);
+        if (mFree == nullptr)
+            AddChunk();
+        Slot* slot = mFree;
+        mFree = slot->mNext;
+        ++mNumObjects;
+        return slot;
+    }
+
+    //! @brief returns the memory of one object, allocated by Allocate()
+    void Deallocate(void* rPointer)
+    {
+        std::lock_guard<std::mutex> lock(mMutex);
+        Slot* slot = static_cast<Slot*>(rPointer);
+        slot->mNext = mFree;
+        mFree = slot;
+        if (--mNumObjects == 0)
+        {
+            mChunks.clear();
+            mFree = nullptr;
+        }
+    }
+
+    //! @brief returns the number of allocated objects
+    std::size_t GetNumObjects() const
+    {
+        std::lock_guard<std::mutex> lock(mMutex);
+        return mNumObjects;
+    }
+
+    //! @brief returns the number of chunks
+    std::size_t GetNumChunks() const
+    {
+        std::lock_guard<std::mutex> lock(mMutex);
+        return mChunks.size();
+    }
+
+    //! @brief number of objects per chunk
+    static constexpr std::size_t NumObjectsPerChunk = 256;
+
+private:
+    union Slot {
+        Slot* mNext;
+        alignas(std::max_align_t) unsigned char mData[TSize];
+    };
+
+    ObjectPool() = default;
+
+    //! @brief adds a chunk to the free slots, in the order of their addresses
+    void AddChunk()
+    {
+        mChunks.emplace_back(new Slot[NumObjectsPerChunk]);
+        Slot* chunk = mChunks.back().get();
+        for (std::size_t i = 0; i < NumObjectsPerChunk - 1; ++i)
+            chunk[i].mNext = &chunk[i + 1];
+        chunk[NumObjectsPerChunk - 1].mNext = mFree;
+        mFree = chunk;
+    }
+
+    mutable std::mutex mMutex;
+    std::vector<std::unique_ptr<Slot[]>> mChunks;
+    Slot* mFree = nullptr;
+    std::size_t mNumObjects = 0;
+};
+
+template <std::size_t TSize>
+constexpr std::size_t ObjectPool<TSize>::NumObjectsPerChunk;
+
+} // namespace NuTo
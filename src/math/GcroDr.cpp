@@ -0,0 +1,272 @@
+#include "math/GcroDr.h"
+
+#include <algorithm>
+#include <cmath>
+#include <numeric>
+#include <vector>
+#include <Eigen/Cholesky>
+#include <Eigen/Eigenvalues>
+#include <Eigen/Jacobi>
+#include <Eigen/QR>
+
+#include "base/Exception.h"
+#include "math/SparseMatrixProduct.h"
+
+using namespace NuTo;
+
+namespace
+{
+//! @brief number of rows of the blocks of the orthogonalization
+constexpr int blockSize = 1024;
+
+//! @brief rH = rBasis^T rW, rW -= rBasis rH, parallel over blocks of rows
+void ProjectOut(const Eigen::Ref<const Eigen::MatrixXd>& rBasis, Eigen::VectorXd& rW, Eigen::VectorXd& rH)
+{
+    const int numRows = rBasis.rows();
+    const int numColumns = rBasis.cols();
+    const int numBlocks = (numRows + blockSize - 1) / blockSize;
+
+    // one column per block, summed in a fixed order for reproducible results
+    Eigen::MatrixXd partial(numColumns, numBlocks);
+#ifdef _OPENMP
+#pragma omp parallel for schedule(static) if (numRows > SparseMatrixProduct::minRowsPerThread)
+#endif
+    for (int block = 0; block < numBlocks; ++block)
+    {
+        const int begin = block * blockSize;
+        const int size = std::min(blockSize, numRows - begin);
+        partial.col(block).noalias() = rBasis.middleRows(begin, size).transpose() * rW.segment(begin, size);
+    }
+    rH = partial.rowwise().sum();
+
+#ifdef _OPENMP
+#pragma omp parallel for schedule(static) if (numRows > SparseMatrixProduct::minRowsPerThread)
+#endif
+    for (int block = 0; block < numBlocks; ++block)
+    {
+        const int begin = block * blockSize;
+        const int size = std::min(blockSize, numRows - begin);
+        rW.segment(begin, size).noalias() -= rBasis.middleRows(begin, size) * rH;
+    }
+}
+
+//! @brief rW -= rBasis rH with rH = rBasis^T rW, two passes of classical Gram-Schmidt
+void Orthogonalize(const Eigen::Ref<const Eigen::MatrixXd>& rBasis, Eigen::VectorXd& rW, Eigen::VectorXd& rH)
+{
+    Eigen::VectorXd correction;
+    ProjectOut(rBasis, rW, rH);
+    ProjectOut(rBasis, rW, correction);
+    rH += correction;
+}
+
+//! @brief rMatrix * rR^-1 for an upper triangular rR
+Eigen::MatrixXd SolveRight(const Eigen::MatrixXd& rMatrix, const Eigen::MatrixXd& rR)
+{
+    return rR.transpose().triangularView<Eigen::Lower>().solve(rMatrix.transpose()).transpose();
+}
+} // namespace
+
+GcroDr::GcroDr(int rKrylovDimension, int rNumRecycledVectors)
+    : mKrylovDimension(rKrylovDimension)
+    , mNumRecycledVectors(rNumRecycledVectors)
+{
+    if (rNumRecycledVectors < 0 or rNumRecycledVectors >= rKrylovDimension)
+        throw Exception(__PRETTY_FUNCTION__,
+                        "The number of recycled vectors has to be in [0, Krylov dimension - 1].");
+}
+
+bool GcroDr::Solve(const Operator& rA, const Operator& rPreconditioner, const Eigen::VectorXd& rRhs,
+                   Eigen::VectorXd& rX)
+{
+    const int numRows = rRhs.rows();
+    if (rX.rows() != numRows)
+        rX = Eigen::VectorXd::Zero(numRows);
+    mNumIterations = 0;
+    const double tolerance = mTolerance * rRhs.norm();
+
+    Eigen::VectorXd product;
+    rA(rX, product);
+    Eigen::VectorXd residual = rRhs - product;
+
+    // the recycled subspace of the previous system, C = A U for the current operator
+    if (mU.rows() != numRows)
+        ClearRecycledSubspace();
+    if (mU.cols() > 0)
+    {
+        Eigen::MatrixXd products(numRows, mU.cols());
+        for (int i = 0; i < mU.cols(); ++i)
+        {
+            rA(mU.col(i), product);
+            products.col(i) = product;
+        }
+        OrthonormalizeProducts(products);
+        const Eigen::VectorXd projection = mC.transpose() * residual;
+        rX += mU * projection;
+        residual -= mC * projection;
+    }
+
+    Eigen::VectorXd z, w, h;
+    while (true)
+    {
+        const double residualNorm = residual.norm();
+        if (residualNorm <= tolerance)
+            return true;
+        if (mNumIterations >= mMaxNumIterations)
+            return false;
+
+        // Arnoldi process for (I - C C^T) A M^-1
+        const int numRecycled = mU.cols();
+        const int maxNumSteps = mKrylovDimension - numRecycled;
+        Eigen::MatrixXd V(numRows, maxNumSteps + 1);
+        Eigen::MatrixXd Z(numRows, maxNumSteps);
+        Eigen::MatrixXd H = Eigen::MatrixXd::Zero(maxNumSteps + 1, maxNumSteps);
+        Eigen::MatrixXd B(numRecycled, maxNumSteps);
+        V.col(0) = residual / residualNorm;
+
+        // least squares problem min |s - H y|, H is reduced to the upper triangular R by Givens rotations
+        Eigen::MatrixXd R = H;
+        std::vector<Eigen::JacobiRotation<double>> givens(maxNumSteps);
+        Eigen::VectorXd s = Eigen::VectorXd::Zero(maxNumSteps + 1);
+        s[0] = residualNorm;
+
+        int numSteps = 0;
+        while (numSteps < maxNumSteps and mNumIterations < mMaxNumIterations)
+        {
+            const int j = numSteps;
+            rPreconditioner(V.col(j), z);
+            Z.col(j) = z;
+            rA(z, w);
+            const double norm = w.norm();
+            if (numRecycled > 0)
+            {
+                Orthogonalize(mC, w, h);
+                B.col(j) = h;
+            }
+            Orthogonalize(V.leftCols(j + 1), w, h);
+            H.col(j).head(j + 1) = h;
+            H(j + 1, j) = w.norm();
+            ++numSteps;
+            ++mNumIterations;
+
+            // the Krylov space is invariant, the least squares solution is exact
+            const bool isBreakdown = H(j + 1, j) <= 1.e-14 * norm;
+            if (isBreakdown)
+            {
+                H(j + 1, j) = 0.;
+                V.col(j + 1).setZero();
+            }
+            else
+                V.col(j + 1) = w / H(j + 1, j);
+
+            R.col(j) = H.col(j);
+            for (int i = 0; i < j; ++i)
+                R.col(j).applyOnTheLeft(i, i + 1, givens[i].adjoint());
+            givens[j].makeGivens(R(j, j), R(j + 1, j));
+            R.col(j).applyOnTheLeft(j, j + 1, givens[j].adjoint());
+            s.applyOnTheLeft(j, j + 1, givens[j].adjoint());
+
+            if (isBreakdown or std::abs(s[j + 1]) <= tolerance)
+                break;
+        }
+
+        // x += [U D, Z] y with y = [y1; y2], y2 minimizes |s - H y2| and y1 = -D^-1 B y2 removes the C component
+        Eigen::VectorXd y = s.head(numSteps);
+        R.topLeftCorner(numSteps, numSteps).triangularView<Eigen::Upper>().solveInPlace(y);
+        rX += Z.leftCols(numSteps) * y;
+        if (numRecycled > 0)
+            rX -= mU * (B.leftCols(numSteps) * y);
+        rA(rX, product);
+        residual = rRhs - product;
+
+        if (mNumRecycledVectors > 0)
+            UpdateRecycledSubspace(Z, V, B, H, numSteps);
+    }
+}
+
+void GcroDr::OrthonormalizeProducts(const Eigen::MatrixXd& rProducts)
+{
+    // A U P = Q R  ->  C = Q, U = U P R^-1
+    const Eigen::ColPivHouseholderQR<Eigen::MatrixXd> qr(rProducts);
+    const int rank = qr.rank();
+    if (rank == 0)
+    {
+        ClearRecycledSubspace();
+        return;
+    }
+    const Eigen::MatrixXd permuted = (mU * qr.colsPermutation()).leftCols(rank);
+    const Eigen::MatrixXd upper =
+            qr.matrixR().topLeftCorner(rank, rank).triangularView<Eigen::Upper>().toDenseMatrix();
+    mU = SolveRight(permuted, upper);
+    mC = qr.householderQ() * Eigen::MatrixXd::Identity(rProducts.rows(), rank);
+}
+
+void GcroDr::UpdateRecycledSubspace(const Eigen::MatrixXd& rZ, const Eigen::MatrixXd& rV, const Eigen::MatrixXd& rB,
+                                    const Eigen::MatrixXd& rH, int rNumSteps)
+{
+    const int numRecycled = mU.cols();
+    const int numColumns = numRecycled + rNumSteps;
+    const auto Z = rZ.leftCols(rNumSteps);
+    const auto V = rV.leftCols(rNumSteps + 1);
+
+    // G = [D B; 0 H] and F = [C V]^T [U D, Z]
+    const Eigen::VectorXd d = mU.colwise().norm().cwiseInverse().transpose();
+    Eigen::MatrixXd G = Eigen::MatrixXd::Zero(numColumns + 1, numColumns);
+    Eigen::MatrixXd F(numColumns + 1, numColumns);
+    G.bottomRightCorner(rNumSteps + 1, rNumSteps) = rH.topLeftCorner(rNumSteps + 1, rNumSteps);
+    F.bottomRightCorner(rNumSteps + 1, rNumSteps) = V.transpose() * Z;
+    if (numRecycled > 0)
+    {
+        G.topLeftCorner(numRecycled, numRecycled) = d.asDiagonal();
+        G.topRightCorner(numRecycled, rNumSteps) = rB.leftCols(rNumSteps);
+        F.topLeftCorner(numRecycled, numRecycled) = mC.transpose() * mU * d.asDiagonal();
+        F.topRightCorner(numRecycled, rNumSteps) = mC.transpose() * Z;
+        F.bottomLeftCorner(rNumSteps + 1, numRecycled) = V.transpose() * mU * d.asDiagonal();
+    }
+
+    // harmonic Ritz values: G^T G z = theta G^T F z, the eigenvalues 1 / theta of (G^T G)^-1 G^T F with the largest
+    // modulus belong to the smallest harmonic Ritz values
+    const Eigen::LDLT<Eigen::MatrixXd> gram(G.transpose() * G);
+    if (gram.info() != Eigen::Success)
+        return;
+    const Eigen::EigenSolver<Eigen::MatrixXd> eigen(gram.solve(G.transpose() * F));
+    if (eigen.info() != Eigen::Success)
+        return;
+    std::vector<int> order(numColumns);
+    std::iota(order.begin(), order.end(), 0);
+    std::sort(order.begin(), order.end(), [&](int a, int b) {
+        return std::abs(eigen.eigenvalues()[a]) > std::abs(eigen.eigenvalues()[b]);
+    });
+
+    // real basis P of the eigenvectors, complex vectors contribute their real and imaginary parts
+    const int numVectors = std::min(mNumRecycledVectors, numColumns);
+    Eigen::MatrixXd vectors(numColumns, 2 * numVectors);
+    for (int i = 0; i < numVectors; ++i)
+    {
+        vectors.col(2 * i) = eigen.eigenvectors().col(order[i]).real();
+        vectors.col(2 * i + 1) = eigen.eigenvectors().col(order[i]).imag();
+    }
+    const Eigen::ColPivHouseholderQR<Eigen::MatrixXd> basis(vectors);
+    const int rank = std::min(numVectors, static_cast<int>(basis.rank()));
+    if (rank == 0)
+        return;
+    const Eigen::MatrixXd P = basis.householderQ() * Eigen::MatrixXd::Identity(numColumns, rank);
+
+    // A [U D, Z] P = [C V] G P = [C V] Q R  ->  C = [C V] Q, U = [U D, Z] P R^-1
+    const Eigen::HouseholderQR<Eigen::MatrixXd> qr(G * P);
+    const Eigen::MatrixXd upper =
+            qr.matrixQR().topLeftCorner(rank, rank).triangularView<Eigen::Upper>().toDenseMatrix();
+    if (upper.diagonal().cwiseAbs().minCoeff() <= 1.e-14 * upper.diagonal().cwiseAbs().maxCoeff())
+        return;
+    const Eigen::MatrixXd Q = qr.householderQ() * Eigen::MatrixXd::Identity(numColumns + 1, rank);
+    const Eigen::MatrixXd coefficients = SolveRight(P, upper);
+
+    Eigen::MatrixXd u = Z * coefficients.bottomRows(rNumSteps);
+    Eigen::MatrixXd c = V * Q.bottomRows(rNumSteps + 1);
+    if (numRecycled > 0)
+    {
+        u += mU * (d.asDiagonal() * coefficients.topRows(numRecycled));
+        c += mC * Q.topRows(numRecycled);
+    }
+    mU = std::move(u);
+    mC = std::move(c);
+}
@@ -0,0 +1,104 @@
+#pragma once
+
+#include <functional>
+#include <Eigen/Core>
+
+namespace NuTo
+{
+//! @brief flexible GMRES with deflated restarting and Krylov subspace recycling (GCRO-DR) for nonsymmetric systems
+//! @remark Parks, de Sturler, Mackey, Johnson, Maiti (2006), with the flexible right preconditioning of Carvalho,
+//! Gratton, Lago, Vasseur (2011): A recycled subspace U with C = A U, C^T C = I, is kept between the restart cycles
+//! and between the calls of Solve. Each cycle projects the residual onto C and runs Arnoldi steps with
+//! (I - C C^T) A M^-1. At the end of a cycle, U is replaced by the harmonic Ritz vectors of the smallest harmonic Ritz
+//! values, i.e. the slowly converging components. A new system, e.g. the next Newton iteration or time step, only
+//! recomputes C = A U, thus the recycled subspace is reused for slowly changing operators.
+//! The preconditioner may change from one application to the next (flexible variant). The basis vectors are
+//! orthogonalized by two passes of classical Gram-Schmidt, blocked over the rows and parallel, which is as stable as
+//! modified Gram-Schmidt.
+class GcroDr
+{
+public:
+    //! @brief rResult = operator * rVector
+    using Operator = std::function<void(const Eigen::VectorXd& rVector, Eigen::VectorXd& rResult)>;
+
+    //! @param rKrylovDimension ... maximum number of basis vectors per cycle, including the recycled ones
+    //! @param rNumRecycledVectors ... dimension of the recycled subspace, 0 for flexible GMRES(rKrylovDimension)
+    GcroDr(int rKrylovDimension = 40, int rNumRecycledVectors = 10);
+
+    //! @brief |b - A x| <= rTolerance * |b|
+    void SetTolerance(double rTolerance)
+    {
+        mTolerance = rTolerance;
+    }
+
+    //! @brief maximum number of Arnoldi steps of a call of Solve
+    void SetMaxNumIterations(int rMaxNumIterations)
+    {
+        mMaxNumIterations = rMaxNumIterations;
+    }
+
+    //! @brief solves rA * rX = rRhs with the right preconditioner rPreconditioner
+    //! @param rX ... initial guess, resized and set to zero if its size does not match
+    //! @return true if converged within the maximum number of iterations
+    bool Solve(const Operator& rA, const Operator& rPreconditioner, const Eigen::VectorXd& rRhs, Eigen::VectorXd& rX);
+
+    //! @brief Solve for a matrix type with operator * and a preconditioner with a method solve(vector), see Gmres
+    template <class T, class Preconditioner>
+    bool Solve(const T& rA, const Preconditioner& rPreconditioner, const Eigen::VectorXd& rRhs, Eigen::VectorXd& rX)
+    {
+        const Operator multiply = [&](const Eigen::VectorXd& rVector, Eigen::VectorXd& rResult) {
+            rResult = rA * rVector;
+        };
+        const Operator precondition = [&](const Eigen::VectorXd& rVector, Eigen::VectorXd& rResult) {
+            rResult = rPreconditioner.solve(rVector);
+        };
+        return Solve(multiply, precondition, rRhs, rX);
+    }
+
+    //! @brief number of Arnoldi steps of the last call of Solve
+    int GetNumIterations() const
+    {
+        return mNumIterations;
+    }
+
+    //! @brief current dimension of the recycled subspace
+    int GetNumRecycledVectors() const
+    {
+        return mU.cols();
+    }
+
+    //! @brief discards the recycled subspace, e.g. if the next system is unrelated to the previous ones
+    void ClearRecycledSubspace()
+    {
+        mU.resize(0, 0);
+        mC.resize(0, 0);
+    }
+
+private:
+    //! @brief U and C for a new operator
+    //! @param rProducts ... A U, its orthonormalized columns become C, U is transformed accordingly
+    //! @remark Linearly dependent columns are dropped.
+    void OrthonormalizeProducts(const Eigen::MatrixXd& rProducts);
+
+    //! @brief harmonic Ritz vectors of a cycle as the new recycled subspace
+    //! @remark The cycle satisfies A [U D, Z] = [C V] [D B; 0 H] with D = diag(1 / |u_i|).
+    //! @param rZ ... preconditioned Arnoldi vectors
+    //! @param rV ... Arnoldi vectors
+    //! @param rB ... C^T A Z
+    //! @param rH ... Hessenberg matrix V^T A Z
+    //! @param rNumSteps ... number of Arnoldi steps of the cycle
+    void UpdateRecycledSubspace(const Eigen::MatrixXd& rZ, const Eigen::MatrixXd& rV, const Eigen::MatrixXd& rB,
+                                const Eigen::MatrixXd& rH, int rNumSteps);
+
+    int mKrylovDimension;
+    int mNumRecycledVectors;
+    double mTolerance = 1.e-10;
+    int mMaxNumIterations = 10000;
+
+    int mNumIterations = 0;
+
+    //! @brief recycled subspace U and C = A U
+    Eigen::MatrixXd mU;
+    Eigen::MatrixXd mC;
+};
+} // namespace NuTo
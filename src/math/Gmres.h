@@ -12,9 +12,11 @@ namespace NuTo
 {
 
 /// \brief Generalized minimal residual method
-template <class T, class Preconditioner = Eigen::DiagonalPreconditioner<double>>
+/// \remark see GcroDr for a flexible variant that recycles the Krylov subspace for sequences of systems
+/// \param precond ... set up preconditioner with a method solve(vector), e.g. SmoothedAggregationAMG
+template <class T, class Preconditioner>
 int Gmres(const T& A, const Eigen::VectorXd& rhs, Eigen::VectorXd& x, const int maxNumRestarts, const double tolerance,
-          const int krylovDimension)
+          const int krylovDimension, const Preconditioner& precond)
 {
 
     using MatrixType = Eigen::MatrixXd;
@@ -34,9 +36,6 @@ int Gmres(const T& A, const Eigen::VectorXd& rhs, Eigen::VectorXd& x, const int
     VectorType e1 = VectorType::Zero(n);
     e1[0] = 1.0;
 
-    // Initialize preconditioner
-    Preconditioner precond(A);
-
     // preconditioned residual
     VectorType r = precond.solve(rhs - A * x);
     double rNorm = r.norm();
@@ -115,4 +114,13 @@ int Gmres(const T& A, const Eigen::VectorXd& rhs, Eigen::VectorXd& x, const int
     return numRestarts;
 }
 
+/// \brief Generalized minimal residual method with a preconditioner that is constructed from A
+template <class T, class Preconditioner = Eigen::DiagonalPreconditioner<double>>
+int Gmres(const T& A, const Eigen::VectorXd& rhs, Eigen::VectorXd& x, const int maxNumRestarts, const double tolerance,
+          const int krylovDimension)
+{
+    const Preconditioner precond(A);
+    return Gmres(A, rhs, x, maxNumRestarts, tolerance, krylovDimension, precond);
+}
+
 } // namespace NuTo
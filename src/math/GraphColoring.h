@@ -0,0 +1,125 @@
+#pragma once
+
+#include <algorithm>
+#include <set>
+#include <tuple>
+#include <vector>
+
+namespace NuTo
+{
+//! @brief ... vertex coloring of undirected graphs, e.g. the element connectivity graph used for the parallel assembly
+//! @remark The graph is given as adjacency list, adjacency[i] contains the (unique) neighbors of vertex i.
+namespace GraphColoring
+{
+
+//! @brief colors the graph with the DSatur heuristic (Brélaz, 1979)
+//! the vertex with the most differently colored neighbors is colored next, ties are broken by the degree
+//! @param adjacency ... adjacency list
+//! @return color of each vertex, the colors are numbered consecutively starting at 0
+inline std::vector<int> DSatur(const std::vector<std::vector<int>>& adjacency)
+{
+    const int numVertices = adjacency.size();
+    std::vector<int> colors(numVertices, -1);
+
+    // distinct colors of the neighbors of each vertex, sorted
+    std::vector<std::vector<int>> neighborColors(numVertices);
+
+    // (-saturation, -degree, vertex) --> the first entry is the next vertex to color
+    std::set<std::tuple<int, int, int>> queue;
+    for (int vertex = 0; vertex < numVertices; ++vertex)
+        queue.emplace(0, -static_cast<int>(adjacency[vertex].size()), vertex);
+
+    while (not queue.empty())
+    {
+        const int vertex = std::get<2>(*queue.begin());
+        queue.erase(queue.begin());
+
+        // smallest color not used by any neighbor
+        const auto& used = neighborColors[vertex];
+        int color = 0;
+        for (int usedColor : used)
+        {
+            if (usedColor != color)
+                break;
+            ++color;
+        }
+        colors[vertex] = color;
+
+        for (int neighbor : adjacency[vertex])
+        {
+            if (colors[neighbor] != -1)
+                continue;
+            auto& neighborUsed = neighborColors[neighbor];
+            auto it = std::lower_bound(neighborUsed.begin(), neighborUsed.end(), color);
+            if (it != neighborUsed.end() and *it == color)
+                continue;
+
+            const int degree = adjacency[neighbor].size();
+            queue.erase(std::make_tuple(-static_cast<int>(neighborUsed.size()), -degree, neighbor));
+            neighborUsed.insert(it, color);
+            queue.emplace(-static_cast<int>(neighborUsed.size()), -degree, neighbor);
+        }
+        std::vector<int>().swap(neighborColors[vertex]);
+    }
+    return colors;
+}
+
+//! @brief moves vertices from large color classes to small ones (without violating the coloring) such that all colors
+//! contain roughly the same number of vertices
+//! @param adjacency ... adjacency list
+//! @param colors ... valid coloring of the graph, modified in place
+inline void Balance(const std::vector<std::vector<int>>& adjacency, std::vector<int>& colors)
+{
+    if (colors.empty())
+        return;
+
+    const int numColors = *std::max_element(colors.begin(), colors.end()) + 1;
+    const int numVertices = colors.size();
+    const int targetSize = (numVertices + numColors - 1) / numColors;
+
+    std::vector<int> colorSizes(numColors, 0);
+    for (int color : colors)
+        colorSizes[color]++;
+
+    std::vector<bool> usedByNeighbor(numColors, false);
+    for (int vertex = 0; vertex < numVertices; ++vertex)
+    {
+        const int color = colors[vertex];
+        if (colorSizes[color] <= targetSize)
+            continue;
+
+        for (int neighbor : adjacency[vertex])
+            usedByNeighbor[colors[neighbor]] = true;
+
+        // smallest admissible color class
+        int newColor = color;
+        for (int candidate = 0; candidate < numColors; ++candidate)
+            if (not usedByNeighbor[candidate] and colorSizes[candidate] < colorSizes[newColor])
+                newColor = candidate;
+
+        for (int neighbor : adjacency[vertex])
+            usedByNeighbor[colors[neighbor]] = false;
+
+        if (colorSizes[newColor] + 1 >= colorSizes[color])
+            continue; // moving the vertex would not improve the balance
+
+        colorSizes[color]--;
+        colorSizes[newColor]++;
+        colors[vertex] = newColor;
+    }
+}
+
+//! @brief checks if no two adjacent vertices share the same color
+//! @param adjacency ... adjacency list
+//! @param colors ... color of each vertex
+inline bool IsValid(const std::vector<std::vector<int>>& adjacency, const std::vector<int>& colors)
+{
+    for (unsigned int vertex = 0; vertex < adjacency.size(); ++vertex)
+        for (int neighbor : adjacency[vertex])
+            if (colors[vertex] == colors[neighbor])
+                return false;
+    return true;
+}
+
+} // namespace GraphColoring
+} // namespace NuTo
@@ -0,0 +1,288 @@
+#pragma once
+
+#include <algorithm>
+#include <cstdint>
+#include <cstdlib>
+#include <numeric>
+#include <tuple>
+#include <vector>
+#include <Eigen/Core>
+
+#include "math/MortonOrder.h"
+
+namespace NuTo
+{
+//! @brief ... orderings of the vertices of undirected graphs, e.g. of the node connectivity graph used for the dof
+//! numbering
+//! @remark The graph is given as adjacency list, adjacency[i] contains the (unique) neighbors of vertex i. An ordering
+//! lists the vertices in their new order, ordering[newIndex] = vertex.
+namespace GraphOrdering
+{
+
+//! @brief breadth first search restricted to the vertices with mask[vertex] == label
+//! @param adjacency ... adjacency list
+//! @param mask ... label of each vertex
+//! @param label ... label of the vertices of the subgraph
+//! @param root ... start vertex, mask[root] == label
+//! @param levels ... level of each visited vertex, has to be -1 for all vertices of the subgraph, reset on return
+//! @param sortByDegree ... visits the neighbors of a vertex in ascending order of their degree (Cuthill-McKee)
+//! @return visited vertices in the order of the search and the first vertex of each level (plus the end)
+inline std::pair<std::vector<int>, std::vector<int>> LevelStructure(const std::vector<std::vector<int>>& adjacency,
+                                                                    const std::vector<int>& mask, int label, int root,
+                                                                    std::vector<int>& levels, bool sortByDegree)
+{
+    std::vector<int> visited{root};
+    std::vector<int> levelBegin{0};
+    levels[root] = 0;
+
+    std::vector<int> neighbors;
+    for (unsigned int pos = 0; pos < visited.size(); ++pos)
+    {
+        const int vertex = visited[pos];
+        if (levels[vertex] == static_cast<int>(levelBegin.size()))
+            levelBegin.push_back(pos);
+
+        neighbors.clear();
+        for (int neighbor : adjacency[vertex])
+            if (mask[neighbor] == label and levels[neighbor] == -1)
+                neighbors.push_back(neighbor);
+        if (sortByDegree)
+            std::sort(neighbors.begin(), neighbors.end(), [&](int a, int b) {
+                return std::make_tuple(adjacency[a].size(), a) < std::make_tuple(adjacency[b].size(), b);
+            });
+        for (int neighbor : neighbors)
+        {
+            levels[neighbor] = levels[vertex] + 1;
+            visited.push_back(neighbor);
+        }
+    }
+    levelBegin.push_back(visited.size());
+
+    for (int vertex : visited)
+        levels[vertex] = -1;
+    return {visited, levelBegin};
+}
+
+//! @brief finds a pseudo peripheral vertex of the connected subgraph containing root (George and Liu, 1979)
+//! @remark starting at root, the search is repeated from a vertex of minimal degree in the last level as long as the
+//! number of levels increases
+//! @param levels ... see LevelStructure
+//! @return pseudo peripheral vertex
+inline int PseudoPeripheralVertex(const std::vector<std::vector<int>>& adjacency, const std::vector<int>& mask,
+                                  int label, int root, std::vector<int>& levels)
+{
+    int numLevels = 0;
+    while (true)
+    {
+        auto levelStructure = LevelStructure(adjacency, mask, label, root, levels, false);
+        const auto& visited = levelStructure.first;
+        const auto& levelBegin = levelStructure.second;
+        const int newNumLevels = levelBegin.size() - 1;
+        if (newNumLevels <= numLevels)
+            return root;
+        numLevels = newNumLevels;
+
+        root = *std::min_element(visited.begin() + levelBegin[numLevels - 1], visited.end(), [&](int a, int b) {
+            return adjacency[a].size() < adjacency[b].size();
+        });
+    }
+}
+
+//! @brief reverse Cuthill-McKee ordering, reduces the bandwidth and the profile of the adjacency matrix
+//! @remark each connected component is ordered separately, starting at a pseudo peripheral vertex
+//! @param adjacency ... adjacency list
+//! @return ordering of the vertices
+inline std::vector<int> ReverseCuthillMcKee(const std::vector<std::vector<int>>& adjacency)
+{
+    const int numVertices = adjacency.size();
+    const std::vector<int> mask(numVertices, 0);
+    std::vector<int> levels(numVertices, -1);
+    std::vector<bool> isOrdered(numVertices, false);
+
+    std::vector<int> ordering;
+    ordering.reserve(numVertices);
+    for (int vertex = 0; vertex < numVertices; ++vertex)
+    {
+        if (isOrdered[vertex])
+            continue;
+        const int root = PseudoPeripheralVertex(adjacency, mask, 0, vertex, levels);
+        for (int componentVertex : LevelStructure(adjacency, mask, 0, root, levels, true).first)
+        {
+            isOrdered[componentVertex] = true;
+            ordering.push_back(componentVertex);
+        }
+    }
+    std::reverse(ordering.begin(), ordering.end());
+    return ordering;
+}
+
+//! @brief nested dissection ordering, reduces the fill-in of sparse direct solvers
+//! @remark The graph is recursively split by level structure separators. The vertices of both parts are ordered
+//! before the vertices of the separator. Subgraphs with less than minSize vertices are ordered by reverse
+//! Cuthill-McKee.
+//! @param adjacency ... adjacency list
+//! @param minSize ... minimal number of vertices of a subgraph to be split again
+//! @return ordering of the vertices
+inline std::vector<int> NestedDissection(const std::vector<std::vector<int>>& adjacency, int minSize = 64)
+{
+    const int numVertices = adjacency.size();
+    std::vector<int> levels(numVertices, -1);
+
+    // label of the subgraph of each vertex, -1 for ordered vertices
+    std::vector<int> mask(numVertices, 0);
+    int numLabels = 1;
+
+    // the subgraphs are processed depth first, each stack entry is (label, vertex of the subgraph, separator)
+    // separators are ordered when the entry is popped for the second time
+    std::vector<std::tuple<int, int, std::vector<int>>> stack;
+    std::vector<int> ordering;
+    ordering.reserve(numVertices);
+
+    for (int vertex = numVertices - 1; vertex >= 0; --vertex)
+        stack.emplace_back(0, vertex, std::vector<int>());
+
+    while (not stack.empty())
+    {
+        const int label = std::get<0>(stack.back());
+        const int root = std::get<1>(stack.back());
+        std::vector<int> separator = std::move(std::get<2>(stack.back()));
+        stack.pop_back();
+
+        if (label == -1)
+        {
+            // both parts are ordered
+            ordering.insert(ordering.end(), separator.begin(), separator.end());
+            continue;
+        }
+        if (mask[root] != label)
+            continue; // already ordered as part of another component
+
+        const int peripheral = PseudoPeripheralVertex(adjacency, mask, label, root, levels);
+        auto levelStructure = LevelStructure(adjacency, mask, label, peripheral, levels, true);
+        const auto& component = levelStructure.first;
+        const auto& levelBegin = levelStructure.second;
+        const int numLevels = levelBegin.size() - 1;
+
+        if (static_cast<int>(component.size()) < minSize or numLevels < 3)
+        {
+            for (auto it = component.rbegin(); it != component.rend(); ++it)
+            {
+                mask[*it] = -1;
+                ordering.push_back(*it);
+            }
+            continue;
+        }
+
+        // the middle level separates the lower from the upper levels, only its vertices with neighbors in the upper
+        // level are required in the separator
+        int middle = 1;
+        while (middle < numLevels - 2 and 2 * levelBegin[middle + 1] <= static_cast<int>(component.size()))
+            ++middle;
+
+        const int lowerLabel = numLabels++;
+        const int upperLabel = numLabels++;
+        for (int pos = 0; pos < levelBegin[middle]; ++pos)
+            mask[component[pos]] = lowerLabel;
+        for (int pos = levelBegin[middle + 1]; pos < levelBegin[numLevels]; ++pos)
+            mask[component[pos]] = upperLabel;
+
+        for (int pos = levelBegin[middle]; pos < levelBegin[middle + 1]; ++pos)
+        {
+            const int vertex = component[pos];
+            const auto& neighbors = adjacency[vertex];
+            if (std::any_of(neighbors.begin(), neighbors.end(), [&](int n) { return mask[n] == upperLabel; }))
+                separator.push_back(vertex);
+            else
+                mask[vertex] = lowerLabel;
+        }
+        for (int vertex : separator)
+            mask[vertex] = -1;
+
+        // the parts may consist of several connected components, each vertex is a potential root
+        stack.emplace_back(-1, -1, std::move(separator));
+        for (int pos = levelBegin[numLevels] - 1; pos >= 0; --pos)
+        {
+            const int vertex = component[pos];
+            if (mask[vertex] != -1)
+                stack.emplace_back(mask[vertex], vertex, std::vector<int>());
+        }
+    }
+    return ordering;
+}
+
+//! @brief orders points along the Morton curve (z-order) through their bounding box
+//! @param coordinates ... coordinates of the points, 1, 2 or 3 components
+//! @return ordering of the points
+inline std::vector<int> MortonCurve(const std::vector<Eigen::VectorXd>& coordinates)
+{
+    const int numPoints = coordinates.size();
+    std::vector<int> ordering(numPoints);
+    std::iota(ordering.begin(), ordering.end(), 0);
+    if (numPoints == 0)
+        return ordering;
+
+    const int dimension = coordinates[0].rows();
+    Eigen::VectorXd min = coordinates[0];
+    Eigen::VectorXd max = coordinates[0];
+    for (const auto& point : coordinates)
+    {
+        min = min.cwiseMin(point);
+        max = max.cwiseMax(point);
+    }
+
+    // 10 bits per component in 3D, 16 bits in 1D and 2D
+    const double numCells = dimension == 3 ? 1023. : 65535.;
+    const double extent = std::max((max - min).maxCoeff(), 1.e-300);
+    std::vector<uint32_t> codes(numPoints);
+    for (int i = 0; i < numPoints; ++i)
+    {
+        Eigen::VectorXd cell = ((coordinates[i] - min) * (numCells / extent)).array().round();
+        uint32_t x = cell[0];
+        uint32_t y = dimension > 1 ? cell[1] : 0;
+        if (dimension == 3)
+            codes[i] = MortonOrder::EncodeMorton3D(x, y, static_cast<uint32_t>(cell[2]));
+        else
+            codes[i] = (MortonOrder::Part1By1(y) << 1) + MortonOrder::Part1By1(x);
+    }
+
+    std::stable_sort(ordering.begin(), ordering.end(), [&](int a, int b) { return codes[a] < codes[b]; });
+    return ordering;
+}
+
+//! @brief returns the inverse of an ordering, inverse[vertex] = newIndex
+inline std::vector<int> Inverse(const std::vector<int>& ordering)
+{
+    std::vector<int> inverse(ordering.size());
+    for (unsigned int newIndex = 0; newIndex < ordering.size(); ++newIndex)
+        inverse[ordering[newIndex]] = newIndex;
+    return inverse;
+}
+
+//! @brief bandwidth of the adjacency matrix in the given ordering, max |newIndex(i) - newIndex(j)| of all edges
+inline int Bandwidth(const std::vector<std::vector<int>>& adjacency, const std::vector<int>& ordering)
+{
+    const std::vector<int> inverse = Inverse(ordering);
+    int bandwidth = 0;
+    for (unsigned int vertex = 0; vertex < adjacency.size(); ++vertex)
+        for (int neighbor : adjacency[vertex])
+            bandwidth = std::max(bandwidth, std::abs(inverse[vertex] - inverse[neighbor]));
+    return bandwidth;
+}
+
+//! @brief checks if the ordering is a permutation of all vertices
+inline bool IsValid(int numVertices, const std::vector<int>& ordering)
+{
+    if (static_cast<int>(ordering.size()) != numVertices)
+        return false;
+    std::vector<bool> isContained(numVertices, false);
+    for (int vertex : ordering)
+    {
+        if (vertex < 0 or vertex >= numVertices or isContained[vertex])
+            return false;
+        isContained[vertex] = true;
+    }
+    return true;
+}
+
+} // namespace GraphOrdering
+} // namespace NuTo
@@ -0,0 +1,416 @@
+#include "math/SmoothedAggregationAMG.h"
+
+#include <algorithm>
+#include <cmath>
+#include <numeric>
+#include <random>
+#include <Eigen/QR>
+
+#include "base/Exception.h"
+#include "math/SparseMatrixProduct.h"
+
+using namespace NuTo;
+
+namespace
+{
+using Matrix = SmoothedAggregationAMG::Matrix;
+
+//! @brief rResult = rA * rVector, parallel over the rows
+void Multiply(const Matrix& rA, const Eigen::VectorXd& rVector, Eigen::VectorXd& rResult)
+{
+    const int numRows = rA.rows();
+    rResult.resize(numRows);
+#ifdef _OPENMP
+#pragma omp parallel for schedule(static) if (numRows > SparseMatrixProduct::minRowsPerThread)
+#endif
+    for (int row = 0; row < numRows; ++row)
+    {
+        double sum = 0.;
+        for (Matrix::InnerIterator it(rA, row); it; ++it)
+            sum += it.value() * rVector[it.col()];
+        rResult[row] = sum;
+    }
+}
+
+//! @brief rResidual = rInverseDiagonal * (rRhs - rA * rX), parallel over the rows
+void ScaledResidual(const Matrix& rA, const Eigen::VectorXd& rInverseDiagonal, const Eigen::VectorXd& rRhs,
+                    const Eigen::VectorXd& rX, Eigen::VectorXd& rResidual)
+{
+    const int numRows = rA.rows();
+    rResidual.resize(numRows);
+#ifdef _OPENMP
+#pragma omp parallel for schedule(static) if (numRows > SparseMatrixProduct::minRowsPerThread)
+#endif
+    for (int row = 0; row < numRows; ++row)
+    {
+        double sum = rRhs[row];
+        for (Matrix::InnerIterator it(rA, row); it; ++it)
+            sum -= it.value() * rX[it.col()];
+        rResidual[row] = rInverseDiagonal.size() == 0 ? sum : rInverseDiagonal[row] * sum;
+    }
+}
+} // namespace
+
+void SmoothedAggregationAMG::SetSmoother(eSmoother rSmoother, int rNumSweeps)
+{
+    if (rNumSweeps < 1)
+        throw Exception(__PRETTY_FUNCTION__, "At least one sweep is required.");
+    mSmoother = rSmoother;
+    mNumSweeps = rNumSweeps;
+}
+
+void SmoothedAggregationAMG::Compute(const Matrix& rMatrix)
+{
+    const int numRows = rMatrix.rows();
+    if (rMatrix.cols() != numRows)
+        throw Exception(__PRETTY_FUNCTION__, "The matrix has to be square.");
+
+    Eigen::MatrixXd modes = mNearNullSpace.mModes;
+    std::vector<int> nodes = mNearNullSpace.mNodes;
+    if (modes.size() == 0)
+    {
+        modes = Eigen::MatrixXd::Ones(numRows, 1);
+        nodes.resize(numRows);
+        std::iota(nodes.begin(), nodes.end(), 0);
+    }
+    if (modes.rows() != numRows or static_cast<int>(nodes.size()) != numRows)
+        throw Exception(__PRETTY_FUNCTION__, "The near null space does not match the matrix.");
+
+    // consecutive node numbers
+    std::vector<int> nodeIds = nodes;
+    std::sort(nodeIds.begin(), nodeIds.end());
+    nodeIds.erase(std::unique(nodeIds.begin(), nodeIds.end()), nodeIds.end());
+    for (int& node : nodes)
+        node = std::lower_bound(nodeIds.begin(), nodeIds.end(), node) - nodeIds.begin();
+    int numNodes = nodeIds.size();
+
+    mLevels.clear();
+    mLevels.emplace_back();
+    mLevels.back().mA = rMatrix;
+    mLevels.back().mA.makeCompressed();
+    while (true)
+    {
+        Level& level = mLevels.back();
+        SetupSmoother(level);
+        const int numLevelRows = level.mA.rows();
+        if (numLevelRows <= mMaxCoarseSize or static_cast<int>(mLevels.size()) == mMaxNumLevels)
+            break;
+
+        const auto aggregates = Aggregate(level.mA, nodes, numNodes);
+        std::vector<int> dofAggregates(numLevelRows);
+        for (int dof = 0; dof < numLevelRows; ++dof)
+            dofAggregates[dof] = aggregates.first[nodes[dof]];
+
+        Eigen::MatrixXd coarseModes;
+        const Matrix tentative = TentativeProlongator(dofAggregates, aggregates.second, modes, coarseModes);
+        const int numCoarseRows = tentative.cols();
+        if (numCoarseRows >= 0.9 * numLevelRows)
+            break;
+
+        // P = (I - omega D^-1 A) T
+        const double omega = 4. / (3. * level.mSpectralRadius);
+        Matrix smoothing = level.mA * tentative;
+        for (int row = 0; row < smoothing.outerSize(); ++row)
+            for (Matrix::InnerIterator it(smoothing, row); it; ++it)
+                it.valueRef() *= omega * level.mInverseDiagonal[row];
+        level.mP = tentative - smoothing;
+        level.mR = level.mP.transpose();
+        Matrix coarse = level.mR * (level.mA * level.mP);
+
+        nodes.resize(numCoarseRows);
+        const int numModes = modes.cols();
+        for (int dof = 0; dof < numCoarseRows; ++dof)
+            nodes[dof] = dof / numModes;
+        numNodes = aggregates.second;
+        modes = std::move(coarseModes);
+
+        mLevels.emplace_back();
+        mLevels.back().mA = std::move(coarse);
+        mLevels.back().mA.makeCompressed();
+    }
+
+    // rows without entries, e.g. coarse dofs of aggregates with fewer dofs than modes, are decoupled
+    Eigen::MatrixXd coarse = mLevels.back().mA;
+    for (int row = 0; row < coarse.rows(); ++row)
+        if (coarse.row(row).isZero(0.))
+            coarse(row, row) = 1.;
+    mCoarseSolver.compute(coarse);
+    if (mCoarseSolver.info() != Eigen::Success)
+        throw Exception(__PRETTY_FUNCTION__, "Factorization of the coarsest matrix failed.");
+}
+
+std::pair<std::vector<int>, int> SmoothedAggregationAMG::Aggregate(const Matrix& rA, const std::vector<int>& rNodes,
+                                                                   int rNumNodes) const
+{
+    // dofs of each node
+    std::vector<int> nodeBegin(rNumNodes + 1, 0);
+    for (int node : rNodes)
+        ++nodeBegin[node + 1];
+    std::partial_sum(nodeBegin.begin(), nodeBegin.end(), nodeBegin.begin());
+    std::vector<int> nodeDofs(rNodes.size());
+    {
+        std::vector<int> position(nodeBegin.begin(), nodeBegin.end() - 1);
+        for (unsigned int dof = 0; dof < rNodes.size(); ++dof)
+            nodeDofs[position[rNodes[dof]]++] = dof;
+    }
+
+    // squared Frobenius norms of the node blocks
+    std::vector<std::vector<std::pair<int, double>>> couplings(rNumNodes);
+    std::vector<double> diagonal(rNumNodes, 0.);
+#ifdef _OPENMP
+#pragma omp parallel if (rNumNodes > SparseMatrixProduct::minRowsPerThread)
+#endif
+    {
+        std::vector<double> blockNorms(rNumNodes, 0.);
+        std::vector<int> marker(rNumNodes, -1);
+        std::vector<int> neighbors;
+#ifdef _OPENMP
+#pragma omp for schedule(static)
+#endif
+        for (int node = 0; node < rNumNodes; ++node)
+        {
+            neighbors.clear();
+            for (int pos = nodeBegin[node]; pos < nodeBegin[node + 1]; ++pos)
+                for (Matrix::InnerIterator it(rA, nodeDofs[pos]); it; ++it)
+                {
+                    const int neighbor = rNodes[it.col()];
+                    if (marker[neighbor] != node)
+                    {
+                        marker[neighbor] = node;
+                        neighbors.push_back(neighbor);
+                    }
+                    blockNorms[neighbor] += it.value() * it.value();
+                }
+            for (int neighbor : neighbors)
+            {
+                if (neighbor == node)
+                    diagonal[node] = blockNorms[neighbor];
+                else if (blockNorms[neighbor] > 0.)
+                    couplings[node].emplace_back(neighbor, blockNorms[neighbor]);
+                blockNorms[neighbor] = 0.;
+            }
+        }
+    }
+
+    // strong couplings, |A_IJ|^2 >= threshold^2 |A_II| |A_JJ|
+    const double threshold = mStrengthThreshold * mStrengthThreshold;
+    std::vector<std::vector<int>> strong(rNumNodes);
+    for (int node = 0; node < rNumNodes; ++node)
+    {
+        auto& nodeCouplings = couplings[node];
+        std::sort(nodeCouplings.begin(), nodeCouplings.end(),
+                  [](const auto& a, const auto& b) { return a.second > b.second; });
+        for (const auto& coupling : nodeCouplings)
+            if (coupling.second >= threshold * std::sqrt(diagonal[node] * diagonal[coupling.first]))
+                strong[node].push_back(coupling.first);
+    }
+
+    // 1. aggregates of nodes whose strong neighbors are not aggregated yet
+    std::vector<int> aggregates(rNumNodes, -1);
+    int numAggregates = 0;
+    for (int node = 0; node < rNumNodes; ++node)
+    {
+        if (aggregates[node] != -1 or strong[node].empty())
+            continue;
+        if (std::any_of(strong[node].begin(), strong[node].end(), [&](int n) { return aggregates[n] != -1; }))
+            continue;
+        aggregates[node] = numAggregates;
+        for (int neighbor : strong[node])
+            aggregates[neighbor] = numAggregates;
+        ++numAggregates;
+    }
+
+    // 2. remaining nodes join the aggregate of their strongest aggregated neighbor
+    std::vector<int> firstAggregates(aggregates);
+    for (int node = 0; node < rNumNodes; ++node)
+    {
+        if (aggregates[node] != -1)
+            continue;
+        for (int neighbor : strong[node])
+            if (firstAggregates[neighbor] != -1)
+            {
+                aggregates[node] = firstAggregates[neighbor];
+                break;
+            }
+    }
+
+    // 3. aggregates of the rest, including isolated nodes
+    for (int node = 0; node < rNumNodes; ++node)
+    {
+        if (aggregates[node] != -1)
+            continue;
+        aggregates[node] = numAggregates;
+        for (int neighbor : strong[node])
+            if (aggregates[neighbor] == -1)
+                aggregates[neighbor] = numAggregates;
+        ++numAggregates;
+    }
+    return {aggregates, numAggregates};
+}
+
+SmoothedAggregationAMG::Matrix SmoothedAggregationAMG::TentativeProlongator(const std::vector<int>& rDofAggregates,
+                                                                            int rNumAggregates,
+                                                                            const Eigen::MatrixXd& rModes,
+                                                                            Eigen::MatrixXd& rCoarseModes)
+{
+    const int numDofs = rDofAggregates.size();
+    const int numModes = rModes.cols();
+
+    std::vector<int> aggregateBegin(rNumAggregates + 1, 0);
+    for (int aggregate : rDofAggregates)
+        ++aggregateBegin[aggregate + 1];
+    std::partial_sum(aggregateBegin.begin(), aggregateBegin.end(), aggregateBegin.begin());
+    std::vector<int> aggregateDofs(numDofs);
+    {
+        std::vector<int> position(aggregateBegin.begin(), aggregateBegin.end() - 1);
+        for (int dof = 0; dof < numDofs; ++dof)
+            aggregateDofs[position[rDofAggregates[dof]]++] = dof;
+    }
+
+    // Q R = modes of the aggregate, Q is the block of the tentative prolongator, R the coarse modes
+    rCoarseModes = Eigen::MatrixXd::Zero(rNumAggregates * numModes, numModes);
+    std::vector<Eigen::MatrixXd> blocks(rNumAggregates);
+#ifdef _OPENMP
+#pragma omp parallel for schedule(dynamic, 64) if (numDofs > SparseMatrixProduct::minRowsPerThread)
+#endif
+    for (int aggregate = 0; aggregate < rNumAggregates; ++aggregate)
+    {
+        const int begin = aggregateBegin[aggregate];
+        const int size = aggregateBegin[aggregate + 1] - begin;
+        Eigen::MatrixXd aggregateModes(size, numModes);
+        for (int i = 0; i < size; ++i)
+            aggregateModes.row(i) = rModes.row(aggregateDofs[begin + i]);
+
+        const int rank = std::min(size, numModes);
+        const Eigen::HouseholderQR<Eigen::MatrixXd> qr(aggregateModes);
+        blocks[aggregate] = qr.householderQ() * Eigen::MatrixXd::Identity(size, rank);
+        rCoarseModes.block(aggregate * numModes, 0, rank, numModes) =
+                qr.matrixQR().topRows(rank).triangularView<Eigen::Upper>();
+    }
+
+    std::vector<Eigen::Triplet<double>> entries;
+    entries.reserve(static_cast<long>(numDofs) * numModes);
+    for (int aggregate = 0; aggregate < rNumAggregates; ++aggregate)
+    {
+        const Eigen::MatrixXd& block = blocks[aggregate];
+        for (int i = 0; i < block.rows(); ++i)
+            for (int j = 0; j < block.cols(); ++j)
+                entries.emplace_back(aggregateDofs[aggregateBegin[aggregate] + i], aggregate * numModes + j,
+                                     block(i, j));
+    }
+    Matrix tentative(numDofs, rNumAggregates * numModes);
+    tentative.setFromTriplets(entries.begin(), entries.end());
+    return tentative;
+}
+
+void SmoothedAggregationAMG::SetupSmoother(Level& rLevel)
+{
+    const Matrix& a = rLevel.mA;
+    const int numRows = a.rows();
+    rLevel.mInverseDiagonal = Eigen::VectorXd::Zero(numRows);
+    for (int row = 0; row < numRows; ++row)
+    {
+        const double diagonal = a.coeff(row, row);
+        if (diagonal != 0.)
+            rLevel.mInverseDiagonal[row] = 1. / std::abs(diagonal);
+    }
+
+    // power iteration for the largest eigenvalue of D^-1 A, with a safety factor
+    std::mt19937 generator(0);
+    std::uniform_real_distribution<double> distribution(-1., 1.);
+    Eigen::VectorXd x(numRows);
+    for (int row = 0; row < numRows; ++row)
+        x[row] = distribution(generator);
+    Eigen::VectorXd y;
+    double radius = 1.;
+    for (int iteration = 0; iteration < 15; ++iteration)
+    {
+        x.normalize();
+        Multiply(a, x, y);
+        y = y.cwiseProduct(rLevel.mInverseDiagonal);
+        radius = y.norm();
+        if (radius == 0.)
+        {
+            radius = 1.;
+            break;
+        }
+        x.swap(y);
+    }
+    rLevel.mSpectralRadius = 1.1 * radius;
+}
+
+void SmoothedAggregationAMG::Smooth(const Level& rLevel, const Eigen::VectorXd& rRhs, Eigen::VectorXd& rX) const
+{
+    const double upper = rLevel.mSpectralRadius;
+    Eigen::VectorXd residual;
+    if (mSmoother == eSmoother::JACOBI)
+    {
+        const double omega = 4. / (3. * upper);
+        for (int sweep = 0; sweep < mNumSweeps; ++sweep)
+        {
+            ScaledResidual(rLevel.mA, rLevel.mInverseDiagonal, rRhs, rX, residual);
+            rX += omega * residual;
+        }
+        return;
+    }
+
+    // Chebyshev iteration for the eigenvalues of D^-1 A in [upper / 30, upper]
+    const double lower = upper / 30.;
+    const double theta = 0.5 * (upper + lower);
+    const double delta = 0.5 * (upper - lower);
+    const double sigma = theta / delta;
+    double rho = 1. / sigma;
+
+    ScaledResidual(rLevel.mA, rLevel.mInverseDiagonal, rRhs, rX, residual);
+    Eigen::VectorXd direction = residual / theta;
+    Eigen::VectorXd product;
+    for (int degree = 1; degree <= mNumSweeps; ++degree)
+    {
+        rX += direction;
+        if (degree == mNumSweeps)
+            break;
+        Multiply(rLevel.mA, direction, product);
+        residual -= product.cwiseProduct(rLevel.mInverseDiagonal);
+        const double rhoNew = 1. / (2. * sigma - rho);
+        direction = (rhoNew * rho) * direction + (2. * rhoNew / delta) * residual;
+        rho = rhoNew;
+    }
+}
+
+void SmoothedAggregationAMG::Cycle(int rLevel, const Eigen::VectorXd& rRhs, Eigen::VectorXd& rX) const
+{
+    if (rLevel == static_cast<int>(mLevels.size()) - 1)
+    {
+        rX = mCoarseSolver.solve(rRhs);
+        return;
+    }
+    const Level& level = mLevels[rLevel];
+    rX = Eigen::VectorXd::Zero(rRhs.rows());
+    Smooth(level, rRhs, rX);
+
+    Eigen::VectorXd residual;
+    ScaledResidual(level.mA, Eigen::VectorXd(), rRhs, rX, residual);
+    Eigen::VectorXd coarseRhs;
+    Multiply(level.mR, residual, coarseRhs);
+    Eigen::VectorXd coarseX;
+    Cycle(rLevel + 1, coarseRhs, coarseX);
+    Multiply(level.mP, coarseX, residual);
+    rX += residual;
+
+    Smooth(level, rRhs, rX);
+}
+
+void SmoothedAggregationAMG::Apply(const Eigen::VectorXd& rRhs, Eigen::VectorXd& rResult) const
+{
+    if (mLevels.empty())
+        throw Exception(__PRETTY_FUNCTION__, "Call Compute first.");
+    Cycle(0, rRhs, rResult);
+}
+
+double SmoothedAggregationAMG::GetOperatorComplexity() const
+{
+    double numEntries = 0.;
+    for (const Level& level : mLevels)
+        numEntries += level.mA.nonZeros();
+    return numEntries / mLevels.front().mA.nonZeros();
+}
@@ -0,0 +1,140 @@
+#pragma once
+
+#include <utility>
+#include <vector>
+#include <Eigen/Core>
+#include <Eigen/Cholesky>
+#include <Eigen/SparseCore>
+
+namespace NuTo
+{
+//! @brief vectors that the smoothers of a multigrid method cannot reduce, e.g. the rigid body modes for elasticity
+//! @remark mModes has one row per dof and one column per vector. mNodes[dof] identifies the node of a dof, the dofs of
+//! a node always end up in the same aggregate. See StructureBase::BuildNearNullSpace.
+struct NearNullSpace
+{
+    Eigen::MatrixXd mModes;
+    std::vector<int> mNodes;
+};
+
+//! @brief algebraic multigrid preconditioner with smoothed aggregation for symmetric positive (semi-)definite matrices
+//! @remark Setup (Vanek, Mandel, Brezina 1996): The nodes of a level are grouped into aggregates of strongly coupled
+//! nodes. The near null space restricted to an aggregate is orthonormalized and forms the tentative prolongator, its
+//! R factor is the near null space of the coarse level with one coarse node per aggregate. The prolongator is smoothed
+//! by a damped Jacobi step and the coarse matrix is the Galerkin product P^T A P. The coarsest matrix is factorized
+//! densely.
+//! The application is a V-cycle with a zero initial guess and identical pre- and post-smoothing, i.e. a symmetric
+//! positive definite preconditioner for PCG, see SolverIterative, or Gmres. The smoothers (Jacobi or Chebyshev
+//! polynomials of D^-1 A) and the transfer operators consist of parallel matrix vector products.
+class SmoothedAggregationAMG
+{
+public:
+    using Matrix = Eigen::SparseMatrix<double, Eigen::RowMajor>;
+
+    enum class eSmoother
+    {
+        JACOBI, //!< damped Jacobi, damping 4 / (3 rho(D^-1 A))
+        CHEBYSHEV //!< Chebyshev polynomial of D^-1 A for the upper part of its spectrum
+    };
+
+    SmoothedAggregationAMG() = default;
+
+    //! @brief setup with the constant vector as near null space, e.g. for scalar problems or as a preconditioner in
+    //! Gmres
+    explicit SmoothedAggregationAMG(const Matrix& rMatrix)
+    {
+        Compute(rMatrix);
+    }
+
+    //! @brief near null space of the next Compute, the default is the constant vector with one node per dof
+    void SetNearNullSpace(NearNullSpace rNearNullSpace)
+    {
+        mNearNullSpace = std::move(rNearNullSpace);
+    }
+
+    //! @brief smoother and the number of sweeps (Jacobi) or the polynomial degree (Chebyshev)
+    void SetSmoother(eSmoother rSmoother, int rNumSweeps);
+
+    //! @brief nodes I, J are strongly coupled if |A_IJ| >= threshold * sqrt(|A_II| |A_JJ|), Frobenius norms of the
+    //! node blocks
+    void SetStrengthThreshold(double rThreshold)
+    {
+        mStrengthThreshold = rThreshold;
+    }
+
+    //! @brief the coarsening stops at this number of dofs
+    void SetMaxCoarseSize(int rMaxCoarseSize)
+    {
+        mMaxCoarseSize = rMaxCoarseSize;
+    }
+
+    //! @brief builds the hierarchy for rMatrix
+    void Compute(const Matrix& rMatrix);
+
+    //! @brief one V-cycle for rRhs with a zero initial guess
+    //! @remark lower case, like the preconditioners of Eigen, see Gmres
+    Eigen::VectorXd solve(const Eigen::VectorXd& rRhs) const
+    {
+        Eigen::VectorXd result;
+        Apply(rRhs, result);
+        return result;
+    }
+
+    //! @brief rResult = one V-cycle for rRhs with a zero initial guess
+    void Apply(const Eigen::VectorXd& rRhs, Eigen::VectorXd& rResult) const;
+
+    int GetNumLevels() const
+    {
+        return mLevels.size();
+    }
+
+    //! @brief number of rows of the matrix of a level
+    int GetNumRows(int rLevel) const
+    {
+        return mLevels[rLevel].mA.rows();
+    }
+
+    //! @brief sum of the entries of all level matrices divided by the entries of the finest matrix
+    double GetOperatorComplexity() const;
+
+private:
+    struct Level
+    {
+        Matrix mA;
+        Eigen::VectorXd mInverseDiagonal;
+        //! @brief upper bound of the spectral radius of D^-1 A
+        double mSpectralRadius = 1.;
+        //! @brief prolongator from the next coarser level and its transpose, the restriction
+        Matrix mP;
+        Matrix mR;
+    };
+
+    //! @brief aggregate of each node, see class description
+    //! @param rA ... matrix of the level
+    //! @param rNodes ... node of each dof, 0 ... rNumNodes - 1
+    //! @return aggregate of each node and the number of aggregates
+    std::pair<std::vector<int>, int> Aggregate(const Matrix& rA, const std::vector<int>& rNodes, int rNumNodes) const;
+
+    //! @brief tentative prolongator of the aggregates and the coarse near null space
+    static Matrix TentativeProlongator(const std::vector<int>& rDofAggregates, int rNumAggregates,
+                                       const Eigen::MatrixXd& rModes, Eigen::MatrixXd& rCoarseModes);
+
+    //! @brief diagonal and spectral radius for the smoothers
+    static void SetupSmoother(Level& rLevel);
+
+    //! @brief rX = smoothed rX for rA x = rRhs
+    void Smooth(const Level& rLevel, const Eigen::VectorXd& rRhs, Eigen::VectorXd& rX) const;
+
+    void Cycle(int rLevel, const Eigen::VectorXd& rRhs, Eigen::VectorXd& rX) const;
+
+    NearNullSpace mNearNullSpace;
+    eSmoother mSmoother = eSmoother::CHEBYSHEV;
+    int mNumSweeps = 2;
+    double mStrengthThreshold = 0.08;
+    int mMaxCoarseSize = 500;
+    int mMaxNumLevels = 20;
+
+    std::vector<Level> mLevels;
+    Eigen::LDLT<Eigen::MatrixXd> mCoarseSolver;
+};
+} // namespace NuTo
@@ -35,6 +35,27 @@ void NuTo::SparseDirectSolverMUMPS::Solve(const NuTo::SparseMatrixCSR<double>& r
 //! @brief ... prepare the solver, and perform all the steps up to the factorization of the matrix
 //! @param rMatrix ... sparse coefficient matrix, stored in compressed CSR format (input)
 void NuTo::SparseDirectSolverMUMPS::Factorization(const NuTo::SparseMatrixCSR<double>& rMatrix)
+{
+    Analysis(rMatrix);
+    NumericalFactorization(rMatrix);
+}
+
+
+NuTo::SparseDirectSolverMUMPS::~SparseDirectSolverMUMPS()
+{
+#ifdef HAVE_MUMPS
+    if (mIsInitialized)
+    {
+        mSolver.job = -2;
+        dmumps_c(&mSolver);
+    }
+#endif // HAVE_MUMPS
+}
+
+
+//! @brief ... prepare the solver, reordering and symbolic factorization of the matrix
+//! @param rMatrix ... sparse coefficient matrix, stored in compressed CSR format (input)
+void NuTo::SparseDirectSolverMUMPS::Analysis(const NuTo::SparseMatrixCSR<double>& rMatrix)
 {
 #ifdef HAVE_MUMPS
     Timer timer(std::string("MUMPS ") + __FUNCTION__ + " reordering and symbolic factorization", GetShowTime());
@@ -49,20 +70,22 @@ void NuTo::SparseDirectSolverMUMPS::Factorization(const NuTo::SparseMatrixCSR<do
     {
         throw NuTo::Exception(__PRETTY_FUNCTION__, "matrix is not square.");
     }
+    CleanUp();
+
     const std::vector<int>& matrixRowIndex = rMatrix.GetRowIndex();
     // extract rows from rowIndex
-    std::vector<int> matrixRows(rMatrix.GetNumEntries());
+    mRows.resize(rMatrix.GetNumEntries());
     int entryCount = 0;
     for (int rowCount = 0; rowCount < matrixDimension; rowCount++)
     {
         for (int indexCount = matrixRowIndex[rowCount]; indexCount < matrixRowIndex[rowCount + 1]; indexCount++)
         {
             assert(entryCount < rMatrix.GetNumEntries());
-            matrixRows[entryCount] = rowCount + 1;
+            mRows[entryCount] = rowCount + 1;
             entryCount++;
         }
     }
-    const std::vector<int>& matrixColumns = rMatrix.GetColumns();
+    mColumns = rMatrix.GetColumns();
     const std::vector<double>& matrixValues = rMatrix.GetValues();
 
     // initialize solver data
@@ -89,13 +112,14 @@ void NuTo::SparseDirectSolverMUMPS::Factorization(const NuTo::SparseMatrixCSR<do
     // initialize solver
     mSolver.job = -1;
     dmumps_c(&mSolver);
+    mIsInitialized = true;
 
     // define the problem
     mSolver.n = matrixDimension; // dimension
     mSolver.nz = rMatrix.GetNumEntries(); // number of nonzero entries
-    mSolver.irn = &matrixRows[0]; // rows
-    mSolver.jcn = const_cast<int*>(&matrixColumns[0]); // columns
-    mSolver.a = const_cast<double*>(&matrixValues[0]); // values
+    mSolver.irn = mRows.data(); // rows
+    mSolver.jcn = mColumns.data(); // columns
+    mSolver.a = const_cast<double*>(matrixValues.data()); // values
     mSolver.rhs = nullptr; // right hand side vector is set befor solution
     // define mSolver specific parameters
     mSolver.icntl[0] = 0; // output stream for error messages
@@ -122,8 +146,24 @@ void NuTo::SparseDirectSolverMUMPS::Factorization(const NuTo::SparseMatrixCSR<do
         throw NuTo::Exception(__PRETTY_FUNCTION__,
                               "Analysis and reordering phase: " + this->GetErrorString(mSolver.info[0]) + ".");
     }
+#else // HAVE_MUMPS
+    throw NuTo::Exception(__PRETTY_FUNCTION__, "MUMPS-solver was not found on your system (check cmake)");
+#endif // HAVE_MUMPS
+}
 
-    timer.Reset(std::string("MUMPS ") + __FUNCTION__ + " numerical factorization");
+
+//! @brief ... numerical factorization of a matrix with the pattern of the last Analysis
+//! @param rMatrix ... sparse coefficient matrix, stored in compressed CSR format (input)
+void NuTo::SparseDirectSolverMUMPS::NumericalFactorization(const NuTo::SparseMatrixCSR<double>& rMatrix)
+{
+#ifdef HAVE_MUMPS
+    Timer timer(std::string("MUMPS ") + __FUNCTION__, GetShowTime());
+
+    if (not mIsInitialized or mSolver.n != rMatrix.GetNumRows() or mSolver.nz != rMatrix.GetNumEntries())
+    {
+        throw NuTo::Exception(__PRETTY_FUNCTION__, "the pattern of the matrix differs from the analyzed one.");
+    }
+    mSolver.a = const_cast<double*>(rMatrix.GetValues().data()); // values
 
     // Numerical factorization.
     mSolver.job = 2;
@@ -189,10 +229,13 @@ void NuTo::SparseDirectSolverMUMPS::Solution(const Eigen::VectorXd& rRhs, Eigen:
 void NuTo::SparseDirectSolverMUMPS::CleanUp()
 {
 #ifdef HAVE_MUMPS
+    if (not mIsInitialized)
+        return;
     Timer timer(std::string("MUMPS ") + __FUNCTION__, GetShowTime());
     // Termination and release of memory
     mSolver.job = -2;
     dmumps_c(&mSolver);
+    mIsInitialized = false;
     if (mSolver.info[0] < 0)
     {
         throw NuTo::Exception(__PRETTY_FUNCTION__, "Termination phase: " + this->GetErrorString(mSolver.info[0]) + ".");
@@ -244,6 +287,8 @@ void NuTo::SparseDirectSolverMUMPS::SchurComplement(
     // add indices by one, since the external interface always counts from zero and mumps requires one based indexing
     rSchurIndices += Eigen::VectorXi::Ones(rSchurIndices.rows());
 
+    CleanUp();
+
     // initialize solver data
     // set MPI communicator (also required in sequential version)
     mSolver.comm_fortran = -987654;
@@ -268,6 +313,7 @@ void NuTo::SparseDirectSolverMUMPS::SchurComplement(
     // initialize mSolver
     mSolver.job = -1;
     dmumps_c(&mSolver);
+    mIsInitialized = true;
 
     // resize result matrix
     Eigen::Matrix<double, Eigen::Dynamic, Eigen::Dynamic> rSchurComplementTranspose(rSchurIndices.rows(),
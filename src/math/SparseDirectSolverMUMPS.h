@@ -8,6 +8,7 @@ extern "C" {
 
 
 #include "math/SparseDirectSolver.h"
+#include <vector>
 #include <Eigen/Core>
 
 namespace NuTo
@@ -28,6 +29,12 @@ public:
     //! @brief ... default constructor
     SparseDirectSolverMUMPS();
 
+    //! @brief ... releases the memory of the factorization, if CleanUp was not called
+    ~SparseDirectSolverMUMPS();
+
+    SparseDirectSolverMUMPS(const SparseDirectSolverMUMPS&) = delete;
+    SparseDirectSolverMUMPS& operator=(const SparseDirectSolverMUMPS&) = delete;
+
     //! @brief ... solve system of equations: rMatrix * rSolution = rRhs
     //! @param rMatrix ... sparse coefficient matrix, stored in compressed CSR format (input)
     //! @param rRhs ... matrix storing the right-hand-side vectors (input)
@@ -47,6 +54,15 @@ public:
     //! @param rMatrix ... sparse coefficient matrix, stored in compressed CSR format (input)
     void Factorization(const NuTo::SparseMatrixCSR<double>& rMatrix);
 
+    //! @brief ... prepare the solver, reordering and symbolic factorization of the matrix
+    //! @remark ... the pattern of rMatrix is copied, a previous factorization is released
+    //! @param rMatrix ... sparse coefficient matrix, stored in compressed CSR format (input)
+    void Analysis(const NuTo::SparseMatrixCSR<double>& rMatrix);
+
+    //! @brief ... numerical factorization of a matrix with the pattern of the last Analysis
+    //! @param rMatrix ... sparse coefficient matrix, stored in compressed CSR format (input)
+    void NumericalFactorization(const NuTo::SparseMatrixCSR<double>& rMatrix);
+
     //! @brief ... use the factorized matrix for the final solution phase
     //! @param rMatrix ... sparse coefficient matrix, stored in compressed CSR format (input)
     //! @param rRhs ... matrix storing the right-hand-side vectors (input)
@@ -63,6 +79,13 @@ protected:
 
 #endif // HAVE_MUMPS
 
+    //! @brief ... true between the initialization in Analysis and CleanUp
+    bool mIsInitialized = false;
+
+    //! @brief ... one based row and column indices of the entries, required by all phases
+    std::vector<int> mRows;
+    std::vector<int> mColumns;
+
     //! @brief ... generate an error message from the error code
     //! @param error ... error code
     //! @return error message as std::string
@@ -34,10 +34,24 @@ NuTo::SparseDirectSolverPardiso::SparseDirectSolverPardiso(int rNumThreads, int
 }
 
 #ifdef HAVE_PARDISO
+NuTo::SparseDirectSolverPardiso::~SparseDirectSolverPardiso()
+{
+    if (mIsInitialized)
+        Termination();
+}
+
 void NuTo::SparseDirectSolverPardiso::Solve(const NuTo::SparseMatrixCSR<double>& rMatrix, const Eigen::VectorXd& rRhs,
                                             Eigen::VectorXd& rSolution)
 {
     Timer timerTotal(std::string("PARDISO ") + __FUNCTION__ + " TOTAL TIME", GetShowTime());
+    Analysis(rMatrix);
+    NumericalFactorization(rMatrix);
+    Solution(rRhs, rSolution);
+    CleanUp();
+}
+
+void NuTo::SparseDirectSolverPardiso::Analysis(const NuTo::SparseMatrixCSR<double>& rMatrix)
+{
     Timer timer(std::string("PARDISO ") + __FUNCTION__ + " License checking and and initialization", GetShowTime());
 
     // check rMatrix
@@ -45,47 +59,35 @@ void NuTo::SparseDirectSolverPardiso::Solve(const NuTo::SparseMatrixCSR<double>&
     {
         throw NuTo::Exception(__PRETTY_FUNCTION__, "one based indexing of sparse rMatrix is required for this solver.");
     }
-    int matrixDimension = rMatrix.GetNumRows();
-    if (matrixDimension != rMatrix.GetNumColumns())
+    if (rMatrix.GetNumRows() != rMatrix.GetNumColumns())
     {
         throw NuTo::Exception(__PRETTY_FUNCTION__, "matrix must be square.");
     }
-    const std::vector<int>& matrixRowIndex = rMatrix.GetRowIndex();
-    const std::vector<int>& matrixColumns = rMatrix.GetColumns();
+    CleanUp();
+
+    mMatrixDimension = rMatrix.GetNumRows();
+    mRowIndex = rMatrix.GetRowIndex();
+    mColumns = rMatrix.GetColumns();
     const std::vector<double>& matrixValues = rMatrix.GetValues();
-    int matrixType;
     if (rMatrix.IsSymmetric())
     {
         if (rMatrix.IsPositiveDefinite())
         {
-            matrixType = 2;
+            mMatrixType = 2;
         }
         else
         {
-            matrixType = -2;
+            mMatrixType = -2;
         }
     }
     else
     {
-        matrixType = 11;
+        mMatrixType = 11;
     }
 
-    // check right hand side
-    if (matrixDimension != rRhs.rows())
-    {
-        throw NuTo::Exception(__PRETTY_FUNCTION__, "invalid dimension of right hand side vector.");
-    }
-    int rhsNumColumns = 1;
-    const double* rhsValues = rRhs.data();
-
-    // prepare solution matrix
-    rSolution.resize(matrixDimension);
-    const double* solutionValues = rSolution.data();
-
-    void* pt[64];
     for (unsigned int count = 0; count < 64; count++)
     {
-        pt[count] = 0;
+        mPt[count] = 0;
     }
     int maxfct(1); // Maximum number of numerical factorizations.
     int mnum(1); // Which factorization to use.
@@ -93,23 +95,21 @@ void NuTo::SparseDirectSolverPardiso::Solve(const NuTo::SparseMatrixCSR<double>&
     int error(0); // Initialize error flag
     double ddum(0); // Double dummy
     int idum(0); // Integer dummy
-
-    int parameters[64];
-    double dparameters[64];
+    int rhsNumColumns = 1;
 
 #ifdef _OPENMP
-    parameters[2] = mNumThreads;
+    mParameters[2] = mNumThreads;
 #else
-    parameters[2] = 1;
+    mParameters[2] = 1;
 #endif
 
     /** checks the current license in the file pardiso.lic and initializes the internal
     timer and the address pointer pt. It sets the solver default values according to the matrix type. **/
 
-    pardisoinit(pt, &matrixType, &mSolver, parameters, dparameters, &error);
+    pardisoinit(mPt, &mMatrixType, &mSolver, mParameters, mDParameters, &error);
 
     // parallel METIS reordering
-    parameters[27] = 1;
+    mParameters[27] = 1;
 
 
     if (error != 0)
@@ -121,98 +121,157 @@ void NuTo::SparseDirectSolverPardiso::Solve(const NuTo::SparseMatrixCSR<double>&
         if (error == -12)
             throw NuTo::Exception(__PRETTY_FUNCTION__, "Wrong username or hostname.");
     }
+    mIsInitialized = true;
 
     timer.Reset(std::string("PARDISO ") + __FUNCTION__ + " reordering and symbolic factorization");
 
     // Reordering and Symbolic Factorization.
     // This step also allocates all memory that is necessary for the factorization.
     int phase = 11;
-    // int a = omp_get_num_threads();
-    pardiso(pt, &maxfct, &mnum, &matrixType, &phase, &matrixDimension, const_cast<double*>(&matrixValues[0]),
-            const_cast<int*>(&matrixRowIndex[0]), const_cast<int*>(&matrixColumns[0]), &idum, &rhsNumColumns,
-            parameters, &msglvl, &ddum, &ddum, &error, dparameters);
+    pardiso(mPt, &maxfct, &mnum, &mMatrixType, &phase, &mMatrixDimension, const_cast<double*>(matrixValues.data()),
+            mRowIndex.data(), mColumns.data(), &idum, &rhsNumColumns, mParameters, &msglvl, &ddum, &ddum, &error,
+            mDParameters);
 
     if (error != 0)
     {
         throw NuTo::Exception(__PRETTY_FUNCTION__,
                               "Analysis and reordering phase: " + this->GetErrorString(error) + ".");
     }
+}
 
-    timer.Reset(std::string("PARDISO ") + __FUNCTION__ + " numerical factorization");
+void NuTo::SparseDirectSolverPardiso::NumericalFactorization(const NuTo::SparseMatrixCSR<double>& rMatrix)
+{
+    Timer timer(std::string("PARDISO ") + __FUNCTION__, GetShowTime());
+
+    if (not mIsInitialized or rMatrix.GetNumRows() != mMatrixDimension or
+        rMatrix.GetNumEntries() != static_cast<int>(mColumns.size()))
+    {
+        throw NuTo::Exception(__PRETTY_FUNCTION__, "the pattern of the matrix differs from the analyzed one.");
+    }
+
+    int maxfct(1); // Maximum number of numerical factorizations.
+    int mnum(1); // Which factorization to use.
+    int msglvl(this->mVerboseLevel); // Print statistical information in file
+    int error(0); // Initialize error flag
+    double ddum(0); // Double dummy
+    int idum(0); // Integer dummy
+    int rhsNumColumns = 1;
 
     // Numerical factorization.
-    phase = 22;
-    pardiso(pt, &maxfct, &mnum, &matrixType, &phase, &matrixDimension, const_cast<double*>(&matrixValues[0]),
-            const_cast<int*>(&matrixRowIndex[0]), const_cast<int*>(&matrixColumns[0]), &idum, &rhsNumColumns,
-            parameters, &msglvl, &ddum, &ddum, &error, dparameters);
+    int phase = 22;
+    mMatrixValues = rMatrix.GetValues().data();
+    pardiso(mPt, &maxfct, &mnum, &mMatrixType, &phase, &mMatrixDimension, const_cast<double*>(mMatrixValues),
+            mRowIndex.data(), mColumns.data(), &idum, &rhsNumColumns, mParameters, &msglvl, &ddum, &ddum, &error,
+            mDParameters);
     if (error != 0)
     {
-        throw NuTo::MathException(__PRETTY_FUNCTION__,
-                                  "Numerical factorization phase: " + this->GetErrorString(error) + ".");
+        throw NuTo::Exception(__PRETTY_FUNCTION__,
+                              "Numerical factorization phase: " + this->GetErrorString(error) + ".");
     }
+}
 
-    timer.Reset(std::string("PARDISO ") + __FUNCTION__ + " back substitution and iterative refinement");
+void NuTo::SparseDirectSolverPardiso::Solution(const Eigen::VectorXd& rRhs, Eigen::VectorXd& rSolution)
+{
+    Timer timer(std::string("PARDISO ") + __FUNCTION__ + " back substitution and iterative refinement",
+                GetShowTime());
+
+    // check right hand side
+    if (mMatrixDimension != rRhs.rows())
+    {
+        throw NuTo::Exception(__PRETTY_FUNCTION__, "invalid dimension of right hand side vector.");
+    }
+    int rhsNumColumns = 1;
+    const double* rhsValues = rRhs.data();
+
+    // prepare solution matrix
+    rSolution.resize(mMatrixDimension);
+    const double* solutionValues = rSolution.data();
+
+    int maxfct(1); // Maximum number of numerical factorizations.
+    int mnum(1); // Which factorization to use.
+    int msglvl(this->mVerboseLevel); // Print statistical information in file
+    int error(0); // Initialize error flag
+    int idum(0); // Integer dummy
 
     // Back substitution and iterative refinement.
-    phase = 33;
-    pardiso(pt, &maxfct, &mnum, &matrixType, &phase, &matrixDimension, const_cast<double*>(&matrixValues[0]),
-            const_cast<int*>(&matrixRowIndex[0]), const_cast<int*>(&matrixColumns[0]), &idum, &rhsNumColumns,
-            parameters, &msglvl, const_cast<double*>(rhsValues), const_cast<double*>(solutionValues), &error,
-            dparameters);
+    // The values are only used by the iterative refinement, they have to be those of the factorized matrix.
+    int phase = 33;
+    pardiso(mPt, &maxfct, &mnum, &mMatrixType, &phase, &mMatrixDimension, const_cast<double*>(mMatrixValues),
+            mRowIndex.data(), mColumns.data(), &idum, &rhsNumColumns, mParameters, &msglvl,
+            const_cast<double*>(rhsValues), const_cast<double*>(solutionValues), &error, mDParameters);
     if (error != 0)
     {
-        throw NuTo::MathException(__PRETTY_FUNCTION__, "Back substitution and iterative refinement phase: " +
-                                                               this->GetErrorString(error) + ".");
+        throw NuTo::Exception(__PRETTY_FUNCTION__,
+                              "Back substitution and iterative refinement phase: " + this->GetErrorString(error) + ".");
     }
+}
 
-    timer.Reset(std::string("PARDISO ") + __FUNCTION__ + " termination");
+void NuTo::SparseDirectSolverPardiso::CleanUp()
+{
+    if (not mIsInitialized)
+        return;
 
+    Timer timer(std::string("PARDISO ") + __FUNCTION__ + " termination", GetShowTime());
 
     if (this->mVerboseLevel > 1)
     {
-        std::cout << "[SparseDirectSolverPardiso::solve] Peak memory symbolic factorization: " << parameters[14]
+        std::cout << "[SparseDirectSolverPardiso::solve] Peak memory symbolic factorization: " << mParameters[14]
                   << " KBytes" << std::endl;
-        std::cout << "[SparseDirectSolverPardiso::solve] Permanent memory symbolic factorization: " << parameters[15]
+        std::cout << "[SparseDirectSolverPardiso::solve] Permanent memory symbolic factorization: " << mParameters[15]
                   << " KBytes" << std::endl;
         std::cout << "[SparseDirectSolverPardiso::solve] Memory numerical factorization and solution: "
-                  << parameters[16] << " KBytes" << std::endl;
+                  << mParameters[16] << " KBytes" << std::endl;
         if (this->mVerboseLevel > 2)
         {
             std::cout << "[SparseDirectSolverPardiso::solve] Number of floating point operations required for "
                          "factorization: "
-                      << parameters[18] << " MFLOS" << std::endl;
-            if (matrixType == -2)
+                      << mParameters[18] << " MFLOS" << std::endl;
+            if (mMatrixType == -2)
             {
                 std::cout << "[SparseDirectSolverPardiso::solve] Inertia: number of positive eigenvalues: "
-                          << parameters[21] << std::endl;
+                          << mParameters[21] << std::endl;
                 std::cout << "[SparseDirectSolverPardiso::solve] Inertia: number of negative eigenvalues: "
-                          << parameters[22] << std::endl;
+                          << mParameters[22] << std::endl;
                 std::cout << "[SparseDirectSolverPardiso::solve] Inertia: number of zero eigenvalues: "
-                          << matrixDimension - parameters[21] - parameters[22] << std::endl;
+                          << mMatrixDimension - mParameters[21] - mParameters[22] << std::endl;
             }
-            std::cout << "[SparseDirectSolverPardiso::solve] Number of nonzeros in factors: " << parameters[17]
+            std::cout << "[SparseDirectSolverPardiso::solve] Number of nonzeros in factors: " << mParameters[17]
                       << std::endl;
             std::cout << "[SparseDirectSolverPardiso::solve] Number of performed iterative refinement steps: "
-                      << parameters[6] << std::endl;
-            if (matrixType != 2)
+                      << mParameters[6] << std::endl;
+            if (mMatrixType != 2)
             {
-                std::cout << "[SparseDirectSolverPardiso::solve] Number of perturbed pivots: " << parameters[13]
+                std::cout << "[SparseDirectSolverPardiso::solve] Number of perturbed pivots: " << mParameters[13]
                           << std::endl;
             }
         }
     }
 
-    // Termination and release of memory
-    phase = -1;
-    pardiso(pt, &maxfct, &mnum, &matrixType, &phase, &matrixDimension, &ddum, const_cast<int*>(&matrixRowIndex[0]),
-            const_cast<int*>(&matrixColumns[0]), &idum, &rhsNumColumns, parameters, &msglvl, &ddum, &ddum, &error,
-            dparameters);
+    int error = Termination();
     if (error != 0)
     {
         throw NuTo::Exception(__PRETTY_FUNCTION__, "Termination phase: " + this->GetErrorString(error) + ".");
     }
 }
 
+int NuTo::SparseDirectSolverPardiso::Termination()
+{
+    int maxfct(1); // Maximum number of numerical factorizations.
+    int mnum(1); // Which factorization to use.
+    int msglvl(this->mVerboseLevel); // Print statistical information in file
+    int error(0); // Initialize error flag
+    double ddum(0); // Double dummy
+    int idum(0); // Integer dummy
+    int rhsNumColumns = 1;
+
+    // Termination and release of memory
+    int phase = -1;
+    pardiso(mPt, &maxfct, &mnum, &mMatrixType, &phase, &mMatrixDimension, &ddum, mRowIndex.data(), mColumns.data(),
+            &idum, &rhsNumColumns, mParameters, &msglvl, &ddum, &ddum, &error, mDParameters);
+    mIsInitialized = false;
+    return error;
+}
+
 std::string NuTo::SparseDirectSolverPardiso::GetErrorString(int error) const
 {
     assert(error != 0);
@@ -1,6 +1,7 @@
 #pragma once
 
 #include "math/SparseDirectSolver.h"
+#include <vector>
 #include <Eigen/Core>
 
 namespace NuTo
@@ -23,6 +24,31 @@ public:
     //! @param rSolution ... matrix storing the corresponding solution vectors (output)
     void Solve(const NuTo::SparseMatrixCSR<double>& rMatrix, const Eigen::VectorXd& rRhs, Eigen::VectorXd& rSolution);
 
+    //! @brief ... releases the memory of the factorization, if CleanUp was not called
+    ~SparseDirectSolverPardiso();
+
+    SparseDirectSolverPardiso(const SparseDirectSolverPardiso&) = delete;
+    SparseDirectSolverPardiso& operator=(const SparseDirectSolverPardiso&) = delete;
+
+    //! @brief ... initialization, reordering and symbolic factorization of the matrix
+    //! @remark ... the pattern of rMatrix is copied, a previous factorization is released
+    //! @param rMatrix ... sparse coefficient matrix, stored in compressed CSR format (input)
+    void Analysis(const NuTo::SparseMatrixCSR<double>& rMatrix);
+
+    //! @brief ... numerical factorization of a matrix with the pattern of the last Analysis
+    //! @remark ... the values of rMatrix are used for the iterative refinement in Solution, i.e. rMatrix has to
+    //! exist until the next factorization
+    //! @param rMatrix ... sparse coefficient matrix, stored in compressed CSR format (input)
+    void NumericalFactorization(const NuTo::SparseMatrixCSR<double>& rMatrix);
+
+    //! @brief ... back substitution with the current factorization
+    //! @param rRhs ... right-hand-side vector (input)
+    //! @param rSolution ... solution vector (output)
+    void Solution(const Eigen::VectorXd& rRhs, Eigen::VectorXd& rSolution);
+
+    //! @brief ... termination and release of memory
+    void CleanUp();
+
     //! @brief ... use the nested dissection alogrithm from the METIS-package for for the fill-in reducing odering of
     //! the coefficient matrix
     //! @sa mOrderingType
@@ -96,6 +122,25 @@ protected:
     //! @return error message as std::string
     std::string GetErrorString(int error) const;
 
+    //! @brief ... termination phase
+    //! @return error code
+    int Termination();
+
+    //! @brief ... internal data of the solver, valid between Analysis and CleanUp
+    void* mPt[64];
+    int mParameters[64];
+    double mDParameters[64];
+    bool mIsInitialized = false;
+
+    //! @brief ... matrix type, dimension and pattern of the last Analysis
+    int mMatrixType = 11;
+    int mMatrixDimension = 0;
+    std::vector<int> mRowIndex;
+    std::vector<int> mColumns;
+
+    //! @brief ... values of the last NumericalFactorization
+    const double* mMatrixValues = nullptr;
+
     //! @brief ... type of fill-in reducing odering of the coefficient matrix
     //! \sa setOrderingMETIS, setOrderingMinimumDegree
     /*!
@@ -0,0 +1,280 @@
+#pragma once
+
+#include <algorithm>
+#include <vector>
+#include <Eigen/Core>
+
+#include "base/Exception.h"
+#include "math/SparseMatrixCSRGeneral.h"
+
+namespace NuTo
+{
+
+//! @brief sparse matrix of dense square blocks in block compressed row storage (BSR)
+//! @remark A block consists of rBlockSize consecutive rows and columns, e.g. the displacement dofs of a node, if they
+//! are numbered consecutively. Only one column index is stored per block, i.e. up to rBlockSize^2 times less index
+//! memory than for compressed row storage. The matrix-vector product works on contiguous blocks, with fixed size
+//! kernels for blocks of size 1, 2 and 3 that Eigen and the compiler unroll and vectorize. The last block row and
+//! column are padded with zeros, if the number of rows or columns is not a multiple of the block size. Entries of
+//! blocks that are not zero in the original matrix are stored explicitly.
+class SparseMatrixBSR
+{
+public:
+    //! @brief empty matrix
+    SparseMatrixBSR() = default;
+
+    //! @brief converts a matrix in compressed row storage, symmetric matrices are stored with both triangles
+    //! @param rMatrix ... matrix, zero or one based indexing
+    //! @param rBlockSize ... number of rows and columns of each block
+    SparseMatrixBSR(const SparseMatrixCSR<double>& rMatrix, int rBlockSize)
+        : mNumRows(rMatrix.GetNumRows())
+        , mNumColumns(rMatrix.GetNumColumns())
+        , mBlockSize(rBlockSize)
+    {
+        if (rBlockSize < 1)
+            throw Exception(__PRETTY_FUNCTION__, "The block size has to be positive.");
+
+        const int numBlockRows = GetNumBlockRows();
+        const int base = rMatrix.HasOneBasedIndexing() ? 1 : 0;
+        const auto& rowIndex = rMatrix.GetRowIndex();
+        const auto& columns = rMatrix.GetColumns();
+
+        // block columns of each block row, including the transposed entries of symmetric matrices
+        std::vector<std::vector<int>> blockColumns(numBlockRows);
+        for (int row = 0; row < mNumRows; ++row)
+            for (int pos = rowIndex[row] - base; pos < rowIndex[row + 1] - base; ++pos)
+            {
+                const int column = columns[pos] - base;
+                blockColumns[row / mBlockSize].push_back(column / mBlockSize);
+                if (rMatrix.IsSymmetric() and column != row)
+                    blockColumns[column / mBlockSize].push_back(row / mBlockSize);
+            }
+
+        mBlockRowIndex.resize(numBlockRows + 1, 0);
+        for (int blockRow = 0; blockRow < numBlockRows; ++blockRow)
+        {
+            auto& rowBlocks = blockColumns[blockRow];
+            std::sort(rowBlocks.begin(), rowBlocks.end());
+            rowBlocks.erase(std::unique(rowBlocks.begin(), rowBlocks.end()), rowBlocks.end());
+            mBlockRowIndex[blockRow + 1] = mBlockRowIndex[blockRow] + rowBlocks.size();
+        }
+        mBlockColumns.reserve(mBlockRowIndex.back());
+        for (const auto& rowBlocks : blockColumns)
+            mBlockColumns.insert(mBlockColumns.end(), rowBlocks.begin(), rowBlocks.end());
+
+        SetValues(rMatrix);
+    }
+
+    //! @brief replaces the values by the values of rMatrix without changing the blocks
+    //! @return false, if rMatrix has other dimensions or entries outside of the blocks of this matrix. The values are
+    //! undefined in this case.
+    bool SetValues(const SparseMatrixCSR<double>& rMatrix)
+    {
+        if (rMatrix.GetNumRows() != mNumRows or rMatrix.GetNumColumns() != mNumColumns)
+            return false;
+
+        const int base = rMatrix.HasOneBasedIndexing() ? 1 : 0;
+        const auto& rowIndex = rMatrix.GetRowIndex();
+        const auto& columns = rMatrix.GetColumns();
+        const auto& values = rMatrix.GetValues();
+        mValues.assign(mBlockColumns.size() * mBlockSize * mBlockSize, 0.);
+        for (int row = 0; row < mNumRows; ++row)
+            for (int pos = rowIndex[row] - base; pos < rowIndex[row + 1] - base; ++pos)
+            {
+                const int column = columns[pos] - base;
+                if (not AddValue(row, column, values[pos]))
+                    return false;
+                if (rMatrix.IsSymmetric() and column != row and not AddValue(column, row, values[pos]))
+                    return false;
+            }
+        return true;
+    }
+
+    //! @brief adds rValue to the entry (rRow, rColumn)
+    //! @return false, if the entry is not part of a stored block
+    bool AddValue(int rRow, int rColumn, double rValue)
+    {
+        const int blockRow = rRow / mBlockSize;
+        const int blockColumn = rColumn / mBlockSize;
+        const auto begin = mBlockColumns.begin() + mBlockRowIndex[blockRow];
+        const auto end = mBlockColumns.begin() + mBlockRowIndex[blockRow + 1];
+        const auto it = std::lower_bound(begin, end, blockColumn);
+        if (it == end or *it != blockColumn)
+            return false;
+        const int block = std::distance(mBlockColumns.begin(), it);
+        mValues[(block * mBlockSize + rRow % mBlockSize) * mBlockSize + rColumn % mBlockSize] += rValue;
+        return true;
+    }
+
+    int GetNumRows() const
+    {
+        return mNumRows;
+    }
+
+    int GetNumColumns() const
+    {
+        return mNumColumns;
+    }
+
+    int GetBlockSize() const
+    {
+        return mBlockSize;
+    }
+
+    int GetNumBlockRows() const
+    {
+        return (mNumRows + mBlockSize - 1) / mBlockSize;
+    }
+
+    int GetNumBlockColumns() const
+    {
+        return (mNumColumns + mBlockSize - 1) / mBlockSize;
+    }
+
+    //! @brief returns the number of stored blocks
+    int GetNumBlocks() const
+    {
+        return mBlockColumns.size();
+    }
+
+    //! @brief blocks of block row i are GetBlockColumns()[GetBlockRowIndex()[i]] ...
+    //! GetBlockColumns()[GetBlockRowIndex()[i + 1] - 1]
+    const std::vector<int>& GetBlockRowIndex() const
+    {
+        return mBlockRowIndex;
+    }
+
+    const std::vector<int>& GetBlockColumns() const
+    {
+        return mBlockColumns;
+    }
+
+    //! @brief values of the blocks, each block stored row major
+    const std::vector<double>& GetValues() const
+    {
+        return mValues;
+    }
+
+    //! @brief matrix-vector product rResult = this * rVector
+    void Multiply(const Eigen::VectorXd& rVector, Eigen::VectorXd& rResult) const
+    {
+        if (rVector.rows() != mNumColumns)
+            throw Exception(__PRETTY_FUNCTION__, "Dimension of the vector does not match the number of columns.");
+
+        // the padded block column and row require vectors with a multiple of the block size
+        const int paddedColumns = GetNumBlockColumns() * mBlockSize;
+        const int paddedRows = GetNumBlockRows() * mBlockSize;
+        Eigen::VectorXd paddedVector;
+        const double* vector = rVector.data();
+        if (paddedColumns != mNumColumns)
+        {
+            paddedVector = Eigen::VectorXd::Zero(paddedColumns);
+            paddedVector.head(mNumColumns) = rVector;
+            vector = paddedVector.data();
+        }
+        rResult.resize(paddedRows);
+
+        switch (mBlockSize)
+        {
+        case 1:
+            MultiplyBlocks<1>(vector, rResult.data());
+            break;
+        case 2:
+            MultiplyBlocks<2>(vector, rResult.data());
+            break;
+        case 3:
+            MultiplyBlocks<3>(vector, rResult.data());
+            break;
+        default:
+            MultiplyBlocks<Eigen::Dynamic>(vector, rResult.data());
+            break;
+        }
+        rResult.conservativeResize(mNumRows);
+    }
+
+    //! @brief matrix-vector product
+    Eigen::VectorXd operator*(const Eigen::VectorXd& rVector) const
+    {
+        Eigen::VectorXd result;
+        Multiply(rVector, result);
+        return result;
+    }
+
+    //! @brief converts to compressed row storage, e.g. for the direct solvers
+    //! @remark all entries of the blocks within the dimensions of the matrix are stored, also zeros
+    SparseMatrixCSRGeneral<double> ExportToCSRGeneral() const
+    {
+        SparseMatrixCSRGeneral<double> result(mNumRows, mNumColumns);
+        auto& rowIndex = result.GetRowIndexReference();
+        auto& columns = result.GetColumnsReference();
+        auto& values = result.GetValuesReference();
+        columns.reserve(mValues.size());
+        values.reserve(mValues.size());
+        for (int row = 0; row < mNumRows; ++row)
+        {
+            const int blockRow = row / mBlockSize;
+            for (int block = mBlockRowIndex[blockRow]; block < mBlockRowIndex[blockRow + 1]; ++block)
+                for (int i = 0; i < mBlockSize; ++i)
+                {
+                    const int column = mBlockColumns[block] * mBlockSize + i;
+                    if (column >= mNumColumns)
+                        break;
+                    columns.push_back(column);
+                    values.push_back(mValues[(block * mBlockSize + row % mBlockSize) * mBlockSize + i]);
+                }
+            rowIndex[row + 1] = columns.size();
+        }
+        return result;
+    }
+
+    //! @brief converts to a dense matrix
+    Eigen::MatrixXd ConvertToFullMatrix() const
+    {
+        Eigen::MatrixXd result =
+                Eigen::MatrixXd::Zero(GetNumBlockRows() * mBlockSize, GetNumBlockColumns() * mBlockSize);
+        for (int blockRow = 0; blockRow < GetNumBlockRows(); ++blockRow)
+            for (int block = mBlockRowIndex[blockRow]; block < mBlockRowIndex[blockRow + 1]; ++block)
+                result.block(blockRow * mBlockSize, mBlockColumns[block] * mBlockSize, mBlockSize, mBlockSize) =
+                        Eigen::Map<const Eigen::Matrix<double, Eigen::Dynamic, Eigen::Dynamic, Eigen::RowMajor>>(
+                                &mValues[block * mBlockSize * mBlockSize], mBlockSize, mBlockSize);
+        return result.topLeftCorner(mNumRows, mNumColumns);
+    }
+
+private:
+    //! @brief product of the padded matrix with the padded vector rVector, fixed size blocks for TBlockSize > 0
+    template <int TBlockSize>
+    void MultiplyBlocks(const double* rVector, double* rResult) const
+    {
+        using Block =
+                Eigen::Matrix<double, TBlockSize, TBlockSize, TBlockSize == 1 ? Eigen::ColMajor : Eigen::RowMajor>;
+        using Vector = Eigen::Matrix<double, TBlockSize, 1>;
+        const int blockSize = mBlockSize;
+        const int numBlockRows = GetNumBlockRows();
+#ifdef _OPENMP
+#pragma omp parallel for schedule(static)
+#endif
+        for (int blockRow = 0; blockRow < numBlockRows; ++blockRow)
+        {
+            Vector sum = Vector::Zero(blockSize);
+            for (int block = mBlockRowIndex[blockRow]; block < mBlockRowIndex[blockRow + 1]; ++block)
+            {
+                const double* values = &mValues[block * blockSize * blockSize];
+                const double* vector = rVector + mBlockColumns[block] * blockSize;
+                sum.noalias() += Eigen::Map<const Block>(values, blockSize, blockSize) *
+                                 Eigen::Map<const Vector>(vector, blockSize);
+            }
+            Eigen::Map<Vector>(rResult + blockRow * blockSize, blockSize) = sum;
+        }
+    }
+
+    int mNumRows = 0;
+    int mNumColumns = 0;
+    int mBlockSize = 1;
+
+    //! @brief block compressed row storage, the values of block i start at mValues[i * mBlockSize * mBlockSize]
+    std::vector<int> mBlockRowIndex = {0};
+    std::vector<int> mBlockColumns;
+    std::vector<double> mValues;
+};
+
+} // namespace NuTo
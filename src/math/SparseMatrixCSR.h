@@ -112,6 +112,25 @@ public:
         return this->mValues;
     }
 
+    //! @brief ... returns a reference to the row index vector, e.g. to fill the matrix without AddValue
+    //! @remark the caller is responsible for a consistent storage (indexing, sorted columns)
+    std::vector<int>& GetRowIndexReference()
+    {
+        return this->mRowIndex;
+    }
+
+    //! @brief ... returns a reference to the vector of columns, see GetRowIndexReference
+    std::vector<int>& GetColumnsReference()
+    {
+        return this->mColumns;
+    }
+
+    //! @brief ... returns a reference to the vector of values, see GetRowIndexReference
+    std::vector<T>& GetValuesReference()
+    {
+        return this->mValues;
+    }
+
     //! @brief ... returns the number of non-zero matrix entries
     //! @return number of non-zero matrix entries
     int GetNumEntries() const override
@@ -3,6 +3,7 @@
 
 #include "math/SparseMatrixCSRVector2General.h"
 #include "math/SparseMatrixEnum.h"
+#include "math/SparseMatrixProduct.h"
 #include "base/Exception.h"
 
 //! @brief ... constructor
@@ -470,52 +471,13 @@ operator*(const Eigen::Matrix<T, Eigen::Dynamic, Eigen::Dynamic>& rMatrix) const
     {
         throw Exception("[SparseMatrixCSRGeneral::operator*] invalid matrix dimensions.");
     }
-    Eigen::Matrix<T, Eigen::Dynamic, Eigen::Dynamic> result(this->GetNumRows(), rMatrix.cols());
-    if (this->HasOneBasedIndexing())
-    {
-        // loop over rows
-        for (int row = 0; row < this->GetNumRows(); row++)
-        {
-            // initialize result
-            for (int matrixCol = 0; matrixCol < result.cols(); matrixCol++)
-            {
-                result(row, matrixCol) = 0.0;
-            }
-            // perform multiplication
-            for (int pos = this->mRowIndex[row] - 1; pos < this->mRowIndex[row + 1] - 1; pos++)
-            {
-                int column = this->mColumns[pos] - 1;
-                T value = this->mValues[pos];
-                for (int matrixCol = 0; matrixCol < rMatrix.cols(); matrixCol++)
-                {
-                    result(row, matrixCol) += value * rMatrix(column, matrixCol);
-                }
-            }
-        }
-    }
-    else
-    {
-        // loop over rows
-        for (int row = 0; row < this->GetNumRows(); row++)
-        {
-            // initialize result
-            for (int matrixCol = 0; matrixCol < result.cols(); matrixCol++)
-            {
-                result(row, matrixCol) = 0.0;
-            }
-            // perform multiplication
-            for (int pos = this->mRowIndex[row]; pos < this->mRowIndex[row + 1]; pos++)
-            {
-                int column = this->mColumns[pos];
-                T value = this->mValues[pos];
-                for (int matrixCol = 0; matrixCol < rMatrix.cols(); matrixCol++)
-                {
-                    result(row, matrixCol) += value * rMatrix(column, matrixCol);
-                }
-            }
-        }
-    }
-    return result;
+    const int base = this->HasOneBasedIndexing() ? 1 : 0;
+    auto getRow = [&](int row) {
+        const int begin = this->mRowIndex[row] - base;
+        return SparseMatrixProduct::Row<T>{this->mColumns.data() + begin, this->mValues.data() + begin,
+                                           this->mRowIndex[row + 1] - base - begin};
+    };
+    return SparseMatrixProduct::General<T>(getRow, this->GetNumRows(), base, rMatrix);
 }
 
 template <class T>
@@ -1,6 +1,7 @@
 #include "math/SparseMatrixCSRSymmetric.h"
 #include "math/SparseMatrixCSRGeneral.h"
 #include "math/SparseMatrixCSRVector2Symmetric.h"
+#include "math/SparseMatrixProduct.h"
 #include "base/Exception.h"
 
 namespace NuTo
@@ -186,28 +187,13 @@ Eigen::MatrixXd SparseMatrixCSRSymmetric<double>::operator*(const Eigen::MatrixX
     {
         throw Exception("[SparseMatrixCSRSymmetric<int>::operator*] invalid number of rows in input matrix.");
     }
-    Eigen::MatrixXd result(this->GetNumRows(), rMatrix.cols());
-
-    for (int matrixCol = 0; matrixCol < rMatrix.cols(); matrixCol++)
-    {
-        const double* matrixValues = rMatrix.data() + matrixCol * rMatrix.rows();
-        double* resultValues = result.data() + matrixCol * rMatrix.rows();
-        for (int thisRow = 0; thisRow < this->GetNumRows(); thisRow++)
-        {
-            for (int thisPos = this->mRowIndex[thisRow] - mOneBasedIndexing;
-                 thisPos < this->mRowIndex[thisRow + 1] - mOneBasedIndexing; thisPos++)
-            {
-                int thisColumn = this->mColumns[thisPos] - mOneBasedIndexing;
-                double thisValue = this->mValues[thisPos];
-                resultValues[thisRow] += thisValue * matrixValues[thisColumn];
-                if (thisRow != thisColumn)
-                {
-                    resultValues[thisColumn] += thisValue * matrixValues[thisRow];
-                }
-            }
-        }
-    }
-    return result;
+    const int base = mOneBasedIndexing ? 1 : 0;
+    auto getRow = [&](int row) {
+        const int begin = this->mRowIndex[row] - base;
+        return SparseMatrixProduct::Row<double>{this->mColumns.data() + begin, this->mValues.data() + begin,
+                                                this->mRowIndex[row + 1] - base - begin};
+    };
+    return SparseMatrixProduct::SymmetricUpper<double>(getRow, this->GetNumRows(), base, rMatrix);
 }
 
 // multiply sparse matrix with scalar
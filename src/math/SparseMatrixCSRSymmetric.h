@@ -176,7 +176,7 @@ Eigen::Matrix<T, Eigen::Dynamic, Eigen::Dynamic> NuTo::SparseMatrixCSRSymmetric<
             {
                 m(row, (*columnIterator) - 1) = *valueIterator;
                 if (static_cast<int>(row) != (*columnIterator) - 1)
-                    m((*columnIterator) - 1) = row, *valueIterator;
+                    m((*columnIterator) - 1, row) = *valueIterator;
                 columnIterator++;
                 valueIterator++;
             }
@@ -5,6 +5,7 @@
 
 #include "math/SparseMatrixCSRVector2General_Def.h"
 #include "math/SparseMatrixEnum.h"
+#include "math/SparseMatrixProduct.h"
 #include "math/SparseMatrixCSRGeneral.h"
 #include "math/SparseMatrixCSRVector2Symmetric.h"
 
@@ -400,62 +401,12 @@ operator*(const Eigen::Matrix<T, Eigen::Dynamic, Eigen::Dynamic>& rMatrix) const
                   << "\n";
         throw Exception(std::string("[") + __PRETTY_FUNCTION__ + "] invalid matrix dimensions.");
     }
-    Eigen::Matrix<T, Eigen::Dynamic, Eigen::Dynamic> result(this->GetNumRows(), rMatrix.cols());
-    if (this->HasOneBasedIndexing())
-    {
-// loop over rows
-#ifdef _OPENMP
-#pragma omp parallel for schedule(static)
-#endif
-        for (int row = 0; row < this->GetNumRows(); ++row)
-        {
-            // initialize result
-            for (int matrixCol = 0; matrixCol < result.cols(); ++matrixCol)
-            {
-                result(row, matrixCol) = 0.0;
-            }
-            const std::vector<T>& thisValueVec(this->mValues[row]);
-            const std::vector<int>& thisColumnVec(this->mColumns[row]);
-            // perform multiplication
-            for (unsigned int pos = 0; pos < this->mColumns.size(); ++pos)
-            {
-                int column = thisColumnVec[pos] - 1;
-                T value = thisValueVec[pos];
-                for (int matrixCol = 0; matrixCol < rMatrix.cols(); ++matrixCol)
-                {
-                    result(row, matrixCol) += value * rMatrix(column, matrixCol);
-                }
-            }
-        }
-    }
-    else
-    {
-// loop over rows
-#ifdef _OPENMP
-#pragma omp parallel for schedule(static)
-#endif
-        for (int row = 0; row < this->GetNumRows(); ++row)
-        {
-            // initialize result
-            for (int matrixCol = 0; matrixCol < result.cols(); ++matrixCol)
-            {
-                result(row, matrixCol) = 0.0;
-            }
-            const std::vector<T>& thisValueVec(this->mValues[row]);
-            const std::vector<int>& thisColumnVec(this->mColumns[row]);
-            // perform multiplication
-            for (unsigned int pos = 0; pos < thisColumnVec.size(); ++pos)
-            {
-                int column = thisColumnVec[pos];
-                T value = thisValueVec[pos];
-                for (int matrixCol = 0; matrixCol < rMatrix.cols(); ++matrixCol)
-                {
-                    result(row, matrixCol) += value * rMatrix(column, matrixCol);
-                }
-            }
-        }
-    }
-    return result;
+    const int base = this->HasOneBasedIndexing() ? 1 : 0;
+    auto getRow = [&](int row) {
+        return SparseMatrixProduct::Row<T>{this->mColumns[row].data(), this->mValues[row].data(),
+                                           static_cast<int>(this->mColumns[row].size())};
+    };
+    return SparseMatrixProduct::General<T>(getRow, this->GetNumRows(), base, rMatrix);
 }
 
 //! @brief ... add the scaled other matrix
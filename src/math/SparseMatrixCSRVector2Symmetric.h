@@ -4,6 +4,7 @@
 
 #include "math/SparseMatrixEnum.h"
 #include "math/SparseMatrixCSRVector2Symmetric_Def.h"
+#include "math/SparseMatrixProduct.h"
 
 #include "base/Exception.h"
 
@@ -301,67 +302,12 @@ operator*(const Eigen::Matrix<T, Eigen::Dynamic, Eigen::Dynamic>& rMatrix) const
     {
         throw Exception(std::string("[") + __PRETTY_FUNCTION__ + "] invalid matrix dimensions.");
     }
-    Eigen::Matrix<T, Eigen::Dynamic, Eigen::Dynamic> result =
-            Eigen::Matrix<T, Eigen::Dynamic, Eigen::Dynamic>::Zero(this->GetNumRows(), rMatrix.cols());
-    if (this->HasOneBasedIndexing())
-    {
-        // loop over rows
-        for (int row = 0; row < this->GetNumRows(); row++)
-        {
-            const std::vector<T>& thisValueVec(this->mValues[row]);
-            const std::vector<int>& thisColumnVec(this->mColumns[row]);
-            // perform multiplication
-            for (unsigned int pos = 0; pos < this->mColumns.size(); pos++)
-            {
-                int column = thisColumnVec[pos] - 1;
-                T value = thisValueVec[pos];
-                for (int matrixCol = 0; matrixCol < rMatrix.cols(); matrixCol++)
-                {
-                    result(row, matrixCol) += value * rMatrix(column, matrixCol);
-                }
-                if (column != row)
-                {
-                    // add the symmetric contribution
-                    for (int matrixCol = 0; matrixCol < rMatrix.cols(); matrixCol++)
-                    {
-                        result(column, matrixCol) += value * rMatrix(row, matrixCol);
-                    }
-                }
-            }
-        }
-    }
-    else
-    {
-        // loop over rows
-        for (int row = 0; row < this->GetNumRows(); row++)
-        {
-            const std::vector<T>& thisValueVec(this->mValues[row]);
-            const std::vector<int>& thisColumnVec(this->mColumns[row]);
-            // perform multiplication
-            for (unsigned int pos = 0; pos < thisColumnVec.size(); pos++)
-            {
-                int column = thisColumnVec[pos];
-                T value = thisValueVec[pos];
-                for (int matrixCol = 0; matrixCol < rMatrix.cols(); matrixCol++)
-                {
-                    result(row, matrixCol) += value * rMatrix(column, matrixCol);
-                    // std::cout << "add at " <<row << " " << matrixCol << " value " << value << " * " <<
-                    // rMatrix(column,matrixCol) << std::endl;
-                }
-                if (column != row)
-                {
-                    // add the symmetric contribution
-                    for (int matrixCol = 0; matrixCol < rMatrix.cols(); matrixCol++)
-                    {
-                        result(column, matrixCol) += value * rMatrix(row, matrixCol);
-                        // std::cout << "add at symm " <<column << " " << matrixCol << " value " << value << " * " <<
-                        // rMatrix(row,matrixCol) << std::endl;
-                    }
-                }
-            }
-        }
-    }
-    return result;
+    const int base = this->HasOneBasedIndexing() ? 1 : 0;
+    auto getRow = [&](int row) {
+        return SparseMatrixProduct::Row<T>{this->mColumns[row].data(), this->mValues[row].data(),
+                                           static_cast<int>(this->mColumns[row].size())};
+    };
+    return SparseMatrixProduct::SymmetricUpper<T>(getRow, this->GetNumRows(), base, rMatrix);
 }
 
 template <class T>
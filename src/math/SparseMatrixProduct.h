@@ -0,0 +1,158 @@
+#pragma once
+
+#include <algorithm>
+#include <vector>
+#include <Eigen/Core>
+#ifdef _OPENMP
+#include <omp.h>
+#endif
+
+namespace NuTo
+{
+//! @brief parallel products of sparse matrices in (vector) compressed row storage with dense matrices
+namespace SparseMatrixProduct
+{
+
+//! @brief entries of a row of a sparse matrix
+template <typename T>
+struct Row
+{
+    const int* mColumns;
+    const T* mValues;
+    int mSize;
+};
+
+template <typename T>
+using DenseMatrix = Eigen::Matrix<T, Eigen::Dynamic, Eigen::Dynamic>;
+
+//! @brief number of rows that justify an additional thread
+constexpr int minRowsPerThread = 2000;
+
+//! @brief returns A * rMatrix for a general sparse matrix A, the rows are computed in parallel
+//! @param rGetRow ... returns the Row of A with a given index
+//! @param rNumRows ... number of rows of A
+//! @param rBase ... 1 for one based column indices, 0 otherwise
+template <typename T, typename TGetRow>
+DenseMatrix<T> General(TGetRow rGetRow, int rNumRows, int rBase, const DenseMatrix<T>& rMatrix)
+{
+    const int numColumns = rMatrix.cols();
+    DenseMatrix<T> result(rNumRows, numColumns);
+#ifdef _OPENMP
+#pragma omp parallel for schedule(static) if (rNumRows > minRowsPerThread)
+#endif
+    for (int row = 0; row < rNumRows; ++row)
+    {
+        const Row<T> entries = rGetRow(row);
+        for (int matrixCol = 0; matrixCol < numColumns; ++matrixCol)
+        {
+            const T* matrixValues = rMatrix.data() + matrixCol * rMatrix.rows() - rBase;
+            T sum = 0;
+            for (int pos = 0; pos < entries.mSize; ++pos)
+                sum += entries.mValues[pos] * matrixValues[entries.mColumns[pos]];
+            result(row, matrixCol) = sum;
+        }
+    }
+    return result;
+}
+
+//! @brief returns A * rMatrix for a symmetric sparse matrix A stored as upper triangle (including the diagonal)
+//! @remark The entries of the lower triangle are added as transposed entries of the upper triangle, i.e. to other
+//! rows. Each thread computes a contiguous range of rows. The transposed entries of the rows of a range belong to the
+//! range itself or to the following ranges. The latter are collected in a buffer per range and added by the owners of
+//! the rows in a second pass. This requires neither atomics nor a coloring, and the buffers are small for matrices
+//! with a small bandwidth, see GraphOrdering.
+//! @param rGetRow ... returns the Row of A with a given index, only entries with column >= row
+//! @param rNumRows ... number of rows of A
+//! @param rBase ... 1 for one based column indices, 0 otherwise
+template <typename T, typename TGetRow>
+DenseMatrix<T> SymmetricUpper(TGetRow rGetRow, int rNumRows, int rBase, const DenseMatrix<T>& rMatrix)
+{
+    using Matrix = DenseMatrix<T>;
+    const int numColumns = rMatrix.cols();
+    Matrix result = Matrix::Zero(rNumRows, numColumns);
+
+    // one range of rows per thread
+    int numRanges = 1;
+#ifdef _OPENMP
+    numRanges = std::max(1, std::min(omp_get_max_threads(), rNumRows / minRowsPerThread));
+#endif
+    std::vector<int> rangeBegin(numRanges + 1);
+    for (int range = 0; range <= numRanges; ++range)
+        rangeBegin[range] = static_cast<long>(rNumRows) * range / numRanges;
+
+    // transposed entries of a range that belong to the rows rangeBegin[range + 1], ... of the following ranges
+    std::vector<Matrix> buffers(numRanges);
+
+#ifdef _OPENMP
+#pragma omp parallel num_threads(numRanges)
+#endif
+    {
+#ifdef _OPENMP
+#pragma omp for schedule(static)
+#endif
+        for (int range = 0; range < numRanges; ++range)
+        {
+            const int begin = rangeBegin[range];
+            const int end = rangeBegin[range + 1];
+
+            int maxColumn = end - 1;
+            for (int row = begin; row < end; ++row)
+            {
+                const Row<T> entries = rGetRow(row);
+                for (int pos = 0; pos < entries.mSize; ++pos)
+                    maxColumn = std::max(maxColumn, entries.mColumns[pos] - rBase);
+            }
+            Matrix& buffer = buffers[range];
+            buffer = Matrix::Zero(maxColumn + 1 - end, numColumns);
+
+            for (int matrixCol = 0; matrixCol < numColumns; ++matrixCol)
+            {
+                const T* matrixValues = rMatrix.data() + matrixCol * rMatrix.rows();
+                T* resultValues = result.data() + matrixCol * rNumRows;
+                T* bufferValues = buffer.data() + matrixCol * buffer.rows();
+                for (int row = begin; row < end; ++row)
+                {
+                    const Row<T> entries = rGetRow(row);
+                    const T rowValue = matrixValues[row];
+                    T sum = 0;
+                    for (int pos = 0; pos < entries.mSize; ++pos)
+                    {
+                        const int column = entries.mColumns[pos] - rBase;
+                        const T value = entries.mValues[pos];
+                        sum += value * matrixValues[column];
+                        if (column == row)
+                            continue;
+                        if (column < end)
+                            resultValues[column] += value * rowValue;
+                        else
+                            bufferValues[column - end] += value * rowValue;
+                    }
+                    resultValues[row] += sum;
+                }
+            }
+        }
+
+        // second pass, after the implicit barrier: transposed entries of the previous ranges
+#ifdef _OPENMP
+#pragma omp for schedule(static)
+#endif
+        for (int range = 0; range < numRanges; ++range)
+        {
+            const int begin = rangeBegin[range];
+            const int end = rangeBegin[range + 1];
+            for (int other = 0; other < range; ++other)
+            {
+                const Matrix& otherBuffer = buffers[other];
+                const int otherBegin = rangeBegin[other + 1];
+                const int first = std::max(begin, otherBegin);
+                const int last = std::min(end, otherBegin + static_cast<int>(otherBuffer.rows()));
+                if (first < last)
+                    result.middleRows(first, last - first) += otherBuffer.middleRows(first - otherBegin, last - first);
+            }
+        }
+    }
+    return result;
+}
+
+} // namespace SparseMatrixProduct
+} // namespace NuTo
@@ -0,0 +1,301 @@
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <cassert>
+#include <cmath>
+#include <limits>
+#include <vector>
+#include <Eigen/Core>
+
+namespace NuTo
+{
+
+//! @brief uniform grid over axis aligned boxes (or points) in 1D, 2D or 3D for range and nearest neighbor queries
+//! @remark Each box is stored in all cells it overlaps. The cell size is chosen such that a cell contains about two
+//! boxes on average, but it is not smaller than the mean extent of the boxes, and there are at most about twice as many
+//! cells as boxes. Queries visit the cells that overlap the query region and check the stored boxes exactly, so they
+//! cost O(number of visited cells + number of candidates) instead of O(number of boxes).
+class SpatialGrid
+{
+public:
+    //! @brief empty grid
+    SpatialGrid() = default;
+
+    //! @brief builds the grid over points
+    //! @param rPoints ... coordinates of the points, one column per point
+    explicit SpatialGrid(const Eigen::MatrixXd& rPoints)
+        : SpatialGrid(rPoints, rPoints)
+    {
+    }
+
+    //! @brief builds the grid over boxes
+    //! @param rBoxMin ... lower corners of the boxes, one column per box
+    //! @param rBoxMax ... upper corners of the boxes, one column per box
+    SpatialGrid(const Eigen::MatrixXd& rBoxMin, const Eigen::MatrixXd& rBoxMax)
+        : mBoxMin(rBoxMin)
+        , mBoxMax(rBoxMax)
+    {
+        assert(mBoxMin.rows() == mBoxMax.rows() and mBoxMin.cols() == mBoxMax.cols());
+        assert(mBoxMin.rows() >= 1 and mBoxMin.rows() <= 3);
+        const int numBoxes = GetNumBoxes();
+        const int dimension = GetDimension();
+        if (numBoxes == 0)
+            return;
+
+        mMin = mBoxMin.rowwise().minCoeff();
+        mMax = mBoxMax.rowwise().maxCoeff();
+        const Eigen::VectorXd extent = mMax - mMin;
+        mMaxBoxExtent = (mBoxMax - mBoxMin).maxCoeff();
+
+        // directions with a vanishing extent (e.g. all points on a plane) get a single cell
+        const double eps = 1.e-12 * std::max(extent.maxCoeff(), 1.e-300);
+        int numActiveDirections = 0;
+        double volume = 1.;
+        for (int i = 0; i < dimension; ++i)
+            if (extent[i] > eps)
+            {
+                ++numActiveDirections;
+                volume *= extent[i];
+            }
+
+        double cellSize = 1.;
+        if (numActiveDirections > 0)
+        {
+            const double numCellsTarget = std::max(1., 0.5 * numBoxes);
+            cellSize = std::pow(volume / numCellsTarget, 1. / numActiveDirections);
+            const double meanBoxExtent = (mBoxMax - mBoxMin).colwise().maxCoeff().mean();
+            cellSize = std::max(cellSize, meanBoxExtent);
+        }
+
+        // the rounding up per direction may exceed the target considerably, e.g. for a thin layer of points, the
+        // cells are enlarged until the total number of cells is at most about twice the number of boxes
+        const long maxNumCellsTotal = 2 * static_cast<long>(numBoxes) + 1;
+        mCellSize = Eigen::VectorXd::Ones(dimension);
+        for (;;)
+        {
+            mNumCells = {{1, 1, 1}};
+            long numCellsTotal = 1;
+            for (int i = 0; i < dimension; ++i)
+            {
+                if (extent[i] <= eps)
+                    continue;
+                const double numCells = std::ceil(extent[i] / cellSize);
+                mNumCells[i] = static_cast<int>(std::max(1., std::min(numCells, double(1 << 20))));
+                numCellsTotal *= mNumCells[i];
+            }
+            if (numCellsTotal <= maxNumCellsTotal)
+                break;
+            cellSize *= 1.25;
+        }
+        for (int i = 0; i < dimension; ++i)
+            if (extent[i] > eps)
+                mCellSize[i] = extent[i] / mNumCells[i];
+
+        // two passes, counting the boxes per cell and storing them contiguously
+        mCellBegin.assign(mNumCells[0] * mNumCells[1] * mNumCells[2] + 1, 0);
+        for (int pass = 0; pass < 2; ++pass)
+        {
+            for (int box = 0; box < numBoxes; ++box)
+            {
+                std::array<int, 3> lower, upper;
+                CellRange(mBoxMin.col(box), mBoxMax.col(box), lower, upper);
+                for (int k = lower[2]; k <= upper[2]; ++k)
+                    for (int j = lower[1]; j <= upper[1]; ++j)
+                        for (int i = lower[0]; i <= upper[0]; ++i)
+                        {
+                            const int cell = CellIndex({{i, j, k}});
+                            if (pass == 0)
+                                ++mCellBegin[cell + 1];
+                            else
+                                mCellBoxes[mCellBegin[cell]++] = box;
+                        }
+            }
+            if (pass == 0)
+            {
+                for (unsigned int cell = 1; cell < mCellBegin.size(); ++cell)
+                    mCellBegin[cell] += mCellBegin[cell - 1];
+                mCellBoxes.resize(mCellBegin.back());
+            }
+            else
+            {
+                // the second pass moved each begin to the begin of the next cell
+                for (unsigned int cell = mCellBegin.size() - 1; cell > 0; --cell)
+                    mCellBegin[cell] = mCellBegin[cell - 1];
+                mCellBegin[0] = 0;
+            }
+        }
+    }
+
+    int GetNumBoxes() const
+    {
+        return mBoxMin.cols();
+    }
+
+    int GetDimension() const
+    {
+        return mBoxMin.rows();
+    }
+
+    //! @brief returns the largest extent of the boxes in any direction, 0 for points
+    double GetMaxBoxExtent() const
+    {
+        return mMaxBoxExtent;
+    }
+
+    //! @brief returns the number of cells in each direction
+    std::array<int, 3> GetNumCells() const
+    {
+        return mNumCells;
+    }
+
+    //! @brief finds the boxes that intersect the box [rMin, rMax] (bounds included)
+    //! @param rMin ... lower corner of the query box, components may be -infinity
+    //! @param rMax ... upper corner of the query box, components may be +infinity
+    //! @return indices of the boxes in ascending order
+    std::vector<int> FindInBox(const Eigen::VectorXd& rMin, const Eigen::VectorXd& rMax) const
+    {
+        assert(rMin.rows() == GetDimension() and rMax.rows() == GetDimension());
+        std::vector<int> boxes;
+        if (GetNumBoxes() == 0 or (rMin.array() > mMax.array()).any() or (rMax.array() < mMin.array()).any())
+            return boxes;
+
+        std::array<int, 3> lower, upper;
+        CellRange(rMin, rMax, lower, upper);
+        for (int k = lower[2]; k <= upper[2]; ++k)
+            for (int j = lower[1]; j <= upper[1]; ++j)
+                for (int i = lower[0]; i <= upper[0]; ++i)
+                {
+                    const int cell = CellIndex({{i, j, k}});
+                    for (int pos = mCellBegin[cell]; pos < mCellBegin[cell + 1]; ++pos)
+                    {
+                        const int box = mCellBoxes[pos];
+                        if ((mBoxMin.col(box).array() <= rMax.array()).all() and
+                            (mBoxMax.col(box).array() >= rMin.array()).all())
+                            boxes.push_back(box);
+                    }
+                }
+
+        // boxes that overlap several cells are found several times
+        std::sort(boxes.begin(), boxes.end());
+        boxes.erase(std::unique(boxes.begin(), boxes.end()), boxes.end());
+        return boxes;
+    }
+
+    //! @brief finds the box with the smallest distance to rPoint, the box with the smallest index if several boxes
+    //! have the same distance
+    //! @remark The cells are visited in rings around the cell of rPoint until no cell of the next ring can contain a
+    //! closer box.
+    //! @return index of the box, -1 if the grid is empty
+    int FindNearest(const Eigen::VectorXd& rPoint) const
+    {
+        assert(rPoint.rows() == GetDimension());
+        if (GetNumBoxes() == 0)
+            return -1;
+
+        std::array<int, 3> center, dummy;
+        CellRange(rPoint, rPoint, center, dummy);
+
+        int nearest = -1;
+        double nearestDistance2 = std::numeric_limits<double>::max();
+        for (int ring = 0;; ++ring)
+        {
+            std::array<int, 3> lower, upper;
+            bool isComplete = true;
+            for (int i = 0; i < 3; ++i)
+            {
+                lower[i] = std::max(center[i] - ring, 0);
+                upper[i] = std::min(center[i] + ring, mNumCells[i] - 1);
+                isComplete = isComplete and lower[i] == 0 and upper[i] == mNumCells[i] - 1;
+            }
+
+            for (int k = lower[2]; k <= upper[2]; ++k)
+                for (int j = lower[1]; j <= upper[1]; ++j)
+                    for (int i = lower[0]; i <= upper[0]; ++i)
+                    {
+                        const int distance = std::max(std::abs(i - center[0]),
+                                                      std::max(std::abs(j - center[1]), std::abs(k - center[2])));
+                        if (distance != ring)
+                            continue;
+                        const int cell = CellIndex({{i, j, k}});
+                        for (int pos = mCellBegin[cell]; pos < mCellBegin[cell + 1]; ++pos)
+                        {
+                            const int box = mCellBoxes[pos];
+                            const double distance2 = Distance2(box, rPoint);
+                            if (distance2 < nearestDistance2 or (distance2 == nearestDistance2 and box < nearest))
+                            {
+                                nearest = box;
+                                nearestDistance2 = distance2;
+                            }
+                        }
+                    }
+
+            if (isComplete)
+                return nearest;
+            if (nearest == -1)
+                continue;
+
+            // all boxes outside the visited cells are at least as far away as the nearest face of the visited cells
+            // that is not on the boundary of the grid
+            double bound = std::numeric_limits<double>::max();
+            for (int i = 0; i < GetDimension(); ++i)
+            {
+                if (lower[i] > 0)
+                    bound = std::min(bound, rPoint[i] - (mMin[i] + lower[i] * mCellSize[i]));
+                if (upper[i] < mNumCells[i] - 1)
+                    bound = std::min(bound, mMin[i] + (upper[i] + 1) * mCellSize[i] - rPoint[i]);
+            }
+            if (bound > 0. and bound * bound > nearestDistance2)
+                return nearest;
+        }
+    }
+
+private:
+    //! @brief squared distance of rPoint to a box, 0 if rPoint is inside
+    double Distance2(int rBox, const Eigen::VectorXd& rPoint) const
+    {
+        return (rPoint.cwiseMax(mBoxMin.col(rBox)).cwiseMin(mBoxMax.col(rBox)) - rPoint).squaredNorm();
+    }
+
+    //! @brief range of the cells that overlap the box [rMin, rMax], clamped to the grid
+    void CellRange(const Eigen::VectorXd& rMin, const Eigen::VectorXd& rMax, std::array<int, 3>& rLower,
+                   std::array<int, 3>& rUpper) const
+    {
+        rLower = {{0, 0, 0}};
+        rUpper = {{0, 0, 0}};
+        for (int i = 0; i < GetDimension(); ++i)
+        {
+            rLower[i] = CellCoordinate(rMin[i], i);
+            rUpper[i] = CellCoordinate(rMax[i], i);
+        }
+    }
+
+    //! @brief cell of a coordinate in direction rDirection, clamped to the grid (infinite values allowed)
+    int CellCoordinate(double rCoordinate, int rDirection) const
+    {
+        const double cell = std::floor((rCoordinate - mMin[rDirection]) / mCellSize[rDirection]);
+        return static_cast<int>(std::min(std::max(cell, 0.), mNumCells[rDirection] - 1.));
+    }
+
+    int CellIndex(const std::array<int, 3>& rCell) const
+    {
+        return rCell[0] + mNumCells[0] * (rCell[1] + mNumCells[1] * rCell[2]);
+    }
+
+    Eigen::MatrixXd mBoxMin;
+    Eigen::MatrixXd mBoxMax;
+
+    //! @brief bounding box of all boxes, lower corner of the first cell
+    Eigen::VectorXd mMin;
+    Eigen::VectorXd mMax;
+    double mMaxBoxExtent = 0.;
+
+    Eigen::VectorXd mCellSize;
+    std::array<int, 3> mNumCells = {{1, 1, 1}};
+
+    //! @brief boxes of cell c are mCellBoxes[mCellBegin[c]] ... mCellBoxes[mCellBegin[c + 1] - 1]
+    std::vector<int> mCellBegin;
+    std::vector<int> mCellBoxes;
+};
+
+} // namespace NuTo
@@ -0,0 +1,561 @@
+#include "math/SupernodalLDLT.h"
+
+#include <algorithm>
+#include <cmath>
+
+#ifdef _OPENMP
+#include <omp.h>
+#endif
+
+#include "base/Exception.h"
+#include "math/GraphOrdering.h"
+
+using namespace NuTo;
+
+namespace
+{
+//! @brief number of columns of the panels of the dense factorization
+constexpr int panelSize = 64;
+
+//! @brief number of columns of the blocks of the parallel trailing update
+constexpr int updateBlockSize = 128;
+
+//! @brief lower triangle of rC -= rA rB^T, parallel over blocks of columns outside of the parallel subtree tasks
+template <typename T>
+void LowerUpdate(Eigen::Ref<Eigen::Matrix<T, Eigen::Dynamic, Eigen::Dynamic>> rC,
+                 const Eigen::Ref<const Eigen::Matrix<T, Eigen::Dynamic, Eigen::Dynamic>>& rA,
+                 const Eigen::Ref<const Eigen::Matrix<T, Eigen::Dynamic, Eigen::Dynamic>>& rB)
+{
+    const int size = rC.rows();
+    const int numBlocks = (size + updateBlockSize - 1) / updateBlockSize;
+#ifdef _OPENMP
+#pragma omp parallel for schedule(dynamic) if (numBlocks > 1 and not omp_in_parallel())
+#endif
+    for (int block = 0; block < numBlocks; ++block)
+    {
+        const int begin = block * updateBlockSize;
+        const int blockSize = std::min(updateBlockSize, size - begin);
+        const auto columns = rB.middleRows(begin, blockSize);
+        rC.block(begin, begin, blockSize, blockSize).template triangularView<Eigen::Lower>() -=
+                rA.middleRows(begin, blockSize) * columns.transpose();
+        const int below = size - begin - blockSize;
+        if (below > 0)
+            rC.block(begin + blockSize, begin, below, blockSize).noalias() -=
+                    rA.bottomRows(below) * columns.transpose();
+    }
+}
+
+//! @brief eliminates the first rNumPivots columns of the lower triangle of rFront, rFront = L D L^T + [0 0; 0 S]
+//! @remark On return, the first columns contain L (below the unit diagonal) and the lower triangle of the trailing
+//! block contains the Schur complement S.
+//! @param rDiagonal ... D
+template <typename T>
+void PartialLDLT(Eigen::Matrix<T, Eigen::Dynamic, Eigen::Dynamic>& rFront, int rNumPivots,
+                 Eigen::Matrix<T, Eigen::Dynamic, 1>& rDiagonal)
+{
+    using Matrix = Eigen::Matrix<T, Eigen::Dynamic, Eigen::Dynamic>;
+    const int size = rFront.rows();
+    rDiagonal.resize(rNumPivots);
+    for (int panelBegin = 0; panelBegin < rNumPivots; panelBegin += panelSize)
+    {
+        const int panelEnd = std::min(panelBegin + panelSize, rNumPivots);
+        for (int j = panelBegin; j < panelEnd; ++j)
+        {
+            const T pivot = rFront(j, j);
+            if (not(std::abs(pivot) > T(0)))
+                throw Exception(__PRETTY_FUNCTION__, "Zero pivot, the matrix is singular.");
+            rDiagonal[j] = pivot;
+
+            const int below = size - j - 1;
+            const int remaining = panelEnd - j - 1;
+            if (remaining > 0)
+                rFront.block(j + 1, j + 1, below, remaining).noalias() -=
+                        rFront.col(j).tail(below) * (rFront.col(j).segment(j + 1, remaining).transpose() / pivot);
+            rFront.col(j).tail(below) /= pivot;
+        }
+
+        const int trailing = size - panelEnd;
+        if (trailing > 0)
+        {
+            const int width = panelEnd - panelBegin;
+            const auto lower = rFront.block(panelEnd, panelBegin, trailing, width);
+            const Matrix scaled = lower * rDiagonal.segment(panelBegin, width).asDiagonal();
+            LowerUpdate<T>(rFront.bottomRightCorner(trailing, trailing), scaled, lower);
+        }
+    }
+}
+} // namespace
+
+
+bool SupernodalLDLT::IsSymmetric(const MatrixView& rMatrix, double rTolerance)
+{
+    if (rMatrix.rows() != rMatrix.cols())
+        return false;
+
+    const int numRows = rMatrix.rows();
+    const int* rowIndex = rMatrix.outerIndexPtr();
+    const int* columns = rMatrix.innerIndexPtr();
+    const double* values = rMatrix.valuePtr();
+    double maxValue = 0.;
+    for (int i = 0; i < rMatrix.nonZeros(); ++i)
+        maxValue = std::max(maxValue, std::abs(values[i]));
+    const double tolerance = rTolerance * maxValue;
+
+    // the columns of a row are sorted, a_ji is found by a binary search in row j
+    auto transposed = [&](int rRow, int rColumn) {
+        const int* begin = columns + rowIndex[rColumn];
+        const int* end = columns + rowIndex[rColumn + 1];
+        const int* it = std::lower_bound(begin, end, rRow);
+        return it != end and *it == rRow ? values[it - columns] : 0.;
+    };
+
+    bool isSymmetric = true;
+#ifdef _OPENMP
+#pragma omp parallel for schedule(static) reduction(&& : isSymmetric)
+#endif
+    for (int row = 0; row < numRows; ++row)
+        for (int k = rowIndex[row]; k < rowIndex[row + 1]; ++k)
+            if (columns[k] != row and std::abs(values[k] - transposed(row, columns[k])) > tolerance)
+                isSymmetric = false;
+    return isSymmetric;
+}
+
+
+void SupernodalLDLT::AnalyzePattern(const MatrixView& rMatrix)
+{
+    if (rMatrix.rows() != rMatrix.cols())
+        throw Exception(__PRETTY_FUNCTION__, "The matrix has to be square.");
+
+    const int numRows = rMatrix.rows();
+    const int* rowIndex = rMatrix.outerIndexPtr();
+    const int* columns = rMatrix.innerIndexPtr();
+    mNumRows = numRows;
+    mNumEntries = rMatrix.nonZeros();
+    mIsFactorized = false;
+
+    // symmetric graph of the matrix without the diagonal
+    std::vector<std::vector<int>> adjacency(numRows);
+    for (int row = 0; row < numRows; ++row)
+        for (int pos = rowIndex[row]; pos < rowIndex[row + 1]; ++pos)
+            if (columns[pos] != row)
+            {
+                adjacency[row].push_back(columns[pos]);
+                adjacency[columns[pos]].push_back(row);
+            }
+    for (auto& neighbors : adjacency)
+    {
+        std::sort(neighbors.begin(), neighbors.end());
+        neighbors.erase(std::unique(neighbors.begin(), neighbors.end()), neighbors.end());
+    }
+
+    // elimination tree of the nested dissection ordering (Liu 1986, with path compression)
+    const std::vector<int> dissection = GraphOrdering::NestedDissection(adjacency);
+    std::vector<int> inverse = GraphOrdering::Inverse(dissection);
+    std::vector<int> parent(numRows, -1);
+    std::vector<int> ancestor(numRows, -1);
+    for (int i = 0; i < numRows; ++i)
+        for (int vertex : adjacency[dissection[i]])
+            for (int k = inverse[vertex]; k != -1 and k < i;)
+            {
+                const int next = ancestor[k];
+                ancestor[k] = i;
+                if (next == -1)
+                    parent[k] = i;
+                k = next;
+            }
+
+    // postorder, the columns of each subtree are consecutive
+    std::vector<int> firstChild(numRows, -1);
+    std::vector<int> nextSibling(numRows, -1);
+    for (int j = numRows - 1; j >= 0; --j)
+        if (parent[j] != -1)
+        {
+            nextSibling[j] = firstChild[parent[j]];
+            firstChild[parent[j]] = j;
+        }
+    std::vector<int> postorder;
+    postorder.reserve(numRows);
+    std::vector<int> stack;
+    for (int root = 0; root < numRows; ++root)
+    {
+        if (parent[root] != -1)
+            continue;
+        stack.push_back(root);
+        while (not stack.empty())
+        {
+            const int node = stack.back();
+            const int child = firstChild[node];
+            if (child == -1)
+            {
+                stack.pop_back();
+                postorder.push_back(node);
+            }
+            else
+            {
+                firstChild[node] = nextSibling[child];
+                stack.push_back(child);
+            }
+        }
+    }
+
+    mOrdering.resize(numRows);
+    for (int k = 0; k < numRows; ++k)
+        mOrdering[k] = dissection[postorder[k]];
+    const std::vector<int> postorderInverse = GraphOrdering::Inverse(postorder);
+    std::vector<int> treeParent(numRows, -1);
+    for (int j = 0; j < numRows; ++j)
+        if (parent[j] != -1)
+            treeParent[postorderInverse[j]] = postorderInverse[parent[j]];
+    inverse = GraphOrdering::Inverse(mOrdering);
+
+    // number of entries of each column of L, marking the row subtrees
+    std::vector<int> counts(numRows, 1);
+    std::vector<int> mark(numRows, -1);
+    for (int i = 0; i < numRows; ++i)
+    {
+        mark[i] = i;
+        for (int vertex : adjacency[mOrdering[i]])
+            for (int k = inverse[vertex]; k < i and mark[k] != i; k = treeParent[k])
+            {
+                ++counts[k];
+                mark[k] = i;
+            }
+    }
+
+    // fundamental supernodes: a column joins the supernode of the previous column if it is its only child and the
+    // structures match
+    mSupernodeBegin.assign(1, 0);
+    std::vector<int> numChildren(numRows, 0);
+    for (int j = 0; j < numRows; ++j)
+        if (treeParent[j] != -1)
+            ++numChildren[treeParent[j]];
+    for (int j = 1; j < numRows; ++j)
+        if (not(treeParent[j - 1] == j and numChildren[j] == 1 and counts[j - 1] == counts[j] + 1))
+            mSupernodeBegin.push_back(j);
+    if (numRows > 0)
+        mSupernodeBegin.push_back(numRows);
+    const int numSupernodes = GetNumSupernodes();
+
+    std::vector<int> columnSupernode(numRows);
+    for (int s = 0; s < numSupernodes; ++s)
+        std::fill(columnSupernode.begin() + mSupernodeBegin[s], columnSupernode.begin() + mSupernodeBegin[s + 1], s);
+
+    // rows of the frontal matrices, children before parents
+    mRows.assign(numSupernodes, std::vector<int>());
+    mChildren.assign(numSupernodes, std::vector<int>());
+    mRelativeRows.assign(numSupernodes, std::vector<int>());
+    std::vector<int> supernodeParent(numSupernodes, -1);
+    std::vector<int> position(numRows, -1);
+    std::fill(mark.begin(), mark.end(), -1);
+    for (int s = 0; s < numSupernodes; ++s)
+    {
+        const int begin = mSupernodeBegin[s];
+        const int end = mSupernodeBegin[s + 1];
+        auto& rows = mRows[s];
+        for (int j = begin; j < end; ++j)
+        {
+            rows.push_back(j);
+            mark[j] = s;
+        }
+        for (int j = begin; j < end; ++j)
+            for (int vertex : adjacency[mOrdering[j]])
+            {
+                const int i = inverse[vertex];
+                if (i >= end and mark[i] != s)
+                {
+                    mark[i] = s;
+                    rows.push_back(i);
+                }
+            }
+        for (int child : mChildren[s])
+            for (unsigned int a = mSupernodeBegin[child + 1] - mSupernodeBegin[child]; a < mRows[child].size(); ++a)
+            {
+                const int i = mRows[child][a];
+                if (i >= end and mark[i] != s)
+                {
+                    mark[i] = s;
+                    rows.push_back(i);
+                }
+            }
+        std::sort(rows.begin() + (end - begin), rows.end());
+        if (static_cast<int>(rows.size()) != counts[begin])
+            throw Exception(__PRETTY_FUNCTION__, "Inconsistent symbolic factorization.");
+
+        for (unsigned int a = 0; a < rows.size(); ++a)
+            position[rows[a]] = a;
+        for (int child : mChildren[s])
+        {
+            const int childColumns = mSupernodeBegin[child + 1] - mSupernodeBegin[child];
+            for (unsigned int a = childColumns; a < mRows[child].size(); ++a)
+                mRelativeRows[child].push_back(position[mRows[child][a]]);
+        }
+
+        if (static_cast<int>(rows.size()) > end - begin)
+        {
+            supernodeParent[s] = columnSupernode[rows[end - begin]];
+            mChildren[supernodeParent[s]].push_back(s);
+        }
+    }
+
+    // entries A(i, j), i >= j, of the columns of each supernode in its column major frontal matrix
+    mAssembly.assign(numSupernodes, std::vector<std::pair<int, std::size_t>>());
+    mFactorBegin.assign(numSupernodes + 1, 0);
+    mNumNonZeros = 0;
+    std::vector<double> work(numSupernodes);
+    for (int s = 0; s < numSupernodes; ++s)
+    {
+        const int begin = mSupernodeBegin[s];
+        const std::size_t numColumns = mSupernodeBegin[s + 1] - begin;
+        const std::size_t size = mRows[s].size();
+        for (unsigned int a = 0; a < size; ++a)
+            position[mRows[s][a]] = a;
+        for (int j = begin; j < mSupernodeBegin[s + 1]; ++j)
+        {
+            const int row = mOrdering[j];
+            for (int pos = rowIndex[row]; pos < rowIndex[row + 1]; ++pos)
+            {
+                const int i = inverse[columns[pos]];
+                if (i >= j)
+                    mAssembly[s].emplace_back(pos, position[i] + (j - begin) * size);
+            }
+        }
+        mFactorBegin[s + 1] = mFactorBegin[s] + size * numColumns;
+        mNumNonZeros += numColumns * (numColumns + 1) / 2 + (size - numColumns) * numColumns;
+        work[s] = static_cast<double>(numColumns) * size * size;
+    }
+
+    // parallel schedule: the subtrees below the supernodes with a large share of the work are independent tasks
+    std::vector<double> subtreeWork(work);
+    mSubtreeBegin.resize(numSupernodes);
+    for (int s = 0; s < numSupernodes; ++s)
+    {
+        mSubtreeBegin[s] = s;
+        for (int child : mChildren[s])
+        {
+            subtreeWork[s] += subtreeWork[child];
+            mSubtreeBegin[s] = std::min(mSubtreeBegin[s], mSubtreeBegin[child]);
+        }
+    }
+    double totalWork = 0.;
+    for (int s = 0; s < numSupernodes; ++s)
+        if (supernodeParent[s] == -1)
+            totalWork += subtreeWork[s];
+#ifdef _OPENMP
+    const int numThreads = omp_get_max_threads();
+#else
+    const int numThreads = 1;
+#endif
+    std::vector<bool> isTop(numSupernodes, false);
+    mTaskRoots.clear();
+    mTopSupernodes.clear();
+    for (int s = numSupernodes - 1; s >= 0; --s)
+    {
+        const bool isParentTop = supernodeParent[s] == -1 or isTop[supernodeParent[s]];
+        if (not isParentTop)
+            continue;
+        if (subtreeWork[s] > totalWork / (2 * numThreads))
+            isTop[s] = true;
+        else
+            mTaskRoots.push_back(s);
+    }
+    for (int s = 0; s < numSupernodes; ++s)
+        if (isTop[s])
+            mTopSupernodes.push_back(s);
+    // the largest subtrees first
+    std::stable_sort(mTaskRoots.begin(), mTaskRoots.end(),
+                     [&](int a, int b) { return subtreeWork[a] > subtreeWork[b]; });
+}
+
+
+void SupernodalLDLT::Factorize(const MatrixView& rMatrix)
+{
+    if (rMatrix.rows() != mNumRows or rMatrix.cols() != mNumRows or rMatrix.nonZeros() != mNumEntries)
+        throw Exception(__PRETTY_FUNCTION__, "The pattern of the matrix does not match the analysis.");
+
+    mIsFactorized = false;
+    mDiagonal.resize(mNumRows);
+    if (mPrecision == ePrecision::DOUBLE)
+    {
+        mFactorValuesSingle.clear();
+        mFactorValuesSingle.shrink_to_fit();
+        mScaling.resize(0);
+        FactorizeNumeric(rMatrix.valuePtr(), mFactorValues);
+    }
+    else
+    {
+        // the scaled matrix has a unit diagonal, which avoids overflow and underflow in float
+        mFactorValues.clear();
+        mFactorValues.shrink_to_fit();
+        const int* rowIndex = rMatrix.outerIndexPtr();
+        const int* columns = rMatrix.innerIndexPtr();
+        const double* values = rMatrix.valuePtr();
+        mScaling = Eigen::VectorXd::Ones(mNumRows);
+        for (int row = 0; row < mNumRows; ++row)
+            for (int pos = rowIndex[row]; pos < rowIndex[row + 1]; ++pos)
+                if (columns[pos] == row and values[pos] != 0.)
+                    mScaling[row] = 1. / std::sqrt(std::abs(values[pos]));
+        std::vector<double> scaledValues(mNumEntries);
+        for (int row = 0; row < mNumRows; ++row)
+            for (int pos = rowIndex[row]; pos < rowIndex[row + 1]; ++pos)
+                scaledValues[pos] = mScaling[row] * values[pos] * mScaling[columns[pos]];
+        FactorizeNumeric(scaledValues.data(), mFactorValuesSingle);
+    }
+    mIsFactorized = true;
+}
+
+
+template <typename T>
+void SupernodalLDLT::FactorizeNumeric(const double* rValues, std::vector<T>& rFactorValues)
+{
+    rFactorValues.resize(mFactorBegin.empty() ? 0 : mFactorBegin.back());
+    std::vector<Eigen::Matrix<T, Eigen::Dynamic, Eigen::Dynamic>> updates(GetNumSupernodes());
+
+    // exceptions must not leave a task
+    bool isSingular = false;
+#ifdef _OPENMP
+#pragma omp parallel if (mTaskRoots.size() > 1)
+#pragma omp single
+#endif
+    for (int root : mTaskRoots)
+    {
+#ifdef _OPENMP
+#pragma omp task firstprivate(root) shared(updates, isSingular, rValues, rFactorValues)
+#endif
+        {
+            try
+            {
+                for (int s = mSubtreeBegin[root]; s <= root; ++s)
+                    FactorizeSupernode(s, rValues, updates, rFactorValues);
+            }
+            catch (Exception&)
+            {
+#ifdef _OPENMP
+#pragma omp atomic write
+#endif
+                isSingular = true;
+            }
+        }
+    }
+    if (isSingular)
+        throw Exception(__PRETTY_FUNCTION__, "Zero pivot, the matrix is singular.");
+
+    for (int s : mTopSupernodes)
+        FactorizeSupernode(s, rValues, updates, rFactorValues);
+}
+
+
+template <typename T>
+void SupernodalLDLT::FactorizeSupernode(int rSupernode, const double* rValues,
+                                        std::vector<Eigen::Matrix<T, Eigen::Dynamic, Eigen::Dynamic>>& rUpdates,
+                                        std::vector<T>& rFactorValues)
+{
+    using Matrix = Eigen::Matrix<T, Eigen::Dynamic, Eigen::Dynamic>;
+    const int begin = mSupernodeBegin[rSupernode];
+    const int numColumns = mSupernodeBegin[rSupernode + 1] - begin;
+    const int size = mRows[rSupernode].size();
+
+    Matrix front = Matrix::Zero(size, size);
+    T* frontValues = front.data();
+    for (const auto& entry : mAssembly[rSupernode])
+        frontValues[entry.second] += static_cast<T>(rValues[entry.first]);
+
+    // extend-add of the lower triangles of the update matrices
+    for (int child : mChildren[rSupernode])
+    {
+        const auto& relativeRows = mRelativeRows[child];
+        Matrix& update = rUpdates[child];
+        const int updateSize = relativeRows.size();
+        for (int b = 0; b < updateSize; ++b)
+            for (int a = b; a < updateSize; ++a)
+                front(relativeRows[a], relativeRows[b]) += update(a, b);
+        update.resize(0, 0);
+    }
+
+    Eigen::Matrix<T, Eigen::Dynamic, 1> diagonal;
+    PartialLDLT(front, numColumns, diagonal);
+    mDiagonal.segment(begin, numColumns) = diagonal.template cast<double>();
+
+    Eigen::Map<Matrix>(rFactorValues.data() + mFactorBegin[rSupernode], size, numColumns) =
+            front.leftCols(numColumns);
+    if (size > numColumns)
+        rUpdates[rSupernode] = front.bottomRightCorner(size - numColumns, size - numColumns);
+}
+
+
+Eigen::VectorXd SupernodalLDLT::Solve(const Eigen::VectorXd& rRhs) const
+{
+    if (not mIsFactorized)
+        throw Exception(__PRETTY_FUNCTION__, "Factorize the matrix first.");
+    if (rRhs.rows() != mNumRows)
+        throw Exception(__PRETTY_FUNCTION__, "The size of the right hand side does not match the matrix.");
+
+    Eigen::VectorXd solution(mNumRows);
+    if (mPrecision == ePrecision::DOUBLE)
+    {
+        Eigen::VectorXd x(mNumRows);
+        for (int k = 0; k < mNumRows; ++k)
+            x[k] = rRhs[mOrdering[k]];
+        SolveNumeric(x, mFactorValues);
+        for (int k = 0; k < mNumRows; ++k)
+            solution[mOrdering[k]] = x[k];
+    }
+    else
+    {
+        // A^-1 = D_A^-1/2 (D_A^-1/2 A D_A^-1/2)^-1 D_A^-1/2
+        Eigen::VectorXf x(mNumRows);
+        for (int k = 0; k < mNumRows; ++k)
+            x[k] = static_cast<float>(mScaling[mOrdering[k]] * rRhs[mOrdering[k]]);
+        SolveNumeric(x, mFactorValuesSingle);
+        for (int k = 0; k < mNumRows; ++k)
+            solution[mOrdering[k]] = mScaling[mOrdering[k]] * x[k];
+    }
+    return solution;
+}
+
+
+template <typename T>
+void SupernodalLDLT::SolveNumeric(Eigen::Matrix<T, Eigen::Dynamic, 1>& rX, const std::vector<T>& rFactorValues) const
+{
+    using Matrix = Eigen::Matrix<T, Eigen::Dynamic, Eigen::Dynamic>;
+    using Vector = Eigen::Matrix<T, Eigen::Dynamic, 1>;
+    const int numSupernodes = GetNumSupernodes();
+    Vector buffer;
+
+    // L y = b
+    for (int s = 0; s < numSupernodes; ++s)
+    {
+        const int begin = mSupernodeBegin[s];
+        const int numColumns = mSupernodeBegin[s + 1] - begin;
+        const int size = mRows[s].size();
+        const Eigen::Map<const Matrix> factor(rFactorValues.data() + mFactorBegin[s], size, numColumns);
+        Eigen::Ref<Vector> xs = rX.segment(begin, numColumns);
+        factor.topRows(numColumns).template triangularView<Eigen::UnitLower>().solveInPlace(xs);
+        if (size > numColumns)
+        {
+            buffer.noalias() = factor.bottomRows(size - numColumns) * xs;
+            for (int a = numColumns; a < size; ++a)
+                rX[mRows[s][a]] -= buffer[a - numColumns];
+        }
+    }
+
+    // D z = y
+    rX.array() /= mDiagonal.cast<T>().array();
+
+    // L^T x = z
+    for (int s = numSupernodes - 1; s >= 0; --s)
+    {
+        const int begin = mSupernodeBegin[s];
+        const int numColumns = mSupernodeBegin[s + 1] - begin;
+        const int size = mRows[s].size();
+        const Eigen::Map<const Matrix> factor(rFactorValues.data() + mFactorBegin[s], size, numColumns);
+        Eigen::Ref<Vector> xs = rX.segment(begin, numColumns);
+        if (size > numColumns)
+        {
+            buffer.resize(size - numColumns);
+            for (int a = numColumns; a < size; ++a)
+                buffer[a - numColumns] = rX[mRows[s][a]];
+            xs.noalias() -= factor.bottomRows(size - numColumns).transpose() * buffer;
+        }
+        factor.topRows(numColumns).template triangularView<Eigen::UnitLower>().transpose().solveInPlace(xs);
+    }
+}
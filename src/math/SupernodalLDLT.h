@@ -0,0 +1,177 @@
+#pragma once
+
+#include <cstddef>
+#include <utility>
+#include <vector>
+#include <Eigen/Core>
+#include <Eigen/SparseCore>
+
+namespace NuTo
+{
+//! @brief multithreaded supernodal LDL^T factorization of sparse symmetric matrices, e.g. for builds without MUMPS
+//! @remark Analysis: The matrix is reordered by nested dissection (GraphOrdering::NestedDissection) and the postorder
+//! of its elimination tree. Consecutive columns with the same structure of L are combined to supernodes.
+//! Factorization: multifrontal, each supernode assembles its entries of A and the update matrices of its children
+//! into a dense frontal matrix, eliminates its columns by a blocked dense LDL^T and passes the Schur complement to its
+//! parent. The dense updates are matrix-matrix products (Eigen), thus BLAS-3. The subtrees of the elimination tree
+//! are independent and are factorized as parallel tasks, the large supernodes near the root, i.e. the separators of
+//! the top levels of the nested dissection, are factorized one after another with parallel dense updates.
+//! The factorization does not pivot, thus the matrix has to be positive definite or at least have a stable LDL^T
+//! decomposition in the fill-reducing ordering, like the matrices that SolverEigen<SimplicialLDLT> handles.
+//! The analysis only depends on the pattern and is reused by Factorize for new values with the same pattern.
+//! In single precision, the symmetrically scaled matrix D_A^-1/2 A D_A^-1/2, D_A = |diag(A)|, is factorized and solved
+//! in float, which halves the memory and the time of the factorization, but only yields about 7 digits, see
+//! SolverMixedPrecision for the iterative refinement to double precision.
+class SupernodalLDLT
+{
+public:
+    enum class ePrecision
+    {
+        DOUBLE,
+        SINGLE //!< frontal matrices and factor in float, the solutions are accurate to about 1e-7 * condition number
+    };
+
+    //! @brief symmetric matrix in compressed row storage with both triangles, see
+    //! BlockSparseMatrix::GetEigenSparseMatrixView
+    using MatrixView = Eigen::Map<const Eigen::SparseMatrix<double, Eigen::RowMajor>>;
+
+    explicit SupernodalLDLT(ePrecision rPrecision = ePrecision::DOUBLE)
+        : mPrecision(rPrecision)
+    {
+    }
+
+    //! @brief precision of the next Factorize
+    void SetPrecision(ePrecision rPrecision)
+    {
+        mPrecision = rPrecision;
+        mIsFactorized = false;
+    }
+
+    ePrecision GetPrecision() const
+    {
+        return mPrecision;
+    }
+
+    //! @brief ordering, elimination tree, supernodes and the assembly of the frontal matrices
+    void AnalyzePattern(const MatrixView& rMatrix);
+
+    //! @brief numerical factorization of a matrix with the pattern of the last AnalyzePattern
+    //! @remark throws if a pivot is zero
+    void Factorize(const MatrixView& rMatrix);
+
+    //! @brief AnalyzePattern and Factorize
+    void Compute(const MatrixView& rMatrix)
+    {
+        AnalyzePattern(rMatrix);
+        Factorize(rMatrix);
+    }
+
+    //! @brief convenience overloads for compressed row major matrices
+    void AnalyzePattern(const Eigen::SparseMatrix<double, Eigen::RowMajor>& rMatrix)
+    {
+        AnalyzePattern(View(rMatrix));
+    }
+
+    void Factorize(const Eigen::SparseMatrix<double, Eigen::RowMajor>& rMatrix)
+    {
+        Factorize(View(rMatrix));
+    }
+
+    void Compute(const Eigen::SparseMatrix<double, Eigen::RowMajor>& rMatrix)
+    {
+        Compute(View(rMatrix));
+    }
+
+    //! @brief checks |a_ij - a_ji| <= rTolerance * max |a_kl| for all entries, missing entries are zero
+    //! @remark AnalyzePattern and Factorize only read the lower triangle, a nonsymmetric matrix yields a wrong solution
+    static bool IsSymmetric(const MatrixView& rMatrix, double rTolerance = 1.e-10);
+
+    static bool IsSymmetric(const Eigen::SparseMatrix<double, Eigen::RowMajor>& rMatrix, double rTolerance = 1.e-10)
+    {
+        return IsSymmetric(View(rMatrix), rTolerance);
+    }
+
+    //! @brief solves A x = rRhs with the factorization
+    Eigen::VectorXd Solve(const Eigen::VectorXd& rRhs) const;
+
+    int GetNumSupernodes() const
+    {
+        return static_cast<int>(mSupernodeBegin.size()) - 1;
+    }
+
+    //! @brief number of entries of L, including the unit diagonal
+    std::size_t GetNumNonZeros() const
+    {
+        return mNumNonZeros;
+    }
+
+    //! @brief number of negative entries of D, i.e. the number of negative eigenvalues of A
+    int GetNumNegativePivots() const
+    {
+        return (mDiagonal.array() < 0.).count();
+    }
+
+private:
+    static MatrixView View(const Eigen::SparseMatrix<double, Eigen::RowMajor>& rMatrix)
+    {
+        return MatrixView(rMatrix.rows(), rMatrix.cols(), rMatrix.nonZeros(), rMatrix.outerIndexPtr(),
+                          rMatrix.innerIndexPtr(), rMatrix.valuePtr());
+    }
+
+    //! @brief numerical factorization with frontal matrices and factor of type T
+    //! @param rValues ... values of the (scaled) matrix
+    template <typename T>
+    void FactorizeNumeric(const double* rValues, std::vector<T>& rFactorValues);
+
+    //! @brief assembles, factorizes and stores a supernode
+    //! @param rUpdates ... update matrices of the supernodes, those of the children are consumed
+    template <typename T>
+    void FactorizeSupernode(int rSupernode, const double* rValues,
+                            std::vector<Eigen::Matrix<T, Eigen::Dynamic, Eigen::Dynamic>>& rUpdates,
+                            std::vector<T>& rFactorValues);
+
+    //! @brief forward and backward substitution in the precision of the factor, in the new ordering
+    template <typename T>
+    void SolveNumeric(Eigen::Matrix<T, Eigen::Dynamic, 1>& rX, const std::vector<T>& rFactorValues) const;
+
+    ePrecision mPrecision;
+    int mNumRows = 0;
+    int mNumEntries = 0;
+    bool mIsFactorized = false;
+
+    //! @brief mOrdering[newIndex] = row of the matrix
+    std::vector<int> mOrdering;
+
+    //! @brief first column of each supernode (plus the end), in the new ordering
+    std::vector<int> mSupernodeBegin;
+
+    //! @brief rows of the frontal matrix of a supernode, its columns followed by the sorted rows of its update matrix
+    std::vector<std::vector<int>> mRows;
+
+    std::vector<std::vector<int>> mChildren;
+
+    //! @brief position of each row of the update matrix of a supernode in the frontal matrix of its parent
+    std::vector<std::vector<int>> mRelativeRows;
+
+    //! @brief (position in the values of the matrix, position in the column major frontal matrix) for the entries of A
+    std::vector<std::vector<std::pair<int, std::size_t>>> mAssembly;
+
+    //! @brief parallel schedule: each task factorizes the supernodes mSubtreeBegin[root] ... root, afterwards the
+    //! remaining supernodes mTopSupernodes are factorized in order
+    std::vector<int> mSubtreeBegin;
+    std::vector<int> mTaskRoots;
+    std::vector<int> mTopSupernodes;
+
+    //! @brief columns of L of each supernode, (number of rows) x (number of columns), column major, starting at
+    //! mFactorBegin[supernode]
+    std::vector<std::size_t> mFactorBegin;
+    std::vector<double> mFactorValues;
+    std::vector<float> mFactorValuesSingle;
+    std::size_t mNumNonZeros = 0;
+
+    Eigen::VectorXd mDiagonal;
+
+    //! @brief diagonal scaling D_A^-1/2 of the single precision factorization, in the original ordering
+    Eigen::VectorXd mScaling;
+};
+} // namespace NuTo
@@ -140,6 +140,13 @@ public:
     //! @return ... true/false
     virtual bool CheckOutputTypeCompatibility(NuTo::Constitutive::eOutput rOutputEnum) const;
 
+    //! @brief ... returns true, if the law calculates Constitutive::eOutput::TANGENT_STATE. Integration points with
+    //! equal tangent states have equal tangents, e.g. laws that remain in their elastic branch.
+    virtual bool HasTangentState() const
+    {
+        return false;
+    }
+
 
     ///////////////////////////////////////////////////////////////////////////
 
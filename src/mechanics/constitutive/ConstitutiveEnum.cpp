@@ -250,7 +250,7 @@ std::string NuTo::Constitutive::OutputToString(const NuTo::Constitutive::eOutput
             eOutput::D_INTERNAL_GRADIENT_WV_D_WV_BOUNDARY_NN_H0, "D_INTERNAL_GRADIENT_WV_D_WV_BOUNDARY_NN_H0")(
             eOutput::INTERNAL_GRADIENT_RELATIVE_HUMIDITY_BOUNDARY_N, "INTERNAL_GRADIENT_RELATIVE_HUMIDITY_BOUNDARY_N")(
             eOutput::INTERNAL_GRADIENT_WATER_VOLUME_FRACTION_BOUNDARY_N,
-            "INTERNAL_GRADIENT_WATER_VOLUME_FRACTION_BOUNDARY_N");
+            "INTERNAL_GRADIENT_WATER_VOLUME_FRACTION_BOUNDARY_N")(eOutput::TANGENT_STATE, "TANGENT_STATE");
     std::map<eOutput, std::string>::const_iterator it = lut.find(e);
     if (lut.end() != it)
         return it->second;
@@ -273,7 +273,8 @@ enum class eOutput
     SLIP,
     ELASTIC_ENERGY_DAMAGED_PART,
     D_ELASTIC_ENERGY_DAMAGED_PART_D_ENGINEERING_STRAIN,
-    NONLOCAL_RADIUS
+    NONLOCAL_RADIUS,
+    TANGENT_STATE //!< equal values <=> equal D_ENGINEERING_STRESS_D_ENGINEERING_STRAIN, NaN if it depends on the strain
 };
 
 
@@ -37,6 +37,16 @@ public:
         return std::make_unique<ConstitutiveCalculateStaticData>(*this);
     }
 
+    virtual bool CopyValues(const ConstitutiveIOBase& rOther) override
+    {
+        auto other = dynamic_cast<const ConstitutiveCalculateStaticData*>(&rOther);
+        if (other == nullptr)
+            return false;
+        mCalculateStaticData = other->mCalculateStaticData;
+        mIndexOfPreviousStaticData = other->mIndexOfPreviousStaticData;
+        return true;
+    }
+
     //! @brief returns (rXn + rTimeStep[0] / rTimeStep[1] * (rXn - rXn_m1)
     template <typename T>
     static T EulerForward(const T& rXn, const T& rXn_m1, const ConstitutiveIOBase& rTimeStep)
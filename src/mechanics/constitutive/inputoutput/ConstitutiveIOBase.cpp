@@ -39,6 +39,7 @@ NuTo::ConstitutiveIOBase::makeConstitutiveIO(NuTo::Constitutive::eOutput outputT
     case eOutput::INTERNAL_GRADIENT_WATER_VOLUME_FRACTION_BOUNDARY_N:
     case eOutput::LOCAL_EQ_STRAIN:
     case eOutput::NONLOCAL_RADIUS:
+    case eOutput::TANGENT_STATE:
         return std::make_unique<ConstitutiveScalar>();
     // vectors dim
     case eOutput::INTERNAL_GRADIENT_RELATIVE_HUMIDITY_B:
@@ -200,7 +201,7 @@ double NuTo::ConstitutiveIOBase::operator[](int) const
 }
 
 
-void NuTo::ConstitutiveIOBase::AssertIsScalar(Constitutive::eOutput rOutputEnum, std::string rMethodName) const
+void NuTo::ConstitutiveIOBase::AssertIsScalar(Constitutive::eOutput rOutputEnum, const char* rMethodName) const
 {
     bool isNotScalar = dynamic_cast<const ConstitutiveScalar*>(this) == nullptr;
     if (isNotScalar)
@@ -33,6 +33,13 @@ public:
     //! Copy construct `this` into a `unique_ptr`.
     virtual std::unique_ptr<ConstitutiveIOBase> clone() = 0;
 
+    //! Copies the values of `rOther` into `this` without creating a new object.
+    //! @return false, if the type of `rOther` is not compatible and nothing was copied
+    virtual bool CopyValues(const ConstitutiveIOBase&)
+    {
+        return false;
+    }
+
     //! Factory for polymorphic construction of constitutive outputs.
     //! @param outputType Determines which derived object is returned
     //! @return `unique_ptr` to the created object
@@ -82,12 +89,12 @@ public:
      *  some "pretty asserts" to ensure type safety
      *
      ***************************************************************************/
-    void AssertIsScalar(Constitutive::eOutput rOutputEnum, std::string rMethodName) const;
+    void AssertIsScalar(Constitutive::eOutput rOutputEnum, const char* rMethodName) const;
     // implementation in cpp file, since the dynamic_cast to ConstitutiveScalar
     // requires the full include instead of the forward declaration
 
     template <int TRows>
-    void AssertIsVector(Constitutive::eOutput rOutputEnum, std::string rMethodName) const
+    void AssertIsVector(Constitutive::eOutput rOutputEnum, const char* rMethodName) const
     {
 #ifndef NDEBUG
         AssertDimension<TRows, 1>(rOutputEnum, rMethodName);
@@ -99,7 +106,7 @@ public:
     }
 
     template <int TRows, int TCols>
-    void AssertIsMatrix(Constitutive::eOutput rOutputEnum, std::string rMethodName) const
+    void AssertIsMatrix(Constitutive::eOutput rOutputEnum, const char* rMethodName) const
     {
 #ifndef NDEBUG
         AssertDimension<TRows, TCols>(rOutputEnum, rMethodName);
@@ -155,12 +162,12 @@ public:
 private:
 #ifndef NDEBUG
     template <int TRows, int TCols>
-    void AssertDimension(Constitutive::eOutput rOutputEnum, const std::string& rMethodName) const
+    void AssertDimension(Constitutive::eOutput rOutputEnum, const char* rMethodName) const
     {
         if (GetNumRows() != TRows || GetNumColumns() != TCols)
         {
             std::string exception;
-            exception += "[" + rMethodName + "] \n";
+            exception += std::string("[") + rMethodName + "] \n";
             exception += "Dimension mismatch of constitutive output. \n";
             exception += "Dim(" + Constitutive::OutputToString(rOutputEnum) + ") = (";
             exception += std::to_string(GetNumRows()) + "x" + std::to_string(GetNumColumns()) + ") ";
@@ -46,6 +46,20 @@ NuTo::ConstitutiveIOMap<IOEnum>& NuTo::ConstitutiveIOMap<IOEnum>::Merge(const Co
     return *this;
 }
 
+template <typename IOEnum>
+NuTo::ConstitutiveIOMap<IOEnum>& NuTo::ConstitutiveIOMap<IOEnum>::CopyValues(const ConstitutiveIOMap<IOEnum>& other)
+{
+    for (auto& it : other)
+    {
+        auto& object = (*this)[it.first];
+        if (it.second == nullptr)
+            object.reset();
+        else if (object == nullptr or not object->CopyValues(*it.second))
+            object = it.second->clone();
+    }
+    return *this;
+}
+
 template <typename IOEnum>
 bool NuTo::ConstitutiveIOMap<IOEnum>::Contains(IOEnum rEnum) const
 {
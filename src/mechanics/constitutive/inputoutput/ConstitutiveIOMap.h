@@ -22,6 +22,10 @@ public:
     ConstitutiveIOMap() = default;
     ConstitutiveIOMap(const ConstitutiveIOMap& other);
     NuTo::ConstitutiveIOMap<IOEnum>& Merge(const ConstitutiveIOMap& other);
+    //! @brief copies the values of all objects in `other` to the objects with the same key in this map
+    //! @remark New objects are only created (cloned) for missing keys or incompatible types. Repeated updates with
+    //! maps of the same structure do not allocate memory.
+    NuTo::ConstitutiveIOMap<IOEnum>& CopyValues(const ConstitutiveIOMap& other);
     bool Contains(IOEnum rEnum) const;
     template <int TDim>
     void Add(IOEnum rEnum)
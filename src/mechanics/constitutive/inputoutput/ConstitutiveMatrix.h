@@ -25,6 +25,17 @@ public:
         return std::make_unique<ConstitutiveMatrix<TRows, TCols>>(*this);
     }
 
+    virtual bool CopyValues(const ConstitutiveIOBase& rOther) override
+    {
+        auto other = dynamic_cast<const ConstitutiveMatrix<TRows, TCols>*>(&rOther);
+        if (other == nullptr)
+            return false;
+        static_cast<Eigen::Matrix<double, TRows, TCols>&>(*this) =
+                static_cast<const Eigen::Matrix<double, TRows, TCols>&>(*other);
+        this->SetIsCalculated(other->GetIsCalculated());
+        return true;
+    }
+
     ConstitutiveMatrix& operator=(const ConstitutiveMatrix&) = default;
     ConstitutiveMatrix& operator=(ConstitutiveMatrix&&) = default;
 
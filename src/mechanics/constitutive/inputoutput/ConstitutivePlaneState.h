@@ -26,6 +26,15 @@ public:
         return std::make_unique<ConstitutivePlaneState>(*this);
     }
 
+    virtual bool CopyValues(const ConstitutiveIOBase& rOther) override
+    {
+        auto other = dynamic_cast<const ConstitutivePlaneState*>(&rOther);
+        if (other == nullptr)
+            return false;
+        mPlaneState = other->mPlaneState;
+        return true;
+    }
+
     ePlaneState GetPlaneState() const
     {
         return mPlaneState;
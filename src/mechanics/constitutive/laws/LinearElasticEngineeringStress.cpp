@@ -49,6 +49,7 @@ NuTo::LinearElasticEngineeringStress::GetConstitutiveInputs(const ConstitutiveOu
             break;
         // no inputs needed for:
         case NuTo::Constitutive::eOutput::D_ENGINEERING_STRESS_D_ENGINEERING_STRAIN:
+        case NuTo::Constitutive::eOutput::TANGENT_STATE:
         case NuTo::Constitutive::eOutput::UPDATE_TMP_STATIC_DATA:
         case NuTo::Constitutive::eOutput::UPDATE_STATIC_DATA:
             break;
@@ -111,6 +112,12 @@ void NuTo::LinearElasticEngineeringStress::Evaluate<1>(const ConstitutiveInputMa
                     rConstitutiveInput.at(Constitutive::eInput::ENGINEERING_STRAIN)->AsEngineeringStrain1D().As3D(mNu);
             break;
         }
+        case NuTo::Constitutive::eOutput::TANGENT_STATE:
+        {
+            // the tangent is constant
+            (*itOutput.second)[0] = 0.;
+            break;
+        }
         case NuTo::Constitutive::eOutput::EXTRAPOLATION_ERROR:
             break;
         case NuTo::Constitutive::eOutput::UPDATE_TMP_STATIC_DATA:
@@ -228,6 +235,12 @@ void NuTo::LinearElasticEngineeringStress::Evaluate<2>(const ConstitutiveInputMa
                                                                .As3D(mNu, planeState.GetPlaneState());
         }
         break;
+        case NuTo::Constitutive::eOutput::TANGENT_STATE:
+        {
+            // the tangent is constant
+            (*itOutput.second)[0] = 0.;
+            break;
+        }
         case NuTo::Constitutive::eOutput::EXTRAPOLATION_ERROR:
             break;
         case NuTo::Constitutive::eOutput::UPDATE_TMP_STATIC_DATA:
@@ -312,6 +325,12 @@ void NuTo::LinearElasticEngineeringStress::Evaluate<3>(const ConstitutiveInputMa
                     rConstitutiveInput.at(Constitutive::eInput::ENGINEERING_STRAIN)->AsEngineeringStrain3D();
             break;
         }
+        case NuTo::Constitutive::eOutput::TANGENT_STATE:
+        {
+            // the tangent is constant
+            (*itOutput.second)[0] = 0.;
+            break;
+        }
         case NuTo::Constitutive::eOutput::EXTRAPOLATION_ERROR:
             break;
         case NuTo::Constitutive::eOutput::UPDATE_TMP_STATIC_DATA:
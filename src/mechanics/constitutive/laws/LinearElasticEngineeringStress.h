@@ -140,6 +140,12 @@ public:
         return false;
     }
 
+    //! @brief ... the tangent is constant, see ConstitutiveBase::HasTangentState
+    bool HasTangentState() const override
+    {
+        return true;
+    }
+
 
 protected:
     //! @brief ... Young's modulus \f$ E \f$
@@ -13,6 +13,8 @@
 #include "mechanics/constitutive/inputoutput/EquivalentStrain.h"
 #include "mechanics/constitutive/damageLaws/DamageLaw.h"
 
+#include <limits>
+
 
 using NuTo::Constitutive::eConstitutiveParameter;
 using NuTo::Constitutive::eOutput;
@@ -114,40 +116,17 @@ template <>
 void NuTo::LocalDamageModel::Evaluate<1>(const ConstitutiveInputMap& rConstitutiveInput,
                                          const ConstitutiveOutputMap& rConstitutiveOutput, Data& rStaticData)
 {
-    throw Exception(__PRETTY_FUNCTION__, "IMPLEMENT ME!");
-
     double kappa = GetCurrentStaticData<1>(rStaticData, rConstitutiveInput);
+    double omega = mDamageLaw->CalculateDamage(kappa);
 
     // get constitutive inputs
-    const auto& elasticEngineeringStrain = rConstitutiveInput.at(eInput::ENGINEERING_STRAIN)->AsEngineeringStrain2D();
+    const auto& strainEl = rConstitutiveInput.at(eInput::ENGINEERING_STRAIN)->AsEngineeringStrain1D();
 
-    const auto& planeState =
-            *dynamic_cast<ConstitutivePlaneState*>(rConstitutiveInput.at(Constitutive::eInput::PLANE_STATE).get());
-
-    EquivalentStrainModifiedMises<2> eeq(elasticEngineeringStrain, mCompressiveStrength / mTensileStrength,
-                                         mPoissonsRatio, planeState.GetPlaneState());
+    EquivalentStrainModifiedMises<1> eeq(strainEl, mCompressiveStrength / mTensileStrength, mPoissonsRatio);
     double localEqStrain = eeq.Get();
 
-    double omega = mDamageLaw->CalculateDamage(kappa);
-
     bool performUpdateAtEnd = false;
 
-    // calculate coefficients
-    double C11, C12, C33;
-    switch (planeState.GetPlaneState())
-    {
-    case ePlaneState::PLANE_STRAIN:
-        std::tie(C11, C12, C33) = EngineeringStressHelper::CalculateCoefficients3D(mYoungsModulus, mPoissonsRatio);
-        break;
-    case ePlaneState::PLANE_STRESS:
-        std::tie(C11, C12, C33) =
-                EngineeringStressHelper::CalculateCoefficients2DPlaneStress(mYoungsModulus, mPoissonsRatio);
-        break;
-    default:
-        throw Exception(__PRETTY_FUNCTION__, "Invalid type of 2D section behavior found.");
-    }
-
-
     /////////////////////////////////////////////////
     //         LOOP OVER OUTPUT REQUESTS           //
     /////////////////////////////////////////////////
@@ -160,52 +139,21 @@ void NuTo::LocalDamageModel::Evaluate<1>(const ConstitutiveInputMap& rConstituti
         case eOutput::ENGINEERING_STRESS:
         {
             ConstitutiveIOBase& engineeringStress = *itOutput.second;
-            engineeringStress.AssertIsVector<3>(itOutput.first, __PRETTY_FUNCTION__);
-            engineeringStress[0] =
-                    (1 - omega) * (C11 * elasticEngineeringStrain[0] + C12 * elasticEngineeringStrain[1]);
-            engineeringStress[1] =
-                    (1 - omega) * (C11 * elasticEngineeringStrain[1] + C12 * elasticEngineeringStrain[0]);
-            engineeringStress[2] = (1 - omega) * C33 * elasticEngineeringStrain[2];
+            engineeringStress.AssertIsVector<1>(itOutput.first, __PRETTY_FUNCTION__);
+            engineeringStress[0] = (1 - omega) * mYoungsModulus * strainEl[0];
             break;
         }
 
         case eOutput::D_ENGINEERING_STRESS_D_ENGINEERING_STRAIN:
         {
             ConstitutiveIOBase& tangent = *itOutput.second;
-            tangent.AssertIsMatrix<3, 3>(itOutput.first, __PRETTY_FUNCTION__);
+            tangent.AssertIsMatrix<1, 1>(itOutput.first, __PRETTY_FUNCTION__);
 
-            double dDamageDKappa = mDamageLaw->CalculateDerivative(kappa);
+            double dDamageDKappa = CalculateDamageDerivative(kappa, localEqStrain, rConstitutiveInput);
             auto dLocalEqStrainDStrain = eeq.GetDerivative();
 
-            auto itCalculateStaticData = rConstitutiveInput.find(Constitutive::eInput::CALCULATE_STATIC_DATA);
-            const auto& calculateStaticData =
-                    *static_cast<const ConstitutiveCalculateStaticData*>(itCalculateStaticData->second.get());
-
-            if (calculateStaticData.GetCalculateStaticData() == eCalculateStaticData::EULER_FORWARD)
-                dDamageDKappa = 0.;
-
-            if (localEqStrain < kappa)
-                dDamageDKappa = 0.; // set zero as well, corrresponds to
-            // dKappa / dLocalEqStrain
-
-
-            std::vector<double> effectiveStress(3);
-            effectiveStress[0] = (C11 * elasticEngineeringStrain[0] + C12 * elasticEngineeringStrain[1]);
-            effectiveStress[1] = (C11 * elasticEngineeringStrain[1] + C12 * elasticEngineeringStrain[0]);
-            effectiveStress[2] = C33 * elasticEngineeringStrain[2];
-
-            // right coefficients are calculated above
-            tangent(0, 0) = (1 - omega) * C11 - dDamageDKappa * dLocalEqStrainDStrain[0] * effectiveStress[0];
-            tangent(1, 0) = (1 - omega) * C12 - dDamageDKappa * dLocalEqStrainDStrain[0] * effectiveStress[1];
-            tangent(2, 0) = 0. - dDamageDKappa * dLocalEqStrainDStrain[0] * effectiveStress[2];
-
-            tangent(0, 1) = (1 - omega) * C12 - dDamageDKappa * dLocalEqStrainDStrain[1] * effectiveStress[0];
-            tangent(1, 1) = (1 - omega) * C11 - dDamageDKappa * dLocalEqStrainDStrain[1] * effectiveStress[1];
-            tangent(2, 1) = 0. - dDamageDKappa * dLocalEqStrainDStrain[1] * effectiveStress[2];
-
-            tangent(0, 2) = 0. - dDamageDKappa * dLocalEqStrainDStrain[2] * effectiveStress[0];
-            tangent(1, 2) = 0. - dDamageDKappa * dLocalEqStrainDStrain[2] * effectiveStress[1];
-            tangent(2, 2) = (1 - omega) * C33 - dDamageDKappa * dLocalEqStrainDStrain[2] * effectiveStress[2];
+            tangent(0, 0) = (1 - omega) * mYoungsModulus -
+                            dDamageDKappa * dLocalEqStrainDStrain[0] * mYoungsModulus * strainEl[0];
             break;
         }
 
@@ -217,6 +165,13 @@ void NuTo::LocalDamageModel::Evaluate<1>(const ConstitutiveInputMap& rConstituti
             damage[0] = omega;
             break;
         }
+        case eOutput::TANGENT_STATE:
+        {
+            // the tangent (1 - omega) E only depends on the strain, if the damage evolves
+            const bool isConstant = CalculateDamageDerivative(kappa, localEqStrain, rConstitutiveInput) == 0.;
+            (*itOutput.second)[0] = isConstant ? omega : std::numeric_limits<double>::quiet_NaN();
+            break;
+        }
         case eOutput::EXTRAPOLATION_ERROR:
         {
             ConstitutiveIOBase& error = *itOutput.second;
@@ -228,12 +183,11 @@ void NuTo::LocalDamageModel::Evaluate<1>(const ConstitutiveInputMap& rConstituti
             throw Exception(__PRETTY_FUNCTION__,
                             "tmp_static_data has to be updated without any other outputs, call it separately.");
         }
-            continue;
         case eOutput::UPDATE_STATIC_DATA:
         {
             performUpdateAtEnd = true;
-        }
             continue;
+        }
 
         default:
             continue;
@@ -306,20 +260,9 @@ void NuTo::LocalDamageModel::Evaluate<2>(const ConstitutiveInputMap& rConstituti
         {
             Eigen::Matrix3d& tangent = dynamic_cast<Eigen::Matrix3d&>(*itOutput.second);
 
-            double dDamageDKappa = mDamageLaw->CalculateDerivative(kappa);
+            double dDamageDKappa = CalculateDamageDerivative(kappa, localEqStrain, rConstitutiveInput);
             auto dLocalEqStrainDStrain = eeq.GetDerivative();
 
-            auto itCalculateStaticData = rConstitutiveInput.find(Constitutive::eInput::CALCULATE_STATIC_DATA);
-            const auto& calculateStaticData =
-                    *static_cast<const ConstitutiveCalculateStaticData*>(itCalculateStaticData->second.get());
-
-            if (calculateStaticData.GetCalculateStaticData() == eCalculateStaticData::EULER_FORWARD)
-                dDamageDKappa = 0.;
-
-            if (localEqStrain < kappa)
-                dDamageDKappa = 0.; // set zero as well, corrresponds to
-            // dKappa / dLocalEqStrain
-
             Eigen::Vector3d effectiveStress;
             effectiveStress[0] = (C11 * strainEl[0] + C12 * strainEl[1]);
             effectiveStress[1] = (C11 * strainEl[1] + C12 * strainEl[0]);
@@ -346,6 +289,13 @@ void NuTo::LocalDamageModel::Evaluate<2>(const ConstitutiveInputMap& rConstituti
             damage[0] = omega;
             break;
         }
+        case eOutput::TANGENT_STATE:
+        {
+            // the tangent (1 - omega) C only depends on the strain, if the damage evolves
+            const bool isConstant = CalculateDamageDerivative(kappa, localEqStrain, rConstitutiveInput) == 0.;
+            (*itOutput.second)[0] = isConstant ? omega : std::numeric_limits<double>::quiet_NaN();
+            break;
+        }
         case eOutput::EXTRAPOLATION_ERROR:
         {
             ConstitutiveIOBase& error = *itOutput.second;
@@ -421,20 +371,9 @@ void NuTo::LocalDamageModel::Evaluate<3>(const ConstitutiveInputMap& rConstituti
         {
             Eigen::Matrix<double, 6, 6>& tangent = dynamic_cast<Eigen::Matrix<double, 6, 6>&>(*itOutput.second);
 
-            double dDamageDKappa = mDamageLaw->CalculateDerivative(kappa);
+            double dDamageDKappa = CalculateDamageDerivative(kappa, localEqStrain, rConstitutiveInput);
             auto dLocalEqStrainDStrain = eeq.GetDerivative();
 
-            auto itCalculateStaticData = rConstitutiveInput.find(Constitutive::eInput::CALCULATE_STATIC_DATA);
-            const auto& calculateStaticData =
-                    *static_cast<const ConstitutiveCalculateStaticData*>(itCalculateStaticData->second.get());
-
-            if (calculateStaticData.GetCalculateStaticData() == eCalculateStaticData::EULER_FORWARD)
-                dDamageDKappa = 0.;
-
-            if (localEqStrain < kappa)
-                dDamageDKappa = 0.; // set zero as well, corrresponds to
-            // dKappa / dLocalEqStrain
-
 
             Eigen::Matrix<double, 6, 1> effectiveStress;
             effectiveStress[0] = C11 * strainEl[0] + C12 * (strainEl[1] + strainEl[2]);
@@ -478,6 +417,13 @@ void NuTo::LocalDamageModel::Evaluate<3>(const ConstitutiveInputMap& rConstituti
             damage[0] = omega;
             break;
         }
+        case eOutput::TANGENT_STATE:
+        {
+            // the tangent (1 - omega) C only depends on the strain, if the damage evolves
+            const bool isConstant = CalculateDamageDerivative(kappa, localEqStrain, rConstitutiveInput) == 0.;
+            (*itOutput.second)[0] = isConstant ? omega : std::numeric_limits<double>::quiet_NaN();
+            break;
+        }
         case NuTo::Constitutive::eOutput::LOCAL_EQ_STRAIN:
         {
             (*itOutput.second)[0] = localEqStrain;
@@ -526,6 +472,22 @@ NuTo::ConstitutiveInputMap NuTo::LocalDamageModel::GetConstitutiveInputs(const C
     return constitutiveInputMap;
 }
 
+double NuTo::LocalDamageModel::CalculateDamageDerivative(double rKappa, double rLocalEqStrain,
+                                                        const ConstitutiveInputMap& rConstitutiveInput) const
+{
+    const auto& calculateStaticData = *static_cast<const ConstitutiveCalculateStaticData*>(
+            rConstitutiveInput.at(Constitutive::eInput::CALCULATE_STATIC_DATA).get());
+
+    if (calculateStaticData.GetCalculateStaticData() == eCalculateStaticData::EULER_FORWARD)
+        return 0.;
+
+    // set zero as well, corresponds to dKappa / dLocalEqStrain
+    if (rLocalEqStrain < rKappa)
+        return 0.;
+
+    return mDamageLaw->CalculateDerivative(rKappa);
+}
+
 template <int TDim>
 double NuTo::LocalDamageModel::GetCurrentStaticData(Data& rStaticData,
                                                     const ConstitutiveInputMap& rConstitutiveInput) const
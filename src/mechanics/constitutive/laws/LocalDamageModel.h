@@ -53,6 +53,15 @@ public:
     double CalculateStaticDataExtrapolationError(Data& rStaticData,
                                                  const ConstitutiveInputMap& rConstitutiveInput) const;
 
+    //! @brief Calculates the derivative of the damage with respect to kappa, zero if kappa does not follow the local
+    //! equivalent strain.
+    //! @param rKappa Kappa value calculated from history data.
+    //! @param rLocalEqStrain Local equivalent strain.
+    //! @param rConstitutiveInput Input to the constitutive law (strain, temp gradient etc.).
+    //! @return dOmega / dKappa * dKappa / dLocalEqStrain
+    double CalculateDamageDerivative(double rKappa, double rLocalEqStrain,
+                                     const ConstitutiveInputMap& rConstitutiveInput) const;
+
 
     //! @brief ... gets a variable of the constitutive law which is selected by an enum
     //! @param rIdentifier ... Enum to identify the requested variable
@@ -72,6 +81,12 @@ public:
     //! @brief ... check parameters of the constitutive relationship
     void CheckParameters() const override;
 
+    //! @brief ... the tangent is \f$(1-\omega) C\f$ while the damage does not evolve, the tangent state is \f$\omega\f$
+    bool HasTangentState() const override
+    {
+        return true;
+    }
+
     //! @brief ... determines which submatrices of a multi-doftype problem can be solved by the constitutive law
     //! @param rDofRow ... row dof
     //! @param rDofCol ... column dof
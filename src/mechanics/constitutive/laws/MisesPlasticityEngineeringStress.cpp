@@ -1,4 +1,5 @@
 #include <iostream>
+#include <limits>
 #include "base/Logger.h"
 
 #include "mechanics/structures/StructureBase.h"
@@ -41,6 +42,7 @@ NuTo::MisesPlasticityEngineeringStress::GetConstitutiveInputs(const Constitutive
         case NuTo::Constitutive::eOutput::ENGINEERING_STRAIN_VISUALIZE:
         case NuTo::Constitutive::eOutput::ENGINEERING_PLASTIC_STRAIN_VISUALIZE:
         case NuTo::Constitutive::eOutput::D_ENGINEERING_STRESS_D_ENGINEERING_STRAIN:
+        case NuTo::Constitutive::eOutput::TANGENT_STATE:
         case NuTo::Constitutive::eOutput::UPDATE_TMP_STATIC_DATA:
         case NuTo::Constitutive::eOutput::UPDATE_STATIC_DATA:
             break;
@@ -85,7 +87,7 @@ void NuTo::MisesPlasticityEngineeringStress::Evaluate<2>(const ConstitutiveInput
     ConstitutiveIOBase* engineeringStressPtr = nullptr;
     ConstitutiveIOBase* tangent = nullptr;
 
-    bool strainRequested = false;
+    unsigned numOutputsWithoutReturnMapping = 0;
 
     for (auto& itOutput : rConstitutiveOutput)
     {
@@ -107,7 +109,8 @@ void NuTo::MisesPlasticityEngineeringStress::Evaluate<2>(const ConstitutiveInput
         }
 
         case Constitutive::eOutput::ENGINEERING_STRAIN_VISUALIZE:
-            strainRequested = true;
+        case Constitutive::eOutput::TANGENT_STATE:
+            ++numOutputsWithoutReturnMapping;
             break;
 
         case Constitutive::eOutput::ENGINEERING_PLASTIC_STRAIN_VISUALIZE:
@@ -125,9 +128,9 @@ void NuTo::MisesPlasticityEngineeringStress::Evaluate<2>(const ConstitutiveInput
     }
 
 
-    if (rConstitutiveOutput.size() == 1 && strainRequested)
+    if (rConstitutiveOutput.size() == numOutputsWithoutReturnMapping)
     {
-        // return mapping can skipped, if ENGINEERING_STRAIN_VISUALIZE is the only requested output.
+        // return mapping can skipped, if only ENGINEERING_STRAIN_VISUALIZE or TANGENT_STATE are requested.
     }
     else
     {
@@ -173,6 +176,18 @@ void NuTo::MisesPlasticityEngineeringStress::Evaluate<2>(const ConstitutiveInput
             engineeringPlasticStrain = newStaticData.GetPlasticStrain();
             break;
         }
+        case Constitutive::eOutput::TANGENT_STATE:
+        {
+            EngineeringStrain<3> engineeringStrain3D;
+            engineeringStrain3D.SetZero();
+            engineeringStrain3D[0] = engineeringStrain[0];
+            engineeringStrain3D[1] = engineeringStrain[1];
+            engineeringStrain3D[3] = engineeringStrain[2];
+            (*itOutput.second)[0] = IsElastic3D(rStaticData.GetData(), engineeringStrain3D)
+                                            ? 0.
+                                            : std::numeric_limits<double>::quiet_NaN();
+            break;
+        }
         case Constitutive::eOutput::UPDATE_TMP_STATIC_DATA:
             continue;
         case Constitutive::eOutput::UPDATE_STATIC_DATA:
@@ -202,7 +217,7 @@ void NuTo::MisesPlasticityEngineeringStress::Evaluate<3>(const ConstitutiveInput
     StaticData::DataMisesPlasticity<3> newStaticData;
     StaticData::DataMisesPlasticity<3>* newStaticDataPtr = nullptr;
 
-    bool strainRequested = false;
+    unsigned numOutputsWithoutReturnMapping = 0;
 
     for (auto& itOutput : rConstitutiveOutput)
     {
@@ -234,7 +249,8 @@ void NuTo::MisesPlasticityEngineeringStress::Evaluate<3>(const ConstitutiveInput
             break;
         }
         case Constitutive::eOutput::ENGINEERING_STRAIN_VISUALIZE:
-            strainRequested = true;
+        case Constitutive::eOutput::TANGENT_STATE:
+            ++numOutputsWithoutReturnMapping;
             break;
         case Constitutive::eOutput::ENGINEERING_PLASTIC_STRAIN_VISUALIZE:
         case Constitutive::eOutput::UPDATE_STATIC_DATA:
@@ -249,9 +265,9 @@ void NuTo::MisesPlasticityEngineeringStress::Evaluate<3>(const ConstitutiveInput
     }
 
 
-    if (rConstitutiveOutput.size() == 1 && strainRequested)
+    if (rConstitutiveOutput.size() == numOutputsWithoutReturnMapping)
     {
-        // return mapping can skipped, if ENGINEERING_STRAIN_VISUALIZE is the only requested output.
+        // return mapping can skipped, if only ENGINEERING_STRAIN_VISUALIZE or TANGENT_STATE are requested.
     }
     else
     {
@@ -284,6 +300,13 @@ void NuTo::MisesPlasticityEngineeringStress::Evaluate<3>(const ConstitutiveInput
             engineeringPlasticStrain = newStaticData.GetPlasticStrain();
             break;
         }
+        case Constitutive::eOutput::TANGENT_STATE:
+        {
+            (*itOutput.second)[0] = IsElastic3D(rStaticData.GetData(), engineeringStrain)
+                                            ? 0.
+                                            : std::numeric_limits<double>::quiet_NaN();
+            break;
+        }
         case Constitutive::eOutput::UPDATE_TMP_STATIC_DATA:
             continue;
         case Constitutive::eOutput::UPDATE_STATIC_DATA:
@@ -358,6 +381,57 @@ void NuTo::MisesPlasticityEngineeringStress::ReturnMapping2D(StaticData::DataMis
     }
 }
 
+bool NuTo::MisesPlasticityEngineeringStress::IsElastic3D(const StaticData::DataMisesPlasticity<3>& oldStaticData,
+                                                         const EngineeringStrain<3>& rEngineeringStrain) const
+{
+    double sigma_trial[6], xi_trial[6], norm_dev, sigma_y, d_sigma, yield_condition;
+    return TrialState3D(oldStaticData, rEngineeringStrain, sigma_trial, xi_trial, norm_dev, sigma_y, d_sigma,
+                        yield_condition);
+}
+
+
+bool NuTo::MisesPlasticityEngineeringStress::TrialState3D(const StaticData::DataMisesPlasticity<3>& oldStaticData,
+                                                          const EngineeringStrain<3>& rEngineeringStrain,
+                                                          double rSigmaTrial[6], double rXiTrial[6], double& rNormDev,
+                                                          double& rSigmaY, double& rDSigma,
+                                                          double& rYieldCondition) const
+{
+    const double sqrt_2div3 = 0.81649658;
+    const double tolerance = 1e-8;
+    const double mu = mE / (2. * (1. + mNu));
+
+    // set strain data ptr
+    const EngineeringStrain<3>& total_strain = rEngineeringStrain;
+
+    const EngineeringStrain<3> plastic_strain = oldStaticData.GetPlasticStrain();
+    const EngineeringStress<3> back_stress = oldStaticData.GetBackStress();
+
+    const double trace_epsilon_div_3 = (total_strain[0] + total_strain[1] + total_strain[2]) / 3.;
+
+    // trial stress
+    rSigmaTrial[0] = (total_strain[0] - trace_epsilon_div_3 - plastic_strain[0]) * 2. * mu;
+    rSigmaTrial[1] = (total_strain[1] - trace_epsilon_div_3 - plastic_strain[1]) * 2. * mu;
+    rSigmaTrial[2] = (total_strain[2] - trace_epsilon_div_3 - plastic_strain[2]) * 2. * mu;
+    rSigmaTrial[3] = (total_strain[3] - plastic_strain[3]) * mu; // in total strain, gamma is stored
+    rSigmaTrial[4] = (total_strain[4] - plastic_strain[4]) * mu; // in total strain, gamma is stored
+    rSigmaTrial[5] = (total_strain[5] - plastic_strain[5]) * mu; // in total strain, gamma is stored
+
+    // subtract backstress
+    for (int i = 0; i < 6; ++i)
+        rXiTrial[i] = rSigmaTrial[i] - back_stress[i];
+
+    // norm of deviator
+    rNormDev = std::sqrt(rXiTrial[0] * rXiTrial[0] + rXiTrial[1] * rXiTrial[1] + rXiTrial[2] * rXiTrial[2] +
+                         2. * (rXiTrial[3] * rXiTrial[3] + rXiTrial[4] * rXiTrial[4] + rXiTrial[5] * rXiTrial[5]));
+
+    // determine radius of yield function
+    rSigmaY = GetYieldStrength(oldStaticData.GetEquivalentPlasticStrain(), rDSigma);
+
+    rYieldCondition = rNormDev - sqrt_2div3 * rSigmaY;
+    return rYieldCondition < -tolerance * rSigmaY;
+}
+
+
 void NuTo::MisesPlasticityEngineeringStress::ReturnMapping3D(StaticData::DataMisesPlasticity<3>& oldStaticData,
                                                              const EngineeringStrain<3>& rEngineeringStrain,
                                                              ConstitutiveIOBase* rNewStress,
@@ -368,7 +442,7 @@ void NuTo::MisesPlasticityEngineeringStress::ReturnMapping3D(StaticData::DataMis
     const double tolerance = 1e-8;
 
     double sigma_trial[6], xi_trial[6], norm_dev, sigma_y, factor, yield_condition, d_sigma, d_H, H, H2, mu,
-            bulk_modulus, delta_gamma = 0., df_dsigma[6], trace_epsilon, trace_epsilon_div_3;
+            bulk_modulus, delta_gamma = 0., df_dsigma[6], trace_epsilon;
 
     mu = mE / (2. * (1. + mNu));
     bulk_modulus = mE / (3. - 6. * mNu);
@@ -381,39 +455,7 @@ void NuTo::MisesPlasticityEngineeringStress::ReturnMapping3D(StaticData::DataMis
 
     trace_epsilon = total_strain[0] + total_strain[1] + total_strain[2];
 
-    trace_epsilon_div_3 = trace_epsilon / 3.;
-
-    // trial stress
-    sigma_trial[0] = (total_strain[0] - trace_epsilon_div_3 - plastic_strain[0]) * 2. * mu;
-    sigma_trial[1] = (total_strain[1] - trace_epsilon_div_3 - plastic_strain[1]) * 2. * mu;
-    sigma_trial[2] = (total_strain[2] - trace_epsilon_div_3 - plastic_strain[2]) * 2. * mu;
-    sigma_trial[3] = (total_strain[3] - plastic_strain[3]) * mu; // in total strain, gamma is stored
-    sigma_trial[4] = (total_strain[4] - plastic_strain[4]) * mu; // in total strain, gamma is stored
-    sigma_trial[5] = (total_strain[5] - plastic_strain[5]) * mu; // in total strain, gamma is stored
-
-    // subtract backstress
-    xi_trial[0] = sigma_trial[0] - back_stress[0];
-    xi_trial[1] = sigma_trial[1] - back_stress[1];
-    xi_trial[2] = sigma_trial[2] - back_stress[2];
-    xi_trial[3] = sigma_trial[3] - back_stress[3];
-    xi_trial[4] = sigma_trial[4] - back_stress[4];
-    xi_trial[5] = sigma_trial[5] - back_stress[5];
-
-    //    printf("total_strain %g %g %g %g %g
-    //    %g\n",total_strain[0],total_strain[1],total_strain[2],total_strain[3],total_strain[4],total_strain[5]);
-    //    printf("Xi trial %g %g %g %g %g
-    //    %g\n",xi_trial[0],xi_trial[1],xi_trial[2],xi_trial[3],xi_trial[4],xi_trial[5]);
-
-    // norm of deviator
-    norm_dev = std::sqrt(xi_trial[0] * xi_trial[0] + xi_trial[1] * xi_trial[1] + xi_trial[2] * xi_trial[2] +
-                         2. * (xi_trial[3] * xi_trial[3] + xi_trial[4] * xi_trial[4] + xi_trial[5] * xi_trial[5]));
-
-    // determine radius of yield function
-    sigma_y = GetYieldStrength(oldStaticData.GetEquivalentPlasticStrain(), d_sigma);
-
-    yield_condition = norm_dev - sqrt_2div3 * sigma_y;
-
-    if (yield_condition < -tolerance * sigma_y)
+    if (TrialState3D(oldStaticData, total_strain, sigma_trial, xi_trial, norm_dev, sigma_y, d_sigma, yield_condition))
     {
         // elastic regime
         factor = bulk_modulus * trace_epsilon;
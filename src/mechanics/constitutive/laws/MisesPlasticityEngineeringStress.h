@@ -64,6 +64,24 @@ public:
                          ConstitutiveIOBase* rNewTangent,
                          Constitutive::StaticData::DataMisesPlasticity<3>* rNewStaticData) const;
 
+    //! @brief Checks whether the trial stress lies within the yield surface, then the tangent is the elastic one.
+    //! @param rEngineeringStrain Engineering strain.
+    //! @return true, if the return mapping would remain in the elastic regime
+    bool IsElastic3D(const Constitutive::StaticData::DataMisesPlasticity<3>& oldStaticData,
+                     const EngineeringStrain<3>& rEngineeringStrain) const;
+
+    //! @brief Calculates the trial state of the return mapping in 3D, shared by ReturnMapping3D and IsElastic3D.
+    //! @param rEngineeringStrain Engineering strain.
+    //! @param rSigmaTrial Deviatoric trial stress.
+    //! @param rXiTrial Deviatoric trial stress minus the back stress.
+    //! @param rNormDev Norm of rXiTrial.
+    //! @param rSigmaY Yield strength and its derivative rDSigma at the old equivalent plastic strain.
+    //! @param rYieldCondition Value of the yield function.
+    //! @return true, if the trial stress lies within the yield surface
+    bool TrialState3D(const Constitutive::StaticData::DataMisesPlasticity<3>& oldStaticData,
+                      const EngineeringStrain<3>& rEngineeringStrain, double rSigmaTrial[6], double rXiTrial[6],
+                      double& rNormDev, double& rSigmaY, double& rDSigma, double& rYieldCondition) const;
+
     // parameters /////////////////////////////////////////////////////////////
 
     //! @brief ... gets a parameter of the constitutive law which is selected by an enum
@@ -121,6 +139,12 @@ public:
         return false;
     }
 
+    //! @brief ... the elastic tangent is constant, see ConstitutiveBase::HasTangentState
+    bool HasTangentState() const override
+    {
+        return true;
+    }
+
 protected:
     //! @brief ... Young's modulus \f$ E \f$
     double mE;
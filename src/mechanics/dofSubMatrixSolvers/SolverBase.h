@@ -4,16 +4,144 @@
 
 #pragma once
 
+#include "base/Exception.h"
 #include "mechanics/dofSubMatrixStorage/BlockSparseMatrix.h"
 #include "mechanics/dofSubMatrixStorage/BlockFullVector.h"
 
 namespace NuTo
 {
+//! @brief solver for block sparse systems of equations
+//! @remark The solver keeps the symbolic analysis (ordering, symbolic factorization) and the numerical factorization
+//! of the last matrix. The revision of the compressed sparsity pattern decides whether the analysis is still valid, the
+//! revision of the values whether the factorization is (BlockSparseMatrix::GetCompressedPatternRevision,
+//! BlockSparseMatrix::GetValueRevision). Thus, repeated solutions with the same matrix, e.g. linear problems with a
+//! constant time step, factorize once, and matrices with the same pattern, e.g. in Newton iterations, skip the
+//! ordering.
 class SolverBase
 {
 public:
     virtual ~SolverBase() = default;
 
-    virtual BlockFullVector<double> Solve(const BlockSparseMatrix& rMatrix, const BlockFullVector<double>& rVector) = 0;
+    //! @brief solves rMatrix * x = rVector, reuses the analysis and the factorization where possible
+    virtual BlockFullVector<double> Solve(const BlockSparseMatrix& rMatrix, const BlockFullVector<double>& rVector)
+    {
+        Factorize(rMatrix);
+        return SolveFactorized(rVector);
+    }
+
+    //! @brief factorizes rMatrix, the analysis is only repeated if the sparsity pattern changed and the numerical
+    //! factorization only if the matrix was modified
+    void Factorize(const BlockSparseMatrix& rMatrix)
+    {
+        Compress(rMatrix);
+        const unsigned long patternRevision = rMatrix.GetCompressedPatternRevision();
+        const unsigned long valueRevision = rMatrix.GetValueRevision();
+        if (not mIsAnalyzed or patternRevision != mPatternRevision)
+        {
+            mIsAnalyzed = false;
+            mIsFactorized = false;
+            AnalyzePattern();
+            mIsAnalyzed = true;
+            mPatternRevision = patternRevision;
+            ++mNumAnalyses;
+        }
+        if (mIsFactorized and valueRevision == mValueRevision)
+            return;
+
+        mIsFactorized = false;
+        FactorizeValues();
+        mIsFactorized = true;
+        mValueRevision = valueRevision;
+        ++mNumFactorizations;
+    }
+
+    //! @brief solves with the factorization of the last call to Factorize
+    BlockFullVector<double> SolveFactorized(const BlockFullVector<double>& rVector)
+    {
+        if (not IsFactorized())
+            throw Exception(__PRETTY_FUNCTION__, "Factorize a matrix first.");
+        return BlockFullVector<double>(SolveFactorized(rVector.Export()), rVector.GetDofStatus());
+    }
+
+    //! @brief SolveFactorized for the vector of all active dofs, e.g. for the refinement in SolverMixedPrecision
+    Eigen::VectorXd SolveFactorized(const Eigen::VectorXd& rVector)
+    {
+        if (not IsFactorized())
+            throw Exception(__PRETTY_FUNCTION__, "Factorize a matrix first.");
+        return SolveWithFactorization(rVector);
+    }
+
+    bool IsFactorized() const
+    {
+        return mIsAnalyzed and mIsFactorized;
+    }
+
+    //! @brief discards the analysis and the factorization, e.g. to release memory
+    void Reset()
+    {
+        mIsAnalyzed = false;
+        mIsFactorized = false;
+    }
+
+    //! @brief tolerance of the residual of rDof that is required by the caller, e.g. a Newton scheme
+    //! @remark Direct solvers ignore it, iterative solvers stop as soon as the residual of the linear system satisfies
+    //! it, see SolverIterative.
+    virtual void SetToleranceResidual(Node::eDof, double)
+    {
+    }
+
+    //! @brief number of iterations of the last solution, e.g. of SolverIterative or the refinement of
+    //! SolverMixedPrecision, 0 for direct solvers
+    virtual int GetNumIterations() const
+    {
+        return 0;
+    }
+
+    //! @brief number of symbolic analyses since the construction of the solver
+    int GetNumAnalyses() const
+    {
+        return mNumAnalyses;
+    }
+
+    //! @brief number of numerical factorizations since the construction of the solver
+    int GetNumFactorizations() const
+    {
+        return mNumFactorizations;
+    }
+
+protected:
+    //! @brief compressed row storage arrays of a matrix in the format of a solver
+    struct CompressedMatrix
+    {
+        int mNumRows;
+        int mNumEntries;
+        const int* mRowIndex;
+        const int* mColumns;
+        const double* mValues;
+    };
+
+    //! @brief converts rMatrix to the format of the solver, the following calls of AnalyzePattern and FactorizeValues
+    //! refer to this matrix
+    virtual CompressedMatrix Compress(const BlockSparseMatrix& rMatrix) = 0;
+
+    //! @brief ordering and symbolic factorization of the compressed matrix
+    virtual void AnalyzePattern() = 0;
+
+    //! @brief numerical factorization of the compressed matrix, called after AnalyzePattern for the same pattern
+    virtual void FactorizeValues() = 0;
+
+    //! @brief solution with the current numerical factorization
+    virtual Eigen::VectorXd SolveWithFactorization(const Eigen::VectorXd& rRhs) = 0;
+
+private:
+    bool mIsAnalyzed = false;
+    bool mIsFactorized = false;
+
+    //! @brief revisions of the pattern and the values of the analyzed and factorized matrix
+    unsigned long mPatternRevision = 0;
+    unsigned long mValueRevision = 0;
+
+    int mNumAnalyses = 0;
+    int mNumFactorizations = 0;
 };
 } // namespace NuTo
@@ -16,13 +16,41 @@ public:
         : SolverBase()
     {
     }
-    virtual BlockFullVector<double> Solve(const BlockSparseMatrix& rMatrix,
-                                          const BlockFullVector<double>& rVector) override
+
+protected:
+    CompressedMatrix Compress(const BlockSparseMatrix& rMatrix) override
+    {
+        const auto view = rMatrix.GetEigenSparseMatrixView();
+        mMatrix = {static_cast<int>(view.rows()), static_cast<int>(view.nonZeros()), view.outerIndexPtr(),
+                   view.innerIndexPtr(), view.valuePtr()};
+        return mMatrix;
+    }
+
+    void AnalyzePattern() override
+    {
+        mSolver.analyzePattern(GetView());
+    }
+
+    void FactorizeValues() override
     {
-        Eigen::VectorXd result;
-        Solver solver;
-        solver.compute(rMatrix.ExportToEigenSparseMatrix());
-        return BlockFullVector<double>(solver.solve(rVector.Export()), rMatrix.GetDofStatus());
+        mSolver.factorize(GetView());
+        if (mSolver.info() != Eigen::Success)
+            throw Exception(__PRETTY_FUNCTION__, "Numerical factorization failed.");
     }
+
+    Eigen::VectorXd SolveWithFactorization(const Eigen::VectorXd& rRhs) override
+    {
+        return mSolver.solve(rRhs);
+    }
+
+private:
+    BlockSparseMatrix::EigenSparseMatrixView GetView() const
+    {
+        return BlockSparseMatrix::EigenSparseMatrixView(mMatrix.mNumRows, mMatrix.mNumRows, mMatrix.mNumEntries,
+                                                        mMatrix.mRowIndex, mMatrix.mColumns, mMatrix.mValues);
+    }
+
+    Solver mSolver;
+    CompressedMatrix mMatrix;
 };
 } // namespace NuTo
@@ -0,0 +1,21 @@
+#include "mechanics/dofSubMatrixSolvers/SolverFGMRES.h"
+
+#include <cmath>
+
+using namespace NuTo;
+
+bool SolverFGMRES::Iterate(const Eigen::VectorXd& rRhs, Eigen::VectorXd& rSolution, int& rNumIterations)
+{
+    // GcroDr minimizes the 2-norm of the residual, which bounds the inf norms of the residual tolerances
+    const double rhsNorm = std::sqrt(Dot(rRhs, rRhs));
+    mGcroDr.SetTolerance(rhsNorm > 0. ? GetResidualNormTolerance(rhsNorm) / rhsNorm : 0.);
+    mGcroDr.SetMaxNumIterations(GetMaxNumIterations());
+
+    auto multiply = [this](const Eigen::VectorXd& rVector, Eigen::VectorXd& rResult) { Multiply(rVector, rResult); };
+    auto precondition = [this](const Eigen::VectorXd& rVector, Eigen::VectorXd& rResult) {
+        Precondition(rVector, rResult);
+    };
+    const bool isConverged = mGcroDr.Solve(GcroDr::Operator(multiply), GcroDr::Operator(precondition), rRhs, rSolution);
+    rNumIterations = mGcroDr.GetNumIterations();
+    return isConverged;
+}
@@ -0,0 +1,43 @@
+#pragma once
+
+#include "math/GcroDr.h"
+#include "mechanics/dofSubMatrixSolvers/SolverIterative.h"
+
+namespace NuTo
+{
+//! @brief flexible GMRES with Krylov subspace recycling for nonsymmetric block sparse systems, e.g. the tangent of
+//! gradient damage models
+//! @remark The recycled subspace, see GcroDr, is kept between the solutions. Thus, the same solver in consecutive
+//! systems that change only slightly, e.g. the Newton iterations and time steps of NewmarkDirect, converges in
+//! fewer iterations. The preconditioner does not have to be symmetric.
+class SolverFGMRES : public SolverIterative
+{
+public:
+    //! @param rKrylovDimension ... maximum number of basis vectors per restart cycle, including the recycled ones
+    //! @param rNumRecycledVectors ... dimension of the recycled subspace, 0 for FGMRES without recycling
+    SolverFGMRES(ePreconditioner rPreconditioner = ePreconditioner::JACOBI, int rKrylovDimension = 40,
+                 int rNumRecycledVectors = 10)
+        : SolverIterative(rPreconditioner)
+        , mGcroDr(rKrylovDimension, rNumRecycledVectors)
+    {
+    }
+
+    //! @brief discards the recycled subspace, e.g. if the next system is unrelated to the previous ones
+    void ClearRecycledSubspace()
+    {
+        mGcroDr.ClearRecycledSubspace();
+    }
+
+    //! @brief current dimension of the recycled subspace
+    int GetNumRecycledVectors() const
+    {
+        return mGcroDr.GetNumRecycledVectors();
+    }
+
+protected:
+    bool Iterate(const Eigen::VectorXd& rRhs, Eigen::VectorXd& rSolution, int& rNumIterations) override;
+
+private:
+    GcroDr mGcroDr;
+};
+} // namespace NuTo
@@ -0,0 +1,627 @@
+#include "mechanics/dofSubMatrixSolvers/SolverIterative.h"
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <utility>
+#include <Eigen/LU>
+
+#include "math/SparseMatrixCSRVector2.h"
+#include "math/SparseMatrixProduct.h"
+#include "mechanics/dofSubMatrixSolvers/SolverPCG.h"
+#include "mechanics/nodes/NodeEnum.h"
+
+using namespace NuTo;
+
+void SolverIterative::SetBlockSize(int rBlockSize)
+{
+    if (rBlockSize < 1)
+        throw Exception(__PRETTY_FUNCTION__, "The block size has to be positive.");
+    mBlockSize = rBlockSize;
+    Reset();
+}
+
+void SolverIterative::SetRelaxation(double rRelaxation)
+{
+    if (rRelaxation <= 0. or rRelaxation >= 2.)
+        throw Exception(__PRETTY_FUNCTION__, "The relaxation parameter has to be in (0, 2).");
+    mRelaxation = rRelaxation;
+    Reset();
+}
+
+void SolverIterative::SetFieldPreconditioner(Node::eDof rDof, ePreconditioner rPreconditioner)
+{
+    if (rPreconditioner == ePreconditioner::FIELD_SPLIT)
+        throw Exception(__PRETTY_FUNCTION__, "The preconditioner of a dof type cannot be a field split.");
+    mFieldPreconditioners[rDof] = rPreconditioner;
+    Reset();
+}
+
+SolverBase::CompressedMatrix SolverIterative::Compress(const BlockSparseMatrix& rMatrix)
+{
+    const auto view = rMatrix.GetEigenSparseMatrixView();
+    mMatrix = {static_cast<int>(view.rows()), static_cast<int>(view.nonZeros()), view.outerIndexPtr(),
+               view.innerIndexPtr(), view.valuePtr()};
+
+    mDofRanges.clear();
+    int begin = 0;
+    for (auto dof : rMatrix.GetDofStatus().GetActiveDofTypes())
+    {
+        const int size = rMatrix(dof, dof).GetNumRows();
+        mDofRanges.push_back({dof, begin, size});
+        begin += size;
+    }
+    return mMatrix;
+}
+
+void SolverIterative::AnalyzePattern()
+{
+    const int numRows = mMatrix.mNumRows;
+    mDiagonal.assign(numRows, -1);
+    for (int row = 0; row < numRows; ++row)
+        for (int pos = mMatrix.mRowIndex[row]; pos < mMatrix.mRowIndex[row + 1]; ++pos)
+            if (mMatrix.mColumns[pos] == row)
+                mDiagonal[row] = pos;
+
+    if (mPreconditioner != ePreconditioner::NONE and
+        std::find(mDiagonal.begin(), mDiagonal.end(), -1) != mDiagonal.end())
+        throw Exception(__PRETTY_FUNCTION__, "The preconditioner requires all diagonal entries.");
+
+    switch (mPreconditioner)
+    {
+    case ePreconditioner::BLOCK_JACOBI:
+    {
+        // blocks of consecutive rows within the dof types
+        mBlockBegin.clear();
+        mBlockValueBegin.assign(1, 0);
+        for (const DofRange& range : mDofRanges)
+            for (int row = range.mBegin; row < range.mBegin + range.mSize; row += mBlockSize)
+            {
+                const int size = std::min(mBlockSize, range.mBegin + range.mSize - row);
+                mBlockBegin.push_back(row);
+                mBlockValueBegin.push_back(mBlockValueBegin.back() + size * size);
+            }
+        mBlockBegin.push_back(numRows);
+        break;
+    }
+    case ePreconditioner::INCOMPLETE_CHOLESKY:
+    {
+        // lower triangle with sorted columns, the diagonal is the last entry of a row
+        mFactorRowIndex.assign(1, 0);
+        mFactorColumns.clear();
+        mFactorSource.clear();
+        std::vector<std::pair<int, int>> entries;
+        for (int row = 0; row < numRows; ++row)
+        {
+            entries.clear();
+            for (int pos = mMatrix.mRowIndex[row]; pos < mMatrix.mRowIndex[row + 1]; ++pos)
+                if (mMatrix.mColumns[pos] <= row)
+                    entries.emplace_back(mMatrix.mColumns[pos], pos);
+            std::sort(entries.begin(), entries.end());
+            for (const auto& entry : entries)
+            {
+                mFactorColumns.push_back(entry.first);
+                mFactorSource.push_back(entry.second);
+            }
+            mFactorRowIndex.push_back(mFactorColumns.size());
+        }
+        mFactorValues.resize(mFactorColumns.size());
+        break;
+    }
+    case ePreconditioner::FIELD_SPLIT:
+        AnalyzeFields();
+        break;
+    default:
+        break;
+    }
+}
+
+void SolverIterative::AnalyzeFields()
+{
+    if (mFieldSplit == eFieldSplit::SCHUR_COMPLEMENT and mDofRanges.size() != 2)
+        throw Exception(__PRETTY_FUNCTION__, "The Schur complement requires exactly two active dof types.");
+    if (mNearNullSpace.mModes.size() != 0 and
+        (mNearNullSpace.mModes.rows() != mMatrix.mNumRows or
+         static_cast<int>(mNearNullSpace.mNodes.size()) != mMatrix.mNumRows))
+        throw Exception(__PRETTY_FUNCTION__, "The near null space does not match the matrix.");
+
+    mFields.clear();
+    mFields.resize(mDofRanges.size());
+    for (std::size_t i = 0; i < mDofRanges.size(); ++i)
+    {
+        const DofRange& range = mDofRanges[i];
+        const int end = range.mBegin + range.mSize;
+        Field& field = mFields[i];
+        field.mRange = range;
+        field.mRowIndex.assign(1, 0);
+        for (int row = range.mBegin; row < end; ++row)
+        {
+            for (int pos = mMatrix.mRowIndex[row]; pos < mMatrix.mRowIndex[row + 1]; ++pos)
+                if (mMatrix.mColumns[pos] >= range.mBegin and mMatrix.mColumns[pos] < end)
+                {
+                    field.mColumns.push_back(mMatrix.mColumns[pos] - range.mBegin);
+                    field.mSource.push_back(pos);
+                }
+            field.mRowIndex.push_back(field.mColumns.size());
+        }
+        field.mValues.resize(field.mColumns.size());
+
+        const auto preconditioner = mFieldPreconditioners.find(range.mDof);
+        if (preconditioner != mFieldPreconditioners.end())
+            field.mSolver = std::make_unique<SolverPCG>(preconditioner->second);
+        else if (range.mDof == Node::eDof::DISPLACEMENTS)
+            field.mSolver = std::make_unique<SolverPCG>(ePreconditioner::ALGEBRAIC_MULTIGRID);
+        else
+            field.mSolver = std::make_unique<SolverPCG>(ePreconditioner::INCOMPLETE_CHOLESKY);
+
+        SolverIterative& solver = *field.mSolver;
+        solver.mBlockSize = mBlockSize;
+        solver.mRelaxation = mRelaxation;
+        solver.mMultigrid = mMultigrid;
+        solver.mDofRanges = {{range.mDof, 0, range.mSize}};
+        solver.mMatrix = {range.mSize, static_cast<int>(field.mValues.size()), field.mRowIndex.data(),
+                          field.mColumns.data(), field.mValues.data()};
+
+        if (mNearNullSpace.mModes.size() != 0)
+        {
+            // modes that vanish on this dof type, e.g. the rotations for a scalar field, are dropped
+            const Eigen::MatrixXd modes = mNearNullSpace.mModes.middleRows(range.mBegin, range.mSize);
+            std::vector<int> columns;
+            for (int column = 0; column < modes.cols(); ++column)
+                if (modes.col(column).squaredNorm() > 0.)
+                    columns.push_back(column);
+            solver.mNearNullSpace.mModes.resize(range.mSize, columns.size());
+            for (std::size_t column = 0; column < columns.size(); ++column)
+                solver.mNearNullSpace.mModes.col(column) = modes.col(columns[column]);
+            solver.mNearNullSpace.mNodes.assign(mNearNullSpace.mNodes.begin() + range.mBegin,
+                                                mNearNullSpace.mNodes.begin() + end);
+        }
+
+        // the pattern of the Schur complement depends on the values, see FactorizeFields
+        if (mFieldSplit != eFieldSplit::SCHUR_COMPLEMENT or i == 0)
+            solver.AnalyzePattern();
+    }
+}
+
+void SolverIterative::FactorizeValues()
+{
+    const int numRows = mMatrix.mNumRows;
+    switch (mPreconditioner)
+    {
+    case ePreconditioner::JACOBI:
+    case ePreconditioner::SSOR:
+    {
+        mDiagonalValues.resize(numRows);
+        for (int row = 0; row < numRows; ++row)
+        {
+            const double diagonal = mMatrix.mValues[mDiagonal[row]];
+            if (mPreconditioner == ePreconditioner::JACOBI and diagonal != 0.)
+                mDiagonalValues[row] = 1. / std::abs(diagonal);
+            else if (mPreconditioner == ePreconditioner::SSOR and diagonal > 0.)
+                mDiagonalValues[row] = diagonal;
+            else
+                throw Exception(__PRETTY_FUNCTION__, "Invalid diagonal entry in row " + std::to_string(row) + ".");
+        }
+        break;
+    }
+    case ePreconditioner::BLOCK_JACOBI:
+    {
+        const int numBlocks = mBlockBegin.size() - 1;
+        mInverseBlocks.resize(mBlockValueBegin.back());
+        bool isInvertible = true;
+#ifdef _OPENMP
+#pragma omp parallel for schedule(static) reduction(&& : isInvertible) \
+        if (numRows > SparseMatrixProduct::minRowsPerThread)
+#endif
+        for (int block = 0; block < numBlocks; ++block)
+        {
+            const int begin = mBlockBegin[block];
+            const int size = mBlockBegin[block + 1] - begin;
+            Eigen::MatrixXd values = Eigen::MatrixXd::Zero(size, size);
+            for (int row = begin; row < begin + size; ++row)
+                for (int pos = mMatrix.mRowIndex[row]; pos < mMatrix.mRowIndex[row + 1]; ++pos)
+                {
+                    const int column = mMatrix.mColumns[pos];
+                    if (column >= begin and column < begin + size)
+                        values(row - begin, column - begin) = mMatrix.mValues[pos];
+                }
+            const Eigen::FullPivLU<Eigen::MatrixXd> lu(values);
+            if (not lu.isInvertible())
+                isInvertible = false;
+            Eigen::Map<Eigen::MatrixXd>(mInverseBlocks.data() + mBlockValueBegin[block], size, size) = lu.inverse();
+        }
+        if (not isInvertible)
+            throw Exception(__PRETTY_FUNCTION__, "Singular diagonal block.");
+        break;
+    }
+    case ePreconditioner::ALGEBRAIC_MULTIGRID:
+    {
+        // the hierarchy depends on the values, the multigrid keeps a copy of the finest matrix
+        mMultigrid.SetNearNullSpace(mNearNullSpace);
+        mMultigrid.Compute(Eigen::Map<const SmoothedAggregationAMG::Matrix>(
+                numRows, numRows, mMatrix.mNumEntries, mMatrix.mRowIndex, mMatrix.mColumns, mMatrix.mValues));
+        break;
+    }
+    case ePreconditioner::INCOMPLETE_CHOLESKY:
+    {
+        // IC(0) may break down for matrices that are not M-matrices, the diagonal is then shifted until all pivots
+        // are positive
+        double shift = 0.;
+        while (not IncompleteCholesky(shift))
+        {
+            shift = shift == 0. ? 1.e-3 : 2. * shift;
+            if (shift > 1.)
+                throw Exception(__PRETTY_FUNCTION__, "Incomplete Cholesky factorization failed. Is the matrix "
+                                                     "positive definite?");
+        }
+        break;
+    }
+    case ePreconditioner::FIELD_SPLIT:
+        FactorizeFields();
+        break;
+    default:
+        break;
+    }
+}
+
+void SolverIterative::FactorizeFields()
+{
+    for (Field& field : mFields)
+        for (std::size_t i = 0; i < field.mValues.size(); ++i)
+            field.mValues[i] = mMatrix.mValues[field.mSource[i]];
+
+    if (mFieldSplit == eFieldSplit::SCHUR_COMPLEMENT)
+    {
+        // S = A_22 - A_21 diag(A_11)^-1 A_12
+        const DofRange& first = mFields[0].mRange;
+        const DofRange& second = mFields[1].mRange;
+        Eigen::VectorXd inverseDiagonal(first.mSize);
+        for (int row = 0; row < first.mSize; ++row)
+        {
+            const double diagonal = mMatrix.mValues[mDiagonal[first.mBegin + row]];
+            if (diagonal == 0.)
+                throw Exception(__PRETTY_FUNCTION__, "Zero diagonal entry in row " + std::to_string(row) + ".");
+            inverseDiagonal[row] = 1. / diagonal;
+        }
+
+        std::vector<Eigen::Triplet<double>> entries12, entries21;
+        for (int row = first.mBegin; row < first.mBegin + first.mSize; ++row)
+            for (int pos = mMatrix.mRowIndex[row]; pos < mMatrix.mRowIndex[row + 1]; ++pos)
+                if (mMatrix.mColumns[pos] >= second.mBegin)
+                    entries12.emplace_back(row - first.mBegin, mMatrix.mColumns[pos] - second.mBegin,
+                                           mMatrix.mValues[pos]);
+        for (int row = second.mBegin; row < second.mBegin + second.mSize; ++row)
+            for (int pos = mMatrix.mRowIndex[row]; pos < mMatrix.mRowIndex[row + 1]; ++pos)
+                if (mMatrix.mColumns[pos] < second.mBegin)
+                    entries21.emplace_back(row - second.mBegin, mMatrix.mColumns[pos] - first.mBegin,
+                                           mMatrix.mValues[pos]);
+        SmoothedAggregationAMG::Matrix a12(first.mSize, second.mSize), a21(second.mSize, first.mSize);
+        a12.setFromTriplets(entries12.begin(), entries12.end());
+        a21.setFromTriplets(entries21.begin(), entries21.end());
+
+        const Field& field = mFields[1];
+        const Eigen::Map<const SmoothedAggregationAMG::Matrix> a22(
+                second.mSize, second.mSize, field.mValues.size(), field.mRowIndex.data(), field.mColumns.data(),
+                field.mValues.data());
+        const SmoothedAggregationAMG::Matrix coupling = a21 * inverseDiagonal.asDiagonal();
+        const SmoothedAggregationAMG::Matrix correction = coupling * a12;
+        mSchurComplement = a22 - correction;
+        mSchurComplement.makeCompressed();
+
+        SolverIterative& solver = *field.mSolver;
+        solver.mMatrix = {second.mSize, static_cast<int>(mSchurComplement.nonZeros()),
+                          mSchurComplement.outerIndexPtr(), mSchurComplement.innerIndexPtr(),
+                          mSchurComplement.valuePtr()};
+        solver.AnalyzePattern();
+    }
+
+    for (Field& field : mFields)
+        field.mSolver->FactorizeValues();
+}
+
+bool SolverIterative::IncompleteCholesky(double rShift)
+{
+    const int numRows = mMatrix.mNumRows;
+    for (std::size_t i = 0; i < mFactorValues.size(); ++i)
+        mFactorValues[i] = mMatrix.mValues[mFactorSource[i]];
+
+    for (int row = 0; row < numRows; ++row)
+    {
+        const int rowBegin = mFactorRowIndex[row];
+        const int diagonalPos = mFactorRowIndex[row + 1] - 1;
+        for (int pos = rowBegin; pos < diagonalPos; ++pos)
+        {
+            // L(row, column) = (A(row, column) - sum_k L(row, k) L(column, k)) / L(column, column), k < column
+            const int column = mFactorColumns[pos];
+            const int otherEnd = mFactorRowIndex[column + 1] - 1;
+            double sum = 0.;
+            for (int i = rowBegin, j = mFactorRowIndex[column]; i < pos and j < otherEnd;)
+            {
+                if (mFactorColumns[i] < mFactorColumns[j])
+                    ++i;
+                else if (mFactorColumns[i] > mFactorColumns[j])
+                    ++j;
+                else
+                    sum += mFactorValues[i++] * mFactorValues[j++];
+            }
+            mFactorValues[pos] = (mFactorValues[pos] - sum) / mFactorValues[otherEnd];
+        }
+
+        double pivot = (1. + rShift) * mFactorValues[diagonalPos];
+        for (int pos = rowBegin; pos < diagonalPos; ++pos)
+            pivot -= mFactorValues[pos] * mFactorValues[pos];
+        if (not(pivot > 0.))
+            return false;
+        mFactorValues[diagonalPos] = std::sqrt(pivot);
+    }
+    return true;
+}
+
+Eigen::VectorXd SolverIterative::SolveWithFactorization(const Eigen::VectorXd& rRhs)
+{
+    Eigen::VectorXd solution = Eigen::VectorXd::Zero(rRhs.rows());
+    if (not Iterate(rRhs, solution, mNumIterations))
+        throw Exception(__PRETTY_FUNCTION__,
+                        "No convergence within " + std::to_string(mMaxNumIterations) + " iterations.");
+    return solution;
+}
+
+void SolverIterative::Multiply(const Eigen::VectorXd& rVector, Eigen::VectorXd& rResult) const
+{
+    const int numRows = mMatrix.mNumRows;
+    rResult.resize(numRows);
+    const int* rowIndex = mMatrix.mRowIndex;
+    const int* columns = mMatrix.mColumns;
+    const double* values = mMatrix.mValues;
+    const double* vector = rVector.data();
+    double* result = rResult.data();
+#ifdef _OPENMP
+#pragma omp parallel for schedule(static) if (numRows > SparseMatrixProduct::minRowsPerThread)
+#endif
+    for (int row = 0; row < numRows; ++row)
+    {
+        double sum = 0.;
+        for (int pos = rowIndex[row]; pos < rowIndex[row + 1]; ++pos)
+            sum += values[pos] * vector[columns[pos]];
+        result[row] = sum;
+    }
+}
+
+void SolverIterative::Precondition(const Eigen::VectorXd& rVector, Eigen::VectorXd& rResult) const
+{
+    const int numRows = rVector.rows();
+    rResult.resize(numRows);
+    switch (mPreconditioner)
+    {
+    case ePreconditioner::NONE:
+        rResult = rVector;
+        break;
+    case ePreconditioner::JACOBI:
+#ifdef _OPENMP
+#pragma omp parallel for schedule(static) if (numRows > SparseMatrixProduct::minRowsPerThread)
+#endif
+        for (int row = 0; row < numRows; ++row)
+            rResult[row] = mDiagonalValues[row] * rVector[row];
+        break;
+    case ePreconditioner::BLOCK_JACOBI:
+        ApplyBlockJacobi(rVector, rResult);
+        break;
+    case ePreconditioner::SSOR:
+        ApplySSOR(rVector, rResult);
+        break;
+    case ePreconditioner::INCOMPLETE_CHOLESKY:
+        ApplyIncompleteCholesky(rVector, rResult);
+        break;
+    case ePreconditioner::ALGEBRAIC_MULTIGRID:
+        mMultigrid.Apply(rVector, rResult);
+        break;
+    case ePreconditioner::FIELD_SPLIT:
+        ApplyFieldSplit(rVector, rResult);
+        break;
+    }
+}
+
+void SolverIterative::ApplyBlockJacobi(const Eigen::VectorXd& rVector, Eigen::VectorXd& rResult) const
+{
+    const int numBlocks = mBlockBegin.size() - 1;
+#ifdef _OPENMP
+#pragma omp parallel for schedule(static) if (rVector.rows() > SparseMatrixProduct::minRowsPerThread)
+#endif
+    for (int block = 0; block < numBlocks; ++block)
+    {
+        const int begin = mBlockBegin[block];
+        const int size = mBlockBegin[block + 1] - begin;
+        const Eigen::Map<const Eigen::MatrixXd> inverse(mInverseBlocks.data() + mBlockValueBegin[block], size, size);
+        rResult.segment(begin, size).noalias() = inverse * rVector.segment(begin, size);
+    }
+}
+
+void SolverIterative::ApplySSOR(const Eigen::VectorXd& rVector, Eigen::VectorXd& rResult) const
+{
+    // M = (D + wL) D^-1 (D + wU) / (w (2 - w))
+    const int numRows = mMatrix.mNumRows;
+    const double w = mRelaxation;
+    const int* rowIndex = mMatrix.mRowIndex;
+    const int* columns = mMatrix.mColumns;
+    const double* values = mMatrix.mValues;
+
+    // (D + wL) y = v, then D y
+    for (int row = 0; row < numRows; ++row)
+    {
+        double sum = 0.;
+        for (int pos = rowIndex[row]; pos < rowIndex[row + 1]; ++pos)
+            if (columns[pos] < row)
+                sum += values[pos] * rResult[columns[pos]];
+        rResult[row] = (rVector[row] - w * sum) / mDiagonalValues[row];
+    }
+    rResult = rResult.cwiseProduct(mDiagonalValues);
+
+    // (D + wU) z = D y
+    for (int row = numRows - 1; row >= 0; --row)
+    {
+        double sum = 0.;
+        for (int pos = rowIndex[row]; pos < rowIndex[row + 1]; ++pos)
+            if (columns[pos] > row)
+                sum += values[pos] * rResult[columns[pos]];
+        rResult[row] = (rResult[row] - w * sum) / mDiagonalValues[row];
+    }
+    rResult *= w * (2. - w);
+}
+
+void SolverIterative::ApplyIncompleteCholesky(const Eigen::VectorXd& rVector, Eigen::VectorXd& rResult) const
+{
+    const int numRows = mMatrix.mNumRows;
+
+    // L y = v
+    for (int row = 0; row < numRows; ++row)
+    {
+        const int diagonalPos = mFactorRowIndex[row + 1] - 1;
+        double sum = rVector[row];
+        for (int pos = mFactorRowIndex[row]; pos < diagonalPos; ++pos)
+            sum -= mFactorValues[pos] * rResult[mFactorColumns[pos]];
+        rResult[row] = sum / mFactorValues[diagonalPos];
+    }
+
+    // L^T z = y, column oriented
+    for (int row = numRows - 1; row >= 0; --row)
+    {
+        const int diagonalPos = mFactorRowIndex[row + 1] - 1;
+        rResult[row] /= mFactorValues[diagonalPos];
+        for (int pos = mFactorRowIndex[row]; pos < diagonalPos; ++pos)
+            rResult[mFactorColumns[pos]] -= mFactorValues[pos] * rResult[row];
+    }
+}
+
+void SolverIterative::ApplyFieldSplit(const Eigen::VectorXd& rVector, Eigen::VectorXd& rResult) const
+{
+    Eigen::VectorXd product, correction;
+    switch (mFieldSplit)
+    {
+    case eFieldSplit::ADDITIVE:
+        for (const Field& field : mFields)
+        {
+            field.mSolver->Precondition(rVector.segment(field.mRange.mBegin, field.mRange.mSize), correction);
+            rResult.segment(field.mRange.mBegin, field.mRange.mSize) = correction;
+        }
+        break;
+    case eFieldSplit::SYMMETRIC_MULTIPLICATIVE:
+    {
+        // z_i += B_i (r - A z)_i for i = 1 ... n, n - 1 ... 1
+        rResult.setZero();
+        auto update = [&](const Field& rField) {
+            const int begin = rField.mRange.mBegin;
+            const int size = rField.mRange.mSize;
+            MultiplyRows(rResult, begin, size, product);
+            rField.mSolver->Precondition(rVector.segment(begin, size) - product, correction);
+            rResult.segment(begin, size) += correction;
+        };
+        for (const Field& field : mFields)
+            update(field);
+        for (int i = static_cast<int>(mFields.size()) - 2; i >= 0; --i)
+            update(mFields[i]);
+        break;
+    }
+    case eFieldSplit::SCHUR_COMPLEMENT:
+    {
+        // [I  -B_1 A_12] [B_1  0] [I          0]
+        // [0   I       ] [0  B_S] [-A_21 B_1  I]
+        const DofRange& first = mFields[0].mRange;
+        const DofRange& second = mFields[1].mRange;
+        Eigen::VectorXd y1;
+        mFields[0].mSolver->Precondition(rVector.segment(first.mBegin, first.mSize), y1);
+        rResult.setZero();
+        rResult.segment(first.mBegin, first.mSize) = y1;
+        MultiplyRows(rResult, second.mBegin, second.mSize, product);
+        mFields[1].mSolver->Precondition(rVector.segment(second.mBegin, second.mSize) - product, correction);
+
+        rResult.segment(first.mBegin, first.mSize).setZero();
+        rResult.segment(second.mBegin, second.mSize) = correction;
+        MultiplyRows(rResult, first.mBegin, first.mSize, product);
+        mFields[0].mSolver->Precondition(product, correction);
+        rResult.segment(first.mBegin, first.mSize) = y1 - correction;
+        break;
+    }
+    }
+}
+
+void SolverIterative::MultiplyRows(const Eigen::VectorXd& rVector, int rBegin, int rSize,
+                                   Eigen::VectorXd& rResult) const
+{
+    rResult.resize(rSize);
+    const int* rowIndex = mMatrix.mRowIndex;
+    const int* columns = mMatrix.mColumns;
+    const double* values = mMatrix.mValues;
+#ifdef _OPENMP
+#pragma omp parallel for schedule(static) if (rSize > SparseMatrixProduct::minRowsPerThread)
+#endif
+    for (int row = 0; row < rSize; ++row)
+    {
+        double sum = 0.;
+        for (int pos = rowIndex[rBegin + row]; pos < rowIndex[rBegin + row + 1]; ++pos)
+            sum += values[pos] * rVector[columns[pos]];
+        rResult[row] = sum;
+    }
+}
+
+bool SolverIterative::IsConverged(const Eigen::VectorXd& rResidual, double rRhsNorm) const
+{
+    if (std::sqrt(Dot(rResidual, rResidual)) <= mTolerance * rRhsNorm)
+        return true;
+    if (mToleranceResidual.empty())
+        return false;
+
+    for (const DofRange& range : mDofRanges)
+    {
+        const auto tolerance = mToleranceResidual.find(range.mDof);
+        if (tolerance == mToleranceResidual.end())
+            return false;
+        if (range.mSize > 0 and
+            rResidual.segment(range.mBegin, range.mSize).lpNorm<Eigen::Infinity>() >
+                    mToleranceResidualFactor * tolerance->second)
+            return false;
+    }
+    return true;
+}
+
+double SolverIterative::GetResidualNormTolerance(double rRhsNorm) const
+{
+    // |r_dof|_inf <= |r|
+    const double tolerance = mTolerance * rRhsNorm;
+    if (mToleranceResidual.empty())
+        return tolerance;
+    double toleranceResidual = std::numeric_limits<double>::max();
+    for (const DofRange& range : mDofRanges)
+    {
+        const auto dofTolerance = mToleranceResidual.find(range.mDof);
+        if (dofTolerance == mToleranceResidual.end())
+            return tolerance;
+        toleranceResidual = std::min(toleranceResidual, mToleranceResidualFactor * dofTolerance->second);
+    }
+    return std::max(tolerance, toleranceResidual);
+}
+
+double SolverIterative::Dot(const Eigen::VectorXd& rA, const Eigen::VectorXd& rB)
+{
+    const int size = rA.rows();
+    const double* a = rA.data();
+    const double* b = rB.data();
+    double sum = 0.;
+#ifdef _OPENMP
+#pragma omp parallel for schedule(static) reduction(+ : sum) if (size > SparseMatrixProduct::minRowsPerThread)
+#endif
+    for (int i = 0; i < size; ++i)
+        sum += a[i] * b[i];
+    return sum;
+}
+
+void SolverIterative::AddScaled(Eigen::VectorXd& rY, double rAlpha, const Eigen::VectorXd& rX)
+{
+    const int size = rY.rows();
+    double* y = rY.data();
+    const double* x = rX.data();
+#ifdef _OPENMP
+#pragma omp parallel for schedule(static) if (size > SparseMatrixProduct::minRowsPerThread)
+#endif
+    for (int i = 0; i < size; ++i)
+        y[i] += rAlpha * x[i];
+}
@@ -0,0 +1,246 @@
+#pragma once
+
+#include <map>
+#include <memory>
+#include <vector>
+
+#include "math/SmoothedAggregationAMG.h"
+#include "mechanics/dofSubMatrixSolvers/SolverBase.h"
+
+namespace NuTo
+{
+//! @brief base class of the preconditioned Krylov solvers for symmetric block sparse systems, e.g. SolverPCG and
+//! SolverMINRES
+//! @remark The solvers work directly on the compressed matrix of the block sparse matrix, see GetCompressed, without a
+//! copy of the matrix. In terms of SolverBase, the analysis sets up the pattern of the preconditioner and the
+//! factorization computes its values. The matrix vector products, the vector operations, the Jacobi type and the
+//! multigrid preconditioners run in parallel, the triangular solutions of SSOR and IC(0) are sequential.
+//! The iteration stops if the residual r = b - A x satisfies |r| <= tolerance * |b|, or, if residual tolerances are
+//! set, if |r_dof|_inf <= factor * toleranceResidual[dof] for all active dof types, i.e. the norm of the Newton
+//! residual used by the time integration schemes, see TimeIntegrationBase::SetToleranceResidual.
+//! The field split preconditioner uses the dof type blocks of coupled problems, e.g. displacements and nonlocal
+//! equivalent strains: each diagonal block A_ii gets its own preconditioner B_i, e.g. multigrid for displacements and
+//! IC(0) for scalar fields, that are combined additively (block Jacobi), multiplicatively (symmetric block
+//! Gauss-Seidel) or by the block factorization with an approximate Schur complement.
+class SolverIterative : public SolverBase
+{
+public:
+    enum class ePreconditioner
+    {
+        NONE,
+        JACOBI, //!< inverse of the absolute values of the diagonal
+        BLOCK_JACOBI, //!< inverse of the diagonal blocks of the dofs of a node, see SetBlockSize
+        SSOR, //!< symmetric successive over-relaxation, see SetRelaxation
+        INCOMPLETE_CHOLESKY, //!< incomplete Cholesky factorization without fill-in, IC(0)
+        ALGEBRAIC_MULTIGRID, //!< V-cycle of smoothed aggregation AMG, see SetNearNullSpace
+        FIELD_SPLIT //!< preconditioners of the dof type blocks, see SetFieldSplit and SetFieldPreconditioner
+    };
+
+    enum class eFieldSplit
+    {
+        ADDITIVE, //!< z_i = B_i r_i
+        SYMMETRIC_MULTIPLICATIVE, //!< z_i += B_i (r - A z)_i, forward and backward over the dof types
+        SCHUR_COMPLEMENT //!< two dof types, S = A_22 - A_21 diag(A_11)^-1 A_12 is preconditioned by B_2
+    };
+
+    SolverIterative(ePreconditioner rPreconditioner = ePreconditioner::JACOBI)
+        : SolverBase()
+        , mPreconditioner(rPreconditioner)
+    {
+    }
+
+    void SetPreconditioner(ePreconditioner rPreconditioner)
+    {
+        mPreconditioner = rPreconditioner;
+        Reset();
+    }
+
+    //! @brief number of consecutive dofs of a dof type that form a block of the block Jacobi preconditioner, e.g. the
+    //! dimension for displacements, if the dofs of a node are numbered consecutively
+    void SetBlockSize(int rBlockSize);
+
+    //! @brief relaxation parameter of SSOR, 0 < rRelaxation < 2
+    void SetRelaxation(double rRelaxation);
+
+    //! @brief near null space of the active dofs for the algebraic multigrid preconditioner, e.g. the rigid body modes
+    //! of StructureBase::BuildNearNullSpace. Without it, the multigrid uses the constant vector.
+    void SetNearNullSpace(NearNullSpace rNearNullSpace)
+    {
+        mNearNullSpace = std::move(rNearNullSpace);
+        Reset();
+    }
+
+    //! @brief combination of the dof type preconditioners of FIELD_SPLIT
+    void SetFieldSplit(eFieldSplit rFieldSplit)
+    {
+        mFieldSplit = rFieldSplit;
+        Reset();
+    }
+
+    //! @brief preconditioner of the diagonal block of rDof for FIELD_SPLIT, the default is ALGEBRAIC_MULTIGRID for
+    //! displacements and INCOMPLETE_CHOLESKY for the other dof types
+    //! @remark The block size, the relaxation and the multigrid settings are those of this solver, the near null space
+    //! is restricted to the rows of rDof.
+    void SetFieldPreconditioner(Node::eDof rDof, ePreconditioner rPreconditioner);
+
+    //! @brief access to the settings of the algebraic multigrid preconditioner
+    SmoothedAggregationAMG& GetMultigrid()
+    {
+        return mMultigrid;
+    }
+
+    //! @brief relative tolerance |r| <= rTolerance * |b|
+    void SetTolerance(double rTolerance)
+    {
+        mTolerance = rTolerance;
+    }
+
+    //! @brief the iteration stops with an exception if it does not converge within rMaxNumIterations
+    void SetMaxNumIterations(int rMaxNumIterations)
+    {
+        mMaxNumIterations = rMaxNumIterations;
+    }
+
+    //! @brief tolerance of the inf norm of the residual of rDof
+    void SetToleranceResidual(Node::eDof rDof, double rTolerance) override
+    {
+        mToleranceResidual[rDof] = rTolerance;
+    }
+
+    //! @brief the residual of a dof type has to be smaller than rFactor times its residual tolerance, the default
+    //! leaves some margin for the Newton iteration
+    void SetToleranceResidualFactor(double rFactor)
+    {
+        mToleranceResidualFactor = rFactor;
+    }
+
+    //! @brief number of iterations of the last solution
+    int GetNumIterations() const override
+    {
+        return mNumIterations;
+    }
+
+protected:
+    CompressedMatrix Compress(const BlockSparseMatrix& rMatrix) override;
+
+    void AnalyzePattern() override;
+
+    void FactorizeValues() override;
+
+    Eigen::VectorXd SolveWithFactorization(const Eigen::VectorXd& rRhs) override;
+
+    //! @brief Krylov iteration for the compressed matrix, starting with x = 0
+    //! @param rRhs ... right hand side b
+    //! @param rSolution ... solution x, initially zero
+    //! @param rNumIterations ... number of iterations
+    //! @return true if converged within the maximum number of iterations
+    virtual bool Iterate(const Eigen::VectorXd& rRhs, Eigen::VectorXd& rSolution, int& rNumIterations) = 0;
+
+    //! @brief rResult = A * rVector
+    void Multiply(const Eigen::VectorXd& rVector, Eigen::VectorXd& rResult) const;
+
+    //! @brief rResult = M^-1 * rVector, with the preconditioner M
+    void Precondition(const Eigen::VectorXd& rVector, Eigen::VectorXd& rResult) const;
+
+    //! @brief convergence check, see class description
+    //! @param rResidual ... residual r = b - A x
+    //! @param rRhsNorm ... |b|
+    bool IsConverged(const Eigen::VectorXd& rResidual, double rRhsNorm) const;
+
+    //! @brief tolerance of |r| that is sufficient for IsConverged, for solvers that only know the norm of the residual
+    //! @param rRhsNorm ... |b|
+    double GetResidualNormTolerance(double rRhsNorm) const;
+
+    int GetMaxNumIterations() const
+    {
+        return mMaxNumIterations;
+    }
+
+    //! @brief parallel scalar product
+    static double Dot(const Eigen::VectorXd& rA, const Eigen::VectorXd& rB);
+
+    //! @brief parallel rY += rAlpha * rX
+    static void AddScaled(Eigen::VectorXd& rY, double rAlpha, const Eigen::VectorXd& rX);
+
+private:
+    //! @brief IC(0) of the compressed matrix with a diagonal shift, false if a pivot is not positive
+    bool IncompleteCholesky(double rShift);
+
+    void ApplyBlockJacobi(const Eigen::VectorXd& rVector, Eigen::VectorXd& rResult) const;
+    void ApplySSOR(const Eigen::VectorXd& rVector, Eigen::VectorXd& rResult) const;
+    void ApplyIncompleteCholesky(const Eigen::VectorXd& rVector, Eigen::VectorXd& rResult) const;
+    void ApplyFieldSplit(const Eigen::VectorXd& rVector, Eigen::VectorXd& rResult) const;
+
+    //! @brief extracts the diagonal blocks of the dof types and analyzes their preconditioners
+    void AnalyzeFields();
+
+    //! @brief values of the diagonal blocks (and the Schur complement) and the factorization of their preconditioners
+    void FactorizeFields();
+
+    //! @brief rResult = rows rBegin ... rBegin + rSize - 1 of A * rVector
+    void MultiplyRows(const Eigen::VectorXd& rVector, int rBegin, int rSize, Eigen::VectorXd& rResult) const;
+
+    ePreconditioner mPreconditioner;
+    int mBlockSize = 3;
+    double mRelaxation = 1.;
+
+    double mTolerance = 1.e-10;
+    int mMaxNumIterations = 10000;
+    std::map<Node::eDof, double> mToleranceResidual;
+    double mToleranceResidualFactor = 0.1;
+
+    int mNumIterations = 0;
+
+    //! @brief compressed matrix with all entries (zero based), see BlockSparseMatrix::GetEigenSparseMatrixView
+    CompressedMatrix mMatrix;
+
+    //! @brief dof type, first row and number of rows of the active dof types in the compressed matrix
+    struct DofRange
+    {
+        Node::eDof mDof;
+        int mBegin;
+        int mSize;
+    };
+    std::vector<DofRange> mDofRanges;
+
+    //! @brief position of the diagonal entry of each row in the compressed matrix
+    std::vector<int> mDiagonal;
+
+    //! @brief inverse of the (absolute) diagonal for Jacobi, the diagonal for SSOR
+    Eigen::VectorXd mDiagonalValues;
+
+    //! @brief first row of each block and the inverse blocks (column major) for block Jacobi
+    std::vector<int> mBlockBegin;
+    std::vector<int> mBlockValueBegin;
+    std::vector<double> mInverseBlocks;
+
+    //! @brief lower triangle L of IC(0), A ~ L * L^T, in compressed row storage, the diagonal is the last entry of a
+    //! row, mFactorSource is the position of each entry in the compressed matrix
+    std::vector<int> mFactorRowIndex;
+    std::vector<int> mFactorColumns;
+    std::vector<int> mFactorSource;
+    std::vector<double> mFactorValues;
+
+    NearNullSpace mNearNullSpace;
+    SmoothedAggregationAMG mMultigrid;
+
+    eFieldSplit mFieldSplit = eFieldSplit::SYMMETRIC_MULTIPLICATIVE;
+    std::map<Node::eDof, ePreconditioner> mFieldPreconditioners;
+
+    //! @brief diagonal block of a dof type in compressed row storage and its preconditioner, mSource is the position of
+    //! each entry in the compressed matrix
+    struct Field
+    {
+        DofRange mRange;
+        std::vector<int> mRowIndex;
+        std::vector<int> mColumns;
+        std::vector<int> mSource;
+        std::vector<double> mValues;
+        std::unique_ptr<SolverIterative> mSolver;
+    };
+    std::vector<Field> mFields;
+
+    //! @brief approximate Schur complement of the second dof type, see eFieldSplit::SCHUR_COMPLEMENT
+    SmoothedAggregationAMG::Matrix mSchurComplement;
+};
+} // namespace NuTo
@@ -0,0 +1,94 @@
+#include "mechanics/dofSubMatrixSolvers/SolverMINRES.h"
+
+#include <cmath>
+#include <utility>
+
+using namespace NuTo;
+
+bool SolverMINRES::Iterate(const Eigen::VectorXd& rRhs, Eigen::VectorXd& rSolution, int& rNumIterations)
+{
+    // preconditioned Lanczos process with Givens rotations, see Elman, Silvester, Wathen (2005), Algorithm 6.1. The
+    // residual is updated with the products of the search directions, which requires no additional matrix product.
+    const int numRows = rRhs.rows();
+    const double rhsNorm = std::sqrt(Dot(rRhs, rRhs));
+    Eigen::VectorXd residual = rRhs;
+    rNumIterations = 0;
+    if (IsConverged(residual, rhsNorm))
+        return true;
+
+    Eigen::VectorXd vOld = Eigen::VectorXd::Zero(numRows);
+    Eigen::VectorXd v = rRhs;
+    Eigen::VectorXd z;
+    Precondition(v, z);
+    double gamma = std::sqrt(Dot(z, v));
+    double gammaOld = 1.;
+
+    // search directions w and their products A * w
+    Eigen::VectorXd wOld = Eigen::VectorXd::Zero(numRows);
+    Eigen::VectorXd w = Eigen::VectorXd::Zero(numRows);
+    Eigen::VectorXd productOld = Eigen::VectorXd::Zero(numRows);
+    Eigen::VectorXd product = Eigen::VectorXd::Zero(numRows);
+    Eigen::VectorXd productZ;
+
+    double eta = gamma;
+    double sOld = 0., s = 0.;
+    double cOld = 1., c = 1.;
+
+    while (rNumIterations < GetMaxNumIterations())
+    {
+        ++rNumIterations;
+        z /= gamma;
+        Multiply(z, productZ);
+        const double delta = Dot(productZ, z);
+
+        // v_new = A z - delta / gamma v - gamma / gammaOld vOld
+        vOld *= -gamma / gammaOld;
+        AddScaled(vOld, 1., productZ);
+        AddScaled(vOld, -delta / gamma, v);
+        std::swap(v, vOld);
+
+        Eigen::VectorXd zNew;
+        Precondition(v, zNew);
+        const double gammaSquare = Dot(zNew, v);
+        if (gammaSquare < 0.)
+            throw Exception(__PRETTY_FUNCTION__, "The preconditioner is not positive definite.");
+        const double gammaNew = std::sqrt(gammaSquare);
+
+        const double alpha0 = c * delta - cOld * s * gamma;
+        const double alpha1 = std::sqrt(alpha0 * alpha0 + gammaNew * gammaNew);
+        const double alpha2 = s * delta + cOld * c * gamma;
+        const double alpha3 = sOld * gamma;
+        if (alpha1 == 0.)
+            throw Exception(__PRETTY_FUNCTION__, "The matrix is singular.");
+        const double cNew = alpha0 / alpha1;
+        const double sNew = gammaNew / alpha1;
+
+        // w_new = (z - alpha3 wOld - alpha2 w) / alpha1, same for the products
+        wOld *= -alpha3;
+        AddScaled(wOld, -alpha2, w);
+        AddScaled(wOld, 1., z);
+        wOld /= alpha1;
+        std::swap(w, wOld);
+        productOld *= -alpha3;
+        AddScaled(productOld, -alpha2, product);
+        AddScaled(productOld, 1., productZ);
+        productOld /= alpha1;
+        std::swap(product, productOld);
+
+        AddScaled(rSolution, cNew * eta, w);
+        AddScaled(residual, -cNew * eta, product);
+        eta *= -sNew;
+
+        if (IsConverged(residual, rhsNorm) or gammaNew == 0.)
+            return true;
+
+        z = std::move(zNew);
+        gammaOld = gamma;
+        gamma = gammaNew;
+        cOld = c;
+        c = cNew;
+        sOld = s;
+        s = sNew;
+    }
+    return false;
+}
@@ -0,0 +1,22 @@
+#pragma once
+
+#include "mechanics/dofSubMatrixSolvers/SolverIterative.h"
+
+namespace NuTo
+{
+//! @brief preconditioned minimal residual method for symmetric, possibly indefinite block sparse systems, e.g. with
+//! Lagrange multipliers
+//! @remark The preconditioner has to be positive definite. The Jacobi preconditioner uses the absolute values of the
+//! diagonal and can therefore be used for indefinite matrices as well.
+class SolverMINRES : public SolverIterative
+{
+public:
+    SolverMINRES(ePreconditioner rPreconditioner = ePreconditioner::JACOBI)
+        : SolverIterative(rPreconditioner)
+    {
+    }
+
+protected:
+    bool Iterate(const Eigen::VectorXd& rRhs, Eigen::VectorXd& rSolution, int& rNumIterations) override;
+};
+} // namespace NuTo
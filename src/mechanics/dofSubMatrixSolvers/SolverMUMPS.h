@@ -5,6 +5,8 @@
 
 #pragma once
 
+#include <memory>
+
 #include "mechanics/dofSubMatrixSolvers/SolverBase.h"
 #include "math/SparseDirectSolverMUMPS.h"
 #include "math/SparseMatrixCSR.h"
@@ -20,23 +22,44 @@ public:
         , mShowTime(rShowTime)
     {
     }
-    virtual BlockFullVector<double> Solve(const BlockSparseMatrix& rMatrix,
-                                          const BlockFullVector<double>& rVector) override
-    {
 
-        Eigen::VectorXd result;
-        std::unique_ptr<NuTo::SparseMatrixCSR<double>> matrixForSolver = rMatrix.ExportToCSR();
-        matrixForSolver->SetOneBasedIndexing();
+protected:
+    CompressedMatrix Compress(const BlockSparseMatrix& rMatrix) override
+    {
+        mMatrix = &rMatrix.GetCompressed(true);
+        return {mMatrix->GetNumRows(), mMatrix->GetNumEntries(), mMatrix->GetRowIndex().data(),
+                mMatrix->GetColumns().data(), mMatrix->GetValues().data()};
+    }
 
-        NuTo::SparseDirectSolverMUMPS solver;
-        solver.SetShowTime(mShowTime);
+    void AnalyzePattern() override
+    {
+        if (mSolver == nullptr)
+        {
+            mSolver = std::make_unique<NuTo::SparseDirectSolverMUMPS>();
+            mSolver->SetShowTime(mShowTime);
+        }
+        mSolver->Analysis(*mMatrix);
+    }
 
-        solver.Solve(*matrixForSolver, rVector.Export(), result);
+    void FactorizeValues() override
+    {
+        mSolver->NumericalFactorization(*mMatrix);
+    }
 
-        return BlockFullVector<double>(result, rMatrix.GetDofStatus());
+    Eigen::VectorXd SolveWithFactorization(const Eigen::VectorXd& rRhs) override
+    {
+        Eigen::VectorXd result;
+        mSolver->Solution(rRhs, result);
+        return result;
     }
 
 private:
     bool mShowTime;
+
+    //! @brief created with the first analysis
+    std::unique_ptr<NuTo::SparseDirectSolverMUMPS> mSolver;
+
+    //! @brief compressed matrix of the last call to Compress, owned by the BlockSparseMatrix
+    const NuTo::SparseMatrixCSR<double>* mMatrix = nullptr;
 };
 } // namespace NuTo
@@ -0,0 +1,159 @@
+#include "mechanics/dofSubMatrixSolvers/SolverMixedPrecision.h"
+
+#include <algorithm>
+#include <cmath>
+#include <string>
+
+#include "math/GcroDr.h"
+#include "mechanics/dofSubMatrixSolvers/SolverSupernodalLDLT.h"
+
+using namespace NuTo;
+
+SolverMixedPrecision::SolverMixedPrecision()
+    : SolverMixedPrecision(std::make_unique<SolverSupernodalLDLT>(SupernodalLDLT::ePrecision::SINGLE))
+{
+}
+
+
+SolverMixedPrecision::SolverMixedPrecision(std::unique_ptr<SolverBase> rFactorization)
+    : SolverBase()
+    , mFactorization(std::move(rFactorization))
+{
+    if (mFactorization == nullptr)
+        throw Exception(__PRETTY_FUNCTION__, "The factorization solver is missing.");
+}
+
+
+void SolverMixedPrecision::SetStallRatio(double rStallRatio)
+{
+    if (not(rStallRatio > 0. and rStallRatio < 1.))
+        throw Exception(__PRETTY_FUNCTION__, "The stall ratio has to be in (0, 1).");
+    mStallRatio = rStallRatio;
+}
+
+
+SolverBase::CompressedMatrix SolverMixedPrecision::Compress(const BlockSparseMatrix& rMatrix)
+{
+    // a view for the norm, the residuals are computed from the block matrix
+    mMatrix = &rMatrix;
+    const auto view = rMatrix.GetEigenSparseMatrixView();
+    mCompressed = {static_cast<int>(view.rows()), static_cast<int>(view.nonZeros()), view.outerIndexPtr(),
+                   view.innerIndexPtr(), view.valuePtr()};
+    return mCompressed;
+}
+
+
+void SolverMixedPrecision::FactorizeValues()
+{
+    // computed before the factorization, which leaves the compressed arrays of the matrix in the format of the backend
+    const BlockSparseMatrix::EigenSparseMatrixView view(mCompressed.mNumRows, mCompressed.mNumRows,
+                                                        mCompressed.mNumEntries, mCompressed.mRowIndex,
+                                                        mCompressed.mColumns, mCompressed.mValues);
+    mNormA = 0.;
+    for (int row = 0; row < view.rows(); ++row)
+    {
+        double sum = 0.;
+        for (BlockSparseMatrix::EigenSparseMatrixView::InnerIterator it(view, row); it; ++it)
+            sum += std::abs(it.value());
+        mNormA = std::max(mNormA, sum);
+    }
+
+    mFactorization->Factorize(*mMatrix);
+}
+
+
+Eigen::VectorXd SolverMixedPrecision::SolveWithFactorization(const Eigen::VectorXd& rRhs)
+{
+    mNumRefinements = 0;
+    mNumGmresIterations = 0;
+    const double rhsNorm = rRhs.lpNorm<Eigen::Infinity>();
+
+    Eigen::VectorXd x = mFactorization->SolveFactorized(rRhs);
+    Eigen::VectorXd residual;
+    Residual(rRhs, x, residual);
+    double residualNorm = residual.lpNorm<Eigen::Infinity>();
+
+    // iterative refinement with the factorization
+    bool isStalled = false;
+    while (BackwardError(residual, x, rhsNorm) > mTolerance and mNumRefinements < mMaxNumRefinements and
+           not isStalled)
+    {
+        const Eigen::VectorXd correction = mFactorization->SolveFactorized(residual);
+        x += correction;
+        ++mNumRefinements;
+
+        const double previousNorm = residualNorm;
+        Residual(rRhs, x, residual);
+        residualNorm = residual.lpNorm<Eigen::Infinity>();
+        isStalled = residualNorm > mStallRatio * previousNorm;
+        if (residualNorm > previousNorm)
+        {
+            // diverges, the factorization is too inaccurate for the condition number
+            x -= correction;
+            Residual(rRhs, x, residual);
+            residualNorm = residual.lpNorm<Eigen::Infinity>();
+        }
+    }
+
+    // GMRES-IR, the correction equations are solved by GMRES preconditioned with the factorization
+    if (BackwardError(residual, x, rhsNorm) > mTolerance)
+    {
+        GcroDr gmres(mKrylovDimension, 0);
+        gmres.SetMaxNumIterations(10 * mKrylovDimension);
+        const GcroDr::Operator multiply = [this](const Eigen::VectorXd& rVector, Eigen::VectorXd& rResult) {
+            Multiply(rVector, rResult);
+        };
+        const GcroDr::Operator precondition = [this](const Eigen::VectorXd& rVector, Eigen::VectorXd& rResult) {
+            rResult = mFactorization->SolveFactorized(rVector);
+        };
+
+        for (int step = 0; step < mMaxNumRefinements and BackwardError(residual, x, rhsNorm) > mTolerance; ++step)
+        {
+            // the correction only has to reach the backward error, but GMRES cannot resolve more than about 6 digits
+            // of the residual in double precision per step
+            const double target = mTolerance * (mNormA * x.lpNorm<Eigen::Infinity>() + rhsNorm);
+            gmres.SetTolerance(std::max(target / residual.norm(), 1.e-6));
+            Eigen::VectorXd correction;
+            gmres.Solve(multiply, precondition, residual, correction);
+            mNumGmresIterations += gmres.GetNumIterations();
+            x += correction;
+            ++mNumRefinements;
+
+            const double previousNorm = residualNorm;
+            Residual(rRhs, x, residual);
+            residualNorm = residual.lpNorm<Eigen::Infinity>();
+            if (not(residualNorm < previousNorm))
+                break;
+        }
+    }
+
+    const double backwardError = BackwardError(residual, x, rhsNorm);
+    if (backwardError > mTolerance)
+        throw Exception(__PRETTY_FUNCTION__, "No convergence after " + std::to_string(mNumRefinements) +
+                                                     " refinement steps, the backward error is " +
+                                                     std::to_string(backwardError) + ".");
+    return x;
+}
+
+
+void SolverMixedPrecision::Multiply(const Eigen::VectorXd& rVector, Eigen::VectorXd& rResult) const
+{
+    rResult = (*mMatrix * BlockFullVector<double>(rVector, mMatrix->GetDofStatus())).Export();
+}
+
+
+void SolverMixedPrecision::Residual(const Eigen::VectorXd& rRhs, const Eigen::VectorXd& rX,
+                                    Eigen::VectorXd& rResidual) const
+{
+    Multiply(rX, rResidual);
+    rResidual = rRhs - rResidual;
+}
+
+
+double SolverMixedPrecision::BackwardError(const Eigen::VectorXd& rResidual, const Eigen::VectorXd& rX,
+                                           double rRhsNorm) const
+{
+    const double scale = mNormA * rX.lpNorm<Eigen::Infinity>() + rRhsNorm;
+    const double residualNorm = rResidual.lpNorm<Eigen::Infinity>();
+    return scale > 0. ? residualNorm / scale : residualNorm;
+}
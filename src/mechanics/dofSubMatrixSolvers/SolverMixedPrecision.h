@@ -0,0 +1,109 @@
+#pragma once
+
+#include <memory>
+
+#include "mechanics/dofSubMatrixSolvers/SolverBase.h"
+
+namespace NuTo
+{
+//! @brief direct solution with a low precision factorization and iterative refinement to double precision
+//! @remark Mixed precision iterative refinement (Carson, Higham 2018): with the factorization M ~ A of the backend
+//! solver, x_0 = M^-1 b and x_k+1 = x_k + M^-1 (b - A x_k), the residuals are computed in double precision. This
+//! converges if the condition number of A times the precision of M is below one, e.g. about 1e7 for a single precision
+//! factorization. If a step reduces the residual by less than the stall ratio, the correction equations A d = r are
+//! solved by GMRES preconditioned with M instead (GMRES-IR), which also converges for considerably larger condition
+//! numbers. The iteration stops if the normwise backward error |b - A x| / (|A| |x| + |b|) (inf norms) is below the
+//! tolerance and throws if neither variant reaches it.
+//! The backend can be any direct solver. SolverSupernodalLDLT in single precision, the default, halves the memory and
+//! the time of the factorization. Double precision backends, e.g. SolverMUMPS, converge in one step.
+//! GetNumIterations returns the refinement steps plus the GMRES iterations of the last solution, see also
+//! GetNumGmresIterations, NewmarkDirect reports it.
+class SolverMixedPrecision : public SolverBase
+{
+public:
+    //! @brief SolverSupernodalLDLT in single precision as backend
+    SolverMixedPrecision();
+
+    //! @param rFactorization ... direct solver that factorizes the matrix, its solutions are refined
+    explicit SolverMixedPrecision(std::unique_ptr<SolverBase> rFactorization);
+
+    //! @brief tolerance of the normwise backward error, see class description
+    void SetTolerance(double rTolerance)
+    {
+        mTolerance = rTolerance;
+    }
+
+    //! @brief maximum number of refinement steps, and of GMRES-IR steps after the fallback
+    void SetMaxNumRefinements(int rMaxNumRefinements)
+    {
+        mMaxNumRefinements = rMaxNumRefinements;
+    }
+
+    //! @brief falls back to GMRES-IR if |r_k+1| > rStallRatio * |r_k|, 0 < rStallRatio < 1
+    void SetStallRatio(double rStallRatio);
+
+    //! @brief maximum number of basis vectors of GMRES per restart cycle
+    void SetKrylovDimension(int rKrylovDimension)
+    {
+        mKrylovDimension = rKrylovDimension;
+    }
+
+    //! @brief refinement steps plus GMRES iterations of the last solution
+    int GetNumIterations() const override
+    {
+        return mNumRefinements + mNumGmresIterations;
+    }
+
+    //! @brief refinement steps of the last solution, including the GMRES-IR steps
+    int GetNumRefinements() const
+    {
+        return mNumRefinements;
+    }
+
+    //! @brief GMRES iterations of the last solution, 0 if it did not fall back to GMRES-IR
+    int GetNumGmresIterations() const
+    {
+        return mNumGmresIterations;
+    }
+
+protected:
+    CompressedMatrix Compress(const BlockSparseMatrix& rMatrix) override;
+
+    //! @brief nothing to do, the backend analyzes the pattern in FactorizeValues if necessary
+    void AnalyzePattern() override
+    {
+    }
+
+    void FactorizeValues() override;
+
+    Eigen::VectorXd SolveWithFactorization(const Eigen::VectorXd& rRhs) override;
+
+private:
+    //! @brief rResult = A rVector in double precision, see BlockSparseMatrix::operator*
+    void Multiply(const Eigen::VectorXd& rVector, Eigen::VectorXd& rResult) const;
+
+    //! @brief rResidual = rRhs - A rX
+    void Residual(const Eigen::VectorXd& rRhs, const Eigen::VectorXd& rX, Eigen::VectorXd& rResidual) const;
+
+    //! @brief normwise backward error of rX
+    double BackwardError(const Eigen::VectorXd& rResidual, const Eigen::VectorXd& rX, double rRhsNorm) const;
+
+    std::unique_ptr<SolverBase> mFactorization;
+
+    double mTolerance = 1.e-13;
+    int mMaxNumRefinements = 20;
+    double mStallRatio = 0.5;
+    int mKrylovDimension = 30;
+
+    int mNumRefinements = 0;
+    int mNumGmresIterations = 0;
+
+    //! @brief matrix of the last Compress, factorized by the backend in FactorizeValues, and its inf norm
+    //! @remark The residuals are computed from its submatrices, no copy of the values is kept.
+    const BlockSparseMatrix* mMatrix = nullptr;
+    double mNormA = 0.;
+
+    //! @brief view of the compressed arrays of mMatrix, valid until the backend compresses it
+    CompressedMatrix mCompressed;
+};
+} // namespace NuTo
@@ -0,0 +1,45 @@
+#include "mechanics/dofSubMatrixSolvers/SolverPCG.h"
+
+#include <cmath>
+
+using namespace NuTo;
+
+bool SolverPCG::Iterate(const Eigen::VectorXd& rRhs, Eigen::VectorXd& rSolution, int& rNumIterations)
+{
+    const double rhsNorm = std::sqrt(Dot(rRhs, rRhs));
+    Eigen::VectorXd residual = rRhs;
+    rNumIterations = 0;
+    if (IsConverged(residual, rhsNorm))
+        return true;
+
+    Eigen::VectorXd preconditioned;
+    Precondition(residual, preconditioned);
+    Eigen::VectorXd direction = preconditioned;
+    Eigen::VectorXd product;
+    double rho = Dot(residual, preconditioned);
+
+    while (rNumIterations < GetMaxNumIterations())
+    {
+        ++rNumIterations;
+        Multiply(direction, product);
+        const double curvature = Dot(direction, product);
+        if (not(curvature > 0.))
+            throw Exception(__PRETTY_FUNCTION__, "The matrix is not positive definite.");
+
+        const double alpha = rho / curvature;
+        AddScaled(rSolution, alpha, direction);
+        AddScaled(residual, -alpha, product);
+        if (IsConverged(residual, rhsNorm))
+            return true;
+
+        Precondition(residual, preconditioned);
+        const double rhoNew = Dot(residual, preconditioned);
+        const double beta = rhoNew / rho;
+        rho = rhoNew;
+
+        // direction = preconditioned + beta * direction
+        direction *= beta;
+        AddScaled(direction, 1., preconditioned);
+    }
+    return false;
+}
@@ -0,0 +1,21 @@
+#pragma once
+
+#include "mechanics/dofSubMatrixSolvers/SolverIterative.h"
+
+namespace NuTo
+{
+//! @brief preconditioned conjugate gradient method for symmetric positive definite block sparse systems
+//! @remark The memory consumption is a few vectors plus the preconditioner, e.g. for large 3D models where the fill-in
+//! of direct solvers does not fit into memory.
+class SolverPCG : public SolverIterative
+{
+public:
+    SolverPCG(ePreconditioner rPreconditioner = ePreconditioner::INCOMPLETE_CHOLESKY)
+        : SolverIterative(rPreconditioner)
+    {
+    }
+
+protected:
+    bool Iterate(const Eigen::VectorXd& rRhs, Eigen::VectorXd& rSolution, int& rNumIterations) override;
+};
+} // namespace NuTo
@@ -4,6 +4,8 @@
 
 #pragma once
 
+#include <memory>
+
 #include "mechanics/dofSubMatrixSolvers/SolverBase.h"
 #include "math/SparseDirectSolverPardiso.h"
 #include "math/SparseMatrixCSR.h"
@@ -22,25 +24,48 @@ public:
 #endif // HAVE_PARDISO
     {
     }
+
+protected:
 #ifdef HAVE_PARDISO
-    virtual BlockFullVector<double> Solve(const BlockSparseMatrix& rMatrix,
-                                          const BlockFullVector<double>& rVector) override
+    CompressedMatrix Compress(const BlockSparseMatrix& rMatrix) override
     {
-        Eigen::VectorXd result;
-        std::unique_ptr<NuTo::SparseMatrixCSR<double>> matrixForSolver = rMatrix.ExportToCSR();
-        matrixForSolver->SetOneBasedIndexing();
+        mMatrix = &rMatrix.GetCompressed(true);
+        return {mMatrix->GetNumRows(), mMatrix->GetNumEntries(), mMatrix->GetRowIndex().data(),
+                mMatrix->GetColumns().data(), mMatrix->GetValues().data()};
+    }
 
-        int verboseLevel = mShowTime ? 1 : 0;
-        NuTo::SparseDirectSolverPardiso pardiso(mNumProcessors, verboseLevel);
-        pardiso.SetShowTime(mShowTime);
-        pardiso.Solve(*matrixForSolver, rVector.Export(), result);
+    void AnalyzePattern() override
+    {
+        if (mSolver == nullptr)
+        {
+            int verboseLevel = mShowTime ? 1 : 0;
+            mSolver = std::make_unique<NuTo::SparseDirectSolverPardiso>(mNumProcessors, verboseLevel);
+            mSolver->SetShowTime(mShowTime);
+        }
+        mSolver->Analysis(*mMatrix);
+    }
 
-        return BlockFullVector<double>(result, rMatrix.GetDofStatus());
+    void FactorizeValues() override
+    {
+        mSolver->NumericalFactorization(*mMatrix);
+    }
+
+    Eigen::VectorXd SolveWithFactorization(const Eigen::VectorXd& rRhs) override
+    {
+        Eigen::VectorXd result;
+        mSolver->Solution(rRhs, result);
+        return result;
     }
 
 private:
     int mNumProcessors;
     bool mShowTime;
+
+    //! @brief created with the first analysis
+    std::unique_ptr<NuTo::SparseDirectSolverPardiso> mSolver;
+
+    //! @brief compressed matrix of the last call to Compress, owned by the BlockSparseMatrix
+    const NuTo::SparseMatrixCSR<double>* mMatrix = nullptr;
 #endif // HAVE_PARDISO
 };
 } // namespace NuTo
@@ -0,0 +1,100 @@
+#pragma once
+
+#include <memory>
+#include <Eigen/SparseLU>
+
+#include "mechanics/dofSubMatrixSolvers/SolverBase.h"
+#include "mechanics/dofSubMatrixSolvers/SolverEigen.h"
+#include "math/SupernodalLDLT.h"
+
+namespace NuTo
+{
+//! @brief built-in multithreaded sparse direct solver for symmetric matrices, see SupernodalLDLT
+//! @remark the default solver of the time integration schemes if NuTo is built without MUMPS, in single precision the
+//! factorization of SolverMixedPrecision. SupernodalLDLT only reads the lower triangle, thus nonsymmetric matrices,
+//! e.g. the tangents of nonassociative plasticity, are factorized by Eigen::SparseLU in double precision instead.
+class SolverSupernodalLDLT : public SolverBase
+{
+public:
+    SolverSupernodalLDLT(SupernodalLDLT::ePrecision rPrecision = SupernodalLDLT::ePrecision::DOUBLE)
+        : SolverBase()
+        , mSolver(rPrecision)
+    {
+    }
+
+    int GetNumSupernodes() const
+    {
+        return mSolver.GetNumSupernodes();
+    }
+
+    //! @brief number of entries of the factor L
+    std::size_t GetNumNonZeros() const
+    {
+        return mSolver.GetNumNonZeros();
+    }
+
+    //! @brief true, if the last factorized matrix was not symmetric and factorized by the fallback
+    bool IsNonSymmetric() const
+    {
+        return mUseNonSymmetricSolver;
+    }
+
+protected:
+    CompressedMatrix Compress(const BlockSparseMatrix& rMatrix) override
+    {
+        mBlockMatrix = &rMatrix;
+        const auto view = rMatrix.GetEigenSparseMatrixView();
+        mMatrix = {static_cast<int>(view.rows()), static_cast<int>(view.nonZeros()), view.outerIndexPtr(),
+                   view.innerIndexPtr(), view.valuePtr()};
+        return mMatrix;
+    }
+
+    //! @brief the symmetry depends on the values, the analysis is done in FactorizeValues
+    void AnalyzePattern() override
+    {
+        mIsPatternAnalyzed = false;
+    }
+
+    void FactorizeValues() override
+    {
+        mUseNonSymmetricSolver = not SupernodalLDLT::IsSymmetric(GetView());
+        if (mUseNonSymmetricSolver)
+        {
+            if (mNonSymmetricSolver == nullptr)
+                mNonSymmetricSolver = std::make_unique<SolverEigen<NonSymmetricSolver>>();
+            mNonSymmetricSolver->Factorize(*mBlockMatrix);
+            return;
+        }
+        if (not mIsPatternAnalyzed)
+        {
+            mSolver.AnalyzePattern(GetView());
+            mIsPatternAnalyzed = true;
+        }
+        mSolver.Factorize(GetView());
+    }
+
+    Eigen::VectorXd SolveWithFactorization(const Eigen::VectorXd& rRhs) override
+    {
+        if (mUseNonSymmetricSolver)
+            return mNonSymmetricSolver->SolveFactorized(rRhs);
+        return mSolver.Solve(rRhs);
+    }
+
+private:
+    BlockSparseMatrix::EigenSparseMatrixView GetView() const
+    {
+        return BlockSparseMatrix::EigenSparseMatrixView(mMatrix.mNumRows, mMatrix.mNumRows, mMatrix.mNumEntries,
+                                                        mMatrix.mRowIndex, mMatrix.mColumns, mMatrix.mValues);
+    }
+
+    using NonSymmetricSolver = Eigen::SparseLU<Eigen::SparseMatrix<double>, Eigen::COLAMDOrdering<int>>;
+
+    SupernodalLDLT mSolver;
+    CompressedMatrix mMatrix;
+    const BlockSparseMatrix* mBlockMatrix = nullptr;
+    bool mIsPatternAnalyzed = false;
+
+    bool mUseNonSymmetricSolver = false;
+    std::unique_ptr<SolverBase> mNonSymmetricSolver;
+};
+} // namespace NuTo
@@ -14,6 +14,7 @@
 
 #include "math/SparseMatrixCSRSymmetric.h"
 #include "math/SparseMatrixCSRGeneral.h"
+#include "math/SparseMatrixBSR.h"
 #include "math/SparseMatrix.h"
 
 
@@ -45,6 +46,10 @@ NuTo::BlockSparseMatrix::BlockSparseMatrix(NuTo::BlockSparseMatrix&& rOther)
     , mCanBeSymmetric(rOther.mCanBeSymmetric)
 {
     mData = std::move(rOther.mData);
+    mCompressed = std::move(rOther.mCompressed);
+    mCompressedIsSymmetric = rOther.mCompressedIsSymmetric;
+    mCompressedPatternRevision = rOther.mCompressedPatternRevision;
+    mCompressedBSR = std::move(rOther.mCompressedBSR);
 }
 
 NuTo::BlockSparseMatrix::~BlockSparseMatrix()
@@ -53,6 +58,7 @@ NuTo::BlockSparseMatrix::~BlockSparseMatrix()
 
 void NuTo::BlockSparseMatrix::AllocateSubmatrices()
 {
+    SetModified();
     mData.clear();
     const auto& dofTypes = mDofStatus.GetDofTypes();
     for (auto dofRow : dofTypes)
@@ -99,6 +105,11 @@ NuTo::BlockSparseMatrix& NuTo::BlockSparseMatrix::operator=(NuTo::BlockSparseMat
 {
     mCanBeSymmetric = rOther.mCanBeSymmetric;
     mData = std::move(rOther.mData);
+    mCompressed = std::move(rOther.mCompressed);
+    mCompressedIsSymmetric = rOther.mCompressedIsSymmetric;
+    mCompressedPatternRevision = rOther.mCompressedPatternRevision;
+    mCompressedBSR = std::move(rOther.mCompressedBSR);
+    SetModified();
     return *this;
 }
 
@@ -113,6 +124,7 @@ NuTo::BlockSparseMatrix& NuTo::BlockSparseMatrix::operator=(NuTo::BlockSparseMat
 
 NuTo::SparseMatrixCSRVector2<double>& NuTo::BlockSparseMatrix::operator()(Node::eDof rDofRow, Node::eDof rDofCol)
 {
+    SetModified();
     auto data = mData.find(std::make_pair(rDofRow, rDofCol));
     assert(data != mData.end());
     return *((*data).second);
@@ -136,6 +148,7 @@ NuTo::BlockFullVector<double> NuTo::BlockSparseMatrix::operator*(const BlockFull
     {
         result[dofRow].resize((*this)(dofRow, dofRow).GetNumRows());
         result[dofRow].setZero();
+        // the products of the submatrices are parallel, see SparseMatrixProduct
         for (auto dofSum : activeDofTypes)
         {
             result[dofRow] += (*this)(dofRow, dofSum).operator*(rRhs[dofSum]);
@@ -250,6 +263,7 @@ void NuTo::BlockSparseMatrix::Info() const
 
 void NuTo::BlockSparseMatrix::SetZero()
 {
+    SetModified();
     for (auto& pair : mData)
         pair.second->SetZeroEntries();
 }
@@ -352,25 +366,7 @@ Eigen::MatrixXd NuTo::BlockSparseMatrix::ExportToFullMatrix() const
 
 Eigen::SparseMatrix<double> NuTo::BlockSparseMatrix::ExportToEigenSparseMatrix() const
 {
-
-    SparseMatrixCSRGeneral<double> sparseMatrixCSRGeneral(ExportToCSRVector2General());
-
-    std::vector<Eigen::Triplet<double>> tripletList;
-    std::vector<double> val = sparseMatrixCSRGeneral.GetValues();
-    std::vector<int> colInd = sparseMatrixCSRGeneral.GetColumns();
-    std::vector<int> rowInd = sparseMatrixCSRGeneral.GetRowIndex();
-
-    for (unsigned i = 0; i < rowInd.size() - 1; ++i)
-    {
-        for (int k = rowInd[i]; k < rowInd[i + 1]; ++k)
-            tripletList.push_back(Eigen::Triplet<double>(i, colInd[k], val[k]));
-    }
-
-    Eigen::SparseMatrix<double> eigenSparseMatrix(GetNumActiveRows(), GetNumActiveColumns());
-    eigenSparseMatrix.setFromTriplets(tripletList.begin(), tripletList.end());
-    eigenSparseMatrix.makeCompressed();
-
-    return eigenSparseMatrix;
+    return Eigen::SparseMatrix<double>(GetEigenSparseMatrixView());
 }
 
 
@@ -471,6 +467,171 @@ std::unique_ptr<NuTo::SparseMatrixCSR<double>> NuTo::BlockSparseMatrix::ExportTo
 }
 
 
+const NuTo::SparseMatrixCSR<double>& NuTo::BlockSparseMatrix::GetCompressed(bool rOneBasedIndexing) const
+{
+    const auto& activeDofs = mDofStatus.GetActiveDofTypes();
+    if (activeDofs.size() == 0)
+        throw Exception(__PRETTY_FUNCTION__, "No active dofs defined. Nothing to export.");
+
+    auto dof = *activeDofs.begin();
+    const bool isSymmetric = activeDofs.size() == 1 && mDofStatus.IsSymmetric(dof);
+    assert(not isSymmetric or (*this)(dof, dof).IsSymmetric());
+    UpdateCompressed(isSymmetric, rOneBasedIndexing);
+    return *mCompressed;
+}
+
+
+NuTo::BlockSparseMatrix::EigenSparseMatrixView NuTo::BlockSparseMatrix::GetEigenSparseMatrixView() const
+{
+    UpdateCompressed(false, false);
+    return EigenSparseMatrixView(mCompressed->GetNumRows(), mCompressed->GetNumColumns(),
+                                 mCompressed->GetNumEntries(), mCompressed->GetRowIndex().data(),
+                                 mCompressed->GetColumns().data(), mCompressed->GetValues().data());
+}
+
+
+const NuTo::SparseMatrixBSR& NuTo::BlockSparseMatrix::GetCompressedBSR(int rBlockSize) const
+{
+    UpdateCompressed(false, false);
+    if (mCompressedBSR == nullptr or mCompressedBSR->GetBlockSize() != rBlockSize or
+        not mCompressedBSR->SetValues(*mCompressed))
+        mCompressedBSR = std::make_unique<SparseMatrixBSR>(*mCompressed, rBlockSize);
+    return *mCompressedBSR;
+}
+
+
+unsigned long NuTo::BlockSparseMatrix::GetValueRevision() const
+{
+    if (mIsModified.exchange(false))
+        mValueRevision = NewRevision();
+    return mValueRevision;
+}
+
+
+unsigned long NuTo::BlockSparseMatrix::NewRevision()
+{
+    static std::atomic<unsigned long> revision(0);
+    return ++revision;
+}
+
+
+void NuTo::BlockSparseMatrix::UpdateCompressed(bool rSymmetric, bool rOneBasedIndexing) const
+{
+    const int numRows = GetNumActiveRows();
+    const int numColumns = GetNumActiveColumns();
+    // the old arrays are overwritten in place, each changed row index or column changes the pattern
+    bool isPatternChanged = false;
+    if (mCompressed == nullptr or mCompressedIsSymmetric != rSymmetric or mCompressed->GetNumRows() != numRows or
+        mCompressed->GetNumColumns() != numColumns)
+    {
+        if (rSymmetric)
+            mCompressed = std::make_unique<SparseMatrixCSRSymmetric<double>>(numRows, 0);
+        else
+            mCompressed = std::make_unique<SparseMatrixCSRGeneral<double>>(numRows, numColumns);
+        mCompressedIsSymmetric = rSymmetric;
+        isPatternChanged = true;
+    }
+
+    // the arrays are written in the current indexing of mCompressed to avoid an additional conversion
+    const int base = mCompressed->HasOneBasedIndexing() ? 1 : 0;
+    auto& rowIndex = mCompressed->GetRowIndexReference();
+    auto& columns = mCompressed->GetColumnsReference();
+    auto& values = mCompressed->GetValuesReference();
+    const auto& activeDofs = mDofStatus.GetActiveDofTypes();
+
+    // number of entries per row, including the transposed entries of symmetric submatrices
+    std::vector<int> newRowIndex(numRows + 1, 0);
+    int blockStartRow = 0;
+    for (auto dofRow : activeDofs)
+    {
+        const int numRowsDof = (*this)(dofRow, dofRow).GetNumRows();
+        for (auto dofCol : activeDofs)
+        {
+            const auto& subMatrix = (*this)(dofRow, dofCol);
+            const auto& subColumns = subMatrix.GetColumns();
+            for (int iRow = 0; iRow < numRowsDof; ++iRow)
+            {
+                newRowIndex[blockStartRow + iRow + 1] += subColumns[iRow].size();
+                if (subMatrix.IsSymmetric() and not rSymmetric)
+                    for (int subColumn : subColumns[iRow])
+                        if (subColumn != iRow)
+                            ++newRowIndex[blockStartRow + subColumn + 1];
+            }
+        }
+        blockStartRow += numRowsDof;
+    }
+    for (int iRow = 0; iRow < numRows; ++iRow)
+        newRowIndex[iRow + 1] += newRowIndex[iRow];
+    columns.resize(newRowIndex[numRows]);
+    values.resize(newRowIndex[numRows]);
+
+    // the submatrices of a row of blocks are processed in the order of their columns. The entries of each row are
+    // sorted, if the rows of the submatrices are sorted.
+    std::vector<int> position(newRowIndex.begin(), newRowIndex.end() - 1);
+    blockStartRow = 0;
+    for (auto dofRow : activeDofs)
+    {
+        const int numRowsDof = (*this)(dofRow, dofRow).GetNumRows();
+        int blockStartCol = 0;
+        for (auto dofCol : activeDofs)
+        {
+            const auto& subMatrix = (*this)(dofRow, dofCol);
+            const auto& subValues = subMatrix.GetValues();
+            const auto& subColumns = subMatrix.GetColumns();
+
+            // the transposed entries of the lower triangle precede the entries of the upper triangle in each row
+            if (subMatrix.IsSymmetric() and not rSymmetric)
+                for (int iRow = 0; iRow < numRowsDof; ++iRow)
+                    for (unsigned int iCol = 0; iCol < subColumns[iRow].size(); ++iCol)
+                    {
+                        const int subColumn = subColumns[iRow][iCol];
+                        if (subColumn == iRow)
+                            continue;
+                        const int pos = position[blockStartRow + subColumn]++;
+                        const int column = iRow + blockStartCol + base;
+                        isPatternChanged = isPatternChanged or columns[pos] != column;
+                        columns[pos] = column;
+                        values[pos] = subValues[iRow][iCol];
+                    }
+
+#ifdef _OPENMP
+#pragma omp parallel for schedule(static) reduction(|| : isPatternChanged)
+#endif
+            for (int iRow = 0; iRow < numRowsDof; ++iRow)
+            {
+                int& pos = position[blockStartRow + iRow];
+                for (unsigned int iCol = 0; iCol < subColumns[iRow].size(); ++iCol, ++pos)
+                {
+                    const int column = subColumns[iRow][iCol] + blockStartCol + base;
+                    isPatternChanged = isPatternChanged or columns[pos] != column;
+                    columns[pos] = column;
+                    values[pos] = subValues[iRow][iCol];
+                }
+            }
+            blockStartCol += subMatrix.GetNumColumns();
+        }
+        blockStartRow += numRowsDof;
+    }
+    if (base != 0)
+        for (int& index : newRowIndex)
+            index += base;
+    if (newRowIndex != rowIndex)
+    {
+        rowIndex.swap(newRowIndex);
+        isPatternChanged = true;
+    }
+    if (isPatternChanged)
+        mCompressedPatternRevision = NewRevision();
+
+    if (rOneBasedIndexing)
+        mCompressed->SetOneBasedIndexing();
+    else
+        mCompressed->SetZeroBasedIndexing();
+    if (rSymmetric)
+        mCompressed->SetPositiveDefinite();
+}
+
+
 NuTo::SparseMatrixCSRVector2General<double> NuTo::BlockSparseMatrix::Get(std::string rDofRow, std::string rDofCol) const
 {
     auto& ref = (*this)(Node::DofToEnum(rDofRow), Node::DofToEnum(rDofCol));
@@ -1,5 +1,6 @@
 #pragma once
 
+#include <atomic>
 #include <memory>
 
 #include "mechanics/dofSubMatrixStorage/BlockStorageBase.h"
@@ -23,6 +24,7 @@ template <class T>
 class SparseMatrixCSRVector2General;
 template <class T>
 class SparseMatrixCSR;
+class SparseMatrixBSR;
 
 //! @author Thomas Titscher, BAM
 //! @date January 2016
@@ -136,6 +138,46 @@ public:
     Eigen::SparseMatrix<double> ExportToEigenSparseMatrix() const;
 #ifndef SWIG
     std::unique_ptr<NuTo::SparseMatrixCSR<double>> ExportToCSR() const;
+
+    //! @brief view of the compressed matrix of the active dofs, see GetEigenSparseMatrixView
+    using EigenSparseMatrixView = Eigen::Map<const Eigen::SparseMatrix<double, Eigen::RowMajor>>;
+
+    //! @brief returns the matrix of the active dofs in compressed row storage without copying it into a new matrix
+    //! @remark The compressed matrix is kept by the block matrix and its values are updated from the submatrices in
+    //! each call. Its arrays are reused as long as the number of entries does not change, e.g. in each iteration of a
+    //! Newton-Raphson scheme. Like ExportToCSR, it is the upper triangle of a SparseMatrixCSRSymmetric, if only one
+    //! symmetric dof type is active, and a SparseMatrixCSRGeneral otherwise. It is valid until the next call of
+    //! GetCompressed or GetEigenSparseMatrixView.
+    //! @param rOneBasedIndexing ... true for solvers that require one based indexing, e.g. MUMPS and Pardiso
+    const SparseMatrixCSR<double>& GetCompressed(bool rOneBasedIndexing = false) const;
+
+    //! @brief returns an Eigen view of the compressed matrix of all entries of the active dofs (also for symmetric
+    //! dof types), see GetCompressed
+    EigenSparseMatrixView GetEigenSparseMatrixView() const;
+
+    //! @brief returns the matrix of all entries of the active dofs in block compressed row storage, e.g. for repeated
+    //! matrix-vector products with vector valued dofs
+    //! @remark Like GetCompressed, the matrix is kept and only its values are updated, as long as the blocks do not
+    //! change. The blocks consist of consecutive active dofs, i.e. the dofs of a node, if they are numbered
+    //! consecutively.
+    //! @param rBlockSize ... number of rows and columns of a block, e.g. the dimension for displacements
+    const SparseMatrixBSR& GetCompressedBSR(int rBlockSize) const;
+
+    //! @brief returns a number that identifies the values of the matrix, e.g. to reuse a factorization
+    //! @remark It changes after each non-const access to the matrix. The numbers are unique among all block sparse
+    //! matrices, a copy gets a new one. References to submatrices from the non-const operator() must not be kept to
+    //! modify the matrix after this call.
+    unsigned long GetValueRevision() const;
+
+    //! @brief returns a number that identifies the sparsity pattern of the last compressed matrix (GetCompressed,
+    //! GetEigenSparseMatrixView, GetCompressedBSR), e.g. to reuse a symbolic analysis
+    //! @remark It changes whenever the row index or the columns of the compressed matrix change, but not with the
+    //! indexing. The numbers are unique among all block sparse matrices. A change between the symmetric and the
+    //! general format of GetCompressed also changes it.
+    unsigned long GetCompressedPatternRevision() const
+    {
+        return mCompressedPatternRevision;
+    }
 #endif
 
 
@@ -149,6 +191,34 @@ private:
             mData;
 
     bool mCanBeSymmetric;
+
+    //! @brief marks the values as modified, see GetValueRevision
+    //! @remark called concurrently in a parallel assembly, the flag is only written once
+    void SetModified()
+    {
+        if (not mIsModified.load(std::memory_order_relaxed))
+            mIsModified.store(true, std::memory_order_relaxed);
+    }
+
+    //! @brief returns a new revision number, unique among all block sparse matrices
+    static unsigned long NewRevision();
+
+    //! @brief see GetValueRevision
+    mutable std::atomic<bool> mIsModified{true};
+    mutable unsigned long mValueRevision = 0;
+
+    //! @brief updates mCompressed from the submatrices
+    //! @param rSymmetric ... true to store the upper triangle of a single symmetric dof type
+    //! @param rOneBasedIndexing ... indexing of the compressed matrix
+    void UpdateCompressed(bool rSymmetric, bool rOneBasedIndexing) const;
+
+    //! @brief compressed matrix of the active dofs, see GetCompressed
+    mutable std::unique_ptr<SparseMatrixCSR<double>> mCompressed;
+    mutable bool mCompressedIsSymmetric = false;
+    mutable unsigned long mCompressedPatternRevision = 0;
+
+    //! @brief block compressed matrix of the active dofs, see GetCompressedBSR
+    mutable std::unique_ptr<SparseMatrixBSR> mCompressedBSR;
 };
 
 } /* namespace NuTo */
@@ -46,10 +46,13 @@ void NuTo::ContinuumBoundaryElement<TDim>::Evaluate(
         const ConstitutiveInputMap& rInput,
         std::map<Element::eOutput, std::shared_ptr<ElementOutputBase>>& rElementOutput)
 {
+    auto constitutiveOutput = GetConstitutiveOutputMap(rElementOutput);
+    if (not RequiresIntegration(rElementOutput))
+        return;
+
     EvaluateDataContinuumBoundary<TDim> data;
     ExtractAllNecessaryDofValues(data);
 
-    auto constitutiveOutput = GetConstitutiveOutputMap(rElementOutput);
     auto constitutiveInput = GetConstitutiveInputMap(constitutiveOutput);
     constitutiveInput.Merge(rInput);
 
@@ -1,6 +1,8 @@
 #include <iostream>
+#include <typeinfo>
 
 #include "mechanics/elements/ContinuumElement.h"
+#include "mechanics/elements/ContinuumKinematics.h"
 #include "mechanics/nodes/NodeBase.h"
 #include "mechanics/nodes/NodeEnum.h"
 
@@ -16,6 +18,7 @@
 #include "mechanics/elements/IpDataEnum.h"
 #include "mechanics/elements/ElementEnum.h"
 #include "mechanics/elements/EvaluateDataContinuum.h"
+#include "mechanics/elements/EvaluateWorkspaceContinuum.h"
 
 #include "mechanics/dofSubMatrixStorage/DofStatus.h"
 #include "mechanics/dofSubMatrixStorage/BlockFullVector.h"
@@ -48,9 +51,128 @@ void NuTo::ContinuumElement<TDim>::Evaluate(
     if ((TDim == 1 || TDim == 2) && (mSection == nullptr))
         throw Exception(__PRETTY_FUNCTION__, "No section allocated for element.");
 
-    EvaluateDataContinuum<TDim> data;
+    // The workspace keeps its memory after the evaluation. Consecutive evaluations on the same thread (e.g. in the
+    // assembly) reuse it and do not allocate memory, which also avoids the contention of the threads in malloc.
+    static thread_local EvaluateWorkspaceContinuum<TDim> threadWorkspace;
+    if (threadWorkspace.mInUse)
+    {
+        EvaluateWorkspaceContinuum<TDim> workspace;
+        EvaluateWithWorkspace(rInput, rElementOutput, workspace);
+        return;
+    }
+
+    threadWorkspace.mInUse = true;
+    try
+    {
+        EvaluateWithWorkspace(rInput, rElementOutput, threadWorkspace);
+    }
+    catch (...)
+    {
+        threadWorkspace.mInUse = false;
+        throw;
+    }
+    threadWorkspace.mInUse = false;
+}
+
+template <int TDim>
+void NuTo::ContinuumElement<TDim>::EvaluateWithWorkspace(
+        const ConstitutiveInputMap& rInput,
+        std::map<Element::eOutput, std::shared_ptr<ElementOutputBase>>& rElementOutput,
+        EvaluateWorkspaceContinuum<TDim>& rWorkspace)
+{
+    PrepareWorkspace(rInput, rElementOutput, rWorkspace);
+    if (not RequiresIntegration(rElementOutput))
+        return;
+
+    if (rWorkspace.mSumFactorization)
+    {
+        EvaluateSumFactorization(rElementOutput, rWorkspace);
+        return;
+    }
+
+    // derived elements, e.g. Element1DInXD, change the element outputs
+    if (rWorkspace.mFixedSizeKernel != nullptr and typeid(*this) == typeid(ContinuumElement<TDim>))
+    {
+        EvaluateFixedSize(rElementOutput, rWorkspace);
+        return;
+    }
+
+    EvaluateDataContinuum<TDim>& data = rWorkspace.mData;
+    data.mTotalMass = 0;
     ExtractAllNecessaryDofValues(data);
 
+    auto& constitutiveInput = rWorkspace.mConstitutiveInput;
+    auto& constitutiveOutput = rWorkspace.mConstitutiveOutput;
+
+    for (int theIP = 0; theIP < GetNumIntegrationPoints(); theIP++)
+    {
+        CalculateNMatrixBMatrixDetJacobian(data, theIP);
+        CalculateConstitutiveInputs(constitutiveInput, data);
+
+        EvaluateConstitutiveLaw<TDim>(constitutiveInput, constitutiveOutput, theIP);
+        CalculateElementOutputs(rElementOutput, data, theIP, constitutiveInput, constitutiveOutput);
+    }
+}
+
+template <int TDim>
+bool NuTo::ContinuumElement<TDim>::IsWorkspaceReusable(
+        const ConstitutiveInputMap& rInput,
+        const std::map<Element::eOutput, std::shared_ptr<ElementOutputBase>>& rElementOutput,
+        const EvaluateWorkspaceContinuum<TDim>& rWorkspace) const
+{
+    if (not rWorkspace.mIsValid or rWorkspace.mStructureGeneration != mStructureGeneration or
+        rWorkspace.mConfigurationGeneration != GetStructureConfigurationGeneration())
+        return false;
+
+    // the weak pointer keeps the control block alive, a new section can not have the same owner
+    const bool isSameSection =
+            not rWorkspace.mSection.owner_before(mSection) and not mSection.owner_before(rWorkspace.mSection);
+    if (rWorkspace.mInterpolationType != mInterpolationType or rWorkspace.mIntegrationType != &GetIntegrationType() or
+        rWorkspace.mConstitutiveLaw != &GetConstitutiveLaw(0) or not isSameSection or
+        rWorkspace.mActiveDofs != mDofStatus.GetActiveDofTypes())
+        return false;
+
+    if (rWorkspace.mElementOutputs.size() != rElementOutput.size() or rWorkspace.mInputs.size() != rInput.size())
+        return false;
+
+    auto itOutput = rWorkspace.mElementOutputs.begin();
+    for (const auto& output : rElementOutput)
+    {
+        // the required constitutive outputs depend on the content of the ip data
+        if (output.first == Element::eOutput::IP_DATA)
+            return false;
+        if (itOutput->first != output.first or itOutput->second != output.second.get())
+            return false;
+        ++itOutput;
+    }
+
+    auto itInput = rWorkspace.mInputs.begin();
+    for (const auto& input : rInput)
+    {
+        if (*itInput != input.first)
+            return false;
+        ++itInput;
+    }
+    return true;
+}
+
+template <int TDim>
+void NuTo::ContinuumElement<TDim>::PrepareWorkspace(
+        const ConstitutiveInputMap& rInput,
+        std::map<Element::eOutput, std::shared_ptr<ElementOutputBase>>& rElementOutput,
+        EvaluateWorkspaceContinuum<TDim>& rWorkspace) const
+{
+    if (IsWorkspaceReusable(rInput, rElementOutput, rWorkspace))
+    {
+        // same keys, no new objects are created. The element outputs are resized, the inputs updated.
+        FillConstitutiveOutputMap(rElementOutput, rWorkspace.mConstitutiveOutput);
+        rWorkspace.mConstitutiveInput.CopyValues(rInput);
+        return;
+    }
+
+    rWorkspace.mIsValid = false;
+    rWorkspace.mData = EvaluateDataContinuum<TDim>();
+
     auto constitutiveOutput = GetConstitutiveOutputMap(rElementOutput);
     auto constitutiveInput = GetConstitutiveInputMap(constitutiveOutput);
 
@@ -59,14 +181,453 @@ void NuTo::ContinuumElement<TDim>::Evaluate(
 
     constitutiveInput.Merge(rInput);
 
+    rWorkspace.mConstitutiveOutput.swap(constitutiveOutput);
+    rWorkspace.mConstitutiveInput.swap(constitutiveInput);
+
     for (int theIP = 0; theIP < GetNumIntegrationPoints(); theIP++)
+        rWorkspace.mData.mIPCoordinates.push_back(GetIntegrationType().GetLocalIntegrationPointCoordinates(theIP));
+
+    // the hessian is only supported by the fixed-size kernel
+    bool outputsSupported = true;
+    bool hessianRequested = false;
+    for (const auto& output : rElementOutput)
     {
-        CalculateNMatrixBMatrixDetJacobian(data, theIP);
-        CalculateConstitutiveInputs(constitutiveInput, data);
+        switch (output.first)
+        {
+        case Element::eOutput::INTERNAL_GRADIENT:
+        case Element::eOutput::UPDATE_STATIC_DATA:
+        case Element::eOutput::UPDATE_TMP_STATIC_DATA:
+        case Element::eOutput::GLOBAL_ROW_DOF:
+        case Element::eOutput::GLOBAL_COLUMN_DOF:
+            break;
+        case Element::eOutput::HESSIAN_0_TIME_DERIVATIVE:
+            hessianRequested = true;
+            break;
+        default:
+            outputsSupported = false;
+        }
+    }
+    PrepareSumFactorization(outputsSupported and not hessianRequested, rWorkspace);
+    PrepareFixedSizeKernel(outputsSupported and not rWorkspace.mSumFactorization, rWorkspace);
+
+    StoreWorkspaceConfiguration(rInput, rElementOutput, rWorkspace);
+}
+
+template <int TDim>
+void NuTo::ContinuumElement<TDim>::StoreWorkspaceConfiguration(
+        const ConstitutiveInputMap& rInput,
+        const std::map<Element::eOutput, std::shared_ptr<ElementOutputBase>>& rElementOutput,
+        EvaluateWorkspaceContinuum<TDim>& rWorkspace) const
+{
+    rWorkspace.mInterpolationType = mInterpolationType;
+    rWorkspace.mIntegrationType = &GetIntegrationType();
+    rWorkspace.mConstitutiveLaw = &GetConstitutiveLaw(0);
+    rWorkspace.mSection = mSection;
+    rWorkspace.mStructureGeneration = mStructureGeneration;
+    rWorkspace.mConfigurationGeneration = GetStructureConfigurationGeneration();
+    rWorkspace.mActiveDofs = mDofStatus.GetActiveDofTypes();
+    rWorkspace.mElementOutputs.clear();
+    for (const auto& output : rElementOutput)
+        rWorkspace.mElementOutputs.emplace_back(output.first, output.second.get());
+    rWorkspace.mInputs.clear();
+    for (const auto& input : rInput)
+        rWorkspace.mInputs.push_back(input.first);
+    rWorkspace.mIsValid = true;
+}
+
+template <int TDim>
+bool NuTo::ContinuumElement<TDim>::IsStrainDrivenConfiguration(const EvaluateWorkspaceContinuum<TDim>& rWorkspace) const
+{
+    for (auto dof : mInterpolationType->GetDofs())
+        if (dof != Node::eDof::COORDINATES and dof != Node::eDof::DISPLACEMENTS)
+            return false;
+    if (not mInterpolationType->IsDof(Node::eDof::DISPLACEMENTS) or
+        not mInterpolationType->IsActive(Node::eDof::DISPLACEMENTS) or
+        mDofStatus.GetActiveDofTypes().count(Node::eDof::DISPLACEMENTS) == 0)
+        return false;
+
+    for (const auto& input : rWorkspace.mConstitutiveInput)
+    {
+        switch (input.first)
+        {
+        case Constitutive::eInput::ENGINEERING_STRAIN:
+        case Constitutive::eInput::TIME:
+        case Constitutive::eInput::TIME_STEP:
+        case Constitutive::eInput::CALCULATE_STATIC_DATA:
+        case Constitutive::eInput::CALCULATE_INITIALIZE_VALUE_RATES:
+        case Constitutive::eInput::PLANE_STATE:
+            break;
+        default:
+            return false;
+        }
+    }
+
+    for (const auto& output : rWorkspace.mConstitutiveOutput)
+    {
+        switch (output.first)
+        {
+        case Constitutive::eOutput::ENGINEERING_STRESS:
+        case Constitutive::eOutput::D_ENGINEERING_STRESS_D_ENGINEERING_STRAIN:
+        case Constitutive::eOutput::UPDATE_STATIC_DATA:
+        case Constitutive::eOutput::UPDATE_TMP_STATIC_DATA:
+        case Constitutive::eOutput::TANGENT_STATE:
+            break;
+        default:
+            return false;
+        }
+    }
+    return true;
+}
+
+template <int TDim>
+void NuTo::ContinuumElement<TDim>::PrepareFixedSizeKernel(bool rOutputsSupported,
+                                                          EvaluateWorkspaceContinuum<TDim>& rWorkspace) const
+{
+    rWorkspace.mFixedSizeKernel.reset();
+    if (not rOutputsSupported or not IsStrainDrivenConfiguration(rWorkspace))
+        return;
+
+    rWorkspace.mFixedSizeKernel = FixedSizeKernelBase<TDim>::Create(
+            mInterpolationType->Get(Node::eDof::COORDINATES), mInterpolationType->Get(Node::eDof::DISPLACEMENTS),
+            GetIntegrationType());
+}
+
+template <int TDim>
+void NuTo::ContinuumElement<TDim>::PrepareSumFactorization(bool rOutputsSupported,
+                                                           EvaluateWorkspaceContinuum<TDim>& rWorkspace) const
+{
+    rWorkspace.mSumFactorization = false;
+    rWorkspace.mKernelDisplacements.reset();
+    rWorkspace.mKernelCoordinates.reset();
+
+    if (TDim == 1 or not rOutputsSupported or not IsStrainDrivenConfiguration(rWorkspace))
+        return;
+
+    rWorkspace.mKernelDisplacements =
+            TensorProductKernel<TDim>::Create(mInterpolationType->Get(Node::eDof::DISPLACEMENTS), GetIntegrationType());
+    rWorkspace.mKernelCoordinates =
+            TensorProductKernel<TDim>::Create(mInterpolationType->Get(Node::eDof::COORDINATES), GetIntegrationType());
+
+    // linear elements are evaluated faster with the full shape function matrices
+    rWorkspace.mSumFactorization = rWorkspace.mKernelDisplacements != nullptr and
+                                   rWorkspace.mKernelCoordinates != nullptr and
+                                   rWorkspace.mKernelDisplacements->GetNumNodes1D() > 2;
+}
+
+namespace
+{
+//! @brief returns the gradient at integration point rTheIP, stored as in TensorProductKernel::Gradient
+template <int TDim>
+Eigen::Matrix<double, TDim, TDim> GradientAtIP(const Eigen::MatrixXd& rGradients, int rTheIP)
+{
+    Eigen::Matrix<double, TDim, TDim> gradient;
+    for (int component = 0; component < TDim; ++component)
+        for (int d = 0; d < TDim; ++d)
+            gradient(component, d) = rGradients(rTheIP, component * TDim + d);
+    return gradient;
+}
+
+//! @brief stores rFlux at integration point rTheIP, as in TensorProductKernel::AddIntegratedGradient
+template <int TDim>
+void SetFluxAtIP(const Eigen::Matrix<double, TDim, TDim>& rFlux, int rTheIP, Eigen::MatrixXd& rFluxes)
+{
+    for (int component = 0; component < TDim; ++component)
+        for (int d = 0; d < TDim; ++d)
+            rFluxes(rTheIP, component * TDim + d) = rFlux(component, d);
+}
+} // namespace
+
+template <int TDim>
+void NuTo::ContinuumElement<TDim>::CalculateGradientsSumFactorization(
+        EvaluateWorkspaceContinuum<TDim>& rWorkspace) const
+{
+    auto& nodalValues = rWorkspace.mData.mNodalValues;
+    ExtractNodeValues(0, Node::eDof::COORDINATES, nodalValues[Node::eDof::COORDINATES]);
+    rWorkspace.mKernelCoordinates->Gradient(nodalValues[Node::eDof::COORDINATES], TDim,
+                                            rWorkspace.mCoordinateGradients);
+
+    if (rWorkspace.mConstitutiveInput.find(Constitutive::eInput::ENGINEERING_STRAIN) ==
+        rWorkspace.mConstitutiveInput.end())
+        return;
+    ExtractNodeValues(0, Node::eDof::DISPLACEMENTS, nodalValues[Node::eDof::DISPLACEMENTS]);
+    rWorkspace.mKernelDisplacements->Gradient(nodalValues[Node::eDof::DISPLACEMENTS], TDim,
+                                              rWorkspace.mDisplacementGradients);
+}
+
+template <int TDim>
+double NuTo::ContinuumElement<TDim>::CalculateConstitutiveInputsSumFactorization(
+        EvaluateWorkspaceContinuum<TDim>& rWorkspace, int rTheIP, Eigen::Matrix<double, TDim, TDim>& rInvJacobian) const
+{
+    const Eigen::Matrix<double, TDim, TDim> jacobian = GradientAtIP<TDim>(rWorkspace.mCoordinateGradients, rTheIP);
+    const double detJacobian = jacobian.determinant();
+    if (detJacobian == 0)
+        throw Exception(__PRETTY_FUNCTION__, "Determinant of the Jacobian is zero, no inversion possible.");
+    rInvJacobian = jacobian.inverse();
+
+    auto itStrain = rWorkspace.mConstitutiveInput.find(Constitutive::eInput::ENGINEERING_STRAIN);
+    if (itStrain != rWorkspace.mConstitutiveInput.end())
+    {
+        constexpr int VoigtDim = ConstitutiveIOBase::GetVoigtDim(TDim);
+        auto& strain = *static_cast<ConstitutiveVector<VoigtDim>*>(itStrain->second.get());
+        strain.AsVector() = ContinuumKinematics::EngineeringStrainOfGradient<TDim>(
+                GradientAtIP<TDim>(rWorkspace.mDisplacementGradients, rTheIP) * rInvJacobian);
+    }
+    return CalculateDetJxWeightIPxSection(detJacobian, rTheIP);
+}
+
+template <int TDim>
+void NuTo::ContinuumElement<TDim>::EvaluateSumFactorization(
+        std::map<Element::eOutput, std::shared_ptr<ElementOutputBase>>& rElementOutput,
+        EvaluateWorkspaceContinuum<TDim>& rWorkspace)
+{
+    CalculateGradientsSumFactorization(rWorkspace);
+
+    auto itInternalGradient = rElementOutput.find(Element::eOutput::INTERNAL_GRADIENT);
+    const bool calculateInternalGradient = itInternalGradient != rElementOutput.end();
+    const int numIPs = GetNumIntegrationPoints();
+    if (calculateInternalGradient)
+        rWorkspace.mFluxes.resize(numIPs, TDim * TDim);
+
+    Eigen::Matrix<double, TDim, TDim> invJacobian;
+    for (int theIP = 0; theIP < numIPs; theIP++)
+    {
+        const double factor = CalculateConstitutiveInputsSumFactorization(rWorkspace, theIP, invJacobian);
+        EvaluateConstitutiveLaw<TDim>(rWorkspace.mConstitutiveInput, rWorkspace.mConstitutiveOutput, theIP);
+
+        if (not calculateInternalGradient)
+            continue;
+
+        // int sigma : grad(N) dV with grad(N) = dN/dxi * invJ
+        const auto& engineeringStress = *static_cast<EngineeringStress<TDim>*>(
+                rWorkspace.mConstitutiveOutput.at(Constitutive::eOutput::ENGINEERING_STRESS).get());
+        SetFluxAtIP<TDim>(factor * ContinuumKinematics::StressTensor<TDim>(engineeringStress) *
+                                  invJacobian.transpose(),
+                          theIP, rWorkspace.mFluxes);
+    }
+
+    if (calculateInternalGradient)
+        rWorkspace.mKernelDisplacements->AddIntegratedGradient(
+                rWorkspace.mFluxes, TDim,
+                itInternalGradient->second->GetBlockFullVectorDouble()[Node::eDof::DISPLACEMENTS]);
+}
+
+template <int TDim>
+void NuTo::ContinuumElement<TDim>::EvaluateFixedSize(
+        std::map<Element::eOutput, std::shared_ptr<ElementOutputBase>>& rElementOutput,
+        EvaluateWorkspaceContinuum<TDim>& rWorkspace)
+{
+    constexpr int VoigtDim = ConstitutiveIOBase::GetVoigtDim(TDim);
+    auto& kernel = *rWorkspace.mFixedSizeKernel;
+    auto& nodalValues = rWorkspace.mData.mNodalValues;
+    ExtractNodeValues(0, Node::eDof::COORDINATES, nodalValues[Node::eDof::COORDINATES]);
+    ExtractNodeValues(0, Node::eDof::DISPLACEMENTS, nodalValues[Node::eDof::DISPLACEMENTS]);
+    kernel.SetNodeValues(nodalValues[Node::eDof::COORDINATES], nodalValues[Node::eDof::DISPLACEMENTS]);
+
+    auto& constitutiveInput = rWorkspace.mConstitutiveInput;
+    auto& constitutiveOutput = rWorkspace.mConstitutiveOutput;
+
+    auto itStrain = constitutiveInput.find(Constitutive::eInput::ENGINEERING_STRAIN);
+    auto* strain = itStrain == constitutiveInput.end()
+                           ? nullptr
+                           : static_cast<ConstitutiveVector<VoigtDim>*>(itStrain->second.get());
+
+    auto itInternalGradient = rElementOutput.find(Element::eOutput::INTERNAL_GRADIENT);
+    const EngineeringStress<TDim>* stress = nullptr;
+    if (itInternalGradient != rElementOutput.end())
+        stress = static_cast<EngineeringStress<TDim>*>(
+                constitutiveOutput.at(Constitutive::eOutput::ENGINEERING_STRESS).get());
+
+    // the tangent is not requested if the constitutive law can not compute it
+    auto itHessian0 = rElementOutput.find(Element::eOutput::HESSIAN_0_TIME_DERIVATIVE);
+    auto itTangent = constitutiveOutput.find(Constitutive::eOutput::D_ENGINEERING_STRESS_D_ENGINEERING_STRAIN);
+    const ConstitutiveMatrix<VoigtDim, VoigtDim>* tangent = nullptr;
+    if (itHessian0 != rElementOutput.end() and itTangent != constitutiveOutput.end())
+        tangent = static_cast<ConstitutiveMatrix<VoigtDim, VoigtDim>*>(itTangent->second.get());
+
+    const ElementGeometryCache<TDim>* cache = mUseGeometryCache ? &GetGeometryCache() : nullptr;
+    const int derivativeOffset = cache ? cache->GetDerivativeOffset(Node::eDof::DISPLACEMENTS) : 0;
+
+    Eigen::Matrix<double, VoigtDim, 1> strainIP;
+    for (int theIP = 0; theIP < GetNumIntegrationPoints(); theIP++)
+    {
+        double factor;
+        if (cache != nullptr)
+        {
+            const double* block = cache->GetIPBlock(theIP);
+            kernel.CalculateIP(block + derivativeOffset, strainIP);
+            factor = block[ElementGeometryCache<TDim>::DetJxWeightIPxSection];
+        }
+        else
+        {
+            factor = CalculateDetJxWeightIPxSection(kernel.CalculateIP(theIP, strainIP), theIP);
+        }
+        if (strain != nullptr)
+            strain->AsVector() = strainIP;
 
         EvaluateConstitutiveLaw<TDim>(constitutiveInput, constitutiveOutput, theIP);
-        CalculateElementOutputs(rElementOutput, data, theIP, constitutiveInput, constitutiveOutput);
+
+        if (stress != nullptr)
+            kernel.AddInternalGradient(factor, *stress);
+        if (tangent != nullptr)
+            kernel.AddHessian0(factor, *tangent);
+    }
+
+    if (stress != nullptr)
+        kernel.AddInternalGradientTo(
+                itInternalGradient->second->GetBlockFullVectorDouble()[Node::eDof::DISPLACEMENTS]);
+    if (tangent != nullptr)
+        kernel.AddHessian0To(itHessian0->second->GetBlockFullMatrixDouble()(Node::eDof::DISPLACEMENTS,
+                                                                            Node::eDof::DISPLACEMENTS));
+}
+
+template <int TDim>
+bool NuTo::ContinuumElement<TDim>::AddHessian0Product(const ConstitutiveInputMap& rInput,
+                                                      const BlockFullVector<double>& rDofValues, double rFactor,
+                                                      BlockFullVector<double>& rProduct)
+{
+    if ((TDim == 1 || TDim == 2) && (mSection == nullptr))
+        throw Exception(__PRETTY_FUNCTION__, "No section allocated for element.");
+
+    if (not GetConstitutiveLaw(0).CheckDofCombinationComputable(Node::eDof::DISPLACEMENTS, Node::eDof::DISPLACEMENTS,
+                                                                0))
+        return false;
+
+    // a separate workspace, its constitutive outputs differ from the ones of Evaluate
+    static thread_local EvaluateWorkspaceContinuum<TDim> workspace;
+    static const std::map<Element::eOutput, std::shared_ptr<ElementOutputBase>> noElementOutputs;
+    if (IsWorkspaceReusable(rInput, noElementOutputs, workspace))
+    {
+        workspace.mConstitutiveInput.CopyValues(rInput);
+    }
+    else
+    {
+        workspace.mIsValid = false;
+
+        ConstitutiveOutputMap constitutiveOutput;
+        constitutiveOutput[Constitutive::eOutput::D_ENGINEERING_STRESS_D_ENGINEERING_STRAIN] =
+                ConstitutiveIOBase::makeConstitutiveIO<TDim>(
+                        Constitutive::eOutput::D_ENGINEERING_STRESS_D_ENGINEERING_STRAIN);
+        auto constitutiveInput = GetConstitutiveInputMap(constitutiveOutput);
+        if (TDim == 2)
+            AddPlaneStateToInput(constitutiveInput);
+        constitutiveInput.Merge(rInput);
+
+        workspace.mConstitutiveOutput.swap(constitutiveOutput);
+        workspace.mConstitutiveInput.swap(constitutiveInput);
+
+        PrepareSumFactorization(true, workspace);
+        StoreWorkspaceConfiguration(rInput, noElementOutputs, workspace);
+    }
+
+    if (not workspace.mSumFactorization)
+        return false;
+
+    constexpr int VoigtDim = ConstitutiveIOBase::GetVoigtDim(TDim);
+    const auto& kernel = *workspace.mKernelDisplacements;
+    CalculateGradientsSumFactorization(workspace);
+    kernel.Gradient(rDofValues[Node::eDof::DISPLACEMENTS], TDim, workspace.mDirectionGradients);
+
+    const int numIPs = GetNumIntegrationPoints();
+    workspace.mFluxes.resize(numIPs, TDim * TDim);
+
+    Eigen::Matrix<double, TDim, TDim> invJacobian;
+    for (int theIP = 0; theIP < numIPs; theIP++)
+    {
+        const double factor = CalculateConstitutiveInputsSumFactorization(workspace, theIP, invJacobian);
+        EvaluateConstitutiveLaw<TDim>(workspace.mConstitutiveInput, workspace.mConstitutiveOutput, theIP);
+
+        // int grad(N)^T C grad(N) dV * v, applied from right to left
+        const auto& tangent = *static_cast<ConstitutiveMatrix<VoigtDim, VoigtDim>*>(
+                workspace.mConstitutiveOutput.at(Constitutive::eOutput::D_ENGINEERING_STRESS_D_ENGINEERING_STRAIN)
+                        .get());
+        const Eigen::Matrix<double, VoigtDim, 1> stress =
+                tangent * ContinuumKinematics::EngineeringStrainOfGradient<TDim>(
+                                  GradientAtIP<TDim>(workspace.mDirectionGradients, theIP) * invJacobian);
+        SetFluxAtIP<TDim>(rFactor * factor * ContinuumKinematics::StressTensor<TDim>(stress) * invJacobian.transpose(),
+                          theIP, workspace.mFluxes);
+    }
+
+    kernel.AddIntegratedGradient(workspace.mFluxes, TDim, rProduct[Node::eDof::DISPLACEMENTS]);
+    return true;
+}
+
+template <int TDim>
+bool NuTo::ContinuumElement<TDim>::UpdateTangentStates(const ConstitutiveInputMap& rInput)
+{
+    if ((TDim == 1 || TDim == 2) && (mSection == nullptr))
+        throw Exception(__PRETTY_FUNCTION__, "No section allocated for element.");
+
+    const int numIPs = GetNumIntegrationPoints();
+    for (int theIP = 0; theIP < numIPs; theIP++)
+    {
+        if (not GetConstitutiveLaw(theIP).HasTangentState())
+        {
+            mTangentStates.clear();
+            return false;
+        }
     }
+
+    // a separate workspace, its constitutive outputs differ from the ones of Evaluate
+    static thread_local EvaluateWorkspaceContinuum<TDim> workspace;
+    static const std::map<Element::eOutput, std::shared_ptr<ElementOutputBase>> noElementOutputs;
+    if (IsWorkspaceReusable(rInput, noElementOutputs, workspace))
+    {
+        workspace.mConstitutiveInput.CopyValues(rInput);
+    }
+    else
+    {
+        workspace.mIsValid = false;
+        workspace.mData = EvaluateDataContinuum<TDim>();
+
+        ConstitutiveOutputMap constitutiveOutput;
+        constitutiveOutput[Constitutive::eOutput::TANGENT_STATE] =
+                ConstitutiveIOBase::makeConstitutiveIO<TDim>(Constitutive::eOutput::TANGENT_STATE);
+        auto constitutiveInput = GetConstitutiveInputMap(constitutiveOutput);
+        if (TDim == 2)
+            AddPlaneStateToInput(constitutiveInput);
+        constitutiveInput.Merge(rInput);
+
+        workspace.mConstitutiveOutput.swap(constitutiveOutput);
+        workspace.mConstitutiveInput.swap(constitutiveInput);
+
+        for (int theIP = 0; theIP < numIPs; theIP++)
+            workspace.mData.mIPCoordinates.push_back(GetIntegrationType().GetLocalIntegrationPointCoordinates(theIP));
+        StoreWorkspaceConfiguration(rInput, noElementOutputs, workspace);
+    }
+
+    // the tangent states only describe D_ENGINEERING_STRESS_D_ENGINEERING_STRAIN
+    if (not IsStrainDrivenConfiguration(workspace))
+    {
+        mTangentStates.clear();
+        return false;
+    }
+
+    // e.g. the tangent state of linear elastic laws does not depend on the strain
+    EvaluateDataContinuum<TDim>& data = workspace.mData;
+    const bool isStrainRequired =
+            workspace.mConstitutiveInput.find(Constitutive::eInput::ENGINEERING_STRAIN) !=
+            workspace.mConstitutiveInput.end();
+    if (isStrainRequired)
+        ExtractAllNecessaryDofValues(data);
+
+    const ConstitutiveIOBase& tangentState = *workspace.mConstitutiveOutput.at(Constitutive::eOutput::TANGENT_STATE);
+    bool isUnchanged = mTangentStates.size() == static_cast<unsigned>(numIPs);
+    mTangentStates.resize(numIPs);
+    for (int theIP = 0; theIP < numIPs; theIP++)
+    {
+        if (isStrainRequired)
+        {
+            CalculateNMatrixBMatrixDetJacobian(data, theIP);
+            CalculateConstitutiveInputs(workspace.mConstitutiveInput, data);
+        }
+        EvaluateConstitutiveLaw<TDim>(workspace.mConstitutiveInput, workspace.mConstitutiveOutput, theIP);
+
+        // NaN, the tangent depends on the strain, compares unequal
+        const std::pair<const ConstitutiveBase*, double> state(&GetConstitutiveLaw(theIP), tangentState[0]);
+        isUnchanged = isUnchanged and state == mTangentStates[theIP];
+        mTangentStates[theIP] = state;
+    }
+    return isUnchanged;
 }
 
 template <int TDim>
@@ -78,34 +639,41 @@ void NuTo::ContinuumElement<TDim>::ExtractAllNecessaryDofValues(EvaluateDataCont
     const std::set<Node::eDof>& dofs = mInterpolationType->GetDofs();
     for (auto dof : dofs)
         if (mInterpolationType->IsConstitutiveInput(dof))
-            data.mNodalValues[dof] = ExtractNodeValues(0, dof);
+            ExtractNodeValues(0, dof, data.mNodalValues[dof]);
 
-    data.mNodalValues[Node::eDof::COORDINATES] = ExtractNodeValues(0, Node::eDof::COORDINATES);
+    ExtractNodeValues(0, Node::eDof::COORDINATES, data.mNodalValues[Node::eDof::COORDINATES]);
 
     for (auto dof : dofs)
         if (mInterpolationType->IsConstitutiveInput(dof))
             if (GetNode(0)->GetNumTimeDerivatives(dof) >= 1)
-                data.mNodalValues_dt1[dof] = ExtractNodeValues(1, dof);
+                ExtractNodeValues(1, dof, data.mNodalValues_dt1[dof]);
 }
 
 template <int TDim>
 Eigen::VectorXd NuTo::ContinuumElement<TDim>::ExtractNodeValues(int rTimeDerivative, Node::eDof rDofType) const
+{
+    Eigen::VectorXd nodalValues;
+    ExtractNodeValues(rTimeDerivative, rDofType, nodalValues);
+    return nodalValues;
+}
+
+template <int TDim>
+void NuTo::ContinuumElement<TDim>::ExtractNodeValues(int rTimeDerivative, Node::eDof rDofType,
+                                                     Eigen::VectorXd& rNodalValues) const
 {
     const InterpolationBase& interpolationTypeDof = GetInterpolationType().Get(rDofType);
 
     int numNodes = interpolationTypeDof.GetNumNodes();
     int numDofsPerNode = NuTo::Node::GetNumComponents(rDofType, TDim);
 
-    Eigen::VectorXd nodalValues(numDofsPerNode * numNodes);
+    rNodalValues.resize(numDofsPerNode * numNodes);
 
     for (int iNode = 0; iNode < numNodes; ++iNode)
     {
         const NodeBase& node = *GetNode(iNode, rDofType);
 
-        nodalValues.block(iNode * numDofsPerNode, 0, numDofsPerNode, 1) = node.Get(rDofType, rTimeDerivative);
+        rNodalValues.segment(iNode * numDofsPerNode, numDofsPerNode) = node.Get(rDofType, rTimeDerivative);
     }
-
-    return nodalValues;
 }
 
 template <int TDim>
@@ -128,9 +696,23 @@ NuTo::ConstitutiveOutputMap NuTo::ContinuumElement<TDim>::GetConstitutiveOutputM
         std::map<Element::eOutput, std::shared_ptr<ElementOutputBase>>& rElementOutput) const
 {
     ConstitutiveOutputMap constitutiveOutput;
+    FillConstitutiveOutputMap(rElementOutput, constitutiveOutput);
+
+    // allocate the objects for the output data
+    for (auto& outputs : constitutiveOutput)
+    {
+        outputs.second = ConstitutiveIOBase::makeConstitutiveIO<TDim>(outputs.first);
+    }
+    return constitutiveOutput;
+}
 
+template <int TDim>
+void NuTo::ContinuumElement<TDim>::FillConstitutiveOutputMap(
+        std::map<Element::eOutput, std::shared_ptr<ElementOutputBase>>& rElementOutput,
+        ConstitutiveOutputMap& constitutiveOutput) const
+{
     // find the outputs we need
-    for (auto it : rElementOutput)
+    for (const auto& it : rElementOutput)
     {
         switch (it.first)
         {
@@ -188,13 +770,6 @@ NuTo::ConstitutiveOutputMap NuTo::ContinuumElement<TDim>::GetConstitutiveOutputM
             throw Exception(__PRETTY_FUNCTION__, "element output not implemented.");
         }
     }
-
-    // allocate the objects for the output data
-    for (auto& outputs : constitutiveOutput)
-    {
-        outputs.second = ConstitutiveIOBase::makeConstitutiveIO<TDim>(outputs.first);
-    }
-    return constitutiveOutput;
 }
 
 template <int TDim>
@@ -564,7 +1139,7 @@ void NuTo::ContinuumElement<TDim>::CalculateConstitutiveInputs(ConstitutiveInput
         case Constitutive::eInput::ENGINEERING_STRAIN:
         {
             auto& strain = *static_cast<ConstitutiveVector<VoigtDim>*>(it.second.get());
-            strain.AsVector() =
+            strain.AsVector().noalias() =
                     rData.mB.at(Node::eDof::DISPLACEMENTS) * rData.mNodalValues.at(Node::eDof::DISPLACEMENTS);
             break;
         }
@@ -693,15 +1268,16 @@ NuTo::ContinuumElement<TDim>::CalculateJacobian(const Eigen::MatrixXd& rDerivati
 
     assert(rNodeCoordinates.rows() == TDim * GetNumNodes(Node::eDof::COORDINATES));
 
-    Eigen::Matrix<double, TDim, Eigen::Dynamic> nodeBlockCoordinates(TDim, numCoordinateNodes);
-    // convert the coordinates to a block structure
+    // J = sum_i x_i * dN_i, without a temporary block matrix of the node coordinates
     // x0  x1  x1  x2 ...
     // y0  y1  y2  y3 ...
     // z0  z1  z2  z3 ...
+    Eigen::Matrix<double, TDim, TDim> jacobian = Eigen::Matrix<double, TDim, TDim>::Zero();
     for (int i = 0; i < numCoordinateNodes; ++i)
-        nodeBlockCoordinates.col(i) = rNodeCoordinates.block<TDim, 1>(TDim * i, 0);
+        jacobian.noalias() += rNodeCoordinates.template segment<TDim>(TDim * i) *
+                              rDerivativeShapeFunctions.row(i).template head<TDim>();
 
-    return nodeBlockCoordinates.lazyProduct(rDerivativeShapeFunctions);
+    return jacobian;
 }
 
 template <int TDim>
@@ -715,55 +1291,70 @@ Eigen::MatrixXd
 NuTo::ContinuumElement<TDim>::CalculateMatrixB(Node::eDof rDofType, const Eigen::MatrixXd& rDerivativeShapeFunctions,
                                                const Eigen::Matrix<double, TDim, TDim> rInvJacobian) const
 {
-    assert(rDerivativeShapeFunctions.rows() == GetNumNodes(rDofType));
-    assert(rDerivativeShapeFunctions.cols() == TDim);
-
-
     Eigen::MatrixXd Bmat;
+    CalculateMatrixB(rDofType, rDerivativeShapeFunctions, rInvJacobian, Bmat);
+    return Bmat;
+}
+
+template <int TDim>
+template <typename TDerivatives>
+void NuTo::ContinuumElement<TDim>::CalculateMatrixBFromDerivatives(Node::eDof rDofType, int rNumNodes,
+                                                                   const TDerivatives& rDerivatives,
+                                                                   Eigen::MatrixXd& rBMatrix) const
+{
+    // the derivatives of each node
+    // N0,x  N0,y  N0,z
+    // N1,x  N1,y  N1,z
+    // ...   ...   ...
     switch (rDofType)
     {
     case Node::eDof::COORDINATES: // makes no sense, but is an example for gradient operator of vector valued dof type.
     {
-        auto tmp = rDerivativeShapeFunctions.lazyProduct(rInvJacobian);
-        /*   N0,x  N0,y  N0,z
-         *   N1,x  N1,y  N1,z
-         *   ...   ...   ...   */
-
-        int numRows = rDerivativeShapeFunctions.rows();
-
-        assert(tmp.cols() == TDim);
-        assert(tmp.rows() == numRows);
-
-        Bmat.resize(TDim, numRows * TDim);
-        Bmat.setZero();
         /*
          * transform to:
          *  N0,x   0    0    N1,x   0    0  ...
          *    0  N0,y   0      0  N1,y   0  ...
          *    0    0  N0,z     0    0  N1,z ...    */
-
-        for (int i = 0; i < numRows; ++i)
+        rBMatrix.setZero(TDim, rNumNodes * TDim);
+        for (int i = 0; i < rNumNodes; ++i)
+        {
+            const Eigen::Matrix<double, 1, TDim> derivatives = rDerivatives(i);
             for (int iDim = 0; iDim < TDim; ++iDim)
-                Bmat(iDim, TDim * i) = tmp(i, iDim);
-
+                rBMatrix(iDim, TDim * i) = derivatives(iDim);
+        }
         break;
     }
     case Node::eDof::DISPLACEMENTS:
     {
-        Bmat = rDerivativeShapeFunctions.lazyProduct(rInvJacobian);
-        BlowToBMatrixEngineeringStrain(Bmat);
+        rBMatrix.setZero(TDim * (TDim + 1) / 2, rNumNodes * TDim);
+        for (int i = 0; i < rNumNodes; ++i)
+            BlowToBMatrixEngineeringStrain(rDerivatives(i), i, rBMatrix);
         break;
     }
     default: // gradient for a scalar dof type
     {
-        Bmat = rDerivativeShapeFunctions.lazyProduct(rInvJacobian).transpose();
-        assert(Bmat.cols() == GetNumNodes(rDofType));
-        assert(Bmat.rows() == TDim);
+        rBMatrix.resize(TDim, rNumNodes);
+        for (int i = 0; i < rNumNodes; ++i)
+            rBMatrix.col(i) = rDerivatives(i).transpose();
         break;
     }
     }
+}
 
-    return Bmat;
+template <int TDim>
+void NuTo::ContinuumElement<TDim>::CalculateMatrixB(Node::eDof rDofType,
+                                                    const Eigen::MatrixXd& rDerivativeShapeFunctions,
+                                                    const Eigen::Matrix<double, TDim, TDim>& rInvJacobian,
+                                                    Eigen::MatrixXd& rBMatrix) const
+{
+    assert(rDerivativeShapeFunctions.rows() == GetNumNodes(rDofType));
+    assert(rDerivativeShapeFunctions.cols() == TDim);
+
+    // the derivatives are transformed node by node with fixed size products
+    auto derivatives = [&](int rNode) -> Eigen::Matrix<double, 1, TDim> {
+        return rDerivativeShapeFunctions.row(rNode).template head<TDim>() * rInvJacobian;
+    };
+    CalculateMatrixBFromDerivatives(rDofType, rDerivativeShapeFunctions.rows(), derivatives, rBMatrix);
 }
 
 template <int TDim>
@@ -772,9 +1363,7 @@ void NuTo::ContinuumElement<TDim>::CalculateElementOutputs(
         EvaluateDataContinuum<TDim>& rData, int rTheIP, const ConstitutiveInputMap& constitutiveInput,
         const ConstitutiveOutputMap& constitutiveOutput) const
 {
-    rData.mDetJxWeightIPxSection =
-            CalculateDetJxWeightIPxSection(rData.mDetJacobian, rTheIP); // formerly known as "factor"
-    const auto ipCoords = GetIntegrationType().GetLocalIntegrationPointCoordinates(rTheIP);
+    const Eigen::VectorXd& ipCoords = rData.mIPCoordinates[rTheIP];
     for (auto it : rElementOutput)
     {
         switch (it.first)
@@ -875,7 +1464,7 @@ void NuTo::ContinuumElement<TDim>::CalculateElementOutputInternalGradient(
         {
             const auto& engineeringStress = *static_cast<EngineeringStress<TDim>*>(
                     constitutiveOutput.at(Constitutive::eOutput::ENGINEERING_STRESS).get());
-            rInternalGradient[dofRow] +=
+            rInternalGradient[dofRow].noalias() +=
                     rData.mDetJxWeightIPxSection * rData.mB.at(dofRow).transpose() * engineeringStress;
             break;
         }
@@ -984,8 +1573,9 @@ void NuTo::ContinuumElement<TDim>::CalculateElementOutputHessian0(BlockFullMatri
             {
                 const auto& tangentStressStrain = *static_cast<ConstitutiveMatrix<VoigtDim, VoigtDim>*>(
                         constitutiveOutput.at(Constitutive::eOutput::D_ENGINEERING_STRESS_D_ENGINEERING_STRAIN).get());
-                hessian0 += rData.mDetJxWeightIPxSection * rData.mB.at(dofRow).transpose() * tangentStressStrain *
-                            rData.mB.at(dofRow);
+                const auto& B = rData.mB.at(dofRow);
+                rData.mProduct.noalias() = rData.mDetJxWeightIPxSection * B.transpose() * tangentStressStrain;
+                hessian0.noalias() += rData.mProduct * B;
                 break;
             }
             case Node::CombineDofs(Node::eDof::DISPLACEMENTS, Node::eDof::NONLOCALEQSTRAIN):
@@ -1284,7 +1874,7 @@ void NuTo::ContinuumElement<TDim>::CalculateElementOutputHessian2(BlockFullMatri
                 const auto& N = *(rData.GetNMatrix(dofRow));
                 double rho =
                         GetConstitutiveLaw(rTheIP).GetParameterDouble(Constitutive::eConstitutiveParameter::DENSITY);
-                hessian2 += rho * N.transpose() * N * rData.mDetJxWeightIPxSection;
+                hessian2.noalias() += (rho * rData.mDetJxWeightIPxSection) * N.transpose() * N;
 
                 break;
             }
@@ -1422,6 +2012,8 @@ void NuTo::ContinuumElement<TDim>::SetNode(int rLocalNodeNumber, NodeBase* rNode
     assert(rLocalNodeNumber < mInterpolationType->GetNumNodes());
     assert(rNode != nullptr);
     mNodes[rLocalNodeNumber] = rNode;
+    mGeometryCache.Clear();
+    mTangentStates.clear();
 }
 
 template <int TDim>
@@ -1434,6 +2026,8 @@ void NuTo::ContinuumElement<TDim>::ResizeNodes(int rNewNumNodes)
     {
         // just resize (enlarge)
         mNodes.resize(rNewNumNodes);
+        mGeometryCache.Clear();
+        mTangentStates.clear();
     }
     else
     {
@@ -1446,6 +2040,8 @@ template <int TDim>
 void NuTo::ContinuumElement<TDim>::SetSection(std::shared_ptr<const Section> section)
 {
     mSection = section;
+    mGeometryCache.Clear();
+    mTangentStates.clear();
 }
 
 template <int TDim>
@@ -1526,13 +2122,37 @@ template <int TDim>
 void NuTo::ContinuumElement<TDim>::ExchangeNodePtr(NodeBase* rOldPtr, NodeBase* rNewPtr)
 {
     std::replace(mNodes.begin(), mNodes.end(), rOldPtr, rNewPtr);
+    mGeometryCache.Clear();
+    mTangentStates.clear();
 }
 
 template <int TDim>
 void NuTo::ContinuumElement<TDim>::CalculateNMatrixBMatrixDetJacobian(EvaluateDataContinuum<TDim>& rData,
                                                                       int rTheIP) const
 {
-    const auto ipCoords = GetIntegrationType().GetLocalIntegrationPointCoordinates(rTheIP);
+    const Eigen::VectorXd& ipCoords = rData.mIPCoordinates[rTheIP];
+
+    if (mUseGeometryCache)
+    {
+        const ElementGeometryCache<TDim>& cache = GetGeometryCache();
+        const double* block = cache.GetIPBlock(rTheIP);
+        rData.mDetJacobian = block[ElementGeometryCache<TDim>::DetJacobian];
+        rData.mDetJxWeightIPxSection = block[ElementGeometryCache<TDim>::DetJxWeightIPxSection];
+        for (const auto& offset : cache.mDerivativeOffsets)
+        {
+            const InterpolationBase& interpolationType = mInterpolationType->Get(offset.first);
+            rData.mN[offset.first] = &interpolationType.MatrixN(ipCoords);
+
+            const int numNodes = interpolationType.GetNumNodes();
+            Eigen::Map<const Eigen::Matrix<double, Eigen::Dynamic, TDim>> derivativesGlobal(block + offset.second,
+                                                                                          numNodes, TDim);
+            auto derivatives = [&](int rNode) -> Eigen::Matrix<double, 1, TDim> {
+                return derivativesGlobal.row(rNode);
+            };
+            CalculateMatrixBFromDerivatives(offset.first, numNodes, derivatives, rData.mB[offset.first]);
+        }
+        return;
+    }
 
     // calculate Jacobian
     const Eigen::MatrixXd& derivativeShapeFunctionsGeometryNatural =
@@ -1548,6 +2168,7 @@ void NuTo::ContinuumElement<TDim>::CalculateNMatrixBMatrixDetJacobian(EvaluateDa
     }
 
     Eigen::Matrix<double, TDim, TDim> invJacobian = jacobian.inverse();
+    rData.mDetJxWeightIPxSection = CalculateDetJxWeightIPxSection(rData.mDetJacobian, rTheIP);
 
     // calculate shape functions and their derivatives
     for (auto dof : mInterpolationType->GetDofs())
@@ -1557,83 +2178,135 @@ void NuTo::ContinuumElement<TDim>::CalculateNMatrixBMatrixDetJacobian(EvaluateDa
         const InterpolationBase& interpolationType = mInterpolationType->Get(dof);
         rData.mN[dof] = &interpolationType.MatrixN(ipCoords);
 
-        rData.mB[dof] = CalculateMatrixB(dof, interpolationType.DerivativeShapeFunctionsNatural(ipCoords), invJacobian);
+        CalculateMatrixB(dof, interpolationType.DerivativeShapeFunctionsNatural(ipCoords), invJacobian, rData.mB[dof]);
     }
 }
 
-namespace NuTo // template specialization in *.cpp somehow requires the definition to be in the namespace...
-{
-template <>
-void NuTo::ContinuumElement<1>::BlowToBMatrixEngineeringStrain(Eigen::MatrixXd& rDerivativeShapeFunctions) const
+template <int TDim>
+void NuTo::ContinuumElement<TDim>::SetUseGeometryCache(bool rUseGeometryCache)
 {
-    assert(rDerivativeShapeFunctions.cols() == 1);
-    rDerivativeShapeFunctions.transposeInPlace();
+    mUseGeometryCache = rUseGeometryCache;
+    if (not mUseGeometryCache)
+        mGeometryCache.Clear();
 }
 
-template <>
-void NuTo::ContinuumElement<2>::BlowToBMatrixEngineeringStrain(Eigen::MatrixXd& rDerivativeShapeFunctions) const
+template <int TDim>
+const NuTo::ElementGeometryCache<TDim>& NuTo::ContinuumElement<TDim>::GetGeometryCache() const
 {
-    int numNodes = GetNumNodes(Node::eDof::DISPLACEMENTS);
-    assert(rDerivativeShapeFunctions.cols() == 2);
-    assert(rDerivativeShapeFunctions.rows() == numNodes);
+    const unsigned long geometryGeneration = GetStructureGeometryGeneration();
+    const unsigned long configurationGeneration = GetStructureConfigurationGeneration();
+    const int numDofTypes = mInterpolationType->GetDofs().size();
+    if (mGeometryCache.IsValid(*mInterpolationType, numDofTypes, GetIntegrationType(), geometryGeneration,
+                               configurationGeneration))
+        return mGeometryCache;
+
+    // invalid until it is completely rebuilt
+    ElementGeometryCache<TDim>& cache = mGeometryCache;
+    cache.mInterpolationType = nullptr;
+    cache.mDerivativeOffsets.clear();
+    int blockSize = ElementGeometryCache<TDim>::DetJxWeightIPxSection + 1;
+    for (auto dof : mInterpolationType->GetDofs())
+    {
+        cache.mDerivativeOffsets.push_back(std::make_pair(dof, blockSize));
+        blockSize += mInterpolationType->Get(dof).GetNumNodes() * TDim;
+    }
+    cache.mBlockSize = blockSize;
 
-    Eigen::MatrixXd Bmat = Eigen::MatrixXd::Zero(3, numNodes * 2);
+    const int numIPs = GetNumIntegrationPoints();
+    cache.mData.resize(numIPs * blockSize);
 
-    for (int iNode = 0, iColumn = 0; iNode < numNodes; ++iNode, iColumn += 2)
+    const Eigen::VectorXd coordinates = ExtractNodeValues(0, Node::eDof::COORDINATES);
+    for (int theIP = 0; theIP < numIPs; ++theIP)
     {
-        double dNdX = rDerivativeShapeFunctions(iNode, 0);
-        double dNdY = rDerivativeShapeFunctions(iNode, 1);
-
-        Bmat(0, iColumn) = dNdX;
-        Bmat(1, iColumn + 1) = dNdY;
-        Bmat(2, iColumn) = dNdY;
-        Bmat(2, iColumn + 1) = dNdX;
+        const Eigen::VectorXd ipCoords = GetIntegrationType().GetLocalIntegrationPointCoordinates(theIP);
+        const Eigen::Matrix<double, TDim, TDim> jacobian = CalculateJacobian(
+                mInterpolationType->Get(Node::eDof::COORDINATES).DerivativeShapeFunctionsNatural(ipCoords),
+                coordinates);
+        const double detJacobian = jacobian.determinant();
+        if (detJacobian == 0)
+            throw Exception(__PRETTY_FUNCTION__, "Determinant of the Jacobian is zero, no inversion possible.");
+        const Eigen::Matrix<double, TDim, TDim> invJacobian = jacobian.inverse();
+
+        double* block = cache.mData.data() + theIP * blockSize;
+        block[ElementGeometryCache<TDim>::DetJacobian] = detJacobian;
+        block[ElementGeometryCache<TDim>::DetJxWeightIPxSection] = CalculateDetJxWeightIPxSection(detJacobian, theIP);
+        for (const auto& offset : cache.mDerivativeOffsets)
+        {
+            const InterpolationBase& interpolationType = mInterpolationType->Get(offset.first);
+            Eigen::Map<Eigen::Matrix<double, Eigen::Dynamic, TDim>> derivativesGlobal(
+                    block + offset.second, interpolationType.GetNumNodes(), TDim);
+            derivativesGlobal.noalias() =
+                    interpolationType.DerivativeShapeFunctionsNatural(ipCoords).leftCols(TDim) * invJacobian;
+        }
     }
-    std::swap(rDerivativeShapeFunctions, Bmat);
+
+    cache.mInterpolationType = mInterpolationType;
+    cache.mIntegrationType = &GetIntegrationType();
+    cache.mGeometryGeneration = geometryGeneration;
+    cache.mConfigurationGeneration = configurationGeneration;
+    return cache;
+}
+
+namespace NuTo // template specialization in *.cpp somehow requires the definition to be in the namespace...
+{
+template <>
+void NuTo::ContinuumElement<1>::BlowToBMatrixEngineeringStrain(const Eigen::Matrix<double, 1, 1>& rDerivatives,
+                                                               int rNode, Eigen::MatrixXd& rBMatrix) const
+{
+    rBMatrix(0, rNode) = rDerivatives(0);
 }
 
 template <>
-void NuTo::ContinuumElement<3>::BlowToBMatrixEngineeringStrain(Eigen::MatrixXd& rDerivativeShapeFunctions) const
+void NuTo::ContinuumElement<2>::BlowToBMatrixEngineeringStrain(const Eigen::Matrix<double, 1, 2>& rDerivatives,
+                                                               int rNode, Eigen::MatrixXd& rBMatrix) const
 {
-    int numNodes = GetNumNodes(Node::eDof::DISPLACEMENTS);
-    assert(rDerivativeShapeFunctions.cols() == 3);
-    assert(rDerivativeShapeFunctions.rows() == numNodes);
-    Eigen::MatrixXd Bmat = Eigen::MatrixXd::Zero(6, numNodes * 3);
+    assert(rBMatrix.rows() == 3);
+    const int iColumn = 2 * rNode;
+    const double dNdX = rDerivatives(0);
+    const double dNdY = rDerivatives(1);
+
+    rBMatrix(0, iColumn) = dNdX;
+    rBMatrix(1, iColumn + 1) = dNdY;
+    rBMatrix(2, iColumn) = dNdY;
+    rBMatrix(2, iColumn + 1) = dNdX;
+}
 
-    for (int iNode = 0, iColumn = 0; iNode < numNodes; ++iNode, iColumn += 3)
-    {
-        double dNdX = rDerivativeShapeFunctions(iNode, 0);
-        double dNdY = rDerivativeShapeFunctions(iNode, 1);
-        double dNdZ = rDerivativeShapeFunctions(iNode, 2);
-
-        /* according to Jirásek
-         *
-         *     +0  +1  +2
-         *    -------------
-         * 0 |  dx  0   0  |     - e_x
-         * 1 |  0   dy  0  |     - e_y
-         * 2 |  0   0   dz |     - e_z
-         * 3 |  0   dz  dy |     - g_yz
-         * 4 |  dz  0   dx |     - g_xz
-         * 5 |  dy  dx  0  |     - g_xy
-         *    -------------
-         */
-
-
-        Bmat(0, iColumn) = dNdX;
-        Bmat(1, iColumn + 1) = dNdY;
-        Bmat(2, iColumn + 2) = dNdZ;
-
-        Bmat(3, iColumn + 1) = dNdZ;
-        Bmat(3, iColumn + 2) = dNdY;
-
-        Bmat(4, iColumn) = dNdZ;
-        Bmat(4, iColumn + 2) = dNdX;
-
-        Bmat(5, iColumn) = dNdY;
-        Bmat(5, iColumn + 1) = dNdX;
-    }
-    std::swap(rDerivativeShapeFunctions, Bmat);
+template <>
+void NuTo::ContinuumElement<3>::BlowToBMatrixEngineeringStrain(const Eigen::Matrix<double, 1, 3>& rDerivatives,
+                                                               int rNode, Eigen::MatrixXd& rBMatrix) const
+{
+    assert(rBMatrix.rows() == 6);
+    const int iColumn = 3 * rNode;
+    const double dNdX = rDerivatives(0);
+    const double dNdY = rDerivatives(1);
+    const double dNdZ = rDerivatives(2);
+
+    /* according to Jirásek
+     *
+     *     +0  +1  +2
+     *    -------------
+     * 0 |  dx  0   0  |     - e_x
+     * 1 |  0   dy  0  |     - e_y
+     * 2 |  0   0   dz |     - e_z
+     * 3 |  0   dz  dy |     - g_yz
+     * 4 |  dz  0   dx |     - g_xz
+     * 5 |  dy  dx  0  |     - g_xy
+     *    -------------
+     */
+
+
+    rBMatrix(0, iColumn) = dNdX;
+    rBMatrix(1, iColumn + 1) = dNdY;
+    rBMatrix(2, iColumn + 2) = dNdZ;
+
+    rBMatrix(3, iColumn + 1) = dNdZ;
+    rBMatrix(3, iColumn + 2) = dNdY;
+
+    rBMatrix(4, iColumn) = dNdZ;
+    rBMatrix(4, iColumn + 2) = dNdX;
+
+    rBMatrix(5, iColumn) = dNdY;
+    rBMatrix(5, iColumn + 1) = dNdX;
 }
 
 template <>
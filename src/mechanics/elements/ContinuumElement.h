@@ -1,6 +1,8 @@
 #pragma once
 
+#include "base/ObjectPool.h"
 #include "mechanics/elements/ElementBase.h"
+#include "mechanics/elements/ElementGeometryCache.h"
 
 namespace NuTo
 {
@@ -15,15 +17,19 @@ template <typename T>
 class BlockFullMatrix;
 template <int TDim>
 class ContinuumBoundaryElement;
+class ElementBatch;
 
 template <int TDim>
 struct EvaluateDataContinuum;
+template <int TDim>
+struct EvaluateWorkspaceContinuum;
 
 template <int TDim>
 class ContinuumElement : public ElementBase
 {
 
     friend class ContinuumBoundaryElement<TDim>;
+    friend class ElementBatch;
 
 public:
     ContinuumElement(const std::vector<NuTo::NodeBase*>& rNodes, const InterpolationType& rInterpolationType,
@@ -34,6 +40,25 @@ public:
 
     virtual ~ContinuumElement() = default;
 
+    //! @brief allocates the elements of the same size next to each other, see ObjectPool
+    //! @remark derived elements of another size use the global operator new
+    static void* operator new(std::size_t rSize)
+    {
+        if (rSize != sizeof(ContinuumElement))
+            return ::operator new(rSize);
+        return ObjectPool<sizeof(ContinuumElement)>::Instance().Allocate();
+    }
+
+    static void operator delete(void* rPointer, std::size_t rSize)
+    {
+        if (rPointer == nullptr)
+            return;
+        if (rSize != sizeof(ContinuumElement))
+            ::operator delete(rPointer);
+        else
+            ObjectPool<sizeof(ContinuumElement)>::Instance().Deallocate(rPointer);
+    }
+
     //! @brief calculates output data for the element
     //! @param rInput ... constitutive input map for the constitutive law
     //! @param rOutput ...  coefficient matrix 0 1 or 2  (mass, damping and stiffness) and internal force (which
@@ -41,6 +66,22 @@ public:
     void Evaluate(const ConstitutiveInputMap& rInput,
                   std::map<Element::eOutput, std::shared_ptr<ElementOutputBase>>& rOutput) override;
 
+    //! @brief adds rFactor * HESSIAN0 * rDofValues to rProduct by sum factorization
+    //! @return false, if the element is not a high order tensor product element with only displacement dofs and a
+    //! constitutive law that only requires the engineering strain, see TensorProductKernel
+    bool AddHessian0Product(const ConstitutiveInputMap& rInput, const BlockFullVector<double>& rDofValues,
+                            double rFactor, BlockFullVector<double>& rProduct) override;
+
+    //! @brief enables the cache of the jacobians and the derivatives of the shape functions at the integration
+    //! points, disabled by default. Disabling releases the memory of the cache.
+    //! @remark The cache is rebuilt when the generations of the structure change, see StructureGeneration.
+    void SetUseGeometryCache(bool rUseGeometryCache) override;
+
+    //! @brief evaluates Constitutive::eOutput::TANGENT_STATE at all integration points and stores it
+    //! @return true, if the constitutive laws and their tangent states equal the ones of the previous call. False, if
+    //! a constitutive law has no tangent state or the element has other dofs than the displacements.
+    bool UpdateTangentStates(const ConstitutiveInputMap& rInput) override;
+
     //! @brief returns the local dimension of the element
     //! this is required to check, if an element can be used in a 1d, 2D or 3D Structure
     //! @return local dimension
@@ -87,6 +128,12 @@ public:
 
     virtual Eigen::VectorXd ExtractNodeValues(int rTimeDerivative, Node::eDof rDofType) const override;
 
+    //! @brief extracts the nodal values of rDofType into rNodalValues, reusing its memory
+    //! @param rTimeDerivative ... time derivative
+    //! @param rDofType ... dof type
+    //! @param rNodalValues ... nodal values (return value)
+    virtual void ExtractNodeValues(int rTimeDerivative, Node::eDof rDofType, Eigen::VectorXd& rNodalValues) const;
+
     //! @brief sets the section of an element
     //! @param rSection reference to section
     void SetSection(std::shared_ptr<const Section> section) override;
@@ -117,6 +164,14 @@ public:
     Eigen::MatrixXd CalculateMatrixB(Node::eDof rDofType, const Eigen::MatrixXd& rDerivativeShapeFunctions,
                                      const Eigen::Matrix<double, TDim, TDim> rInvJacobian) const;
 
+    //! @brief Calculates the B-Matrix of rDofType into rBMatrix, reusing its memory
+    //! @param rDofType ... dof type
+    //! @param rDerivativeShapeFunctions ... derivatives of the shape functions in natural coordinates
+    //! @param rInvJacobian ... inverse Jacobian
+    //! @param rBMatrix ... B-Matrix (return value)
+    void CalculateMatrixB(Node::eDof rDofType, const Eigen::MatrixXd& rDerivativeShapeFunctions,
+                          const Eigen::Matrix<double, TDim, TDim>& rInvJacobian, Eigen::MatrixXd& rBMatrix) const;
+
 protected:
     const DofStatus& mDofStatus;
 
@@ -125,15 +180,99 @@ protected:
     // the base class of the sections
     std::shared_ptr<const Section> mSection;
 
+    //! @brief true, if the geometric quantities at the integration points are cached
+    bool mUseGeometryCache = false;
+
+    //! @brief geometric quantities at the integration points, built lazily by GetGeometryCache
+    //! @remark not thread safe, an element must not be evaluated by several threads at once
+    mutable ElementGeometryCache<TDim> mGeometryCache;
+
+    //! @brief constitutive law and tangent state of each integration point, see UpdateTangentStates
+    std::vector<std::pair<const ConstitutiveBase*, double>> mTangentStates;
+
+    //! @brief returns the geometry cache, it is rebuilt if the node coordinates or the interpolation have changed
+    const ElementGeometryCache<TDim>& GetGeometryCache() const;
+
+    //! @brief Calculates the B-Matrix of rDofType into rBMatrix from the derivatives of the shape functions
+    //! @param rDofType ... dof type
+    //! @param rNumNodes ... number of nodes of rDofType
+    //! @param rDerivatives ... returns the derivatives of the shape functions of a node with respect to the global
+    //! coordinates
+    //! @param rBMatrix ... B-Matrix (return value)
+    template <typename TDerivatives>
+    void CalculateMatrixBFromDerivatives(Node::eDof rDofType, int rNumNodes, const TDerivatives& rDerivatives,
+                                         Eigen::MatrixXd& rBMatrix) const;
+
     //! @brief ... check if the element is properly defined (check node dofs, nodes are reordered if the element
     //! length/area/volum is negative)
     void CheckElement() override;
 
+    //! @brief evaluates the element with the memory of rWorkspace
+    //! @param rInput ... constitutive input map for the constitutive law
+    //! @param rElementOutput ... element outputs
+    //! @param rWorkspace ... workspace, reused if it was prepared for the same configuration
+    void EvaluateWithWorkspace(const ConstitutiveInputMap& rInput,
+                               std::map<Element::eOutput, std::shared_ptr<ElementOutputBase>>& rElementOutput,
+                               EvaluateWorkspaceContinuum<TDim>& rWorkspace);
+
+    //! @brief returns true, if rWorkspace was prepared for this element and the requested outputs
+    bool IsWorkspaceReusable(const ConstitutiveInputMap& rInput,
+                             const std::map<Element::eOutput, std::shared_ptr<ElementOutputBase>>& rElementOutput,
+                             const EvaluateWorkspaceContinuum<TDim>& rWorkspace) const;
+
+    //! @brief updates the constitutive inputs/outputs of rWorkspace, rebuilds them if the workspace is not reusable
+    void PrepareWorkspace(const ConstitutiveInputMap& rInput,
+                          std::map<Element::eOutput, std::shared_ptr<ElementOutputBase>>& rElementOutput,
+                          EvaluateWorkspaceContinuum<TDim>& rWorkspace) const;
+
+    //! @brief stores the configuration rWorkspace was prepared for, see IsWorkspaceReusable
+    void
+    StoreWorkspaceConfiguration(const ConstitutiveInputMap& rInput,
+                                const std::map<Element::eOutput, std::shared_ptr<ElementOutputBase>>& rElementOutput,
+                                EvaluateWorkspaceContinuum<TDim>& rWorkspace) const;
+
+    //! @brief returns true, if the element has only displacement dofs and the constitutive inputs/outputs of
+    //! rWorkspace only depend on the engineering strain
+    bool IsStrainDrivenConfiguration(const EvaluateWorkspaceContinuum<TDim>& rWorkspace) const;
+
+    //! @brief creates the kernels of rWorkspace, if the element can be evaluated by sum factorization
+    //! @remark Requires a high order tensor product interpolation and integration (TensorProductKernel), only
+    //! displacement dofs and constitutive inputs/outputs of rWorkspace that only depend on the engineering strain.
+    //! @param rOutputsSupported ... false, if the element outputs require the standard evaluation
+    void PrepareSumFactorization(bool rOutputsSupported, EvaluateWorkspaceContinuum<TDim>& rWorkspace) const;
+
+    //! @brief creates the fixed-size kernel of rWorkspace for the common element shapes, see FixedSizeKernel
+    //! @param rOutputsSupported ... false, if the element outputs require the generic evaluation
+    void PrepareFixedSizeKernel(bool rOutputsSupported, EvaluateWorkspaceContinuum<TDim>& rWorkspace) const;
+
+    //! @brief evaluates the internal gradient, the hessian and the static data with the fixed-size kernel
+    void EvaluateFixedSize(std::map<Element::eOutput, std::shared_ptr<ElementOutputBase>>& rElementOutput,
+                           EvaluateWorkspaceContinuum<TDim>& rWorkspace);
+
+    //! @brief evaluates the internal gradient and the static data by sum factorization
+    void EvaluateSumFactorization(std::map<Element::eOutput, std::shared_ptr<ElementOutputBase>>& rElementOutput,
+                                  EvaluateWorkspaceContinuum<TDim>& rWorkspace);
+
+    //! @brief calculates the natural derivatives of the coordinates and, if the engineering strain is a constitutive
+    //! input, of the displacements at the integration points
+    void CalculateGradientsSumFactorization(EvaluateWorkspaceContinuum<TDim>& rWorkspace) const;
+
+    //! @brief calculates the jacobian, its inverse and the constitutive inputs at an integration point from the
+    //! gradients of CalculateGradientsSumFactorization
+    //! @return determinant of the jacobian * integration point weight * section
+    double CalculateConstitutiveInputsSumFactorization(EvaluateWorkspaceContinuum<TDim>& rWorkspace, int rTheIP,
+                                                       Eigen::Matrix<double, TDim, TDim>& rInvJacobian) const;
+
     void ExtractAllNecessaryDofValues(EvaluateDataContinuum<TDim>& data);
 
     ConstitutiveOutputMap
     GetConstitutiveOutputMap(std::map<Element::eOutput, std::shared_ptr<ElementOutputBase>>& rElementOutput) const;
 
+    //! @brief adds the keys of the constitutive outputs required by rElementOutput to rConstitutiveOutput and resizes
+    //! the element outputs. The objects of new keys are not allocated.
+    void FillConstitutiveOutputMap(std::map<Element::eOutput, std::shared_ptr<ElementOutputBase>>& rElementOutput,
+                                   ConstitutiveOutputMap& rConstitutiveOutput) const;
+
     virtual void FillConstitutiveOutputMapInternalGradient(ConstitutiveOutputMap& rConstitutiveOutput,
                                                            BlockFullVector<double>& rInternalGradient) const;
     virtual void FillConstitutiveOutputMapHessian0(ConstitutiveOutputMap& rConstitutiveOutput,
@@ -156,12 +295,15 @@ protected:
     void CalculateGlobalColumnDofs(BlockFullVector<int>& rGlobalDofMapping) const;
 
 
+    //! @brief calculates the N-matrices, the B-matrices, the determinant of the jacobian and the determinant of the
+    //! jacobian * integration point weight * section at an integration point, from the geometry cache if it is used
     virtual void CalculateNMatrixBMatrixDetJacobian(EvaluateDataContinuum<TDim>& data, int rTheIP) const;
 
 
-    //! @brief Turns rDerivativeShapeFunctions into the B-Matrix for the displacements
+    //! @brief Writes the derivatives of the shape function of node rNode into the B-Matrix for the displacements
     //! @remark: (N0,x & N0,y \\ ...)   --> (N0,x & 0 \\ 0 & N0,y \\ N0,y & N0,x)
-    void BlowToBMatrixEngineeringStrain(Eigen::MatrixXd& rDerivativeShapeFunctions) const;
+    void BlowToBMatrixEngineeringStrain(const Eigen::Matrix<double, 1, TDim>& rDerivatives, int rNode,
+                                        Eigen::MatrixXd& rBMatrix) const;
 
     void CalculateConstitutiveInputs(ConstitutiveInputMap& rConstitutiveInput, EvaluateDataContinuum<TDim>& rData);
 
@@ -128,6 +128,7 @@ void NuTo::ContinuumElementIGA<TDim>::CalculateNMatrixBMatrixDetJacobian(Evaluat
                         "] Determinant of the Jacobian is zero, no inversion possible.");
 
     Eigen::Matrix<double, TDim, TDim> invJacobian = jacobian.inverse();
+    rData.mDetJxWeightIPxSection = this->CalculateDetJxWeightIPxSection(rData.mDetJacobian, rTheIP);
 
     // calculate shape functions and their derivatives
     for (auto dof : this->mInterpolationType->GetDofs())
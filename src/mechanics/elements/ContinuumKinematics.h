@@ -0,0 +1,102 @@
+#pragma once
+
+#include <Eigen/Core>
+
+#include "mechanics/constitutive/inputoutput/ConstitutiveIOBase.h"
+
+namespace NuTo
+{
+//! @brief small strain kinematics in Voigt notation shared by the element kernels (ContinuumElement, FixedSizeKernel,
+//! ElementBatch), ordered like the rows of ContinuumElement::BlowToBMatrixEngineeringStrain
+namespace ContinuumKinematics
+{
+//! @brief nonzero entries of the B-matrix column of the displacement component c of a node: the row (Voigt notation)
+//! VoigtRow(c, e) contains the derivative of the shape function with respect to the direction Direction(c, e)
+template <int TDim>
+struct StrainPattern;
+
+template <>
+struct StrainPattern<1>
+{
+    // [xx]
+    static constexpr int VoigtRow(int, int)
+    {
+        return 0;
+    }
+    static constexpr int Direction(int, int)
+    {
+        return 0;
+    }
+};
+
+template <>
+struct StrainPattern<2>
+{
+    // [xx, yy, gamma_xy]
+    static constexpr int VoigtRow(int rComponent, int rEntry)
+    {
+        constexpr int voigtRow[2][2] = {{0, 2}, {1, 2}};
+        return voigtRow[rComponent][rEntry];
+    }
+    static constexpr int Direction(int rComponent, int rEntry)
+    {
+        constexpr int direction[2][2] = {{0, 1}, {1, 0}};
+        return direction[rComponent][rEntry];
+    }
+};
+
+template <>
+struct StrainPattern<3>
+{
+    // [xx, yy, zz, gamma_yz, gamma_xz, gamma_xy]
+    static constexpr int VoigtRow(int rComponent, int rEntry)
+    {
+        constexpr int voigtRow[3][3] = {{0, 4, 5}, {1, 3, 5}, {2, 3, 4}};
+        return voigtRow[rComponent][rEntry];
+    }
+    static constexpr int Direction(int rComponent, int rEntry)
+    {
+        constexpr int direction[3][3] = {{0, 2, 1}, {1, 2, 0}, {2, 1, 0}};
+        return direction[rComponent][rEntry];
+    }
+};
+
+//! @brief engineering strain in Voigt notation of a displacement gradient
+template <int TDim>
+inline Eigen::Matrix<double, ConstitutiveIOBase::GetVoigtDim(TDim), 1>
+EngineeringStrainOfGradient(const Eigen::Matrix<double, TDim, TDim>& rGradient)
+{
+    Eigen::Matrix<double, ConstitutiveIOBase::GetVoigtDim(TDim), 1> strain;
+    strain.setZero();
+    for (int c = 0; c < TDim; ++c)
+        for (int e = 0; e < TDim; ++e)
+            strain[StrainPattern<TDim>::VoigtRow(c, e)] += rGradient(c, StrainPattern<TDim>::Direction(c, e));
+    return strain;
+}
+
+//! @brief symmetric stress tensor of an engineering stress in Voigt notation
+template <int TDim>
+inline Eigen::Matrix<double, TDim, TDim>
+StressTensor(const Eigen::Matrix<double, ConstitutiveIOBase::GetVoigtDim(TDim), 1>& rStress)
+{
+    Eigen::Matrix<double, TDim, TDim> stress;
+    for (int c = 0; c < TDim; ++c)
+        for (int e = 0; e < TDim; ++e)
+            stress(c, StrainPattern<TDim>::Direction(c, e)) = rStress[StrainPattern<TDim>::VoigtRow(c, e)];
+    return stress;
+}
+
+//! @brief columns of the B-matrix of a node
+template <int TDim>
+inline Eigen::Matrix<double, ConstitutiveIOBase::GetVoigtDim(TDim), TDim>
+NodeBMatrix(const Eigen::Matrix<double, 1, TDim>& rDerivatives)
+{
+    Eigen::Matrix<double, ConstitutiveIOBase::GetVoigtDim(TDim), TDim> b;
+    b.setZero();
+    for (int c = 0; c < TDim; ++c)
+        for (int e = 0; e < TDim; ++e)
+            b(StrainPattern<TDim>::VoigtRow(c, e), c) = rDerivatives[StrainPattern<TDim>::Direction(c, e)];
+    return b;
+}
+} // namespace ContinuumKinematics
+} // namespace NuTo
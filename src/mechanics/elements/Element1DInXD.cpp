@@ -102,6 +102,12 @@ Eigen::VectorXd NuTo::Element1DInXD::ExtractNodeValues(int rTimeDerivative, Node
     return nodeValues;
 }
 
+void NuTo::Element1DInXD::ExtractNodeValues(int rTimeDerivative, Node::eDof rDofType,
+                                            Eigen::VectorXd& rNodalValues) const
+{
+    rNodalValues = ExtractNodeValues(rTimeDerivative, rDofType);
+}
+
 const Eigen::VectorXd NuTo::Element1DInXD::ExtractGlobalNodeValues(int rTimeDerivative, Node::eDof rDofType) const
 {
 
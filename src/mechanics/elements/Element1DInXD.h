@@ -23,6 +23,7 @@ public:
                   const IntegrationTypeBase& integrationType, const DofStatus& dofStatus, int globalDimension);
 
     Eigen::VectorXd ExtractNodeValues(int rTimeDerivative, Node::eDof) const override;
+    void ExtractNodeValues(int rTimeDerivative, Node::eDof rDofType, Eigen::VectorXd& rNodalValues) const override;
     const Eigen::VectorXd ExtractGlobalNodeValues(int rTimeDerivative, Node::eDof rDofType) const;
 
     Eigen::VectorXd InterpolateDofGlobal(const Eigen::VectorXd& rNaturalCoordinates,
@@ -115,6 +115,9 @@ void NuTo::Element2DInterface::Evaluate(const ConstitutiveInputMap& rInput,
 
 
     auto constitutiveOutput = GetConstitutiveOutputMap(rElementOutput);
+    if (not RequiresIntegration(rElementOutput))
+        return;
+
     auto constitutiveInput = GetConstitutiveInputMap(constitutiveOutput);
     constitutiveInput.Merge(rInput);
 
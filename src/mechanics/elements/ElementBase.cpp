@@ -53,6 +53,15 @@ void NuTo::ElementBase::Evaluate(std::map<Element::eOutput, std::shared_ptr<Elem
     return this->Evaluate(input, rOutput);
 }
 
+bool NuTo::ElementBase::RequiresIntegration(
+        const std::map<Element::eOutput, std::shared_ptr<ElementOutputBase>>& rElementOutput)
+{
+    for (const auto& it : rElementOutput)
+        if (it.first != Element::eOutput::GLOBAL_ROW_DOF and it.first != Element::eOutput::GLOBAL_COLUMN_DOF)
+            return true;
+    return false;
+}
+
 const NuTo::ConstitutiveBase& NuTo::ElementBase::GetConstitutiveLaw(unsigned int rIP) const
 {
     return mIPData.GetIPConstitutiveLaw(rIP).GetConstitutiveLaw();
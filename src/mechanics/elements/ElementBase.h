@@ -5,6 +5,7 @@
 #include <Eigen/Dense>
 #include "base/Exception.h"
 #include "mechanics/elements/IPData.h"
+#include "mechanics/structures/StructureGeneration.h"
 #include <memory>
 
 
@@ -17,6 +18,8 @@ class InterpolationType;
 class NodeBase;
 class Section;
 class ElementOutputBase;
+template <typename T>
+class BlockFullVector;
 enum class eVisualizeWhat;
 template <typename IOEnum>
 class ConstitutiveIOMap;
@@ -198,6 +201,57 @@ public:
     virtual void Evaluate(const ConstitutiveInputMap& rInput,
                           std::map<Element::eOutput, std::shared_ptr<ElementOutputBase>>& rOutput) = 0;
 
+    //! @brief adds rFactor * HESSIAN0 * rDofValues to rProduct without calculating the element hessian
+    //! @remark Implemented by elements that can apply their hessian matrix-free, e.g. by sum factorization.
+    //! @param rInput ... constitutive input map for the constitutive law
+    //! @param rDofValues ... element dof values, ordered like the columns of the element hessian
+    //! @param rFactor ... factor
+    //! @param rProduct ... element vector, ordered and sized like the rows of the element hessian
+    //! @return false, if the element does not support the product, rProduct is unchanged then
+    virtual bool AddHessian0Product(const ConstitutiveInputMap&, const BlockFullVector<double>&, double,
+                                    BlockFullVector<double>&)
+    {
+        return false;
+    }
+
+    //! @brief evaluates the tangent states of the constitutive laws at the integration points and stores them in the
+    //! element, see Constitutive::eOutput::TANGENT_STATE
+    //! @param rInput ... constitutive input map for the constitutive law
+    //! @return true, if the tangent states of all integration points are unchanged since the previous call. The
+    //! HESSIAN_0_TIME_DERIVATIVE of the element is unchanged then, as long as its dofs and its geometry are.
+    virtual bool UpdateTangentStates(const ConstitutiveInputMap&)
+    {
+        return false;
+    }
+
+    //! @brief sets the generations of the structure the element belongs to
+    //! @param rGeneration ... generations of the structure, have to outlive the element. nullptr for elements without
+    //! structure.
+    void SetStructureGeneration(const StructureGeneration* rGeneration)
+    {
+        mStructureGeneration = rGeneration;
+    }
+
+    //! @brief returns the geometry generation of the structure the element belongs to, 0 for elements without
+    //! structure, see StructureGeneration::GetGeometry
+    unsigned long GetStructureGeometryGeneration() const
+    {
+        return mStructureGeneration == nullptr ? 0 : mStructureGeneration->GetGeometry();
+    }
+
+    //! @brief returns the configuration generation of the structure the element belongs to, 0 for elements without
+    //! structure, see StructureGeneration::GetConfiguration
+    unsigned long GetStructureConfigurationGeneration() const
+    {
+        return mStructureGeneration == nullptr ? 0 : mStructureGeneration->GetConfiguration();
+    }
+
+    //! @brief enables the cache of the geometric quantities at the integration points, see ElementGeometryCache
+    //! @remark Elements without a geometry cache ignore the setting.
+    virtual void SetUseGeometryCache(bool)
+    {
+    }
+
     //! @brief Evaluate the constitutive law attached to an integration point.
     //! @param rConstitutiveInput Input map of the constitutive law.
     //! @param rConstitutiveOuput Output map of the constitutive law.
@@ -325,6 +379,11 @@ protected:
     virtual void ReorderNodes();
 
     void AddPlaneStateToInput(ConstitutiveInputMap& input) const;
+
+    //! @brief returns false, if rElementOutput only contains the global dof numbers. They are calculated without the
+    //! integration points, so neither the nodal values nor the constitutive law are evaluated.
+    static bool
+    RequiresIntegration(const std::map<Element::eOutput, std::shared_ptr<ElementOutputBase>>& rElementOutput);
     //! @brief ... extract global dofs from nodes (mapping of local row ordering of the element matrices to the global
     //! dof ordering)
     //! @param rGlobalRowDofs ... vector of global row dofs
@@ -338,6 +397,9 @@ protected:
     const InterpolationType* mInterpolationType;
 
     IPData mIPData;
+
+    //! @brief generations of the structure the element belongs to, see SetStructureGeneration
+    const StructureGeneration* mStructureGeneration = nullptr;
 };
 
 std::ostream& operator<<(std::ostream& out, const ElementBase& element);
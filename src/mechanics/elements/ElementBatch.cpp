@@ -0,0 +1,515 @@
+#include "mechanics/elements/ElementBatch.h"
+
+#include <algorithm>
+#include <typeinfo>
+
+#include "base/Exception.h"
+#include "mechanics/constitutive/ConstitutiveBase.h"
+#include "mechanics/constitutive/ConstitutiveEnum.h"
+#include "mechanics/constitutive/inputoutput/ConstitutiveIOBase.h"
+#include "mechanics/constitutive/inputoutput/ConstitutiveMatrix.h"
+#include "mechanics/constitutive/inputoutput/ConstitutiveVector.h"
+#include "mechanics/constitutive/laws/LinearElasticEngineeringStress.h"
+#include "mechanics/constitutive/laws/LocalDamageModel.h"
+#include "mechanics/dofSubMatrixStorage/BlockFullMatrix.h"
+#include "mechanics/dofSubMatrixStorage/BlockFullVector.h"
+#include "mechanics/dofSubMatrixStorage/DofStatus.h"
+#include "mechanics/elements/ContinuumElement.h"
+#include "mechanics/elements/ContinuumKinematics.h"
+#include "mechanics/elements/ElementEnum.h"
+#include "mechanics/elements/ElementOutputBase.h"
+#include "mechanics/integrationtypes/IntegrationTypeBase.h"
+#include "mechanics/interpolationtypes/InterpolationBase.h"
+#include "mechanics/interpolationtypes/InterpolationType.h"
+#include "mechanics/nodes/NodeEnum.h"
+
+namespace
+{
+typedef Eigen::Array<double, NuTo::ElementBatch::BatchSize, 1> Lane;
+
+//! @brief inverts the jacobians J(c, d) = rJacobian[c * TDim + d] of all lanes
+//! @return determinants
+template <int TDim>
+Lane InvertJacobians(const std::array<Lane, TDim * TDim>& rJacobian, std::array<Lane, TDim * TDim>& rInverse);
+
+template <>
+Lane InvertJacobians<2>(const std::array<Lane, 4>& J, std::array<Lane, 4>& rInverse)
+{
+    const Lane determinant = J[0] * J[3] - J[1] * J[2];
+    const Lane inverseDeterminant = determinant.inverse();
+    rInverse[0] = J[3] * inverseDeterminant;
+    rInverse[1] = -J[1] * inverseDeterminant;
+    rInverse[2] = -J[2] * inverseDeterminant;
+    rInverse[3] = J[0] * inverseDeterminant;
+    return determinant;
+}
+
+template <>
+Lane InvertJacobians<3>(const std::array<Lane, 9>& J, std::array<Lane, 9>& rInverse)
+{
+    // cofactors
+    rInverse[0] = J[4] * J[8] - J[5] * J[7];
+    rInverse[3] = J[5] * J[6] - J[3] * J[8];
+    rInverse[6] = J[3] * J[7] - J[4] * J[6];
+    const Lane determinant = J[0] * rInverse[0] + J[1] * rInverse[3] + J[2] * rInverse[6];
+    const Lane inverseDeterminant = determinant.inverse();
+
+    rInverse[1] = (J[2] * J[7] - J[1] * J[8]) * inverseDeterminant;
+    rInverse[2] = (J[1] * J[5] - J[2] * J[4]) * inverseDeterminant;
+    rInverse[4] = (J[0] * J[8] - J[2] * J[6]) * inverseDeterminant;
+    rInverse[5] = (J[2] * J[3] - J[0] * J[5]) * inverseDeterminant;
+    rInverse[7] = (J[1] * J[6] - J[0] * J[7]) * inverseDeterminant;
+    rInverse[8] = (J[0] * J[4] - J[1] * J[3]) * inverseDeterminant;
+    rInverse[0] *= inverseDeterminant;
+    rInverse[3] *= inverseDeterminant;
+    rInverse[6] *= inverseDeterminant;
+    return determinant;
+}
+} // namespace
+
+
+NuTo::ElementBatch::ElementBatch(const std::function<ElementOutputMap()>& rOutputMapCreate, bool rUseBatches)
+    : mOutputsSupported(rUseBatches)
+{
+    for (int lane = 0; lane < BatchSize; ++lane)
+    {
+        mOutputs[lane] = rOutputMapCreate();
+        mInternalGradients[lane] = nullptr;
+        mHessians0[lane] = nullptr;
+        for (auto& output : mOutputs[lane])
+        {
+            switch (output.first)
+            {
+            case Element::eOutput::INTERNAL_GRADIENT:
+                mInternalGradients[lane] = output.second.get();
+                break;
+            case Element::eOutput::HESSIAN_0_TIME_DERIVATIVE:
+                mHessians0[lane] = output.second.get();
+                break;
+            case Element::eOutput::UPDATE_STATIC_DATA:
+            case Element::eOutput::UPDATE_TMP_STATIC_DATA:
+                break; // passed to the constitutive law
+            default:
+                mOutputsSupported = false;
+            }
+        }
+    }
+}
+
+
+void NuTo::ElementBatch::Evaluate(const ConstitutiveInputMap& rInput, ElementBase* const* rElements, int rNumElements,
+                                  const std::function<void(ElementBase&, ElementOutputMap&)>& rFunction)
+{
+    int elementCount = 0;
+    while (elementCount < rNumElements)
+    {
+        ElementBase& element = *rElements[elementCount];
+
+        int numElementsBatch = 0;
+        if (IsSupported(element))
+        {
+            numElementsBatch = 1;
+            while (numElementsBatch < BatchSize and elementCount + numElementsBatch < rNumElements and
+                   IsCompatible(element, *rElements[elementCount + numElementsBatch]))
+                ++numElementsBatch;
+        }
+
+        // a single element is cheaper to evaluate directly
+        if (numElementsBatch < 2)
+        {
+            element.Evaluate(rInput, mOutputs[0]);
+            rFunction(element, mOutputs[0]);
+            ++elementCount;
+            continue;
+        }
+
+        if (element.GetLocalDimension() == 2)
+            EvaluateBatch<2>(rInput, rElements + elementCount, numElementsBatch);
+        else
+            EvaluateBatch<3>(rInput, rElements + elementCount, numElementsBatch);
+
+        for (int lane = 0; lane < numElementsBatch; ++lane)
+            rFunction(*rElements[elementCount + lane], mOutputs[lane]);
+        elementCount += numElementsBatch;
+    }
+}
+
+
+bool NuTo::ElementBatch::IsSupported(const ElementBase& rElement) const
+{
+    if (not mOutputsSupported)
+        return false;
+
+    // derived classes, e.g. ContinuumElementIGA, change the evaluation
+    if (typeid(rElement) == typeid(ContinuumElement<2>))
+        return IsSupported(static_cast<const ContinuumElement<2>&>(rElement));
+    if (typeid(rElement) == typeid(ContinuumElement<3>))
+        return IsSupported(static_cast<const ContinuumElement<3>&>(rElement));
+    return false;
+}
+
+
+template <int TDim>
+bool NuTo::ElementBatch::IsSupported(const ContinuumElement<TDim>& rElement) const
+{
+    if (TDim == 2 and rElement.mSection == nullptr)
+        return false; // the standard evaluation throws
+
+    const std::set<Node::eDof>& activeDofTypes = rElement.mDofStatus.GetActiveDofTypes();
+    if (activeDofTypes.size() != 1 or *activeDofTypes.begin() != Node::eDof::DISPLACEMENTS)
+        return false;
+
+    const InterpolationType& interpolationType = rElement.GetInterpolationType();
+    if (not interpolationType.IsActive(Node::eDof::DISPLACEMENTS))
+        return false;
+    for (auto dof : interpolationType.GetDofs())
+        if (dof != Node::eDof::COORDINATES and dof != Node::eDof::DISPLACEMENTS)
+            return false;
+
+    const ConstitutiveBase& constitutiveLaw = rElement.GetConstitutiveLaw(0);
+    if (typeid(constitutiveLaw) != typeid(LinearElasticEngineeringStress) and
+        typeid(constitutiveLaw) != typeid(LocalDamageModel))
+        return false;
+    for (int iIP = 1; iIP < rElement.GetNumIntegrationPoints(); ++iIP)
+        if (&rElement.GetConstitutiveLaw(iIP) != &constitutiveLaw)
+            return false;
+    return true;
+}
+
+
+bool NuTo::ElementBatch::IsCompatible(const ElementBase& rFirst, const ElementBase& rElement) const
+{
+    if (typeid(rFirst) != typeid(rElement) or &rFirst.GetInterpolationType() != &rElement.GetInterpolationType() or
+        &rFirst.GetIntegrationType() != &rElement.GetIntegrationType() or
+        &rFirst.GetConstitutiveLaw(0) != &rElement.GetConstitutiveLaw(0) or not IsSupported(rElement))
+        return false;
+
+    // the section is only used in 2D
+    if (rElement.GetLocalDimension() == 2)
+    {
+        const auto& first = static_cast<const ContinuumElement<2>&>(rFirst);
+        const auto& element = static_cast<const ContinuumElement<2>&>(rElement);
+        return first.mSection == element.mSection and first.mUseGeometryCache == element.mUseGeometryCache;
+    }
+    return static_cast<const ContinuumElement<3>&>(rFirst).mUseGeometryCache ==
+           static_cast<const ContinuumElement<3>&>(rElement).mUseGeometryCache;
+}
+
+
+bool NuTo::ElementBatch::HasPreparedInputs(const ConstitutiveInputMap& rInput) const
+{
+    if (rInput.size() != mInputs.size())
+        return false;
+    auto itInput = mInputs.begin();
+    for (const auto& input : rInput)
+        if (input.first != *itInput++)
+            return false;
+    return true;
+}
+
+
+template <int TDim>
+void NuTo::ElementBatch::PrepareBatch(const ConstitutiveInputMap& rInput, ContinuumElement<TDim>& rElement)
+{
+    mInterpolationType = &rElement.GetInterpolationType();
+    mIntegrationType = &rElement.GetIntegrationType();
+    mConstitutiveLaw = &rElement.GetConstitutiveLaw(0);
+    mSection = rElement.mSection.get();
+
+    const InterpolationBase& interpolationCoordinates = mInterpolationType->Get(Node::eDof::COORDINATES);
+    const InterpolationBase& interpolationDisplacements = mInterpolationType->Get(Node::eDof::DISPLACEMENTS);
+    const int numIPs = mIntegrationType->GetNumIntegrationPoints();
+    mDerivativesCoordinates.resize(numIPs);
+    mDerivativesDisplacements.resize(numIPs);
+    mIPFactors.resize(numIPs);
+    for (int iIP = 0; iIP < numIPs; ++iIP)
+    {
+        const Eigen::VectorXd ipCoordinates = mIntegrationType->GetLocalIntegrationPointCoordinates(iIP);
+        mDerivativesCoordinates[iIP] = interpolationCoordinates.DerivativeShapeFunctionsNatural(ipCoordinates);
+        mDerivativesDisplacements[iIP] = interpolationDisplacements.DerivativeShapeFunctionsNatural(ipCoordinates);
+        mIPFactors[iIP] = rElement.CalculateDetJxWeightIPxSection(1., iIP);
+    }
+
+    mInputs.clear();
+    for (const auto& input : rInput)
+        mInputs.push_back(input.first);
+
+    // the tangent of a linear elastic law does not depend on the strain
+    mIsTangentShared = typeid(*mConstitutiveLaw) == typeid(LinearElasticEngineeringStress);
+    if (not mIsTangentShared)
+    {
+        // the constitutive outputs of the requested element outputs, evaluated for each lane
+        auto constitutiveOutput = rElement.GetConstitutiveOutputMap(mOutputs[0]);
+        auto constitutiveInput = rElement.GetConstitutiveInputMap(constitutiveOutput);
+        if (TDim == 2)
+            rElement.AddPlaneStateToInput(constitutiveInput);
+        constitutiveInput.Merge(rInput);
+        mConstitutiveOutput.swap(constitutiveOutput);
+        mConstitutiveInput.swap(constitutiveInput);
+        return;
+    }
+
+    constexpr int VoigtDim = ConstitutiveIOBase::GetVoigtDim(TDim);
+    ConstitutiveOutputMap constitutiveOutput;
+    constitutiveOutput[Constitutive::eOutput::D_ENGINEERING_STRESS_D_ENGINEERING_STRAIN] =
+            ConstitutiveIOBase::makeConstitutiveIO<TDim>(
+                    Constitutive::eOutput::D_ENGINEERING_STRESS_D_ENGINEERING_STRAIN);
+    auto constitutiveInput = rElement.GetConstitutiveInputMap(constitutiveOutput);
+    if (TDim == 2)
+        rElement.AddPlaneStateToInput(constitutiveInput);
+    constitutiveInput.Merge(rInput);
+    rElement.template EvaluateConstitutiveLaw<TDim>(constitutiveInput, constitutiveOutput, 0);
+    mTangent = *static_cast<ConstitutiveMatrix<VoigtDim, VoigtDim>*>(
+            constitutiveOutput.at(Constitutive::eOutput::D_ENGINEERING_STRESS_D_ENGINEERING_STRAIN).get());
+}
+
+
+template <int TDim>
+void NuTo::ElementBatch::EvaluateBatch(const ConstitutiveInputMap& rInput, ElementBase* const* rElements,
+                                       int rNumElements)
+{
+    constexpr int VoigtDim = ConstitutiveIOBase::GetVoigtDim(TDim);
+    typedef ContinuumKinematics::StrainPattern<TDim> Pattern;
+
+    auto& first = static_cast<ContinuumElement<TDim>&>(*rElements[0]);
+    if (&first.GetInterpolationType() != mInterpolationType or &first.GetIntegrationType() != mIntegrationType or
+        &first.GetConstitutiveLaw(0) != mConstitutiveLaw or first.mSection.get() != mSection or
+        not HasPreparedInputs(rInput))
+        PrepareBatch<TDim>(rInput, first);
+    else if (not mIsTangentShared)
+        mConstitutiveInput.CopyValues(rInput);
+
+    const int numNodesCoordinates = mInterpolationType->Get(Node::eDof::COORDINATES).GetNumNodes();
+    const int numNodes = mInterpolationType->Get(Node::eDof::DISPLACEMENTS).GetNumNodes();
+    const int numDofs = TDim * numNodes;
+    const bool calculateInternalGradient = mInternalGradients[0] != nullptr;
+    const bool calculateHessian0 = mHessians0[0] != nullptr;
+    // the tangent of each lane depends on its strain
+    const bool calculateStrain = calculateInternalGradient or not mIsTangentShared;
+    const bool useGeometryCache = first.mUseGeometryCache;
+
+    // gather, the lanes of an incomplete batch repeat its last element
+    std::array<const ElementGeometryCache<TDim>*, BatchSize> geometryCaches;
+    mCoordinates.resize(BatchSize, TDim * numNodesCoordinates);
+    mDisplacements.resize(BatchSize, numDofs);
+    for (int lane = 0; lane < BatchSize; ++lane)
+    {
+        const auto& element = static_cast<const ContinuumElement<TDim>&>(*rElements[std::min(lane, rNumElements - 1)]);
+        if (useGeometryCache)
+        {
+            geometryCaches[lane] = &element.GetGeometryCache();
+        }
+        else
+        {
+            element.ExtractNodeValues(0, Node::eDof::COORDINATES, mNodeValues);
+            mCoordinates.row(lane) = mNodeValues.transpose();
+        }
+        if (calculateStrain)
+        {
+            element.ExtractNodeValues(0, Node::eDof::DISPLACEMENTS, mNodeValues);
+            mDisplacements.row(lane) = mNodeValues.transpose();
+        }
+    }
+    const int derivativeOffset =
+            useGeometryCache ? geometryCaches[0]->GetDerivativeOffset(Node::eDof::DISPLACEMENTS) : 0;
+
+    mDerivatives.resize(BatchSize, TDim * numNodes);
+    mTangentB.resize(BatchSize, VoigtDim * numDofs);
+    if (calculateHessian0)
+        mHessian.setZero(BatchSize, numDofs * numDofs);
+    if (calculateInternalGradient)
+        mInternalGradient.setZero(BatchSize, numDofs);
+
+    std::array<Lane, TDim * TDim> jacobian;
+    std::array<Lane, TDim * TDim> invJacobian;
+    std::array<Lane, VoigtDim> strain;
+    std::array<Lane, VoigtDim> stress;
+    std::array<Lane, VoigtDim * VoigtDim> tangent;
+    Lane factor;
+
+    if (mIsTangentShared)
+        for (int v = 0; v < VoigtDim; ++v)
+            for (int w = 0; w < VoigtDim; ++w)
+                tangent[v * VoigtDim + w] = mTangent(v, w);
+
+    // input and outputs of the constitutive law of one lane
+    ConstitutiveVector<VoigtDim>* strainLane = nullptr;
+    const ConstitutiveVector<VoigtDim>* stressLane = nullptr;
+    const ConstitutiveMatrix<VoigtDim, VoigtDim>* tangentLane = nullptr;
+    if (not mIsTangentShared)
+    {
+        strainLane = static_cast<ConstitutiveVector<VoigtDim>*>(
+                mConstitutiveInput.at(Constitutive::eInput::ENGINEERING_STRAIN).get());
+        if (calculateInternalGradient)
+            stressLane = static_cast<const ConstitutiveVector<VoigtDim>*>(
+                    mConstitutiveOutput.at(Constitutive::eOutput::ENGINEERING_STRESS).get());
+        if (calculateHessian0)
+            tangentLane = static_cast<const ConstitutiveMatrix<VoigtDim, VoigtDim>*>(
+                    mConstitutiveOutput.at(Constitutive::eOutput::D_ENGINEERING_STRESS_D_ENGINEERING_STRAIN).get());
+    }
+
+    const int numIPs = mIntegrationType->GetNumIntegrationPoints();
+    for (int iIP = 0; iIP < numIPs; ++iIP)
+    {
+        if (useGeometryCache)
+        {
+            // dN_i/dx_j = block[offset + j * numNodes + i]
+            for (int lane = 0; lane < BatchSize; ++lane)
+            {
+                const double* block = geometryCaches[lane]->GetIPBlock(iIP);
+                factor[lane] = block[ElementGeometryCache<TDim>::DetJxWeightIPxSection];
+                for (int iNode = 0; iNode < numNodes; ++iNode)
+                    for (int j = 0; j < TDim; ++j)
+                        mDerivatives(lane, TDim * iNode + j) = block[derivativeOffset + j * numNodes + iNode];
+            }
+        }
+        else
+        {
+            // J(c, d) = sum_i x_ic dN_i/dxi_d
+            const Eigen::MatrixXd& derivativesCoordinates = mDerivativesCoordinates[iIP];
+            for (auto& entry : jacobian)
+                entry.setZero();
+            for (int iNode = 0; iNode < numNodesCoordinates; ++iNode)
+                for (int c = 0; c < TDim; ++c)
+                    for (int d = 0; d < TDim; ++d)
+                        jacobian[c * TDim + d] +=
+                                mCoordinates.col(TDim * iNode + c) * derivativesCoordinates(iNode, d);
+
+            const Lane determinant = InvertJacobians<TDim>(jacobian, invJacobian);
+            if ((determinant == 0.).any())
+                throw Exception(__PRETTY_FUNCTION__, "Determinant of the Jacobian is zero, no inversion possible.");
+            factor = determinant * mIPFactors[iIP];
+
+            // dN_i/dx_j = sum_d dN_i/dxi_d invJ(d, j)
+            const Eigen::MatrixXd& derivativesDisplacements = mDerivativesDisplacements[iIP];
+            for (int iNode = 0; iNode < numNodes; ++iNode)
+                for (int j = 0; j < TDim; ++j)
+                {
+                    auto derivative = mDerivatives.col(TDim * iNode + j);
+                    derivative = derivativesDisplacements(iNode, 0) * invJacobian[j];
+                    for (int d = 1; d < TDim; ++d)
+                        derivative += derivativesDisplacements(iNode, d) * invJacobian[d * TDim + j];
+                }
+        }
+
+        if (calculateStrain)
+        {
+            // strain = B u
+            for (auto& entry : strain)
+                entry.setZero();
+            for (int iNode = 0; iNode < numNodes; ++iNode)
+                for (int c = 0; c < TDim; ++c)
+                    for (int e = 0; e < TDim; ++e)
+                        strain[Pattern::VoigtRow(c, e)] += mDerivatives.col(TDim * iNode + Pattern::Direction(c, e)) *
+                                                           mDisplacements.col(TDim * iNode + c);
+        }
+
+        if (mIsTangentShared)
+        {
+            // stress = C strain
+            if (calculateInternalGradient)
+                for (int v = 0; v < VoigtDim; ++v)
+                {
+                    stress[v] = mTangent(v, 0) * strain[0];
+                    for (int w = 1; w < VoigtDim; ++w)
+                        stress[v] += mTangent(v, w) * strain[w];
+                }
+        }
+        else
+        {
+            // the constitutive law of each lane evaluates (and updates) its static data, the repeated last element of
+            // an incomplete batch is not evaluated
+            for (auto& entry : stress)
+                entry.setZero();
+            for (auto& entry : tangent)
+                entry.setZero();
+            for (int lane = 0; lane < rNumElements; ++lane)
+            {
+                for (int v = 0; v < VoigtDim; ++v)
+                    (*strainLane)[v] = strain[v][lane];
+                rElements[lane]->EvaluateConstitutiveLaw<TDim>(mConstitutiveInput, mConstitutiveOutput, iIP);
+                if (stressLane != nullptr)
+                    for (int v = 0; v < VoigtDim; ++v)
+                        stress[v][lane] = (*stressLane)[v];
+                if (tangentLane != nullptr)
+                    for (int v = 0; v < VoigtDim; ++v)
+                        for (int w = 0; w < VoigtDim; ++w)
+                            tangent[v * VoigtDim + w][lane] = (*tangentLane)(v, w);
+            }
+        }
+
+        if (calculateInternalGradient)
+        {
+            // internal gradient += B^T stress
+            for (int v = 0; v < VoigtDim; ++v)
+                stress[v] *= factor;
+            for (int iNode = 0; iNode < numNodes; ++iNode)
+                for (int c = 0; c < TDim; ++c)
+                    for (int e = 0; e < TDim; ++e)
+                        mInternalGradient.col(TDim * iNode + c) +=
+                                mDerivatives.col(TDim * iNode + Pattern::Direction(c, e)) *
+                                stress[Pattern::VoigtRow(c, e)];
+        }
+
+        if (calculateHessian0)
+        {
+            // C B, each column of B has TDim nonzero entries
+            for (int iNode = 0; iNode < numNodes; ++iNode)
+                for (int c = 0; c < TDim; ++c)
+                {
+                    const int dof = TDim * iNode + c;
+                    for (int v = 0; v < VoigtDim; ++v)
+                    {
+                        auto tangentB = mTangentB.col(v * numDofs + dof);
+                        tangentB = tangent[v * VoigtDim + Pattern::VoigtRow(c, 0)] *
+                                   mDerivatives.col(TDim * iNode + Pattern::Direction(c, 0));
+                        for (int e = 1; e < TDim; ++e)
+                            tangentB += tangent[v * VoigtDim + Pattern::VoigtRow(c, e)] *
+                                        mDerivatives.col(TDim * iNode + Pattern::Direction(c, e));
+                    }
+                }
+
+            // factor * B^T C B, only the upper triangle for the symmetric shared tangent
+            for (int iNode = 0; iNode < numNodes; ++iNode)
+                for (int c = 0; c < TDim; ++c)
+                {
+                    const int row = TDim * iNode + c;
+                    for (int e = 0; e < TDim; ++e)
+                    {
+                        const Lane weightedDerivative =
+                                factor * mDerivatives.col(TDim * iNode + Pattern::Direction(c, e));
+                        const int tangentBOffset = Pattern::VoigtRow(c, e) * numDofs;
+                        for (int column = mIsTangentShared ? row : 0; column < numDofs; ++column)
+                            mHessian.col(row * numDofs + column) +=
+                                    weightedDerivative * mTangentB.col(tangentBOffset + column);
+                    }
+                }
+        }
+    }
+    // scatter
+    for (int lane = 0; lane < rNumElements; ++lane)
+    {
+        if (calculateInternalGradient)
+            mInternalGradients[lane]->GetBlockFullVectorDouble()[Node::eDof::DISPLACEMENTS] =
+                    mInternalGradient.row(lane).transpose();
+
+        if (calculateHessian0)
+        {
+            Eigen::MatrixXd& hessian0 =
+                    mHessians0[lane]->GetBlockFullMatrixDouble()(Node::eDof::DISPLACEMENTS, Node::eDof::DISPLACEMENTS);
+            hessian0.resize(numDofs, numDofs);
+            for (int row = 0; row < numDofs; ++row)
+            {
+                if (not mIsTangentShared)
+                {
+                    for (int column = 0; column < numDofs; ++column)
+                        hessian0(row, column) = mHessian(lane, row * numDofs + column);
+                    continue;
+                }
+                hessian0(row, row) = mHessian(lane, row * numDofs + row);
+                for (int column = row + 1; column < numDofs; ++column)
+                    hessian0(row, column) = hessian0(column, row) = mHessian(lane, row * numDofs + column);
+            }
+        }
+    }
+}
@@ -0,0 +1,141 @@
+#pragma once
+
+#include <array>
+#include <functional>
+#include <map>
+#include <memory>
+#include <vector>
+
+#include <Eigen/Core>
+
+#include "mechanics/constitutive/inputoutput/ConstitutiveIOMap.h"
+
+namespace NuTo
+{
+class ConstitutiveBase;
+class ElementBase;
+class ElementOutputBase;
+class IntegrationTypeBase;
+class InterpolationType;
+class Section;
+template <int TDim>
+class ContinuumElement;
+namespace Element
+{
+enum class eOutput;
+} // namespace Element
+
+//! @brief evaluates consecutive elements of the same type together, one element per lane of the vector registers
+//! @remark Batched are ContinuumElement<2> and ContinuumElement<3> with only displacement dofs and a
+//! LinearElasticEngineeringStress or LocalDamageModel law, the outputs INTERNAL_GRADIENT, HESSIAN_0_TIME_DERIVATIVE
+//! and the static data updates. Up to BatchSize consecutive elements with the same interpolation type, integration
+//! type, constitutive law, section and geometry cache setting form a batch. Their node values are gathered into
+//! arrays with one row per element, such that the jacobians, the B-matrices, the stresses and the element matrices of
+//! all elements are calculated by the same (vectorized) operations. Elements with a geometry cache provide the
+//! derivatives of the shape functions and the integration factors from their ElementGeometryCache instead.
+//! @remark The linear elastic tangent is shared by all lanes. The damage model is evaluated for each lane and
+//! integration point, it returns the stress, the static data and the tangent of each lane, e.g. \f$(1-\omega) C\f$.
+//! All other elements are evaluated one by one by ElementBase::Evaluate, i.e. by the fixed-size kernels where
+//! possible. An instance must not be used by several threads at once.
+class ElementBatch
+{
+public:
+    //! @brief number of elements per batch, one AVX register of doubles
+    static constexpr int BatchSize = 4;
+
+    typedef std::map<Element::eOutput, std::shared_ptr<ElementOutputBase>> ElementOutputMap;
+
+    //! @brief constructor
+    //! @param rOutputMapCreate ... creates the element outputs of one element
+    //! @param rUseBatches ... false, to evaluate all elements one by one
+    ElementBatch(const std::function<ElementOutputMap()>& rOutputMapCreate, bool rUseBatches = true);
+
+    //! @brief evaluates the elements and passes each element with its outputs to rFunction
+    //! @param rInput ... constitutive input map for the constitutive law
+    //! @param rElements ... elements
+    //! @param rNumElements ... number of elements
+    //! @param rFunction ... called for each element in the order of rElements, e.g. for the assembly
+    void Evaluate(const ConstitutiveInputMap& rInput, ElementBase* const* rElements, int rNumElements,
+                  const std::function<void(ElementBase&, ElementOutputMap&)>& rFunction);
+
+private:
+    //! @brief returns true, if rElement can be evaluated in a batch
+    bool IsSupported(const ElementBase& rElement) const;
+
+    template <int TDim>
+    bool IsSupported(const ContinuumElement<TDim>& rElement) const;
+
+    //! @brief returns true, if rElement can be evaluated in a batch with rFirst
+    bool IsCompatible(const ElementBase& rFirst, const ElementBase& rElement) const;
+
+    //! @brief evaluates a batch of 2 to BatchSize compatible elements into mOutputs
+    template <int TDim>
+    void EvaluateBatch(const ConstitutiveInputMap& rInput, ElementBase* const* rElements, int rNumElements);
+
+    //! @brief calculates the integration point data and the constitutive input and output shared by the elements of
+    //! a batch, and the elastic tangent
+    template <int TDim>
+    void PrepareBatch(const ConstitutiveInputMap& rInput, ContinuumElement<TDim>& rElement);
+
+    //! @brief returns true, if rInput has the keys of the input of the last PrepareBatch
+    bool HasPreparedInputs(const ConstitutiveInputMap& rInput) const;
+
+    //! @brief element outputs of each lane
+    std::array<ElementOutputMap, BatchSize> mOutputs;
+
+    //! @brief element outputs of each lane, nullptr if not requested
+    std::array<ElementOutputBase*, BatchSize> mInternalGradients;
+    std::array<ElementOutputBase*, BatchSize> mHessians0;
+
+    //! @brief false, if the requested element outputs cannot be evaluated in batches
+    bool mOutputsSupported;
+
+    //! @brief configuration of the integration point data and the tangent
+    const InterpolationType* mInterpolationType = nullptr;
+    const IntegrationTypeBase* mIntegrationType = nullptr;
+    const ConstitutiveBase* mConstitutiveLaw = nullptr;
+    const Section* mSection = nullptr;
+
+    //! @brief derivatives of the shape functions in natural coordinates at each integration point
+    std::vector<Eigen::MatrixXd> mDerivativesCoordinates;
+    std::vector<Eigen::MatrixXd> mDerivativesDisplacements;
+
+    //! @brief integration point weight * section at each integration point
+    std::vector<double> mIPFactors;
+
+    //! @brief keys of the input of the last PrepareBatch
+    std::vector<Constitutive::eInput> mInputs;
+
+    //! @brief true, if the tangent does not depend on the strain and is shared by all lanes
+    bool mIsTangentShared = false;
+
+    //! @brief tangent of the linear elastic law, VoigtDim x VoigtDim
+    Eigen::MatrixXd mTangent;
+
+    //! @brief input and output of the constitutive law of one lane, if the tangent is not shared
+    ConstitutiveInputMap mConstitutiveInput;
+    ConstitutiveOutputMap mConstitutiveOutput;
+
+    //! @brief lane data, one row per element and one column per quantity
+    typedef Eigen::Array<double, BatchSize, Eigen::Dynamic> LaneArray;
+
+    //! @brief node coordinates and displacements, the components of a node are stored consecutively
+    LaneArray mCoordinates;
+    LaneArray mDisplacements;
+
+    //! @brief derivatives of the shape functions with respect to the global coordinates, column TDim * node + d
+    LaneArray mDerivatives;
+
+    //! @brief tangent * B, column row * numDofs + dof, with the shared tangent or the tangent of each lane
+    LaneArray mTangentB;
+
+    //! @brief upper triangle of the element hessians, column row * numDofs + column
+    LaneArray mHessian;
+
+    //! @brief element internal gradients
+    LaneArray mInternalGradient;
+
+    //! @brief temporary node values of one element
+    Eigen::VectorXd mNodeValues;
+};
+} /* namespace NuTo */
@@ -0,0 +1,76 @@
+#pragma once
+
+#include <utility>
+#include <vector>
+
+#include "mechanics/nodes/NodeEnum.h"
+
+namespace NuTo
+{
+class IntegrationTypeBase;
+class InterpolationType;
+
+//! @brief geometric quantities of a continuum element at its integration points, see ContinuumElement::GetGeometryCache
+//! @remark One block of BlockSize doubles per integration point stores the determinant of the jacobian, the
+//! determinant of the jacobian * integration point weight * section and the derivatives of the shape functions with
+//! respect to the global coordinates of each dof type (numNodes x TDim, column major). The node coordinates of small
+//! strain analyses do not change, so the jacobians and the B-matrices of repeated evaluations follow from the cache.
+//! A cache is only valid for the geometry and configuration generations of the structure it was built in, see
+//! StructureGeneration.
+template <int TDim>
+struct ElementGeometryCache
+{
+    //! @brief returns true, if the cache was built for the interpolation type, its number of dof types, the
+    //! integration type and the generations of the structure
+    bool IsValid(const InterpolationType& rInterpolationType, int rNumDofTypes,
+                 const IntegrationTypeBase& rIntegrationType, unsigned long rGeometryGeneration,
+                 unsigned long rConfigurationGeneration) const
+    {
+        return not mData.empty() and mInterpolationType == &rInterpolationType and
+               static_cast<int>(mDerivativeOffsets.size()) == rNumDofTypes and
+               mIntegrationType == &rIntegrationType and mGeometryGeneration == rGeometryGeneration and
+               mConfigurationGeneration == rConfigurationGeneration;
+    }
+
+    //! @brief removes the cached values and releases the memory
+    void Clear()
+    {
+        std::vector<double>().swap(mData);
+        mDerivativeOffsets.clear();
+    }
+
+    //! @brief returns the block of an integration point
+    const double* GetIPBlock(int rTheIP) const
+    {
+        return mData.data() + rTheIP * mBlockSize;
+    }
+
+    //! @brief returns the offset of the derivatives of rDofType within a block
+    int GetDerivativeOffset(Node::eDof rDofType) const
+    {
+        for (const auto& offset : mDerivativeOffsets)
+            if (offset.first == rDofType)
+                return offset.second;
+        return -1;
+    }
+
+    //! @brief positions within a block
+    static constexpr int DetJacobian = 0;
+    static constexpr int DetJxWeightIPxSection = 1;
+
+    const InterpolationType* mInterpolationType = nullptr;
+    const IntegrationTypeBase* mIntegrationType = nullptr;
+    unsigned long mGeometryGeneration = 0;
+    unsigned long mConfigurationGeneration = 0;
+
+    //! @brief number of doubles per integration point
+    int mBlockSize = 0;
+
+    //! @brief offset of the derivatives of each dof type within a block
+    std::vector<std::pair<Node::eDof, int>> mDerivativeOffsets;
+
+    //! @brief blocks of all integration points
+    std::vector<double> mData;
+};
+
+} /* namespace NuTo */
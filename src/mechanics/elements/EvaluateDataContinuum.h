@@ -1,5 +1,12 @@
 #pragma once
 
+#include <map>
+#include <vector>
+
+#include <Eigen/Core>
+
+#include "mechanics/nodes/NodeEnum.h"
+
 namespace NuTo
 {
 template <int TDim>
@@ -32,6 +39,12 @@ public:
             return &(mNIGA.at(dof));
     }
 
+    //! @brief local coordinates of the integration points, calculated once per integration type
+    std::vector<Eigen::VectorXd> mIPCoordinates;
+
+    //! @brief storage for intermediate products, e.g. B^T * C, reused at every integration point
+    Eigen::MatrixXd mProduct;
+
     // Misc
     // --------------------------------------------------------------------------------------------
     double mDetJxWeightIPxSection;
@@ -0,0 +1,75 @@
+#pragma once
+
+#include <map>
+#include <memory>
+#include <set>
+#include <vector>
+
+#include <Eigen/Core>
+
+#include "mechanics/constitutive/inputoutput/ConstitutiveIOMap.h"
+#include "mechanics/elements/EvaluateDataContinuum.h"
+#include "mechanics/elements/FixedSizeKernel.h"
+#include "mechanics/elements/TensorProductKernel.h"
+#include "mechanics/nodes/NodeEnum.h"
+
+namespace NuTo
+{
+class ConstitutiveBase;
+class ElementOutputBase;
+class IntegrationTypeBase;
+class InterpolationType;
+class Section;
+class StructureGeneration;
+namespace Element
+{
+enum class eOutput;
+} // namespace Element
+
+//! @brief memory used in ContinuumElement::Evaluate that is kept for the next evaluation
+//! @remark Each thread owns one workspace per dimension. If consecutive elements have the same interpolation type,
+//! integration type, constitutive law, section and requested outputs, the constitutive inputs/outputs and the element
+//! data of the previous element are reused. The evaluation of the next element then does not allocate memory.
+//! A new object could be allocated at the address of a destroyed one. The structure increments its configuration
+//! generation when it destroys a constitutive law, so a workspace is only valid for the structure and the
+//! configuration generation it was prepared in, see StructureGeneration. Moving nodes does not invalidate it.
+template <int TDim>
+struct EvaluateWorkspaceContinuum
+{
+    EvaluateDataContinuum<TDim> mData;
+    ConstitutiveOutputMap mConstitutiveOutput;
+    ConstitutiveInputMap mConstitutiveInput;
+
+    //! @brief true, if the members below describe the configuration the maps and the data were built for
+    bool mIsValid = false;
+    const StructureGeneration* mStructureGeneration = nullptr;
+    unsigned long mConfigurationGeneration = 0;
+    const InterpolationType* mInterpolationType = nullptr;
+    const IntegrationTypeBase* mIntegrationType = nullptr;
+    const ConstitutiveBase* mConstitutiveLaw = nullptr;
+    std::weak_ptr<const Section> mSection;
+    std::set<Node::eDof> mActiveDofs;
+    std::vector<std::pair<Element::eOutput, const ElementOutputBase*>> mElementOutputs;
+    std::vector<Constitutive::eInput> mInputs;
+
+    //! @brief true, if the element is evaluated by sum factorization with the kernels below
+    bool mSumFactorization = false;
+    std::unique_ptr<TensorProductKernel<TDim>> mKernelDisplacements;
+    std::unique_ptr<TensorProductKernel<TDim>> mKernelCoordinates;
+
+    //! @brief natural derivatives at the integration points, see TensorProductKernel::Gradient
+    Eigen::MatrixXd mCoordinateGradients;
+    Eigen::MatrixXd mDisplacementGradients;
+    Eigen::MatrixXd mDirectionGradients;
+
+    //! @brief fluxes at the integration points, see TensorProductKernel::AddIntegratedGradient
+    Eigen::MatrixXd mFluxes;
+
+    //! @brief kernel with fixed-size matrices for the common element shapes, nullptr if the generic evaluation is used
+    std::unique_ptr<FixedSizeKernelBase<TDim>> mFixedSizeKernel;
+
+    //! @brief true while an element is evaluated, nested evaluations use a temporary workspace
+    bool mInUse = false;
+};
+
+} /* namespace NuTo */
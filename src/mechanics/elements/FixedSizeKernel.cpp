@@ -0,0 +1,254 @@
+#include "mechanics/elements/FixedSizeKernel.h"
+
+#include <array>
+#include <cassert>
+
+#include <Eigen/LU>
+
+#include "base/Exception.h"
+#include "mechanics/elements/ContinuumKinematics.h"
+#include "mechanics/integrationtypes/IntegrationTypeBase.h"
+#include "mechanics/interpolationtypes/InterpolationBase.h"
+#include "mechanics/interpolationtypes/InterpolationTypeEnum.h"
+
+namespace
+{
+template <int TDim, int TNumNodes>
+std::unique_ptr<NuTo::FixedSizeKernelBase<TDim>> MakeKernel(const NuTo::InterpolationBase& rInterpolationCoordinates,
+                                                            const NuTo::InterpolationBase& rInterpolationDisplacements,
+                                                            const NuTo::IntegrationTypeBase& rIntegrationType)
+{
+    return std::make_unique<NuTo::FixedSizeKernel<TDim, TNumNodes>>(rInterpolationCoordinates,
+                                                                     rInterpolationDisplacements, rIntegrationType);
+}
+
+//! @brief creates the kernel for rNumNodes nodes, nullptr if there is no specialization
+template <int TDim>
+std::unique_ptr<NuTo::FixedSizeKernelBase<TDim>> MakeKernel(int rNumNodes,
+                                                            const NuTo::InterpolationBase& rInterpolationCoordinates,
+                                                            const NuTo::InterpolationBase& rInterpolationDisplacements,
+                                                            const NuTo::IntegrationTypeBase& rIntegrationType);
+
+template <>
+std::unique_ptr<NuTo::FixedSizeKernelBase<1>> MakeKernel<1>(int rNumNodes,
+                                                            const NuTo::InterpolationBase& rInterpolationCoordinates,
+                                                            const NuTo::InterpolationBase& rInterpolationDisplacements,
+                                                            const NuTo::IntegrationTypeBase& rIntegrationType)
+{
+    switch (rNumNodes)
+    {
+    case 2: // truss
+        return MakeKernel<1, 2>(rInterpolationCoordinates, rInterpolationDisplacements, rIntegrationType);
+    case 3:
+        return MakeKernel<1, 3>(rInterpolationCoordinates, rInterpolationDisplacements, rIntegrationType);
+    default:
+        return nullptr;
+    }
+}
+
+template <>
+std::unique_ptr<NuTo::FixedSizeKernelBase<2>> MakeKernel<2>(int rNumNodes,
+                                                            const NuTo::InterpolationBase& rInterpolationCoordinates,
+                                                            const NuTo::InterpolationBase& rInterpolationDisplacements,
+                                                            const NuTo::IntegrationTypeBase& rIntegrationType)
+{
+    switch (rNumNodes)
+    {
+    case 3: // linear triangle
+        return MakeKernel<2, 3>(rInterpolationCoordinates, rInterpolationDisplacements, rIntegrationType);
+    case 4: // linear quad
+        return MakeKernel<2, 4>(rInterpolationCoordinates, rInterpolationDisplacements, rIntegrationType);
+    case 6: // quadratic triangle
+        return MakeKernel<2, 6>(rInterpolationCoordinates, rInterpolationDisplacements, rIntegrationType);
+    case 8: // serendipity quad
+        return MakeKernel<2, 8>(rInterpolationCoordinates, rInterpolationDisplacements, rIntegrationType);
+    default:
+        return nullptr;
+    }
+}
+
+template <>
+std::unique_ptr<NuTo::FixedSizeKernelBase<3>> MakeKernel<3>(int rNumNodes,
+                                                            const NuTo::InterpolationBase& rInterpolationCoordinates,
+                                                            const NuTo::InterpolationBase& rInterpolationDisplacements,
+                                                            const NuTo::IntegrationTypeBase& rIntegrationType)
+{
+    switch (rNumNodes)
+    {
+    case 4: // linear tetrahedron
+        return MakeKernel<3, 4>(rInterpolationCoordinates, rInterpolationDisplacements, rIntegrationType);
+    case 8: // linear brick
+        return MakeKernel<3, 8>(rInterpolationCoordinates, rInterpolationDisplacements, rIntegrationType);
+    case 10: // quadratic tetrahedron
+        return MakeKernel<3, 10>(rInterpolationCoordinates, rInterpolationDisplacements, rIntegrationType);
+    case 20: // serendipity brick
+        return MakeKernel<3, 20>(rInterpolationCoordinates, rInterpolationDisplacements, rIntegrationType);
+    default:
+        return nullptr;
+    }
+}
+} // namespace
+
+
+template <int TDim>
+std::unique_ptr<NuTo::FixedSizeKernelBase<TDim>>
+NuTo::FixedSizeKernelBase<TDim>::Create(const InterpolationBase& rInterpolationCoordinates,
+                                        const InterpolationBase& rInterpolationDisplacements,
+                                        const IntegrationTypeBase& rIntegrationType)
+{
+    // IGA interpolations depend on the knots of the element
+    if (rInterpolationCoordinates.GetTypeOrder() == Interpolation::eTypeOrder::SPLINE or
+        rInterpolationDisplacements.GetTypeOrder() == Interpolation::eTypeOrder::SPLINE or
+        rInterpolationCoordinates.GetLocalDimension() != TDim or
+        rInterpolationDisplacements.GetLocalDimension() != TDim)
+        return nullptr;
+
+    const int numNodes = rInterpolationDisplacements.GetNumNodes();
+    if (rInterpolationCoordinates.GetNumNodes() != numNodes)
+        return nullptr;
+
+    return MakeKernel<TDim>(numNodes, rInterpolationCoordinates, rInterpolationDisplacements, rIntegrationType);
+}
+
+
+template <int TDim, int TNumNodes>
+NuTo::FixedSizeKernel<TDim, TNumNodes>::FixedSizeKernel(const InterpolationBase& rInterpolationCoordinates,
+                                                        const InterpolationBase& rInterpolationDisplacements,
+                                                        const IntegrationTypeBase& rIntegrationType)
+{
+    const int numIPs = rIntegrationType.GetNumIntegrationPoints();
+    mDerivativesCoordinatesNatural.resize(numIPs);
+    mDerivativesDisplacementsNatural.resize(numIPs);
+    for (int theIP = 0; theIP < numIPs; ++theIP)
+    {
+        const Eigen::VectorXd ipCoordinates = rIntegrationType.GetLocalIntegrationPointCoordinates(theIP);
+        mDerivativesCoordinatesNatural[theIP] =
+                rInterpolationCoordinates.DerivativeShapeFunctionsNatural(ipCoordinates).leftCols(TDim);
+        mDerivativesDisplacementsNatural[theIP] =
+                rInterpolationDisplacements.DerivativeShapeFunctionsNatural(ipCoordinates).leftCols(TDim);
+    }
+}
+
+
+template <int TDim, int TNumNodes>
+void NuTo::FixedSizeKernel<TDim, TNumNodes>::SetNodeValues(const Eigen::VectorXd& rCoordinates,
+                                                           const Eigen::VectorXd& rDisplacements)
+{
+    assert(rCoordinates.rows() == NumDofs);
+    assert(rDisplacements.rows() == NumDofs);
+    mCoordinates = Eigen::Map<const Eigen::Matrix<double, TDim, TNumNodes>>(rCoordinates.data());
+    mDisplacements = Eigen::Map<const Eigen::Matrix<double, TDim, TNumNodes>>(rDisplacements.data());
+    mInternalGradient.setZero();
+    mHessian0.setZero();
+    mIsHessian0Symmetric = true;
+}
+
+
+template <int TDim, int TNumNodes>
+double NuTo::FixedSizeKernel<TDim, TNumNodes>::CalculateIP(int rTheIP, Eigen::Matrix<double, VoigtDim, 1>& rStrain)
+{
+    // J = sum_i x_i * dN_i
+    const Eigen::Matrix<double, TDim, TDim> jacobian = mCoordinates * mDerivativesCoordinatesNatural[rTheIP];
+    const double detJacobian = jacobian.determinant();
+    if (detJacobian == 0)
+        throw Exception(__PRETTY_FUNCTION__, "Determinant of the Jacobian is zero, no inversion possible.");
+
+    mDerivatives.noalias() = mDerivativesDisplacementsNatural[rTheIP] * jacobian.inverse();
+    rStrain = ContinuumKinematics::EngineeringStrainOfGradient<TDim>(mDisplacements * mDerivatives);
+    return detJacobian;
+}
+
+template <int TDim, int TNumNodes>
+void NuTo::FixedSizeKernel<TDim, TNumNodes>::CalculateIP(const double* rDerivatives,
+                                                         Eigen::Matrix<double, VoigtDim, 1>& rStrain)
+{
+    mDerivatives = Eigen::Map<const DerivativeMatrix>(rDerivatives);
+    rStrain = ContinuumKinematics::EngineeringStrainOfGradient<TDim>(mDisplacements * mDerivatives);
+}
+
+
+template <int TDim, int TNumNodes>
+void NuTo::FixedSizeKernel<TDim, TNumNodes>::AddInternalGradient(double rFactor,
+                                                                 const Eigen::Matrix<double, VoigtDim, 1>& rStress)
+{
+    // int sigma : grad(N) dV
+    mInternalGradient.noalias() +=
+            (rFactor * ContinuumKinematics::StressTensor<TDim>(rStress)) * mDerivatives.transpose();
+}
+
+
+template <int TDim, int TNumNodes>
+void NuTo::FixedSizeKernel<TDim, TNumNodes>::AddHessian0(double rFactor,
+                                                         const Eigen::Matrix<double, VoigtDim, VoigtDim>& rTangent)
+{
+    if (mIsHessian0Symmetric and rTangent != rTangent.transpose())
+    {
+        // e.g. damage models while the damage evolves, the contributions of the previous integration points are
+        // symmetric
+        for (int i = 0; i < TNumNodes; ++i)
+            for (int j = i + 1; j < TNumNodes; ++j)
+                mHessian0.template block<TDim, TDim>(TDim * j, TDim * i) =
+                        mHessian0.template block<TDim, TDim>(TDim * i, TDim * j).transpose();
+        mIsHessian0Symmetric = false;
+    }
+
+    typedef Eigen::Matrix<double, VoigtDim, TDim> NodeMatrix;
+    std::array<NodeMatrix, TNumNodes> tangentB;
+    for (int j = 0; j < TNumNodes; ++j)
+        tangentB[j].noalias() = rTangent * ContinuumKinematics::NodeBMatrix<TDim>(mDerivatives.row(j));
+
+    for (int i = 0; i < TNumNodes; ++i)
+    {
+        const Eigen::Matrix<double, TDim, VoigtDim> weightedBTransposed =
+                rFactor * ContinuumKinematics::NodeBMatrix<TDim>(mDerivatives.row(i)).transpose();
+        for (int j = mIsHessian0Symmetric ? i : 0; j < TNumNodes; ++j)
+            mHessian0.template block<TDim, TDim>(TDim * i, TDim * j).noalias() += weightedBTransposed * tangentB[j];
+    }
+}
+
+
+template <int TDim, int TNumNodes>
+void NuTo::FixedSizeKernel<TDim, TNumNodes>::AddInternalGradientTo(Eigen::VectorXd& rInternalGradient) const
+{
+    assert(rInternalGradient.rows() == NumDofs);
+    rInternalGradient += Eigen::Map<const Eigen::Matrix<double, NumDofs, 1>>(mInternalGradient.data());
+}
+
+
+template <int TDim, int TNumNodes>
+void NuTo::FixedSizeKernel<TDim, TNumNodes>::AddHessian0To(Eigen::MatrixXd& rHessian0) const
+{
+    assert(rHessian0.rows() == NumDofs and rHessian0.cols() == NumDofs);
+    if (not mIsHessian0Symmetric)
+    {
+        rHessian0 += mHessian0;
+        return;
+    }
+    for (int i = 0; i < TNumNodes; ++i)
+    {
+        rHessian0.template block<TDim, TDim>(TDim * i, TDim * i) +=
+                mHessian0.template block<TDim, TDim>(TDim * i, TDim * i);
+        for (int j = i + 1; j < TNumNodes; ++j)
+        {
+            const auto block = mHessian0.template block<TDim, TDim>(TDim * i, TDim * j);
+            rHessian0.template block<TDim, TDim>(TDim * i, TDim * j) += block;
+            rHessian0.template block<TDim, TDim>(TDim * j, TDim * i) += block.transpose();
+        }
+    }
+}
+
+
+template class NuTo::FixedSizeKernelBase<1>;
+template class NuTo::FixedSizeKernelBase<2>;
+template class NuTo::FixedSizeKernelBase<3>;
+
+template class NuTo::FixedSizeKernel<1, 2>;
+template class NuTo::FixedSizeKernel<1, 3>;
+template class NuTo::FixedSizeKernel<2, 3>;
+template class NuTo::FixedSizeKernel<2, 4>;
+template class NuTo::FixedSizeKernel<2, 6>;
+template class NuTo::FixedSizeKernel<2, 8>;
+template class NuTo::FixedSizeKernel<3, 4>;
+template class NuTo::FixedSizeKernel<3, 8>;
+template class NuTo::FixedSizeKernel<3, 10>;
+template class NuTo::FixedSizeKernel<3, 20>;
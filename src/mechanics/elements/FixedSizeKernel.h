@@ -0,0 +1,124 @@
+#pragma once
+
+#include <memory>
+#include <vector>
+
+#include <Eigen/Core>
+#include <Eigen/StdVector>
+
+#include "mechanics/constitutive/inputoutput/ConstitutiveIOBase.h"
+
+namespace NuTo
+{
+class IntegrationTypeBase;
+class InterpolationBase;
+
+//! @brief interface of the element kernels with fixed-size matrices, see FixedSizeKernel
+template <int TDim>
+class FixedSizeKernelBase
+{
+public:
+    static constexpr int VoigtDim = ConstitutiveIOBase::GetVoigtDim(TDim);
+
+    virtual ~FixedSizeKernelBase() = default;
+
+    //! @brief creates the kernel for the number of nodes of the interpolations
+    //! @return kernel, nullptr if the coordinates and the displacements have a different number of nodes or there is
+    //! no specialization for the number of nodes
+    static std::unique_ptr<FixedSizeKernelBase> Create(const InterpolationBase& rInterpolationCoordinates,
+                                                       const InterpolationBase& rInterpolationDisplacements,
+                                                       const IntegrationTypeBase& rIntegrationType);
+
+    //! @brief sets the node values of the element and the element outputs to zero
+    //! @param rCoordinates ... node coordinates, the components of a node are stored consecutively
+    //! @param rDisplacements ... node displacements, the components of a node are stored consecutively
+    virtual void SetNodeValues(const Eigen::VectorXd& rCoordinates, const Eigen::VectorXd& rDisplacements) = 0;
+
+    //! @brief calculates the derivatives of the shape functions with respect to the global coordinates and the
+    //! engineering strain at an integration point
+    //! @param rTheIP ... integration point
+    //! @param rStrain ... engineering strain (return value)
+    //! @return determinant of the jacobian
+    virtual double CalculateIP(int rTheIP, Eigen::Matrix<double, VoigtDim, 1>& rStrain) = 0;
+
+    //! @brief calculates the engineering strain at an integration point from known derivatives of the shape functions
+    //! @param rDerivatives ... derivatives of the shape functions with respect to the global coordinates, numNodes x
+    //! TDim, column major, e.g. from the ElementGeometryCache
+    //! @param rStrain ... engineering strain (return value)
+    virtual void CalculateIP(const double* rDerivatives, Eigen::Matrix<double, VoigtDim, 1>& rStrain) = 0;
+
+    //! @brief adds the contribution of the integration point of the last CalculateIP to the internal gradient
+    //! @param rFactor ... determinant of the jacobian * integration point weight * section
+    //! @param rStress ... engineering stress
+    virtual void AddInternalGradient(double rFactor, const Eigen::Matrix<double, VoigtDim, 1>& rStress) = 0;
+
+    //! @brief adds the contribution of the integration point of the last CalculateIP to the hessian
+    //! @param rFactor ... determinant of the jacobian * integration point weight * section
+    //! @param rTangent ... derivative of the engineering stress with respect to the engineering strain
+    virtual void AddHessian0(double rFactor, const Eigen::Matrix<double, VoigtDim, VoigtDim>& rTangent) = 0;
+
+    //! @brief adds the internal gradient of the element to rInternalGradient
+    virtual void AddInternalGradientTo(Eigen::VectorXd& rInternalGradient) const = 0;
+
+    //! @brief adds the hessian of the element to rHessian0
+    virtual void AddHessian0To(Eigen::MatrixXd& rHessian0) const = 0;
+};
+
+//! @brief continuum element kernel for TNumNodes nodes with displacement dofs
+//! @remark All matrices have a size known at compile time, the strains follow from the displacement gradient without
+//! a B-matrix and only the upper triangle of node blocks of the hessian is calculated, as long as the tangents are
+//! symmetric. This removes the dynamic memory, the loops with runtime bounds and the multiplications with zero entries
+//! of the B-matrix of the generic evaluation.
+template <int TDim, int TNumNodes>
+class FixedSizeKernel : public FixedSizeKernelBase<TDim>
+{
+public:
+    EIGEN_MAKE_ALIGNED_OPERATOR_NEW
+
+    static constexpr int VoigtDim = FixedSizeKernelBase<TDim>::VoigtDim;
+    static constexpr int NumDofs = TDim * TNumNodes;
+
+    typedef Eigen::Matrix<double, TNumNodes, TDim> DerivativeMatrix;
+
+    //! @brief constructor, evaluates the derivatives of the shape functions at the integration points
+    FixedSizeKernel(const InterpolationBase& rInterpolationCoordinates,
+                    const InterpolationBase& rInterpolationDisplacements, const IntegrationTypeBase& rIntegrationType);
+
+    void SetNodeValues(const Eigen::VectorXd& rCoordinates, const Eigen::VectorXd& rDisplacements) override;
+
+    double CalculateIP(int rTheIP, Eigen::Matrix<double, VoigtDim, 1>& rStrain) override;
+
+    void CalculateIP(const double* rDerivatives, Eigen::Matrix<double, VoigtDim, 1>& rStrain) override;
+
+    void AddInternalGradient(double rFactor, const Eigen::Matrix<double, VoigtDim, 1>& rStress) override;
+
+    void AddHessian0(double rFactor, const Eigen::Matrix<double, VoigtDim, VoigtDim>& rTangent) override;
+
+    void AddInternalGradientTo(Eigen::VectorXd& rInternalGradient) const override;
+
+    void AddHessian0To(Eigen::MatrixXd& rHessian0) const override;
+
+private:
+    //! @brief derivatives of the shape functions in natural coordinates at the integration points
+    std::vector<DerivativeMatrix, Eigen::aligned_allocator<DerivativeMatrix>> mDerivativesCoordinatesNatural;
+    std::vector<DerivativeMatrix, Eigen::aligned_allocator<DerivativeMatrix>> mDerivativesDisplacementsNatural;
+
+    //! @brief node values, one column per node
+    Eigen::Matrix<double, TDim, TNumNodes> mCoordinates;
+    Eigen::Matrix<double, TDim, TNumNodes> mDisplacements;
+
+    //! @brief derivatives of the displacement shape functions with respect to the global coordinates at the current
+    //! integration point
+    DerivativeMatrix mDerivatives;
+
+    //! @brief internal gradient, one column per node
+    Eigen::Matrix<double, TDim, TNumNodes> mInternalGradient;
+
+    //! @brief hessian, only the node blocks (i, j) with i <= j are calculated while the tangents are symmetric
+    Eigen::Matrix<double, NumDofs, NumDofs> mHessian0;
+
+    //! @brief false, if a tangent was not symmetric and all node blocks of the hessian are calculated
+    bool mIsHessian0Symmetric = true;
+};
+
+} /* namespace NuTo */
@@ -0,0 +1,256 @@
+#include "mechanics/elements/TensorProductKernel.h"
+
+#include <algorithm>
+#include <cassert>
+#include <cmath>
+
+#include "mechanics/integrationtypes/IntegrationTypeTensorProduct.h"
+#include "mechanics/interpolationtypes/InterpolationBase.h"
+#include "mechanics/interpolationtypes/InterpolationTypeEnum.h"
+
+namespace
+{
+//! @brief evaluates the 1D Lagrange polynomials of rNodes and their derivatives at rX
+void LagrangeBasis1D(const std::vector<double>& rNodes, double rX,
+                     Eigen::Ref<Eigen::RowVectorXd, 0, Eigen::InnerStride<>> rValues,
+                     Eigen::Ref<Eigen::RowVectorXd, 0, Eigen::InnerStride<>> rDerivatives)
+{
+    const int numNodes = rNodes.size();
+    for (int i = 0; i < numNodes; ++i)
+    {
+        double value = 1.;
+        double derivative = 0.;
+        for (int m = 0; m < numNodes; ++m)
+        {
+            if (m == i)
+                continue;
+            double product = 1. / (rNodes[i] - rNodes[m]);
+            for (int j = 0; j < numNodes; ++j)
+                if (j != i and j != m)
+                    product *= (rX - rNodes[j]) / (rNodes[i] - rNodes[j]);
+            derivative += product;
+            value *= (rX - rNodes[m]) / (rNodes[i] - rNodes[m]);
+        }
+        rValues[i] = value;
+        rDerivatives[i] = derivative;
+    }
+}
+
+//! @brief index of rX in rValues, -1 if not found
+int FindCoordinate(const std::vector<double>& rValues, double rX, double rTolerance)
+{
+    for (unsigned i = 0; i < rValues.size(); ++i)
+        if (std::abs(rValues[i] - rX) < rTolerance)
+            return i;
+    return -1;
+}
+} // namespace
+
+
+template <int TDim>
+std::unique_ptr<NuTo::TensorProductKernel<TDim>>
+NuTo::TensorProductKernel<TDim>::Create(const InterpolationBase& rInterpolation,
+                                        const IntegrationTypeBase& rIntegrationType)
+{
+    // IGA interpolations have no nodes in the natural coordinate system
+    if (rInterpolation.GetTypeOrder() == Interpolation::eTypeOrder::SPLINE or
+        rInterpolation.GetLocalDimension() != TDim)
+        return nullptr;
+
+    const auto* integrationType = dynamic_cast<const IntegrationTypeTensorProduct<TDim>*>(&rIntegrationType);
+    if (integrationType == nullptr)
+        return nullptr;
+
+    constexpr double tolerance = 1.e-10;
+    const int numNodes = rInterpolation.GetNumNodes();
+
+    // 1D node coordinates
+    std::vector<double> nodes1D;
+    for (int iNode = 0; iNode < numNodes; ++iNode)
+    {
+        const Eigen::VectorXd& coordinates = rInterpolation.GetNaturalNodeCoordinates(iNode);
+        for (int d = 0; d < TDim; ++d)
+            if (FindCoordinate(nodes1D, coordinates[d], tolerance) == -1)
+                nodes1D.push_back(coordinates[d]);
+    }
+    std::sort(nodes1D.begin(), nodes1D.end());
+    const int numNodes1D = nodes1D.size();
+
+    int numGridNodes = 1;
+    for (int d = 0; d < TDim; ++d)
+        numGridNodes *= numNodes1D;
+    if (numGridNodes != numNodes)
+        return nullptr;
+
+    std::unique_ptr<TensorProductKernel> kernel(new TensorProductKernel);
+
+    // each grid node has to be a node of the element
+    kernel->mNodes.assign(numNodes, -1);
+    for (int iNode = 0; iNode < numNodes; ++iNode)
+    {
+        const Eigen::VectorXd& coordinates = rInterpolation.GetNaturalNodeCoordinates(iNode);
+        int gridNode = 0;
+        int stride = 1;
+        for (int d = 0; d < TDim; ++d)
+        {
+            gridNode += stride * FindCoordinate(nodes1D, coordinates[d], tolerance);
+            stride *= numNodes1D;
+        }
+        if (kernel->mNodes[gridNode] != -1)
+            return nullptr;
+        kernel->mNodes[gridNode] = iNode;
+    }
+
+    const std::vector<double>& ips1D = integrationType->GetIntegrationPoints1D();
+    const int numIps1D = ips1D.size();
+    kernel->mN1D.resize(numIps1D, numNodes1D);
+    kernel->mDerivativeN1D.resize(numIps1D, numNodes1D);
+    for (int iIp = 0; iIp < numIps1D; ++iIp)
+        LagrangeBasis1D(nodes1D, ips1D[iIp], kernel->mN1D.row(iIp), kernel->mDerivativeN1D.row(iIp));
+
+    // the products of the 1D polynomials have to reproduce the shape functions of the interpolation. Some shape
+    // functions are implemented with rounded coefficients, so the tolerance is larger than the one of the coordinates.
+    constexpr double toleranceShapeFunctions = 1.e-9;
+    int numIps = 1;
+    for (int d = 0; d < TDim; ++d)
+        numIps *= numIps1D;
+    for (int iIp = 0; iIp < numIps; ++iIp)
+    {
+        std::array<int, TDim> ipIndex;
+        for (int d = 0, stride = 1; d < TDim; ++d, stride *= numIps1D)
+            ipIndex[d] = (iIp / stride) % numIps1D;
+
+        const Eigen::VectorXd coordinates = rIntegrationType.GetLocalIntegrationPointCoordinates(iIp);
+        const Eigen::VectorXd& shapeFunctions = rInterpolation.ShapeFunctions(coordinates);
+        const Eigen::MatrixXd& derivativeShapeFunctions = rInterpolation.DerivativeShapeFunctionsNatural(coordinates);
+
+        for (int gridNode = 0; gridNode < numNodes; ++gridNode)
+        {
+            std::array<int, TDim> nodeIndex;
+            for (int d = 0, stride = 1; d < TDim; ++d, stride *= numNodes1D)
+                nodeIndex[d] = (gridNode / stride) % numNodes1D;
+
+            const int iNode = kernel->mNodes[gridNode];
+            double value = 1.;
+            for (int d = 0; d < TDim; ++d)
+                value *= kernel->mN1D(ipIndex[d], nodeIndex[d]);
+            if (std::abs(value - shapeFunctions[iNode]) > toleranceShapeFunctions)
+                return nullptr;
+
+            for (int dDerivative = 0; dDerivative < TDim; ++dDerivative)
+            {
+                double derivative = 1.;
+                for (int d = 0; d < TDim; ++d)
+                    derivative *= d == dDerivative ? kernel->mDerivativeN1D(ipIndex[d], nodeIndex[d])
+                                                   : kernel->mN1D(ipIndex[d], nodeIndex[d]);
+                if (std::abs(derivative - derivativeShapeFunctions(iNode, dDerivative)) > toleranceShapeFunctions)
+                    return nullptr;
+            }
+        }
+    }
+    return kernel;
+}
+
+
+template <int TDim>
+void NuTo::TensorProductKernel<TDim>::Gradient(const Eigen::VectorXd& rNodalValues, int rNumComponents,
+                                               Eigen::MatrixXd& rGradients) const
+{
+    const int numNodes = mNodes.size();
+    assert(rNodalValues.rows() == numNodes * rNumComponents);
+
+    int numIps = 1;
+    for (int d = 0; d < TDim; ++d)
+        numIps *= GetNumIntegrationPoints1D();
+    rGradients.resize(numIps, rNumComponents * TDim);
+
+    mTensor.resize(numNodes);
+    for (int component = 0; component < rNumComponents; ++component)
+    {
+        for (int gridNode = 0; gridNode < numNodes; ++gridNode)
+            mTensor[gridNode] = rNodalValues[mNodes[gridNode] * rNumComponents + component];
+
+        // d/dxi_d: derivative in direction d, interpolation in the other directions
+        for (int dDerivative = 0; dDerivative < TDim; ++dDerivative)
+        {
+            std::array<int, TDim> sizes;
+            sizes.fill(GetNumNodes1D());
+            const double* tensor = mTensor.data();
+            for (int d = 0; d < TDim; ++d)
+            {
+                std::vector<double>& result = d % 2 == 0 ? mBuffer0 : mBuffer1;
+                ApplyAlongDirection(tensor, sizes, d, d == dDerivative ? mDerivativeN1D : mN1D, result);
+                tensor = result.data();
+            }
+            rGradients.col(component * TDim + dDerivative) = Eigen::Map<const Eigen::VectorXd>(tensor, numIps);
+        }
+    }
+}
+
+
+template <int TDim>
+void NuTo::TensorProductKernel<TDim>::AddIntegratedGradient(const Eigen::MatrixXd& rFluxes, int rNumComponents,
+                                                            Eigen::VectorXd& rNodalValues) const
+{
+    const int numNodes = mNodes.size();
+    assert(rNodalValues.rows() == numNodes * rNumComponents);
+    assert(rFluxes.cols() == rNumComponents * TDim);
+
+    mSum.resize(numNodes);
+    for (int component = 0; component < rNumComponents; ++component)
+    {
+        std::fill(mSum.begin(), mSum.end(), 0.);
+        for (int dDerivative = 0; dDerivative < TDim; ++dDerivative)
+        {
+            std::array<int, TDim> sizes;
+            sizes.fill(GetNumIntegrationPoints1D());
+            const double* tensor = rFluxes.col(component * TDim + dDerivative).data();
+            for (int d = 0; d < TDim; ++d)
+            {
+                std::vector<double>& result = d % 2 == 0 ? mBuffer0 : mBuffer1;
+                const Eigen::MatrixXd& matrix = d == dDerivative ? mDerivativeN1D : mN1D;
+                ApplyAlongDirection(tensor, sizes, d, matrix.transpose(), result);
+                tensor = result.data();
+            }
+            for (int gridNode = 0; gridNode < numNodes; ++gridNode)
+                mSum[gridNode] += tensor[gridNode];
+        }
+
+        for (int gridNode = 0; gridNode < numNodes; ++gridNode)
+            rNodalValues[mNodes[gridNode] * rNumComponents + component] += mSum[gridNode];
+    }
+}
+
+
+template <int TDim>
+template <typename TMatrix>
+void NuTo::TensorProductKernel<TDim>::ApplyAlongDirection(const double* rIn, std::array<int, TDim>& rSizes,
+                                                          int rDirection, const Eigen::MatrixBase<TMatrix>& rMatrix,
+                                                          std::vector<double>& rOut)
+{
+    const int sizeIn = rSizes[rDirection];
+    const int sizeOut = rMatrix.rows();
+    assert(rMatrix.cols() == sizeIn);
+
+    int inner = 1;
+    for (int d = 0; d < rDirection; ++d)
+        inner *= rSizes[d];
+    int outer = 1;
+    for (int d = rDirection + 1; d < TDim; ++d)
+        outer *= rSizes[d];
+
+    // for each index of the outer directions, the slice (inner x sizeIn) is multiplied with rMatrix^T
+    rOut.resize(inner * sizeOut * outer);
+    for (int iOuter = 0; iOuter < outer; ++iOuter)
+    {
+        Eigen::Map<const Eigen::MatrixXd> in(rIn + iOuter * inner * sizeIn, inner, sizeIn);
+        Eigen::Map<Eigen::MatrixXd> out(rOut.data() + iOuter * inner * sizeOut, inner, sizeOut);
+        out.noalias() = in * rMatrix.transpose();
+    }
+    rSizes[rDirection] = sizeOut;
+}
+
+
+template class NuTo::TensorProductKernel<1>;
+template class NuTo::TensorProductKernel<2>;
+template class NuTo::TensorProductKernel<3>;
@@ -0,0 +1,87 @@
+#pragma once
+
+#include <array>
+#include <memory>
+#include <vector>
+
+#include <Eigen/Core>
+
+namespace NuTo
+{
+class IntegrationTypeBase;
+class InterpolationBase;
+
+//! @brief sum factorization of the interpolation of tensor product elements
+//! @remark For Lagrange shape functions on a tensor product grid of nodes, the shape functions are products of 1D shape
+//! functions, N_i(xi) = phi_a(xi_0) phi_b(xi_1) phi_c(xi_2). If the integration points form a tensor product grid as
+//! well, the values and the natural derivatives of a field at all integration points follow from TDim successive
+//! products with the 1D matrices phi_a(x_q) and dphi_a/dxi(x_q), one per direction. With n nodes and integration points
+//! per direction this costs O(TDim n^(TDim+1)) operations instead of O(n^(2 TDim)) for the products with the full shape
+//! function matrices, which pays off for high order elements. The integration of fluxes against the shape function
+//! derivatives is the transposed operation.
+template <int TDim>
+class TensorProductKernel
+{
+public:
+    //! @brief creates the kernel for an interpolation and an integration type
+    //! @return kernel, nullptr if the interpolation is not a tensor product of 1D Lagrange polynomials or the
+    //! integration type is not a IntegrationTypeTensorProduct<TDim>
+    static std::unique_ptr<TensorProductKernel> Create(const InterpolationBase& rInterpolation,
+                                                       const IntegrationTypeBase& rIntegrationType);
+
+    //! @brief number of nodes per direction
+    int GetNumNodes1D() const
+    {
+        return mN1D.cols();
+    }
+
+    //! @brief number of integration points per direction
+    int GetNumIntegrationPoints1D() const
+    {
+        return mN1D.rows();
+    }
+
+    //! @brief calculates the derivatives of a field with respect to the natural coordinates at all integration points
+    //! @param rNodalValues ... nodal values, the components of a node are stored consecutively
+    //! @param rNumComponents ... number of components of the field
+    //! @param rGradients ... numIps x (rNumComponents * TDim), column c * TDim + d contains du_c/dxi_d (return value)
+    void Gradient(const Eigen::VectorXd& rNodalValues, int rNumComponents, Eigen::MatrixXd& rGradients) const;
+
+    //! @brief transposed operation of Gradient, adds sum_ip dN_i/dxi_d(ip) rFluxes(ip, c * TDim + d) to the component c
+    //! of node i
+    //! @param rFluxes ... numIps x (rNumComponents * TDim)
+    //! @param rNumComponents ... number of components of the field
+    //! @param rNodalValues ... nodal values, the components of a node are stored consecutively
+    void AddIntegratedGradient(const Eigen::MatrixXd& rFluxes, int rNumComponents,
+                               Eigen::VectorXd& rNodalValues) const;
+
+private:
+    TensorProductKernel() = default;
+
+    //! @brief applies rMatrix to the index rDirection of the tensor rIn
+    //! @param rIn ... tensor with rSizes[d] entries in direction d, direction 0 counts fastest
+    //! @param rSizes ... sizes of rIn, the size of rDirection is replaced by the number of rows of rMatrix
+    //! @param rDirection ... direction
+    //! @param rMatrix ... matrix with rSizes[rDirection] columns
+    //! @param rOut ... result
+    template <typename TMatrix>
+    static void ApplyAlongDirection(const double* rIn, std::array<int, TDim>& rSizes, int rDirection,
+                                    const Eigen::MatrixBase<TMatrix>& rMatrix, std::vector<double>& rOut);
+
+    //! @brief 1D shape functions at the 1D integration points, numIps1D x numNodes1D
+    Eigen::MatrixXd mN1D;
+
+    //! @brief derivatives of the 1D shape functions at the 1D integration points, numIps1D x numNodes1D
+    Eigen::MatrixXd mDerivativeN1D;
+
+    //! @brief element node of the grid node i_0 + n i_1 + n^2 i_2
+    std::vector<int> mNodes;
+
+    //! @brief temporary tensors, a kernel must not be used by several threads at once
+    mutable std::vector<double> mTensor;
+    mutable std::vector<double> mSum;
+    mutable std::vector<double> mBuffer0;
+    mutable std::vector<double> mBuffer1;
+};
+
+} /* namespace NuTo */
@@ -1,9 +1,11 @@
 #pragma once
 
-#include <map>
-
 #include <algorithm>
 #include <cassert>
+#include <cstdint>
+#include <iterator>
+#include <utility>
+#include <vector>
 #include "mechanics/groups/GroupBase.h"
 #include "base/Exception.h"
 
@@ -14,15 +16,23 @@ class NodeBase;
 //! @author Jörg F. Unger, ISM
 //! @date October 2009
 //! @brief ... standard abstract class for all groups
+//! @remark The members are stored as (id, pointer) pairs in a vector sorted by the ids, which provides the interface of
+//! a map (begin, end, find, size) without allocations per member. Groups with non-negative and dense ids additionally
+//! keep a bitset of the ids, then membership tests take constant time. Members are appended in constant time if they
+//! are added in the order of their ids, several members in any order are added by one sort, see AddMembers.
+//! @remark Modifications are not thread safe, the const access is read-only.
 template <class T>
-class Group : public GroupBase, public std::map<int, T*>
+class Group : public GroupBase
 {
 
 public:
+    using value_type = std::pair<int, T*>;
+    using iterator = typename std::vector<value_type>::iterator;
+    using const_iterator = typename std::vector<value_type>::const_iterator;
+
     //! @brief constructor
     Group()
         : GroupBase()
-        , std::map<int, T*>()
     {
     }
 
@@ -48,16 +58,45 @@ public:
     //! @param rMember new member
     void AddMember(int rId, T* rMember) override
     {
-        if ((this->insert(std::pair<int, T*>(rId, rMember))).second == false)
+        if (Contain(rId))
             throw Exception("[Group::AddMember] Group member already exists in the group.");
+
+        if (mHasBitset and (rId < 0 or not IsDense(rId, size() + 1)))
+            ClearBitset();
+
+        mMembers.insert(LowerBound(rId), value_type(rId, rMember));
+        if (mHasBitset)
+            SetBit(rId, true);
+        // the bitset is considered whenever the size doubles
+        else if ((size() & (size() - 1)) == 0)
+            BuildBitset();
+    }
+
+    //! @brief adds several group members, they are sorted once instead of being inserted one by one
+    //! @param rMembers new members (id, member) in any order, e.g. in the storage order of the structure
+    void AddMembers(std::vector<value_type> rMembers)
+    {
+        std::sort(rMembers.begin(), rMembers.end(), CompareIds);
+        for (std::size_t i = 0; i < rMembers.size(); ++i)
+            if ((i > 0 and rMembers[i].first == rMembers[i - 1].first) or Contain(rMembers[i].first))
+                throw Exception("[Group::AddMembers] Group member already exists in the group.");
+
+        const std::size_t numMembers = mMembers.size();
+        mMembers.insert(mMembers.end(), rMembers.begin(), rMembers.end());
+        std::inplace_merge(mMembers.begin(), mMembers.begin() + numMembers, mMembers.end(), CompareIds);
+        BuildBitset();
     }
 
     //! @brief removes a group member
     //! @param rMember member to be removed
     void RemoveMember(int rId) override
     {
-        if (!this->erase(rId))
+        if (not Contain(rId))
             throw Exception("[Group::AddMember] Group member to be deleted is not within the group.");
+
+        mMembers.erase(LowerBound(rId));
+        if (mHasBitset)
+            SetBit(rId, false);
     }
 
     //! @brief check if a group contains the entry
@@ -65,6 +104,8 @@ public:
     //! @return TRUE if rMember is in the group, FALSE otherwise
     bool Contain(int rId) const override
     {
+        if (mHasBitset)
+            return rId >= 0 and rId < static_cast<int>(64 * mBitset.size()) and GetBit(rId);
         return this->find(rId) != this->end();
     }
 
@@ -74,7 +115,7 @@ public:
     //! @param rNewPtr
     void ExchangePtr(int rId, T* rOldMember, T* rNewMember) override
     {
-        typename std::map<int, T*>::iterator it(this->find(rId));
+        iterator it(this->find(rId));
         if (it == this->end())
             throw Exception(
                     "[Group::ExchangePtr] New group member can not be inserted, since the id does not exist in group.");
@@ -89,60 +130,68 @@ public:
     //! @return group
     GroupBase* Unite(const NuTo::GroupBase* rOther) const override
     {
-        NuTo::Group<T>* returnGroup = new NuTo::Group<T>();
         const Group<T>* rOtherT = dynamic_cast<const Group<T>*>(rOther);
         if (rOtherT == nullptr)
             throw Exception("[NuTo::Group::Unite] Groups do not have the same type.");
-        std::insert_iterator<NuTo::Group<T>> returnGroupInsertIterator(*returnGroup, returnGroup->begin());
-        std::set_union(this->begin(), this->end(), rOtherT->begin(), rOtherT->end(), returnGroupInsertIterator);
-        return returnGroup;
+        return new Group<T>(Unite(*this, *rOtherT));
     }
 
     //! @brief Union of groupOne and groupTwo
     //! @return Union of groupOne and groupTwo
     static Group<T> Unite(const Group<T>& groupOne, const Group<T>& groupTwo)
     {
-        NuTo::Group<T> returnGroup;
-        std::insert_iterator<NuTo::Group<T>> returnGroupInsertIterator(returnGroup, returnGroup.begin());
-        std::set_union(groupOne.begin(), groupOne.end(), groupTwo.begin(), groupTwo.end(), returnGroupInsertIterator);
-        return returnGroup;
+        std::vector<value_type> members;
+        members.reserve(groupOne.size() + groupTwo.size());
+        std::set_union(groupOne.begin(), groupOne.end(), groupTwo.begin(), groupTwo.end(),
+                       std::back_inserter(members), CompareIds);
+        return Group<T>(std::move(members));
     }
 
     //! @brief Intersection of groupOne and groupTwo
     //! @return Intersection of groupOne and groupTwo
     static Group<T> GetIntersection(const Group<T>& groupOne, const Group<T>& groupTwo)
     {
-        NuTo::Group<T> returnGroup;
-        std::insert_iterator<NuTo::Group<T>> returnGroupInsertIterator(returnGroup, returnGroup.begin());
-        std::set_intersection(groupOne.begin(), groupOne.end(), groupTwo.begin(), groupTwo.end(),
-                              returnGroupInsertIterator);
-        return returnGroup;
+        std::vector<value_type> members;
+        if (groupTwo.mHasBitset)
+        {
+            for (const auto& member : groupOne)
+                if (groupTwo.Contain(member.first))
+                    members.push_back(member);
+        }
+        else
+            std::set_intersection(groupOne.begin(), groupOne.end(), groupTwo.begin(), groupTwo.end(),
+                                  std::back_inserter(members), CompareIds);
+        return Group<T>(std::move(members));
     }
 
     //! @brief returns a group with all members of current group, which are not presented in the second group
     //! @return group
     GroupBase* Difference(const NuTo::GroupBase* rOther) const override
     {
-        NuTo::Group<T>* returnGroup = new NuTo::Group<T>();
         const Group<T>* rOtherT = dynamic_cast<const Group<T>*>(rOther);
         if (rOtherT == nullptr)
             throw Exception("[NuTo::Group::Difference] Groups do not have the same type.");
-        std::insert_iterator<NuTo::Group<T>> returnGroupInsertIterator(*returnGroup, returnGroup->begin());
-        std::set_difference(this->begin(), this->end(), rOtherT->begin(), rOtherT->end(), returnGroupInsertIterator);
-        return returnGroup;
+        std::vector<value_type> members;
+        if (rOtherT->mHasBitset)
+        {
+            for (const auto& member : *this)
+                if (not rOtherT->Contain(member.first))
+                    members.push_back(member);
+        }
+        else
+            std::set_difference(this->begin(), this->end(), rOtherT->begin(), rOtherT->end(),
+                                std::back_inserter(members), CompareIds);
+        return new Group<T>(std::move(members));
     }
 
     //! @brief returns a group with all members which are elements of both groups
     //! @return group
     GroupBase* Intersection(const NuTo::GroupBase* rOther) const override
     {
-        NuTo::Group<T>* returnGroup = new NuTo::Group<T>();
         const Group<T>* rOtherT = dynamic_cast<const Group<T>*>(rOther);
         if (rOtherT == nullptr)
             throw Exception("[NuTo::Group::Intersection] Groups do not have the same type.");
-        std::insert_iterator<NuTo::Group<T>> returnGroupInsertIterator(*returnGroup, returnGroup->begin());
-        std::set_intersection(this->begin(), this->end(), rOtherT->begin(), rOtherT->end(), returnGroupInsertIterator);
-        return returnGroup;
+        return new Group<T>(GetIntersection(*this, *rOtherT));
     }
 
     //! @brief returns a group with the symmetric difference, i.e. all elements present in group 1 or in group 2 (but
@@ -150,14 +199,13 @@ public:
     //! @return group
     GroupBase* SymmetricDifference(const NuTo::GroupBase* rOther) const override
     {
-        NuTo::Group<T>* returnGroup = new NuTo::Group<T>();
         const Group<T>* rOtherT = dynamic_cast<const Group<T>*>(rOther);
         if (rOtherT == nullptr)
             throw Exception("[NuTo::Group::SymmetricDifference] Groups to be united do not have the same type.");
-        std::insert_iterator<NuTo::Group<T>> returnGroupInsertIterator(*returnGroup, returnGroup->begin());
+        std::vector<value_type> members;
         std::set_symmetric_difference(this->begin(), this->end(), rOtherT->begin(), rOtherT->end(),
-                                      returnGroupInsertIterator);
-        return returnGroup;
+                                      std::back_inserter(members), CompareIds);
+        return new Group<T>(std::move(members));
     }
 
     //! @brief either casts the pointer to an element group or throws an exception for groups which are not element
@@ -185,5 +233,132 @@ public:
     //! @brief gives the group type
     //! @return group type
     void Info(int rVerboseLevel) const override;
+
+    //! @brief returns true, if the group keeps a bitset of its member ids
+    bool HasBitset() const
+    {
+        return mHasBitset;
+    }
+
+    //! @brief members in ascending order of their ids
+    iterator begin()
+    {
+        return mMembers.begin();
+    }
+
+    iterator end()
+    {
+        return mMembers.end();
+    }
+
+    const_iterator begin() const
+    {
+        return mMembers.cbegin();
+    }
+
+    const_iterator end() const
+    {
+        return mMembers.cend();
+    }
+
+    //! @brief returns the member with the id rId, end() if it is not contained
+    iterator find(int rId)
+    {
+        auto it = LowerBound(rId);
+        return (it != mMembers.end() and it->first == rId) ? it : mMembers.end();
+    }
+
+    const_iterator find(int rId) const
+    {
+        auto it = std::lower_bound(mMembers.cbegin(), mMembers.cend(), rId,
+                                   [](const value_type& rMember, int rValue) { return rMember.first < rValue; });
+        return (it != mMembers.cend() and it->first == rId) ? it : mMembers.cend();
+    }
+
+    std::size_t size() const
+    {
+        return mMembers.size();
+    }
+
+    bool empty() const
+    {
+        return size() == 0;
+    }
+
+    //! @brief removes all members
+    void clear()
+    {
+        mMembers.clear();
+        ClearBitset();
+    }
+
+private:
+    //! @brief group of members sorted by their ids
+    explicit Group(std::vector<value_type>&& rSortedMembers)
+        : GroupBase()
+        , mMembers(std::move(rSortedMembers))
+    {
+        BuildBitset();
+    }
+
+    static bool CompareIds(const value_type& rA, const value_type& rB)
+    {
+        return rA.first < rB.first;
+    }
+
+    //! @brief returns true, if the group is large and a bitset for ids up to rMaxId needs at most 64 bits per member,
+    //! i.e. less memory than the members
+    static bool IsDense(int rMaxId, std::size_t rNumMembers)
+    {
+        return rNumMembers >= 64 and static_cast<std::size_t>(rMaxId) < 64 * rNumMembers;
+    }
+
+    //! @brief first member with an id >= rId
+    iterator LowerBound(int rId)
+    {
+        return std::lower_bound(mMembers.begin(), mMembers.end(), rId,
+                                [](const value_type& rMember, int rValue) { return rMember.first < rValue; });
+    }
+
+    //! @brief builds the bitset, if all ids are non-negative and dense
+    void BuildBitset()
+    {
+        ClearBitset();
+        if (mMembers.empty() or mMembers.front().first < 0 or not IsDense(mMembers.back().first, size()))
+            return;
+        mHasBitset = true;
+        for (const auto& member : mMembers)
+            SetBit(member.first, true);
+    }
+
+    void ClearBitset()
+    {
+        std::vector<std::uint64_t>().swap(mBitset);
+        mHasBitset = false;
+    }
+
+    bool GetBit(int rId) const
+    {
+        const std::size_t word = rId / 64;
+        return word < mBitset.size() and (mBitset[word] >> (rId % 64)) & 1;
+    }
+
+    void SetBit(int rId, bool rValue)
+    {
+        const std::size_t word = rId / 64;
+        if (word >= mBitset.size())
+            mBitset.resize(std::max(word + 1, 2 * mBitset.size()), 0);
+        if (rValue)
+            mBitset[word] |= std::uint64_t(1) << (rId % 64);
+        else
+            mBitset[word] &= ~(std::uint64_t(1) << (rId % 64));
+    }
+
+    //! @brief members, sorted by their ids
+    std::vector<value_type> mMembers;
+
+    //! @brief bit i is set, if the member with id i is contained
+    bool mHasBitset = false;
+    std::vector<std::uint64_t> mBitset;
 };
 } // namespace NuTo
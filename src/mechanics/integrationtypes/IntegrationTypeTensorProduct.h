@@ -39,6 +39,13 @@ public:
     //! @return weight of integration points
     double GetIntegrationPointWeight(int rIpNum) const override;
 
+    //! @brief returns the coordinates of the 1D integration points, the integration point i_0 + n i_1 + n^2 i_2 has
+    //! the coordinates (x_i_0, x_i_1, x_i_2)
+    const std::vector<double>& GetIntegrationPoints1D() const
+    {
+        return mIPts1D;
+    }
+
     void GetVisualizationCells(unsigned int& NumVisualizationPoints,
                                std::vector<double>& VisualizationPointLocalCoordinates,
                                unsigned int& NumVisualizationCells,
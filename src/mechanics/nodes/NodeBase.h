@@ -7,6 +7,7 @@
 
 namespace NuTo
 {
+class StructureGeneration;
 namespace Node
 {
 enum class eDof : unsigned char;
@@ -147,9 +148,21 @@ public:
     //! @brief clones (copies) the node with all its data, it's supposed to be a new node, so be careful with ptr
     virtual NodeBase* Clone() const = 0;
 
+    //! @brief sets the generations of the structure the node belongs to, the node marks the geometry as modified when
+    //! its coordinates are set
+    //! @param rGeneration ... generations of the structure (see StructureGeneration), have to outlive the node.
+    //! nullptr for nodes without structure.
+    void SetStructureGeneration(StructureGeneration* rGeneration)
+    {
+        mStructureGeneration = rGeneration;
+    }
+
 protected:
     //! @brief Outstream function for "virtual friend idiom"
     virtual void Info(std::ostream& out) const = 0;
+
+    //! @brief generations of the structure the node belongs to, see SetStructureGeneration
+    StructureGeneration* mStructureGeneration = nullptr;
 };
 
 std::ostream& operator<<(std::ostream& out, const NodeBase& node);
@@ -1,5 +1,6 @@
 #include "mechanics/nodes/NodeDof.h"
 #include "mechanics/nodes/NodeEnum.h"
+#include "mechanics/structures/StructureGeneration.h"
 
 using namespace NuTo;
 
@@ -101,6 +102,8 @@ void NodeDof::Set(Node::eDof rDof, int rTimeDerivative, const Eigen::VectorXd& r
                                                      ". This node only has " + std::to_string(it->second.size()) + ".");
 
     it->second[rTimeDerivative] = rValue;
+    if (rDof == Node::eDof::COORDINATES and mStructureGeneration != nullptr)
+        mStructureGeneration->SetGeometryModified();
 }
 
 std::set<Node::eDof> NodeDof::GetDofTypes() const
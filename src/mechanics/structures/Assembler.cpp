@@ -14,7 +14,7 @@ NuTo::Assembler::Assembler()
 {
 }
 
-void NuTo::Assembler::BuildGlobalDofs(const std::vector<NodeBase*>& rNodes)
+void NuTo::Assembler::BuildGlobalDofs(const std::vector<NodeBase*>& rNodes, bool keepNodeOrder)
 {
     std::map<Node::eDof, int> numDofsMap;
 
@@ -87,6 +87,22 @@ void NuTo::Assembler::BuildGlobalDofs(const std::vector<NodeBase*>& rNodes)
         }
         mappingNewToInitialOrdering.clear();
 
+        // restore the initial order of the active dofs
+        if (keepNodeOrder)
+        {
+            std::vector<int> activeRenumbering(numActiveDofs);
+            int numOrderedActiveDofs = 0;
+            for (int newDofNumber : mappingInitialToNewOrdering)
+                if (newDofNumber < numActiveDofs)
+                    activeRenumbering[newDofNumber] = numOrderedActiveDofs++;
+            for (int& newDofNumber : mappingInitialToNewOrdering)
+                if (newDofNumber < numActiveDofs)
+                    newDofNumber = activeRenumbering[newDofNumber];
+            for (int& newDofNumber : tmpMapping)
+                if (newDofNumber < numActiveDofs)
+                    newDofNumber = activeRenumbering[newDofNumber];
+        }
+
         // reorder columns
         constraintMatrix.ReorderColumns(tmpMapping);
 
@@ -22,7 +22,9 @@ public:
     //! @brief builds the global dof numbering depending on the constraints
     //! sets the members mConstraintMatrix, mConstraintMappingRhs and mConstraintRhs [for time t=0]
     //! @param nodes all the nodes included in the global dof numbering
-    void BuildGlobalDofs(const std::vector<NodeBase*>& nodes);
+    //! @param keepNodeOrder true: the active dofs are numbered in the order of the nodes, otherwise the pivoting of the
+    //! constraint elimination swaps some of them
+    void BuildGlobalDofs(const std::vector<NodeBase*>& nodes, bool keepNodeOrder = false);
 
     //! @brief getter for mConstraintRhs, set via ConstraintUpdateRhs
     const BlockFullVector<double>& GetConstraintRhs() const
@@ -0,0 +1,232 @@
+#include "mechanics/structures/AssemblyPattern.h"
+
+#include <algorithm>
+#include <cassert>
+
+#include "base/Exception.h"
+#include "math/SparseMatrixCSRVector2.h"
+#include "mechanics/constitutive/ConstitutiveBase.h"
+#include "mechanics/dofSubMatrixStorage/BlockFullMatrix.h"
+#include "mechanics/dofSubMatrixStorage/BlockFullVector.h"
+#include "mechanics/dofSubMatrixStorage/DofStatus.h"
+#include "mechanics/elements/ElementBase.h"
+
+
+NuTo::AssemblyPattern::AssemblyPattern(const DofStatus& rDofStatus)
+    : mPattern(rDofStatus, true)
+    , mActiveDofTypes(rDofStatus.GetActiveDofTypes())
+    , mNumActiveDofsMap(rDofStatus.GetNumActiveDofsMap())
+    , mNumDependentDofsMap(rDofStatus.GetNumDependentDofsMap())
+{
+}
+
+
+void NuTo::AssemblyPattern::AddElement(const ElementBase* rElementPtr, const BlockFullVector<int>& rGlobalRowDofs,
+                                       const BlockFullVector<int>& rGlobalColumnDofs)
+{
+    if (mFinalized)
+        throw Exception(__PRETTY_FUNCTION__, "The pattern is already finalized.");
+
+    std::vector<ScatterBlock>& scatterMap = mScatterMaps[rElementPtr];
+    scatterMap.clear();
+
+    for (auto dofRow : mActiveDofTypes)
+        for (auto dofCol : mActiveDofTypes)
+        {
+            if (not rElementPtr->GetConstitutiveLaw(0).CheckDofCombinationComputable(dofRow, dofCol, 0))
+                continue;
+
+            const auto& globalRowDofs = rGlobalRowDofs[dofRow];
+            const auto& globalColDofs = rGlobalColumnDofs[dofCol];
+
+            const int numActiveDofsRow = mNumActiveDofsMap.at(dofRow);
+            const int numActiveDofsCol = mNumActiveDofsMap.at(dofCol);
+
+            ScatterBlock blocks[4];
+            for (eSubMatrix subMatrix : {eSubMatrix::JJ, eSubMatrix::JK, eSubMatrix::KJ, eSubMatrix::KK})
+            {
+                auto& block = blocks[static_cast<int>(subMatrix)];
+                block.mDofRow = dofRow;
+                block.mDofCol = dofCol;
+                block.mSubMatrix = subMatrix;
+            }
+
+            for (int iCol = 0; iCol < globalColDofs.rows(); ++iCol)
+                for (int iRow = 0; iRow < globalRowDofs.rows(); ++iRow)
+                {
+                    int globalRowDof = globalRowDofs[iRow];
+                    int globalColDof = globalColDofs[iCol];
+                    eSubMatrix subMatrix;
+                    if (globalRowDof < numActiveDofsRow)
+                    {
+                        if (globalColDof < numActiveDofsCol)
+                            subMatrix = eSubMatrix::JJ;
+                        else
+                        {
+                            subMatrix = eSubMatrix::JK;
+                            globalColDof -= numActiveDofsCol;
+                        }
+                    }
+                    else
+                    {
+                        globalRowDof -= numActiveDofsRow;
+                        if (globalColDof < numActiveDofsCol)
+                            subMatrix = eSubMatrix::KJ;
+                        else
+                        {
+                            subMatrix = eSubMatrix::KK;
+                            globalColDof -= numActiveDofsCol;
+                        }
+                    }
+
+                    auto& globalMatrix = GetSubMatrix(mPattern, subMatrix)(dofRow, dofCol);
+                    if (globalMatrix.IsSymmetric() && globalRowDof > globalColDof)
+                        continue; // entry would be in lower triangle --> not valid for symmetric matrices
+
+                    globalMatrix.AddValue(globalRowDof, globalColDof, 0.);
+
+                    auto& block = blocks[static_cast<int>(subMatrix)];
+                    block.mSource.push_back(iRow + iCol * globalRowDofs.rows());
+                    block.mRow.push_back(globalRowDof);
+                    block.mPosition.push_back(globalColDof);
+                }
+
+            for (auto& block : blocks)
+                if (not block.mSource.empty())
+                    scatterMap.push_back(std::move(block));
+        }
+}
+
+
+void NuTo::AssemblyPattern::Finalize()
+{
+    // the pattern is complete, the columns are replaced by the positions of the entries in the rows
+    for (auto& scatterMap : mScatterMaps)
+        for (auto& block : scatterMap.second)
+        {
+            const auto& columns = GetSubMatrix(mPattern, block.mSubMatrix)(block.mDofRow, block.mDofCol).GetColumns();
+            for (unsigned int i = 0; i < block.mSource.size(); ++i)
+            {
+                const auto& rowColumns = columns[block.mRow[i]];
+                auto it = std::lower_bound(rowColumns.begin(), rowColumns.end(), block.mPosition[i]);
+                assert(it != rowColumns.end() and *it == block.mPosition[i]);
+                block.mPosition[i] = std::distance(rowColumns.begin(), it);
+            }
+        }
+    mFinalized = true;
+}
+
+
+bool NuTo::AssemblyPattern::IsValid(const DofStatus& rDofStatus) const
+{
+    if (not mFinalized)
+        return false;
+
+    if (mActiveDofTypes != rDofStatus.GetActiveDofTypes() or mNumActiveDofsMap != rDofStatus.GetNumActiveDofsMap() or
+        mNumDependentDofsMap != rDofStatus.GetNumDependentDofsMap())
+        return false;
+
+    for (auto dof : mActiveDofTypes)
+        if (mPattern.JJ(dof, dof).IsSymmetric() != rDofStatus.IsSymmetric(dof))
+            return false;
+
+    return true;
+}
+
+
+void NuTo::AssemblyPattern::InitializeMatrix(StructureOutputBlockMatrix& rMatrix) const
+{
+    bool samePattern = true;
+    for (eSubMatrix subMatrix : {eSubMatrix::JJ, eSubMatrix::JK, eSubMatrix::KJ, eSubMatrix::KK})
+        for (auto dofRow : mActiveDofTypes)
+            for (auto dofCol : mActiveDofTypes)
+            {
+                auto& matrix = GetSubMatrix(rMatrix, subMatrix)(dofRow, dofCol);
+                const auto& pattern = GetSubMatrix(mPattern, subMatrix)(dofRow, dofCol);
+                if (matrix.IsSymmetric() != pattern.IsSymmetric())
+                    throw Exception(__PRETTY_FUNCTION__, "The symmetry of the matrix does not match the pattern.");
+
+                matrix.SetZeroBasedIndexing();
+                if (matrix.GetNumColumns() != pattern.GetNumColumns() or matrix.GetColumns() != pattern.GetColumns())
+                    samePattern = false;
+            }
+
+    if (not samePattern)
+        rMatrix = mPattern;
+}
+
+
+void NuTo::AssemblyPattern::AddElementMatrix(const ElementBase* rElementPtr,
+                                             const BlockFullMatrix<double>& rElementMatrix,
+                                             StructureOutputBlockMatrix& rMatrix) const
+{
+    auto itScatterMap = mScatterMaps.find(rElementPtr);
+    if (itScatterMap == mScatterMaps.end())
+        throw Exception(__PRETTY_FUNCTION__, "The element is not part of the pattern.");
+
+    for (const auto& block : itScatterMap->second)
+    {
+        const double* elementValues = rElementMatrix(block.mDofRow, block.mDofCol).data();
+        auto& values = GetSubMatrix(rMatrix, block.mSubMatrix)(block.mDofRow, block.mDofCol).GetValuesReference();
+
+        const int numEntries = block.mSource.size();
+        const int* source = block.mSource.data();
+        const int* row = block.mRow.data();
+        const int* position = block.mPosition.data();
+        for (int i = 0; i < numEntries; ++i)
+            values[row[i]][position[i]] += elementValues[source[i]];
+    }
+}
+
+
+void NuTo::AssemblyPattern::AddMatrix(StructureOutputBlockMatrix& rMatrix, const StructureOutputBlockMatrix& rOther) const
+{
+    for (eSubMatrix subMatrix : {eSubMatrix::JJ, eSubMatrix::JK, eSubMatrix::KJ, eSubMatrix::KK})
+        for (auto dofRow : mActiveDofTypes)
+            for (auto dofCol : mActiveDofTypes)
+            {
+                auto& values = GetSubMatrix(rMatrix, subMatrix)(dofRow, dofCol).GetValuesReference();
+                const auto& otherValues = GetSubMatrix(rOther, subMatrix)(dofRow, dofCol).GetValues();
+                assert(values.size() == otherValues.size());
+                for (unsigned int row = 0; row < values.size(); ++row)
+                {
+                    assert(values[row].size() == otherValues[row].size());
+                    for (unsigned int pos = 0; pos < values[row].size(); ++pos)
+                        values[row][pos] += otherValues[row][pos];
+                }
+            }
+}
+
+
+NuTo::BlockSparseMatrix& NuTo::AssemblyPattern::GetSubMatrix(StructureOutputBlockMatrix& rMatrix,
+                                                             eSubMatrix rSubMatrix)
+{
+    switch (rSubMatrix)
+    {
+    case eSubMatrix::JJ:
+        return rMatrix.JJ;
+    case eSubMatrix::JK:
+        return rMatrix.JK;
+    case eSubMatrix::KJ:
+        return rMatrix.KJ;
+    default:
+        return rMatrix.KK;
+    }
+}
+
+
+const NuTo::BlockSparseMatrix& NuTo::AssemblyPattern::GetSubMatrix(const StructureOutputBlockMatrix& rMatrix,
+                                                                   eSubMatrix rSubMatrix)
+{
+    switch (rSubMatrix)
+    {
+    case eSubMatrix::JJ:
+        return rMatrix.JJ;
+    case eSubMatrix::JK:
+        return rMatrix.JK;
+    case eSubMatrix::KJ:
+        return rMatrix.KJ;
+    default:
+        return rMatrix.KK;
+    }
+}
@@ -0,0 +1,114 @@
+#pragma once
+
+#include <map>
+#include <set>
+#include <unordered_map>
+#include <vector>
+
+#include "mechanics/nodes/NodeEnum.h"
+#include "mechanics/structures/StructureOutputBlockMatrix.h"
+
+namespace NuTo
+{
+class DofStatus;
+class ElementBase;
+template <typename T>
+class BlockFullMatrix;
+template <typename T>
+class BlockFullVector;
+
+//! @brief symbolic part of the assembly of element matrices into a StructureOutputBlockMatrix
+//! @remark The sparsity pattern of the global matrix and, for each element, the positions of the element matrix entries
+//! in this pattern are computed once (symbolic phase). The numeric assembly then adds the element matrices without
+//! searching for the entries in the rows of the global matrix. The pattern has to be rebuilt whenever the dof numbering,
+//! the elements or their constitutive laws change.
+class AssemblyPattern
+{
+public:
+    //! @brief ctor
+    //! @param rDofStatus ... dof status of the structure, the active dof types and dof numbers are stored
+    AssemblyPattern(const DofStatus& rDofStatus);
+
+    //! @brief symbolic phase, step 1: adds all entries of an element matrix to the sparsity pattern
+    //! @param rElementPtr ... element
+    //! @param rGlobalRowDofs ... global row dof numbers of the element
+    //! @param rGlobalColumnDofs ... global column dof numbers of the element
+    void AddElement(const ElementBase* rElementPtr, const BlockFullVector<int>& rGlobalRowDofs,
+                    const BlockFullVector<int>& rGlobalColumnDofs);
+
+    //! @brief symbolic phase, step 2: computes the positions of the element matrix entries in the final pattern
+    //! @remark no elements can be added afterwards
+    void Finalize();
+
+    //! @brief returns true, if the pattern was built for the current active dof types, dof numbers and symmetries
+    //! @param rDofStatus ... dof status of the structure
+    bool IsValid(const DofStatus& rDofStatus) const;
+
+    //! @brief prepares a matrix for the numeric assembly
+    //! @remark the pattern (with zero entries) is copied to rMatrix, if the active submatrices of rMatrix have a
+    //! different sparsity pattern. Otherwise, rMatrix is not modified.
+    //! @param rMatrix ... matrix
+    void InitializeMatrix(StructureOutputBlockMatrix& rMatrix) const;
+
+    //! @brief numeric phase: adds an element matrix to rMatrix
+    //! @remark all entries of the element matrix are added, even if they are zero. Entries in the lower triangle of
+    //! symmetric submatrices and dof combinations that are not computable by the constitutive law are skipped.
+    //! @param rElementPtr ... element, has to be added in the symbolic phase
+    //! @param rElementMatrix ... element matrix
+    //! @param rMatrix ... global matrix, initialized via InitializeMatrix
+    void AddElementMatrix(const ElementBase* rElementPtr, const BlockFullMatrix<double>& rElementMatrix,
+                          StructureOutputBlockMatrix& rMatrix) const;
+
+    //! @brief adds rOther to rMatrix by adding the values entry by entry
+    //! @param rMatrix ... matrix, initialized via InitializeMatrix
+    //! @param rOther ... other matrix, initialized via InitializeMatrix
+    void AddMatrix(StructureOutputBlockMatrix& rMatrix, const StructureOutputBlockMatrix& rOther) const;
+
+    //! @brief returns the number of elements in the pattern
+    int GetNumElements() const
+    {
+        return mScatterMaps.size();
+    }
+
+private:
+    //! @brief submatrices of the StructureOutputBlockMatrix
+    enum class eSubMatrix
+    {
+        JJ,
+        JK,
+        KJ,
+        KK
+    };
+
+    //! @brief positions of the entries of one (dofRow, dofCol) block of an element matrix in one global submatrix
+    struct ScatterBlock
+    {
+        Node::eDof mDofRow;
+        Node::eDof mDofCol;
+        eSubMatrix mSubMatrix;
+        //! @brief index of the entry in the (column major) element matrix block
+        std::vector<int> mSource;
+        //! @brief row in the global submatrix
+        std::vector<int> mRow;
+        //! @brief position in the row of the global submatrix, column in the global submatrix before Finalize()
+        std::vector<int> mPosition;
+    };
+
+    static BlockSparseMatrix& GetSubMatrix(StructureOutputBlockMatrix& rMatrix, eSubMatrix rSubMatrix);
+
+    static const BlockSparseMatrix& GetSubMatrix(const StructureOutputBlockMatrix& rMatrix, eSubMatrix rSubMatrix);
+
+    //! @brief sparsity pattern, all entries are zero
+    StructureOutputBlockMatrix mPattern;
+
+    //! @brief scatter map of each element
+    std::unordered_map<const ElementBase*, std::vector<ScatterBlock>> mScatterMaps;
+
+    std::set<Node::eDof> mActiveDofTypes;
+    std::map<Node::eDof, int> mNumActiveDofsMap;
+    std::map<Node::eDof, int> mNumDependentDofsMap;
+
+    bool mFinalized = false;
+};
+
+} // namespace NuTo
@@ -0,0 +1,98 @@
+#include "mechanics/structures/ElementDofTable.h"
+
+#include <map>
+#include <memory>
+
+#include "base/Exception.h"
+#include "mechanics/dofSubMatrixStorage/DofStatus.h"
+#include "mechanics/elements/ElementBase.h"
+#include "mechanics/elements/ElementEnum.h"
+#include "mechanics/elements/ElementOutputBlockVectorInt.h"
+
+
+NuTo::ElementDofTable::ElementDofTable(const DofStatus& rDofStatus)
+    : mDofStatus(rDofStatus)
+{
+}
+
+
+void NuTo::ElementDofTable::Update(const std::vector<ElementBase*>& rElements)
+{
+    CheckActiveDofTypes();
+
+    // entries are removed together with their elements, so a table with one entry per element is complete
+    if (mEntries.size() == rElements.size())
+        return;
+
+    mEntries.reserve(rElements.size());
+    for (ElementBase* element : rElements)
+        if (not Contains(*element))
+            Add(*element);
+}
+
+
+void NuTo::ElementDofTable::Update(ElementBase& rElement)
+{
+    CheckActiveDofTypes();
+    if (not Contains(rElement))
+        Add(rElement);
+}
+
+
+void NuTo::ElementDofTable::Remove(const ElementBase& rElement)
+{
+    auto itIndex = mIndex.find(&rElement);
+    if (itIndex == mIndex.end())
+        return;
+
+    // the last entry fills the gap
+    const int index = itIndex->second;
+    mIndex.erase(itIndex);
+    if (index != static_cast<int>(mEntries.size()) - 1)
+    {
+        mEntries[index] = std::move(mEntries.back());
+        mIndex[mEntries[index].mElement] = index;
+    }
+    mEntries.pop_back();
+}
+
+
+void NuTo::ElementDofTable::Clear()
+{
+    mEntries.clear();
+    mIndex.clear();
+}
+
+
+void NuTo::ElementDofTable::CheckActiveDofTypes()
+{
+    if (mActiveDofTypes == mDofStatus.GetActiveDofTypes())
+        return;
+
+    Clear();
+    mActiveDofTypes = mDofStatus.GetActiveDofTypes();
+}
+
+
+void NuTo::ElementDofTable::Add(ElementBase& rElement)
+{
+    std::map<Element::eOutput, std::shared_ptr<ElementOutputBase>> elementOutputMap;
+    elementOutputMap[Element::eOutput::GLOBAL_ROW_DOF] = std::make_shared<ElementOutputBlockVectorInt>(mDofStatus);
+    elementOutputMap[Element::eOutput::GLOBAL_COLUMN_DOF] = std::make_shared<ElementOutputBlockVectorInt>(mDofStatus);
+
+    rElement.Evaluate(elementOutputMap);
+
+    mEntries.push_back({&rElement,
+                        std::move(elementOutputMap.at(Element::eOutput::GLOBAL_ROW_DOF)->GetBlockFullVectorInt()),
+                        std::move(elementOutputMap.at(Element::eOutput::GLOBAL_COLUMN_DOF)->GetBlockFullVectorInt())});
+    mIndex[&rElement] = mEntries.size() - 1;
+}
+
+
+int NuTo::ElementDofTable::GetIndex(const ElementBase& rElement) const
+{
+    auto itIndex = mIndex.find(&rElement);
+    if (itIndex == mIndex.end())
+        throw Exception(__PRETTY_FUNCTION__, "The dof numbers of the element are not in the table.");
+    return itIndex->second;
+}
@@ -0,0 +1,99 @@
+#pragma once
+
+#include <set>
+#include <unordered_map>
+#include <vector>
+
+#include "mechanics/dofSubMatrixStorage/BlockFullVector.h"
+#include "mechanics/nodes/NodeEnum.h"
+
+namespace NuTo
+{
+class DofStatus;
+class ElementBase;
+
+//! @brief cache of the global row and column dof numbers of the elements of a structure
+//! @remark The dof numbers of an element only change if the structure renumbers its dofs, the nodes of the element or
+//! its interpolation type are changed or a different set of dof types is activated. Instead of evaluating them for
+//! every element in every assembly, they are calculated once and stored contiguously. The structure clears the table
+//! in NodeBuildGlobalDofs and removes single entries if an element is deleted or modified.
+class ElementDofTable
+{
+public:
+    //! @brief ctor
+    //! @param rDofStatus ... dof status of the structure
+    ElementDofTable(const DofStatus& rDofStatus);
+
+    //! @brief calculates the dof numbers of all elements that are not in the table
+    //! @remark not thread safe, has to be called before the elements are evaluated in parallel
+    //! @param rElements ... all elements of the structure
+    void Update(const std::vector<ElementBase*>& rElements);
+
+    //! @brief calculates the dof numbers of rElement, if it is not in the table
+    //! @remark not thread safe
+    //! @param rElement ... element
+    void Update(ElementBase& rElement);
+
+    //! @brief returns the global row dof numbers of rElement
+    //! @remark thread safe, throws if rElement is not in the table
+    //! @param rElement ... element
+    const BlockFullVector<int>& GetRowDofs(const ElementBase& rElement) const
+    {
+        return mEntries[GetIndex(rElement)].mRowDofs;
+    }
+
+    //! @brief returns the global column dof numbers of rElement
+    //! @remark thread safe, throws if rElement is not in the table
+    //! @param rElement ... element
+    const BlockFullVector<int>& GetColumnDofs(const ElementBase& rElement) const
+    {
+        return mEntries[GetIndex(rElement)].mColumnDofs;
+    }
+
+    //! @brief returns true, if the dof numbers of rElement are in the table
+    bool Contains(const ElementBase& rElement) const
+    {
+        return mIndex.find(&rElement) != mIndex.end();
+    }
+
+    //! @brief removes the entry of rElement, e.g. before the element is deleted
+    void Remove(const ElementBase& rElement);
+
+    //! @brief removes all entries, e.g. after the dofs are renumbered
+    void Clear();
+
+    //! @brief returns the number of elements in the table
+    int GetNumElements() const
+    {
+        return mEntries.size();
+    }
+
+private:
+    struct Entry
+    {
+        const ElementBase* mElement;
+        BlockFullVector<int> mRowDofs;
+        BlockFullVector<int> mColumnDofs;
+    };
+
+    //! @brief clears the table, if the active dof types have changed since the entries were calculated
+    void CheckActiveDofTypes();
+
+    //! @brief calculates the dof numbers of rElement and appends them to the table
+    void Add(ElementBase& rElement);
+
+    int GetIndex(const ElementBase& rElement) const;
+
+    const DofStatus& mDofStatus;
+
+    //! @brief active dof types the entries were calculated for
+    std::set<Node::eDof> mActiveDofTypes;
+
+    //! @brief dof numbers of all elements, unordered
+    std::vector<Entry> mEntries;
+
+    //! @brief position of the entry of each element in mEntries
+    std::unordered_map<const ElementBase*, int> mIndex;
+};
+
+} // namespace NuTo
@@ -0,0 +1,245 @@
+#ifdef _OPENMP
+#include <omp.h>
+#endif
+
+#include "mechanics/structures/HessianOperator.h"
+
+#include <cassert>
+#include <map>
+#include <memory>
+#include <string>
+
+#include "base/Exception.h"
+#include "math/SparseMatrixCSRVector2.h"
+#include "mechanics/constitutive/ConstitutiveBase.h"
+#include "mechanics/constitutive/ConstitutiveEnum.h"
+#include "mechanics/constitutive/inputoutput/ConstitutiveCalculateStaticData.h"
+#include "mechanics/dofSubMatrixStorage/BlockFullMatrix.h"
+#include "mechanics/dofSubMatrixStorage/BlockSparseMatrix.h"
+#include "mechanics/dofSubMatrixStorage/DofStatus.h"
+#include "mechanics/elements/ElementBase.h"
+#include "mechanics/elements/ElementEnum.h"
+#include "mechanics/elements/ElementOutputBlockMatrixDouble.h"
+#include "mechanics/structures/Assembler.h"
+#include "mechanics/structures/ElementDofTable.h"
+#include "mechanics/structures/StructureBase.h"
+#include "mechanics/structures/StructureOutputBlockVector.h"
+
+
+//! @brief element outputs and temporary element vectors of one thread
+struct NuTo::HessianOperator::ElementWorkspace
+{
+    ElementWorkspace(const DofStatus& rDofStatus, double rFactor0, double rFactor1, double rFactor2)
+        : mValues(rDofStatus)
+        , mProduct(rDofStatus)
+    {
+        const std::pair<Element::eOutput, double> hessians[] = {{Element::eOutput::HESSIAN_0_TIME_DERIVATIVE, rFactor0},
+                                                                {Element::eOutput::HESSIAN_1_TIME_DERIVATIVE, rFactor1},
+                                                                {Element::eOutput::HESSIAN_2_TIME_DERIVATIVE, rFactor2}};
+        for (const auto& hessian : hessians)
+        {
+            if (hessian.second == 0.)
+                continue;
+            auto elementOutput = std::make_shared<ElementOutputBlockMatrixDouble>(rDofStatus);
+            mHessians.push_back({hessian.second, elementOutput.get()});
+            mElementOutput[hessian.first] = elementOutput;
+        }
+    }
+
+    std::map<Element::eOutput, std::shared_ptr<ElementOutputBase>> mElementOutput;
+
+    //! @brief factors and element hessians of mElementOutput
+    std::vector<std::pair<double, const BlockFullMatrix<double>*>> mHessians;
+
+    //! @brief dof values of the element
+    BlockFullVector<double> mValues;
+
+    //! @brief product of the element hessians and mValues
+    BlockFullVector<double> mProduct;
+};
+
+
+NuTo::HessianOperator::HessianOperator(StructureBase& rStructure, double rFactor0, double rFactor1, double rFactor2)
+    : mStructure(rStructure)
+    , mFactor0(rFactor0)
+    , mFactor1(rFactor1)
+    , mFactor2(rFactor2)
+    , mNumActiveDofs(0)
+{
+    if (rFactor0 == 0. and rFactor1 == 0. and rFactor2 == 0.)
+        throw Exception(__PRETTY_FUNCTION__, "At least one of the factors has to be nonzero.");
+
+    mStructure.NodeBuildGlobalDofs(__PRETTY_FUNCTION__);
+    mStructure.GetElementDofTable(); // dof numbers of all elements, only read in the multiplications
+    mStructure.GetElementsTotalInAssemblyOrder(mElements);
+
+    const DofStatus& dofStatus = mStructure.GetDofStatus();
+    for (auto dof : dofStatus.GetActiveDofTypes())
+        mNumActiveDofs += dofStatus.GetNumActiveDofs(dof);
+
+    mInput[Constitutive::eInput::CALCULATE_STATIC_DATA] =
+            std::make_unique<ConstitutiveCalculateStaticData>(eCalculateStaticData::EULER_BACKWARD);
+}
+
+
+NuTo::BlockFullVector<double> NuTo::HessianOperator::Apply(const BlockFullVector<double>& rActiveDofValues) const
+{
+    if (rActiveDofValues.GetNumActiveRows() != mNumActiveDofs)
+        throw Exception(__PRETTY_FUNCTION__, "The number of active dofs has changed. Recreate the operator.");
+
+    const DofStatus& dofStatus = mStructure.GetDofStatus();
+    const auto& activeDofTypes = dofStatus.GetActiveDofTypes();
+    const auto& numActiveDofsMap = dofStatus.GetNumActiveDofsMap();
+    const BlockSparseMatrix& constraintMatrix = mStructure.GetAssembler().GetConstraintMatrix();
+    const ElementDofTable& elementDofTable = mStructure.GetElementDofTable();
+
+    // x_K = -C x_J
+    StructureOutputBlockVector dofValues(dofStatus, true);
+    dofValues.J = rActiveDofValues;
+    for (auto dof : activeDofTypes)
+        dofValues.K[dof] = -constraintMatrix(dof, dof).operator*(rActiveDofValues[dof]);
+
+    StructureOutputBlockVector product(dofStatus, true);
+    product.SetZero();
+
+    ForEachElement([&](ElementBase& rElement, ElementWorkspace& rWorkspace) {
+        const auto& rowDofs = elementDofTable.GetRowDofs(rElement);
+        const auto& columnDofs = elementDofTable.GetColumnDofs(rElement);
+
+        for (auto dofCol : activeDofTypes)
+        {
+            const auto& globalColDofs = columnDofs[dofCol];
+            const int numActiveDofsCol = numActiveDofsMap.at(dofCol);
+            auto& values = rWorkspace.mValues[dofCol];
+            values.resize(globalColDofs.rows());
+            for (int iCol = 0; iCol < globalColDofs.rows(); ++iCol)
+            {
+                const int globalColDof = globalColDofs[iCol];
+                values[iCol] = globalColDof < numActiveDofsCol ? dofValues.J[dofCol][globalColDof]
+                                                               : dofValues.K[dofCol][globalColDof - numActiveDofsCol];
+            }
+        }
+
+        for (auto dofRow : activeDofTypes)
+            rWorkspace.mProduct[dofRow].setZero(rowDofs[dofRow].rows());
+
+        // elements that apply their hessian without calculating it, e.g. by sum factorization
+        const bool isMatrixFree =
+                mFactor1 == 0. and mFactor2 == 0. and
+                rElement.AddHessian0Product(mInput, rWorkspace.mValues, mFactor0, rWorkspace.mProduct);
+
+        if (not isMatrixFree)
+        {
+            rElement.Evaluate(mInput, rWorkspace.mElementOutput);
+            for (auto dofRow : activeDofTypes)
+            {
+                auto& elementProduct = rWorkspace.mProduct[dofRow];
+                for (auto dofCol : activeDofTypes)
+                {
+                    // the same combinations as in the assembly of the global hessian
+                    if (not rElement.GetConstitutiveLaw(0).CheckDofCombinationComputable(dofRow, dofCol, 0))
+                        continue;
+                    for (const auto& hessian : rWorkspace.mHessians)
+                    {
+                        const auto& elementMatrix = (*hessian.second)(dofRow, dofCol);
+                        assert(elementMatrix.rows() == elementProduct.rows());
+                        assert(elementMatrix.cols() == rWorkspace.mValues[dofCol].rows());
+                        elementProduct.noalias() += hessian.first * elementMatrix * rWorkspace.mValues[dofCol];
+                    }
+                }
+            }
+        }
+
+        for (auto dofRow : activeDofTypes)
+        {
+            const auto& globalRowDofs = rowDofs[dofRow];
+            const auto& elementProduct = rWorkspace.mProduct[dofRow];
+            const int numActiveDofsRow = numActiveDofsMap.at(dofRow);
+            for (int iRow = 0; iRow < globalRowDofs.rows(); ++iRow)
+            {
+                const int globalRowDof = globalRowDofs[iRow];
+                if (globalRowDof < numActiveDofsRow)
+                    product.J[dofRow][globalRowDof] += elementProduct[iRow];
+                else
+                    product.K[dofRow][globalRowDof - numActiveDofsRow] += elementProduct[iRow];
+            }
+        }
+    });
+
+    return Assembler::ApplyCMatrix(product, constraintMatrix);
+}
+
+
+Eigen::VectorXd NuTo::HessianOperator::Apply(const Eigen::VectorXd& rActiveDofValues) const
+{
+    if (rActiveDofValues.rows() != mNumActiveDofs)
+        throw Exception(__PRETTY_FUNCTION__, "The size of the vector does not match the number of active dofs.");
+
+    return Apply(BlockFullVector<double>(rActiveDofValues, mStructure.GetDofStatus())).Export();
+}
+
+
+Eigen::VectorXd NuTo::HessianOperator::GetDiagonal() const
+{
+    const DofStatus& dofStatus = mStructure.GetDofStatus();
+    const auto& activeDofTypes = dofStatus.GetActiveDofTypes();
+    const auto& numActiveDofsMap = dofStatus.GetNumActiveDofsMap();
+    const ElementDofTable& elementDofTable = mStructure.GetElementDofTable();
+
+    BlockFullVector<double> diagonal(dofStatus);
+    for (auto dof : activeDofTypes)
+        diagonal[dof].setZero(numActiveDofsMap.at(dof));
+
+    ForEachElement([&](ElementBase& rElement, ElementWorkspace& rWorkspace) {
+        rElement.Evaluate(mInput, rWorkspace.mElementOutput);
+        const auto& rowDofs = elementDofTable.GetRowDofs(rElement);
+        for (auto dof : activeDofTypes)
+        {
+            if (not rElement.GetConstitutiveLaw(0).CheckDofCombinationComputable(dof, dof, 0))
+                continue;
+
+            const auto& globalDofs = rowDofs[dof];
+            const int numActiveDofs = numActiveDofsMap.at(dof);
+            for (const auto& hessian : rWorkspace.mHessians)
+            {
+                const auto& elementMatrix = (*hessian.second)(dof, dof);
+                for (int i = 0; i < globalDofs.rows(); ++i)
+                    if (globalDofs[i] < numActiveDofs)
+                        diagonal[dof][globalDofs[i]] += hessian.first * elementMatrix(i, i);
+            }
+        }
+    });
+
+    return diagonal.Export();
+}
+
+
+void NuTo::HessianOperator::ForEachElement(
+        const std::function<void(ElementBase&, ElementWorkspace&)>& rFunction) const
+{
+    const DofStatus& dofStatus = mStructure.GetDofStatus();
+
+#ifdef _OPENMP
+    // elements of an independent set share no nodes, their products are added to different global dofs
+    mStructure.ForEachIndependentSetChunk([&]() {
+        auto workspace = std::make_shared<ElementWorkspace>(dofStatus, mFactor0, mFactor1, mFactor2);
+        return [&rFunction, workspace](ElementBase* const* rElements, int rNumElements) {
+            for (int i = 0; i < rNumElements; ++i)
+                rFunction(*rElements[i], *workspace);
+        };
+    });
+#else
+    ElementWorkspace workspace(dofStatus, mFactor0, mFactor1, mFactor2);
+    for (ElementBase* elementPtr : mElements)
+        rFunction(*elementPtr, workspace);
+#endif
+}
+
+
+NuTo::HessianOperatorJacobi& NuTo::HessianOperatorJacobi::compute(const HessianOperator& rOperator)
+{
+    mInverseDiagonal = rOperator.GetDiagonal();
+    for (int i = 0; i < mInverseDiagonal.rows(); ++i)
+        mInverseDiagonal[i] = mInverseDiagonal[i] != 0. ? 1. / mInverseDiagonal[i] : 1.;
+    return *this;
+}
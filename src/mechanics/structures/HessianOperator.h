@@ -0,0 +1,187 @@
+#pragma once
+
+#include <functional>
+#include <vector>
+
+#include <Eigen/Core>
+#include <Eigen/SparseCore>
+
+#include "mechanics/constitutive/inputoutput/ConstitutiveIOMap.h"
+#include "mechanics/dofSubMatrixStorage/BlockFullVector.h"
+
+namespace NuTo
+{
+class ElementBase;
+class HessianOperator;
+class StructureBase;
+} // namespace NuTo
+
+namespace Eigen
+{
+namespace internal
+{
+//! @brief the operator behaves like a sparse matrix in Eigen expressions
+template <>
+struct traits<NuTo::HessianOperator> : public traits<Eigen::SparseMatrix<double>>
+{
+};
+} // namespace internal
+} // namespace Eigen
+
+namespace NuTo
+{
+
+//! @brief matrix-free operator of the hessian of a structure
+//! @remark Applies rFactor0 * HESSIAN0 + rFactor1 * HESSIAN1 + rFactor2 * HESSIAN2 to the active dof values without
+//! assembling the global hessian. The element hessians are evaluated and multiplied with the element dof values element
+//! by element. The dependent dof values follow from the homogeneous constraints (x_K = -C x_J) and the result is reduced
+//! like in Assembler::ApplyCMatrix. So the operator equals the assembled hessian after
+//! StructureOutputBlockMatrix::ApplyCMatrix, only the storage of the element matrices of one element per thread is
+//! required.
+//!
+//! The operator can be used as matrix in NuTo::Gmres and in the iterative solvers of Eigen, e.g.
+//! Eigen::ConjugateGradient<HessianOperator, Eigen::Lower | Eigen::Upper, HessianOperatorJacobi>.
+//!
+//! The elements and the dof numbering are fixed in the constructor, the operator has to be recreated if they change.
+//! The element hessians are evaluated in every multiplication for the current dof values and static data of the
+//! structure. If only rFactor0 is nonzero, elements that support ElementBase::AddHessian0Product (e.g. high order
+//! tensor product elements via sum factorization) apply their hessian without calculating it.
+class HessianOperator : public Eigen::EigenBase<HessianOperator>
+{
+public:
+    typedef double Scalar;
+    typedef double RealScalar;
+    typedef int StorageIndex;
+    enum
+    {
+        ColsAtCompileTime = Eigen::Dynamic,
+        MaxColsAtCompileTime = Eigen::Dynamic,
+        IsRowMajor = false
+    };
+
+    //! @brief ctor, numbers the dofs of the structure, if required
+    //! @param rStructure ... structure
+    //! @param rFactor0 ... factor of HESSIAN0
+    //! @param rFactor1 ... factor of HESSIAN1
+    //! @param rFactor2 ... factor of HESSIAN2
+    HessianOperator(StructureBase& rStructure, double rFactor0 = 1., double rFactor1 = 0., double rFactor2 = 0.);
+
+    //! @brief applies the operator to the active dof values
+    //! @param rActiveDofValues ... active dof values
+    //! @return active dof values of the product
+    BlockFullVector<double> Apply(const BlockFullVector<double>& rActiveDofValues) const;
+
+    //! @brief applies the operator to the active dof values
+    //! @param rActiveDofValues ... active dof values, ordered like BlockFullVector::Export
+    //! @return active dof values of the product, ordered like BlockFullVector::Export
+    Eigen::VectorXd Apply(const Eigen::VectorXd& rActiveDofValues) const;
+
+    //! @brief returns the diagonal of the active part of the hessian (JJ)
+    //! @remark the contributions of the constraints to the diagonal are not included
+    Eigen::VectorXd GetDiagonal() const;
+
+    //! @brief number of active dofs
+    Eigen::Index rows() const
+    {
+        return mNumActiveDofs;
+    }
+
+    //! @brief number of active dofs
+    Eigen::Index cols() const
+    {
+        return mNumActiveDofs;
+    }
+
+    //! @brief product expression for Eigen, evaluated via Apply
+    template <typename TRhs>
+    Eigen::Product<HessianOperator, TRhs, Eigen::AliasFreeProduct> operator*(const Eigen::MatrixBase<TRhs>& rRhs) const
+    {
+        return Eigen::Product<HessianOperator, TRhs, Eigen::AliasFreeProduct>(*this, rRhs.derived());
+    }
+
+private:
+    struct ElementWorkspace;
+
+    //! @brief calls rFunction for each element with the workspace of the current thread
+    //! @remark elements of the same independent set are processed in parallel, so rFunction may add values of the
+    //! element dofs to global vectors without synchronization
+    void ForEachElement(const std::function<void(ElementBase&, ElementWorkspace&)>& rFunction) const;
+
+    StructureBase& mStructure;
+
+    double mFactor0;
+    double mFactor1;
+    double mFactor2;
+
+    int mNumActiveDofs;
+
+    //! @brief all elements of the structure
+    std::vector<ElementBase*> mElements;
+
+    //! @brief constitutive input of the element evaluations, like in the assembly of the global hessians
+    ConstitutiveInputMap mInput;
+};
+
+//! @brief jacobi preconditioner for the HessianOperator, uses HessianOperator::GetDiagonal
+//! @remark provides the interface of the preconditioners of Eigen and can be used in NuTo::Gmres
+class HessianOperatorJacobi
+{
+public:
+    //! @brief default ctor, required by the Eigen solvers
+    HessianOperatorJacobi() = default;
+
+    //! @brief ctor, calculates the inverse diagonal
+    HessianOperatorJacobi(const HessianOperator& rOperator)
+    {
+        compute(rOperator);
+    }
+
+    HessianOperatorJacobi& analyzePattern(const HessianOperator&)
+    {
+        return *this;
+    }
+
+    HessianOperatorJacobi& factorize(const HessianOperator& rOperator)
+    {
+        return compute(rOperator);
+    }
+
+    //! @brief calculates the inverse diagonal, zero diagonal entries are not scaled
+    HessianOperatorJacobi& compute(const HessianOperator& rOperator);
+
+    //! @brief applies the inverse diagonal
+    template <typename TRhs>
+    Eigen::VectorXd solve(const Eigen::MatrixBase<TRhs>& rRhs) const
+    {
+        return mInverseDiagonal.cwiseProduct(rRhs);
+    }
+
+    Eigen::ComputationInfo info() const
+    {
+        return Eigen::Success;
+    }
+
+private:
+    Eigen::VectorXd mInverseDiagonal;
+};
+
+} // namespace NuTo
+
+namespace Eigen
+{
+namespace internal
+{
+//! @brief evaluation of HessianOperator * vector in Eigen expressions
+template <typename TRhs>
+struct generic_product_impl<NuTo::HessianOperator, TRhs, SparseShape, DenseShape, GemvProduct>
+    : generic_product_impl_base<NuTo::HessianOperator, TRhs,
+                                generic_product_impl<NuTo::HessianOperator, TRhs, SparseShape, DenseShape, GemvProduct>>
+{
+    template <typename TDest>
+    static void scaleAndAddTo(TDest& rDest, const NuTo::HessianOperator& rLhs, const TRhs& rRhs, const double& rAlpha)
+    {
+        rDest.noalias() += rAlpha * rLhs.Apply(Eigen::VectorXd(rRhs));
+    }
+};
+} // namespace internal
+} // namespace Eigen
@@ -0,0 +1,66 @@
+#include "mechanics/structures/IncrementalHessian.h"
+
+#include "base/Exception.h"
+#include "mechanics/dofSubMatrixStorage/BlockFullMatrix.h"
+#include "mechanics/elements/ElementBase.h"
+#include "mechanics/structures/AssemblyPattern.h"
+
+
+NuTo::IncrementalHessian::IncrementalHessian(const AssemblyPattern& rAssemblyPattern, const DofStatus& rDofStatus,
+                                             const std::vector<ElementBase*>& rElements,
+                                             unsigned long rGeometryGeneration,
+                                             unsigned long rConfigurationGeneration)
+    : mAssemblyPattern(rAssemblyPattern)
+    , mGeometryGeneration(rGeometryGeneration)
+    , mConfigurationGeneration(rConfigurationGeneration)
+    , mHessian(rDofStatus, true)
+{
+    mAssemblyPattern.InitializeMatrix(mHessian);
+    mElementHessians.reserve(rElements.size());
+    for (const ElementBase* element : rElements)
+        mElementHessians[element];
+}
+
+
+NuTo::IncrementalHessian::~IncrementalHessian() = default;
+
+
+bool NuTo::IncrementalHessian::IsValid(unsigned long rGeometryGeneration,
+                                       unsigned long rConfigurationGeneration) const
+{
+    return mGeometryGeneration == rGeometryGeneration and mConfigurationGeneration == rConfigurationGeneration;
+}
+
+
+bool NuTo::IncrementalHessian::HasElementHessian(const ElementBase& rElement) const
+{
+    auto itElement = mElementHessians.find(&rElement);
+    return itElement != mElementHessians.end() and itElement->second != nullptr;
+}
+
+
+void NuTo::IncrementalHessian::UpdateElementHessian(const ElementBase& rElement,
+                                                    const BlockFullMatrix<double>& rElementHessian)
+{
+    // the elements are inserted in the ctor, the concurrent read access of the map is thread safe
+    auto itElement = mElementHessians.find(&rElement);
+    if (itElement == mElementHessians.end())
+        throw Exception(__PRETTY_FUNCTION__, "The element is not part of the incremental hessian.");
+
+    std::unique_ptr<BlockFullMatrix<double>>& storedHessian = itElement->second;
+    if (storedHessian == nullptr)
+    {
+        mAssemblyPattern.AddElementMatrix(&rElement, rElementHessian, mHessian);
+        storedHessian = std::make_unique<BlockFullMatrix<double>>(rElementHessian);
+        return;
+    }
+
+    mAssemblyPattern.AddElementMatrix(&rElement, rElementHessian - *storedHessian, mHessian);
+    *storedHessian = rElementHessian;
+}
+
+
+void NuTo::IncrementalHessian::AddTo(StructureOutputBlockMatrix& rMatrix) const
+{
+    mAssemblyPattern.AddMatrix(rMatrix, mHessian);
+}
@@ -0,0 +1,68 @@
+#pragma once
+
+#include <memory>
+#include <unordered_map>
+#include <vector>
+
+#include "mechanics/structures/StructureOutputBlockMatrix.h"
+
+namespace NuTo
+{
+class AssemblyPattern;
+class DofStatus;
+class ElementBase;
+template <typename T>
+class BlockFullMatrix;
+
+//! @brief global HESSIAN0 that is updated by the changes of the element hessians
+//! @remark Between the iterations of a nonlinear solver, the tangents of most integration points often do not change,
+//! e.g. outside the process zone of a damage model. The element hessians of the previous assembly are stored. Only the
+//! elements whose tangents changed (see ElementBase::UpdateTangentStates) are evaluated again, the difference to their
+//! stored hessian is added to the global hessian. The global hessian has the sparsity pattern of an AssemblyPattern and
+//! has to be rebuilt together with it.
+class IncrementalHessian
+{
+public:
+    //! @brief ctor, the hessian is zero and no element hessians are stored
+    //! @param rAssemblyPattern ... assembly pattern of the structure, has to outlive this object
+    //! @param rDofStatus ... dof status of the structure
+    //! @param rElements ... all elements of the assembly pattern
+    //! @param rGeometryGeneration ... geometry generation of the structure, see StructureGeneration
+    //! @param rConfigurationGeneration ... configuration generation of the structure, see StructureGeneration
+    IncrementalHessian(const AssemblyPattern& rAssemblyPattern, const DofStatus& rDofStatus,
+                       const std::vector<ElementBase*>& rElements, unsigned long rGeometryGeneration,
+                       unsigned long rConfigurationGeneration);
+
+    ~IncrementalHessian();
+
+    //! @brief returns true, if neither the node coordinates nor the configuration of the structure changed since the
+    //! construction, see StructureGeneration
+    bool IsValid(unsigned long rGeometryGeneration, unsigned long rConfigurationGeneration) const;
+
+    //! @brief returns true, if the hessian of rElement is stored
+    bool HasElementHessian(const ElementBase& rElement) const;
+
+    //! @brief replaces the stored hessian of rElement and adds the difference to the global hessian
+    //! @remark thread safe for elements without common dofs
+    //! @param rElement ... element of the assembly pattern
+    //! @param rElementHessian ... HESSIAN_0_TIME_DERIVATIVE of the element
+    void UpdateElementHessian(const ElementBase& rElement, const BlockFullMatrix<double>& rElementHessian);
+
+    //! @brief adds the global hessian to rMatrix
+    //! @param rMatrix ... matrix, initialized via AssemblyPattern::InitializeMatrix
+    void AddTo(StructureOutputBlockMatrix& rMatrix) const;
+
+private:
+    const AssemblyPattern& mAssemblyPattern;
+
+    unsigned long mGeometryGeneration;
+    unsigned long mConfigurationGeneration;
+
+    //! @brief sum of the stored element hessians
+    StructureOutputBlockMatrix mHessian;
+
+    //! @brief element hessians of the last update, all elements are inserted in the ctor
+    std::unordered_map<const ElementBase*, std::unique_ptr<BlockFullMatrix<double>>> mElementHessians;
+};
+
+} // namespace NuTo
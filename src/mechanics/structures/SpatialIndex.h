@@ -0,0 +1,77 @@
+#pragma once
+
+#include <utility>
+#include <vector>
+#include <Eigen/Core>
+
+#include "math/SpatialGrid.h"
+
+namespace NuTo
+{
+
+//! @brief nodes or elements of a structure with a SpatialGrid over their coordinates or bounding boxes
+//! @remark The index stores the generations (see StructureGeneration) and the revision of the nodes and elements of
+//! the structure it was built for. It has to be rebuilt when one of them changes, e.g. when
+//! nodes are added, removed or moved.
+template <typename T>
+class SpatialIndex
+{
+public:
+    //! @param rObjects ... ids and pointers of the objects
+    //! @param rBoxMin ... lower corners of the bounding boxes, one column per object
+    //! @param rBoxMax ... upper corners of the bounding boxes, one column per object
+    //! @param rRevision ... revision of the nodes and elements of the structure
+    //! @param rGeometryGeneration ... geometry generation of the structure, changes with the node coordinates
+    //! @param rConfigurationGeneration ... configuration generation of the structure, changes e.g. if nodes are
+    //! exchanged
+    SpatialIndex(std::vector<std::pair<int, T*>> rObjects, const Eigen::MatrixXd& rBoxMin,
+                 const Eigen::MatrixXd& rBoxMax, unsigned long rRevision, unsigned long rGeometryGeneration,
+                 unsigned long rConfigurationGeneration)
+        : mObjects(std::move(rObjects))
+        , mGrid(rBoxMin, rBoxMax)
+        , mRevision(rRevision)
+        , mGeometryGeneration(rGeometryGeneration)
+        , mConfigurationGeneration(rConfigurationGeneration)
+    {
+    }
+
+    //! @brief returns true, if neither the revision nor the generations changed since the construction
+    bool IsValid(unsigned long rRevision, unsigned long rGeometryGeneration,
+                 unsigned long rConfigurationGeneration) const
+    {
+        return mRevision == rRevision and mGeometryGeneration == rGeometryGeneration and
+               mConfigurationGeneration == rConfigurationGeneration;
+    }
+
+    //! @brief returns the objects whose bounding boxes intersect the box [rMin, rMax], see SpatialGrid::FindInBox
+    std::vector<std::pair<int, T*>> FindInBox(const Eigen::VectorXd& rMin, const Eigen::VectorXd& rMax) const
+    {
+        std::vector<std::pair<int, T*>> objects;
+        for (int index : mGrid.FindInBox(rMin, rMax))
+            objects.push_back(mObjects[index]);
+        return objects;
+    }
+
+    //! @brief returns the object with the smallest distance to rPoint, {-1, nullptr} if the index is empty
+    std::pair<int, T*> FindNearest(const Eigen::VectorXd& rPoint) const
+    {
+        const int index = mGrid.FindNearest(rPoint);
+        if (index == -1)
+            return {-1, nullptr};
+        return mObjects[index];
+    }
+
+    const SpatialGrid& GetGrid() const
+    {
+        return mGrid;
+    }
+
+private:
+    std::vector<std::pair<int, T*>> mObjects;
+    SpatialGrid mGrid;
+    unsigned long mRevision;
+    unsigned long mGeometryGeneration;
+    unsigned long mConfigurationGeneration;
+};
+
+} // namespace NuTo
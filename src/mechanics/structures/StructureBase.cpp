@@ -2,11 +2,13 @@
 #include <omp.h>
 #endif
 
+#include <algorithm>
 #include <iostream>
 #include <string>
 #include "math/EigenSolverArpack.h"
 #include "math/SparseMatrixCSR.h"
 #include "math/SparseMatrixCSRVector2.h"
+#include "math/GraphColoring.h"
 
 #include "mechanics/structures/StructureBase.h"
 #include "base/Timer.h"
@@ -35,6 +37,10 @@
 #include "mechanics/constitutive/inputoutput/ConstitutiveCalculateStaticData.h"
 #include "mechanics/constitutive/inputoutput/ConstitutiveIOMap.h"
 #include "mechanics/structures/Assembler.h"
+#include "mechanics/structures/AssemblyPattern.h"
+#include "mechanics/structures/ElementDofTable.h"
+#include "mechanics/structures/IncrementalHessian.h"
+#include "mechanics/structures/SpatialIndex.h"
 #include "mechanics/constraints/ConstraintCompanion.h"
 
 #include "visualize/UnstructuredGrid.h"
@@ -58,10 +64,17 @@ NuTo::StructureBase::StructureBase(int rDimension)
     mHaveTmpStaticData = false;
     mUpdateTmpStaticDataRequired = true;
     mToleranceStiffnessEntries = 0.;
+    mUseAssemblyPattern = false;
+    mUseElementBatches = false;
+    mUseGeometryCache = false;
+    mUseIncrementalHessian0 = false;
+    mDofOrdering = eDofOrdering::NODE_ID;
+    mElementDofTable = std::make_unique<ElementDofTable>(GetDofStatus());
 
 #ifdef _OPENMP
     // then the environment variable is used
     mNumProcessors = 1;
+    mParallelAssembly = eParallelAssembly::COLORING;
 #endif // _OPENMP
 }
 
@@ -564,7 +577,16 @@ void NuTo::StructureBase::ConstraintLinearEquationNodeToElementCreate(int rNode,
     queryNodeCoords = queryNodeCoords + rNodeCoordOffset.head(dim);
 
 
-    std::vector<int> elementGroupIds = GroupGetMemberIds(rElementGroup);
+    // elements of the group whose bounding box is close to the node, in the order of their ids
+    // (a point with natural coordinates > -rTolerance is closer than dim * rTolerance * diameter to the element)
+    const SpatialIndex<ElementBase>& elementIndex = ElementGetSpatialIndex();
+    const double margin = 2. * dim * rTolerance * elementIndex.GetGrid().GetMaxBoxExtent();
+    const Group<ElementBase>* elementGroup = GroupGetGroupPtr(rElementGroup)->AsGroupElement();
+    std::vector<int> elementGroupIds;
+    for (auto& element : elementIndex.FindInBox(queryNodeCoords.array() - margin, queryNodeCoords.array() + margin))
+        if (elementGroup->Contain(element.first))
+            elementGroupIds.push_back(element.first);
+    std::sort(elementGroupIds.begin(), elementGroupIds.end());
 
     ElementBase* elementPtr = nullptr;
     Eigen::VectorXd elementNaturalNodeCoords;
@@ -659,7 +681,7 @@ NuTo::BlockFullVector<double> NuTo::StructureBase::SolveBlockSystem(const BlockS
                                                                     const BlockFullVector<double>& rVector) const
 {
     Eigen::VectorXd resultForSolver;
-    std::unique_ptr<NuTo::SparseMatrixCSR<double>> matrixForSolver = rMatrix.ExportToCSR();
+    const NuTo::SparseMatrixCSR<double>& matrixForSolver = rMatrix.GetCompressed(true);
 
     //    try
     //    {
@@ -674,8 +696,6 @@ NuTo::BlockFullVector<double> NuTo::StructureBase::SolveBlockSystem(const BlockS
     //        std::cout << "Error calculating EVs" << std::endl;
     //    }
 
-    matrixForSolver->SetOneBasedIndexing();
-
 // allocate solver
 #if defined(HAVE_PARDISO) && defined(_OPENMP)
     NuTo::SparseDirectSolverPardiso mySolver(GetNumProcessors(), GetVerboseLevel()); // note: not the MKL version
@@ -686,7 +706,7 @@ NuTo::BlockFullVector<double> NuTo::StructureBase::SolveBlockSystem(const BlockS
     mySolver.SetShowTime(GetShowTime());
 
 
-    mySolver.Solve(*matrixForSolver, rVector.Export(), resultForSolver);
+    mySolver.Solve(matrixForSolver, rVector.Export(), resultForSolver);
 
     return BlockFullVector<double>(-resultForSolver, GetDofStatus());
 }
@@ -720,6 +740,82 @@ double NuTo::StructureBase::GetToleranceStiffnessEntries() const
     return mToleranceStiffnessEntries;
 }
 
+void NuTo::StructureBase::SetUseAssemblyPattern(bool rUseAssemblyPattern)
+{
+    mUseAssemblyPattern = rUseAssemblyPattern;
+    ClearAssemblyPattern();
+}
+
+bool NuTo::StructureBase::GetUseAssemblyPattern() const
+{
+    return mUseAssemblyPattern;
+}
+
+void NuTo::StructureBase::SetUseElementBatches(bool rUseElementBatches)
+{
+    mUseElementBatches = rUseElementBatches;
+}
+
+bool NuTo::StructureBase::GetUseElementBatches() const
+{
+    return mUseElementBatches;
+}
+
+void NuTo::StructureBase::SetUseGeometryCache(bool rUseGeometryCache)
+{
+    mUseGeometryCache = rUseGeometryCache;
+    std::vector<ElementBase*> elements;
+    GetElementsTotal(elements);
+    for (ElementBase* element : elements)
+        element->SetUseGeometryCache(mUseGeometryCache);
+}
+
+bool NuTo::StructureBase::GetUseGeometryCache() const
+{
+    return mUseGeometryCache;
+}
+
+void NuTo::StructureBase::SetDofOrdering(eDofOrdering rDofOrdering)
+{
+    if (mDofOrdering == rDofOrdering)
+        return;
+    mDofOrdering = rDofOrdering;
+    GetAssembler().SetNodeVectorChanged();
+}
+
+NuTo::eDofOrdering NuTo::StructureBase::GetDofOrdering() const
+{
+    return mDofOrdering;
+}
+
+void NuTo::StructureBase::SetUseIncrementalHessian0(bool rUseIncrementalHessian0)
+{
+    mUseIncrementalHessian0 = rUseIncrementalHessian0;
+    mIncrementalHessian0.reset();
+}
+
+bool NuTo::StructureBase::GetUseIncrementalHessian0() const
+{
+    return mUseIncrementalHessian0;
+}
+
+void NuTo::StructureBase::ClearAssemblyPattern()
+{
+    mIncrementalHessian0.reset();
+    mAssemblyPattern.reset();
+#ifdef _OPENMP
+    mThreadLocalOutputs.clear();
+#endif
+}
+
+const NuTo::ElementDofTable& NuTo::StructureBase::GetElementDofTable()
+{
+    std::vector<ElementBase*> elements;
+    GetElementsTotal(elements);
+    mElementDofTable->Update(elements);
+    return *mElementDofTable;
+}
+
 std::set<NuTo::Node::eDof> NuTo::StructureBase::DofTypesGet() const
 {
     return GetDofStatus().GetDofTypes();
@@ -909,18 +1005,15 @@ double NuTo::StructureBase::ReadRestartFile(std::string filename)
 //@brief determines the maximum independent sets and stores it at the structure
 void NuTo::StructureBase::CalculateMaximumIndependentSets()
 {
-#define UNDONE 1
-#define SELECTED 2
-#define DELETED 3
     NuTo::Timer timer(__PRETTY_FUNCTION__, GetShowTime(), GetLogger());
 
     mMIS.clear();
     std::vector<ElementBase*> elementVector;
-    GetElementsTotal(elementVector);
+    GetElementsTotalInAssemblyOrder(elementVector);
 
     // Build the connectivity graph
     // First get for all nodes all the elements
-    std::map<const NodeBase*, std::vector<unsigned int>> elementsPerNode;
+    std::map<const NodeBase*, std::vector<int>> elementsPerNode;
     for (unsigned int elementCount = 0; elementCount < elementVector.size(); elementCount++)
     {
         for (int nodeCount = 0; nodeCount < elementVector[elementCount]->GetNumInfluenceNodes(); nodeCount++)
@@ -930,57 +1023,102 @@ void NuTo::StructureBase::CalculateMaximumIndependentSets()
     }
 
     // Get the neighboring elements (always referring to the location in the vector elementVector)
-    std::vector<std::vector<int>> NeighborElements(elementVector.size());
+    std::vector<std::vector<int>> neighborElements(elementVector.size());
     for (auto& node : elementsPerNode)
     {
         for (unsigned int elementCount1 = 0; elementCount1 < node.second.size(); elementCount1++)
         {
             for (unsigned int elementCount2 = elementCount1 + 1; elementCount2 < node.second.size(); elementCount2++)
             {
-                NeighborElements[node.second[elementCount1]].push_back(node.second[elementCount2]);
-                NeighborElements[node.second[elementCount2]].push_back(node.second[elementCount1]);
+                neighborElements[node.second[elementCount1]].push_back(node.second[elementCount2]);
+                neighborElements[node.second[elementCount2]].push_back(node.second[elementCount1]);
             }
         }
     }
+    // elements sharing more than one node appear multiple times
+    for (auto& neighbors : neighborElements)
+    {
+        std::sort(neighbors.begin(), neighbors.end());
+        neighbors.erase(std::unique(neighbors.begin(), neighbors.end()), neighbors.end());
+    }
 
-    // build the maximum independent sets
-    std::vector<int> elementState(elementVector.size());
-    for (int& entry : elementState)
-        entry = UNDONE;
+    // color the graph with as few colors as possible and balance the size of the colors afterwards. Each color is an
+    // independent set. Equally sized sets keep all threads busy until the end of each set.
+    std::vector<int> colors = GraphColoring::DSatur(neighborElements);
+    GraphColoring::Balance(neighborElements, colors);
 
-    unsigned int numDeleted = 0;
-    unsigned int curMIS = 0;
-    mMIS.resize(10);
-    while (numDeleted < elementVector.size())
+    // the elements of each set remain in the order of elementVector which keeps the element chunks processed by a
+    // single thread local in memory
+    for (unsigned int elementCount = 0; elementCount < elementVector.size(); elementCount++)
     {
-        if (mMIS.size() <= curMIS)
-            mMIS.resize(curMIS + 1);
-        for (unsigned int countElement = 0; countElement < elementVector.size(); countElement++)
-        {
-            if (elementState[countElement] != UNDONE)
-                continue;
+        unsigned int color = colors[elementCount];
+        if (mMIS.size() <= color)
+            mMIS.resize(color + 1);
+        mMIS[color].push_back(elementVector[elementCount]);
+    }
+}
 
-            // add element to the set
-            (mMIS[curMIS]).push_back(elementVector[countElement]);
-            elementState[countElement] = DELETED;
-            numDeleted++;
+void NuTo::StructureBase::ForEachIndependentSetChunk(
+        const std::function<std::function<void(ElementBase* const*, int)>()>& rCreateChunkFunction,
+        int rChunkGranularity)
+{
+    if (mNumProcessors != 0)
+    {
+        omp_set_num_threads(mNumProcessors);
+    }
+    if (mMIS.size() == 0)
+    {
+        CalculateMaximumIndependentSets();
+    }
 
-            // mark all the neighboring elements as selected, which prevents them to being added to this set
-            for (int theNeighborCount : NeighborElements[countElement])
-            {
-                if (elementState[theNeighborCount] == UNDONE)
-                    elementState[theNeighborCount] = SELECTED;
-            }
+    std::string exceptionMessage = "";
+#pragma omp parallel shared(exceptionMessage)
+    {
+        // in OpenMP, exceptions may not leave the parallel region. A thread without a function still takes part in the
+        // barriers of the sets.
+        std::function<void(ElementBase* const*, int)> processChunk;
+        try
+        {
+            processChunk = rCreateChunkFunction();
         }
-        // reset the selected elements to be undone
-        for (unsigned int countElement = 0; countElement < elementVector.size(); countElement++)
+        catch (std::exception& e)
         {
-            if (elementState[countElement] == SELECTED)
-                elementState[countElement] = UNDONE;
+#pragma omp critical(StructureIndependentSetException)
+            exceptionMessage = e.what();
         }
-        curMIS++;
-    }
-    mMIS.resize(curMIS);
+
+        const int numThreads = omp_get_num_threads();
+        for (const auto& independentSet : mMIS)
+        {
+            // aim for several chunks per thread for load balancing, but limit the chunk size such that the element
+            // data of a chunk stays in the cache
+            constexpr int maxChunkSize = 64;
+            const int numElements = independentSet.size();
+            const int chunkSize = rChunkGranularity *
+                                  std::max(1, std::min(maxChunkSize, numElements / (4 * numThreads)) / rChunkGranularity);
+            const int numChunks = (numElements + chunkSize - 1) / chunkSize;
+
+#pragma omp for schedule(dynamic, 1)
+            for (int chunk = 0; chunk < numChunks; ++chunk)
+            {
+                const int chunkBegin = chunk * chunkSize;
+                const int chunkEnd = std::min(numElements, chunkBegin + chunkSize);
+                try
+                {
+                    if (processChunk)
+                        processChunk(independentSet.data() + chunkBegin, chunkEnd - chunkBegin);
+                }
+                catch (std::exception& e)
+                {
+#pragma omp critical(StructureIndependentSetException)
+                    exceptionMessage = e.what();
+                }
+            } // end loop over chunks, implicit barrier
+        } // end loop over independent sets
+    } // end parallel region
+
+    if (exceptionMessage != "")
+        throw Exception(exceptionMessage);
 }
 #else
 //@brief determines the maximum independent sets and stores it at the structure, do nothing for applications without
@@ -990,6 +1128,13 @@ void NuTo::StructureBase::CalculateMaximumIndependentSets()
 }
 #endif
 
+void NuTo::StructureBase::ClearMaximumIndependentSets()
+{
+#ifdef _OPENMP
+    mMIS.clear();
+#endif // _OPENMP
+}
+
 //@brief set the number of processors for openmp parallelization
 void NuTo::StructureBase::SetNumProcessors(int rNumProcessors)
 {
@@ -1006,6 +1151,24 @@ int NuTo::StructureBase::GetNumProcessors() const
     return 1;
 }
 
+void NuTo::StructureBase::SetParallelAssembly(eParallelAssembly rParallelAssembly)
+{
+#ifdef _OPENMP
+    mParallelAssembly = rParallelAssembly;
+    if (mParallelAssembly != eParallelAssembly::THREAD_LOCAL)
+        mThreadLocalOutputs.clear();
+#endif //_OPENMP
+}
+
+NuTo::eParallelAssembly NuTo::StructureBase::GetParallelAssembly() const
+{
+#ifdef _OPENMP
+    return mParallelAssembly;
+#else
+    return eParallelAssembly::COLORING;
+#endif //_OPENMP
+}
+
 void NuTo::StructureBase::SetOMPNested(bool rNested)
 {
 #ifdef _OPENMP
@@ -14,11 +14,15 @@
 #include "mechanics/groups/GroupEnum.h"
 #include "base/Exception.h"
 #include "StructureOutputBlockVector.h"
+#include "mechanics/structures/StructureGeneration.h"
 
 
 namespace NuTo
 {
 class Assembler;
+class AssemblyPattern;
+class ElementDofTable;
+class IncrementalHessian;
 class ConstitutiveBase;
 class ElementBase;
 class GroupBase;
@@ -32,6 +36,7 @@ class SerializeStreamIn;
 class StructureOutputBase;
 class StructureOutputBlockMatrix;
 class TimeIntegrationBase;
+struct NearNullSpace;
 template <typename IOEnum>
 class ConstitutiveIOMap;
 template <class T>
@@ -40,11 +45,15 @@ template <class T>
 class BlockFullVector;
 template <class T>
 class Group;
+template <typename T>
+class SpatialIndex;
 
 enum class eError;
 enum class eGroupId;
 enum class eIntegrationType;
 enum class eStructureOutput;
+enum class eParallelAssembly;
+enum class eDofOrdering;
 enum class eVisualizationType;
 enum class eVisualizeWhat;
 enum class eDirection;
@@ -90,6 +99,7 @@ class StructureBase
     friend class NewmarkIndirect;
     friend class NewmarkDirect;
     friend class VelocityVerlet;
+    friend class HessianOperator;
 
 public:
     //! @brief constructor
@@ -183,14 +193,28 @@ public:
 
     //@brief determines the maximum independent sets and stores it at the structure
     // is only relevant for openmp, otherwise the routine is just empty
+    // the sets are obtained from a balanced (DSatur) coloring of the element connectivity graph
     void CalculateMaximumIndependentSets();
 
+    //@brief removes the maximum independent sets, they are recalculated in the next evaluation
+    // has to be called whenever elements are added or removed
+    void ClearMaximumIndependentSets();
+
     //@brief set the number of processors for openmp parallelization
     void SetNumProcessors(int rNumProcessors);
 
     //@brief get the number of processors for openmp parallelization
     int GetNumProcessors() const;
 
+    //@brief set the strategy for the parallel assembly, the default is eParallelAssembly::COLORING
+    // eParallelAssembly::THREAD_LOCAL requires no element coloring, but additional memory for the thread local
+    // outputs, which are kept between the evaluations. The results are identical in every run with the same number of
+    // processors.
+    void SetParallelAssembly(eParallelAssembly rParallelAssembly);
+
+    //@brief get the strategy for the parallel assembly
+    eParallelAssembly GetParallelAssembly() const;
+
     //@brief set the number of processors for openmp parallelization
     void SetOMPNested(bool rNested);
 
@@ -272,6 +296,12 @@ public:
     //! @brief see NodeGetAtCoordinate(Vector, tolerance) for 1D
     NodeBase& NodeGetAtCoordinate(double coordinate, double tolerance = 1.e-6);
 
+    //! @brief ... returns the node closest to the specified coordinates (the one with the smallest id if several nodes
+    //! have the same distance)
+    //! @param rCoordinates ... coordinates
+    //! @return ... node id, -1 if the structure has no nodes with coordinates
+    int NodeGetIdNearestToCoordinate(Eigen::VectorXd rCoordinates);
+
     //! @brief ... store all elements connected to this node in a vector
     //! @param rNodeId (Input) 			... node id
     //! @param rElementNumbers (Output) ... vector of element ids
@@ -288,6 +318,16 @@ public:
     //! @param rCallerName ... if the method throws it is nice to know by whom it was called.
     virtual void NodeBuildGlobalDofs(std::string rCallerName = "") = 0;
 
+    //! @brief sets the ordering of the nodes in the global dof numbering, the default is eDofOrdering::NODE_ID
+    //! @remark The ordering is computed from the node connectivity of the elements (or the node coordinates) in the
+    //! next NodeBuildGlobalDofs. It improves the memory locality of the assembly and of matrix vector products and
+    //! reduces the fill-in of sparse direct solvers. Only the active dofs follow the node ordering, the dependent dofs
+    //! are numbered after them in the order of the constraint equations.
+    void SetDofOrdering(eDofOrdering rDofOrdering);
+
+    //! @brief returns the ordering of the nodes in the global dof numbering
+    eDofOrdering GetDofOrdering() const;
+
     //! @brief sets the displacements of a node
     //! @param rIdent node identifier
     //! @param rDisplacements matrix (one column) with the displacements
@@ -383,6 +423,15 @@ public:
     //! @return ... StructureBlockVector containing the dofs (J and K)
     NuTo::StructureOutputBlockVector NodeExtractDofValues() const;
 
+#ifndef SWIG
+    //! @brief near null space of the active dofs for algebraic multigrid, see SmoothedAggregationAMG
+    //! @remark The rows follow the compressed matrix of the active dofs, see BlockSparseMatrix::GetCompressed. The
+    //! modes are the rigid body modes of the displacements (translations and rotations about the centroid of the
+    //! nodes) and the constant vector of each other active dof type. The dofs of a node belong to the same node of
+    //! the near null space.
+    NearNullSpace BuildNearNullSpace();
+#endif
+
     //! @brief write dof values (e.g. displacements, temperatures to the nodes)
     //! @param rTimeDerivative time derivative (0 disp 1 vel 2 acc)
     //! @param rActiveDofValues ... vector of independent dof values (ordering according to global dofs, size is number
@@ -1182,6 +1231,12 @@ public:
     //! to false, the element is select if at least one node is in the node group
     void GroupAddElementsFromNodes(int rElementGroupId, int rNodeGroupId, bool rHaveAllNodes);
 
+    //! @brief ... Adds all elements to a group whose nodes are inside the box [rMin, rMax]
+    //! @param rIdentGroup identifier for the element group
+    //! @param rMin ... lower corner of the box
+    //! @param rMax ... upper corner of the box
+    void GroupAddElementsInBox(int rIdentGroup, Eigen::VectorXd rMin, Eigen::VectorXd rMax);
+
     //! @brief ... Adds all the nodes from the group-rElementGroupId to the group rNodeGroupId
     //! @param rNodeGroupId id for the node group
     //! @param rElementGroupId id for the element group
@@ -1289,6 +1344,51 @@ public:
     //! values smaller than that one will not be added to the global matrix
     double GetToleranceStiffnessEntries() const;
 
+    //! @brief enables the reuse of the sparsity pattern in the assembly of the hessians
+    //! @remark The pattern and the positions of the element matrix entries are determined once and reused until the
+    //! elements, their constitutive laws or the dof numbering change. All entries of the pattern are stored, even if
+    //! they are zero, and the tolerance for the stiffness entries is not applied. Not suitable for elements with a
+    //! changing connectivity, e.g. contact elements.
+    void SetUseAssemblyPattern(bool rUseAssemblyPattern);
+
+    //! @brief returns true, if the sparsity pattern is reused in the assembly of the hessians
+    bool GetUseAssemblyPattern() const;
+
+    //! @brief enables the evaluation of consecutive elements of the same type in batches, see ElementBatch. Disabled by
+    //! default, the results only differ by rounding errors.
+    //! @remark The batches read the geometry from the geometry caches of the elements, if enabled. Elements that can not
+    //! be batched are evaluated by the fixed-size kernels where possible.
+    void SetUseElementBatches(bool rUseElementBatches);
+
+    //! @brief returns true, if consecutive elements of the same type are evaluated in batches
+    bool GetUseElementBatches() const;
+
+    //! @brief enables the cache of the jacobians and the derivatives of the shape functions at the integration points
+    //! of the continuum elements, see ElementGeometryCache. Disabled by default, disabling releases the memory.
+    //! @remark The caches are rebuilt when node coordinates of the structure change. Applies to the existing and to new
+    //! elements.
+    void SetUseGeometryCache(bool rUseGeometryCache);
+
+    //! @brief returns true, if the geometric quantities at the integration points are cached
+    bool GetUseGeometryCache() const;
+
+    //! @brief enables the incremental assembly of HESSIAN0, see IncrementalHessian. Disabled by default.
+    //! @remark Only elements whose tangents changed since the previous assembly are evaluated, e.g. the elements in
+    //! the process zone of a LocalDamageModel. Requires the assembly pattern (SetUseAssemblyPattern) and applies to
+    //! evaluations without static data updates. The result differs from a complete assembly by rounding errors.
+    //! Parameters of constitutive laws must be changed via the structure, e.g. ConstitutiveLawSetParameterDouble.
+    void SetUseIncrementalHessian0(bool rUseIncrementalHessian0);
+
+    //! @brief returns true, if HESSIAN0 is assembled incrementally
+    bool GetUseIncrementalHessian0() const;
+
+    //! @brief removes the assembly pattern, it is rebuilt in the next evaluation. Also removes the incremental HESSIAN0
+    void ClearAssemblyPattern();
+
+    //! @brief returns the cached global dof numbers of the elements, missing entries are calculated
+    //! @remark not thread safe
+    const ElementDofTable& GetElementDofTable();
+
     //! @brief returns the number of degrees of freedom
     //! @return ... number of degrees of freedom
     int GetNumTotalDofs() const;
@@ -1487,6 +1587,19 @@ protected:
         return unused;
     }
 
+#ifdef _OPENMP
+    //@brief processes the elements of the maximum independent sets in parallel, one set after another
+    //@remark A single parallel region for all sets. The elements of each set are distributed in chunks via dynamic
+    // scheduling, so a thread that finished its chunks takes over the remaining ones instead of idling. The only
+    // synchronization point is the implicit barrier at the end of each set. Exceptions are rethrown afterwards.
+    //@param rCreateChunkFunction ... called once by each thread, returns the function that processes a chunk of
+    // consecutive elements of one set in this thread (pointer to the first element, number of elements)
+    //@param rChunkGranularity ... the chunk sizes are multiples of it, e.g. ElementBatch::BatchSize
+    void ForEachIndependentSetChunk(
+            const std::function<std::function<void(ElementBase* const*, int)>()>& rCreateChunkFunction,
+            int rChunkGranularity = 1);
+#endif
+
 
     //! @brief ... number of time derivatives (0 : static, 1: velocities, 2: accelerations)
     int mNumTimeDerivatives;
@@ -1533,11 +1646,50 @@ protected:
     //! values smaller than that one will not be added to the global matrix
     double mToleranceStiffnessEntries;
 
+    //! @brief reuse the sparsity pattern in the assembly of the hessians
+    bool mUseAssemblyPattern;
+
+    //! @brief evaluate consecutive elements of the same type in batches
+    bool mUseElementBatches;
+
+    //! @brief cache the geometric quantities at the integration points of the elements
+    bool mUseGeometryCache;
+
+    //! @brief sparsity pattern and positions of the element matrix entries, built in the first evaluation
+    std::unique_ptr<AssemblyPattern> mAssemblyPattern;
+
+    //! @brief ordering of the nodes in the global dof numbering
+    eDofOrdering mDofOrdering;
+
+    //! @brief assemble HESSIAN0 incrementally
+    bool mUseIncrementalHessian0;
+
+    //! @brief HESSIAN0 and the element hessians of the previous assembly, built together with the assembly pattern
+    std::unique_ptr<IncrementalHessian> mIncrementalHessian0;
+
+    //! @brief global dof numbers of the elements, cleared whenever the dofs are renumbered
+    std::unique_ptr<ElementDofTable> mElementDofTable;
+
+    //! @brief spatial index of the node coordinates for the node and group queries, built in the first query
+    std::unique_ptr<SpatialIndex<NodeBase>> mNodeSpatialIndex;
+
+    //! @brief spatial index of the bounding boxes of the elements, built in the first query
+    std::unique_ptr<SpatialIndex<ElementBase>> mElementSpatialIndex;
+
+    //! @brief see GetGeometryGeneration and GetConfigurationGeneration
+    StructureGeneration mGeneration;
+
 #ifdef _OPENMP
     //@brief maximum independent sets used for parallel assembly of the stiffness resforce etc.
+    //@remark each set is processed in chunks of consecutive elements that are dynamically distributed among threads
     mutable std::vector<std::vector<ElementBase*>> mMIS;
     //@brief number of processors used in an openmp simulation
     int mNumProcessors;
+    //@brief strategy for the parallel assembly of the structure outputs
+    eParallelAssembly mParallelAssembly;
+    //@brief structure outputs of the threads 1, 2, ... for eParallelAssembly::THREAD_LOCAL, reused in each evaluation
+    //@remark cleared together with the assembly pattern, e.g. if the dofs are renumbered
+    std::vector<std::map<eStructureOutput, std::unique_ptr<StructureOutputBase>>> mThreadLocalOutputs;
 #endif
 
     //! @brief logger class to redirect the output to some file or the console (or both), can be changed even for const
@@ -1562,6 +1714,14 @@ protected:
     //! @param rElements ... vector of element pointer
     virtual void GetElementsTotal(std::vector<ElementBase*>& rElements) = 0;
 
+    //! @brief ... store all elements of a structure in a vector, in the order of the loops of the assembly
+    //! @remark the order of the ids by default, GetElementsTotal keeps the order of the ids in any case
+    //! @param rElements ... vector of element pointer
+    virtual void GetElementsTotalInAssemblyOrder(std::vector<ElementBase*>& rElements)
+    {
+        GetElementsTotal(rElements);
+    }
+
     //! @brief ... store all elements of a structure in a vector
     //! @param rElements ... vector of element pointer
     virtual void GetElementsTotal(std::vector<std::pair<int, ElementBase*>>& rElements) = 0;
@@ -1587,5 +1747,34 @@ protected:
     //! @param rElementGroup ... element group
     //! @param rElements ... vector of element pointer
     void GetElementsByGroup(Group<ElementBase>* rElementGroup, std::vector<ElementBase*>& rElements);
+
+    //! @brief returns a counter that changes whenever nodes or elements are added or removed, see SpatialIndex
+    virtual unsigned long GetMeshRevision() const = 0;
+
+    //! @brief returns a counter that changes if node coordinates were set since the previous call
+    //! @remark The nodes and elements refer to the generations (see NodeBase::SetStructureGeneration,
+    //! ElementBase::SetStructureGeneration). The geometry caches of the elements, the incremental hessian and the
+    //! spatial indices are only valid for the geometry generation they were built in, see StructureGeneration.
+    unsigned long GetGeometryGeneration() const
+    {
+        return mGeneration.GetGeometry();
+    }
+
+    //! @brief returns a counter that changes whenever an interpolation is added to an interpolation type, a node is
+    //! exchanged or the structure destroys a constitutive law
+    //! @remark The evaluation workspaces of the elements are only valid for the configuration generation they were
+    //! prepared in, the data derived from the geometry also depends on it.
+    unsigned long GetConfigurationGeneration() const
+    {
+        return mGeneration.GetConfiguration();
+    }
+
+    //! @brief returns the spatial index of the nodes, rebuilt if nodes were added, removed or moved
+    //! @remark contains the nodes with as many coordinates as the dimension of the structure
+    const SpatialIndex<NodeBase>& NodeGetSpatialIndex();
+
+    //! @brief returns the spatial index of the bounding boxes of the elements (of their nodes with coordinates),
+    //! rebuilt if nodes or elements were added, removed or moved
+    const SpatialIndex<ElementBase>& ElementGetSpatialIndex();
 };
 } // namespace NuTo
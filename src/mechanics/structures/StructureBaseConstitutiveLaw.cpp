@@ -22,6 +22,7 @@
 #include "mechanics/constitutive/laws/ShrinkageCapillaryStrainBased.h"
 #include "mechanics/constitutive/laws/ShrinkageCapillaryStressBased.h"
 #include "mechanics/constitutive/laws/ThermalStrains.h"
+#include "mechanics/structures/IncrementalHessian.h"
 
 // create a new constitutive law
 int NuTo::StructureBase::ConstitutiveLawCreate(const std::string& rType)
@@ -173,6 +174,8 @@ void NuTo::StructureBase::ConstitutiveLawDelete(int rIdent)
     else
     {
         this->mConstitutiveLawMap.erase(it);
+        // a new law could be allocated at the same address
+        mGeneration.IncrementConfiguration();
     }
 }
 
@@ -284,6 +287,7 @@ void NuTo::StructureBase::ConstitutiveLawSetParameterBool(int rIdent,
 {
     ConstitutiveBase* constitutiveLawPtr = this->ConstitutiveLawGetConstitutiveLawPtr(rIdent);
     constitutiveLawPtr->SetParameterBool(rIdentifier, rValue);
+    mIncrementalHessian0.reset();
 }
 
 
@@ -302,6 +306,7 @@ void NuTo::StructureBase::ConstitutiveLawSetParameterDouble(int rIdent,
 {
     ConstitutiveBase* constitutiveLawPtr = this->ConstitutiveLawGetConstitutiveLawPtr(rIdent);
     constitutiveLawPtr->SetParameterDouble(rIdentifier, rValue);
+    mIncrementalHessian0.reset();
 }
 
 
@@ -318,6 +323,7 @@ void NuTo::StructureBase::ConstitutiveLawSetParameterFullVectorDouble(
 {
     ConstitutiveBase* ConstitutiveLawPtr = this->ConstitutiveLawGetConstitutiveLawPtr(rIdent);
     ConstitutiveLawPtr->SetParameterFullVectorDouble(rIdentifier, rValue);
+    mIncrementalHessian0.reset();
 }
 
 
@@ -334,6 +340,7 @@ void NuTo::StructureBase::ConstitutiveLawSetParameterMatrixDouble(
 {
     ConstitutiveBase* ConstitutiveLawPtr = this->ConstitutiveLawGetConstitutiveLawPtr(rIdent);
     ConstitutiveLawPtr->SetParameterMatrixDouble(rIdentifier, rValue);
+    mIncrementalHessian0.reset();
 }
 
 
@@ -341,6 +348,7 @@ void NuTo::StructureBase::ConstitutiveLawSetDamageLaw(int lawId, std::shared_ptr
 {
     ConstitutiveBase* constitutiveLawPtr = this->ConstitutiveLawGetConstitutiveLawPtr(lawId);
     constitutiveLawPtr->SetDamageLaw(damageLaw);
+    mIncrementalHessian0.reset();
 }
 
 double NuTo::StructureBase::ConstitutiveLawGetEquilibriumWaterVolumeFraction(int rIdent, double rRelativeHumidity,
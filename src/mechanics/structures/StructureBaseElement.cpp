@@ -1,6 +1,8 @@
 #include <cassert>
 
 #include "mechanics/structures/StructureBase.h"
+#include "mechanics/structures/ElementDofTable.h"
+#include "mechanics/structures/SpatialIndex.h"
 
 #include "base/Timer.h"
 #include "mechanics/dofSubMatrixStorage/DofStatus.h"
@@ -14,10 +16,10 @@
 #include "mechanics/elements/ElementEnum.h"
 #include "mechanics/elements/ElementOutputBlockMatrixDouble.h"
 #include "mechanics/elements/ElementOutputBlockVectorDouble.h"
-#include "mechanics/elements/ElementOutputBlockVectorInt.h"
 #include "mechanics/elements/ElementOutputIpData.h"
 #include "mechanics/elements/ElementOutputDummy.h"
 #include "mechanics/elements/IpDataEnum.h"
+#include "mechanics/nodes/NodeBase.h"
 #include "mechanics/nodes/NodeEnum.h"
 
 #include "visualize/VisualizeEnum.h"
@@ -90,24 +92,15 @@ BlockFullMatrix<double> StructureBase::ElementBuildHessian2(ElementBase& rElemen
 
 BlockFullVector<int> StructureBase::ElementBuildGlobalDofsRow(ElementBase& rElement)
 {
-    std::map<Element::eOutput, std::shared_ptr<ElementOutputBase>> elementOutputMap;
-    elementOutputMap[Element::eOutput::GLOBAL_ROW_DOF] = std::make_shared<ElementOutputBlockVectorInt>(GetDofStatus());
-
-    rElement.Evaluate(elementOutputMap);
-
-    return elementOutputMap.at(Element::eOutput::GLOBAL_ROW_DOF)->GetBlockFullVectorInt();
+    mElementDofTable->Update(rElement);
+    return mElementDofTable->GetRowDofs(rElement);
 }
 
 
 BlockFullVector<int> StructureBase::ElementBuildGlobalDofsColumn(ElementBase& rElement)
 {
-    std::map<Element::eOutput, std::shared_ptr<ElementOutputBase>> elementOutputMap;
-    elementOutputMap[Element::eOutput::GLOBAL_COLUMN_DOF] =
-            std::make_shared<ElementOutputBlockVectorInt>(GetDofStatus());
-
-    rElement.Evaluate(elementOutputMap);
-
-    return elementOutputMap.at(Element::eOutput::GLOBAL_COLUMN_DOF)->GetBlockFullVectorInt();
+    mElementDofTable->Update(rElement);
+    return mElementDofTable->GetColumnDofs(rElement);
 }
 
 
@@ -300,6 +293,7 @@ void StructureBase::ElementTotalSetConstitutiveLaw(int rConstitutiveLawIdent)
 void StructureBase::ElementSetConstitutiveLaw(ElementBase* rElement, ConstitutiveBase* rConstitutive)
 {
     rElement->SetConstitutiveLaw(*rConstitutive);
+    ClearAssemblyPattern();
 }
 
 
@@ -368,6 +362,8 @@ void StructureBase::ElementGroupSetInterpolationType(int rGroupId, int rInterpol
 void StructureBase::ElementSetInterpolationType(ElementBase* rElement, InterpolationType* rInterpolationType)
 {
     rElement->SetInterpolationType(*rInterpolationType);
+    mElementDofTable->Remove(*rElement);
+    ClearAssemblyPattern();
 }
 
 
@@ -972,3 +968,48 @@ void StructureBase::ElementVectorAddToVisualize(Visualize::UnstructuredGrid& vis
         throw NuTo::Exception(__PRETTY_FUNCTION__, "Visualization type not implemented.");
     }
 }
+
+const SpatialIndex<ElementBase>& StructureBase::ElementGetSpatialIndex()
+{
+    const unsigned long revision = GetMeshRevision();
+    const unsigned long geometryGeneration = GetGeometryGeneration();
+    const unsigned long configurationGeneration = GetConfigurationGeneration();
+    if (mElementSpatialIndex != nullptr and
+        mElementSpatialIndex->IsValid(revision, geometryGeneration, configurationGeneration))
+        return *mElementSpatialIndex;
+
+    std::vector<std::pair<int, ElementBase*>> elementVector;
+    this->GetElementsTotal(elementVector);
+
+    std::vector<std::pair<int, ElementBase*>> elements;
+    Eigen::MatrixXd boxMin(mDimension, elementVector.size());
+    Eigen::MatrixXd boxMax(mDimension, elementVector.size());
+    for (auto& element : elementVector)
+    {
+        bool hasCoordinates = false;
+        const int column = elements.size();
+        for (int iNode = 0; iNode < element.second->GetNumNodes(); ++iNode)
+        {
+            const NodeBase* node = element.second->GetNode(iNode);
+            if (node->GetNum(Node::eDof::COORDINATES) != mDimension)
+                continue;
+            const Eigen::VectorXd& coordinates = node->Get(Node::eDof::COORDINATES);
+            if (not hasCoordinates)
+            {
+                boxMin.col(column) = coordinates;
+                boxMax.col(column) = coordinates;
+                hasCoordinates = true;
+            }
+            boxMin.col(column) = boxMin.col(column).cwiseMin(coordinates);
+            boxMax.col(column) = boxMax.col(column).cwiseMax(coordinates);
+        }
+        if (hasCoordinates)
+            elements.push_back(element);
+    }
+    boxMin.conservativeResize(mDimension, elements.size());
+    boxMax.conservativeResize(mDimension, elements.size());
+
+    mElementSpatialIndex = std::make_unique<SpatialIndex<ElementBase>>(std::move(elements), boxMin, boxMax, revision,
+                                                                       geometryGeneration, configurationGeneration);
+    return *mElementSpatialIndex;
+}
@@ -17,6 +17,22 @@ enum class eStructureOutput
     UPDATE_STATIC_DATA
 };
 
+//! @brief strategy for the openmp parallel assembly of the structure outputs
+enum class eParallelAssembly
+{
+    COLORING, //!< independent sets of elements are assembled concurrently into the global outputs
+    THREAD_LOCAL //!< each thread assembles into its own outputs, these are summed up in a fixed order
+};
+
+//! @brief ordering of the nodes in the global dof numbering
+enum class eDofOrdering
+{
+    NODE_ID, //!< order of the node ids
+    REVERSE_CUTHILL_MCKEE, //!< small bandwidth of the hessians, see GraphOrdering::ReverseCuthillMcKee
+    MORTON_CURVE, //!< nodes along a space filling curve, see GraphOrdering::MortonCurve
+    NESTED_DISSECTION //!< small fill-in of sparse direct solvers, see GraphOrdering::NestedDissection
+};
+
 const std::map<eStructureOutput, std::string> GetOutputMap();
 std::string StructureOutputToString(eStructureOutput rOutput);
 eStructureOutput StructureOutputToEnum(std::string rOutput);
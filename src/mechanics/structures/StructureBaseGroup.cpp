@@ -1,7 +1,9 @@
+#include <limits>
 #include <set>
 #include "base/Timer.h"
 
 #include "mechanics/structures/StructureBase.h"
+#include "mechanics/structures/SpatialIndex.h"
 #include "mechanics/groups/Group.h"
 #include "mechanics/groups/GroupEnum.h"
 #include "mechanics/elements/ElementBase.h"
@@ -142,23 +144,17 @@ void StructureBase::GroupAddNodeCoordinateRange(int rIdentGroup, int rDirection,
     if (itGroup->second->GetType() != eGroupId::Nodes)
         throw Exception("[StructureBase::GroupAddNodeCoordinateRange] A node can be added only to a node group.");
 
-    if (rDirection < 0 || rDirection > mDimension)
+    if (rDirection < 0 || rDirection >= mDimension)
         throw Exception("[StructureBase::GroupAddNodeCoordinateRange] The direction is either 0(x),1(Y) or "
                         "2(Z) and has to be smaller than the dimension of the structure.");
 
-    std::vector<std::pair<int, NodeBase*>> nodeVector;
-    this->GetNodesTotal(nodeVector);
+    // slab of the structure
+    Eigen::VectorXd boxMin = Eigen::VectorXd::Constant(mDimension, -std::numeric_limits<double>::infinity());
+    Eigen::VectorXd boxMax = Eigen::VectorXd::Constant(mDimension, std::numeric_limits<double>::infinity());
+    boxMin[rDirection] = rMin;
+    boxMax[rDirection] = rMax;
 
-    for (auto& node : nodeVector)
-    {
-        NodeBase* nodePtr(node.second);
-        if (nodePtr->GetNum(Node::eDof::COORDINATES) < 1)
-            continue;
-        double coordinate = nodePtr->Get(Node::eDof::COORDINATES)[rDirection];
-
-        if (coordinate >= rMin && coordinate <= rMax)
-            itGroup->second->AddMember(node.first, nodePtr);
-    }
+    itGroup->second->AsGroupNode()->AddMembers(NodeGetSpatialIndex().FindInBox(boxMin, boxMax));
 }
 
 Group<NodeBase>& StructureBase::GroupGetNodeCoordinateRange(eDirection direction, double min, double max)
@@ -225,12 +221,14 @@ void StructureBase::GroupAddNodeFunction(int rIdentGroup, std::function<bool(Nod
     std::vector<std::pair<int, NodeBase*>> nodeVector;
     this->GetNodesTotal(nodeVector);
 
+    std::vector<std::pair<int, NodeBase*>> newMembers;
     for (auto& node : nodeVector)
     {
         NodeBase* nodePtr(node.second);
         if (rFunction(nodePtr))
-            itGroup->second->AddMember(node.first, nodePtr);
+            newMembers.push_back(node);
     }
+    itGroup->second->AsGroupNode()->AddMembers(std::move(newMembers));
 }
 
 void StructureBase::GroupAddNodeRadiusRange(int rIdentGroup, Eigen::VectorXd rCenter, double rMin, double rMax)
@@ -251,16 +249,12 @@ void StructureBase::GroupAddNodeRadiusRange(int rIdentGroup, Eigen::VectorXd rCe
         throw Exception("[StructureBase::GroupAddNodeRadiusRange] The minimum radius must not be larger than "
                         "the maximum radius.");
 
-    std::vector<std::pair<int, NodeBase*>> nodeVector;
-    this->GetNodesTotal(nodeVector);
     double rMin2 = rMin * rMin;
     double rMax2 = rMax * rMax;
 
-    for (auto& node : nodeVector)
+    for (auto& node : NodeGetSpatialIndex().FindInBox(rCenter.array() - rMax, rCenter.array() + rMax))
     {
         NodeBase* nodePtr(node.second);
-        if (nodePtr->GetNum(Node::eDof::COORDINATES) < 1)
-            continue;
         Eigen::VectorXd dCoordinates = nodePtr->Get(Node::eDof::COORDINATES) - rCenter;
         double r2 = dCoordinates.dot(dCoordinates);
 
@@ -305,8 +299,8 @@ void StructureBase::GroupAddNodeCylinderRadiusRange(int rIdentGroup, Eigen::Vect
     {
     case 2:
     {
-        std::vector<std::pair<int, NodeBase*>> nodeVector;
-        this->GetNodesTotal(nodeVector);
+        std::vector<std::pair<int, NodeBase*>> nodeVector =
+                NodeGetSpatialIndex().FindInBox(rCenter.array() - rMax, rCenter.array() + rMax);
         Eigen::Vector2d coordinates;
         Eigen::Vector2d vecDelta;
         double rMin2 = rMin * rMin;
@@ -331,8 +325,6 @@ void StructureBase::GroupAddNodeCylinderRadiusRange(int rIdentGroup, Eigen::Vect
     }
     case 3:
     {
-        std::vector<std::pair<int, NodeBase*>> nodeVector;
-        this->GetNodesTotal(nodeVector);
         Eigen::Vector3d coordinates;
         Eigen::Vector3d vecPtrCenter;
         Eigen::Vector3d vecPtrProjection;
@@ -343,6 +335,17 @@ void StructureBase::GroupAddNodeCylinderRadiusRange(int rIdentGroup, Eigen::Vect
         // normalize Diretion Vector
         rDirection *= 1. / rDirection.norm();
 
+        // the cylinder is only bounded in the directions perpendicular to its axis
+        Eigen::Vector3d boxMin = Eigen::Vector3d::Constant(-std::numeric_limits<double>::infinity());
+        Eigen::Vector3d boxMax = Eigen::Vector3d::Constant(std::numeric_limits<double>::infinity());
+        for (int i = 0; i < 3; ++i)
+            if (rDirection[i] == 0.)
+            {
+                boxMin[i] = rCenter[i] - rMax;
+                boxMax[i] = rCenter[i] + rMax;
+            }
+        std::vector<std::pair<int, NodeBase*>> nodeVector = NodeGetSpatialIndex().FindInBox(boxMin, boxMax);
+
         for (auto& node : nodeVector)
         {
             NodeBase* nodePtr(node.second);
@@ -389,6 +392,7 @@ void StructureBase::GroupAddElementsFromNodes(int rElementGroupId, int rNodeGrou
 
     std::vector<std::pair<int, ElementBase*>> elementVector;
     this->GetElementsTotal(elementVector);
+    std::vector<std::pair<int, ElementBase*>> newMembers;
     for (auto& element : elementVector)
     {
         if (!elementGroup->Contain(element.first))
@@ -421,10 +425,42 @@ void StructureBase::GroupAddElementsFromNodes(int rElementGroupId, int rNodeGrou
             if (addElement)
             {
                 // add the element;
-                elementGroup->AddMember(element.first, element.second);
+                newMembers.push_back(element);
             }
         }
     }
+    elementGroup->AddMembers(std::move(newMembers));
+}
+
+void StructureBase::GroupAddElementsInBox(int rIdentGroup, Eigen::VectorXd rMin, Eigen::VectorXd rMax)
+{
+    Timer timer(__FUNCTION__, GetShowTime(), GetLogger());
+
+    boost::ptr_map<int, GroupBase>::iterator itGroup = mGroupMap.find(rIdentGroup);
+    if (itGroup == mGroupMap.end())
+        throw Exception(__PRETTY_FUNCTION__, "Group with the given identifier does not exist.");
+    if (itGroup->second->GetType() != eGroupId::Elements)
+        throw Exception(__PRETTY_FUNCTION__, "An element can be added only to an element group.");
+
+    if (rMin.rows() != mDimension or rMax.rows() != mDimension)
+        throw Exception(__PRETTY_FUNCTION__, "The corners of the box must have as many coordinates as the dimension.");
+
+    std::vector<std::pair<int, ElementBase*>> newMembers;
+    for (auto& element : ElementGetSpatialIndex().FindInBox(rMin, rMax))
+    {
+        bool isInside = true;
+        for (int iNode = 0; iNode < element.second->GetNumNodes() and isInside; ++iNode)
+        {
+            const NodeBase* node = element.second->GetNode(iNode);
+            if (node->GetNum(Node::eDof::COORDINATES) != mDimension)
+                continue;
+            const Eigen::VectorXd& coordinates = node->Get(Node::eDof::COORDINATES);
+            isInside = (coordinates.array() >= rMin.array()).all() and (coordinates.array() <= rMax.array()).all();
+        }
+        if (isInside)
+            newMembers.push_back(element);
+    }
+    itGroup->second->AsGroupElement()->AddMembers(std::move(newMembers));
 }
 
 void StructureBase::GroupAddNodesFromElements(int rNodeGroupId, int rElementGroupId)
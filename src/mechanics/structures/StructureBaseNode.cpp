@@ -1,12 +1,14 @@
 #include "base/Timer.h"
 
 #include "math/EigenCompanion.h"
+#include "math/SmoothedAggregationAMG.h"
 
 #include "mechanics/elements/ElementOutputBlockVectorDouble.h"
-#include "mechanics/elements/ElementOutputBlockVectorInt.h"
 
 #include "mechanics/structures/StructureBase.h"
 #include "mechanics/structures/StructureOutputBlockVector.h"
+#include "mechanics/structures/ElementDofTable.h"
+#include "mechanics/structures/SpatialIndex.h"
 #include "mechanics/elements/ElementBase.h"
 #include "mechanics/elements/ElementEnum.h"
 #include "mechanics/nodes/NodeBase.h"
@@ -38,6 +40,77 @@ NuTo::StructureOutputBlockVector NuTo::StructureBase::NodeExtractDofValues() con
     return NodeExtractDofValues(0);
 }
 
+NuTo::NearNullSpace NuTo::StructureBase::BuildNearNullSpace()
+{
+    NodeBuildGlobalDofs(__PRETTY_FUNCTION__);
+
+    std::vector<const NodeBase*> nodes;
+    GetNodesTotal(nodes);
+    Eigen::VectorXd centroid = Eigen::VectorXd::Zero(GetDimension());
+    for (const NodeBase* node : nodes)
+        if (node->IsDof(Node::eDof::COORDINATES))
+            centroid += node->Get(Node::eDof::COORDINATES);
+    centroid /= std::max<int>(1, nodes.size());
+
+    // first row and first mode of each active dof type
+    const int numRotations = GetDimension() == 1 ? 0 : (GetDimension() == 2 ? 1 : 3);
+    std::map<Node::eDof, std::pair<int, int>> offsets;
+    int numRows = 0;
+    int numModes = 0;
+    for (auto dof : DofTypesGetActive())
+    {
+        offsets[dof] = {numRows, numModes};
+        numRows += GetNumActiveDofs(dof);
+        numModes += dof == Node::eDof::DISPLACEMENTS ? GetDimension() + numRotations : 1;
+    }
+
+    NearNullSpace nearNullSpace;
+    nearNullSpace.mModes = Eigen::MatrixXd::Zero(numRows, numModes);
+    nearNullSpace.mNodes.resize(numRows);
+    for (unsigned int nodeIndex = 0; nodeIndex < nodes.size(); ++nodeIndex)
+    {
+        const NodeBase& node = *nodes[nodeIndex];
+        Eigen::VectorXd x = Eigen::VectorXd::Zero(GetDimension());
+        if (node.IsDof(Node::eDof::COORDINATES))
+            x = node.Get(Node::eDof::COORDINATES) - centroid;
+
+        for (const auto& offset : offsets)
+        {
+            const Node::eDof dof = offset.first;
+            if (not node.IsDof(dof))
+                continue;
+            const int numActiveDofs = GetNumActiveDofs(dof);
+            for (int component = 0; component < node.GetNum(dof); ++component)
+            {
+                const int dofNumber = node.GetDof(dof, component);
+                if (dofNumber >= numActiveDofs)
+                    continue;
+                const int row = offset.second.first + dofNumber;
+                const int mode = offset.second.second;
+                nearNullSpace.mNodes[row] = nodeIndex;
+                if (dof != Node::eDof::DISPLACEMENTS)
+                {
+                    nearNullSpace.mModes(row, mode) = 1.;
+                    continue;
+                }
+                // translations and rotations u = e_axis x x
+                auto modes = nearNullSpace.mModes.row(row).segment(mode, GetDimension() + numRotations);
+                modes[component] = 1.;
+                if (GetDimension() == 2)
+                    modes[2] = component == 0 ? -x[1] : x[0];
+                if (GetDimension() == 3)
+                {
+                    const int next = (component + 1) % 3;
+                    const int previous = (component + 2) % 3;
+                    modes[3 + next] = x[previous];
+                    modes[3 + previous] = -x[next];
+                }
+            }
+        }
+    }
+    return nearNullSpace;
+}
+
 void NuTo::StructureBase::NodeSetDisplacements(int rNode, int rTimeDerivative, const Eigen::VectorXd& rDisplacements)
 {
     NuTo::Timer(__FUNCTION__, GetShowTime(), GetLogger());
@@ -310,7 +383,6 @@ void NuTo::StructureBase::NodeInternalForce(const NodeBase* rNodePtr, Eigen::Vec
     std::map<Element::eOutput, std::shared_ptr<ElementOutputBase>> elementOutputMap;
     elementOutputMap[Element::eOutput::INTERNAL_GRADIENT] =
             std::make_shared<ElementOutputBlockVectorDouble>(GetDofStatus());
-    elementOutputMap[Element::eOutput::GLOBAL_ROW_DOF] = std::make_shared<ElementOutputBlockVectorInt>(GetDofStatus());
 
     std::vector<ElementBase*> elements;
     this->NodeGetElements(rNodePtr, elements);
@@ -323,8 +395,8 @@ void NuTo::StructureBase::NodeInternalForce(const NodeBase* rNodePtr, Eigen::Vec
         element->Evaluate(elementOutputMap);
         const auto& internalGradient = elementOutputMap.at(Element::eOutput::INTERNAL_GRADIENT)
                                                ->GetBlockFullVectorDouble()[Node::eDof::DISPLACEMENTS];
-        const auto& globalRowDof = elementOutputMap.at(Element::eOutput::GLOBAL_ROW_DOF)
-                                           ->GetBlockFullVectorInt()[Node::eDof::DISPLACEMENTS];
+        mElementDofTable->Update(*element);
+        const auto& globalRowDof = mElementDofTable->GetRowDofs(*element)[Node::eDof::DISPLACEMENTS];
         assert(internalGradient.rows() == globalRowDof.rows());
 
         for (int countDof = 0; countDof < rNodePtr->GetNum(Node::eDof::DISPLACEMENTS); countDof++)
@@ -362,17 +434,16 @@ NuTo::NodeBase& NuTo::StructureBase::NodeGetAtCoordinate(Eigen::VectorXd coordin
 {
     NuTo::Timer(__FUNCTION__, GetShowTime(), GetLogger());
 
-    std::vector<NodeBase*> nodeVector;
-    this->GetNodesTotal(nodeVector);
+    if (coordinate.rows() != GetDimension())
+        throw Exception(__PRETTY_FUNCTION__, "The coordinates must have as many components as the dimension.");
 
     double toleranceSquared = tolerance * tolerance;
 
-    for (auto* node : nodeVector)
+    // candidates in the order of the ids
+    for (auto& node : NodeGetSpatialIndex().FindInBox(coordinate.array() - tolerance, coordinate.array() + tolerance))
     {
-        if (node->GetNum(Node::eDof::COORDINATES) < 1)
-            continue;
-        if ((node->Get(Node::eDof::COORDINATES) - coordinate).squaredNorm() < toleranceSquared)
-            return *node;
+        if ((node.second->Get(Node::eDof::COORDINATES) - coordinate).squaredNorm() < toleranceSquared)
+            return *node.second;
     }
     std::stringstream coordStream;
     coordStream << '(' << coordinate.transpose() << ')';
@@ -384,18 +455,15 @@ int NuTo::StructureBase::NodeGetIdAtCoordinate(Eigen::VectorXd rCoordinates, dou
 {
     NuTo::Timer(__FUNCTION__, GetShowTime(), GetLogger());
 
-    std::vector<std::pair<int, NodeBase*>> nodeVector;
-    this->GetNodesTotal(nodeVector);
+    if (rCoordinates.rows() != GetDimension())
+        throw Exception(__PRETTY_FUNCTION__, "The coordinates must have as many components as the dimension.");
 
     double distance;
 
     int nodeId = -1;
-    for (auto& node : nodeVector)
+    for (auto& node : NodeGetSpatialIndex().FindInBox(rCoordinates.array() - rRange, rCoordinates.array() + rRange))
     {
         NodeBase* nodePtr(node.second);
-        if (nodePtr->GetNum(Node::eDof::COORDINATES) < 1)
-            continue;
-
         distance = (nodePtr->Get(Node::eDof::COORDINATES) - rCoordinates).norm();
 
         if (distance < rRange)
@@ -415,6 +483,44 @@ int NuTo::StructureBase::NodeGetIdAtCoordinate(Eigen::VectorXd rCoordinates, dou
     return nodeId;
 }
 
+int NuTo::StructureBase::NodeGetIdNearestToCoordinate(Eigen::VectorXd rCoordinates)
+{
+    NuTo::Timer(__FUNCTION__, GetShowTime(), GetLogger());
+
+    if (rCoordinates.rows() != GetDimension())
+        throw Exception(__PRETTY_FUNCTION__, "The coordinates must have as many components as the dimension.");
+
+    return NodeGetSpatialIndex().FindNearest(rCoordinates).first;
+}
+
+const NuTo::SpatialIndex<NuTo::NodeBase>& NuTo::StructureBase::NodeGetSpatialIndex()
+{
+    const unsigned long revision = GetMeshRevision();
+    const unsigned long geometryGeneration = GetGeometryGeneration();
+    const unsigned long configurationGeneration = GetConfigurationGeneration();
+    if (mNodeSpatialIndex != nullptr and
+        mNodeSpatialIndex->IsValid(revision, geometryGeneration, configurationGeneration))
+        return *mNodeSpatialIndex;
+
+    std::vector<std::pair<int, NodeBase*>> nodeVector;
+    this->GetNodesTotal(nodeVector);
+
+    std::vector<std::pair<int, NodeBase*>> nodes;
+    Eigen::MatrixXd coordinates(mDimension, nodeVector.size());
+    for (auto& node : nodeVector)
+    {
+        if (node.second->GetNum(Node::eDof::COORDINATES) != mDimension)
+            continue;
+        coordinates.col(nodes.size()) = node.second->Get(Node::eDof::COORDINATES);
+        nodes.push_back(node);
+    }
+    coordinates.conservativeResize(mDimension, nodes.size());
+
+    mNodeSpatialIndex = std::make_unique<SpatialIndex<NodeBase>>(std::move(nodes), coordinates, coordinates, revision,
+                                                                 geometryGeneration, configurationGeneration);
+    return *mNodeSpatialIndex;
+}
+
 
 void NuTo::StructureBase::NodeTotalAddToVisualize(Visualize::UnstructuredGrid& visualizer,
                                                   const std::vector<eVisualizeWhat>& visualizeComponents) const
@@ -0,0 +1,69 @@
+#pragma once
+
+#include <atomic>
+#include <mutex>
+
+namespace NuTo
+{
+
+//! @brief counters of a structure that change with its geometry and with its configuration
+//! @remark Data derived from the structure (evaluation workspaces and geometry caches of the elements, the
+//! incremental hessian, the spatial indices) stores the generations it was built in and is rebuilt if they changed.
+//! The nodes only mark the geometry as modified when their coordinates are set. All modifications up to the next
+//! query increment the geometry generation once, so setting the coordinates of many nodes invalidates the derived data
+//! only once. Marking and querying are thread safe.
+class StructureGeneration
+{
+public:
+    StructureGeneration() = default;
+    StructureGeneration(const StructureGeneration&) = delete;
+    StructureGeneration& operator=(const StructureGeneration&) = delete;
+
+    //! @brief marks the geometry as modified, e.g. if node coordinates are set
+    void SetGeometryModified()
+    {
+        // written only once to avoid writes to a shared cache line, e.g. in parallel loops over nodes
+        if (not mIsGeometryModified.load(std::memory_order_relaxed))
+            mIsGeometryModified.store(true, std::memory_order_relaxed);
+    }
+
+    //! @brief returns a counter that changes with the node coordinates
+    unsigned long GetGeometry() const
+    {
+        if (mIsGeometryModified.load(std::memory_order_acquire))
+        {
+            // the counter is incremented before the flag is reset, a thread that reads the reset flag also reads the
+            // incremented counter
+            std::lock_guard<std::mutex> lock(mMutex);
+            if (mIsGeometryModified.load(std::memory_order_relaxed))
+            {
+                mGeometry.fetch_add(1, std::memory_order_relaxed);
+                mIsGeometryModified.store(false, std::memory_order_release);
+            }
+        }
+        return mGeometry.load(std::memory_order_relaxed);
+    }
+
+    //! @brief increments the configuration generation
+    //! @remark called by the structure once per operation that changes objects in place or destroys objects whose
+    //! addresses could be reused, e.g. adding interpolations to an interpolation type, exchanging nodes or deleting
+    //! constitutive laws
+    void IncrementConfiguration()
+    {
+        mConfiguration.fetch_add(1, std::memory_order_relaxed);
+    }
+
+    //! @brief returns a counter that changes with the configuration, see IncrementConfiguration
+    unsigned long GetConfiguration() const
+    {
+        return mConfiguration.load(std::memory_order_relaxed);
+    }
+
+private:
+    mutable std::mutex mMutex;
+    mutable std::atomic<bool> mIsGeometryModified{false};
+    mutable std::atomic<unsigned long> mGeometry{0};
+    std::atomic<unsigned long> mConfiguration{0};
+};
+
+} // namespace NuTo
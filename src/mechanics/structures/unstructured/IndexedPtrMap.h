@@ -0,0 +1,212 @@
+#pragma once
+
+#include <functional>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+#include <boost/ptr_container/ptr_map.hpp>
+
+namespace NuTo
+{
+//! @brief owning map of ids to objects (boost::ptr_map) with a contiguous index of the objects
+//! @remark The loops over all objects run over a contiguous array instead of the tree of the map, the array is rebuilt
+//! after insertions and deletions when it is accessed the next time. Its order is the order of the ids. A second array
+//! in the order of an optional ordering is built on demand, e.g. to run over elements of the same type one after
+//! another. The ids of the objects are kept in a hash map for constant time lookups.
+//! @remark Modifications and the first access after a modification are not thread safe.
+template <typename T>
+class IndexedPtrMap
+{
+public:
+    using Map = boost::ptr_map<int, T>;
+    using iterator = typename Map::iterator;
+    using const_iterator = typename Map::const_iterator;
+
+    //! @brief ordering of GetOrderedObjects, returns the objects (given in the order of their ids) in their new order, e.g.
+    //! {2, 0, 1} stores the third object first, see GraphOrdering
+    using Ordering = std::function<std::vector<int>(const std::vector<T*>&)>;
+
+    iterator begin()
+    {
+        return mMap.begin();
+    }
+
+    iterator end()
+    {
+        return mMap.end();
+    }
+
+    const_iterator begin() const
+    {
+        return mMap.begin();
+    }
+
+    const_iterator end() const
+    {
+        return mMap.end();
+    }
+
+    iterator find(int rId)
+    {
+        return mMap.find(rId);
+    }
+
+    const_iterator find(int rId) const
+    {
+        return mMap.find(rId);
+    }
+
+    std::size_t size() const
+    {
+        return mMap.size();
+    }
+
+    bool empty() const
+    {
+        return mMap.empty();
+    }
+
+    //! @brief inserts rObject and takes the ownership, see boost::ptr_map::insert
+    std::pair<iterator, bool> insert(int rId, T* rObject)
+    {
+        auto result = mMap.insert(rId, rObject);
+        if (result.second)
+            mIds[rObject] = rId;
+        ++mRevision;
+        mIsIndexed = false;
+        mIsOrdered = false;
+        return result;
+    }
+
+    //! @brief deletes the object at rIterator
+    void erase(iterator rIterator)
+    {
+        mIds.erase(rIterator->second);
+        mMap.erase(rIterator);
+        ++mRevision;
+        mIsIndexed = false;
+        mIsOrdered = false;
+    }
+
+    //! @brief deletes the object with the id rId
+    //! @return number of deleted objects
+    std::size_t erase(int rId)
+    {
+        auto it = mMap.find(rId);
+        if (it == mMap.end())
+            return 0;
+        erase(it);
+        return 1;
+    }
+
+    //! @brief deletes all objects
+    void clear()
+    {
+        mMap.clear();
+        mIds.clear();
+        ++mRevision;
+        mIsIndexed = false;
+        mIsOrdered = false;
+    }
+
+    //! @brief returns the underlying map, sorted by the ids
+    const Map& GetMap() const
+    {
+        return mMap;
+    }
+
+    //! @brief returns the id of rObject, -1 if it is not contained
+    int GetId(const T* rObject) const
+    {
+        auto it = mIds.find(rObject);
+        return it == mIds.end() ? -1 : it->second;
+    }
+
+    //! @brief returns all objects in the order of their ids
+    const std::vector<T*>& GetObjects() const
+    {
+        BuildIndex();
+        return mObjects;
+    }
+
+    //! @brief returns the ids of the objects in ascending order, GetObjectIds()[i] is the id of GetObjects()[i]
+    const std::vector<int>& GetObjectIds() const
+    {
+        BuildIndex();
+        return mObjectIds;
+    }
+
+    //! @brief returns all objects in the order of SetOrdering, in the order of their ids if no ordering is set
+    const std::vector<T*>& GetOrderedObjects() const
+    {
+        BuildIndex();
+        if (not mOrdering)
+            return mObjects;
+        if (not mIsOrdered)
+        {
+            const std::vector<int> ordering = mOrdering(mObjects);
+            mOrderedObjects.resize(mObjects.size());
+            for (unsigned int i = 0; i < mObjects.size(); ++i)
+                mOrderedObjects[i] = mObjects[ordering[i]];
+            mIsOrdered = true;
+        }
+        return mOrderedObjects;
+    }
+
+    //! @brief sets the ordering of GetOrderedObjects, nullptr for the order of the ids
+    void SetOrdering(Ordering rOrdering)
+    {
+        mOrdering = rOrdering;
+        InvalidateOrdering();
+    }
+
+    //! @brief reorders the objects in the next call of GetOrderedObjects, e.g. if properties of the objects used by
+    //! the ordering changed
+    void InvalidateOrdering()
+    {
+        mIsOrdered = false;
+        mOrderedObjects.clear();
+    }
+
+    //! @brief returns the number of insertions and deletions, e.g. to detect outdated data derived from the objects
+    unsigned long GetRevision() const
+    {
+        return mRevision;
+    }
+
+private:
+    void BuildIndex() const
+    {
+        if (mIsIndexed)
+            return;
+
+        mObjects.clear();
+        mObjectIds.clear();
+        mObjects.reserve(mMap.size());
+        mObjectIds.reserve(mMap.size());
+        for (auto it = mMap.begin(); it != mMap.end(); ++it)
+        {
+            mObjectIds.push_back(it->first);
+            mObjects.push_back(const_cast<T*>(it->second));
+        }
+        mIsIndexed = true;
+    }
+
+    Map mMap;
+
+    //! @brief ids of the objects
+    std::unordered_map<const T*, int> mIds;
+
+    Ordering mOrdering;
+
+    unsigned long mRevision = 0;
+
+    mutable bool mIsIndexed = false;
+    mutable std::vector<T*> mObjects;
+    mutable std::vector<int> mObjectIds;
+
+    mutable bool mIsOrdered = false;
+    mutable std::vector<T*> mOrderedObjects;
+};
+
+} // namespace NuTo
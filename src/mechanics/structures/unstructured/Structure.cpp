@@ -2,6 +2,9 @@
 #include <omp.h>
 #endif
 
+#include <algorithm>
+#include <memory>
+
 #include "mechanics/structures/unstructured/Structure.h"
 
 #include "base/Timer.h"
@@ -11,11 +14,11 @@
 #include "mechanics/constitutive/ConstitutiveEnum.h"
 
 #include "mechanics/elements/ElementBase.h"
+#include "mechanics/elements/ElementBatch.h"
 #include "mechanics/elements/ElementEnum.h"
 #include "mechanics/elements/ElementOutputDummy.h"
 #include "mechanics/elements/ElementOutputBlockMatrixDouble.h"
 #include "mechanics/elements/ElementOutputBlockVectorDouble.h"
-#include "mechanics/elements/ElementOutputBlockVectorInt.h"
 #include "mechanics/nodes/NodeBase.h"
 #include "mechanics/nodes/NodeEnum.h"
 #include "mechanics/timeIntegration/TimeIntegrationBase.h"
@@ -26,10 +29,16 @@
 
 #include "mechanics/mesh/MeshCompanion.h"
 #include "mechanics/structures/Assembler.h"
+#include "mechanics/structures/AssemblyPattern.h"
+#include "mechanics/structures/ElementDofTable.h"
+#include "mechanics/structures/IncrementalHessian.h"
 
 NuTo::Structure::Structure(int rDimension)
     : StructureBase(rDimension)
 {
+    mElementMap.SetOrdering([this](const std::vector<ElementBase*>& rElements) {
+        return ElementLocalityOrdering(rElements);
+    });
 }
 
 NuTo::Structure::~Structure()
@@ -58,6 +67,7 @@ void NuTo::Structure::Evaluate(const NuTo::ConstitutiveInputMap& rInput,
         return; // ! ---> may occur if matrices have been identified as constant
 
     NodeBuildGlobalDofs();
+    GetElementDofTable(); // dof numbers of new elements, only read during the assembly
 
     // build global tmp static data
     if (this->mHaveTmpStaticData && this->mUpdateTmpStaticDataRequired)
@@ -68,197 +78,472 @@ void NuTo::Structure::Evaluate(const NuTo::ConstitutiveInputMap& rInput,
         iteratorOutput.second->SetZero();
     }
 
+    const AssemblyPattern* assemblyPattern = AssemblyPatternPrepare(rStructureOutput);
+
+    if (IsIncrementalHessian0Applicable(rStructureOutput, assemblyPattern))
+    {
+        EvaluateElementsIncremental(rInput, rStructureOutput, *assemblyPattern);
+        return;
+    }
+
+    EvaluateElements(rInput, rStructureOutput, assemblyPattern);
+}
+
+
+void NuTo::Structure::EvaluateElements(const NuTo::ConstitutiveInputMap& rInput,
+                                       std::map<eStructureOutput, StructureOutputBase*>& rStructureOutput,
+                                       const AssemblyPattern* rAssemblyPattern)
+{
 #ifdef _OPENMP
-    std::string exceptionMessage = "";
     if (mNumProcessors != 0)
     {
         omp_set_num_threads(mNumProcessors);
     }
 
-    if (mMIS.size() == 0)
+    if (mParallelAssembly == eParallelAssembly::THREAD_LOCAL)
     {
-        CalculateMaximumIndependentSets();
+        EvaluateThreadLocal(rInput, rStructureOutput, rAssemblyPattern);
+        return;
     }
-    for (unsigned int misCounter = 0; misCounter < mMIS.size(); misCounter++)
-    {
-#pragma omp parallel shared(rStructureOutput) // firstprivate(elementOutputMap)
-        {
-#endif // _OPENMP
-            // The allocation of the elementOutputMap is inside the openmp block
-            // since the every thread needs a copy of the map.
-            // This special case cannot (to my knowledge) be handled with the
-            // omp firstprivate directive, since a copy of a shared_ptr is
-            // not a deep copy of the underlying data - which makes perfectly sense.
 
-            // BEWARE (!!!) Do not perform a SetZero on the rStructureOutput here
-            // since it will remove the allocation of other MIS.
+    // The allocation of the element outputs (ElementBatch) is done by each thread
+    // since the every thread needs a copy of the map.
+    // This special case cannot (to my knowledge) be handled with the
+    // omp firstprivate directive, since a copy of a shared_ptr is
+    // not a deep copy of the underlying data - which makes perfectly sense.
+    const auto createChunkFunction = [&]() {
+        auto elementBatch = std::make_shared<ElementBatch>([&]() { return ElementOutputMapCreate(rStructureOutput); },
+                                                           mUseElementBatches);
+        return [&, elementBatch](ElementBase* const* rElements, int rNumElements) {
+            elementBatch->Evaluate(rInput, rElements, rNumElements,
+                                   [&](ElementBase& rElement, ElementBatch::ElementOutputMap& rElementOutputMap) {
+                                       ElementOutputAssemble(&rElement, rElementOutputMap, rStructureOutput,
+                                                             rAssemblyPattern);
+                                   });
+        };
+    };
+    // the chunks consist of complete element batches
+    ForEachIndependentSetChunk(createChunkFunction, ElementBatch::BatchSize);
+#else
+    std::vector<ElementBase*> elements;
+    GetElementsTotalInAssemblyOrder(elements);
+    ElementBatch elementBatch([&]() { return ElementOutputMapCreate(rStructureOutput); }, mUseElementBatches);
+    elementBatch.Evaluate(rInput, elements.data(), elements.size(),
+                          [&](ElementBase& rElement, ElementBatch::ElementOutputMap& rElementOutputMap) {
+                              ElementOutputAssemble(&rElement, rElementOutputMap, rStructureOutput, rAssemblyPattern);
+                          });
+#endif
+}
+
 
-            std::map<Element::eOutput, std::shared_ptr<ElementOutputBase>> elementOutputMap;
+bool NuTo::Structure::IsIncrementalHessian0Applicable(
+        const std::map<eStructureOutput, StructureOutputBase*>& rStructureOutput,
+        const AssemblyPattern* rAssemblyPattern) const
+{
+    if (not mUseIncrementalHessian0 or rAssemblyPattern == nullptr or
+        rStructureOutput.find(eStructureOutput::HESSIAN0) == rStructureOutput.end())
+        return false;
+
+    // the tangents of the normal assembly are calculated before the static data is updated
+    return rStructureOutput.find(eStructureOutput::UPDATE_STATIC_DATA) == rStructureOutput.end();
+}
 
-            // allocate element outputs and resize the structure outputs
-            for (auto iteratorOutput : rStructureOutput)
+
+void NuTo::Structure::EvaluateElementsIncremental(const NuTo::ConstitutiveInputMap& rInput,
+                                                  std::map<eStructureOutput, StructureOutputBase*>& rStructureOutput,
+                                                  const AssemblyPattern& rAssemblyPattern)
+{
+    std::vector<ElementBase*> elements;
+    GetElementsTotalInAssemblyOrder(elements);
+
+    const unsigned long geometryGeneration = GetGeometryGeneration();
+    const unsigned long configurationGeneration = GetConfigurationGeneration();
+    if (mIncrementalHessian0 == nullptr or
+        not mIncrementalHessian0->IsValid(geometryGeneration, configurationGeneration))
+        mIncrementalHessian0 = std::make_unique<IncrementalHessian>(rAssemblyPattern, GetDofStatus(), elements,
+                                                                    geometryGeneration, configurationGeneration);
+    IncrementalHessian& incrementalHessian = *mIncrementalHessian0;
+
+    // HESSIAN0 follows from the incremental hessian, the other outputs are assembled as usual
+    std::map<eStructureOutput, StructureOutputBase*> otherOutputs = rStructureOutput;
+    otherOutputs.erase(eStructureOutput::HESSIAN0);
+
+    // each element is evaluated once, with HESSIAN_0_TIME_DERIVATIVE only if its tangents changed
+    const auto createChunkFunction = [&]() {
+        auto outputs = ElementOutputMapCreate(otherOutputs);
+        auto outputsWithHessian0 = outputs;
+        outputsWithHessian0[Element::eOutput::HESSIAN_0_TIME_DERIVATIVE] =
+                std::make_shared<ElementOutputBlockMatrixDouble>(GetDofStatus());
+        return [&, outputs, outputsWithHessian0](ElementBase* const* rElements, int rNumElements) mutable {
+            for (int i = 0; i < rNumElements; ++i)
             {
-                switch (iteratorOutput.first)
-                {
-                case NuTo::eStructureOutput::HESSIAN0:
-                {
-                    elementOutputMap[Element::eOutput::HESSIAN_0_TIME_DERIVATIVE] =
-                            std::make_shared<ElementOutputBlockMatrixDouble>(GetDofStatus());
-                    break;
-                }
-                case NuTo::eStructureOutput::HESSIAN1:
-                {
-                    elementOutputMap[Element::eOutput::HESSIAN_1_TIME_DERIVATIVE] =
-                            std::make_shared<ElementOutputBlockMatrixDouble>(GetDofStatus());
-                    break;
-                }
-                case NuTo::eStructureOutput::HESSIAN2:
-                {
-                    elementOutputMap[Element::eOutput::HESSIAN_2_TIME_DERIVATIVE] =
-                            std::make_shared<ElementOutputBlockMatrixDouble>(GetDofStatus());
-                    break;
-                }
-                case NuTo::eStructureOutput::HESSIAN2_LUMPED:
-                {
-                    elementOutputMap[Element::eOutput::LUMPED_HESSIAN_2_TIME_DERIVATIVE] =
-                            std::make_shared<ElementOutputBlockVectorDouble>(GetDofStatus());
-                    break;
-                }
-                case NuTo::eStructureOutput::INTERNAL_GRADIENT:
-                {
-                    elementOutputMap[Element::eOutput::INTERNAL_GRADIENT] =
-                            std::make_shared<ElementOutputBlockVectorDouble>(GetDofStatus());
-                    break;
-                }
-                case NuTo::eStructureOutput::UPDATE_STATIC_DATA:
-                {
-                    elementOutputMap[Element::eOutput::UPDATE_STATIC_DATA] = std::make_shared<ElementOutputDummy>();
-                    break;
-                }
-                default:
-                {
-                    throw NuTo::Exception(std::string("[") + __PRETTY_FUNCTION__ +
-                                          std::string("] Output request not implemented."));
-                }
-                }
+                ElementBase& element = *rElements[i];
+                // the tangent states are updated in any case
+                const bool isHessian0Unchanged =
+                        element.UpdateTangentStates(rInput) and incrementalHessian.HasElementHessian(element);
+                if (isHessian0Unchanged and outputs.empty())
+                    continue;
+                auto& elementOutput = isHessian0Unchanged ? outputs : outputsWithHessian0;
+                element.Evaluate(rInput, elementOutput);
+                ElementOutputAssemble(&element, elementOutput, otherOutputs, &rAssemblyPattern);
+                if (not isHessian0Unchanged)
+                    incrementalHessian.UpdateElementHessian(
+                            element,
+                            elementOutput.at(Element::eOutput::HESSIAN_0_TIME_DERIVATIVE)->GetBlockFullMatrixDouble());
             }
-            // calculate element contribution
-            elementOutputMap[Element::eOutput::GLOBAL_ROW_DOF] =
-                    std::make_shared<ElementOutputBlockVectorInt>(GetDofStatus());
-            elementOutputMap[Element::eOutput::GLOBAL_COLUMN_DOF] =
-                    std::make_shared<ElementOutputBlockVectorInt>(GetDofStatus());
-#ifdef _OPENMP
-            for (auto elementIter = this->mMIS[misCounter].begin(); elementIter != this->mMIS[misCounter].end();
-                 elementIter++)
-            {
-#pragma omp single nowait
-                {
-                    ElementBase* elementPtr = *elementIter;
-                    // in OpenMP, exceptions may not leave the parallel region
-                    try
-                    {
-                        elementPtr->Evaluate(rInput, elementOutputMap);
-                    }
-                    catch (std::exception& e)
-                    {
-                        exceptionMessage = e.what();
-                    }
+        };
+    };
 
+#ifdef _OPENMP
+    // the elements of an independent set have no common dofs, their updates of the outputs do not overlap
+    ForEachIndependentSetChunk(createChunkFunction);
 #else
-    for (auto elementIter : this->mElementMap)
-    {
-        ElementBase* elementPtr = elementIter->second;
-        elementPtr->Evaluate(rInput, elementOutputMap);
+    createChunkFunction()(elements.data(), elements.size());
 #endif
 
-                    const auto& elementVectorGlobalDofsRow =
-                            elementOutputMap.at(Element::eOutput::GLOBAL_ROW_DOF)->GetBlockFullVectorInt();
-                    const auto& elementVectorGlobalDofsColumn =
-                            elementOutputMap.at(Element::eOutput::GLOBAL_COLUMN_DOF)->GetBlockFullVectorInt();
+    incrementalHessian.AddTo(rStructureOutput.at(eStructureOutput::HESSIAN0)->AsStructureOutputBlockMatrix());
+}
 
-                    for (auto& iteratorOutput : rStructureOutput)
-                    {
-                        StructureOutputBase* structureOutput = iteratorOutput.second;
 
-                        switch (iteratorOutput.first)
+#ifdef _OPENMP
+void NuTo::Structure::EvaluateThreadLocal(const NuTo::ConstitutiveInputMap& rInput,
+                                          std::map<eStructureOutput, StructureOutputBase*>& rStructureOutput,
+                                          const AssemblyPattern* rAssemblyPattern)
+{
+    std::vector<ElementBase*> elements;
+    GetElementsTotalInAssemblyOrder(elements);
+    const int numElements = elements.size();
+
+    std::string exceptionMessage = "";
+    // set before the first barrier and only read after it, unlike the exception message
+    bool allocationFailed = false;
+
+    // structure outputs of each thread, thread 0 assembles directly into rStructureOutput
+    std::vector<std::map<eStructureOutput, StructureOutputBase*>> threadOutputs;
+    int numThreads = 1;
+
+#pragma omp parallel shared(rStructureOutput, exceptionMessage, allocationFailed, threadOutputs, numThreads)
+    {
+#pragma omp single
+        {
+            numThreads = omp_get_num_threads();
+            threadOutputs.resize(numThreads, rStructureOutput);
+            if (static_cast<int>(mThreadLocalOutputs.size()) < numThreads)
+                mThreadLocalOutputs.resize(numThreads);
+        } // implicit barrier
+
+        const int thread = omp_get_thread_num();
+        try
+        {
+            // allocated by the thread itself in the first evaluation to place the memory close to it. The patterns of
+            // the matrices are kept, only their values are set to zero.
+            auto& outputs = mThreadLocalOutputs[thread];
+            if (thread != 0)
+                for (auto& output : threadOutputs[thread])
+                {
+                    auto itOutput = outputs.find(output.first);
+                    if (itOutput == outputs.end())
+                    {
+                        std::unique_ptr<StructureOutputBase> threadOutput;
+                        switch (output.first)
                         {
                         case NuTo::eStructureOutput::HESSIAN0:
-                        {
-                            const auto& elementMatrix =
-                                    elementOutputMap.at(Element::eOutput::HESSIAN_0_TIME_DERIVATIVE)
-                                            ->GetBlockFullMatrixDouble();
-                            structureOutput->AsStructureOutputBlockMatrix().AddElementMatrix(
-                                    elementPtr, elementMatrix, elementVectorGlobalDofsRow,
-                                    elementVectorGlobalDofsColumn, mToleranceStiffnessEntries);
-                            break;
-                        }
                         case NuTo::eStructureOutput::HESSIAN1:
-                        {
-                            const auto& elementMatrix =
-                                    elementOutputMap.at(Element::eOutput::HESSIAN_1_TIME_DERIVATIVE)
-                                            ->GetBlockFullMatrixDouble();
-                            structureOutput->AsStructureOutputBlockMatrix().AddElementMatrix(
-                                    elementPtr, elementMatrix, elementVectorGlobalDofsRow,
-                                    elementVectorGlobalDofsColumn, mToleranceStiffnessEntries);
-                            break;
-                        }
-
                         case NuTo::eStructureOutput::HESSIAN2:
-                        {
-                            const auto& elementMatrix =
-                                    elementOutputMap.at(Element::eOutput::HESSIAN_2_TIME_DERIVATIVE)
-                                            ->GetBlockFullMatrixDouble();
-                            structureOutput->AsStructureOutputBlockMatrix().AddElementMatrix(
-                                    elementPtr, elementMatrix, elementVectorGlobalDofsRow,
-                                    elementVectorGlobalDofsColumn, mToleranceStiffnessEntries);
-                            // since its most likely only needed once,
-                            // and causes troubles in the test files.
+                        case NuTo::eStructureOutput::HESSIAN2_LUMPED:
+                            threadOutput.reset(new StructureOutputBlockMatrix(GetDofStatus(), true));
                             break;
+                        case NuTo::eStructureOutput::INTERNAL_GRADIENT:
+                            threadOutput.reset(new StructureOutputBlockVector(GetDofStatus(), true));
+                            break;
+                        default:
+                            continue; // no assembled data, the global output is used
                         }
+                        itOutput = outputs.emplace(output.first, std::move(threadOutput)).first;
+                    }
+                    StructureOutputBase& threadOutput = *itOutput->second;
+                    threadOutput.SetZero();
+                    if (rAssemblyPattern != nullptr and (output.first == NuTo::eStructureOutput::HESSIAN0 or
+                                                         output.first == NuTo::eStructureOutput::HESSIAN1 or
+                                                         output.first == NuTo::eStructureOutput::HESSIAN2))
+                        rAssemblyPattern->InitializeMatrix(threadOutput.AsStructureOutputBlockMatrix());
+                    output.second = &threadOutput;
+                }
+        }
+        catch (std::exception& e)
+        {
+#pragma omp critical(StructureEvaluateException)
+            {
+                exceptionMessage = e.what();
+                allocationFailed = true;
+            }
+        }
 
-                        case NuTo::eStructureOutput::HESSIAN2_LUMPED:
-                        {
-                            const auto& elementVector =
-                                    elementOutputMap.at(Element::eOutput::LUMPED_HESSIAN_2_TIME_DERIVATIVE)
-                                            ->GetBlockFullVectorDouble();
+#pragma omp barrier
+        // the outputs of all threads are available. The flag is not written after the barrier, so all threads agree on
+        // it and take part in the same reduction steps below.
+        const bool allocated = not allocationFailed;
 
-                            structureOutput->AsStructureOutputBlockMatrix().AddElementVectorDiagonal(
-                                    elementVector, elementVectorGlobalDofsRow, mToleranceStiffnessEntries);
-                            break;
-                        }
+        // each thread evaluates a fixed range of consecutive elements. Together with the fixed reduction order
+        // below, this gives identical results in every run with the same number of threads.
+        const int elementBegin = (static_cast<long>(numElements) * thread) / numThreads;
+        const int elementEnd = (static_cast<long>(numElements) * (thread + 1)) / numThreads;
+        if (allocated)
+        {
+            // in OpenMP, exceptions may not leave the parallel region
+            try
+            {
+                ElementBatch elementBatch([&]() { return ElementOutputMapCreate(rStructureOutput); },
+                                          mUseElementBatches);
+                elementBatch.Evaluate(rInput, elements.data() + elementBegin, elementEnd - elementBegin,
+                                      [&](ElementBase& rElement, ElementBatch::ElementOutputMap& rElementOutputMap) {
+                                          ElementOutputAssemble(&rElement, rElementOutputMap, threadOutputs[thread],
+                                                                rAssemblyPattern);
+                                      });
+            }
+            catch (std::exception& e)
+            {
+#pragma omp critical(StructureEvaluateException)
+                exceptionMessage = e.what();
+            }
+        }
 
-                        case NuTo::eStructureOutput::INTERNAL_GRADIENT:
+        // pairwise (tree) reduction, thread i adds the outputs of thread i + stride. After log2(numThreads) steps, the
+        // sum of all outputs is stored in the outputs of thread 0.
+        for (int stride = 1; stride < numThreads; stride *= 2)
+        {
+#pragma omp barrier
+            if (allocated and thread % (2 * stride) == 0 and thread + stride < numThreads)
+            {
+                try
+                {
+                    for (auto& output : threadOutputs[thread])
+                    {
+                        StructureOutputBase* otherOutput = threadOutputs[thread + stride].at(output.first);
+                        switch (output.first)
                         {
-                            const auto& elementVector = elementOutputMap.at(Element::eOutput::INTERNAL_GRADIENT)
-                                                                ->GetBlockFullVectorDouble();
-
-                            structureOutput->AsStructureOutputBlockVector().AddElementVector(
-                                    elementVector, elementVectorGlobalDofsRow);
+                        case NuTo::eStructureOutput::HESSIAN0:
+                        case NuTo::eStructureOutput::HESSIAN1:
+                        case NuTo::eStructureOutput::HESSIAN2:
+                            if (rAssemblyPattern != nullptr)
+                            {
+                                // identical patterns, the values are added entry by entry
+                                rAssemblyPattern->AddMatrix(output.second->AsStructureOutputBlockMatrix(),
+                                                            otherOutput->AsStructureOutputBlockMatrix());
+                                break;
+                            }
+                        // fall through
+                        case NuTo::eStructureOutput::HESSIAN2_LUMPED:
+                            output.second->AsStructureOutputBlockMatrix().AddScal(
+                                    otherOutput->AsStructureOutputBlockMatrix(), 1.);
                             break;
-                        }
-
-                        case NuTo::eStructureOutput::UPDATE_STATIC_DATA:
+                        case NuTo::eStructureOutput::INTERNAL_GRADIENT:
+                            output.second->AsStructureOutputBlockVector() += otherOutput->AsStructureOutputBlockVector();
                             break;
-
                         default:
-                        {
-                            throw NuTo::Exception(__PRETTY_FUNCTION__, StructureOutputToString(iteratorOutput.first) +
-                                                                               " requested but not implemented.");
-                        }
+                            break;
                         }
                     }
-
-#ifdef _OPENMP
                 }
-            } // end loop over elements
-        } // end parallel region
-    } // end loop over independent sets
+                catch (std::exception& e)
+                {
+#pragma omp critical(StructureEvaluateException)
+                    exceptionMessage = e.what();
+                }
+            }
+        }
+    } // end parallel region
 
     if (exceptionMessage != "")
         throw Exception(exceptionMessage);
-#else
-    } // end loop over elements
-#endif
+}
+#endif // _OPENMP
+
+
+const NuTo::AssemblyPattern*
+NuTo::Structure::AssemblyPatternPrepare(std::map<eStructureOutput, StructureOutputBase*>& rStructureOutput)
+{
+    if (not mUseAssemblyPattern)
+        return nullptr;
+
+    std::vector<StructureOutputBlockMatrix*> hessians;
+    for (auto iteratorOutput : rStructureOutput)
+        if (iteratorOutput.first == eStructureOutput::HESSIAN0 or iteratorOutput.first == eStructureOutput::HESSIAN1 or
+            iteratorOutput.first == eStructureOutput::HESSIAN2)
+            hessians.push_back(&iteratorOutput.second->AsStructureOutputBlockMatrix());
+
+    if (hessians.empty())
+        return nullptr;
+
+    if (mAssemblyPattern == nullptr or not mAssemblyPattern->IsValid(GetDofStatus()))
+    {
+        Timer timer(__FUNCTION__, GetShowTime(), GetLogger());
+
+        ClearAssemblyPattern();
+        mAssemblyPattern = std::make_unique<AssemblyPattern>(GetDofStatus());
+
+        const ElementDofTable& elementDofTable = GetElementDofTable();
+        for (auto elementIter : this->mElementMap)
+        {
+            const ElementBase* elementPtr = elementIter->second;
+            mAssemblyPattern->AddElement(elementPtr, elementDofTable.GetRowDofs(*elementPtr),
+                                         elementDofTable.GetColumnDofs(*elementPtr));
+        }
+        mAssemblyPattern->Finalize();
+    }
+
+    for (auto hessian : hessians)
+        mAssemblyPattern->InitializeMatrix(*hessian);
+
+    return mAssemblyPattern.get();
+}
+
+
+std::map<NuTo::Element::eOutput, std::shared_ptr<NuTo::ElementOutputBase>>
+NuTo::Structure::ElementOutputMapCreate(const std::map<eStructureOutput, StructureOutputBase*>& rStructureOutput) const
+{
+    std::map<Element::eOutput, std::shared_ptr<ElementOutputBase>> elementOutputMap;
+
+    // allocate element outputs and resize the structure outputs
+    for (auto iteratorOutput : rStructureOutput)
+    {
+        switch (iteratorOutput.first)
+        {
+        case NuTo::eStructureOutput::HESSIAN0:
+        {
+            elementOutputMap[Element::eOutput::HESSIAN_0_TIME_DERIVATIVE] =
+                    std::make_shared<ElementOutputBlockMatrixDouble>(GetDofStatus());
+            break;
+        }
+        case NuTo::eStructureOutput::HESSIAN1:
+        {
+            elementOutputMap[Element::eOutput::HESSIAN_1_TIME_DERIVATIVE] =
+                    std::make_shared<ElementOutputBlockMatrixDouble>(GetDofStatus());
+            break;
+        }
+        case NuTo::eStructureOutput::HESSIAN2:
+        {
+            elementOutputMap[Element::eOutput::HESSIAN_2_TIME_DERIVATIVE] =
+                    std::make_shared<ElementOutputBlockMatrixDouble>(GetDofStatus());
+            break;
+        }
+        case NuTo::eStructureOutput::HESSIAN2_LUMPED:
+        {
+            elementOutputMap[Element::eOutput::LUMPED_HESSIAN_2_TIME_DERIVATIVE] =
+                    std::make_shared<ElementOutputBlockVectorDouble>(GetDofStatus());
+            break;
+        }
+        case NuTo::eStructureOutput::INTERNAL_GRADIENT:
+        {
+            elementOutputMap[Element::eOutput::INTERNAL_GRADIENT] =
+                    std::make_shared<ElementOutputBlockVectorDouble>(GetDofStatus());
+            break;
+        }
+        case NuTo::eStructureOutput::UPDATE_STATIC_DATA:
+        {
+            elementOutputMap[Element::eOutput::UPDATE_STATIC_DATA] = std::make_shared<ElementOutputDummy>();
+            break;
+        }
+        default:
+        {
+            throw NuTo::Exception(std::string("[") + __PRETTY_FUNCTION__ +
+                                  std::string("] Output request not implemented."));
+        }
+        }
+    }
+    return elementOutputMap;
+}
+
+
+void NuTo::Structure::ElementOutputAssemble(
+        const ElementBase* rElementPtr,
+        const std::map<Element::eOutput, std::shared_ptr<ElementOutputBase>>& rElementOutputMap,
+        std::map<eStructureOutput, StructureOutputBase*>& rStructureOutput,
+        const AssemblyPattern* rAssemblyPattern) const
+{
+    // the table is updated before the elements are evaluated, the read access is thread safe
+    const auto& elementVectorGlobalDofsRow = mElementDofTable->GetRowDofs(*rElementPtr);
+    const auto& elementVectorGlobalDofsColumn = mElementDofTable->GetColumnDofs(*rElementPtr);
+
+    for (auto& iteratorOutput : rStructureOutput)
+    {
+        StructureOutputBase* structureOutput = iteratorOutput.second;
+
+        switch (iteratorOutput.first)
+        {
+        case NuTo::eStructureOutput::HESSIAN0:
+        {
+            const auto& elementMatrix =
+                    rElementOutputMap.at(Element::eOutput::HESSIAN_0_TIME_DERIVATIVE)->GetBlockFullMatrixDouble();
+            if (rAssemblyPattern != nullptr)
+                rAssemblyPattern->AddElementMatrix(rElementPtr, elementMatrix,
+                                                   structureOutput->AsStructureOutputBlockMatrix());
+            else
+                structureOutput->AsStructureOutputBlockMatrix().AddElementMatrix(
+                        rElementPtr, elementMatrix, elementVectorGlobalDofsRow, elementVectorGlobalDofsColumn,
+                        mToleranceStiffnessEntries);
+            break;
+        }
+        case NuTo::eStructureOutput::HESSIAN1:
+        {
+            const auto& elementMatrix =
+                    rElementOutputMap.at(Element::eOutput::HESSIAN_1_TIME_DERIVATIVE)->GetBlockFullMatrixDouble();
+            if (rAssemblyPattern != nullptr)
+                rAssemblyPattern->AddElementMatrix(rElementPtr, elementMatrix,
+                                                   structureOutput->AsStructureOutputBlockMatrix());
+            else
+                structureOutput->AsStructureOutputBlockMatrix().AddElementMatrix(
+                        rElementPtr, elementMatrix, elementVectorGlobalDofsRow, elementVectorGlobalDofsColumn,
+                        mToleranceStiffnessEntries);
+            break;
+        }
+
+        case NuTo::eStructureOutput::HESSIAN2:
+        {
+            const auto& elementMatrix =
+                    rElementOutputMap.at(Element::eOutput::HESSIAN_2_TIME_DERIVATIVE)->GetBlockFullMatrixDouble();
+            if (rAssemblyPattern != nullptr)
+                rAssemblyPattern->AddElementMatrix(rElementPtr, elementMatrix,
+                                                   structureOutput->AsStructureOutputBlockMatrix());
+            else
+                structureOutput->AsStructureOutputBlockMatrix().AddElementMatrix(
+                        rElementPtr, elementMatrix, elementVectorGlobalDofsRow, elementVectorGlobalDofsColumn,
+                        mToleranceStiffnessEntries);
+            // since its most likely only needed once,
+            // and causes troubles in the test files.
+            break;
+        }
+
+        case NuTo::eStructureOutput::HESSIAN2_LUMPED:
+        {
+            const auto& elementVector = rElementOutputMap.at(Element::eOutput::LUMPED_HESSIAN_2_TIME_DERIVATIVE)
+                                                ->GetBlockFullVectorDouble();
+
+            structureOutput->AsStructureOutputBlockMatrix().AddElementVectorDiagonal(
+                    elementVector, elementVectorGlobalDofsRow, mToleranceStiffnessEntries);
+            break;
+        }
+
+        case NuTo::eStructureOutput::INTERNAL_GRADIENT:
+        {
+            const auto& elementVector =
+                    rElementOutputMap.at(Element::eOutput::INTERNAL_GRADIENT)->GetBlockFullVectorDouble();
+
+            structureOutput->AsStructureOutputBlockVector().AddElementVector(elementVector,
+                                                                             elementVectorGlobalDofsRow);
+            break;
+        }
+
+        case NuTo::eStructureOutput::UPDATE_STATIC_DATA:
+            break;
+
+        default:
+        {
+            throw NuTo::Exception(__PRETTY_FUNCTION__, StructureOutputToString(iteratorOutput.first) +
+                                                               " requested but not implemented.");
+        }
+        }
+    }
 }
 
 
@@ -430,12 +715,10 @@ void NuTo::Structure::NuToSerializeSave(SerializeStreamOut& rStream)
         rStream.Separator();
     }
 
-    // serialize element static data
-    std::vector<ElementBase*> elements;
-    GetElementsTotal(elements);
-    for (ElementBase* element : elements)
+    // serialize element static data, in the order of the ids
+    for (auto it = mElementMap.begin(); it != mElementMap.end(); ++it)
     {
-        rStream << element->GetIPData();
+        rStream << it->second->GetIPData();
         rStream.Separator();
     }
 }
@@ -453,12 +736,10 @@ void NuTo::Structure::NuToSerializeLoad(SerializeStreamIn& rStream)
         NodeMergeDofValues(i, nodalValues.J, nodalValues.K);
     }
 
-    // serialize element static data
-    std::vector<ElementBase*> elements;
-    GetElementsTotal(elements);
-    for (ElementBase* element : elements)
+    // serialize element static data, in the order of the ids
+    for (auto it = mElementMap.begin(); it != mElementMap.end(); ++it)
     {
-        rStream >> element->GetIPData();
+        rStream >> it->second->GetIPData();
         rStream.Separator();
     }
 }
@@ -2,12 +2,15 @@
 
 
 #include "mechanics/structures/StructureBase.h"
+#include "mechanics/structures/unstructured/IndexedPtrMap.h"
 #include <set>
 
 
 namespace NuTo
 {
 
+class AssemblyPattern;
+class ElementOutputBase;
 
 namespace Interpolation
 {
@@ -525,6 +528,78 @@ public:
 
 protected:
 #ifndef SWIG
+    //! @brief evaluates all elements and assembles their outputs
+    //! @param rInput ... input map
+    //! @param rStructureOutput ... structure outputs, already set to zero
+    //! @param rAssemblyPattern ... assembly pattern for the hessians, nullptr if not used
+    void EvaluateElements(const ConstitutiveInputMap& rInput,
+                          std::map<eStructureOutput, StructureOutputBase*>& rStructureOutput,
+                          const AssemblyPattern* rAssemblyPattern);
+
+    //! @brief returns true, if HESSIAN0 can be assembled incrementally, see StructureBase::SetUseIncrementalHessian0
+    //! @param rStructureOutput ... requested structure outputs
+    //! @param rAssemblyPattern ... assembly pattern for the hessians, nullptr if not used
+    bool IsIncrementalHessian0Applicable(const std::map<eStructureOutput, StructureOutputBase*>& rStructureOutput,
+                                         const AssemblyPattern* rAssemblyPattern) const;
+
+    //! @brief evaluates all elements once, assembles the outputs other than HESSIAN0 and updates the incremental
+    //! HESSIAN0 by the elements whose tangents changed, see IncrementalHessian
+    //! @remark the elements are always processed by the maximum independent sets, also for
+    //! eParallelAssembly::THREAD_LOCAL
+    //! @param rInput ... input map
+    //! @param rStructureOutput ... structure outputs including HESSIAN0, already set to zero and initialized with the
+    //! assembly pattern
+    //! @param rAssemblyPattern ... assembly pattern
+    void EvaluateElementsIncremental(const ConstitutiveInputMap& rInput,
+                                     std::map<eStructureOutput, StructureOutputBase*>& rStructureOutput,
+                                     const AssemblyPattern& rAssemblyPattern);
+
+#ifdef _OPENMP
+    //! @brief parallel evaluation without element coloring (eParallelAssembly::THREAD_LOCAL)
+    //! @remark each thread assembles a fixed range of elements into its own structure outputs, these are summed up
+    //! pairwise in a fixed order
+    //! @param rInput ... input map
+    //! @param rStructureOutput ... structure outputs, already set to zero
+    //! @param rAssemblyPattern ... assembly pattern for the hessians, nullptr if not used
+    void EvaluateThreadLocal(const ConstitutiveInputMap& rInput,
+                             std::map<eStructureOutput, StructureOutputBase*>& rStructureOutput,
+                             const AssemblyPattern* rAssemblyPattern);
+#endif // _OPENMP
+
+    //! @brief order of the elements in the assembly loops, see GetElementsTotalInAssemblyOrder
+    //! @remark Elements of the same type and interpolation type are stored consecutively, in the order of the first
+    //! element of each type. Within a type, the elements follow a Morton curve through their centers. This improves
+    //! the memory locality of the node and element data and the size of the element batches.
+    //! @param rElements ... all elements, in the order of their ids
+    //! @return elements in their new order, see IndexedPtrMap::Ordering
+    std::vector<int> ElementLocalityOrdering(const std::vector<ElementBase*>& rElements) const;
+
+    //! @brief orders the nodes for the global dof numbering, see StructureBase::SetDofOrdering
+    //! @param rNodes ... all nodes of the structure, reordered in place
+    void NodeOrderForDofNumbering(std::vector<NodeBase*>& rNodes) const;
+
+    //! @brief symbolic phase of the hessian assembly, see StructureBase::SetUseAssemblyPattern
+    //! @remark (re)builds the assembly pattern if required and initializes the requested hessians with it
+    //! @param rStructureOutput ... requested structure outputs
+    //! @return assembly pattern, nullptr if not used or if no hessian is requested
+    const AssemblyPattern* AssemblyPatternPrepare(std::map<eStructureOutput, StructureOutputBase*>& rStructureOutput);
+
+    //! @brief allocates the element outputs required to calculate the requested structure outputs
+    //! @param rStructureOutput ... requested structure outputs
+    //! @return element output map, the global dof numbers are taken from the element dof table
+    std::map<Element::eOutput, std::shared_ptr<ElementOutputBase>>
+    ElementOutputMapCreate(const std::map<eStructureOutput, StructureOutputBase*>& rStructureOutput) const;
+
+    //! @brief adds the evaluated element outputs of one element to the structure outputs
+    //! @remark the dof numbers of the element have to be in the element dof table
+    //! @param rElementPtr ... element
+    //! @param rElementOutputMap ... evaluated element outputs, see ElementOutputMapCreate
+    //! @param rStructureOutput ... structure outputs
+    //! @param rAssemblyPattern ... assembly pattern for the hessians, nullptr if not used
+    void ElementOutputAssemble(const ElementBase* rElementPtr,
+                               const std::map<Element::eOutput, std::shared_ptr<ElementOutputBase>>& rElementOutputMap,
+                               std::map<eStructureOutput, StructureOutputBase*>& rStructureOutput,
+                               const AssemblyPattern* rAssemblyPattern) const;
 #endif
 
 #ifndef SWIG
@@ -541,6 +616,10 @@ protected:
     //! @param rElements ... vector of element pointer
     void GetElementsTotal(std::vector<ElementBase*>& rElements) override;
 
+    //! @brief ... store all elements of a structure in a vector, in the order of ElementLocalityOrdering
+    //! @param rElements ... vector of element pointer
+    void GetElementsTotalInAssemblyOrder(std::vector<ElementBase*>& rElements) override;
+
     //! @brief ... store all elements of a structure in a vector
     //! @param rElements ... vector of element pointer
     void GetElementsTotal(std::vector<std::pair<int, ElementBase*>>& rElements) override;
@@ -562,12 +641,18 @@ protected:
     void GetNodesTotal(std::vector<std::pair<int, NodeBase*>>& rNodes) override;
 #endif
 
+    //! @brief returns the sum of the revisions of the node and the element map
+    unsigned long GetMeshRevision() const override;
+
     //! @brief deletes a node
     //! @param rNodeNumber ... node number
     //! @param checkElements ... check the elements, if set to false, make sure that the node is not part of any element
     void NodeDelete(int rNodeNumber, bool checkElements);
 
-    boost::ptr_map<int, NodeBase> mNodeMap;
-    boost::ptr_map<int, ElementBase> mElementMap;
+    //! @brief nodes, indexed in the order of their ids
+    IndexedPtrMap<NodeBase> mNodeMap;
+
+    //! @brief elements, indexed in the order of their ids and ordered by ElementLocalityOrdering for the assembly
+    IndexedPtrMap<ElementBase> mElementMap;
 };
 } // namespace NuTo
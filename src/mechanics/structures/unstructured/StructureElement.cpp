@@ -1,9 +1,14 @@
 #include <cassert>
+#include <map>
+#include <numeric>
+#include <typeindex>
 #include <typeinfo>
 
 #include "base/Timer.h"
+#include "math/GraphOrdering.h"
 
 #include "mechanics/structures/unstructured/Structure.h"
+#include "mechanics/structures/ElementDofTable.h"
 #include "mechanics/elements/ContinuumElement.h"
 #include "mechanics/elements/ContinuumElementIGA.h"
 #include "mechanics/elements/ContinuumBoundaryElement.h"
@@ -64,12 +69,10 @@ const NuTo::ElementBase* NuTo::Structure::ElementGetElementPtr(int rIdent) const
 //! @return element number
 int NuTo::Structure::ElementGetId(const ElementBase* rElement) const
 {
-    for (boost::ptr_map<int, ElementBase>::const_iterator it = mElementMap.begin(); it != mElementMap.end(); it++)
-    {
-        if (it->second == rElement)
-            return it->first;
-    }
-    throw Exception(__PRETTY_FUNCTION__, "Element does not exist.");
+    int id = mElementMap.GetId(rElement);
+    if (id == -1)
+        throw Exception(__PRETTY_FUNCTION__, "Element does not exist.");
+    return id;
 }
 
 //! @brief returns a vector with the node ids of an element
@@ -145,22 +148,26 @@ void NuTo::Structure::ElementTotalSetInterpolationType(const int rInterpolationT
 
     for (const auto& elementPair : mElementMap)
         ElementSetInterpolationType(elementPair.second, itInterpolationType->second);
+    mElementMap.InvalidateOrdering();
 }
 
 void NuTo::Structure::ElementTotalConvertToInterpolationType()
 {
     MeshCompanion::ElementTotalConvertToInterpolationType(*this);
+    mElementMap.InvalidateOrdering();
 }
 
 void NuTo::Structure::ElementConvertToInterpolationType(int rGroupNumberElements)
 {
     MeshCompanion::ElementConvertToInterpolationType(*this, rGroupNumberElements);
+    mElementMap.InvalidateOrdering();
 }
 
 void NuTo::Structure::ElementTotalConvertToInterpolationType(double rNodeDistanceMerge, double rMeshSize)
 {
     (void)rMeshSize; // unsused
     MeshCompanion::ElementTotalConvertToInterpolationType(*this, rNodeDistanceMerge);
+    mElementMap.InvalidateOrdering();
 }
 
 void NuTo::Structure::ElementConvertToInterpolationType(int rGroupNumberElements, double rNodeDistanceMerge,
@@ -168,6 +175,7 @@ void NuTo::Structure::ElementConvertToInterpolationType(int rGroupNumberElements
 {
     (void)rMeshSize; // unsused
     MeshCompanion::ElementConvertToInterpolationType(*this, rGroupNumberElements, rNodeDistanceMerge);
+    mElementMap.InvalidateOrdering();
 }
 
 
@@ -258,7 +266,11 @@ void NuTo::Structure::ElementCreate(int rElementNumber, int rInterpolationTypeId
         throw Exception(__PRETTY_FUNCTION__, "invalid dimension.");
     }
 
+    ptrElement->SetStructureGeneration(&mGeneration);
+    ptrElement->SetUseGeometryCache(mUseGeometryCache);
     mElementMap.insert(rElementNumber, ptrElement);
+    ClearMaximumIndependentSets();
+    ClearAssemblyPattern();
 }
 
 void NuTo::Structure::ElementCreate(int elementNumber, int interpolationTypeId, const std::vector<int>& rNodeNumbers)
@@ -330,7 +342,11 @@ void NuTo::Structure::ElementCreate(int rElementNumber, int rInterpolationTypeId
         throw Exception(__PRETTY_FUNCTION__, "invalid dimension.");
     }
 
+    ptrElement->SetStructureGeneration(&mGeneration);
+    ptrElement->SetUseGeometryCache(mUseGeometryCache);
     mElementMap.insert(rElementNumber, ptrElement);
+    ClearMaximumIndependentSets();
+    ClearAssemblyPattern();
 }
 
 
@@ -549,7 +565,10 @@ int NuTo::Structure::BoundaryElementsCreate(int rElementGroupId, int rNodeGroupI
                                                              "not implemented");
             }
 
+            boundaryElement->SetStructureGeneration(&mGeneration);
             mElementMap.insert(elementId, boundaryElement);
+            ClearMaximumIndependentSets();
+            ClearAssemblyPattern();
             newBoundaryElementIds.push_back(elementId);
 
             boundaryElement->SetConstitutiveLaw(constitutiveLaw);
@@ -726,58 +745,84 @@ void NuTo::Structure::ElementDeleteInternal(int rElementId)
         }
 
         // delete element from map
+        mElementDofTable->Remove(*itElement->second);
         this->mElementMap.erase(itElement);
+        ClearMaximumIndependentSets();
+        ClearAssemblyPattern();
     }
 }
 
 // store all elements of a structure in a vector
 void NuTo::Structure::GetElementsTotal(std::vector<const ElementBase*>& rElements) const
 {
-    rElements.reserve(mElementMap.size());
-    rElements.resize(0);
-    boost::ptr_map<int, ElementBase>::const_iterator ElementIter = this->mElementMap.begin();
-    while (ElementIter != this->mElementMap.end())
-    {
-        rElements.push_back(ElementIter->second);
-        ElementIter++;
-    }
+    const auto& elements = mElementMap.GetObjects();
+    rElements.assign(elements.begin(), elements.end());
 }
 
 // store all elements of a structure in a vector
 void NuTo::Structure::GetElementsTotal(std::vector<std::pair<int, const ElementBase*>>& rElements) const
 {
-    rElements.reserve(mElementMap.size());
-    rElements.resize(0);
-    boost::ptr_map<int, ElementBase>::const_iterator ElementIter = this->mElementMap.begin();
-    while (ElementIter != this->mElementMap.end())
-    {
-        rElements.push_back(std::pair<int, const ElementBase*>(ElementIter->first, ElementIter->second));
-        ElementIter++;
-    }
+    const auto& elements = mElementMap.GetObjects();
+    const auto& ids = mElementMap.GetObjectIds();
+    rElements.resize(elements.size());
+    for (unsigned int i = 0; i < elements.size(); ++i)
+        rElements[i] = std::pair<int, const ElementBase*>(ids[i], elements[i]);
 }
 
 // store all elements of a structure in a vector
 void NuTo::Structure::GetElementsTotal(std::vector<ElementBase*>& rElements)
 {
-    rElements.reserve(mElementMap.size());
-    rElements.resize(0);
-    boost::ptr_map<int, ElementBase>::iterator ElementIter = this->mElementMap.begin();
-    while (ElementIter != this->mElementMap.end())
-    {
-        rElements.push_back(ElementIter->second);
-        ElementIter++;
-    }
+    rElements = mElementMap.GetObjects();
+}
+
+void NuTo::Structure::GetElementsTotalInAssemblyOrder(std::vector<ElementBase*>& rElements)
+{
+    rElements = mElementMap.GetOrderedObjects();
 }
 
 // store all elements of a structure in a vector
 void NuTo::Structure::GetElementsTotal(std::vector<std::pair<int, ElementBase*>>& rElements)
 {
-    rElements.reserve(mElementMap.size());
-    rElements.resize(0);
-    boost::ptr_map<int, ElementBase>::iterator ElementIter = this->mElementMap.begin();
-    while (ElementIter != this->mElementMap.end())
+    const auto& elements = mElementMap.GetObjects();
+    const auto& ids = mElementMap.GetObjectIds();
+    rElements.resize(elements.size());
+    for (unsigned int i = 0; i < elements.size(); ++i)
+        rElements[i] = std::pair<int, ElementBase*>(ids[i], elements[i]);
+}
+
+std::vector<int> NuTo::Structure::ElementLocalityOrdering(const std::vector<ElementBase*>& rElements) const
+{
+    const int numElements = rElements.size();
+
+    // types in the order of their first element
+    std::vector<int> types(numElements);
+    std::map<std::pair<std::type_index, const InterpolationType*>, int> typeIndices;
+    std::vector<Eigen::VectorXd> centers(numElements);
+    for (int i = 0; i < numElements; ++i)
     {
-        rElements.push_back(std::pair<int, ElementBase*>(ElementIter->first, ElementIter->second));
-        ElementIter++;
+        const ElementBase& element = *rElements[i];
+        auto type = std::make_pair(std::type_index(typeid(element)), &element.GetInterpolationType());
+        types[i] = typeIndices.emplace(type, typeIndices.size()).first->second;
+
+        centers[i] = Eigen::VectorXd::Zero(GetDimension());
+        int numCoordinateNodes = 0;
+        for (int iNode = 0; iNode < element.GetNumNodes(Node::eDof::COORDINATES); ++iNode)
+        {
+            const NodeBase& node = *element.GetNode(iNode, Node::eDof::COORDINATES);
+            if (node.GetNum(Node::eDof::COORDINATES) != GetDimension())
+                continue;
+            centers[i] += node.Get(Node::eDof::COORDINATES);
+            ++numCoordinateNodes;
+        }
+        if (numCoordinateNodes > 0)
+            centers[i] /= numCoordinateNodes;
     }
+
+    const std::vector<int> mortonPositions = GraphOrdering::Inverse(GraphOrdering::MortonCurve(centers));
+    std::vector<int> ordering(numElements);
+    std::iota(ordering.begin(), ordering.end(), 0);
+    std::sort(ordering.begin(), ordering.end(), [&](int a, int b) {
+        return std::make_pair(types[a], mortonPositions[a]) < std::make_pair(types[b], mortonPositions[b]);
+    });
+    return ordering;
 }
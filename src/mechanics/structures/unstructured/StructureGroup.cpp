@@ -26,14 +26,11 @@ void NuTo::Structure::GroupAddElementFromType(int rIdentGroup, int rInterpolatio
 
     InterpolationType* interpolationType = itInterpolationType->second;
 
-    for (boost::ptr_map<int, ElementBase>::iterator elementIter = this->mElementMap.begin();
-         elementIter != this->mElementMap.end(); elementIter++)
-    {
-        ElementBase* element = elementIter->second;
-
-        if (&element->GetInterpolationType() == interpolationType)
-            itGroup->second->AddMember(elementIter->first, elementIter->second);
-    }
+    std::vector<std::pair<int, ElementBase*>> elements;
+    for (auto const& iPair : mElementMap)
+        if (&iPair.second->GetInterpolationType() == interpolationType)
+            elements.emplace_back(iPair.first, iPair.second);
+    itGroup->second->AsGroupElement()->AddMembers(std::move(elements));
 }
 
 
@@ -60,8 +57,9 @@ void NuTo::Structure::GroupAddElementsTotal(int rIdentGroup)
     if (itGroup->second->GetType() != eGroupId::Elements)
         throw Exception(__PRETTY_FUNCTION__, "An element can be added only to an element group.");
 
-    for (auto const& iPair : mElementMap)
-        itGroup->second->AddMember(iPair.first, iPair.second);
+    std::vector<std::pair<int, ElementBase*>> elements;
+    GetElementsTotal(elements);
+    itGroup->second->AsGroupElement()->AddMembers(std::move(elements));
 }
 
 int NuTo::Structure::GroupGetElementsTotal()
@@ -69,9 +67,9 @@ int NuTo::Structure::GroupGetElementsTotal()
     Timer timer(__FUNCTION__, GetShowTime(), GetLogger());
 
     int groupId = GroupCreate(eGroupId::Elements);
-    auto& elementGroup = *(mGroupMap.at(groupId).AsGroupElement());
-    for (auto const& iPair : mElementMap)
-        elementGroup.AddMember(iPair.first, iPair.second);
+    std::vector<std::pair<int, ElementBase*>> elements;
+    GetElementsTotal(elements);
+    mGroupMap.at(groupId).AsGroupElement()->AddMembers(std::move(elements));
     return groupId;
 }
 
@@ -80,9 +78,9 @@ int NuTo::Structure::GroupGetNodesTotal()
     Timer timer(__FUNCTION__, GetShowTime(), GetLogger());
 
     int groupId = GroupCreate(eGroupId::Nodes);
-    auto& elementGroup = *(mGroupMap.at(groupId).AsGroupNode());
-    for (auto const& iPair : mNodeMap)
-        elementGroup.AddMember(iPair.first, iPair.second);
+    std::vector<std::pair<int, NodeBase*>> nodes;
+    GetNodesTotal(nodes);
+    mGroupMap.at(groupId).AsGroupNode()->AddMembers(std::move(nodes));
     return groupId;
 }
 
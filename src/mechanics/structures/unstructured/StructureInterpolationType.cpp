@@ -88,6 +88,7 @@ void NuTo::Structure::InterpolationTypeAdd(int rInterpolationTypeId, NuTo::Node:
 {
     InterpolationType* interpolationType = InterpolationTypeGet(rInterpolationTypeId);
     interpolationType->AddDofInterpolation(rDofType, rTypeOrder, rDegree, rKnots, rWeights);
+    mGeneration.IncrementConfiguration();
 
     eIntegrationType integrationTypeEnum = interpolationType->GetStandardIntegrationType();
     const IntegrationTypeBase& integrationType = *this->GetPtrIntegrationType(integrationTypeEnum);
@@ -120,6 +121,7 @@ void NuTo::Structure::InterpolationTypeAdd(
 {
     InterpolationType& interpolationType = *InterpolationTypeGet(rInterpolationTypeId);
     interpolationType.AddDofInterpolation(rDofType, rTypeOrder);
+    mGeneration.IncrementConfiguration();
 
     eIntegrationType integrationTypeEnum = interpolationType.GetStandardIntegrationType();
     const IntegrationTypeBase& integrationType = *this->GetPtrIntegrationType(integrationTypeEnum);
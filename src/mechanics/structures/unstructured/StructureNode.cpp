@@ -1,5 +1,6 @@
 #include <boost/tokenizer.hpp>
 #include <sstream>
+#include <unordered_map>
 
 #include "base/Timer.h"
 
@@ -12,12 +13,20 @@
 #include "mechanics/nodes/NodeDof.h"
 #include "mechanics/nodes/NodeEnum.h"
 #include "mechanics/structures/Assembler.h"
+#include "mechanics/structures/ElementDofTable.h"
+#include "mechanics/structures/StructureBaseEnum.h"
+#include "math/GraphOrdering.h"
 
 int NuTo::Structure::GetNumNodes() const
 {
     return mNodeMap.size();
 }
 
+unsigned long NuTo::Structure::GetMeshRevision() const
+{
+    return mNodeMap.GetRevision() + mElementMap.GetRevision();
+}
+
 NuTo::NodeBase* NuTo::Structure::NodeGetNodePtr(int rIdent)
 {
     boost::ptr_map<int, NodeBase>::iterator it = mNodeMap.find(rIdent);
@@ -46,17 +55,15 @@ const NuTo::NodeBase* NuTo::Structure::NodeGetNodePtr(int rIdent) const
 
 int NuTo::Structure::NodeGetId(const NodeBase* rNode) const
 {
-    for (boost::ptr_map<int, NodeBase>::const_iterator it = mNodeMap.begin(); it != mNodeMap.end(); it++)
-    {
-        if (it->second == rNode)
-            return it->first;
-    }
-    throw Exception("[NuTo::Structure::GetNodeId] Node does not exist.");
+    int id = mNodeMap.GetId(rNode);
+    if (id == -1)
+        throw Exception("[NuTo::Structure::GetNodeId] Node does not exist.");
+    return id;
 }
 
 const boost::ptr_map<int, NuTo::NodeBase>& NuTo::Structure::NodeGetNodeMap() const
 {
-    return mNodeMap;
+    return mNodeMap.GetMap();
 }
 
 
@@ -186,6 +193,7 @@ NuTo::NodeBase* NuTo::Structure::NodePtrCreate(std::set<Node::eDof> rDOFs, Eigen
     }
 
     nodePtr = new NodeDof(dofInfos);
+    nodePtr->SetStructureGeneration(&mGeneration);
 
     nodePtr->Set(Node::eDof::COORDINATES, rCoordinates);
     return nodePtr;
@@ -377,8 +385,81 @@ void NuTo::Structure::NodeBuildGlobalDofs(std::string)
     UpdateDofStatus();
     std::vector<NodeBase*> nodes;
     this->GetNodesTotal(nodes);
-    GetAssembler().BuildGlobalDofs(nodes);
+    NodeOrderForDofNumbering(nodes);
+    GetAssembler().BuildGlobalDofs(nodes, GetDofOrdering() != eDofOrdering::NODE_ID);
     UpdateDofStatus();
+    mElementDofTable->Clear();
+    ClearAssemblyPattern();
+}
+
+
+void NuTo::Structure::NodeOrderForDofNumbering(std::vector<NodeBase*>& rNodes) const
+{
+    std::vector<int> ordering;
+    switch (GetDofOrdering())
+    {
+    case eDofOrdering::NODE_ID:
+        return;
+    case eDofOrdering::MORTON_CURVE:
+    {
+        std::vector<Eigen::VectorXd> coordinates;
+        coordinates.reserve(rNodes.size());
+        for (const NodeBase* node : rNodes)
+        {
+            if (node->IsDof(Node::eDof::COORDINATES))
+                coordinates.push_back(node->Get(Node::eDof::COORDINATES));
+            else
+                coordinates.push_back(Eigen::VectorXd::Zero(GetDimension()));
+        }
+        ordering = GraphOrdering::MortonCurve(coordinates);
+        break;
+    }
+    case eDofOrdering::REVERSE_CUTHILL_MCKEE:
+    case eDofOrdering::NESTED_DISSECTION:
+    {
+        // nodes are adjacent, if they belong to a common element
+        std::unordered_map<const NodeBase*, int> nodeIndices;
+        nodeIndices.reserve(rNodes.size());
+        for (unsigned int i = 0; i < rNodes.size(); ++i)
+            nodeIndices[rNodes[i]] = i;
+
+        std::vector<std::vector<int>> adjacency(rNodes.size());
+        std::vector<int> elementNodes;
+        for (auto it = mElementMap.begin(); it != mElementMap.end(); ++it)
+        {
+            const ElementBase& element = *it->second;
+            elementNodes.clear();
+            for (int iNode = 0; iNode < element.GetNumNodes(); ++iNode)
+            {
+                auto itIndex = nodeIndices.find(element.GetNode(iNode));
+                if (itIndex != nodeIndices.end())
+                    elementNodes.push_back(itIndex->second);
+            }
+            for (int node : elementNodes)
+                for (int neighbor : elementNodes)
+                    if (node != neighbor)
+                        adjacency[node].push_back(neighbor);
+        }
+        for (auto& neighbors : adjacency)
+        {
+            std::sort(neighbors.begin(), neighbors.end());
+            neighbors.erase(std::unique(neighbors.begin(), neighbors.end()), neighbors.end());
+        }
+
+        if (GetDofOrdering() == eDofOrdering::REVERSE_CUTHILL_MCKEE)
+            ordering = GraphOrdering::ReverseCuthillMcKee(adjacency);
+        else
+            ordering = GraphOrdering::NestedDissection(adjacency);
+        break;
+    }
+    default:
+        throw Exception(__PRETTY_FUNCTION__, "dof ordering not implemented.");
+    }
+
+    std::vector<NodeBase*> orderedNodes(rNodes.size());
+    for (unsigned int i = 0; i < ordering.size(); ++i)
+        orderedNodes[i] = rNodes[ordering[i]];
+    rNodes.swap(orderedNodes);
 }
 
 
@@ -395,9 +476,9 @@ NuTo::StructureOutputBlockVector NuTo::Structure::NodeExtractDofValues(int rTime
 
         int numActiveDofs = GetNumActiveDofs(dofType);
 
-        for (auto it : mNodeMap)
+        for (const NodeBase* nodePtr : mNodeMap.GetObjects())
         {
-            const NodeBase& node = *it->second;
+            const NodeBase& node = *nodePtr;
             if (not node.IsDof(dofType))
                 continue;
 
@@ -434,9 +515,9 @@ void NuTo::Structure::NodeMergeDofValues(int rTimeDerivative, const NuTo::BlockF
         auto& depDofValues = rDependentDofValues[dofType];
         int numActiveDofs = GetNumActiveDofs(dofType);
 
-        for (auto it : mNodeMap)
+        for (NodeBase* nodePtr : mNodeMap.GetObjects())
         {
-            NodeBase& node = *it->second;
+            NodeBase& node = *nodePtr;
             if (not node.IsDof(dofType))
                 continue;
 
@@ -469,53 +550,34 @@ NuTo::Structure::NodeCalculateDependentDofValues(const NuTo::BlockFullVector<dou
 // store all nodes of a structure in a vector
 void NuTo::Structure::GetNodesTotal(std::vector<const NodeBase*>& rNodes) const
 {
-    rNodes.reserve(mNodeMap.size());
-    rNodes.resize(0);
-    boost::ptr_map<int, NodeBase>::const_iterator NodeIter = this->mNodeMap.begin();
-    while (NodeIter != this->mNodeMap.end())
-    {
-        rNodes.push_back(NodeIter->second);
-        NodeIter++;
-    }
+    const auto& nodes = mNodeMap.GetObjects();
+    rNodes.assign(nodes.begin(), nodes.end());
 }
 
 // store all nodes of a structure in a vector
 void NuTo::Structure::GetNodesTotal(std::vector<std::pair<int, const NodeBase*>>& rNodes) const
 {
-    rNodes.reserve(mNodeMap.size());
-    rNodes.resize(0);
-    boost::ptr_map<int, NodeBase>::const_iterator NodeIter = this->mNodeMap.begin();
-    while (NodeIter != this->mNodeMap.end())
-    {
-        rNodes.push_back(std::pair<int, const NodeBase*>(NodeIter->first, NodeIter->second));
-        NodeIter++;
-    }
+    const auto& nodes = mNodeMap.GetObjects();
+    const auto& ids = mNodeMap.GetObjectIds();
+    rNodes.resize(nodes.size());
+    for (unsigned int i = 0; i < nodes.size(); ++i)
+        rNodes[i] = std::pair<int, const NodeBase*>(ids[i], nodes[i]);
 }
 
 // store all nodes of a structure in a vector
 void NuTo::Structure::GetNodesTotal(std::vector<NodeBase*>& rNodes)
 {
-    rNodes.reserve(mNodeMap.size());
-    rNodes.resize(0);
-    boost::ptr_map<int, NodeBase>::iterator NodeIter = this->mNodeMap.begin();
-    while (NodeIter != this->mNodeMap.end())
-    {
-        rNodes.push_back(NodeIter->second);
-        NodeIter++;
-    }
+    rNodes = mNodeMap.GetObjects();
 }
 
 // store all nodes of a structure in a vector
 void NuTo::Structure::GetNodesTotal(std::vector<std::pair<int, NodeBase*>>& rNodes)
 {
-    rNodes.reserve(mNodeMap.size());
-    rNodes.resize(0);
-    boost::ptr_map<int, NodeBase>::iterator NodeIter = this->mNodeMap.begin();
-    while (NodeIter != this->mNodeMap.end())
-    {
-        rNodes.push_back(std::pair<int, NodeBase*>(NodeIter->first, NodeIter->second));
-        NodeIter++;
-    }
+    const auto& nodes = mNodeMap.GetObjects();
+    const auto& ids = mNodeMap.GetObjectIds();
+    rNodes.resize(nodes.size());
+    for (unsigned int i = 0; i < nodes.size(); ++i)
+        rNodes[i] = std::pair<int, NodeBase*>(ids[i], nodes[i]);
 }
 
 void NuTo::Structure::NodeExchangePtr(int rId, NuTo::NodeBase* rOldPtr, NuTo::NodeBase* rNewPtr,
@@ -529,6 +591,8 @@ void NuTo::Structure::NodeExchangePtr(int rId, NuTo::NodeBase* rOldPtr, NuTo::No
     }
 
     mNodeMap.insert(rId, rNewPtr);
+    rNewPtr->SetStructureGeneration(&mGeneration);
+    mGeneration.IncrementConfiguration();
 
     if (rElements.empty())
     {
@@ -560,4 +624,7 @@ void NuTo::Structure::NodeExchangePtr(int rId, NuTo::NodeBase* rOldPtr, NuTo::No
 
     // in constraints
     GetAssembler().GetConstraints().ExchangeNodePtr(*rOldPtr, *rNewPtr);
+
+    // the elements now refer to the dofs of the new node
+    mElementDofTable->Clear();
 }
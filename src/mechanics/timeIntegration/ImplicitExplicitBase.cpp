@@ -13,7 +13,8 @@
 #include "mechanics/structures/StructureBaseEnum.h"
 #include "mechanics/structures/StructureOutputBlockMatrix.h"
 #include "mechanics/structures/StructureOutputDummy.h"
-#include "math/SparseDirectSolverMUMPS.h"
+#include "mechanics/dofSubMatrixSolvers/SolverMUMPS.h"
+#include "mechanics/dofSubMatrixSolvers/SolverSupernodalLDLT.h"
 
 #include "mechanics/constitutive/ConstitutiveEnum.h"
 #include "mechanics/constitutive/inputoutput/ConstitutiveIOMap.h"
@@ -48,7 +49,7 @@ void NuTo::ImplicitExplicitBase::Solve(double rTimeDelta)
     // deactivate all dof types
     mStructure->DofTypeDeactivateAll();
 
-    std::map<Node::eDof, SparseDirectSolverMUMPS> preFactorizedHessians;
+    std::map<Node::eDof, std::unique_ptr<SolverBase>> preFactorizedHessians;
     FactorizeConstantHessians(preFactorizedHessians);
 
 
@@ -155,10 +156,9 @@ void NuTo::ImplicitExplicitBase::Solve(double rTimeDelta)
 
                 mStructure->Evaluate(input, evalInternalGradient); // internal gradient only
 
-                Eigen::VectorXd solution;
-                preFactorizedHessians[activeDof].Solution(-intForce.J[activeDof], solution);
+                const auto solution = preFactorizedHessians[activeDof]->SolveFactorized(intForce.J * (-1.));
 
-                dof_dt0.J[activeDof] += solution;
+                dof_dt0.J[activeDof] += solution[activeDof];
             }
             else
             {
@@ -235,11 +235,6 @@ void NuTo::ImplicitExplicitBase::Solve(double rTimeDelta)
         }
 
     } // end while
-
-    for (auto& itPair : preFactorizedHessians)
-    {
-        itPair.second.CleanUp();
-    }
 }
 
 double NuTo::ImplicitExplicitBase::CalculateCriticalTimeStep() const
@@ -253,7 +248,7 @@ void NuTo::ImplicitExplicitBase::AddDofWithConstantHessian0(Node::eDof rDofWithC
 }
 
 void NuTo::ImplicitExplicitBase::FactorizeConstantHessians(
-        std::map<Node::eDof, SparseDirectSolverMUMPS>& rPreFactorizedHessians)
+        std::map<Node::eDof, std::unique_ptr<SolverBase>>& rPreFactorizedHessians)
 {
     for (auto dof : mDofsWithConstantHessian)
     {
@@ -263,11 +258,13 @@ void NuTo::ImplicitExplicitBase::FactorizeConstantHessians(
 
         mStructure->DofTypeSetIsActive(dof, true);
         auto hessian0 = mStructure->BuildGlobalHessian0();
-        auto hessian0_CSR = hessian0.JJ.ExportToCSRGeneral();
-        hessian0_CSR.SetOneBasedIndexing();
 
-        rPreFactorizedHessians[dof].Factorization(hessian0_CSR);
-        rPreFactorizedHessians[dof].SetShowTime(false);
+#ifdef HAVE_MUMPS
+        rPreFactorizedHessians[dof] = std::make_unique<SolverMUMPS>(false);
+#else
+        rPreFactorizedHessians[dof] = std::make_unique<SolverSupernodalLDLT>();
+#endif
+        rPreFactorizedHessians[dof]->Factorize(hessian0.JJ);
         mStructure->DofTypeSetIsActive(dof, false);
     }
 }
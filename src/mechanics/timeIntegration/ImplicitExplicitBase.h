@@ -15,7 +15,6 @@ namespace NuTo
 {
 
 class ConstitutiveTimeStep;
-class SparseDirectSolverMUMPS;
 
 //! @brief Base class for implicit/explicit time integration schemes like ImplEx and CycleJump
 class ImplicitExplicitBase : public TimeIntegrationBase
@@ -64,7 +63,7 @@ protected:
 private:
     std::set<Node::eDof> mDofsWithConstantHessian;
 
-    void FactorizeConstantHessians(std::map<Node::eDof, SparseDirectSolverMUMPS>& rPreFactorizedHessians);
+    void FactorizeConstantHessians(std::map<Node::eDof, std::unique_ptr<SolverBase>>& rPreFactorizedHessians);
 };
 
 } /* namespace NuTo */
@@ -79,6 +79,7 @@ std::pair<int, BlockScalar> NewmarkDirect::FindEquilibrium(StructureOutputBlockV
         auto hessians = EvaluateHessians();
 
         delta_dof_dt0.J = BuildHessianModAndSolveSystem(hessians, residual, mTimeControl.GetTimeStep());
+        mLinearSolverIterationCount += mSolver->GetNumIterations();
 
         delta_dof_dt0.K = constraintMatrix * delta_dof_dt0.J * (-1.);
         ++mIterationCount;
@@ -249,6 +250,8 @@ void NewmarkDirect::PrintInfoIteration(const BlockScalar& residualNorm, int iter
     case 1:
     {
         logger << "Iteration: " << iteration << "\n";
+        if (mSolver->GetNumIterations() > 0)
+            logger << "Linear solver iterations: " << mSolver->GetNumIterations() << "\n";
         for (const auto dof : mStructure->GetDofStatus().GetActiveDofTypes())
         {
             logger << "Residual " << Node::DofToString(dof) << ": " << residualNorm[dof] << "\n";
@@ -267,6 +270,8 @@ std::array<StructureOutputBlockVector, 3> NuTo::NewmarkDirect::InitialState()
     CalculateStaticAndTimeDependentExternalLoad();
 
     mToleranceResidual.DefineDefaultValueToIninitializedDofTypes(mToleranceForce);
+    for (auto dof : mStructure->GetDofStatus().GetDofTypes())
+        mSolver->SetToleranceResidual(dof, mToleranceResidual[dof]);
 
     if (mStepActiveDofs.empty())
         mStepActiveDofs.push_back(mStructure->DofTypesGetActive());
@@ -433,7 +438,9 @@ void NewmarkDirect::IterateForActiveDofValues(const StructureOutputBlockVector&
         mStructure->GetLogger() << "\n"
                                 << "Initial trial residual:               " << residual_mod.CalculateInfNorm() << "\n";
 
+        const int linearSolverIterations = mLinearSolverIterationCount;
         delta_dof_dt0.J = BuildHessianModAndSolveSystem(hessians, residual_mod, mTimeControl.GetTimeStep());
+        mLinearSolverIterationCount += mSolver->GetNumIterations();
 
         delta_dof_dt0.K = deltaBRHS - constraintMatrix * delta_dof_dt0.J;
         ++mIterationCount;
@@ -470,6 +477,9 @@ void NewmarkDirect::IterateForActiveDofValues(const StructureOutputBlockVector&
                                     << mTimeControl.GetCurrentTime() << " (timestep " << mTimeControl.GetTimeStep()
                                     << ").\n";
             mStructure->GetLogger() << "Residual: \t" << residualNorm << "\n";
+            if (mLinearSolverIterationCount > linearSolverIterations)
+                mStructure->GetLogger() << "Linear solver iterations: "
+                                        << mLinearSolverIterationCount - linearSolverIterations << "\n";
 
             if (staggeredStepNumber >= mStepActiveDofs.size())
                 mPostProcessor->PostProcess(prevResidual);
@@ -510,6 +520,8 @@ BlockFullVector<double>
 
     rHessians[0].ApplyCMatrix(mStructure->GetAssembler().GetConstraintMatrix());
 
+    // the solver keeps the analysis of the pattern and reuses the factorization for unchanged values, e.g. linear
+    // problems with a constant time step
     return mSolver->Solve(rHessians[0].JJ, rResidualMod);
 }
 
@@ -16,13 +16,18 @@
 #include "mechanics/nodes/NodeEnum.h"
 
 #include "mechanics/dofSubMatrixSolvers/SolverMUMPS.h"
+#include "mechanics/dofSubMatrixSolvers/SolverSupernodalLDLT.h"
 #include "mechanics/structures/Assembler.h"
 
 using namespace NuTo;
 
 NuTo::TimeIntegrationBase::TimeIntegrationBase(StructureBase* rStructure)
     : mStructure(rStructure)
+#ifdef HAVE_MUMPS
     , mSolver(std::make_unique<SolverMUMPS>(false))
+#else
+    , mSolver(std::make_unique<SolverSupernodalLDLT>())
+#endif
     , mLoadVectorStatic(rStructure->GetDofStatus())
     , mLoadVectorTimeDependent(rStructure->GetDofStatus())
     , mToleranceResidual(rStructure->GetDofStatus())
@@ -77,6 +82,7 @@ void NuTo::TimeIntegrationBase::SetTimeDependentLoadCase(int rTimeDependentLoadC
 void NuTo::TimeIntegrationBase::SetToleranceResidual(NuTo::Node::eDof rDof, double rTolerance)
 {
     mToleranceResidual[rDof] = rTolerance;
+    mSolver->SetToleranceResidual(rDof, rTolerance);
 }
 
 
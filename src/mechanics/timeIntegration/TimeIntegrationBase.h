@@ -48,7 +48,8 @@ public:
     //! @return Blockscalar with the set residual tolerances
     const BlockScalar& GetToleranceResidual() const;
 
-    //! @brief Sets the residual tolerance for a specific DOF
+    //! @brief Sets the residual tolerance for a specific DOF, iterative solvers use it as stopping criterion, see
+    //! SolverIterative
     //! param rDof: degree of freedom
     //! param rTolerance: tolerance
     void SetToleranceResidual(Node::eDof rDof, double rTolerance);
@@ -123,6 +124,13 @@ public:
         return mIterationCount;
     }
 
+    //! @brief sum of the iterations of the linear solver over all iterations, see SolverBase::GetNumIterations, e.g.
+    //! the refinement steps of SolverMixedPrecision
+    int GetNumLinearSolverIterations() const
+    {
+        return mLinearSolverIterationCount;
+    }
+
     //! @brief sets automatic time stepping (on or off)
     void SetAutomaticTimeStepping(bool rAutomaticTimeStepping)
     {
@@ -221,6 +229,8 @@ protected:
 
     int mIterationCount = 0; //!< iteration count
 
+    int mLinearSolverIterationCount = 0; //!< iterations of the linear solver, see GetNumLinearSolverIterations
+
 
     int mLoadStep = 0; //!< load step number is increased after each converged step (used for successive output)
 
@@ -0,0 +1,35 @@
+#include "BoostUnitTest.h"
+#include "base/ObjectPool.h"
+
+#include <cstdint>
+#include <vector>
+
+BOOST_AUTO_TEST_CASE(ObjectPoolChunks)
+{
+    using Pool = NuTo::ObjectPool<40>;
+    Pool& pool = Pool::Instance();
+    BOOST_CHECK_EQUAL(pool.GetNumObjects(), 0);
+
+    // consecutive objects are stored next to each other
+    std::vector<void*> objects;
+    for (std::size_t i = 0; i < Pool::NumObjectsPerChunk + 1; ++i)
+        objects.push_back(pool.Allocate());
+    BOOST_CHECK_EQUAL(pool.GetNumChunks(), 2);
+    for (std::size_t i = 1; i < Pool::NumObjectsPerChunk; ++i)
+        BOOST_CHECK_EQUAL(static_cast<char*>(objects[i]) - static_cast<char*>(objects[i - 1]), 48);
+    for (void* object : objects)
+        BOOST_CHECK_EQUAL(reinterpret_cast<std::uintptr_t>(object) % alignof(std::max_align_t), 0);
+
+    // freed slots are reused
+    void* freed = objects[3];
+    pool.Deallocate(freed);
+    objects[3] = pool.Allocate();
+    BOOST_CHECK_EQUAL(objects[3], freed);
+    BOOST_CHECK_EQUAL(pool.GetNumChunks(), 2);
+
+    // the chunks are released with the last object
+    for (void* object : objects)
+        pool.Deallocate(object);
+    BOOST_CHECK_EQUAL(pool.GetNumObjects(), 0);
+    BOOST_CHECK_EQUAL(pool.GetNumChunks(), 0);
+}
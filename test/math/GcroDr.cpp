@@ -0,0 +1,135 @@
+#include "BoostUnitTest.h"
+
+#include <cmath>
+#include <numeric>
+#include <Eigen/IterativeLinearSolvers>
+#include <Eigen/SparseLU>
+#include "base/Exception.h"
+#include "math/GcroDr.h"
+
+using namespace NuTo;
+
+//! @brief upwind convection diffusion operator on a grid of n x n nodes with homogeneous Dirichlet boundaries
+//! @param rConvection ... cell Peclet number, the matrix is nonsymmetric for rConvection > 0
+Eigen::SparseMatrix<double> ConvectionDiffusion(int n, double rConvection)
+{
+    std::vector<Eigen::Triplet<double>> entries;
+    for (int i = 0; i < n; ++i)
+        for (int j = 0; j < n; ++j)
+        {
+            const int node = i * n + j;
+            entries.emplace_back(node, node, 4. + rConvection);
+            if (i > 0)
+                entries.emplace_back(node, node - n, -1.);
+            if (i < n - 1)
+                entries.emplace_back(node, node + n, -1.);
+            if (j > 0)
+                entries.emplace_back(node, node - 1, -1. - rConvection);
+            if (j < n - 1)
+                entries.emplace_back(node, node + 1, -1.);
+        }
+    Eigen::SparseMatrix<double> matrix(n * n, n * n);
+    matrix.setFromTriplets(entries.begin(), entries.end());
+    return matrix;
+}
+
+void CheckSolution(const Eigen::SparseMatrix<double>& rMatrix, const Eigen::VectorXd& rRhs,
+                   const Eigen::VectorXd& rSolution)
+{
+    Eigen::SparseLU<Eigen::SparseMatrix<double>> lu(rMatrix);
+    const Eigen::VectorXd expected = lu.solve(rRhs);
+    BOOST_CHECK_SMALL((rSolution - expected).norm() / expected.norm(), 1.e-7);
+}
+
+BOOST_AUTO_TEST_CASE(GcroDrSolve)
+{
+    const auto matrix = ConvectionDiffusion(30, 2.);
+    const Eigen::DiagonalPreconditioner<double> jacobi(matrix);
+    const Eigen::VectorXd rhs = Eigen::VectorXd::LinSpaced(matrix.rows(), -1., 1.);
+
+    for (int numRecycledVectors : {0, 5, 10})
+    {
+        GcroDr solver(20, numRecycledVectors);
+        Eigen::VectorXd x;
+        BOOST_CHECK(solver.Solve(matrix, jacobi, rhs, x));
+        CheckSolution(matrix, rhs, x);
+        BOOST_CHECK_LE(solver.GetNumRecycledVectors(), numRecycledVectors);
+        BOOST_TEST_MESSAGE("recycled vectors " << numRecycledVectors << ", iterations " << solver.GetNumIterations());
+
+        // the initial guess is used
+        solver.Solve(matrix, jacobi, rhs, x);
+        BOOST_CHECK_LE(solver.GetNumIterations(), 1);
+    }
+
+    GcroDr solver(20, 5);
+    solver.SetMaxNumIterations(3);
+    Eigen::VectorXd x;
+    BOOST_CHECK(not solver.Solve(matrix, jacobi, rhs, x));
+    BOOST_CHECK_EQUAL(solver.GetNumIterations(), 3);
+
+    BOOST_CHECK_THROW(GcroDr(10, 10), Exception);
+}
+
+BOOST_AUTO_TEST_CASE(GcroDrFlexible)
+{
+    // the preconditioner changes in each application
+    const auto matrix = ConvectionDiffusion(30, 1.);
+    const Eigen::VectorXd rhs = Eigen::VectorXd::Ones(matrix.rows());
+    const Eigen::VectorXd inverseDiagonal = matrix.diagonal().cwiseInverse();
+    int numApplications = 0;
+    const GcroDr::Operator multiply = [&](const Eigen::VectorXd& rVector, Eigen::VectorXd& rResult) {
+        rResult = matrix * rVector;
+    };
+    const GcroDr::Operator precondition = [&](const Eigen::VectorXd& rVector, Eigen::VectorXd& rResult) {
+        const double damping = 1. + 0.5 * std::sin(numApplications++);
+        rResult = damping * inverseDiagonal.cwiseProduct(rVector);
+    };
+
+    GcroDr solver(20, 5);
+    Eigen::VectorXd x;
+    BOOST_CHECK(solver.Solve(multiply, precondition, rhs, x));
+    CheckSolution(matrix, rhs, x);
+}
+
+BOOST_AUTO_TEST_CASE(GcroDrRecycling)
+{
+    // slowly changing systems, e.g. consecutive Newton iterations, with a few small eigenvalues
+    const int numSystems = 5;
+    std::vector<int> numIterationsRecycling;
+    int numIterationsDeflation = 0;
+    int numIterationsRestart = 0;
+    GcroDr recycling(30, 10);
+    GcroDr deflation(30, 10);
+    GcroDr restart(30, 0);
+    for (int i = 0; i < numSystems; ++i)
+    {
+        const auto matrix = ConvectionDiffusion(40, 0.1 + 0.001 * i);
+        const Eigen::DiagonalPreconditioner<double> jacobi(matrix);
+        const Eigen::VectorXd rhs = Eigen::VectorXd::LinSpaced(matrix.rows(), 1., 1. + i);
+
+        Eigen::VectorXd x;
+        BOOST_CHECK(recycling.Solve(matrix, jacobi, rhs, x));
+        CheckSolution(matrix, rhs, x);
+        numIterationsRecycling.push_back(recycling.GetNumIterations());
+
+        // deflated restarts only
+        deflation.ClearRecycledSubspace();
+        x.setZero();
+        BOOST_CHECK(deflation.Solve(matrix, jacobi, rhs, x));
+        numIterationsDeflation += deflation.GetNumIterations();
+
+        x.setZero();
+        BOOST_CHECK(restart.Solve(matrix, jacobi, rhs, x));
+        numIterationsRestart += restart.GetNumIterations();
+        BOOST_TEST_MESSAGE("iterations recycling " << recycling.GetNumIterations() << ", deflation "
+                                                   << deflation.GetNumIterations() << ", restart "
+                                                   << restart.GetNumIterations());
+    }
+    const int numIterations = std::accumulate(numIterationsRecycling.begin(), numIterationsRecycling.end(), 0);
+    BOOST_CHECK_LT(numIterations, numIterationsDeflation);
+    BOOST_CHECK_LT(numIterations, 0.6 * numIterationsRestart);
+    BOOST_CHECK_LT(numIterationsRecycling.back(), numIterationsRecycling.front());
+
+    recycling.ClearRecycledSubspace();
+    BOOST_CHECK_EQUAL(recycling.GetNumRecycledVectors(), 0);
+}
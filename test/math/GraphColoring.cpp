@@ -0,0 +1,73 @@
+#include "BoostUnitTest.h"
+#include "math/GraphColoring.h"
+
+//! @brief adjacency list of a structured grid of nx * ny quad elements, elements sharing a node are neighbors
+std::vector<std::vector<int>> GridAdjacency(int nx, int ny)
+{
+    std::vector<std::vector<int>> adjacency(nx * ny);
+    for (int i = 0; i < nx; ++i)
+        for (int j = 0; j < ny; ++j)
+            for (int di = -1; di <= 1; ++di)
+                for (int dj = -1; dj <= 1; ++dj)
+                {
+                    const int ni = i + di;
+                    const int nj = j + dj;
+                    if ((di == 0 and dj == 0) or ni < 0 or nj < 0 or ni >= nx or nj >= ny)
+                        continue;
+                    adjacency[i * ny + j].push_back(ni * ny + nj);
+                }
+    return adjacency;
+}
+
+BOOST_AUTO_TEST_CASE(DSaturTriangle)
+{
+    std::vector<std::vector<int>> adjacency{{1, 2}, {0, 2}, {0, 1}};
+    auto colors = NuTo::GraphColoring::DSatur(adjacency);
+    BOOST_CHECK(NuTo::GraphColoring::IsValid(adjacency, colors));
+    BOOST_CHECK_EQUAL(*std::max_element(colors.begin(), colors.end()), 2);
+}
+
+BOOST_AUTO_TEST_CASE(DSaturEmpty)
+{
+    BOOST_CHECK(NuTo::GraphColoring::DSatur({}).empty());
+    std::vector<int> colors;
+    NuTo::GraphColoring::Balance({}, colors);
+}
+
+BOOST_AUTO_TEST_CASE(DSaturGridBalanced)
+{
+    const int nx = 20;
+    const int ny = 15;
+    auto adjacency = GridAdjacency(nx, ny);
+    auto colors = NuTo::GraphColoring::DSatur(adjacency);
+    BOOST_CHECK(NuTo::GraphColoring::IsValid(adjacency, colors));
+
+    // the node connectivity graph of a quad grid requires exactly 4 colors
+    const int numColors = *std::max_element(colors.begin(), colors.end()) + 1;
+    BOOST_CHECK_EQUAL(numColors, 4);
+
+    NuTo::GraphColoring::Balance(adjacency, colors);
+    BOOST_CHECK(NuTo::GraphColoring::IsValid(adjacency, colors));
+
+    std::vector<int> colorSizes(numColors, 0);
+    for (int color : colors)
+        colorSizes[color]++;
+    // perfect balance is not guaranteed, but no color should be significantly larger than the average
+    for (int size : colorSizes)
+        BOOST_CHECK_LE(size, 1.1 * nx * ny / numColors);
+}
+
+BOOST_AUTO_TEST_CASE(BalanceUnbalancedColoring)
+{
+    // path 0 - 1 - 2 - 3 - 4 - 5 with a valid, but unbalanced 3-coloring
+    std::vector<std::vector<int>> adjacency{{1}, {0, 2}, {1, 3}, {2, 4}, {3, 5}, {4}};
+    std::vector<int> colors{0, 1, 0, 1, 0, 2};
+
+    NuTo::GraphColoring::Balance(adjacency, colors);
+    BOOST_CHECK(NuTo::GraphColoring::IsValid(adjacency, colors));
+
+    std::vector<int> colorSizes(3, 0);
+    for (int color : colors)
+        colorSizes[color]++;
+    BOOST_CHECK_EQUAL(*std::max_element(colorSizes.begin(), colorSizes.end()), 2);
+}
@@ -0,0 +1,111 @@
+#include "BoostUnitTest.h"
+#include "math/GraphOrdering.h"
+
+#include <Eigen/SparseCholesky>
+
+//! @brief adjacency list of the nodes of a structured grid of (nx - 1) * (ny - 1) quad elements, numbered row by row
+std::vector<std::vector<int>> GridAdjacency(int nx, int ny)
+{
+    std::vector<std::vector<int>> adjacency(nx * ny);
+    for (int j = 0; j < ny; ++j)
+        for (int i = 0; i < nx; ++i)
+            for (int dj = -1; dj <= 1; ++dj)
+                for (int di = -1; di <= 1; ++di)
+                {
+                    const int ni = i + di;
+                    const int nj = j + dj;
+                    if ((di == 0 and dj == 0) or ni < 0 or nj < 0 or ni >= nx or nj >= ny)
+                        continue;
+                    adjacency[j * nx + i].push_back(nj * nx + ni);
+                }
+    return adjacency;
+}
+
+BOOST_AUTO_TEST_CASE(ReverseCuthillMcKeeGrid)
+{
+    // numbered along the long side, the bandwidth is nx + 1
+    const int nx = 30;
+    const int ny = 5;
+    auto adjacency = GridAdjacency(nx, ny);
+    std::vector<int> natural(nx * ny);
+    std::iota(natural.begin(), natural.end(), 0);
+    BOOST_CHECK_EQUAL(NuTo::GraphOrdering::Bandwidth(adjacency, natural), nx + 1);
+
+    auto ordering = NuTo::GraphOrdering::ReverseCuthillMcKee(adjacency);
+    BOOST_CHECK(NuTo::GraphOrdering::IsValid(nx * ny, ordering));
+    // the levels of the search are numbered consecutively, each level contains at most 2 * ny - 1 vertices
+    BOOST_CHECK_LE(NuTo::GraphOrdering::Bandwidth(adjacency, ordering), 2 * ny);
+}
+
+BOOST_AUTO_TEST_CASE(ReverseCuthillMcKeeComponents)
+{
+    // two paths 0 - 2 - 4 and 1 - 3, an isolated vertex 5
+    std::vector<std::vector<int>> adjacency{{2}, {3}, {0, 4}, {1}, {2}, {}};
+    auto ordering = NuTo::GraphOrdering::ReverseCuthillMcKee(adjacency);
+    BOOST_CHECK(NuTo::GraphOrdering::IsValid(6, ordering));
+    BOOST_CHECK_EQUAL(NuTo::GraphOrdering::Bandwidth(adjacency, ordering), 1);
+
+    BOOST_CHECK(NuTo::GraphOrdering::ReverseCuthillMcKee({}).empty());
+}
+
+//! @brief number of nonzeros of the cholesky factor of the graph laplacian (plus identity) in the given ordering
+int CholeskyNonZeros(const std::vector<std::vector<int>>& adjacency, const std::vector<int>& ordering)
+{
+    const std::vector<int> position = NuTo::GraphOrdering::Inverse(ordering);
+    std::vector<Eigen::Triplet<double>> entries;
+    for (unsigned int vertex = 0; vertex < adjacency.size(); ++vertex)
+    {
+        entries.emplace_back(position[vertex], position[vertex], adjacency[vertex].size() + 1.);
+        for (int neighbor : adjacency[vertex])
+            entries.emplace_back(position[vertex], position[neighbor], -1.);
+    }
+    Eigen::SparseMatrix<double> matrix(adjacency.size(), adjacency.size());
+    matrix.setFromTriplets(entries.begin(), entries.end());
+
+    Eigen::SimplicialLLT<Eigen::SparseMatrix<double>, Eigen::Lower, Eigen::NaturalOrdering<int>> cholesky(matrix);
+    BOOST_REQUIRE(cholesky.info() == Eigen::Success);
+    return Eigen::SparseMatrix<double>(cholesky.matrixL()).nonZeros();
+}
+
+BOOST_AUTO_TEST_CASE(NestedDissectionGrid)
+{
+    const int nx = 40;
+    const int ny = 40;
+    auto adjacency = GridAdjacency(nx, ny);
+    std::vector<int> natural(nx * ny);
+    std::iota(natural.begin(), natural.end(), 0);
+
+    auto ordering = NuTo::GraphOrdering::NestedDissection(adjacency, 16);
+    BOOST_CHECK(NuTo::GraphOrdering::IsValid(nx * ny, ordering));
+    BOOST_CHECK_LT(CholeskyNonZeros(adjacency, ordering), 0.75 * CholeskyNonZeros(adjacency, natural));
+
+    // small graphs are not split
+    auto path = GridAdjacency(5, 1);
+    BOOST_CHECK(NuTo::GraphOrdering::IsValid(5, NuTo::GraphOrdering::NestedDissection(path)));
+    BOOST_CHECK(NuTo::GraphOrdering::NestedDissection({}).empty());
+}
+
+BOOST_AUTO_TEST_CASE(MortonCurveQuadrants)
+{
+    // the points of each quadrant are consecutive, the quadrants are visited in z-order
+    std::vector<Eigen::VectorXd> points;
+    for (double y : {0.9, 0.1, 0.6, 0.4})
+        for (double x : {0.1, 0.9, 0.4, 0.6})
+            points.push_back(Eigen::Vector2d(x, y));
+    auto ordering = NuTo::GraphOrdering::MortonCurve(points);
+    BOOST_CHECK(NuTo::GraphOrdering::IsValid(points.size(), ordering));
+
+    for (int quadrant = 0; quadrant < 4; ++quadrant)
+        for (int i = 0; i < 4; ++i)
+        {
+            const Eigen::VectorXd& point = points[ordering[4 * quadrant + i]];
+            BOOST_CHECK_EQUAL(point[0] > 0.5, quadrant % 2 == 1);
+            BOOST_CHECK_EQUAL(point[1] > 0.5, quadrant / 2 == 1);
+        }
+
+    std::vector<Eigen::VectorXd> points3D{Eigen::Vector3d(1., 1., 1.), Eigen::Vector3d(0., 0., 0.),
+                                          Eigen::Vector3d(1., 0., 0.)};
+    std::vector<int> ordering3D = NuTo::GraphOrdering::MortonCurve(points3D);
+    std::vector<int> expected3D{1, 2, 0};
+    BOOST_CHECK_EQUAL_COLLECTIONS(ordering3D.begin(), ordering3D.end(), expected3D.begin(), expected3D.end());
+}
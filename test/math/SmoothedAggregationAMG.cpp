@@ -0,0 +1,125 @@
+#include "BoostUnitTest.h"
+
+#include <Eigen/IterativeLinearSolvers>
+#include "base/Exception.h"
+#include "math/Gmres.h"
+#include "math/SmoothedAggregationAMG.h"
+
+using namespace NuTo;
+
+//! @brief 5 point Laplacian on a grid of n x n nodes with homogeneous Dirichlet boundaries
+Eigen::SparseMatrix<double> Laplacian(int n)
+{
+    std::vector<Eigen::Triplet<double>> entries;
+    for (int i = 0; i < n; ++i)
+        for (int j = 0; j < n; ++j)
+        {
+            const int node = i * n + j;
+            entries.emplace_back(node, node, 4.);
+            if (i > 0)
+                entries.emplace_back(node, node - n, -1.);
+            if (i < n - 1)
+                entries.emplace_back(node, node + n, -1.);
+            if (j > 0)
+                entries.emplace_back(node, node - 1, -1.);
+            if (j < n - 1)
+                entries.emplace_back(node, node + 1, -1.);
+        }
+    Eigen::SparseMatrix<double> laplacian(n * n, n * n);
+    laplacian.setFromTriplets(entries.begin(), entries.end());
+    return laplacian;
+}
+
+//! @brief number of Gmres restarts to reduce the preconditioned residual by 1e-8
+template <typename TPreconditioner>
+int NumRestarts(const Eigen::SparseMatrix<double>& rMatrix, const TPreconditioner& rPreconditioner)
+{
+    const Eigen::VectorXd rhs = Eigen::VectorXd::Ones(rMatrix.rows());
+    Eigen::VectorXd x = Eigen::VectorXd::Zero(rMatrix.rows());
+    const int numRestarts = Gmres(rMatrix, rhs, x, 1000, 1.e-8, 5, rPreconditioner);
+    BOOST_CHECK_SMALL((rMatrix * x - rhs).norm() / rhs.norm(), 1.e-5);
+    return numRestarts;
+}
+
+BOOST_AUTO_TEST_CASE(AMGHierarchy)
+{
+    const auto laplacian = Laplacian(64);
+    SmoothedAggregationAMG amg(laplacian);
+    BOOST_CHECK_GT(amg.GetNumLevels(), 1);
+    for (int level = 1; level < amg.GetNumLevels(); ++level)
+        BOOST_CHECK_LT(amg.GetNumRows(level), amg.GetNumRows(level - 1) / 3);
+    BOOST_CHECK_LT(amg.GetOperatorComplexity(), 2.);
+
+    // symmetric preconditioner, x^T M y = y^T M x
+    const Eigen::VectorXd x = Eigen::VectorXd::Random(laplacian.rows());
+    const Eigen::VectorXd y = Eigen::VectorXd::Random(laplacian.rows());
+    BOOST_CHECK_CLOSE(x.dot(amg.solve(y)), y.dot(amg.solve(x)), 1.e-8);
+    BOOST_CHECK_GT(x.dot(amg.solve(x)), 0.);
+
+    // a single level is a direct solver
+    SmoothedAggregationAMG direct;
+    direct.SetMaxCoarseSize(5000);
+    direct.Compute(laplacian);
+    BOOST_CHECK_EQUAL(direct.GetNumLevels(), 1);
+    BoostUnitTest::CheckVector(laplacian * direct.solve(y), y, y.rows(), 1.e-8);
+}
+
+BOOST_AUTO_TEST_CASE(AMGGmresMeshIndependence)
+{
+    for (auto smoother : {SmoothedAggregationAMG::eSmoother::JACOBI, SmoothedAggregationAMG::eSmoother::CHEBYSHEV})
+    {
+        std::vector<int> numRestarts;
+        for (int n : {32, 64, 128})
+        {
+            const auto laplacian = Laplacian(n);
+            SmoothedAggregationAMG amg;
+            amg.SetSmoother(smoother, 2);
+            amg.SetMaxCoarseSize(100);
+            amg.Compute(laplacian);
+            numRestarts.push_back(NumRestarts(laplacian, amg));
+            BOOST_TEST_MESSAGE("n = " << n << ", levels " << amg.GetNumLevels() << ", restarts " << numRestarts.back());
+        }
+        BOOST_CHECK_LE(numRestarts.back(), numRestarts.front() + 2);
+    }
+
+    // as template argument, compared to the diagonal preconditioner
+    const auto laplacian = Laplacian(32);
+    Eigen::VectorXd x = Eigen::VectorXd::Zero(laplacian.rows());
+    const int numRestartsAMG = Gmres<Eigen::SparseMatrix<double>, SmoothedAggregationAMG>(
+            laplacian, Eigen::VectorXd::Ones(laplacian.rows()), x, 1000, 1.e-8, 5);
+    BOOST_CHECK_LT(5 * numRestartsAMG, NumRestarts(laplacian, Eigen::DiagonalPreconditioner<double>(laplacian)));
+}
+
+BOOST_AUTO_TEST_CASE(AMGNearNullSpace)
+{
+    // two decoupled Laplacians, the dofs of a node are consecutive
+    const int n = 32;
+    const auto laplacian = Laplacian(n);
+    std::vector<Eigen::Triplet<double>> entries;
+    for (int k = 0; k < laplacian.outerSize(); ++k)
+        for (Eigen::SparseMatrix<double>::InnerIterator it(laplacian, k); it; ++it)
+            for (int component = 0; component < 2; ++component)
+                entries.emplace_back(2 * it.row() + component, 2 * it.col() + component, it.value());
+    Eigen::SparseMatrix<double> matrix(2 * n * n, 2 * n * n);
+    matrix.setFromTriplets(entries.begin(), entries.end());
+
+    NearNullSpace nearNullSpace;
+    nearNullSpace.mModes = Eigen::MatrixXd::Zero(2 * n * n, 2);
+    for (int node = 0; node < n * n; ++node)
+        for (int component = 0; component < 2; ++component)
+        {
+            nearNullSpace.mModes(2 * node + component, component) = 1.;
+            nearNullSpace.mNodes.push_back(10 * node);
+        }
+
+    SmoothedAggregationAMG amg;
+    amg.SetNearNullSpace(nearNullSpace);
+    amg.SetMaxCoarseSize(100);
+    amg.Compute(matrix);
+    BOOST_CHECK_GT(amg.GetNumLevels(), 1);
+    BOOST_CHECK_LE(NumRestarts(matrix, amg), 10);
+
+    nearNullSpace.mNodes.pop_back();
+    amg.SetNearNullSpace(nearNullSpace);
+    BOOST_CHECK_THROW(amg.Compute(matrix), Exception);
+}
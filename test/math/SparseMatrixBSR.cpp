@@ -0,0 +1,83 @@
+#include "BoostUnitTest.h"
+
+#include <Eigen/Core>
+#include "math/SparseMatrixBSR.h"
+#include "math/SparseMatrixCSRGeneral.h"
+#include "math/SparseMatrixCSRSymmetric.h"
+
+using namespace NuTo;
+
+//! @brief random matrix with about rDensity * rNumRows * rNumColumns nonzero entries
+Eigen::MatrixXd RandomSparse(int rNumRows, int rNumColumns, double rDensity)
+{
+    Eigen::MatrixXd matrix = Eigen::MatrixXd::Random(rNumRows, rNumColumns);
+    const Eigen::MatrixXd pattern = Eigen::MatrixXd::Random(rNumRows, rNumColumns);
+    for (int i = 0; i < rNumRows; ++i)
+        for (int j = 0; j < rNumColumns; ++j)
+            if (0.5 * (pattern(i, j) + 1.) > rDensity)
+                matrix(i, j) = 0.;
+    return matrix;
+}
+
+BOOST_AUTO_TEST_CASE(BSRGeneral)
+{
+    for (int blockSize : {1, 2, 3, 4})
+        for (int numRows : {6, 7, 8})
+        {
+            const int numColumns = numRows + 2;
+            const Eigen::MatrixXd full = RandomSparse(numRows, numColumns, 0.3);
+            SparseMatrixCSRGeneral<double> csr(full);
+
+            SparseMatrixBSR bsr(csr, blockSize);
+            BOOST_CHECK_EQUAL(bsr.GetNumRows(), numRows);
+            BOOST_CHECK_EQUAL(bsr.GetNumColumns(), numColumns);
+            BOOST_CHECK_LE(bsr.GetNumBlocks(), csr.GetNumEntries());
+            BoostUnitTest::CheckEigenMatrix(bsr.ConvertToFullMatrix(), full);
+
+            const Eigen::VectorXd vector = Eigen::VectorXd::Random(numColumns);
+            BoostUnitTest::CheckVector(bsr * vector, full * vector, numRows);
+
+            BoostUnitTest::CheckEigenMatrix(bsr.ExportToCSRGeneral().ConvertToFullMatrix(), full);
+
+            // one based indexing and new values with the same pattern
+            csr *= 2.;
+            csr.SetOneBasedIndexing();
+            BOOST_CHECK(bsr.SetValues(csr));
+            BoostUnitTest::CheckEigenMatrix(bsr.ConvertToFullMatrix(), 2. * full);
+        }
+}
+
+BOOST_AUTO_TEST_CASE(BSRSymmetric)
+{
+    const int dimension = 9;
+    Eigen::MatrixXd full = RandomSparse(dimension, dimension, 0.3);
+    full += full.transpose().eval();
+
+    SparseMatrixCSRSymmetric<double> csr(dimension);
+    for (int i = 0; i < dimension; ++i)
+        for (int j = i; j < dimension; ++j)
+            if (full(i, j) != 0.)
+                csr.AddValue(i, j, full(i, j));
+
+    SparseMatrixBSR bsr(csr, 3);
+    BoostUnitTest::CheckEigenMatrix(bsr.ConvertToFullMatrix(), full);
+    const Eigen::VectorXd vector = Eigen::VectorXd::Random(dimension);
+    BoostUnitTest::CheckVector(bsr * vector, full * vector, dimension);
+}
+
+BOOST_AUTO_TEST_CASE(BSRPattern)
+{
+    Eigen::MatrixXd full = Eigen::MatrixXd::Zero(4, 4);
+    full(0, 1) = 1.;
+    full(3, 3) = 2.;
+    SparseMatrixBSR bsr(SparseMatrixCSRGeneral<double>(full), 2);
+    BOOST_CHECK_EQUAL(bsr.GetNumBlocks(), 2);
+
+    // block (0, 1) does not exist
+    full(1, 2) = 3.;
+    BOOST_CHECK(not bsr.SetValues(SparseMatrixCSRGeneral<double>(full)));
+    BOOST_CHECK(not bsr.SetValues(SparseMatrixCSRGeneral<double>(Eigen::MatrixXd::Ones(4, 5))));
+
+    BOOST_CHECK_THROW(bsr * Eigen::VectorXd::Ones(3), Exception);
+    BOOST_CHECK_THROW(SparseMatrixBSR(SparseMatrixCSRGeneral<double>(full), 0), Exception);
+}
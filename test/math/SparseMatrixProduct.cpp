@@ -0,0 +1,101 @@
+#include "BoostUnitTest.h"
+
+#include <random>
+#include <vector>
+#include <Eigen/Core>
+#include <Eigen/SparseCore>
+#include "math/SparseMatrixCSRGeneral.h"
+#include "math/SparseMatrixCSRSymmetric.h"
+#include "math/SparseMatrixCSRVector2General.h"
+#include "math/SparseMatrixCSRVector2Symmetric.h"
+
+using namespace NuTo;
+
+//! @brief upper triangle of a symmetric banded matrix with some entries far from the diagonal, sorted by rows
+//! @remark the far entries produce transposed entries for all following ranges of rows of the parallel product
+std::vector<Eigen::Triplet<double>> UpperTriangle(int rDimension)
+{
+    std::mt19937 generator(42);
+    std::uniform_real_distribution<double> value(-1., 1.);
+    std::vector<Eigen::Triplet<double>> entries;
+    for (int row = 0; row < rDimension; ++row)
+    {
+        entries.emplace_back(row, row, 10. + value(generator));
+        for (int column = row + 1; column < std::min(row + 30, rDimension); ++column)
+            if (value(generator) > 0.5)
+                entries.emplace_back(row, column, value(generator));
+        const int farColumn = rDimension - 1 - row / 2;
+        if (row % 97 == 0 and farColumn >= row + 30)
+            entries.emplace_back(row, farColumn, value(generator));
+    }
+    return entries;
+}
+
+//! @brief full symmetric matrix from the upper triangle
+Eigen::SparseMatrix<double> Reference(const std::vector<Eigen::Triplet<double>>& rUpper, int rDimension)
+{
+    std::vector<Eigen::Triplet<double>> entries(rUpper);
+    for (const auto& entry : rUpper)
+        if (entry.row() != entry.col())
+            entries.emplace_back(entry.col(), entry.row(), entry.value());
+    Eigen::SparseMatrix<double> reference(rDimension, rDimension);
+    reference.setFromTriplets(entries.begin(), entries.end());
+    return reference;
+}
+
+void CheckProduct(const SparseMatrix<double>& rMatrix, const Eigen::SparseMatrix<double>& rReference)
+{
+    const Eigen::MatrixXd vectors = Eigen::MatrixXd::Random(rReference.cols(), 2);
+    const Eigen::MatrixXd expected = rReference * vectors;
+    BoostUnitTest::CheckEigenMatrix(rMatrix * vectors, expected);
+}
+
+BOOST_AUTO_TEST_CASE(ProductSymmetric)
+{
+    // enough rows for several threads, see SparseMatrixProduct::minRowsPerThread
+    for (int dimension : {10, 9001})
+    {
+        const auto upper = UpperTriangle(dimension);
+        const auto reference = Reference(upper, dimension);
+
+        SparseMatrixCSRSymmetric<double> csr(dimension);
+        SparseMatrixCSRVector2Symmetric<double> csrVector2(dimension, dimension);
+        for (const auto& entry : upper)
+        {
+            csr.AddValue(entry.row(), entry.col(), entry.value());
+            csrVector2.AddValue(entry.row(), entry.col(), entry.value());
+        }
+        CheckProduct(csr, reference);
+        CheckProduct(csrVector2, reference);
+
+        csr.SetOneBasedIndexing();
+        csrVector2.SetOneBasedIndexing();
+        CheckProduct(csr, reference);
+        CheckProduct(csrVector2, reference);
+    }
+}
+
+BOOST_AUTO_TEST_CASE(ProductGeneral)
+{
+    for (int dimension : {10, 9001})
+    {
+        const auto reference = Reference(UpperTriangle(dimension), dimension);
+
+        SparseMatrixCSRGeneral<double> csr(dimension, dimension);
+        SparseMatrixCSRVector2General<double> csrVector2(dimension, dimension);
+        for (int row = 0; row < dimension; ++row)
+            // column row of the symmetric reference
+            for (Eigen::SparseMatrix<double>::InnerIterator it(reference, row); it; ++it)
+            {
+                csr.AddValue(row, it.row(), it.value());
+                csrVector2.AddValue(row, it.row(), it.value());
+            }
+        CheckProduct(csr, reference);
+        CheckProduct(csrVector2, reference);
+
+        csr.SetOneBasedIndexing();
+        csrVector2.SetOneBasedIndexing();
+        CheckProduct(csr, reference);
+        CheckProduct(csrVector2, reference);
+    }
+}
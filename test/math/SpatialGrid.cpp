@@ -0,0 +1,126 @@
+#include "BoostUnitTest.h"
+#include "math/SpatialGrid.h"
+
+#include <random>
+
+//! @brief indices of the boxes that intersect [rMin, rMax], by checking all boxes
+std::vector<int> FindInBoxBruteForce(const Eigen::MatrixXd& rBoxMin, const Eigen::MatrixXd& rBoxMax,
+                                     const Eigen::VectorXd& rMin, const Eigen::VectorXd& rMax)
+{
+    std::vector<int> boxes;
+    for (int box = 0; box < rBoxMin.cols(); ++box)
+        if ((rBoxMin.col(box).array() <= rMax.array()).all() and (rBoxMax.col(box).array() >= rMin.array()).all())
+            boxes.push_back(box);
+    return boxes;
+}
+
+//! @brief random boxes with extents up to rMaxExtent in the unit cube, stretched by rScale
+void RandomBoxes(int rNumBoxes, Eigen::VectorXd rScale, double rMaxExtent, Eigen::MatrixXd& rBoxMin,
+                 Eigen::MatrixXd& rBoxMax)
+{
+    std::mt19937 generator(6174);
+    std::uniform_real_distribution<double> distribution(0., 1.);
+    const int dimension = rScale.rows();
+    rBoxMin.resize(dimension, rNumBoxes);
+    rBoxMax.resize(dimension, rNumBoxes);
+    for (int box = 0; box < rNumBoxes; ++box)
+        for (int i = 0; i < dimension; ++i)
+        {
+            rBoxMin(i, box) = rScale[i] * distribution(generator);
+            rBoxMax(i, box) = rBoxMin(i, box) + rScale[i] * rMaxExtent * distribution(generator);
+        }
+}
+
+BOOST_AUTO_TEST_CASE(SpatialGridFindInBox)
+{
+    const double inf = std::numeric_limits<double>::infinity();
+    std::vector<Eigen::VectorXd> scales{Eigen::Vector2d(10., 1.), Eigen::Vector3d::Ones(), Eigen::Vector3d(1., 0., 2.),
+                                       Eigen::VectorXd::Ones(1)};
+    for (const Eigen::VectorXd& scale : scales)
+        for (double maxExtent : {0., 0.05, 0.5})
+        {
+            Eigen::MatrixXd boxMin, boxMax;
+            RandomBoxes(500, scale, maxExtent, boxMin, boxMax);
+            NuTo::SpatialGrid grid(boxMin, boxMax);
+            BOOST_CHECK_EQUAL(grid.GetNumBoxes(), 500);
+            BOOST_CHECK_CLOSE(grid.GetMaxBoxExtent(), (boxMax - boxMin).maxCoeff(), 1.e-10);
+
+            const int dimension = scale.rows();
+            std::vector<std::pair<Eigen::VectorXd, Eigen::VectorXd>> queries;
+            queries.emplace_back(0.2 * scale, 0.3 * scale);
+            queries.emplace_back(-Eigen::VectorXd::Ones(dimension), 2. * scale);
+            queries.emplace_back(Eigen::VectorXd::Constant(dimension, -inf), Eigen::VectorXd::Constant(dimension, inf));
+            queries.emplace_back(boxMin.col(3), boxMin.col(3));
+            queries.emplace_back(3. * scale + Eigen::VectorXd::Ones(dimension),
+                                 4. * scale + Eigen::VectorXd::Ones(dimension));
+            // a slab in the first direction
+            Eigen::VectorXd slabMin = Eigen::VectorXd::Constant(dimension, -inf);
+            Eigen::VectorXd slabMax = Eigen::VectorXd::Constant(dimension, inf);
+            slabMin[0] = 0.4 * scale[0];
+            slabMax[0] = 0.45 * scale[0];
+            queries.emplace_back(slabMin, slabMax);
+
+            for (const auto& query : queries)
+            {
+                std::vector<int> expected = FindInBoxBruteForce(boxMin, boxMax, query.first, query.second);
+                std::vector<int> found = grid.FindInBox(query.first, query.second);
+                BOOST_CHECK_EQUAL_COLLECTIONS(found.begin(), found.end(), expected.begin(), expected.end());
+            }
+        }
+}
+
+BOOST_AUTO_TEST_CASE(SpatialGridFindNearest)
+{
+    for (double maxExtent : {0., 0.02})
+    {
+        Eigen::MatrixXd boxMin, boxMax;
+        RandomBoxes(1000, Eigen::Vector3d(1., 2., 0.5), maxExtent, boxMin, boxMax);
+        NuTo::SpatialGrid grid(boxMin, boxMax);
+
+        std::mt19937 generator(42);
+        std::uniform_real_distribution<double> distribution(-1., 3.);
+        for (int query = 0; query < 200; ++query)
+        {
+            Eigen::Vector3d point(distribution(generator), distribution(generator), distribution(generator));
+            Eigen::VectorXd distances2(boxMin.cols());
+            for (int box = 0; box < boxMin.cols(); ++box)
+                distances2[box] = (point.cwiseMax(boxMin.col(box)).cwiseMin(boxMax.col(box)) - point).squaredNorm();
+            int expected;
+            distances2.minCoeff(&expected);
+            BOOST_CHECK_EQUAL(grid.FindNearest(point), expected);
+        }
+    }
+}
+
+BOOST_AUTO_TEST_CASE(SpatialGridDegenerate)
+{
+    NuTo::SpatialGrid empty;
+    BOOST_CHECK_EQUAL(empty.GetNumBoxes(), 0);
+
+    NuTo::SpatialGrid emptyPoints(Eigen::MatrixXd(2, 0));
+    BOOST_CHECK_EQUAL(emptyPoints.FindNearest(Eigen::Vector2d::Zero()), -1);
+    BOOST_CHECK(emptyPoints.FindInBox(Eigen::Vector2d::Zero(), Eigen::Vector2d::Ones()).empty());
+
+    // identical points share a single cell
+    NuTo::SpatialGrid samePoints(Eigen::MatrixXd::Ones(2, 5));
+    BOOST_CHECK(samePoints.GetNumCells() == (std::array<int, 3>{{1, 1, 1}}));
+    BOOST_CHECK_EQUAL(samePoints.FindInBox(Eigen::Vector2d::Zero(), Eigen::Vector2d::Ones()).size(), 5);
+    BOOST_CHECK_EQUAL(samePoints.FindNearest(Eigen::Vector2d(7., -3.)), 0);
+
+    // points on a line in 3D, only one direction is split
+    Eigen::MatrixXd line = Eigen::MatrixXd::Zero(3, 100);
+    line.row(1) = Eigen::VectorXd::LinSpaced(100, 0., 1.);
+    NuTo::SpatialGrid lineGrid(line);
+    BOOST_CHECK_EQUAL(lineGrid.GetNumCells()[0], 1);
+    BOOST_CHECK_GT(lineGrid.GetNumCells()[1], 10);
+    BOOST_CHECK_EQUAL(lineGrid.GetNumCells()[2], 1);
+    BOOST_CHECK_EQUAL(lineGrid.FindNearest(Eigen::Vector3d(5., 0.5 + 1.e-3, 5.)), 50);
+
+    // points in a thin layer, the tiny thickness must not blow up the number of cells in the other directions
+    Eigen::MatrixXd layer = Eigen::MatrixXd::Random(3, 1000);
+    layer.row(2) *= 1.e-9;
+    NuTo::SpatialGrid layerGrid(layer);
+    const std::array<int, 3> numCells = layerGrid.GetNumCells();
+    BOOST_CHECK_LE(static_cast<long>(numCells[0]) * numCells[1] * numCells[2], 2001);
+    BOOST_CHECK_EQUAL(layerGrid.FindInBox(Eigen::Vector3d::Constant(-2.), Eigen::Vector3d::Constant(2.)).size(), 1000);
+}
@@ -0,0 +1,176 @@
+#include "BoostUnitTest.h"
+
+#include <cmath>
+#include <Eigen/SparseCholesky>
+#include "base/Exception.h"
+#include "math/SupernodalLDLT.h"
+
+using namespace NuTo;
+using Matrix = Eigen::SparseMatrix<double, Eigen::RowMajor>;
+
+//! @brief 7 point finite difference Laplacian on a grid of nx x ny x nz nodes with a diagonal shift
+Matrix Laplacian(int nx, int ny, int nz, double rShift = 0.01)
+{
+    std::vector<Eigen::Triplet<double>> entries;
+    auto node = [&](int i, int j, int k) { return (k * ny + j) * nx + i; };
+    for (int k = 0; k < nz; ++k)
+        for (int j = 0; j < ny; ++j)
+            for (int i = 0; i < nx; ++i)
+            {
+                const int row = node(i, j, k);
+                entries.emplace_back(row, row, 6. + rShift);
+                if (i > 0)
+                    entries.emplace_back(row, node(i - 1, j, k), -1.);
+                if (i < nx - 1)
+                    entries.emplace_back(row, node(i + 1, j, k), -1.);
+                if (j > 0)
+                    entries.emplace_back(row, node(i, j - 1, k), -1.);
+                if (j < ny - 1)
+                    entries.emplace_back(row, node(i, j + 1, k), -1.);
+                if (k > 0)
+                    entries.emplace_back(row, node(i, j, k - 1), -1.);
+                if (k < nz - 1)
+                    entries.emplace_back(row, node(i, j, k + 1), -1.);
+            }
+    Matrix matrix(nx * ny * nz, nx * ny * nz);
+    matrix.setFromTriplets(entries.begin(), entries.end());
+    return matrix;
+}
+
+//! @brief compares the solution with Eigen::SimplicialLDLT
+void CheckSolution(const Matrix& rMatrix, const SupernodalLDLT& rSolver)
+{
+    const Eigen::VectorXd rhs = Eigen::VectorXd::LinSpaced(rMatrix.rows(), -1., 2.);
+    const Eigen::VectorXd solution = rSolver.Solve(rhs);
+    BOOST_CHECK_SMALL((rMatrix * solution - rhs).norm() / rhs.norm(), 1.e-12);
+
+    Eigen::SimplicialLDLT<Eigen::SparseMatrix<double>> reference(rMatrix);
+    const Eigen::VectorXd referenceSolution = reference.solve(rhs);
+    BOOST_CHECK_SMALL((solution - referenceSolution).norm() / referenceSolution.norm(), 1.e-10);
+}
+
+BOOST_AUTO_TEST_CASE(SupernodalLDLTLaplacian)
+{
+    for (auto matrix : {Laplacian(1, 1, 1), Laplacian(50, 1, 1), Laplacian(40, 30, 1), Laplacian(15, 14, 13)})
+    {
+        SupernodalLDLT solver;
+        solver.Compute(matrix);
+        CheckSolution(matrix, solver);
+        BOOST_CHECK_LE(solver.GetNumSupernodes(), matrix.rows());
+        BOOST_CHECK_EQUAL(solver.GetNumNegativePivots(), 0);
+    }
+}
+
+BOOST_AUTO_TEST_CASE(SupernodalLDLTIndefinite)
+{
+    // the eigenvalues of the shifted Laplacian are in (-1.5, 10.5), the pivots of a fill-reducing ordering are stable
+    Matrix matrix = Laplacian(12, 11, 10, -1.5);
+    SupernodalLDLT solver;
+    solver.Compute(matrix);
+    CheckSolution(matrix, solver);
+    BOOST_CHECK_GT(solver.GetNumNegativePivots(), 0);
+}
+
+BOOST_AUTO_TEST_CASE(SupernodalLDLTForest)
+{
+    // two unconnected blocks, i.e. two trees of the elimination forest
+    const Matrix first = Laplacian(20, 15, 1);
+    const Matrix second = Laplacian(8, 7, 6);
+    std::vector<Eigen::Triplet<double>> entries;
+    for (int k = 0; k < first.outerSize(); ++k)
+        for (Matrix::InnerIterator it(first, k); it; ++it)
+            entries.emplace_back(it.row(), it.col(), it.value());
+    for (int k = 0; k < second.outerSize(); ++k)
+        for (Matrix::InnerIterator it(second, k); it; ++it)
+            entries.emplace_back(it.row() + first.rows(), it.col() + first.rows(), it.value());
+    Matrix matrix(first.rows() + second.rows(), first.rows() + second.rows());
+    matrix.setFromTriplets(entries.begin(), entries.end());
+
+    SupernodalLDLT solver;
+    solver.Compute(matrix);
+    CheckSolution(matrix, solver);
+}
+
+BOOST_AUTO_TEST_CASE(SupernodalLDLTRefactorize)
+{
+    Matrix matrix = Laplacian(20, 20, 5);
+    SupernodalLDLT solver;
+    solver.AnalyzePattern(matrix);
+    BOOST_CHECK_THROW(solver.Solve(Eigen::VectorXd::Ones(matrix.rows())), Exception);
+    solver.Factorize(matrix);
+    CheckSolution(matrix, solver);
+    const std::size_t numNonZeros = solver.GetNumNonZeros();
+
+    // new values, same pattern
+    for (int k = 0; k < matrix.outerSize(); ++k)
+        for (Matrix::InnerIterator it(matrix, k); it; ++it)
+            it.valueRef() *= 1. + 0.01 * ((it.row() + it.col()) % 7);
+    solver.Factorize(matrix);
+    CheckSolution(matrix, solver);
+    BOOST_CHECK_EQUAL(solver.GetNumNonZeros(), numNonZeros);
+
+    // another pattern
+    Matrix other = Laplacian(10, 10, 10);
+    BOOST_CHECK_THROW(solver.Factorize(other), Exception);
+}
+
+BOOST_AUTO_TEST_CASE(SupernodalLDLTSinglePrecision)
+{
+    // the diagonal varies over four orders of magnitude, the scaling keeps the single precision factorization accurate
+    Matrix matrix = Laplacian(15, 14, 13);
+    for (int k = 0; k < matrix.outerSize(); ++k)
+        for (Matrix::InnerIterator it(matrix, k); it; ++it)
+            it.valueRef() *= std::pow(10., (it.row() % 5 + it.col() % 5) / 2.);
+
+    SupernodalLDLT solver(SupernodalLDLT::ePrecision::SINGLE);
+    solver.Compute(matrix);
+    const Eigen::VectorXd rhs = Eigen::VectorXd::LinSpaced(matrix.rows(), -1., 2.);
+    Eigen::VectorXd solution = solver.Solve(rhs);
+    Eigen::VectorXd residual = rhs - matrix * solution;
+    BOOST_CHECK_SMALL(residual.norm() / rhs.norm(), 1.e-4);
+
+    // iterative refinement in double precision
+    for (int step = 0; step < 4; ++step)
+    {
+        solution += solver.Solve(residual);
+        residual = rhs - matrix * solution;
+    }
+    BOOST_CHECK_SMALL(residual.norm() / rhs.norm(), 1.e-12);
+
+    solver.SetPrecision(SupernodalLDLT::ePrecision::DOUBLE);
+    BOOST_CHECK_THROW(solver.Solve(rhs), Exception);
+    solver.Factorize(matrix);
+    CheckSolution(matrix, solver);
+}
+
+BOOST_AUTO_TEST_CASE(SupernodalLDLTSingular)
+{
+    // a row and column of explicit zeros, its pivot vanishes exactly
+    Matrix matrix = Laplacian(30, 30, 1);
+    const int zeroRow = 123;
+    for (int k = 0; k < matrix.outerSize(); ++k)
+        for (Matrix::InnerIterator it(matrix, k); it; ++it)
+            if (it.row() == zeroRow or it.col() == zeroRow)
+                it.valueRef() = 0.;
+    SupernodalLDLT solver;
+    solver.AnalyzePattern(matrix);
+    BOOST_CHECK_THROW(solver.Factorize(matrix), Exception);
+}
+
+BOOST_AUTO_TEST_CASE(SupernodalLDLTIsSymmetric)
+{
+    Matrix matrix = Laplacian(10, 10, 1);
+    BOOST_CHECK(SupernodalLDLT::IsSymmetric(matrix));
+
+    // an entry without its transposed counterpart
+    matrix.coeffRef(3, 50) = 1.e-3;
+    matrix.makeCompressed();
+    BOOST_CHECK(not SupernodalLDLT::IsSymmetric(matrix));
+    matrix.coeffRef(50, 3) = 1.e-3 * (1. + 1.e-14);
+    matrix.makeCompressed();
+    BOOST_CHECK(SupernodalLDLT::IsSymmetric(matrix));
+
+    // nonsymmetric values with a symmetric pattern
+    matrix.coeffRef(1, 0) = -0.5;
+    BOOST_CHECK(not SupernodalLDLT::IsSymmetric(matrix));
+}
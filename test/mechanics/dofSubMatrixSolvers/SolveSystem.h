@@ -54,3 +54,51 @@ void SolveAndCheckSystem(NuTo::SolverBase& solver)
     TestProblem p;
     BOOST_CHECK((solver.Solve(p.matrix, p.rhs).Export() - p.expectedSolution.Export()).isMuchSmallerThan(1.e-6, 1.e-1));
 }
+
+//! @brief solves the test problem repeatedly and checks the reuse of the analysis and the factorization
+void SolveAndCheckReuse(NuTo::SolverBase& solver)
+{
+    using NuTo::Node::eDof;
+    TestProblem p;
+    BOOST_CHECK(not solver.IsFactorized());
+    BOOST_CHECK_THROW(solver.SolveFactorized(p.rhs), NuTo::Exception);
+
+    // same matrix
+    solver.Solve(p.matrix, p.rhs);
+    BoostUnitTest::CheckVector(solver.Solve(p.matrix, p.rhs).Export(), p.expectedSolution.Export(), 4);
+    BOOST_CHECK_EQUAL(solver.GetNumAnalyses(), 1);
+    BOOST_CHECK_EQUAL(solver.GetNumFactorizations(), 1);
+
+    // new values, same pattern
+    p.matrix(eDof::DISPLACEMENTS, eDof::DISPLACEMENTS).AddValue(1, 1, 2.);
+    Eigen::VectorXd expected = p.expectedSolution.Export();
+    expected[1] = 0.25;
+    BoostUnitTest::CheckVector(solver.Solve(p.matrix, p.rhs).Export(), expected, 4);
+    BOOST_CHECK_EQUAL(solver.GetNumAnalyses(), 1);
+    BOOST_CHECK_EQUAL(solver.GetNumFactorizations(), 2);
+
+    // new right hand side
+    BoostUnitTest::CheckVector(solver.SolveFactorized(p.rhs * 2.).Export(), expected * 2., 4);
+    BOOST_CHECK_EQUAL(solver.GetNumFactorizations(), 2);
+
+    // new pattern
+    p.matrix(eDof::DISPLACEMENTS, eDof::CRACKPHASEFIELD).AddValue(0, 1, 1.);
+    expected[0] = 0.25;
+    BoostUnitTest::CheckVector(solver.Solve(p.matrix, p.rhs).Export(), expected, 4);
+    BOOST_CHECK_EQUAL(solver.GetNumAnalyses(), 2);
+    BOOST_CHECK_EQUAL(solver.GetNumFactorizations(), 3);
+
+    // another pattern with the same number of entries
+    p.matrix(eDof::DISPLACEMENTS, eDof::CRACKPHASEFIELD).Resize(2, 2);
+    p.matrix(eDof::DISPLACEMENTS, eDof::CRACKPHASEFIELD).AddValue(1, 0, 1.);
+    expected[0] = 0.5;
+    expected[1] = 0.125;
+    BoostUnitTest::CheckVector(solver.Solve(p.matrix, p.rhs).Export(), expected, 4);
+    BOOST_CHECK_EQUAL(solver.GetNumAnalyses(), 3);
+    BOOST_CHECK_EQUAL(solver.GetNumFactorizations(), 4);
+
+    // a copy has the same values, but is another matrix
+    const NuTo::BlockSparseMatrix copy(p.matrix);
+    BoostUnitTest::CheckVector(solver.Solve(copy, p.rhs).Export(), expected, 4);
+    BOOST_CHECK_EQUAL(solver.GetNumFactorizations(), 5);
+}
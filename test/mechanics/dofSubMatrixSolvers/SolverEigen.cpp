@@ -19,3 +19,9 @@ BOOST_AUTO_TEST_CASE(SolverEigenSimplicialLDLT)
     NuTo::SolverEigen<Eigen::SimplicialLDLT<Eigen::SparseMatrix<double>>> s;
     SolveAndCheckSystem(s);
 }
+
+BOOST_AUTO_TEST_CASE(SolverEigenReuse)
+{
+    NuTo::SolverEigen<Eigen::SparseLU<Eigen::SparseMatrix<double>, Eigen::COLAMDOrdering<int>>> s;
+    SolveAndCheckReuse(s);
+}
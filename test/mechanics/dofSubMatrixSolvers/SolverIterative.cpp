@@ -0,0 +1,262 @@
+#include "SolveSystem.h"
+#include <Eigen/SparseCholesky>
+#include "mechanics/dofSubMatrixSolvers/SolverFGMRES.h"
+#include "mechanics/dofSubMatrixSolvers/SolverMINRES.h"
+#include "mechanics/dofSubMatrixSolvers/SolverPCG.h"
+
+using NuTo::Node::eDof;
+using ePreconditioner = NuTo::SolverIterative::ePreconditioner;
+
+const std::vector<ePreconditioner> preconditioners = {ePreconditioner::NONE, ePreconditioner::JACOBI,
+                                                      ePreconditioner::BLOCK_JACOBI, ePreconditioner::SSOR,
+                                                      ePreconditioner::INCOMPLETE_CHOLESKY};
+
+//! @brief symmetric system on a grid of n x n nodes with two displacements and a phase field per node
+//! @remark The diagonal blocks are Laplacians, the displacements of a node are coupled, the first displacement is
+//! coupled with the phase field. rPhaseFieldShift < 0 makes the matrix indefinite.
+struct GridProblem
+{
+    GridProblem(int n, double rPhaseFieldShift = 1.)
+        : rhs(dofStatus)
+        , matrix(dofStatus)
+    {
+        const int numNodes = n * n;
+        std::set<eDof> dofTypes({eDof::DISPLACEMENTS, eDof::CRACKPHASEFIELD});
+        dofStatus.SetDofTypes(dofTypes);
+        dofStatus.SetActiveDofTypes(dofTypes);
+        dofStatus.SetNumActiveDofs(eDof::DISPLACEMENTS, 2 * numNodes);
+        dofStatus.SetNumActiveDofs(eDof::CRACKPHASEFIELD, numNodes);
+
+        matrix.AllocateSubmatrices();
+        auto& uu = matrix(eDof::DISPLACEMENTS, eDof::DISPLACEMENTS);
+        auto& ud = matrix(eDof::DISPLACEMENTS, eDof::CRACKPHASEFIELD);
+        auto& du = matrix(eDof::CRACKPHASEFIELD, eDof::DISPLACEMENTS);
+        auto& dd = matrix(eDof::CRACKPHASEFIELD, eDof::CRACKPHASEFIELD);
+        uu.Resize(2 * numNodes, 2 * numNodes);
+        ud.Resize(2 * numNodes, numNodes);
+        du.Resize(numNodes, 2 * numNodes);
+        dd.Resize(numNodes, numNodes);
+
+        const Eigen::Matrix2d nodeCoupling = (Eigen::Matrix2d() << 2., 0.5, 0.5, 1.).finished();
+        for (int i = 0; i < n; ++i)
+            for (int j = 0; j < n; ++j)
+            {
+                const int node = i * n + j;
+                std::vector<int> neighbors;
+                if (i > 0)
+                    neighbors.push_back(node - n);
+                if (i < n - 1)
+                    neighbors.push_back(node + n);
+                if (j > 0)
+                    neighbors.push_back(node - 1);
+                if (j < n - 1)
+                    neighbors.push_back(node + 1);
+
+                for (int a = 0; a < 2; ++a)
+                    for (int b = 0; b < 2; ++b)
+                    {
+                        uu.AddValue(2 * node + a, 2 * node + b, 4. * nodeCoupling(a, b));
+                        for (int neighbor : neighbors)
+                            uu.AddValue(2 * node + a, 2 * neighbor + b, -nodeCoupling(a, b));
+                    }
+                dd.AddValue(node, node, 4. + rPhaseFieldShift);
+                for (int neighbor : neighbors)
+                    dd.AddValue(node, neighbor, -1.);
+                ud.AddValue(2 * node, node, 0.1);
+                du.AddValue(node, 2 * node, 0.1);
+            }
+
+        rhs.AllocateSubvectors();
+        rhs[eDof::DISPLACEMENTS] = Eigen::VectorXd::LinSpaced(2 * numNodes, -1., 1.);
+        rhs[eDof::CRACKPHASEFIELD] = Eigen::VectorXd::Ones(numNodes);
+    }
+
+    Eigen::VectorXd ExpectedSolution() const
+    {
+        const Eigen::SparseMatrix<double> eigenMatrix = matrix.ExportToEigenSparseMatrix();
+        Eigen::SparseLU<Eigen::SparseMatrix<double>> solver(eigenMatrix);
+        return solver.solve(rhs.Export());
+    }
+
+    NuTo::DofStatus dofStatus;
+    NuTo::BlockFullVector<double> rhs;
+    NuTo::BlockSparseMatrix matrix;
+};
+
+void CheckSolution(const Eigen::VectorXd& rSolution, const Eigen::VectorXd& rExpected)
+{
+    BOOST_CHECK_SMALL((rSolution - rExpected).norm() / rExpected.norm(), 1.e-8);
+}
+
+BOOST_AUTO_TEST_CASE(SolverIterativeDiagonal)
+{
+    for (auto preconditioner : preconditioners)
+    {
+        NuTo::SolverPCG pcg(preconditioner);
+        SolveAndCheckSystem(pcg);
+        NuTo::SolverMINRES minres(preconditioner);
+        SolveAndCheckSystem(minres);
+    }
+}
+
+BOOST_AUTO_TEST_CASE(SolverPCGGrid)
+{
+    GridProblem p(20);
+    const Eigen::VectorXd expected = p.ExpectedSolution();
+    int numIterationsJacobi = 0;
+    for (auto preconditioner : preconditioners)
+    {
+        NuTo::SolverPCG solver(preconditioner);
+        solver.SetBlockSize(2);
+        CheckSolution(solver.Solve(p.matrix, p.rhs).Export(), expected);
+        BOOST_TEST_MESSAGE("PCG iterations " << solver.GetNumIterations());
+        if (preconditioner == ePreconditioner::JACOBI)
+            numIterationsJacobi = solver.GetNumIterations();
+        if (preconditioner == ePreconditioner::SSOR or preconditioner == ePreconditioner::INCOMPLETE_CHOLESKY)
+            BOOST_CHECK_LT(solver.GetNumIterations(), numIterationsJacobi);
+    }
+}
+
+BOOST_AUTO_TEST_CASE(SolverMINRESGrid)
+{
+    for (double phaseFieldShift : {1., -6.})
+    {
+        GridProblem p(20, phaseFieldShift);
+        const Eigen::VectorXd expected = p.ExpectedSolution();
+        for (auto preconditioner : {ePreconditioner::NONE, ePreconditioner::JACOBI})
+        {
+            NuTo::SolverMINRES solver(preconditioner);
+            CheckSolution(solver.Solve(p.matrix, p.rhs).Export(), expected);
+        }
+    }
+
+    // indefinite
+    GridProblem p(20, -6.);
+    NuTo::SolverPCG pcg(ePreconditioner::JACOBI);
+    BOOST_CHECK_THROW(pcg.Solve(p.matrix, p.rhs), NuTo::Exception);
+}
+
+BOOST_AUTO_TEST_CASE(SolverIterativeToleranceResidual)
+{
+    GridProblem p(20);
+    NuTo::SolverPCG solver(ePreconditioner::JACOBI);
+    const int numIterations = (solver.Solve(p.matrix, p.rhs), solver.GetNumIterations());
+
+    // residual of each dof type below 0.1 * 1.e-3
+    solver.SetToleranceResidual(eDof::DISPLACEMENTS, 1.e-3);
+    const auto solution = solver.Solve(p.matrix, p.rhs);
+    BOOST_CHECK_EQUAL(solver.GetNumIterations(), numIterations);
+    solver.SetToleranceResidual(eDof::CRACKPHASEFIELD, 1.e-3);
+    const auto coarseSolution = solver.SolveFactorized(p.rhs);
+    BOOST_CHECK_LT(solver.GetNumIterations(), numIterations);
+    const auto residual = p.rhs - p.matrix * coarseSolution;
+    BOOST_CHECK_LE(residual[eDof::DISPLACEMENTS].lpNorm<Eigen::Infinity>(), 1.e-4);
+    BOOST_CHECK_LE(residual[eDof::CRACKPHASEFIELD].lpNorm<Eigen::Infinity>(), 1.e-4);
+
+    // the preconditioner is reused
+    BOOST_CHECK_EQUAL(solver.GetNumFactorizations(), 1);
+
+    solver.SetMaxNumIterations(2);
+    BOOST_CHECK_THROW(solver.SolveFactorized(p.rhs * 2.), NuTo::Exception);
+}
+
+BOOST_AUTO_TEST_CASE(SolverIterativeFieldSplit)
+{
+    const int n = 30;
+    GridProblem p(n);
+    const Eigen::VectorXd expected = p.ExpectedSolution();
+
+    NuTo::SolverPCG jacobi(ePreconditioner::JACOBI);
+    jacobi.Solve(p.matrix, p.rhs);
+
+    // translations of the displacements, constant phase field
+    NuTo::NearNullSpace nearNullSpace;
+    nearNullSpace.mModes = Eigen::MatrixXd::Zero(3 * n * n, 3);
+    for (int node = 0; node < n * n; ++node)
+    {
+        nearNullSpace.mModes(2 * node, 0) = 1.;
+        nearNullSpace.mModes(2 * node + 1, 1) = 1.;
+        nearNullSpace.mModes(2 * n * n + node, 2) = 1.;
+        nearNullSpace.mNodes.push_back(node);
+        nearNullSpace.mNodes.push_back(node);
+    }
+    for (int node = 0; node < n * n; ++node)
+        nearNullSpace.mNodes.push_back(node);
+
+    using eFieldSplit = NuTo::SolverIterative::eFieldSplit;
+    for (auto fieldSplit :
+         {eFieldSplit::ADDITIVE, eFieldSplit::SYMMETRIC_MULTIPLICATIVE, eFieldSplit::SCHUR_COMPLEMENT})
+    {
+        NuTo::SolverPCG solver(ePreconditioner::FIELD_SPLIT);
+        solver.SetFieldSplit(fieldSplit);
+        solver.SetNearNullSpace(nearNullSpace);
+        CheckSolution(solver.Solve(p.matrix, p.rhs).Export(), expected);
+        BOOST_TEST_MESSAGE("PCG field split iterations " << solver.GetNumIterations() << ", Jacobi "
+                                                         << jacobi.GetNumIterations());
+        BOOST_CHECK_LT(2 * solver.GetNumIterations(), jacobi.GetNumIterations());
+
+        // same preconditioners for all dof types
+        solver.SetFieldPreconditioner(eDof::DISPLACEMENTS, ePreconditioner::INCOMPLETE_CHOLESKY);
+        CheckSolution(solver.Solve(p.matrix, p.rhs).Export(), expected);
+        BOOST_CHECK_LT(solver.GetNumIterations(), jacobi.GetNumIterations());
+
+        NuTo::SolverMINRES minres(ePreconditioner::FIELD_SPLIT);
+        minres.SetFieldSplit(fieldSplit);
+        minres.SetFieldPreconditioner(eDof::DISPLACEMENTS, ePreconditioner::BLOCK_JACOBI);
+        minres.SetBlockSize(2);
+        CheckSolution(minres.Solve(p.matrix, p.rhs).Export(), expected);
+    }
+
+    NuTo::SolverPCG solver(ePreconditioner::FIELD_SPLIT);
+    BOOST_CHECK_THROW(solver.SetFieldPreconditioner(eDof::DISPLACEMENTS, ePreconditioner::FIELD_SPLIT),
+                      NuTo::Exception);
+    nearNullSpace.mNodes.pop_back();
+    solver.SetNearNullSpace(nearNullSpace);
+    BOOST_CHECK_THROW(solver.Solve(p.matrix, p.rhs), NuTo::Exception);
+}
+
+BOOST_AUTO_TEST_CASE(SolverFGMRESNonsymmetric)
+{
+    // one sided coupling of the phase field, e.g. a damage driven by the displacements
+    const int n = 20;
+    GridProblem p(n);
+    for (int node = 0; node < n * n; ++node)
+        p.matrix(eDof::CRACKPHASEFIELD, eDof::DISPLACEMENTS).AddValue(node, 2 * node + 1, 0.5);
+
+    for (auto preconditioner : {ePreconditioner::JACOBI, ePreconditioner::SSOR, ePreconditioner::FIELD_SPLIT})
+    {
+        NuTo::SolverFGMRES solver(preconditioner);
+        solver.SetBlockSize(2);
+        CheckSolution(solver.Solve(p.matrix, p.rhs).Export(), p.ExpectedSolution());
+        BOOST_CHECK_GT(solver.GetNumRecycledVectors(), 0);
+    }
+
+    // slowly changing systems, e.g. Newton iterations, converge faster with the recycled subspace
+    NuTo::SolverFGMRES recycling(ePreconditioner::JACOBI, 20, 10);
+    NuTo::SolverFGMRES restart(ePreconditioner::JACOBI, 20, 0);
+    int numIterationsRecycling = 0;
+    int numIterationsRestart = 0;
+    for (int i = 0; i < 4; ++i)
+    {
+        for (int node = 0; node < n * n; ++node)
+            p.matrix(eDof::CRACKPHASEFIELD, eDof::CRACKPHASEFIELD).AddValue(node, node, 0.01);
+        const Eigen::VectorXd expected = p.ExpectedSolution();
+        CheckSolution(recycling.Solve(p.matrix, p.rhs).Export(), expected);
+        CheckSolution(restart.Solve(p.matrix, p.rhs).Export(), expected);
+        numIterationsRecycling += recycling.GetNumIterations();
+        numIterationsRestart += restart.GetNumIterations();
+        BOOST_TEST_MESSAGE("FGMRES iterations recycling " << recycling.GetNumIterations() << ", restart "
+                                                          << restart.GetNumIterations());
+    }
+    BOOST_CHECK_LT(numIterationsRecycling, numIterationsRestart);
+
+    // residual tolerances of the dof types
+    recycling.SetToleranceResidual(eDof::DISPLACEMENTS, 1.e-3);
+    recycling.SetToleranceResidual(eDof::CRACKPHASEFIELD, 1.e-3);
+    recycling.ClearRecycledSubspace();
+    const auto solution = recycling.SolveFactorized(p.rhs);
+    const auto residual = p.rhs - p.matrix * solution;
+    BOOST_CHECK_LE(residual[eDof::DISPLACEMENTS].lpNorm<Eigen::Infinity>(), 1.e-4);
+    BOOST_CHECK_LE(residual[eDof::CRACKPHASEFIELD].lpNorm<Eigen::Infinity>(), 1.e-4);
+    BOOST_CHECK_LT(recycling.GetNumIterations(), numIterationsRestart / 4);
+}
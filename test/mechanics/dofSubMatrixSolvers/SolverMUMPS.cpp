@@ -7,3 +7,9 @@ BOOST_AUTO_TEST_CASE(SolverMUMPS)
     NuTo::SolverMUMPS s;
     SolveAndCheckSystem(s);
 }
+
+BOOST_AUTO_TEST_CASE(SolverMUMPSReuse)
+{
+    NuTo::SolverMUMPS s(false);
+    SolveAndCheckReuse(s);
+}
@@ -0,0 +1,86 @@
+#include "SolveSystem.h"
+#include <cmath>
+#include "mechanics/dofSubMatrixSolvers/SolverEigen.h"
+#include "mechanics/dofSubMatrixSolvers/SolverMixedPrecision.h"
+
+
+BOOST_AUTO_TEST_CASE(SolverMixedPrecision)
+{
+    NuTo::SolverMixedPrecision s;
+    SolveAndCheckSystem(s);
+}
+
+BOOST_AUTO_TEST_CASE(SolverMixedPrecisionReuse)
+{
+    // any direct solver, also for nonsymmetric matrices
+    using SparseLU = Eigen::SparseLU<Eigen::SparseMatrix<double>, Eigen::COLAMDOrdering<int>>;
+    NuTo::SolverMixedPrecision s(std::make_unique<NuTo::SolverEigen<SparseLU>>());
+    SolveAndCheckReuse(s);
+    BOOST_CHECK_EQUAL(s.GetNumRefinements(), 0);
+}
+
+//! @brief tridiagonal finite difference Laplacian with n dofs, its condition number is about 0.4 n^2
+struct LaplacianProblem
+{
+    LaplacianProblem(int n, double rShift = 0.)
+        : matrix(dofStatus)
+        , rhs(dofStatus)
+    {
+        using NuTo::Node::eDof;
+        dofStatus.SetDofTypes({eDof::DISPLACEMENTS});
+        dofStatus.SetActiveDofTypes({eDof::DISPLACEMENTS});
+        dofStatus.SetNumActiveDofs(eDof::DISPLACEMENTS, n);
+
+        matrix.AllocateSubmatrices();
+        auto& values = matrix(eDof::DISPLACEMENTS, eDof::DISPLACEMENTS);
+        values.Resize(n, n);
+        for (int i = 0; i < n; ++i)
+        {
+            values.AddValue(i, i, 2. - rShift);
+            if (i > 0)
+                values.AddValue(i, i - 1, -1.);
+            if (i < n - 1)
+                values.AddValue(i, i + 1, -1.);
+        }
+
+        solution = Eigen::VectorXd::LinSpaced(n, 0., 1.).array().sin();
+        rhs.AllocateSubvectors();
+        rhs[eDof::DISPLACEMENTS] = matrix.ExportToEigenSparseMatrix() * solution;
+    }
+
+    NuTo::DofStatus dofStatus;
+    NuTo::BlockSparseMatrix matrix;
+    NuTo::BlockFullVector<double> rhs;
+    Eigen::VectorXd solution;
+};
+
+BOOST_AUTO_TEST_CASE(SolverMixedPrecisionRefinement)
+{
+    // condition number 4e5, the single precision factorization is sufficient for the refinement
+    LaplacianProblem p(1000);
+    NuTo::SolverMixedPrecision s;
+    const Eigen::VectorXd x = s.Solve(p.matrix, p.rhs).Export();
+    BOOST_CHECK_SMALL((x - p.solution).lpNorm<Eigen::Infinity>(), 1.e-8);
+    BOOST_CHECK_GT(s.GetNumRefinements(), 0);
+    BOOST_CHECK_EQUAL(s.GetNumGmresIterations(), 0);
+    BOOST_TEST_MESSAGE("n = 1000: " << s.GetNumRefinements() << " refinement steps");
+}
+
+BOOST_AUTO_TEST_CASE(SolverMixedPrecisionGmresIR)
+{
+    // the shift by 90% of the smallest eigenvalue pi^2 / (n + 1)^2 increases the condition number to 1e8, the
+    // refinement with the single precision factorization stalls
+    const int n = 5000;
+    LaplacianProblem p(n, 0.9 * M_PI * M_PI / ((n + 1.) * (n + 1.)));
+    NuTo::SolverMixedPrecision s;
+    const Eigen::VectorXd x = s.Solve(p.matrix, p.rhs).Export();
+    BOOST_CHECK_SMALL((x - p.solution).lpNorm<Eigen::Infinity>(), 1.e-5);
+    BOOST_CHECK_GT(s.GetNumGmresIterations(), 0);
+    BOOST_CHECK_EQUAL(s.GetNumIterations(), s.GetNumRefinements() + s.GetNumGmresIterations());
+    BOOST_TEST_MESSAGE("n = 5000: " << s.GetNumRefinements() << " refinement steps, " << s.GetNumGmresIterations()
+                                     << " GMRES iterations");
+
+    // the fallback fails if the tolerance is out of reach
+    s.SetTolerance(1.e-30);
+    BOOST_CHECK_THROW(s.SolveFactorized(p.rhs), NuTo::Exception);
+}
@@ -7,3 +7,9 @@ BOOST_AUTO_TEST_CASE(SolverPardiso)
     NuTo::SolverPardiso s(1);
     SolveAndCheckSystem(s);
 }
+
+BOOST_AUTO_TEST_CASE(SolverPardisoReuse)
+{
+    NuTo::SolverPardiso s(1, false);
+    SolveAndCheckReuse(s);
+}
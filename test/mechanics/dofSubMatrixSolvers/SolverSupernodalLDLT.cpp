@@ -0,0 +1,41 @@
+#include "SolveSystem.h"
+#include "mechanics/dofSubMatrixSolvers/SolverSupernodalLDLT.h"
+
+
+BOOST_AUTO_TEST_CASE(SolverSupernodalLDLT)
+{
+    NuTo::SolverSupernodalLDLT s;
+    SolveAndCheckSystem(s);
+}
+
+BOOST_AUTO_TEST_CASE(SolverSupernodalLDLTReuse)
+{
+    // the new pattern of SolveAndCheckReuse is nonsymmetric
+    NuTo::SolverSupernodalLDLT s;
+    SolveAndCheckReuse(s);
+    BOOST_CHECK(s.IsNonSymmetric());
+}
+
+BOOST_AUTO_TEST_CASE(SolverSupernodalLDLTNonSymmetric)
+{
+    using NuTo::Node::eDof;
+    NuTo::SolverSupernodalLDLT solver;
+    TestProblem p;
+
+    // symmetric pattern, nonsymmetric values: [2 1; 0 2] for the first displacement and crack phase field dof
+    p.matrix(eDof::DISPLACEMENTS, eDof::CRACKPHASEFIELD).AddValue(0, 0, 1.);
+    p.matrix(eDof::CRACKPHASEFIELD, eDof::DISPLACEMENTS).AddValue(0, 0, 0.);
+    Eigen::VectorXd expected = p.expectedSolution.Export();
+    expected[0] = 0.25;
+    BoostUnitTest::CheckVector(solver.Solve(p.matrix, p.rhs).Export(), expected, 4);
+    BOOST_CHECK(solver.IsNonSymmetric());
+
+    // symmetric values with the same pattern, factorized by SupernodalLDLT
+    p.matrix(eDof::CRACKPHASEFIELD, eDof::DISPLACEMENTS).AddValue(0, 0, 1.);
+    expected[0] = 1. / 3.;
+    expected[2] = 1. / 3.;
+    BoostUnitTest::CheckVector(solver.Solve(p.matrix, p.rhs).Export(), expected, 4);
+    BOOST_CHECK(not solver.IsNonSymmetric());
+    BOOST_CHECK_EQUAL(solver.GetNumAnalyses(), 1);
+    BOOST_CHECK_EQUAL(solver.GetNumFactorizations(), 2);
+}
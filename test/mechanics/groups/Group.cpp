@@ -3,6 +3,9 @@
 #include "mechanics/nodes/NodeBase.h"
 
 #include <fakeit.hpp>
+#include <algorithm>
+#include <iterator>
+#include <set>
 
 using namespace NuTo;
 using namespace fakeit;
@@ -58,3 +61,160 @@ BOOST_FIXTURE_TEST_CASE(symmetricDiffTest, GroupTestFixture)
     auto symmetricDiffGroup = nodeGroupOne.SymmetricDifference(&nodeGroupTwo);
     BOOST_CHECK_EQUAL(symmetricDiffGroup->GetNumMembers(), 3);
 }
+
+
+//! @brief compares the members of rGroup with the ids in rExpected
+void CheckMembers(const Group<NodeBase>& rGroup, const std::set<int>& rExpected)
+{
+    BOOST_CHECK_EQUAL(rGroup.GetNumMembers(), rExpected.size());
+    const std::vector<int> ids = rGroup.GetMemberIds();
+    BOOST_CHECK_EQUAL_COLLECTIONS(ids.begin(), ids.end(), rExpected.begin(), rExpected.end());
+}
+
+
+BOOST_AUTO_TEST_CASE(largeGroupTest)
+{
+    Mock<NodeBase> mockNode;
+    NodeBase& node = mockNode.get();
+
+    // dense ids, added out of order
+    Group<NodeBase> group;
+    std::set<int> expected;
+    for (int i = 0; i < 1000; ++i)
+    {
+        const int id = (7 * i) % 1000;
+        group.AddMember(id, &node);
+        expected.insert(id);
+    }
+    BOOST_CHECK(group.HasBitset());
+    BOOST_CHECK_THROW(group.AddMember(500, &node), Exception);
+    CheckMembers(group, expected);
+
+    for (int id = 0; id < 1000; id += 3)
+    {
+        group.RemoveMember(id);
+        expected.erase(id);
+    }
+    BOOST_CHECK_THROW(group.RemoveMember(0), Exception);
+    BOOST_CHECK(not group.Contain(3));
+    BOOST_CHECK(group.Contain(4));
+    BOOST_CHECK_EQUAL(group.GetNumMembers(), expected.size());
+
+    // a removed member is added again
+    group.AddMember(300, &node);
+    expected.insert(300);
+    BOOST_CHECK(group.Contain(300));
+    CheckMembers(group, expected);
+    BOOST_CHECK(group.find(300) != group.end());
+    BOOST_CHECK(group.find(3) == group.end());
+
+    // a negative id turns the bitset off
+    group.AddMember(-5, &node);
+    expected.insert(-5);
+    BOOST_CHECK(not group.HasBitset());
+    BOOST_CHECK(group.Contain(-5));
+    CheckMembers(group, expected);
+    group.RemoveMember(-5);
+    expected.erase(-5);
+    CheckMembers(group, expected);
+
+    // sparse ids do not get a bitset
+    Group<NodeBase> sparseGroup;
+    for (int i = 0; i < 200; ++i)
+        sparseGroup.AddMember(1000 * i, &node);
+    BOOST_CHECK(not sparseGroup.HasBitset());
+    BOOST_CHECK(sparseGroup.Contain(5000));
+    BOOST_CHECK(not sparseGroup.Contain(5001));
+}
+
+
+BOOST_AUTO_TEST_CASE(largeGroupOperationsTest)
+{
+    Mock<NodeBase> mockNode;
+    NodeBase& node = mockNode.get();
+
+    Group<NodeBase> groupOne, groupTwo, sparseGroup;
+    std::set<int> idsOne, idsTwo, idsSparse;
+    for (int id = 0; id < 600; ++id)
+    {
+        if (id % 2 == 0)
+        {
+            groupOne.AddMember(id, &node);
+            idsOne.insert(id);
+        }
+        if (id % 3 == 0)
+        {
+            groupTwo.AddMember(id, &node);
+            idsTwo.insert(id);
+        }
+        if (id % 5 == 0)
+        {
+            sparseGroup.AddMember(100 * id, &node);
+            idsSparse.insert(100 * id);
+        }
+    }
+    BOOST_CHECK(groupOne.HasBitset());
+    BOOST_CHECK(groupTwo.HasBitset());
+    BOOST_CHECK(not sparseGroup.HasBitset());
+
+    auto check = [](const GroupBase* rResult, const std::set<int>& rExpected) {
+        CheckMembers(*rResult->AsGroupNode(), rExpected);
+        delete rResult;
+    };
+
+    for (auto pair : {std::make_pair(&groupOne, &groupTwo), std::make_pair(&groupTwo, &sparseGroup),
+                      std::make_pair(&sparseGroup, &groupOne)})
+    {
+        const Group<NodeBase>& a = *pair.first;
+        const Group<NodeBase>& b = *pair.second;
+        const std::vector<int> idsA = a.GetMemberIds();
+        const std::vector<int> idsB = b.GetMemberIds();
+        std::set<int> expected;
+        std::set_union(idsA.begin(), idsA.end(), idsB.begin(), idsB.end(), std::inserter(expected, expected.end()));
+        check(a.Unite(&b), expected);
+        expected.clear();
+        std::set_intersection(idsA.begin(), idsA.end(), idsB.begin(), idsB.end(),
+                              std::inserter(expected, expected.end()));
+        check(a.Intersection(&b), expected);
+        expected.clear();
+        std::set_difference(idsA.begin(), idsA.end(), idsB.begin(), idsB.end(),
+                            std::inserter(expected, expected.end()));
+        check(a.Difference(&b), expected);
+        expected.clear();
+        std::set_symmetric_difference(idsA.begin(), idsA.end(), idsB.begin(), idsB.end(),
+                                      std::inserter(expected, expected.end()));
+        check(a.SymmetricDifference(&b), expected);
+    }
+}
+
+
+BOOST_AUTO_TEST_CASE(addMembersTest)
+{
+    Mock<NodeBase> mockNode;
+    NodeBase& node = mockNode.get();
+
+    Group<NodeBase> group;
+    std::set<int> expected;
+    for (int id = 0; id < 100; id += 2)
+    {
+        group.AddMember(id, &node);
+        expected.insert(id);
+    }
+
+    // unsorted, e.g. in the locality order of the structure, merged with the existing members
+    std::vector<std::pair<int, NodeBase*>> newMembers;
+    for (int i = 0; i < 50; ++i)
+    {
+        const int id = 2 * ((7 * i) % 50) + 1;
+        newMembers.emplace_back(id, &node);
+        expected.insert(id);
+    }
+    group.AddMembers(newMembers);
+    BOOST_CHECK(group.HasBitset());
+    BOOST_CHECK(group.Contain(37));
+    CheckMembers(group, expected);
+
+    BOOST_CHECK_THROW(group.AddMembers({{200, &node}, {4, &node}}), Exception);
+    BOOST_CHECK_THROW(group.AddMembers({{200, &node}, {200, &node}}), Exception);
+    CheckMembers(group, expected);
+}
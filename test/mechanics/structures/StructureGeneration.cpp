@@ -0,0 +1,37 @@
+#include "BoostUnitTest.h"
+#include "mechanics/structures/StructureGeneration.h"
+
+#include <vector>
+
+BOOST_AUTO_TEST_CASE(StructureGenerationGeometry)
+{
+    NuTo::StructureGeneration generation;
+    const unsigned long geometry = generation.GetGeometry();
+    BOOST_CHECK_EQUAL(generation.GetGeometry(), geometry);
+
+    // several modifications increment the geometry generation once
+    generation.SetGeometryModified();
+    generation.SetGeometryModified();
+    BOOST_CHECK_EQUAL(generation.GetGeometry(), geometry + 1);
+    BOOST_CHECK_EQUAL(generation.GetGeometry(), geometry + 1);
+
+    // the configuration is independent
+    const unsigned long configuration = generation.GetConfiguration();
+    generation.IncrementConfiguration();
+    BOOST_CHECK_EQUAL(generation.GetConfiguration(), configuration + 1);
+    BOOST_CHECK_EQUAL(generation.GetGeometry(), geometry + 1);
+}
+
+BOOST_AUTO_TEST_CASE(StructureGenerationParallel)
+{
+    NuTo::StructureGeneration generation;
+    generation.SetGeometryModified();
+    std::vector<unsigned long> geometries(100);
+#ifdef _OPENMP
+#pragma omp parallel for
+#endif
+    for (int i = 0; i < 100; ++i)
+        geometries[i] = generation.GetGeometry();
+    for (unsigned long geometry : geometries)
+        BOOST_CHECK_EQUAL(geometry, 1);
+}
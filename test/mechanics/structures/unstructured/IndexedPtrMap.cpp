@@ -0,0 +1,82 @@
+#include "BoostUnitTest.h"
+#include "mechanics/structures/unstructured/IndexedPtrMap.h"
+
+#include <algorithm>
+#include <numeric>
+
+BOOST_AUTO_TEST_CASE(IndexedPtrMapIds)
+{
+    NuTo::IndexedPtrMap<double> map;
+    double* a = new double(1.);
+    double* b = new double(2.);
+    double* c = new double(3.);
+    map.insert(5, a);
+    map.insert(2, b);
+    map.insert(7, c);
+    BOOST_CHECK_EQUAL(map.size(), 3);
+
+    BOOST_CHECK_EQUAL(map.GetId(a), 5);
+    BOOST_CHECK_EQUAL(map.GetId(b), 2);
+    BOOST_CHECK_EQUAL(map.GetId(nullptr), -1);
+
+    // index in the order of the ids
+    BOOST_CHECK(map.GetObjects() == std::vector<double*>({b, a, c}));
+    BOOST_CHECK(map.GetObjectIds() == std::vector<int>({2, 5, 7}));
+
+    const unsigned long revision = map.GetRevision();
+    BOOST_CHECK_EQUAL(map.erase(5), 1);
+    BOOST_CHECK_EQUAL(map.erase(5), 0);
+    BOOST_CHECK_EQUAL(map.GetRevision(), revision + 1);
+    BOOST_CHECK_EQUAL(map.GetId(a), -1);
+    BOOST_CHECK(map.GetObjects() == std::vector<double*>({b, c}));
+
+    map.erase(map.find(7));
+    BOOST_CHECK(map.GetObjectIds() == std::vector<int>({2}));
+    BOOST_CHECK_EQUAL(*map.find(2)->second, 2.);
+
+    map.clear();
+    BOOST_CHECK(map.GetObjects().empty());
+    BOOST_CHECK_EQUAL(map.GetId(b), -1);
+}
+
+BOOST_AUTO_TEST_CASE(IndexedPtrMapOrdering)
+{
+    NuTo::IndexedPtrMap<double> map;
+    for (int id = 0; id < 4; ++id)
+        map.insert(id, new double(4. - id));
+
+    auto orderedIds = [&]() {
+        std::vector<int> ids;
+        for (const double* object : map.GetOrderedObjects())
+            ids.push_back(map.GetId(object));
+        return ids;
+    };
+
+    // without an ordering in the order of the ids
+    BOOST_CHECK(map.GetOrderedObjects() == map.GetObjects());
+
+    // sorted by value
+    map.SetOrdering([](const std::vector<double*>& rObjects) {
+        std::vector<int> ordering(rObjects.size());
+        std::iota(ordering.begin(), ordering.end(), 0);
+        std::sort(ordering.begin(), ordering.end(), [&](int i, int j) { return *rObjects[i] < *rObjects[j]; });
+        return ordering;
+    });
+    BOOST_CHECK(orderedIds() == std::vector<int>({3, 2, 1, 0}));
+
+    // the index remains in the order of the ids
+    BOOST_CHECK(map.GetObjectIds() == std::vector<int>({0, 1, 2, 3}));
+    for (unsigned int i = 0; i < map.size(); ++i)
+        BOOST_CHECK_EQUAL(map.GetId(map.GetObjects()[i]), map.GetObjectIds()[i]);
+
+    // new objects are sorted in the next access
+    map.insert(4, new double(2.5));
+    BOOST_CHECK(orderedIds() == std::vector<int>({3, 2, 4, 1, 0}));
+
+    // the ordering is only applied when the objects are reordered
+    *map.find(0)->second = 0.;
+    BOOST_CHECK_EQUAL(orderedIds().back(), 0);
+    map.InvalidateOrdering();
+    BOOST_CHECK_EQUAL(orderedIds().front(), 0);
+    BOOST_CHECK_EQUAL(map.GetObjectIds().front(), 0);
+}